@@ -71,6 +71,16 @@ class TCPServer : public ISocketServer{
     */
     using OnClientMessageHandler = std::function<void(std::string)>;
 
+    /**
+    * @typedef OnSocketMessageHandler
+    * @brief A function type alias for handling messages received from clients, together with the connection they come from.
+    * 
+    * This function type takes a pointer to a TCPSocket object and a string parameter.
+    * The function should handle the actions to be taken when a message is received from a client.
+    * 
+    */
+    using OnSocketMessageHandler = std::function<void(TCPSocket::pointer, std::string)>;
+
 public:
     /**
      * @brief Constructs a new TCPServer object.
@@ -102,6 +112,7 @@ public:
     OnJoinHandler OnJoin;  /**< Variable of type 'OnJoinHandler' */
     OnLeaveHandler OnLeave;  /**< Variable of type 'OnLeaveHandler' */
     OnClientMessageHandler OnClientMessage;  /**< Variable of type 'OnClientMessageHandler' */
+    OnSocketMessageHandler OnSocketMessage;  /**< Variable of type 'OnSocketMessageHandler' (used instead of 'OnClientMessage' if set) */
 
 private:
     IPV _ipVersion;
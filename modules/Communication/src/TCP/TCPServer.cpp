@@ -65,7 +65,13 @@ void TCPServer::acceptConnection() {
         _connections.insert(connection);
         if (!error) {
             connection->open(  // open connection with socket
-                [this](const std::string& message) { if (OnClientMessage) OnClientMessage(message); },  // call function obj OnClientMessage
+                [this, weak = std::weak_ptr(connection)](const std::string& message) {
+                    if (auto shared = weak.lock(); shared && OnSocketMessage) {
+                        OnSocketMessage(shared, message);  // call function obj OnSocketMessage
+                    } else if (OnClientMessage) {
+                        OnClientMessage(message);  // call function obj OnClientMessage
+                    }
+                },
                 [&, weak =std::weak_ptr(connection)] {
                     if (auto shared = weak.lock(); shared && _connections.erase(shared)) {
                         if (OnLeave) OnLeave(shared);  // call function obj OnLeave
@@ -0,0 +1,151 @@
+/**
+ * @file AlignmentSettings.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Loader of typed structs from the sections of the alignment settings file.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include "spdlog/spdlog.h"
+
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "IConfiguration.hpp"
+
+/**
+ * @struct SettingsField
+ * @brief Entry of the key table of a settings struct: links a key of the section to a member of the struct.
+ *
+ * @tparam Owner struct containing the member.
+ * @tparam T type of the member (float, double, int, bool, std::string or std::filesystem::path).
+ */
+template <typename Owner, typename T>
+struct SettingsField {
+    const char* key;  /**< Key in the section of the alignment settings file. */
+    T Owner::*member;  /**< Member of the struct where the value is stored. */
+};
+
+/**
+ * @brief Create an entry of the key table of a settings struct.
+ *
+ * @param key key in the section of the alignment settings file.
+ * @param member member of the struct where the value is stored.
+ * @return constexpr SettingsField<Owner, T> entry of the key table.
+ */
+template <typename Owner, typename T>
+constexpr SettingsField<Owner, T> settingsField(const char* key, T Owner::*member) {
+    return SettingsField<Owner, T>{key, member};
+}
+
+namespace alignmentSettings {
+
+namespace detail {
+
+constexpr bool equalKeys(const char* first, const char* second) {
+    while (*first != '\0' && *first == *second) {
+        ++first;
+        ++second;
+    }
+    return *first == *second;
+}
+
+template <typename Table, size_t... I>
+constexpr bool hasUniqueKeys(const Table& table, std::index_sequence<I...>) {
+    const char* keys[] = {std::get<I>(table).key...};
+    for (size_t i = 0; i < sizeof...(I); i++) {
+        for (size_t j = i + 1; j < sizeof...(I); j++) {
+            if (equalKeys(keys[i], keys[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+inline bool readValue(IConfiguration& configuration, const std::string& section, const std::string& key, float& value) {
+    value = configuration.readFloatFromConfigurationFile(configuration.getAlignmentSettingsConfigFilename(), configuration.getPath(), section, key);
+    return std::isfinite(value);
+}
+
+inline bool readValue(IConfiguration& configuration, const std::string& section, const std::string& key, double& value) {
+    value = configuration.readFloatFromConfigurationFile(configuration.getAlignmentSettingsConfigFilename(), configuration.getPath(), section, key);
+    return std::isfinite(value);
+}
+
+inline bool readValue(IConfiguration& configuration, const std::string& section, const std::string& key, int& value) {
+    value = configuration.readIntFromConfigurationFile(configuration.getAlignmentSettingsConfigFilename(), configuration.getPath(), section, key);
+    return true;
+}
+
+inline bool readValue(IConfiguration& configuration, const std::string& section, const std::string& key, bool& value) {
+    value = configuration.readBoolFromConfigurationFile(configuration.getAlignmentSettingsConfigFilename(), configuration.getPath(), section, key);
+    return true;
+}
+
+inline bool readValue(IConfiguration& configuration, const std::string& section, const std::string& key, std::string& value) {
+    value = configuration.readStringFromConfigurationFile(configuration.getAlignmentSettingsConfigFilename(), configuration.getPath(), section, key);
+    return !value.empty();
+}
+
+inline bool readValue(IConfiguration& configuration, const std::string& section, const std::string& key, std::filesystem::path& value) {
+    value = configuration.readFileSystemPathFromConfigurationFile(configuration.getAlignmentSettingsConfigFilename(), configuration.getPath(), section, key);
+    return !value.empty();
+}
+
+template <typename Settings, typename Owner, typename T>
+bool loadField(IConfiguration& configuration, const char* section, const SettingsField<Owner, T>& field, Settings& settings) {
+    bool valid;
+    try {
+        valid = readValue(configuration, section, field.key, settings.*field.member);
+    } catch (const std::exception&) {  // std::stof/std::stoi of a missing or non numeric value
+        valid = false;
+    }
+    if (!valid) {
+        spdlog::error("Key {} of section {} is missing or invalid\n", field.key, section);
+    }
+    return valid;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Load and validate a settings struct from its section of the alignment settings file.
+ *
+ * The struct declares the name of its section ('static constexpr const char* kSection'), its key table
+ * ('static constexpr auto fields()' returning a tuple of @ref SettingsField) and the checks on the values
+ * ('bool isValid() const'). The keys of the table are checked at compile time for duplicates.
+ * All the keys are read, so every missing or invalid key is logged.
+ *
+ * @tparam Settings type of the settings struct.
+ * @param configuration object used to read the alignment settings file.
+ * @param settings struct where the values are stored.
+ * @return true if all the keys have been read and the values are valid.
+ * @return false otherwise.
+ */
+template <typename Settings>
+bool load(IConfiguration& configuration, Settings& settings) {
+    constexpr auto kFields = Settings::fields();
+    static_assert(detail::hasUniqueKeys(kFields, std::make_index_sequence<std::tuple_size<decltype(kFields)>::value>{}),
+                  "Duplicated key in the key table of the settings struct");
+    bool valid = std::apply([&](const auto&... field) {
+        return (detail::loadField(configuration, Settings::kSection, field, settings) & ...);
+    }, kFields);
+    if (valid && !settings.isValid()) {
+        spdlog::error("Invalid values in section {} of the alignment settings\n", Settings::kSection);
+        valid = false;
+    }
+    return valid;
+}
+
+}  // namespace alignmentSettings
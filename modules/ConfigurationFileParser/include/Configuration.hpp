@@ -15,11 +15,16 @@
 #include <ini.h>
 #include "spdlog/spdlog.h"
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <filesystem>
+#include <memory>
 #include <string>
 
 #include "IConfiguration.hpp"
+#include "ConfigurationCache.hpp"
+#include "ProjectPaths.hpp"
 
 /**
  * @class Configuration
@@ -29,7 +34,6 @@
 class Configuration : public IConfiguration{
  private:
     std::filesystem::path path_;
-    std::filesystem::path pathToLogFilesDirectory_;  /**< Path to the where the log files are stored. */
     /**
      * @brief Struct containing all the default devices parameters.
      * 
@@ -55,16 +59,20 @@ class Configuration : public IConfiguration{
         const double const6 = 0.003750;
         const double const7 = 0.005;
     };
-    const std::filesystem::path projectName_ = "XRay_Machine";  /**< Name of the project. */
-    const std::filesystem::path configurationFilesFolder_ = "ConfigurationFiles";
-    const std::filesystem::path logFilesFolder_ = "LogFiles";
     const std::filesystem::path configFilename_ = "config.ini";  /**< Name of the configuration file that stores the 'devices configurations' and 'alignment configurations'. */
     const std::filesystem::path alignmentSettingsFilename_ = "AlignmentSettings.ini"; /**< Name of the configuration file that stores the alignment settings. */
     defaultConfigurationParameters_ defaultConfiguration_;
+    std::shared_ptr<ConfigurationCache> cache_;  /**< Parsed configuration files, shared by default by the whole process. */
 
  public:
 
     explicit Configuration();
+    /**
+     * @brief Construct a new Configuration object reading the files through a given cache.
+     *
+     * @param cache cache of the parsed configuration files.
+     */
+    explicit Configuration(std::shared_ptr<ConfigurationCache> cache);
 
     ~Configuration();
 
@@ -76,6 +84,10 @@ class Configuration : public IConfiguration{
                                std::string key,
                                std::filesystem::path filename,
                                std::filesystem::path path) override;
+    int writeConfigurationValues(const std::vector<ConfigurationValue>& values,
+                                 std::filesystem::path filename,
+                                 std::filesystem::path path,
+                                 bool preserveLayout) override;
     int createConfigurationFile(std::filesystem::path filename,
                                 std::filesystem::path path) override;
     int hasFile(std::filesystem::path filename, std::filesystem::path path) override;
@@ -118,4 +130,20 @@ class Configuration : public IConfiguration{
    std::string getDefaultIpAddressHxp() override;
    std::string getDefaultIpAddressStepper() override;
    int getDefaultNPortHxp() override;
+   std::shared_ptr<IConfiguration> takeSnapshot() override;
+   uint64_t getConfigurationVersion() override;
+   /**
+    * @brief Start the watcher of the cache: the configuration files edited on disk are reloaded in background
+    * and the reads do not access the disk (see ConfigurationCache::startWatcher()).
+    *
+    * @param period period of the checks of the files.
+    * @return true if the watcher has been started.
+    * @return false otherwise.
+    */
+   bool startWatcher(std::chrono::milliseconds period);
+   /**
+    * @brief Stop the watcher of the cache.
+    *
+    */
+   void stopWatcher();
 };
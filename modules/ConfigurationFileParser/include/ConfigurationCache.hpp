@@ -0,0 +1,201 @@
+/**
+ * @file ConfigurationCache.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief In-memory store of the parsed configuration files.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <ini.h>
+#include "spdlog/spdlog.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * @struct ConfigurationFileData
+ * @brief Struct containing a configuration file parsed once.
+ *
+ */
+struct ConfigurationFileData {
+    mINI::INIStructure ini;  /**< Structure parsed by mINI. */
+    std::unordered_map<std::string, std::string> values;  /**< Hash index of the values ("section" + '\n' + "key", lower case). */
+    std::unordered_set<std::string> sections;  /**< Names of the sections (lower case). */
+    uint64_t hash = 0;  /**< Hash of the content of the file. */
+    /**
+     * @brief Get a value of the file.
+     *
+     * @param section section of the value.
+     * @param key key of the value.
+     * @param value value found.
+     * @return true if the key exists.
+     * @return false otherwise.
+     */
+    bool get(const std::string& section, const std::string& key, std::string& value) const;
+    /**
+     * @brief Check if the file has a section.
+     *
+     * @param section name of the section.
+     * @return true if the section exists.
+     * @return false otherwise.
+     */
+    bool hasSection(const std::string& section) const;
+};
+
+/**
+ * @class ConfigurationCache
+ * @brief In-memory store of the parsed configuration files.
+ * @details Each file is parsed once and the lookups are served from a hash index.
+ * Before every lookup the modification time and size of the file are checked: if they changed the file is read
+ * again, and parsed again only if the hash of its content changed.
+ * When the watcher is running (see startWatcher()) the lookups do not access the disk: the cached files are checked
+ * periodically by a background thread instead.
+ * The files written through @ref Configuration are invalidated immediately.
+ * Every change of the content of a cached file publishes a new version of the configuration (see getVersion()).
+ * A snapshot (see snapshot()) freezes the files of the current version: it is used by the measurements so that
+ * the files edited while they are running are only used by the next measurement.
+ * The cache is shared by all the objects of class @ref Configuration of the process (see getShared()).
+ *
+ */
+class ConfigurationCache : public std::enable_shared_from_this<ConfigurationCache> {
+ public:
+    /**
+     * @brief Construct a new ConfigurationCache object.
+     *
+     */
+    ConfigurationCache();
+    /**
+     * @brief Destroy the ConfigurationCache object.
+     *
+     */
+    ~ConfigurationCache();
+    /**
+     * @brief Get the cache shared by the whole process.
+     *
+     * @return std::shared_ptr<ConfigurationCache> shared cache.
+     */
+    static std::shared_ptr<ConfigurationCache> getShared();
+    /**
+     * @brief Get the parsed content of a file, reloading it if it changed on disk.
+     *
+     * @param pathToFile path to the .ini file.
+     * @return std::shared_ptr<const ConfigurationFileData> parsed content, nullptr if the file cannot be read.
+     */
+    std::shared_ptr<const ConfigurationFileData> get(const std::filesystem::path& pathToFile);
+    /**
+     * @brief Drop a file from the cache. It is called after the file has been written.
+     *
+     * @param pathToFile path to the .ini file.
+     */
+    void invalidate(const std::filesystem::path& pathToFile);
+    /**
+     * @brief Lock a file for writing. The lock is shared by the whole process (all the caches and their snapshots),
+     * so that the read-modify-replace sequences of two writers of the same file do not interleave.
+     * @param pathToFile path to the .ini file.
+     * @return std::unique_lock<std::mutex> lock of the file, released when it is destroyed.
+     */
+    static std::unique_lock<std::mutex> lockFile(const std::filesystem::path& pathToFile);
+    /**
+     * @brief Get the number of times a file has been parsed since the construction of the cache.
+     *
+     * @return size_t number of parsings.
+     */
+    size_t getParseCount();
+    /**
+     * @brief Get the version of the configuration. It is incremented every time a change of a cached file is
+     * detected or a cached file is written. The version of a snapshot is the version of the cache when it was taken.
+     *
+     * @return uint64_t version of the configuration.
+     */
+    uint64_t getVersion();
+    /**
+     * @brief Take an immutable snapshot of the cached files.
+     * @details The lookups of the snapshot never reload the files frozen at the time of the snapshot. The files
+     * not cached yet are read at their first lookup and then frozen as well. A file written through a snapshot
+     * is invalidated both in the snapshot and in the cache it was taken from, so that the snapshot reads its own writes.
+     *
+     * @return std::shared_ptr<ConfigurationCache> snapshot.
+     */
+    std::shared_ptr<ConfigurationCache> snapshot();
+    /**
+     * @brief Check if this object is a snapshot.
+     *
+     * @return true if the object has been created by snapshot().
+     * @return false otherwise.
+     */
+    bool isSnapshot() const;
+    /**
+     * @brief Check once all the cached files and reload the ones changed on disk.
+     *
+     * @return true if a new version has been published.
+     * @return false otherwise.
+     */
+    bool refresh();
+    /**
+     * @brief Start the background thread calling refresh() periodically.
+     *
+     * @param period period of the checks.
+     * @return true if the thread has been started.
+     * @return false if it is already running or the object is a snapshot.
+     */
+    bool startWatcher(std::chrono::milliseconds period);
+    /**
+     * @brief Stop the background thread started by startWatcher().
+     *
+     */
+    void stopWatcher();
+
+ private:
+    /**
+     * @struct Entry
+     * @brief Struct containing a file of the cache and the attributes used to detect changes.
+     *
+     */
+    struct Entry {
+        std::shared_ptr<const ConfigurationFileData> data;  /**< Parsed content of the file. */
+        std::filesystem::file_time_type lastWriteTime;  /**< Modification time of the file when it was read. */
+        uintmax_t size = 0;  /**< Size of the file when it was read. */
+    };
+    /**
+     * @brief Read and parse a file.
+     *
+     * @param pathToFile path to the .ini file.
+     * @param hash hash of the content of the file.
+     * @return std::shared_ptr<const ConfigurationFileData> parsed content, nullptr if the file cannot be read.
+     */
+    std::shared_ptr<const ConfigurationFileData> parse(const std::filesystem::path& pathToFile, uint64_t hash);
+    /**
+     * @brief Compute the hash of the content of a file.
+     *
+     * @param pathToFile path to the file.
+     * @param hash hash of the content (FNV-1a).
+     * @return true if the file has been read.
+     * @return false otherwise.
+     */
+    static bool hashFile(const std::filesystem::path& pathToFile, uint64_t& hash);
+    std::unordered_map<std::string, Entry> entries_;  /**< Cached files indexed by path. */
+    std::atomic<size_t> parseCount_{0};  /**< Number of files parsed. */
+    uint64_t version_ = 1;  /**< Version of the configuration. */
+    bool frozen_ = false;  /**< True if the object is a snapshot. */
+    std::weak_ptr<ConfigurationCache> parent_;  /**< Cache the snapshot has been taken from. */
+    std::mutex mutex_;  /**< Mutex protecting the entries and the version. */
+    std::thread watcher_;  /**< Thread checking the cached files. */
+    std::atomic<bool> watching_{false};  /**< True while the watcher is running. */
+    std::mutex watcherMutex_;  /**< Mutex used to wake up the watcher. */
+    std::condition_variable watcherCondition_;  /**< Condition variable used to stop the watcher. */
+};
@@ -43,6 +43,10 @@ class ConfigurationMock : public IConfiguration {
                                            std::string key,
                                            std::filesystem::path filename,
                                            std::filesystem::path path));
+  MOCK_METHOD4(writeConfigurationValues, int(const std::vector<ConfigurationValue>& values,
+                                              std::filesystem::path filename,
+                                              std::filesystem::path path,
+                                              bool preserveLayout));
   MOCK_METHOD2(createConfigurationFile, int(std::filesystem::path filename,
                                             std::filesystem::path path));
   MOCK_METHOD2(hasFile, int(std::filesystem::path filename,
@@ -86,4 +90,6 @@ class ConfigurationMock : public IConfiguration {
   MOCK_METHOD0(getDefaultIpAddressHxp, std::string());
   MOCK_METHOD0(getDefaultIpAddressStepper, std::string());
   MOCK_METHOD0(getDefaultNPortHxp, int());
+  MOCK_METHOD0(takeSnapshot, std::shared_ptr<IConfiguration>());
+  MOCK_METHOD0(getConfigurationVersion, uint64_t());
 };
@@ -44,6 +44,7 @@ class ConfigurationMockConfig {
   void configureConfigurationMock() {
     ON_CALL(*ConfigurationMock_, getPartialPathUntilKeyName(_, _)).WillByDefault(Return("C:\\Users\\giricci\\Desktop\\XRay_Machine\\"));
     ON_CALL(*ConfigurationMock_, writeConfigurationFile(_, _, _, _, _)).WillByDefault(Return(1));
+    ON_CALL(*ConfigurationMock_, writeConfigurationValues(_, _, _, _)).WillByDefault(Return(1));
     ON_CALL(*ConfigurationMock_, readFloatFromConfigurationFile(_, _, _, _)).WillByDefault(Return(0.1));
     ON_CALL(*ConfigurationMock_, readIntFromConfigurationFile(_, _, _, _)).WillByDefault(Return(1));
     ON_CALL(*ConfigurationMock_, readStringFromConfigurationFile(_, _, _, _)).WillByDefault(Return("test_read_string"));
@@ -57,6 +58,12 @@ class ConfigurationMockConfig {
     ON_CALL(*ConfigurationMock_, getDefaultIpAddressHxp()).WillByDefault(Return("192.168.0.3"));
     ON_CALL(*ConfigurationMock_, getDefaultIpAddressStepper()).WillByDefault(Return("192.168.0.2"));
     ON_CALL(*ConfigurationMock_, getDefaultNPortHxp()).WillByDefault(Return(5001));
+    // the snapshot of the mock is the mock itself (weak pointer: the mock does not own itself)
+    std::weak_ptr<NiceMock<ConfigurationMock>> mock = ConfigurationMock_;
+    ON_CALL(*ConfigurationMock_, takeSnapshot()).WillByDefault(Invoke([mock]() -> std::shared_ptr<IConfiguration> {
+      return mock.lock();
+    }));
+    ON_CALL(*ConfigurationMock_, getConfigurationVersion()).WillByDefault(Return(1));
   }
 
  private:
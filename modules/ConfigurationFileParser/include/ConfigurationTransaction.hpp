@@ -0,0 +1,93 @@
+/**
+ * @file ConfigurationTransaction.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class used to stage several updates of a configuration file and write them at once.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include "spdlog/spdlog.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "IConfiguration.hpp"
+
+/**
+ * @class ConfigurationTransaction
+ * @brief Class used to stage several updates of a configuration file and write them at once.
+ *
+ * The values are staged in memory by set() and written by commit() with a single read-update-write cycle of the file
+ * (see IConfiguration::writeConfigurationValues()). Either all the values are written or the file is left untouched.
+ * The values not committed are discarded when the object is destroyed.
+ *
+ */
+class ConfigurationTransaction {
+ public:
+    ConfigurationTransaction() = delete;
+    /**
+     * @brief Construct a new ConfigurationTransaction object.
+     *
+     * @param clientConfiguration shared pointer to Class IConfiguration.
+     * @param filename name of the configuration file.
+     * @param path path to the directory that contains the configuration file.
+     */
+    explicit ConfigurationTransaction(std::shared_ptr<IConfiguration> clientConfiguration,
+                                      std::filesystem::path filename,
+                                      std::filesystem::path path);
+    /**
+     * @brief Destroy the ConfigurationTransaction object.
+     *
+     */
+    ~ConfigurationTransaction();
+    /**
+     * @brief Stage a value. A value staged twice for the same key replaces the previous one.
+     *
+     * @param section name of the section.
+     * @param key name of the key.
+     * @param value new value.
+     * @return ConfigurationTransaction& the transaction, to chain the calls.
+     */
+    ConfigurationTransaction& set(const std::string& section, const std::string& key, const std::string& value);
+    /**
+     * @brief Stage a numeric value, converted with std::to_string.
+     *
+     * @param section name of the section.
+     * @param key name of the key.
+     * @param value new value.
+     * @return ConfigurationTransaction& the transaction, to chain the calls.
+     */
+    ConfigurationTransaction& set(const std::string& section, const std::string& key, float value);
+    /**
+     * @brief Write all the staged values in the configuration file.
+     *
+     * @param preserveLayout true to keep the comments and the order of the keys of the file.
+     * @return 1 if writing was successful 0 otherwise. The staged values are discarded in both cases.
+     */
+    int commit(bool preserveLayout = true);
+    /**
+     * @brief Discard all the staged values.
+     *
+     */
+    void rollback();
+    /**
+     * @brief Get the number of staged values.
+     *
+     * @return size_t number of staged values.
+     */
+    size_t size() const;
+
+ private:
+    std::shared_ptr<IConfiguration> clientConfiguration_;  /**< Shared pointer to IConfiguration Class. */
+    std::filesystem::path filename_;  /**< Name of the configuration file. */
+    std::filesystem::path path_;  /**< Path to the directory that contains the configuration file. */
+    std::vector<ConfigurationValue> values_;  /**< Staged values. */
+};
@@ -12,9 +12,23 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 #include <filesystem>
+#include <memory>
 #include <string>
+#include <vector>
+
+/**
+ * @struct ConfigurationValue
+ * @brief Struct containing a value to be written in a configuration file.
+ * 
+ */
+struct ConfigurationValue {
+    std::string section;  /**< Name of the section. */
+    std::string key;  /**< Name of the key. */
+    std::string value;  /**< New value. */
+};
 
 /**
  * @class IConfiguration.
@@ -56,6 +70,22 @@ class IConfiguration{
                                std::filesystem::path filename,
                                std::filesystem::path path) = 0;
 
+    /**
+     * @brief Write several values in configuration file at once.
+     * @details The file is read once, all the values are updated in memory and the result is written to a temporary
+     * file that replaces the configuration file. Either all the values are written or the file is left untouched.
+     * @param values values to be written in the configuration file.
+     * @param filename name of the file.
+     * @param path path to the directory that contains the configuration file.
+     * @param preserveLayout true to keep the comments and the order of the keys of the file,
+     * false to regenerate the file from the parsed values.
+     * @return 1 if writing was successful 0 otherwise.
+     */
+    virtual int writeConfigurationValues(const std::vector<ConfigurationValue>& values,
+                                         std::filesystem::path filename,
+                                         std::filesystem::path path,
+                                         bool preserveLayout) = 0;
+
     /**
      * @brief Create an empty configuration file.
      * @param filename name of the file to be created (filename with .ini extension).
@@ -219,4 +249,17 @@ class IConfiguration{
      * @return int containing the number of the port used to establish a TCP connection with the hexapod controller.
      */
     virtual int getDefaultNPortHxp() = 0;
+
+    /**
+     * @brief Take an immutable snapshot of the configuration files.
+     * The files edited after the snapshot are not seen by its reads, except the ones written through the snapshot itself.
+     * @return std::shared_ptr<IConfiguration> configuration reading the snapshot.
+     */
+    virtual std::shared_ptr<IConfiguration> takeSnapshot() = 0;
+
+    /**
+     * @brief Get the version of the configuration files read by this object.
+     * @return uint64_t version of the configuration (version at the time of the snapshot for a snapshot).
+     */
+    virtual uint64_t getConfigurationVersion() = 0;
 };
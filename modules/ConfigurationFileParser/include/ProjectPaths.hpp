@@ -0,0 +1,94 @@
+/**
+ * @file ProjectPaths.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Directories of the project, resolved once and shared by all the modules.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include "spdlog/spdlog.h"
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @class ProjectPaths
+ * @brief Directories of the project (root, configuration files, log files, scans, spectra, results and scripts).
+ * @details The directories are computed once from the root of the project, so the path of the working directory
+ * is walked only when the process-wide object is created (see getShared()). The process-wide object can be
+ * replaced at startup or by the tests (see setShared()).
+ *
+ */
+class ProjectPaths {
+ public:
+    ProjectPaths() = delete;
+    /**
+     * @brief Construct a new ProjectPaths object.
+     *
+     * @param root path to the root directory of the project.
+     */
+    explicit ProjectPaths(const std::filesystem::path& root);
+    /**
+     * @brief Resolve the directories of the project from a path inside the project.
+     *
+     * @param currentPath path inside the project (e.g. working directory).
+     * @param projectName name of the root directory of the project.
+     * @return ProjectPaths directories of the project (empty root if the project is not found in the path).
+     */
+    static ProjectPaths resolve(const std::filesystem::path& currentPath,
+                                const std::filesystem::path& projectName = kProjectName);
+    /**
+     * @brief Get the part of a path until a directory name (included).
+     *
+     * @param pathReference path to be walked.
+     * @param keyPathName name of the directory.
+     * @return std::filesystem::path partial path, empty if the name is not found.
+     */
+    static std::filesystem::path getPartialPathUntilKeyName(const std::filesystem::path& pathReference,
+                                                            const std::filesystem::path& keyPathName);
+    /**
+     * @brief Get the directories shared by the whole process, resolved from the working directory at the first call.
+     *
+     * @return std::shared_ptr<const ProjectPaths> directories of the project.
+     */
+    static std::shared_ptr<const ProjectPaths> getShared();
+    /**
+     * @brief Replace the directories shared by the whole process.
+     *
+     * @param projectPaths directories of the project.
+     */
+    static void setShared(std::shared_ptr<const ProjectPaths> projectPaths);
+    const std::filesystem::path& getRoot() const;
+    const std::filesystem::path& getConfigurationDirectory() const;
+    const std::filesystem::path& getLogDirectory() const;
+    const std::filesystem::path& getScanDirectory() const;
+    const std::filesystem::path& getSpectraDirectory() const;
+    const std::filesystem::path& getScriptsDirectory() const;
+    /**
+     * @brief Get the directory where the results of the alignments and measurements of a device are saved.
+     *
+     * @param deviceName name of the device (e.g. "Crystal").
+     * @return std::filesystem::path path to the directory.
+     */
+    std::filesystem::path getResultsDirectory(const std::string& deviceName) const;
+
+    static constexpr const char* kProjectName = "XRay_Machine";  /**< Name of the root directory of the project. */
+
+ private:
+    static std::mutex sharedMutex_;  /**< Mutex protecting the process-wide object. */
+    static std::shared_ptr<const ProjectPaths> shared_;  /**< Directories shared by the whole process. */
+    std::filesystem::path root_;  /**< Root directory of the project. */
+    std::filesystem::path configurationDirectory_;  /**< Directory of the configuration files. */
+    std::filesystem::path logDirectory_;  /**< Directory of the log files. */
+    std::filesystem::path scanDirectory_;  /**< Directory of the data logged by the scans. */
+    std::filesystem::path spectraDirectory_;  /**< Directory of the spectra saved by the X-Ray sensor. */
+    std::filesystem::path scriptsDirectory_;  /**< Directory of the python scripts of the devices. */
+};
@@ -12,9 +12,14 @@
 
 #include "Configuration.hpp"
 
-Configuration::Configuration() {
+Configuration::Configuration() :
+    Configuration(ConfigurationCache::getShared()) {
+}
+
+Configuration::Configuration(std::shared_ptr<ConfigurationCache> cache) :
+    cache_(cache) {
     spdlog::info("cTor2 Configuration\n");
-    path_ = this->getPartialPathUntilKeyName(std::filesystem::current_path(), projectName_) / configurationFilesFolder_;
+    path_ = ProjectPaths::getShared()->getConfigurationDirectory();
 }
 
 Configuration::~Configuration() {
@@ -25,25 +30,7 @@ std::filesystem::path Configuration::getPartialPathUntilKeyName(
                     const std::filesystem::path pathReference,
                     const std::filesystem::path keyPathName) {
     spdlog::info("Method getPartialPathUntilKeyName of Class Configuration\n");
-    spdlog::debug("Current Path: {} \n", pathReference.string());
-    std::filesystem::path partialPath;
-    std::filesystem::path::iterator itrPath = std::find(pathReference.begin(),
-                                                        pathReference.end(),
-                                                        keyPathName);
-    if (itrPath != pathReference.end()) {
-        std::advance(itrPath, 1);
-        std::for_each(pathReference.begin(),
-                      itrPath,
-                      [&partialPath](std::filesystem::path nameInPath){
-                          partialPath/= nameInPath;
-                          });
-    } else {
-        spdlog::error("KeyName ({}) not Found in Path ({})",
-                       keyPathName.string(),
-                       pathReference.string());
-    }
-    spdlog::debug("Partial path: {} \n", partialPath.string());
-    return partialPath;
+    return ProjectPaths::getPartialPathUntilKeyName(pathReference, keyPathName);
 }
 
 int Configuration::writeConfigurationFile(std::string value,
@@ -53,33 +40,70 @@ int Configuration::writeConfigurationFile(std::string value,
                                           std::filesystem::path path) {
     spdlog::info("Method writeStringConfigurationFile "
                  "of Class Configuration\n");
+    return this->writeConfigurationValues({ConfigurationValue{section, key, value}}, filename, path, true);
+}
+
+int Configuration::writeConfigurationValues(const std::vector<ConfigurationValue>& values,
+                                            std::filesystem::path filename,
+                                            std::filesystem::path path,
+                                            bool preserveLayout) {
+    spdlog::info("Method writeConfigurationValues of Class Configuration\n");
     path /= filename;
+    // the other writers of the file (e.g. the worker threads of the devices) wait until it has been replaced
+    std::unique_lock<std::mutex> fileLock = ConfigurationCache::lockFile(path);
     // create a file instance
     mINI::INIFile file(path.string());
     // create a structure that will hold data
     mINI::INIStructure ini;
     // now we can read the file
     bool readSuccess = file.read(ini);
-    if (readSuccess == true) {
-        // update a value or add a new entry
-        ini[section][key] = value;
-        // write updates to file
-        file.write(ini, true);
-        return 1;
-    } else {
-        spdlog::error("Error in writeStringConfigurationFile"
+    if (readSuccess == false) {
+        spdlog::error("Error in writeConfigurationValues"
                       " of Class Configuration\n");
         return 0;
     }
+    // update the values or add new entries
+    for (const ConfigurationValue& value : values) {
+        ini[value.section][value.key] = value.value;
+    }
+    // write the updates to a temporary file that replaces the configuration file
+    static std::atomic<uint64_t> temporaryFileCount{0};
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+                     "_" + std::to_string(temporaryFileCount++);  // never shared with another writer
+    std::error_code errorCode;
+    bool writeSuccess;
+    if (preserveLayout) {
+        // mINI keeps the comments and the order of the file being overwritten
+        writeSuccess = std::filesystem::copy_file(path, temporaryPath, std::filesystem::copy_options::overwrite_existing, errorCode) &&
+                       mINI::INIFile(temporaryPath.string()).write(ini, true);
+    } else {
+        writeSuccess = mINI::INIFile(temporaryPath.string()).generate(ini, true);
+    }
+    if (writeSuccess) {
+        std::filesystem::rename(temporaryPath, path, errorCode);
+        writeSuccess = !errorCode;
+    }
+    cache_->invalidate(path);
+    if (writeSuccess == false) {
+        std::filesystem::remove(temporaryPath, errorCode);
+        spdlog::error("Error in writeConfigurationValues"
+                      " of Class Configuration. "
+                      "File {} not updated.\n", path.string());
+        return 0;
+    }
+    return 1;
 }
 
 int Configuration::createConfigurationFile(std::filesystem::path filename,
                                            std::filesystem::path path) {
     spdlog::info("Method createConfigurationFile of Class Configuration\n");
     path /= filename;
+    std::unique_lock<std::mutex> fileLock = ConfigurationCache::lockFile(path);
     mINI::INIFile file(path.string());
     mINI::INIStructure ini;
     bool generatesuccess = file.generate(ini, true);
+    cache_->invalidate(path);
     if (generatesuccess == true) {
         spdlog::debug("New .ini file created\n");
         path_ = path;
@@ -95,13 +119,7 @@ int Configuration::createConfigurationFile(std::filesystem::path filename,
 int Configuration::hasFile(std::filesystem::path filename,
                            std::filesystem::path path) {
     path /= filename;
-    // create a file instance
-    mINI::INIFile file(path.string());
-    // create a structure that will hold data
-    mINI::INIStructure ini;
-    // now we can read the file
-    bool readSuccess = file.read(ini);
-    if (readSuccess == true) {
+    if (cache_->get(path)) {
         spdlog::debug("Read Success!\n");
         return 1;
     } else {
@@ -115,13 +133,8 @@ int Configuration::hasSection(std::string section,
                               std::filesystem::path path) {
     spdlog::info("Method hasSection of Class Configuration\n");
     path /= filename;
-    // create a file instance
-    mINI::INIFile file(path.string());
-    // create a structure that will hold data
-    mINI::INIStructure ini;
-    file.read(ini);
-    bool hasSection = ini.has(section);
-    if (hasSection == true) {
+    std::shared_ptr<const ConfigurationFileData> file = cache_->get(path);
+    if (file && file->hasSection(section)) {
         return 1;
     } else {
         return 0;
@@ -133,13 +146,9 @@ int Configuration::hasKey(std::string section,
                           std::filesystem::path filename,
                           std::filesystem::path path) {
     path /= filename;
-    // create a file instance
-    mINI::INIFile file(path.string());
-    // create a structure that will hold data
-    mINI::INIStructure ini;
-    file.read(ini);
-    bool hasKey = ini[section].has(key);
-    if (hasKey == true) {
+    std::shared_ptr<const ConfigurationFileData> file = cache_->get(path);
+    std::string value;
+    if (file && file->get(section, key, value)) {
         return 1;
     } else {
         return 0;
@@ -150,6 +159,8 @@ int Configuration::removeConfigurationFile(std::filesystem::path filename,
                                            std::filesystem::path path) {
     spdlog::info("Method removeConfigurationFile of Class Configuration\n");
     path /= filename;
+    std::unique_lock<std::mutex> fileLock = ConfigurationCache::lockFile(path);
+    cache_->invalidate(path);
     if (std::filesystem::remove(path)) {
         return 0;
     } else {
@@ -164,14 +175,9 @@ std::string Configuration::readStringFromConfigurationFile(std::filesystem::path
     spdlog::info("Method readStringFromConfigurationFile of Class Configuration\n");
     path /= filename;
     std::string result;
-    // create a file instance
-    mINI::INIFile file(path.string());
-    // create a structure that will hold data
-    mINI::INIStructure ini;
-    // read the file
-    bool readSuccess = file.read(ini);
-    if (readSuccess == true) {
-        result = ini.get(section).get(key);
+    std::shared_ptr<const ConfigurationFileData> file = cache_->get(path);
+    if (file) {
+        file->get(section, key, result);
         spdlog::info("Read string {} {} Ok!\n", key ,result);
     } else {
         spdlog::error("Error\n");
@@ -245,25 +251,19 @@ std::filesystem::path Configuration::getAlignmentSettingsConfigFilename() {
 }
 
 std::filesystem::path Configuration::getPathToLogFilesDirectory() {
-    pathToLogFilesDirectory_ = this->getPartialPathUntilKeyName(std::filesystem::current_path(), projectName_) / logFilesFolder_;
-    return pathToLogFilesDirectory_;
+    return ProjectPaths::getShared()->getLogDirectory();
 }
 
 std::string Configuration::readStepperMotorIndexAxis(int axis) {
     spdlog::info("Method readStepperMotorIndexAxis "
                  "of Class ConfigurationStepper\n");
     std::filesystem::path path = path_ / this->getConfigFilename();
-    // create a file instance
-    mINI::INIFile file(path.string());
-    // create a structure that will hold data
-    mINI::INIStructure ini;
+    std::shared_ptr<const ConfigurationFileData> file = cache_->get(path);
     std::string stepperMotorIndexAxis;
-    // read the file
-    bool readSuccess = file.read(ini);
-    if (readSuccess == true) {
+    if (file) {
         spdlog::info("Read Ok!\n");
         std::string stepper_axis = "STEPPER_AXIS_" + std::to_string(axis);
-        stepperMotorIndexAxis = ini.get(stepper_axis).get("ID");
+        file->get(stepper_axis, "ID", stepperMotorIndexAxis);
     } else {
         spdlog::error("Error\n");
     }
@@ -274,17 +274,13 @@ double Configuration::readStepperMotorCONST(int axis) {
     spdlog::info("Method readStepperMotorCONST of "
                  "Class ConfigurationStepper\n");
     std::filesystem::path path = path_ / this->getConfigFilename();
-    // create a file instance
-    mINI::INIFile file(path.string());
-    // create a structure that will hold data
-    mINI::INIStructure ini;
+    std::shared_ptr<const ConfigurationFileData> file = cache_->get(path);
     double const_var;
-    // read the file
-    bool readSuccess = file.read(ini);
-    if (readSuccess == true) {
+    if (file) {
         spdlog::info("Read Ok!\n");
         std::string stepper_axis = "STEPPER_AXIS_" + std::to_string(axis);
-        std::string value = ini.get(stepper_axis).get("CONST");
+        std::string value;
+        file->get(stepper_axis, "CONST", value);
         const_var =  std::stod(value);
     } else {
         spdlog::error("Error\n");
@@ -302,4 +298,26 @@ std::string Configuration::getDefaultIpAddressStepper() {
 
 int Configuration::getDefaultNPortHxp() {
     return defaultConfiguration_.nPortHxp;
-}
\ No newline at end of file
+}
+std::shared_ptr<IConfiguration> Configuration::takeSnapshot() {
+    spdlog::info("Method takeSnapshot of Class Configuration\n");
+    // the configuration files are frozen at the snapshot, not at their first read
+    cache_->get(path_ / configFilename_);
+    cache_->get(path_ / alignmentSettingsFilename_);
+    auto snapshot = std::make_shared<Configuration>(cache_->snapshot());
+    snapshot->setPath(path_);
+    spdlog::info("Configuration version {} used\n", snapshot->getConfigurationVersion());
+    return snapshot;
+}
+
+uint64_t Configuration::getConfigurationVersion() {
+    return cache_->getVersion();
+}
+
+bool Configuration::startWatcher(std::chrono::milliseconds period) {
+    return cache_->startWatcher(period);
+}
+
+void Configuration::stopWatcher() {
+    cache_->stopWatcher();
+}
@@ -0,0 +1,269 @@
+/**
+ * @file ConfigurationCache.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief In-memory store of the parsed configuration files.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "ConfigurationCache.hpp"
+
+#include <fstream>
+
+namespace {
+
+std::string normalize(std::string name) {
+    mINI::INIStringUtil::trim(name);
+#ifndef MINI_CASE_SENSITIVE
+    mINI::INIStringUtil::toLower(name);
+#endif
+    return name;
+}
+
+std::string makeIndexKey(const std::string& section, const std::string& key) {
+    return normalize(section) + '\n' + normalize(key);
+}
+
+}  // namespace
+
+bool ConfigurationFileData::get(const std::string& section, const std::string& key, std::string& value) const {
+    auto it = values.find(makeIndexKey(section, key));
+    if (it == values.end()) {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+bool ConfigurationFileData::hasSection(const std::string& section) const {
+    return sections.count(normalize(section)) == 1;
+}
+
+ConfigurationCache::ConfigurationCache() {
+    spdlog::debug("cTor ConfigurationCache\n");
+}
+
+ConfigurationCache::~ConfigurationCache() {
+    this->stopWatcher();
+    spdlog::debug("dTor ConfigurationCache\n");
+}
+
+std::shared_ptr<ConfigurationCache> ConfigurationCache::getShared() {
+    static std::shared_ptr<ConfigurationCache> sharedCache = std::make_shared<ConfigurationCache>();
+    return sharedCache;
+}
+
+std::shared_ptr<const ConfigurationFileData> ConfigurationCache::get(const std::filesystem::path& pathToFile) {
+    if (frozen_ || watching_) {
+        // The snapshots and the watched caches serve the files already read without accessing the disk
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(pathToFile.string());
+        if (it != entries_.end() && it->second.data) {
+            return it->second.data;
+        }
+    }
+    std::error_code errorCode;
+    const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(pathToFile, errorCode);
+    if (errorCode) {
+        return nullptr;
+    }
+    const uintmax_t size = std::filesystem::file_size(pathToFile, errorCode);
+    if (errorCode) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entries_[pathToFile.string()];
+    if (entry.data && entry.lastWriteTime == lastWriteTime && entry.size == size) {
+        return entry.data;
+    }
+    uint64_t hash;
+    if (!hashFile(pathToFile, hash)) {
+        return nullptr;
+    }
+    if (!entry.data || entry.data->hash != hash) {
+        std::shared_ptr<const ConfigurationFileData> data = this->parse(pathToFile, hash);
+        if (!data) {
+            return nullptr;
+        }
+        if (entry.data) {
+            version_++;
+        }
+        entry.data = data;
+    }
+    entry.lastWriteTime = lastWriteTime;
+    entry.size = size;
+    return entry.data;
+}
+
+void ConfigurationCache::invalidate(const std::filesystem::path& pathToFile) {
+    std::shared_ptr<ConfigurationCache> parent = parent_.lock();
+    if (parent) {
+        parent->invalidate(pathToFile);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.erase(pathToFile.string()) == 1 && !frozen_) {
+        version_++;
+    }
+}
+
+std::unique_lock<std::mutex> ConfigurationCache::lockFile(const std::filesystem::path& pathToFile) {
+    static std::mutex registryMutex;
+    static std::unordered_map<std::string, std::unique_ptr<std::mutex>> fileMutexes;  // one per file written by the process
+    std::mutex* fileMutex;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        std::unique_ptr<std::mutex>& entry = fileMutexes[pathToFile.lexically_normal().string()];
+        if (!entry) {
+            entry = std::make_unique<std::mutex>();
+        }
+        fileMutex = entry.get();
+    }
+    return std::unique_lock<std::mutex>(*fileMutex);
+}
+
+size_t ConfigurationCache::getParseCount() {
+    return parseCount_;
+}
+
+uint64_t ConfigurationCache::getVersion() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+std::shared_ptr<ConfigurationCache> ConfigurationCache::snapshot() {
+    auto snapshot = std::make_shared<ConfigurationCache>();
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot->entries_ = entries_;
+    snapshot->version_ = version_;
+    snapshot->frozen_ = true;
+    snapshot->parent_ = frozen_ ? parent_ : weak_from_this();
+    return snapshot;
+}
+
+bool ConfigurationCache::isSnapshot() const {
+    return frozen_;
+}
+
+bool ConfigurationCache::refresh() {
+    if (frozen_) {
+        return false;
+    }
+    /* Copy the attributes of the cached files: the files are read without holding the lock */
+    std::unordered_map<std::string, Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : entries_) {
+            if (entry.second.data) {
+                entries.insert(entry);
+            }
+        }
+    }
+    bool changed = false;
+    for (const auto& entry : entries) {
+        const std::filesystem::path pathToFile = entry.first;
+        std::error_code errorCode;
+        const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(pathToFile, errorCode);
+        if (errorCode) {
+            continue;
+        }
+        const uintmax_t size = std::filesystem::file_size(pathToFile, errorCode);
+        if (errorCode || (entry.second.lastWriteTime == lastWriteTime && entry.second.size == size)) {
+            continue;
+        }
+        uint64_t hash;
+        if (!hashFile(pathToFile, hash)) {
+            continue;
+        }
+        std::shared_ptr<const ConfigurationFileData> data = entry.second.data;
+        if (data->hash != hash) {
+            data = this->parse(pathToFile, hash);
+            if (!data) {
+                continue;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(entry.first);
+        if (it == entries_.end() || it->second.data != entry.second.data) {
+            continue;  // invalidated or reloaded meanwhile
+        }
+        if (it->second.data != data) {
+            version_++;
+            changed = true;
+        }
+        it->second.data = data;
+        it->second.lastWriteTime = lastWriteTime;
+        it->second.size = size;
+    }
+    if (changed) {
+        spdlog::info("Configuration version {} published\n", this->getVersion());
+    }
+    return changed;
+}
+
+bool ConfigurationCache::startWatcher(std::chrono::milliseconds period) {
+    std::lock_guard<std::mutex> lock(watcherMutex_);
+    if (frozen_ || watcher_.joinable()) {
+        return false;
+    }
+    spdlog::info("Method startWatcher of Class ConfigurationCache\n");
+    watching_ = true;
+    watcher_ = std::thread([this, period]() {
+        std::unique_lock<std::mutex> watcherLock(watcherMutex_);
+        while (!watcherCondition_.wait_for(watcherLock, period, [this]() { return !watching_; })) {
+            watcherLock.unlock();
+            this->refresh();
+            watcherLock.lock();
+        }
+    });
+    return true;
+}
+
+void ConfigurationCache::stopWatcher() {
+    {
+        std::lock_guard<std::mutex> lock(watcherMutex_);
+        watching_ = false;
+    }
+    watcherCondition_.notify_all();
+    if (watcher_.joinable()) {
+        watcher_.join();
+    }
+}
+
+std::shared_ptr<const ConfigurationFileData> ConfigurationCache::parse(const std::filesystem::path& pathToFile, uint64_t hash) {
+    spdlog::debug("Parsing configuration file {}\n", pathToFile.string());
+    auto data = std::make_shared<ConfigurationFileData>();
+    mINI::INIFile file(pathToFile.string());
+    if (!file.read(data->ini)) {
+        spdlog::error("Error reading configuration file {}\n", pathToFile.string());
+        return nullptr;
+    }
+    for (const auto& section : data->ini) {
+        data->sections.insert(section.first);
+        for (const auto& keyValue : section.second) {
+            data->values[section.first + '\n' + keyValue.first] = keyValue.second;
+        }
+    }
+    data->hash = hash;
+    parseCount_++;
+    return data;
+}
+
+bool ConfigurationCache::hashFile(const std::filesystem::path& pathToFile, uint64_t& hash) {
+    std::ifstream file(pathToFile, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    hash = 14695981039346656037ULL;  // FNV-1a offset basis
+    char buffer[4096];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+        for (std::streamsize i = 0; i < file.gcount(); i++) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 1099511628211ULL;  // FNV-1a prime
+        }
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file ConfigurationTransaction.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class used to stage several updates of a configuration file and write them at once.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "ConfigurationTransaction.hpp"
+
+#include <algorithm>
+
+ConfigurationTransaction::ConfigurationTransaction(std::shared_ptr<IConfiguration> clientConfiguration,
+                                                   std::filesystem::path filename,
+                                                   std::filesystem::path path) :
+    clientConfiguration_(clientConfiguration),
+    filename_(filename),
+    path_(path) {
+}
+
+ConfigurationTransaction::~ConfigurationTransaction() {
+    if (!values_.empty()) {
+        spdlog::warn("{} values of {} not committed\n", values_.size(), filename_.string());
+    }
+}
+
+ConfigurationTransaction& ConfigurationTransaction::set(const std::string& section, const std::string& key, const std::string& value) {
+    auto it = std::find_if(values_.begin(), values_.end(), [&](const ConfigurationValue& staged) {
+        return staged.section == section && staged.key == key;
+    });
+    if (it != values_.end()) {
+        it->value = value;
+    } else {
+        values_.push_back(ConfigurationValue{section, key, value});
+    }
+    return *this;
+}
+
+ConfigurationTransaction& ConfigurationTransaction::set(const std::string& section, const std::string& key, float value) {
+    return this->set(section, key, std::to_string(value));
+}
+
+int ConfigurationTransaction::commit(bool preserveLayout) {
+    spdlog::info("Method commit of Class ConfigurationTransaction\n");
+    if (values_.empty()) {
+        return 1;
+    }
+    int result = clientConfiguration_->writeConfigurationValues(values_, filename_, path_, preserveLayout);
+    values_.clear();
+    return result;
+}
+
+void ConfigurationTransaction::rollback() {
+    values_.clear();
+}
+
+size_t ConfigurationTransaction::size() const {
+    return values_.size();
+}
@@ -0,0 +1,96 @@
+/**
+ * @file ProjectPaths.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Directories of the project, resolved once and shared by all the modules.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "ProjectPaths.hpp"
+
+#include <algorithm>
+
+std::mutex ProjectPaths::sharedMutex_;
+std::shared_ptr<const ProjectPaths> ProjectPaths::shared_;
+
+ProjectPaths::ProjectPaths(const std::filesystem::path& root) :
+    root_(root),
+    configurationDirectory_(root / "ConfigurationFiles"),
+    logDirectory_(root / "LogFiles"),
+    scanDirectory_(logDirectory_ / "DeviceScans"),
+    spectraDirectory_(logDirectory_ / "Spectra"),
+    scriptsDirectory_(root / "modules" / "Devices" / "scripts") {
+}
+
+ProjectPaths ProjectPaths::resolve(const std::filesystem::path& currentPath, const std::filesystem::path& projectName) {
+    return ProjectPaths(getPartialPathUntilKeyName(currentPath, projectName));
+}
+
+std::filesystem::path ProjectPaths::getPartialPathUntilKeyName(const std::filesystem::path& pathReference,
+                                                               const std::filesystem::path& keyPathName) {
+    spdlog::debug("Current Path: {} \n", pathReference.string());
+    std::filesystem::path partialPath;
+    std::filesystem::path::iterator itrPath = std::find(pathReference.begin(),
+                                                        pathReference.end(),
+                                                        keyPathName);
+    if (itrPath != pathReference.end()) {
+        std::advance(itrPath, 1);
+        std::for_each(pathReference.begin(),
+                      itrPath,
+                      [&partialPath](std::filesystem::path nameInPath){
+                          partialPath/= nameInPath;
+                          });
+    } else {
+        spdlog::error("KeyName ({}) not Found in Path ({})",
+                       keyPathName.string(),
+                       pathReference.string());
+    }
+    spdlog::debug("Partial path: {} \n", partialPath.string());
+    return partialPath;
+}
+
+std::shared_ptr<const ProjectPaths> ProjectPaths::getShared() {
+    std::lock_guard<std::mutex> lock(sharedMutex_);
+    if (!shared_) {
+        shared_ = std::make_shared<const ProjectPaths>(resolve(std::filesystem::current_path()));
+        spdlog::info("Project directory: {}\n", shared_->getRoot().string());
+    }
+    return shared_;
+}
+
+void ProjectPaths::setShared(std::shared_ptr<const ProjectPaths> projectPaths) {
+    std::lock_guard<std::mutex> lock(sharedMutex_);
+    shared_ = projectPaths;
+}
+
+const std::filesystem::path& ProjectPaths::getRoot() const {
+    return root_;
+}
+
+const std::filesystem::path& ProjectPaths::getConfigurationDirectory() const {
+    return configurationDirectory_;
+}
+
+const std::filesystem::path& ProjectPaths::getLogDirectory() const {
+    return logDirectory_;
+}
+
+const std::filesystem::path& ProjectPaths::getScanDirectory() const {
+    return scanDirectory_;
+}
+
+const std::filesystem::path& ProjectPaths::getSpectraDirectory() const {
+    return spectraDirectory_;
+}
+
+const std::filesystem::path& ProjectPaths::getScriptsDirectory() const {
+    return scriptsDirectory_;
+}
+
+std::filesystem::path ProjectPaths::getResultsDirectory(const std::string& deviceName) const {
+    return logDirectory_ / (deviceName + "AlignmentResults");
+}
@@ -0,0 +1,124 @@
+/**
+ * @file TestAlignmentSettings.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the loading of typed settings structs from the alignment settings file.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+#include "AlignmentSettings.hpp"
+#include "Configuration.hpp"
+
+/**
+ * @struct ScanSettings
+ * @brief Settings struct used by the tests.
+ *
+ */
+struct ScanSettings {
+    static constexpr const char* kSection = "Scan_Test";
+    std::filesystem::path scriptName;
+    float stepSize = 0;
+    int durationAcquisition = 0;
+    bool eraseCsvContent = false;
+    std::string dataLogFilename;
+    static constexpr auto fields() {
+        return std::make_tuple(settingsField("SCRIPT_NAME", &ScanSettings::scriptName),
+                               settingsField("STEP_SIZE", &ScanSettings::stepSize),
+                               settingsField("DURATION_ACQUISITION", &ScanSettings::durationAcquisition),
+                               settingsField("ERASE_CSV_CONTENT", &ScanSettings::eraseCsvContent),
+                               settingsField("DATA_LOG_FILENAME", &ScanSettings::dataLogFilename));
+    }
+    bool isValid() const {
+        return stepSize > 0;
+    }
+};
+
+/**
+ * @brief Test fixture called 'TestAlignmentSettings', which inherits from 'testing::Test'.
+ *
+ */
+struct TestAlignmentSettings : public ::testing::Test {
+    /**
+     * @brief Use a temporary alignment settings file.
+     *
+     */
+    void SetUp() override {
+        conf->setPath(conf->getPath() / "TestAlignmentSettings");
+        std::filesystem::create_directories(conf->getPath());
+    }
+    /**
+     * @brief Remove the temporary alignment settings file.
+     *
+     */
+    void TearDown() override {
+        std::filesystem::remove_all(conf->getPath());
+    }
+    /**
+     * @brief Write the section of the alignment settings file.
+     *
+     * @param content content of the section.
+     */
+    void writeSection(const std::string& content) {
+        std::ofstream file(conf->getPath() / conf->getAlignmentSettingsConfigFilename(), std::ios::out | std::ios::trunc);
+        file << "[Scan_Test]\n" << content;
+    }
+
+    std::shared_ptr<Configuration> conf =
+        std::make_shared<Configuration>(); /**< Shared pointer to 'Configuration' Class. */
+};
+
+/**
+ * @brief Test case that checks that all the keys of the section are read in the typed fields.
+ *
+ */
+TEST_F(TestAlignmentSettings, Load_all_fields) {
+    this->writeSection("SCRIPT_NAME = Scan.py\nSTEP_SIZE = 0.05\nDURATION_ACQUISITION = 30\n"
+                       "ERASE_CSV_CONTENT = 1\nDATA_LOG_FILENAME = scan.csv\n");
+    ScanSettings settings;
+    ASSERT_TRUE(alignmentSettings::load(*conf, settings));
+    EXPECT_EQ(std::filesystem::path("Scan.py"), settings.scriptName);
+    EXPECT_FLOAT_EQ(0.05f, settings.stepSize);
+    EXPECT_EQ(30, settings.durationAcquisition);
+    EXPECT_TRUE(settings.eraseCsvContent);
+    EXPECT_EQ("scan.csv", settings.dataLogFilename);
+}
+
+/**
+ * @brief Test case that checks that a missing key fails the loading.
+ *
+ */
+TEST_F(TestAlignmentSettings, Missing_key) {
+    this->writeSection("SCRIPT_NAME = Scan.py\nSTEP_SIZE = 0.05\nERASE_CSV_CONTENT = 1\nDATA_LOG_FILENAME = scan.csv\n");
+    ScanSettings settings;
+    EXPECT_FALSE(alignmentSettings::load(*conf, settings));
+}
+
+/**
+ * @brief Test case that checks that a non numeric value fails the loading.
+ *
+ */
+TEST_F(TestAlignmentSettings, Mistyped_value) {
+    this->writeSection("SCRIPT_NAME = Scan.py\nSTEP_SIZE = fast\nDURATION_ACQUISITION = 30\n"
+                       "ERASE_CSV_CONTENT = 1\nDATA_LOG_FILENAME = scan.csv\n");
+    ScanSettings settings;
+    EXPECT_FALSE(alignmentSettings::load(*conf, settings));
+}
+
+/**
+ * @brief Test case that checks that the values are validated.
+ *
+ */
+TEST_F(TestAlignmentSettings, Invalid_value) {
+    this->writeSection("SCRIPT_NAME = Scan.py\nSTEP_SIZE = -0.05\nDURATION_ACQUISITION = 30\n"
+                       "ERASE_CSV_CONTENT = 1\nDATA_LOG_FILENAME = scan.csv\n");
+    ScanSettings settings;
+    EXPECT_FALSE(alignmentSettings::load(*conf, settings));
+}
@@ -0,0 +1,170 @@
+/**
+ * @file TestConfigurationCache.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test methods of class 'ConfigurationCache'.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "Configuration.hpp"
+#include "ConfigurationCache.hpp"
+
+/**
+ * @brief Test fixture called 'TestConfigurationCache', which inherits from 'testing::Test'.
+ *
+ */
+struct TestConfigurationCache : public ::testing::Test {
+    /**
+     * @brief Create configuration file.
+     *
+     */
+    void SetUp() override {
+        this->writeFile("[Hexapod]\nnPort = 5001\n");
+    }
+    /**
+     * @brief Remove configuration file.
+     *
+     */
+    void TearDown() override {
+        conf->removeConfigurationFile("cache.ini", fullPath);
+    }
+    /**
+     * @brief Write the configuration file bypassing the class 'Configuration'.
+     *
+     * @param content content of the file.
+     */
+    void writeFile(const std::string& content) {
+        std::ofstream file(fullPath / "cache.ini", std::ios::out | std::ios::trunc);
+        file << content;
+    }
+
+    std::shared_ptr<ConfigurationCache> cache =
+        std::make_shared<ConfigurationCache>(); /**< Shared pointer to 'ConfigurationCache' Class. */
+    std::shared_ptr<Configuration> conf =
+        std::make_shared<Configuration>(cache); /**< Shared pointer to 'Configuration' Class. */
+    std::filesystem::path fullPath = conf->getPath();
+};
+
+/**
+ * @brief Test case that checks that the file is parsed only once when it does not change.
+ *
+ */
+TEST_F(TestConfigurationCache, File_parsed_once) {
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(5001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    }
+    EXPECT_EQ(1, conf->hasSection("HEXAPOD", "cache.ini", fullPath));
+    EXPECT_EQ(1, conf->hasKey("Hexapod", "NPORT", "cache.ini", fullPath));
+    EXPECT_EQ(0, conf->hasKey("Hexapod", "IP", "cache.ini", fullPath));
+    EXPECT_EQ(0, conf->hasSection("Stepper", "cache.ini", fullPath));
+    EXPECT_EQ(1u, cache->getParseCount());
+}
+
+/**
+ * @brief Test case that checks that a file modified externally is reloaded.
+ *
+ */
+TEST_F(TestConfigurationCache, File_modified_externally_is_reloaded) {
+    EXPECT_EQ(5001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    this->writeFile("[Hexapod]\nnPort = 15001\n");
+    EXPECT_EQ(15001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    EXPECT_EQ(2u, cache->getParseCount());
+}
+
+/**
+ * @brief Test case that checks that a file touched without changing its content is not parsed again.
+ *
+ */
+TEST_F(TestConfigurationCache, File_touched_is_not_parsed_again) {
+    EXPECT_EQ(5001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    std::filesystem::path path = fullPath / "cache.ini";
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+    EXPECT_EQ(5001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    EXPECT_EQ(1u, cache->getParseCount());
+}
+
+/**
+ * @brief Test case that checks that a value written through 'Configuration' is read back.
+ *
+ */
+TEST_F(TestConfigurationCache, Write_invalidates_file) {
+    EXPECT_EQ(5001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    EXPECT_EQ(1, conf->writeConfigurationFile("5002", "Hexapod", "nPort", "cache.ini", fullPath));
+    EXPECT_EQ(5002, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+}
+
+/**
+ * @brief Test case that checks that a missing file is not cached.
+ *
+ */
+TEST_F(TestConfigurationCache, Missing_file) {
+    EXPECT_EQ(0, conf->hasFile("missing.ini", fullPath));
+    EXPECT_EQ(nullptr, cache->get(fullPath / "missing.ini"));
+}
+
+/**
+ * @brief Test case that checks that a snapshot is not affected by the files modified after it has been taken.
+ *
+ */
+TEST_F(TestConfigurationCache, Snapshot_is_immutable) {
+    EXPECT_EQ(5001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    std::shared_ptr<IConfiguration> snapshot = conf->takeSnapshot();
+    this->writeFile("[Hexapod]\nnPort = 15001\n");
+    EXPECT_EQ(5001, snapshot->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    EXPECT_EQ(15001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    EXPECT_LT(snapshot->getConfigurationVersion(), conf->getConfigurationVersion());
+}
+
+/**
+ * @brief Test case that checks that a value written through a snapshot is read back by the snapshot and the cache.
+ *
+ */
+TEST_F(TestConfigurationCache, Snapshot_reads_own_writes) {
+    EXPECT_EQ(5001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    std::shared_ptr<IConfiguration> snapshot = conf->takeSnapshot();
+    EXPECT_EQ(1, snapshot->writeConfigurationFile("5002", "Hexapod", "nPort", "cache.ini", fullPath));
+    EXPECT_EQ(5002, snapshot->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    EXPECT_EQ(5002, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+}
+
+/**
+ * @brief Test case that checks that refresh() publishes a new version only when the content of a file changes.
+ *
+ */
+TEST_F(TestConfigurationCache, Refresh_publishes_new_version) {
+    EXPECT_EQ(5001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    const uint64_t version = conf->getConfigurationVersion();
+    EXPECT_FALSE(cache->refresh());
+    this->writeFile("[Hexapod]\nnPort = 15001\n");
+    EXPECT_TRUE(cache->refresh());
+    EXPECT_EQ(version + 1, conf->getConfigurationVersion());
+    EXPECT_EQ(15001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    EXPECT_EQ(2u, cache->getParseCount());
+}
+
+/**
+ * @brief Test case that checks that the watcher reloads a file modified externally.
+ *
+ */
+TEST_F(TestConfigurationCache, Watcher_reloads_file) {
+    EXPECT_EQ(5001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+    const uint64_t version = conf->getConfigurationVersion();
+    ASSERT_TRUE(conf->startWatcher(std::chrono::milliseconds(10)));
+    EXPECT_FALSE(conf->startWatcher(std::chrono::milliseconds(10)));
+    this->writeFile("[Hexapod]\nnPort = 15001\n");
+    for (int i = 0; i < 200 && conf->getConfigurationVersion() == version; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    conf->stopWatcher();
+    EXPECT_EQ(version + 1, conf->getConfigurationVersion());
+    EXPECT_EQ(15001, conf->readIntFromConfigurationFile("cache.ini", fullPath, "Hexapod", "nPort"));
+}
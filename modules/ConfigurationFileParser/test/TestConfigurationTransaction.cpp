@@ -0,0 +1,171 @@
+/**
+ * @file TestConfigurationTransaction.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test methods of class 'ConfigurationTransaction'.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Configuration.hpp"
+#include "ConfigurationTransaction.hpp"
+
+/**
+ * @brief Test fixture called 'TestConfigurationTransaction', which inherits from 'testing::Test'.
+ *
+ */
+struct TestConfigurationTransaction : public ::testing::Test {
+    /**
+     * @brief Create configuration file.
+     *
+     */
+    void SetUp() override {
+        std::ofstream file(fullPath / "transaction.ini", std::ios::out | std::ios::trunc);
+        file << "; alignment positions\n[CRYSTAL_HXP]\nALIGNMENT_POSITION_HXP_X = 0\n"
+                "; from Bragg peak search\nALIGNMENT_POSITION_HXP_W = 0\n";
+    }
+    /**
+     * @brief Remove configuration file.
+     *
+     */
+    void TearDown() override {
+        conf->removeConfigurationFile("transaction.ini", fullPath);
+    }
+    /**
+     * @brief Read the content of the configuration file.
+     *
+     * @return std::string content of the file.
+     */
+    std::string readFile() {
+        std::ifstream file(fullPath / "transaction.ini");
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+    /**
+     * @brief Check if a temporary file of a write is left in the configuration directory.
+     *
+     * @return true if a temporary file of 'transaction.ini' exists.
+     */
+    bool hasTemporaryFiles() {
+        for (const auto& entry : std::filesystem::directory_iterator(fullPath)) {
+            if (entry.path().filename().string().rfind("transaction.ini.tmp", 0) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<Configuration> conf =
+        std::make_shared<Configuration>(); /**< Shared pointer to 'Configuration' Class. */
+    std::filesystem::path fullPath = conf->getPath();
+};
+
+/**
+ * @brief Test case that checks that all the staged values are written at commit and the comments are kept.
+ *
+ */
+TEST_F(TestConfigurationTransaction, Commit_keeps_comments_and_order) {
+    ConfigurationTransaction transaction(conf, "transaction.ini", fullPath);
+    transaction.set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W", "1.5")
+               .set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_X", "-2.5")
+               .set("CRYSTAL_MEASUREMENTS", "BENDING_ANGLE", "12");
+    EXPECT_EQ(3u, transaction.size());
+    EXPECT_EQ("0", conf->readStringFromConfigurationFile("transaction.ini", fullPath, "CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W"));
+    EXPECT_EQ(1, transaction.commit());
+    EXPECT_EQ(0u, transaction.size());
+    EXPECT_FLOAT_EQ(1.5, conf->readFloatFromConfigurationFile("transaction.ini", fullPath, "CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W"));
+    EXPECT_FLOAT_EQ(-2.5, conf->readFloatFromConfigurationFile("transaction.ini", fullPath, "CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_X"));
+    EXPECT_EQ(12, conf->readIntFromConfigurationFile("transaction.ini", fullPath, "CRYSTAL_MEASUREMENTS", "BENDING_ANGLE"));
+    const std::string content = this->readFile();
+    EXPECT_NE(std::string::npos, content.find("; alignment positions"));
+    EXPECT_NE(std::string::npos, content.find("; from Bragg peak search"));
+    EXPECT_LT(content.find("ALIGNMENT_POSITION_HXP_X"), content.find("ALIGNMENT_POSITION_HXP_W"));
+    EXPECT_FALSE(this->hasTemporaryFiles());
+}
+
+/**
+ * @brief Test case that checks that the file can be regenerated from the parsed values.
+ *
+ */
+TEST_F(TestConfigurationTransaction, Commit_without_layout) {
+    ConfigurationTransaction transaction(conf, "transaction.ini", fullPath);
+    transaction.set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W", 1.5f);
+    EXPECT_EQ(1, transaction.commit(false));
+    EXPECT_EQ(std::string::npos, this->readFile().find("; alignment positions"));
+    EXPECT_FLOAT_EQ(1.5, conf->readFloatFromConfigurationFile("transaction.ini", fullPath, "CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W"));
+}
+
+/**
+ * @brief Test case that checks that the values rolled back are not written.
+ *
+ */
+TEST_F(TestConfigurationTransaction, Rollback) {
+    ConfigurationTransaction transaction(conf, "transaction.ini", fullPath);
+    transaction.set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W", "1.5");
+    transaction.rollback();
+    EXPECT_EQ(1, transaction.commit());
+    EXPECT_EQ("0", conf->readStringFromConfigurationFile("transaction.ini", fullPath, "CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W"));
+}
+
+/**
+ * @brief Test case that checks that the writers of the same file running on different threads do not overwrite
+ * each other's values (e.g. the worker threads of the devices writing config.ini).
+ *
+ */
+TEST_F(TestConfigurationTransaction, Concurrent_writers) {
+    const int nWriters = 4;
+    const int nValues = 25;
+    std::vector<std::thread> writers;
+    for (int writer = 0; writer < nWriters; writer++) {
+        writers.emplace_back([this, writer] {
+            // a separate cache, as the snapshots taken by the measurements: the file is locked for the whole process
+            auto writerConf = std::make_shared<Configuration>(std::make_shared<ConfigurationCache>());
+            const std::string section = "WRITER_" + std::to_string(writer);
+            for (int value = 0; value < nValues; value++) {
+                if (value % 2 == 0) {
+                    writerConf->writeConfigurationFile(std::to_string(value), section, "VALUE_" + std::to_string(value),
+                                                       "transaction.ini", fullPath);
+                } else {
+                    ConfigurationTransaction transaction(writerConf, "transaction.ini", fullPath);
+                    transaction.set(section, "VALUE_" + std::to_string(value), std::to_string(value))
+                               .set(section, "LAST", std::to_string(value));
+                    transaction.commit();
+                }
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    for (int writer = 0; writer < nWriters; writer++) {
+        const std::string section = "WRITER_" + std::to_string(writer);
+        for (int value = 0; value < nValues; value++) {
+            EXPECT_EQ(value, conf->readIntFromConfigurationFile("transaction.ini", fullPath, section, "VALUE_" + std::to_string(value)));
+        }
+        EXPECT_EQ(nValues - 2, conf->readIntFromConfigurationFile("transaction.ini", fullPath, section, "LAST"));
+    }
+    EXPECT_NE(std::string::npos, this->readFile().find("; alignment positions"));
+    EXPECT_FALSE(this->hasTemporaryFiles());
+}
+
+/**
+ * @brief Test case that checks that nothing is written if the configuration file does not exist.
+ *
+ */
+TEST_F(TestConfigurationTransaction, Missing_file) {
+    ConfigurationTransaction transaction(conf, "missing.ini", fullPath);
+    transaction.set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W", "1.5");
+    EXPECT_EQ(0, transaction.commit());
+    EXPECT_FALSE(std::filesystem::exists(fullPath / "missing.ini"));
+}
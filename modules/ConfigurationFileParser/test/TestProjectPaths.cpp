@@ -0,0 +1,53 @@
+/**
+ * @file TestProjectPaths.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test methods of class 'ProjectPaths'.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+
+#include "ProjectPaths.hpp"
+
+/**
+ * @brief Test case that checks that the directories are resolved from a path inside the project.
+ *
+ */
+TEST(TestProjectPaths, Resolve_from_path_inside_project) {
+    const std::filesystem::path root = std::filesystem::path("work") / "XRay_Machine";
+    ProjectPaths projectPaths = ProjectPaths::resolve(root / "build" / "bin");
+    EXPECT_EQ(root, projectPaths.getRoot());
+    EXPECT_EQ(root / "ConfigurationFiles", projectPaths.getConfigurationDirectory());
+    EXPECT_EQ(root / "LogFiles", projectPaths.getLogDirectory());
+    EXPECT_EQ(root / "LogFiles" / "DeviceScans", projectPaths.getScanDirectory());
+    EXPECT_EQ(root / "LogFiles" / "Spectra", projectPaths.getSpectraDirectory());
+    EXPECT_EQ(root / "LogFiles" / "CrystalAlignmentResults", projectPaths.getResultsDirectory("Crystal"));
+    EXPECT_EQ(root / "modules" / "Devices" / "scripts", projectPaths.getScriptsDirectory());
+}
+
+/**
+ * @brief Test case that checks that the root is empty if the project is not in the path.
+ *
+ */
+TEST(TestProjectPaths, Resolve_outside_project) {
+    EXPECT_TRUE(ProjectPaths::resolve(std::filesystem::path("work") / "build").getRoot().empty());
+}
+
+/**
+ * @brief Test case that checks that the directories shared by the process can be replaced.
+ *
+ */
+TEST(TestProjectPaths, Shared_paths_injected) {
+    std::shared_ptr<const ProjectPaths> previous = ProjectPaths::getShared();
+    EXPECT_EQ(previous, ProjectPaths::getShared());
+    auto injected = std::make_shared<const ProjectPaths>(std::filesystem::path("XRay_Machine_test"));
+    ProjectPaths::setShared(injected);
+    EXPECT_EQ(std::filesystem::path("XRay_Machine_test") / "LogFiles", ProjectPaths::getShared()->getLogDirectory());
+    ProjectPaths::setShared(previous);
+}
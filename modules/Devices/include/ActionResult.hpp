@@ -0,0 +1,54 @@
+/**
+ * @file ActionResult.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class used by the state machines of the devices to run each guarded action only once.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+/**
+ * @class ActionResult
+ * @brief Class storing the result of the action run by a guard of a transition table.
+ *
+ * An action that can fail is encoded with two transitions for the same event: the first one runs the action in its guard
+ * and stores the result, the second one (to systemError) checks the stored result. Since sml evaluates the guards in the
+ * order of the transition table, the action runs once, while calling it in both guards would repeat it after a failure.
+ *
+ * @code
+ * state<systemInMotion> + event<eventStartScan> [([this] { return lastAction_.store(actions_->startScan()); })] = state<systemConnected>,
+ * state<systemInMotion> + event<eventStartScan> [([this] { return lastAction_.failed(); })] = state<systemError>,
+ * @endcode
+ *
+ */
+class ActionResult {
+ public:
+  /**
+   * @brief Store the result of an action.
+   *
+   * @param succeeded result of the action.
+   * @return true if the action succeeded.
+   * @return false otherwise.
+   */
+  bool store(bool succeeded) const noexcept {
+    succeeded_ = succeeded;
+    return succeeded;
+  }
+  /**
+   * @brief Check if the last stored action failed.
+   *
+   * @return true if the action failed.
+   * @return false otherwise.
+   */
+  bool failed() const noexcept {
+    return !succeeded_;
+  }
+
+ private:
+  mutable bool succeeded_ = false;  /**< Result of the last action (the guards of sml are const). */
+};
@@ -65,13 +65,16 @@ class AutocollimatorDeviceController : public ISingleStepperDeviceController {
                    bool eraseCsvContent,
                    bool showPlot) override;
   bool stop() override;
+  std::shared_ptr<DeviceCommand> submitCommand(const std::string& name, std::function<bool()> command) override;
+  std::shared_ptr<DeviceCommand> submitStop() override;
   std::string getFsmState() override;
+  DeviceStateSnapshot getStateSnapshot() override;
+  size_t addStateListener(DeviceStateMonitor::Listener listener) override;
+  void removeStateListener(size_t id) override;
   /**
-   * @brief This method returns the current status of the Autocollimator device.
+   * @brief This method returns the status published by the worker thread of the device after the last event.
    * 
-   * @details first checks the current state of the state machine associated with the device using Boost.SML library.
-   * Depending on the current state of the state machine, the method sets the corresponding AutocollimatorStatus.
-   * If the state of the state machine is not recognized or defined, the method sets the status to "NotInitialized".
+   * @details it is a single atomic load: it can be called by any thread while a command is running.
    * 
    * @return AutocollimatorStatus 
    */
@@ -111,11 +114,44 @@ class AutocollimatorDeviceController : public ISingleStepperDeviceController {
   bool setupForCrystalBraggPeakSearch() override;
 
  private:
+  /**
+   * @brief Method used to process the event 'eventStopMovement' on the worker thread of the device.
+   * 
+   * @param interrupted true if the stop has interrupted a running command: its failed action does not leave the device in
+   * state 'systemError'.
+   * @return false if after the execution of the event the FSM is not in state 'systemConnected'.
+   * @return true otherwise.
+   */
+  bool stopMovement(bool interrupted);
+  /**
+   * @brief This method reads the current status of the Autocollimator device.
+   * 
+   * @details first checks the current state of the state machine associated with the device using Boost.SML library.
+   * Depending on the current state of the state machine, the method sets the corresponding AutocollimatorStatus.
+   * If the state of the state machine is not recognized or defined, the method sets the status to "NotInitialized".
+   * 
+   * @return AutocollimatorStatus 
+   */
+  AutocollimatorStatus readStatus();
+  /**
+   * @brief Method used to process an event on the worker thread of the device and to publish the new state.
+   * 
+   * @tparam Event type of the event.
+   * @param event event processed by the state machine.
+   */
+  template <typename Event>
+  void processEvent(const Event& event) {
+    sMachine_.process_event(event);
+    stateMonitor_.publish(static_cast<int>(this->readStatus()));
+  }
+
   std::filesystem::path logFilePath_;  /**< Path to the file where the log file is saved. */
   AutocollimatorStatus autocollimatorStatus_; /**< Object of type 'AutocollimatorStatus'. */
   std::shared_ptr<Actions> actionsPtr_;  /**< Shared pointer to Class Actions. */
   std::shared_ptr<scanning::IScanning> scanningPtr_;  /**< Shared pointer to Class IScanning. */
   boost::sml::sm<System> sMachine_;  /**<  State machine object. */
+  DeviceStateMonitor stateMonitor_;  /**< State of the device published after every event, read by the other threads without locking. */
+  DeviceCommandQueue commandQueue_;  /**< Queue of the commands, the only thread using the state machine (destroyed first). */
 };
 
 }  // namespace autocollimator
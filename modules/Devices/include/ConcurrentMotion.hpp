@@ -0,0 +1,82 @@
+/**
+ * @file ConcurrentMotion.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class moving the axes of independent motor controllers at the same time.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class ConcurrentMotion
+ * @brief Class issuing the movements of independent motor controllers together and joining them on completion.
+ *
+ * Every movement blocks until its axis stops (e.g. IHXP::setPositionAbsolute, IMotor::moveCalibratedMotor). The axes
+ * driven by separate controllers (the XPS of the hexapod and the XIMC controllers of the steppers) can move at the same
+ * time, so the movement lasts as long as the slowest axis instead of the sum of all the movements. The movements must not
+ * share a controller.
+ *
+ * @code
+ * ConcurrentMotion motion("Crystal");
+ * motion.add("hexapod", [this] { return this->setHxpPositionAbsolute(); });
+ * motion.add("stepper", [this] { return this->moveCalibratedMotor(); });
+ * bool result = motion.run();  // false if one of the axes failed, see getFailedAxes()
+ * @endcode
+ *
+ */
+class ConcurrentMotion {
+ public:
+  ConcurrentMotion() = delete;
+  /**
+   * @brief Construct a new ConcurrentMotion object.
+   *
+   * @param device name of the device (used in the logs).
+   */
+  explicit ConcurrentMotion(const std::string& device);
+  /**
+   * @brief Add the movement of an axis.
+   *
+   * @param axis name of the axis (used in the logs and in the failed axes).
+   * @param movement function moving the axis and waiting for its stop: it returns false (or throws) if the movement failed.
+   */
+  void add(const std::string& axis, std::function<bool()> movement);
+  /**
+   * @brief Start all the movements together and wait for the end of all of them, also when one of them fails.
+   *
+   * @return true if all the movements succeeded.
+   * @return false otherwise.
+   */
+  bool run();
+  /**
+   * @brief Get the axes whose movement failed during the last run.
+   *
+   * @return std::vector<std::string> names of the axes.
+   */
+  std::vector<std::string> getFailedAxes() const;
+
+ private:
+  /**
+   * @brief Run the movement of an axis, catching its exceptions.
+   *
+   * @param index index of the movement.
+   * @return true if the movement succeeded.
+   * @return false otherwise.
+   */
+  bool move(size_t index) const;
+
+  std::string device_;  /**< Name of the device. */
+  std::vector<std::string> axes_;  /**< Names of the axes. */
+  std::vector<std::function<bool()>> movements_;  /**< Movements of the axes. */
+  std::vector<std::string> failedAxes_;  /**< Axes whose movement failed during the last run. */
+};
@@ -15,14 +15,33 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "IHXP.hpp"
 #include "IMotor.hpp"
 #include "IScanning.hpp"
 #include "ISensors.hpp"
 #include "IConfiguration.hpp"
+#include "ProjectPaths.hpp"
+#include "ConfigurationTransaction.hpp"
 #include "IPostProcessing.hpp"
+#include "ConcurrentMotion.hpp"
+#include "AnalysisBatch.hpp"
+#include "CrystalAngles.hpp"
+#include "Crystal/AlignmentCache.hpp"
+#include "Crystal/HexapodMotionPlanner.hpp"
+#include "Crystal/MeasurementCheckpoint.hpp"
+#include "Crystal/AlignmentProcedureSettings.hpp"
+#include "Crystal/MeasurementSettings.hpp"
+#include "Crystal/PivotPoint.hpp"
 
 using namespace scanning;  // NOLINT
 using namespace sensors;  // NOLINT
@@ -118,6 +137,13 @@ class Actions {
    * @return false otherwise.
    */
   bool stop();
+  /**
+   * @brief Set the function telling the multi-step actions that the running command has been preempted by a stop: they end
+   * before their next step and fail.
+   * 
+   * @param isCancelled function returning true when the running command has been preempted.
+   */
+  void setCancellationCheck(std::function<bool()> isCancelled);
   /**
    * @brief Method used to start a scan of one of the axes of the hexapod that controls the pose of the crystal.
    * 
@@ -139,11 +165,42 @@ class Actions {
    * @param stepperPosition float representing to be set to the private parameter 'stepperPosition_'.
    */
   void setStepperPosition(float stepperPosition);
+  /**
+   * @brief Setter function of the settings of the bending angle measurement, loaded and validated when the measurement starts.
+   * 
+   * @param settings settings of the bending angle measurement.
+   */
+  void setBendingAngleSettings(const BendingAngleSettings& settings);
+  /**
+   * @brief Setter function of the settings of the miscut angle measurement, loaded and validated when the measurement starts.
+   * 
+   * @param settings settings of the miscut angle measurement.
+   */
+  void setMiscutAngleSettings(const MiscutAngleSettings& settings);
+  /**
+   * @brief Setter function of the settings of the torsion angle measurement, loaded and validated when the measurement starts.
+   * 
+   * @param settings settings of the torsion angle measurement.
+   */
+  void setTorsionAngleSettings(const TorsionAngleSettings& settings);
+  /**
+   * @brief Setter function of the version of the configuration snapshot used by the measurement, recorded in the measurement index.
+   * 
+   * @param configurationVersion version of the configuration.
+   */
+  void setConfigurationVersion(uint64_t configurationVersion);
+  /**
+   * @brief Getter function of the version of the configuration snapshot used by the last measurement.
+   * 
+   * @return uint64_t version of the configuration, 0 if no measurement has been started.
+   */
+  uint64_t getConfigurationVersion();
   /**
    * @brief Method used to move to a target position the hexapod robot and the stepper motor that control the rotation of the crystal.
    * 
    * @note Before calling this method the private parameter 'hxpCoord_' (structure variable of type HxpCoordinates of Class 'HXP') 
    * and the private parameter 'stepperPosition_' (of this Class) must be set.
+   * The two movements are issued together (see 'ConcurrentMotion') and the method returns when both have ended.
    * 
    * @return true if the movements were successfull.
    * @return false otherwise.
@@ -164,6 +221,9 @@ class Actions {
   * 7. The function sets the X-coordinate of the object named 'clientHxp_' to the new X-axis alignment position.
   * 8. The function calls the 'setHxpPositionAbsolute' function wich sets the position of the HXP to the new alignment position.
   * 
+  * @note The X-axis alignment starts a new alignment sequence: the cached alignment of the mounted crystal is verified again
+  * (see 'reuseCachedAlignment'). If it is confirmed, the steps 2-7 are skipped by all the alignments of the sequence.
+  * 
   * @return true if the alignment has been executed correctly.
   * @return false otherwise.
   */
@@ -198,6 +258,8 @@ class Actions {
   * @brief This method is used to check the alignment of the crystal on the horizontal (Y) axis.
   * 
   * This alignment check is performed by a movement in steps of the crystal on the Y-axis of the hexapd followed by a scan on the W-axis.
+  * It is not executed when the pivot point is enabled (section 'Pivot_Point_CRYSTAL_STAGE'): the W-axis then rotates
+  * about the impact point of the beam on the crystal.
   * 
   * @details
   * 1. The 'moveBothMotors' function is called to move the stepper motor and the hexapod to the initial positons;
@@ -207,7 +269,8 @@ class Actions {
   *    of the object named clientScanningHXP_ is called;
   * 5. For every movement performed on the y-axis the 'executeScript5' function of the
   *    object named 'clientPostProcessing_' is also called;
-  * 6. At the end of the motion in steps the alignment on the y-axis is checked;
+  * 6. At the end of the motion in steps the alignment on the y-axis is checked: the column 'Standard Deviation of slopes'
+  *    of the result file must be found and below 'THRESHOLD_STD_DEVIATION';
   * 9. The function calls the 'setHxpPositionAbsolute' function wich sets the position of the HXP to the new alignment position.
   * 
   * @return true if the alignment has been executed correctly.
@@ -228,6 +291,7 @@ class Actions {
   * 6. The function then reads the new w-axis position from the .csv file and writes it in a .ini configuration file.
   * 7. The function sets the W-coordinate of the object named 'clientHxp_' to the new W-axis alignment position.
   * 8. The function calls the 'setHxpPositionAbsolute' function wich sets the position of the HXP to the new alignment position.
+  * 9. The aligned pose is stored in the alignment cache of the mounted crystal.
   * 
   * @return true if the alignment has been executed correctly.
   * @return false otherwise.
@@ -291,7 +355,7 @@ class Actions {
    * 2. The stepper motor position is set to zero;
    * 3. Both motors are moved using the 'moveBothMotors' function,
    *    and the result is stored in 'result_movement';
-   * 4. The x-axis is re-aligned using the searchXAxisAlignmentCrystal function,
+   * 4. The x-axis is re-aligned using the runXAxisAlignment function,
    *    which returns a boolean value indicating whether the alignment was successful.
    *    If the result is false, the method returns false, indicating failure;
    * 5. The y-axis is re-aligned using the searchYAxisFineAlignment function,
@@ -318,13 +382,16 @@ class Actions {
   * @details 
   * 1. The Hexapod and the stepper motor are moved to the predefined initial positions;
   * 2. The .csv files used to register the result of the alignment are set-up;
-  * 3. The range of the scan and step size to execute on the Y-axis are read from the configuration file;
+  * 3. The range of the scan and step size to execute on the Y-axis are taken from the settings loaded when the measurement starts;
   * 4. For every movement performed on the y-axis the 'scan' method (that performs a scan in the W axis direction)
   *    of the object named clientScanningHXP_ is called;
-  * 5. For every movement performed on the y-axis the 'executeScript6' function of the
-  *    object named 'clientPostProcessing_' is also called;
-  * 6. At the end of the motion in steps on the y-axis the beding angle is read from a .csv file
-  *    and written in the configuration file;
+  * 5. For every movement performed on the y-axis the Bragg peak is found in the points of the scan
+  *    and saved in the .csv file of the peaks;
+  * 6. At the end of the motion in steps on the y-axis the bending angle is computed from a linear fit of the Bragg angles as a function of the Y positions,
+  *    with its bootstrap uncertainty, and written in the .csv result and in the configuration file;
+  * 
+  * @note The completed steps on the y-axis are stored in a checkpoint file (see 'MeasurementCheckpoint').
+  * If the measurement fails or is stopped, the next call with the same parameters skips the steps already completed.
   * 
   * @return true if the measurement has been executed correctly.
   * @return false otherwise.
@@ -339,13 +406,16 @@ class Actions {
   @details 
   * 1. The Hexapod and the stepper motor are moved to the predefined initial positions;
   * 2. The .csv files used to register the result of the alignment are set-up;
-  * 3. The range of the scan and step size to execute on the Y-axis are read from the configuration file;
+  * 3. The range of the scan and step size to execute on the Y-axis are taken from the settings loaded when the measurement starts;
   * 4. For every movement performed on the y-axis the 'scan' method (that performs a scan in the W axis direction)
   *    of the object named clientScanningHXP_ is called;
-  * 5. For every movement performed on the y-axis the 'executeScript7' function of the
-  *    object named 'clientPostProcessing_' is also called;
-  * 6. At the end of the motion in steps on the y-axis the miscut angle is read from a .csv file
-  *    and written in the configuration file;
+  * 5. For every movement performed on the y-axis the Bragg peak is found in the points of the scan
+  *    and saved in the .csv file of the peaks;
+  * 6. At the end of the motion in steps on the y-axis the miscut angle is computed from the half differences with the Bragg angles of the bending angle measurement,
+  *    with its bootstrap uncertainty, and written in the .csv result and in the configuration file;
+  * 
+  * @note The completed steps on the y-axis are stored in a checkpoint file (see 'MeasurementCheckpoint').
+  * If the measurement fails or is stopped, the next call with the same parameters skips the steps already completed.
   * 
   * @return true if the measurement has been executed correctly.
   * @return false otherwise.
@@ -360,13 +430,16 @@ class Actions {
   @details 
   * 1. The Hexapod and the stepper motor are moved to the predefined initial positions;
   * 2. The .csv files used to register the result of the alignment are set-up;
-  * 3. The range of the scan and step size to execute on the Z-axis are read from the configuration file;
+  * 3. The range of the scan and step size to execute on the Z-axis are taken from the settings loaded when the measurement starts;
   * 4. For every movement performed on the Z-axis the 'scan' method (that performs a scan in the W axis direction)
   *    of the object named clientScanningHXP_ is called;
-  * 5. For every movement performed on the Z-axis the 'executeScript7' function of the
-  *    object named 'clientPostProcessing_' is also called;
-  * 6. At the end of the motion in steps on the Z-axis the torsion angle is read from a .csv file
-  *    and written in the configuration file;
+  * 5. For every movement performed on the Z-axis the Bragg peak is found in the points of the scan
+  *    and saved in the .csv file of the peaks;
+  * 6. At the end of the motion in steps on the Z-axis the torsion angle is computed from a linear fit of the Bragg angles as a function of the Z positions,
+  *    with its bootstrap uncertainty, and written in the .csv result and in the configuration file;
+  * 
+  * @note The completed steps on the Z-axis are stored in a checkpoint file (see 'MeasurementCheckpoint').
+  * If the measurement fails or is stopped, the next call with the same parameters skips the steps already completed.
   * 
   * @return true if the measurement has been executed correctly.
   * @return false otherwise.
@@ -374,6 +447,183 @@ class Actions {
   bool torsionAngleMeasurement();
 
  private:
+  /**
+   * @brief Check if the running command has been preempted by a stop.
+   * 
+   * @return true if the action must end before its next step.
+   * @return false otherwise.
+   */
+  bool isCancelled() const;
+  /**
+   * @brief Execute the alignment on the X axis, without checking the alignment cache.
+   * Used by the alignments that contain X alignments (Y axis alignment and re-alignment), so that the cached
+   * alignment is verified and reused only at the start of the requested alignment.
+   * 
+   * @param settings settings of the alignment on the X axis.
+   * @return true if the crystal has been aligned and moved to the X alignment position.
+   * @return false otherwise.
+   */
+  bool runXAxisAlignment(const XAxisAlignmentSettings& settings);
+  /**
+   * @brief Get the target coordinates of the hexapod.
+   * 
+   * @return HxpPose structure containing the coordinates of the 6 axes.
+   */
+  HxpPose getHxpPose();
+  /**
+   * @brief Get the path to the checkpoint file of a measurement.
+   * 
+   * @param measurementName name of the measurement (section of the alignment settings file).
+   * @return std::filesystem::path path to the checkpoint file.
+   */
+  std::filesystem::path getPathToCheckpointFile(const std::string& measurementName);
+  /**
+   * @brief Move the hexapod through the steps of a measurement along one axis and execute a step at each position.
+   * The positions are visited by the HexapodMotionPlanner (section 'Hexapod_Motion_CRYSTAL_STAGE'), each of them with a
+   * single absolute movement that also returns the W axis to its initial position. The completed steps are skipped.
+   * When the pivot point is enabled (section 'Pivot_Point_CRYSTAL_STAGE'), the W scans rotate the crystal about the
+   * impact point of the beam and the positions of the axis refer to it.
+   * 
+   * @param measurementName name of the measurement (section of the alignment settings file).
+   * @param checkpoint checkpoint of the measurement.
+   * @param axis coordinate of the hexapod moved by the measurement.
+   * @param getPosition method of IHXP reading the current position of the axis.
+   * @param stepSize step size of the measurement.
+   * @param range range of the measurement.
+   * @param step function executed at each position (iteration of the measurement, position of the axis).
+   * @return true if all the steps have been executed correctly.
+   * @return false otherwise.
+   */
+  bool runMeasurementSteps(const char* measurementName,
+                           const MeasurementCheckpoint& checkpoint,
+                           double HxpPose::*axis,
+                           double (IHXP::*getPosition)(),
+                           float stepSize,
+                           float range,
+                           const std::function<bool(int iteration, double position)>& step);
+  /**
+   * @brief Get the key of the mounted crystal in the alignment cache, built from the keys CRYSTAL_ID and MOUNT_ID
+   * of the section CRYSTAL_MEASUREMENTS of the configuration file.
+   * 
+   * @return std::string key of the mounted crystal (empty if the crystal is not identified).
+   */
+  std::string getAlignmentCacheKey();
+  /**
+   * @brief Find the cached alignment of the mounted crystal.
+   * 
+   * @param settings struct where the settings of the cache are stored.
+   * @param entry struct where the cached alignment is stored.
+   * @return true if the cache is enabled and contains a recent alignment of the mounted crystal.
+   * @return false otherwise.
+   */
+  bool findCachedAlignment(AlignmentCacheSettings& settings, AlignmentCacheEntry& entry);
+  /**
+   * @brief Use the cached alignment of the mounted crystal instead of executing an alignment.
+   * 
+   * The first alignment of a sequence verifies the cached alignment with a short scan on the W axis around the cached Bragg angle
+   * (see 'verifyCachedAlignment'). If the Bragg peak is found within the tolerance, the cached positions are written
+   * in the configuration file and the crystal is moved to the cached pose; otherwise the alignments of the sequence are executed.
+   * 
+   * @param alignmentName name of the alignment, used in the logs.
+   * @param fineYAlignment true if the alignment requires the result of the fine alignment on the Y axis.
+   * @return true if the cached alignment has been reused.
+   * @return false if the alignment must be executed.
+   */
+  bool reuseCachedAlignment(const std::string& alignmentName, bool fineYAlignment);
+  /**
+   * @brief Execute the verification scan of a cached alignment.
+   * 
+   * The parameters of the scan and the target coordinates set by the controller for the requested alignment are restored at the end,
+   * so that the alignment can be executed if the cached alignment is not confirmed.
+   * 
+   * @param entry cached alignment.
+   * @param settings settings of the cache.
+   * @return true if the Bragg peak confirms the cached alignment.
+   * @return false otherwise.
+   */
+  bool verifyCachedAlignment(const AlignmentCacheEntry& entry, const AlignmentCacheSettings& settings);
+  /**
+   * @brief Store the current pose in the alignment cache of the mounted crystal, at the end of the Bragg peak search.
+   * 
+   */
+  void storeCachedAlignment();
+  /**
+   * @brief Update the Y coordinate of the cached alignment with the result of the fine alignment on the Y axis.
+   * 
+   */
+  void updateCachedFineYAlignment();
+  /**
+   * @brief Record a measurement in the measurement index.
+   * 
+   * @param measurementName name of the measurement (section of the alignment settings file).
+   * @param startTime beginning of the measurement (seconds since epoch).
+   * @param result result of the measurement, with its uncertainty.
+   * @param pathToResult path to the .csv file containing the result (empty if no result has been written: the measurement
+   * is then recorded as not completed). The entry refers to the archived copy of the file (see MeasurementIndex::archive).
+   * @param pathToPeaks path to the .csv file of the Bragg peaks, archived as well (parameter 'PEAKS' of the entry).
+   * @param parameters parameters of the measurement.
+   */
+  void recordMeasurement(const std::string& measurementName,
+                         double startTime,
+                         const analysis::AngleEstimate& result,
+                         const std::string& pathToResult,
+                         const std::string& pathToPeaks,
+                         const MeasurementCheckpointParameters& parameters);
+  /**
+   * @brief Copy the data log of the last scan, so that its analysis can run while the next scan overwrites the data log.
+   * 
+   * @param dataLogFilename name of the .csv file where the data of the scan are logged.
+   * @param iteration iteration of the scan.
+   * @return std::filesystem::path path to the copy (empty if the copy failed).
+   */
+  std::filesystem::path preserveScanDataLog(const std::string& dataLogFilename, int iteration);
+  /**
+   * @brief Find the Bragg peak in the rocking curve of the last scan of the hexapod (counts as a function of the W axis).
+   * 
+   * @return analysis::Peak Bragg peak (the centre is the Bragg angle).
+   */
+  analysis::Peak findBraggPeak();
+  /**
+   * @brief Create the .csv file of the Bragg peaks of a measurement, containing only the header.
+   * 
+   * @param pathToPeaks path to the .csv file of the Bragg peaks.
+   * @param columnNames names of the columns.
+   * @return true if the file has been created.
+   * @return false otherwise.
+   */
+  bool createPeaksFile(const std::string& pathToPeaks, const std::vector<std::string>& columnNames);
+  /**
+   * @brief Append a Bragg peak to the .csv file of the Bragg peaks of a measurement.
+   * 
+   * @param pathToPeaks path to the .csv file of the Bragg peaks.
+   * @param values values of the row, in the order of the columns.
+   * @return true if the row has been written.
+   * @return false otherwise.
+   */
+  bool appendPeak(const std::string& pathToPeaks, const std::vector<double>& values);
+  /**
+   * @brief Read a column of the .csv file of the Bragg peaks of a measurement.
+   * 
+   * @param pathToPeaks path to the .csv file of the Bragg peaks.
+   * @param columnName name of the column.
+   * @return std::vector<double> values of the column (empty if the column is not found).
+   */
+  std::vector<double> readPeaks(const std::string& pathToPeaks, const std::string& columnName);
+  /**
+   * @brief Write an estimated angle and its uncertainty in the .csv result and in the configuration file.
+   * If the angle could not be estimated (e.g. too few Bragg peaks) nothing is written.
+   * 
+   * @param angle estimated angle.
+   * @param keyName key of the angle in the section CRYSTAL_MEASUREMENTS (the uncertainty is written in keyName_UNCERTAINTY).
+   * @param columnName name of the column of the angle in the .csv result.
+   * @param pathToResult path to the .csv result.
+   * @return true if the angle has been written.
+   * @return false if the angle could not be estimated or writing failed.
+   */
+  bool saveAngleEstimate(const analysis::AngleEstimate& angle,
+                         const std::string& keyName,
+                         const std::string& columnName,
+                         const std::string& pathToResult);
   std::shared_ptr<IHXP> clientHxp_;  /**< Shared pointer to IHXP Class*/
   std::shared_ptr<IMotor> clientStepper_;  /**< Shared pointer to IMotor Class*/
   std::shared_ptr<scanning::IScanning> clientScanningHXP_;  /**< Shared pointer to IScanning Class*/
@@ -396,12 +646,31 @@ class Actions {
         float CoordW = 0;
   };
   float crystalWidth_;  /**< Crystal Width is read from the configuration file. */
+  BendingAngleSettings bendingAngleSettings_;  /**< Settings of the bending angle measurement. */
+  MiscutAngleSettings miscutAngleSettings_;  /**< Settings of the miscut angle measurement. */
+  TorsionAngleSettings torsionAngleSettings_;  /**< Settings of the torsion angle measurement. */
+  analysis::BootstrapSettings bootstrapSettings_;  /**< Settings of the bootstrap of the uncertainties of the measured angles. */
+  uint64_t configurationVersion_ = 0;  /**< Version of the configuration snapshot used by the last measurement. */
   HxpAlignmentCoordinates hxpAlignmentCoord_;  /**< Structure variable of type HxpAlignmentCoordinates. */
-  std::filesystem::path pathToProjDirectory_ = clientSensors_->getPathToProjDirectory();  /**< Path to the project directory. */
-  std::filesystem::path pathToScriptDirectory_ = pathToProjDirectory_ / "modules\\Devices\\scripts\\Crystal";  /**< Path to the directory where all the scripts to perform the alignments and measurements are contained. */
-  std::filesystem::path pathToScriptMeasurementsDirectory_ = pathToProjDirectory_ / "modules\\Devices\\scripts\\Crystal\\Measurements";  /**< Path to the directory where all the scripts to perform the measurements are contained. */
+  /**
+   * @brief State of the verification of the cached alignment in the current alignment sequence.
+   * 
+   */
+  enum class AlignmentCacheState {
+        NotVerified,
+        Confirmed,
+        Rejected
+  };
+  std::unique_ptr<AlignmentCache> alignmentCache_;  /**< Alignment positions of the mounted crystals. */
+  std::string alignmentCacheKey_;  /**< Key of the crystal mounted during the last alignment. */
+  AlignmentCacheState alignmentCacheState_ = AlignmentCacheState::NotVerified;  /**< Result of the verification scan of the cached alignment. */
+  ProjectPaths projectPaths_{clientSensors_->getPathToProjDirectory()};  /**< Directories of the project. */
+  std::filesystem::path pathToScriptDirectory_ = projectPaths_.getScriptsDirectory() / "Crystal";  /**< Path to the directory where all the scripts to perform the alignments and measurements are contained. */
+  std::filesystem::path pathToScriptMeasurementsDirectory_ = projectPaths_.getScriptsDirectory() / "Crystal" / "Measurements";  /**< Path to the directory where all the scripts to perform the measurements are contained. */
   std::filesystem::path crystalAlignmentResultsDirectoryName_ = "CrystalAlignmentResults";  /**< Name of the directory where to save the results of the alignments and measurements. */
-  std::string pathToCrystalAlinmentResultsDirectory_;  /**< Path to the directory where to save the results of the alignments and measurements. */
+  std::filesystem::path pathToCrystalAlinmentResultsDirectory_;  /**< Path to the directory where to save the results of the alignments and measurements. */
+  std::filesystem::path alignmentCacheFilename_ = "Alignment_Cache.ini";  /**< Name of the file of the alignment cache, in the directory of the results of the alignments. */
+  std::function<bool()> isCancelled_;  /**< Function telling if the running command has been preempted by a stop. */
 };
 
 }  // namespace crystal
@@ -0,0 +1,165 @@
+/**
+ * @file Crystal/AlignmentCache.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class used to store the alignment positions of the mounted crystals, so that a crystal aligned recently can skip the full alignment.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#ifndef MODULES_DEVICES_INCLUDE_CRYSTAL_ALIGNMENTCACHE_HPP_
+#define MODULES_DEVICES_INCLUDE_CRYSTAL_ALIGNMENTCACHE_HPP_
+
+#include <ini.h>
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <string>
+#include <tuple>
+
+#include "AlignmentSettings.hpp"
+#include "ScanAnalysis.hpp"
+#include "Crystal/MeasurementCheckpoint.hpp"
+
+namespace crystal {
+
+/**
+ * @struct AlignmentCacheSettings
+ * @brief Struct containing the settings of the alignment cache and of its verification scan (section 'Alignment_Cache_CRYSTAL_STAGE').
+ *
+ */
+struct AlignmentCacheSettings {
+  static constexpr const char* kSection = "Alignment_Cache_CRYSTAL_STAGE";
+  bool enabled = false;  /**< False to always execute the full alignments. */
+  float maxAge = 0;  /**< Maximum age of a cached alignment [h]. */
+  float stepSize = 0;  /**< Step size of the verification scan on the W axis. */
+  float range = 0;  /**< Range of the verification scan, centred on the cached Bragg angle. */
+  int durationAcquisition = 0;  /**< Duration of the acquisition of every point of the verification scan [s]. */
+  std::string dataLogFilename;  /**< Name of the .csv file where the data of the verification scan are logged. */
+  float toleranceHxpW = 0;  /**< Maximum distance between the Bragg peak found by the verification scan and the cached Bragg angle. */
+  float minPeakRatio = 0;  /**< Minimum ratio between the Bragg peak found by the verification scan and the cached one (counts per second). */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("ENABLED", &AlignmentCacheSettings::enabled),
+                           settingsField("MAX_AGE", &AlignmentCacheSettings::maxAge),
+                           settingsField("STEP_SIZE", &AlignmentCacheSettings::stepSize),
+                           settingsField("RANGE", &AlignmentCacheSettings::range),
+                           settingsField("DURATION_ACQUISITION", &AlignmentCacheSettings::durationAcquisition),
+                           settingsField("DATA_LOG_FILENAME", &AlignmentCacheSettings::dataLogFilename),
+                           settingsField("TOLERANCE_HXP_W", &AlignmentCacheSettings::toleranceHxpW),
+                           settingsField("MIN_PEAK_RATIO", &AlignmentCacheSettings::minPeakRatio));
+  }
+  /**
+   * @brief Check the values read from the alignment settings file.
+   *
+   * @return true if the verification scan is not empty and the tolerances are positive.
+   * @return false otherwise.
+   */
+  bool isValid() const {
+    return maxAge > 0 && stepSize > 0 && range > 0 && durationAcquisition > 0 && toleranceHxpW > 0 &&
+           minPeakRatio >= 0 && minPeakRatio <= 1;
+  }
+};
+
+/**
+ * @struct AlignmentCacheEntry
+ * @brief Struct containing the result of the alignment of a mounted crystal.
+ *
+ */
+struct AlignmentCacheEntry {
+  HxpPose pose;  /**< Hexapod coordinates at the end of the alignment (the W coordinate is the Bragg angle). */
+  float stepperPosition = 0;  /**< Position of the stepper motor during the alignment. */
+  double braggPeakRate = 0;  /**< Value of the Bragg peak at the aligned pose, divided by the duration of the acquisition [counts/s]. */
+  bool fineYAlignment = false;  /**< True if the Y coordinate is the result of the fine alignment on the Y axis. */
+  double timestamp = 0;  /**< End of the alignment (seconds since epoch). */
+};
+
+/**
+ * @class AlignmentCache
+ * @brief Class used to store the alignment positions of the mounted crystals in a .ini file.
+ *
+ * Every entry is identified by the crystal id and by the mount. Before an entry is reused, the alignment must be confirmed
+ * by a short scan on the W axis around the cached Bragg angle (see 'isConfirmed').
+ */
+class AlignmentCache {
+ public:
+  AlignmentCache() = delete;
+  /**
+   * @brief Construct a new AlignmentCache object.
+   *
+   * @param pathToCacheFile path to the .ini file where the cache is stored.
+   */
+  explicit AlignmentCache(std::filesystem::path pathToCacheFile);
+  /**
+   * @brief Destroy the AlignmentCache object.
+   *
+   */
+  ~AlignmentCache();
+  /**
+   * @brief Build the key of a mounted crystal.
+   *
+   * @param crystalId id of the crystal.
+   * @param mountId id of the mount of the crystal.
+   * @return std::string key of the entry (empty if the crystal is not identified).
+   */
+  static std::string makeKey(const std::string& crystalId, const std::string& mountId);
+  /**
+   * @brief Find the alignment of a mounted crystal.
+   *
+   * @param key key of the mounted crystal (see 'makeKey').
+   * @param now current time (seconds since epoch).
+   * @param maxAge maximum age of the entry [s].
+   * @param entry struct where the alignment is stored.
+   * @return true if an entry younger than maxAge has been found.
+   * @return false otherwise.
+   */
+  bool find(const std::string& key, double now, double maxAge, AlignmentCacheEntry& entry) const;
+  /**
+   * @brief Store the alignment of a mounted crystal, replacing the previous one.
+   *
+   * @param key key of the mounted crystal (see 'makeKey').
+   * @param entry alignment of the crystal.
+   * @return true if the cache file has been written.
+   * @return false otherwise.
+   */
+  bool store(const std::string& key, const AlignmentCacheEntry& entry) const;
+  /**
+   * @brief Remove the alignment of a mounted crystal. It is called when the crystal is re-aligned after a compensation.
+   *
+   * @param key key of the mounted crystal (see 'makeKey').
+   * @return true if the entry does not exist anymore.
+   * @return false otherwise.
+   */
+  bool erase(const std::string& key) const;
+  /**
+   * @brief Check if the Bragg peak found by the verification scan confirms a cached alignment.
+   *
+   * @param entry cached alignment.
+   * @param peak Bragg peak found by the verification scan.
+   * @param durationAcquisition duration of the acquisition of every point of the verification scan [s].
+   * @param settings settings of the cache.
+   * @return true if the peak is within the tolerance from the cached Bragg angle and not weaker than the minimum ratio of the cached peak.
+   * @return false otherwise.
+   */
+  static bool isConfirmed(const AlignmentCacheEntry& entry,
+                          const analysis::Peak& peak,
+                          int durationAcquisition,
+                          const AlignmentCacheSettings& settings);
+
+ private:
+  /**
+   * @brief Read the cache file.
+   *
+   * @param ini structure where the cache is stored.
+   * @return true if the file exists and has been read.
+   * @return false otherwise.
+   */
+  bool read(mINI::INIStructure& ini) const;
+  std::filesystem::path pathToCacheFile_;  /**< Path to the .ini file where the cache is stored. */
+};
+
+}  // namespace crystal
+
+#endif  // MODULES_DEVICES_INCLUDE_CRYSTAL_ALIGNMENTCACHE_HPP_
@@ -0,0 +1,210 @@
+/**
+ * @file Crystal/AlignmentProcedureSettings.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Typed settings of the crystal alignments (X axis, Y axis, Y-W axes, Bragg peak search and Y axis fine alignment)
+ * read from the alignment settings file.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#ifndef MODULES_DEVICES_INCLUDE_CRYSTAL_ALIGNMENTPROCEDURESETTINGS_HPP_
+#define MODULES_DEVICES_INCLUDE_CRYSTAL_ALIGNMENTPROCEDURESETTINGS_HPP_
+
+#include <filesystem>
+#include <string>
+#include <tuple>
+
+#include "AlignmentSettings.hpp"
+
+namespace crystal {
+
+/**
+ * @struct XAxisAlignmentSettings
+ * @brief Struct containing the settings of the alignment on the X axis (section 'xAxis_Alignment_CRYSTAL_STAGE').
+ *
+ */
+struct XAxisAlignmentSettings {
+  static constexpr const char* kSection = "xAxis_Alignment_CRYSTAL_STAGE";
+  std::filesystem::path scriptName;  /**< Name of the alignment script. */
+  std::string filenameToResult;  /**< Name of the .csv file where the X alignment position is written. */
+  float stepSize = 0;  /**< Step size of the X scan. */
+  float range = 0;  /**< Range of the X scan. */
+  int durationAcquisition = 0;  /**< Duration of the acquisition of every point of the X scan [s]. */
+  std::string dataLogFilename;  /**< Name of the .csv file where the data of the X scan are logged. */
+  bool eraseCsvContent = true;  /**< True to erase the data log before every X scan. */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("SCRIPT_NAME", &XAxisAlignmentSettings::scriptName),
+                           settingsField("FILENAME_TO_X_ALIGNMENT_POSITION", &XAxisAlignmentSettings::filenameToResult),
+                           settingsField("STEP_SIZE", &XAxisAlignmentSettings::stepSize),
+                           settingsField("RANGE", &XAxisAlignmentSettings::range),
+                           settingsField("DURATION_ACQUISITION", &XAxisAlignmentSettings::durationAcquisition),
+                           settingsField("DATA_LOG_FILENAME", &XAxisAlignmentSettings::dataLogFilename),
+                           settingsField("ERASE_CSV_CONTENT", &XAxisAlignmentSettings::eraseCsvContent));
+  }
+  /**
+   * @brief Check the values read from the alignment settings file.
+   *
+   * @return true if the X scan is not empty.
+   * @return false otherwise.
+   */
+  bool isValid() const {
+    return stepSize != 0 && range != 0 && durationAcquisition > 0;
+  }
+};
+
+/**
+ * @struct YAxisAlignmentSettings
+ * @brief Struct containing the settings of the alignment on the Y axis (section 'yAxis_Alignment_CRYSTAL_STAGE'):
+ * X alignment and Y scan for every step of the W axis.
+ *
+ */
+struct YAxisAlignmentSettings {
+  static constexpr const char* kSection = "yAxis_Alignment_CRYSTAL_STAGE";
+  std::filesystem::path scriptNameOffset;  /**< Name of the script computing the offsets of every Y scan. */
+  std::string filenameToWAlignmentPosition;  /**< Name of the .csv file where the W alignment position is written. */
+  std::string filenameToXAlignmentPosition;  /**< Name of the .csv file where the X alignment position is written. */
+  std::string filenameToSlopes;  /**< Name of the .csv file where the slopes of every Y scan are written. */
+  float stepSizeW = 0;  /**< Step size of the W axis. */
+  float rangeW = 0;  /**< Range of the W axis. */
+  float stepSizeY = 0;  /**< Step size of the Y scan. */
+  float rangeY = 0;  /**< Range of the Y scan. */
+  int durationAcquisition = 0;  /**< Duration of the acquisition of every point of the Y scan [s]. */
+  std::string dataLogFilenameYScan;  /**< Name of the .csv file where the data of the Y scan are logged. */
+  bool eraseCsvContent = true;  /**< True to erase the data log before every Y scan. */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("SCRIPT_NAME_OFFSET", &YAxisAlignmentSettings::scriptNameOffset),
+                           settingsField("FILENAME_TO_W_ALIGNMENT_POSITION", &YAxisAlignmentSettings::filenameToWAlignmentPosition),
+                           settingsField("FILENAME_TO_X_ALIGNMENT_POSITION", &YAxisAlignmentSettings::filenameToXAlignmentPosition),
+                           settingsField("FILENAME_TO_Y_SLOPES", &YAxisAlignmentSettings::filenameToSlopes),
+                           settingsField("STEP_SIZE_W", &YAxisAlignmentSettings::stepSizeW),
+                           settingsField("RANGE_W", &YAxisAlignmentSettings::rangeW),
+                           settingsField("STEP_SIZE_Y", &YAxisAlignmentSettings::stepSizeY),
+                           settingsField("RANGE_Y", &YAxisAlignmentSettings::rangeY),
+                           settingsField("DURATION_ACQUISITION", &YAxisAlignmentSettings::durationAcquisition),
+                           settingsField("DATA_LOG_FILENAME_Y_SCAN", &YAxisAlignmentSettings::dataLogFilenameYScan),
+                           settingsField("ERASE_CSV_CONTENT", &YAxisAlignmentSettings::eraseCsvContent));
+  }
+  /**
+   * @brief Check the values read from the alignment settings file.
+   *
+   * @return true if the loop on the W axis terminates and the Y scan is not empty.
+   * @return false otherwise.
+   */
+  bool isValid() const {
+    return stepSizeW > 0 && rangeW >= 0 && stepSizeY != 0 && rangeY != 0 && durationAcquisition > 0;
+  }
+};
+
+/**
+ * @struct YWAxesAlignmentSettings
+ * @brief Struct containing the settings of the alignment on the Y and W axes (section 'yWAxis_Alignment_CRYSTAL_STAGE'):
+ * W scan for every step of the Y axis.
+ *
+ */
+struct YWAxesAlignmentSettings {
+  static constexpr const char* kSection = "yWAxis_Alignment_CRYSTAL_STAGE";
+  std::filesystem::path scriptName;  /**< Name of the alignment script. */
+  std::string filenameToYAlignmentPosition;  /**< Name of the .csv file where the Y alignment position is written. */
+  std::string filenameToStandardDeviation;  /**< Name of the .csv file where the standard deviation of the slopes is written. */
+  std::string filenameToSlopes;  /**< Name of the .csv file where the slopes of every W scan are written. */
+  float thresholdStdDeviation = 0;  /**< Maximum standard deviation of the slopes of an aligned crystal. */
+  float stepSizeScan = 0;  /**< Step size of the Y axis. */
+  float rangeScan = 0;  /**< Range of the Y axis. */
+  std::string dataLogFilename;  /**< Name of the .csv file where the data of the W scan are logged. */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("SCRIPT_NAME", &YWAxesAlignmentSettings::scriptName),
+                           settingsField("FILENAME_TO_Y_ALIGNMENT_POSITION", &YWAxesAlignmentSettings::filenameToYAlignmentPosition),
+                           settingsField("FILENAME_TO_STANDARD_DEVIATION_RESULT", &YWAxesAlignmentSettings::filenameToStandardDeviation),
+                           settingsField("FILENAME_TO_SLOPESFILE", &YWAxesAlignmentSettings::filenameToSlopes),
+                           settingsField("THRESHOLD_STD_DEVIATION", &YWAxesAlignmentSettings::thresholdStdDeviation),
+                           settingsField("STEP_SIZE_SCAN_HXP_Y", &YWAxesAlignmentSettings::stepSizeScan),
+                           settingsField("RANGE_SCAN_HXP_Y", &YWAxesAlignmentSettings::rangeScan),
+                           settingsField("DATA_LOG_FILENAME", &YWAxesAlignmentSettings::dataLogFilename));
+  }
+  /**
+   * @brief Check the values read from the alignment settings file.
+   *
+   * @return true if the loop on the Y axis terminates.
+   * @return false otherwise.
+   */
+  bool isValid() const {
+    return stepSizeScan > 0 && rangeScan >= 0;
+  }
+};
+
+/**
+ * @struct BraggPeakSearchSettings
+ * @brief Struct containing the settings of the search of the Bragg peak (section 'Braggs_Peak_Search_CRYSTAL_STAGE').
+ *
+ */
+struct BraggPeakSearchSettings {
+  static constexpr const char* kSection = "Braggs_Peak_Search_CRYSTAL_STAGE";
+  std::filesystem::path scriptName;  /**< Name of the script searching the Bragg peak. */
+  std::string filenameToResult;  /**< Name of the .csv file where the Bragg angle is written. */
+  std::string dataLogFilename;  /**< Name of the .csv file where the data of the W scan are logged. */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("SCRIPT_NAME", &BraggPeakSearchSettings::scriptName),
+                           settingsField("FILENAME_TO_BRAGG_ANGLE", &BraggPeakSearchSettings::filenameToResult),
+                           settingsField("DATA_LOG_FILENAME", &BraggPeakSearchSettings::dataLogFilename));
+  }
+  bool isValid() const {
+    return true;
+  }
+};
+
+/**
+ * @struct YAxisFineAlignmentSettings
+ * @brief Struct containing the settings of the fine alignment on the Y axis (section 'yAxis_Fine_Alignment_CRYSTAL_STAGE'):
+ * W scans for every step of the Y axis on both edges of the crystal.
+ *
+ */
+struct YAxisFineAlignmentSettings {
+  static constexpr const char* kSection = "yAxis_Fine_Alignment_CRYSTAL_STAGE";
+  std::filesystem::path scriptNameFullyOpenedBeam;  /**< Name of the script computing the fully opened beam. */
+  std::string filenameToFullyOpenedBeam;  /**< Name of the .csv file where the fully opened beam is written. */
+  std::filesystem::path scriptName;  /**< Name of the alignment script. */
+  std::string filenameToYAlignmentPosition;  /**< Name of the .csv file where the Yin and Yout positions are written. */
+  std::string filenameToYin;  /**< Name of the .csv file where the data of the Yin computation are written. */
+  std::string filenameToYout;  /**< Name of the .csv file where the data of the Yout computation are written. */
+  float crystalWidth = 0;  /**< Width of the crystal [mm]. */
+  float stepSizeScan = 0;  /**< Step size of the Y axis. */
+  float rangeScan = 0;  /**< Range of the Y axis. */
+  float stepSize = 0;  /**< Step size of the W scan. */
+  float range = 0;  /**< Range of the W scan. */
+  int durationAcquisition = 0;  /**< Duration of the acquisition of every point of the W scan [s]. */
+  std::string dataLogFilename;  /**< Name of the .csv file where the data of the W scan are logged. */
+  bool eraseCsvContent = true;  /**< True to erase the data log before every W scan. */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("SCRIPT_NAME_FULLY_OPENED_BEAM", &YAxisFineAlignmentSettings::scriptNameFullyOpenedBeam),
+                           settingsField("FILENAME_TO_FULLY_OPENED_BEAM", &YAxisFineAlignmentSettings::filenameToFullyOpenedBeam),
+                           settingsField("SCRIPT_NAME", &YAxisFineAlignmentSettings::scriptName),
+                           settingsField("FILENAME_TO_Y_ALIGNMENT_POSITION", &YAxisFineAlignmentSettings::filenameToYAlignmentPosition),
+                           settingsField("FILENAME_TO_Yin", &YAxisFineAlignmentSettings::filenameToYin),
+                           settingsField("FILENAME_TO_Yout", &YAxisFineAlignmentSettings::filenameToYout),
+                           settingsField("CRYSTAL_WIDTH", &YAxisFineAlignmentSettings::crystalWidth),
+                           settingsField("STEP_SIZE_SCAN_HXP_Y", &YAxisFineAlignmentSettings::stepSizeScan),
+                           settingsField("RANGE_SCAN_HXP_Y", &YAxisFineAlignmentSettings::rangeScan),
+                           settingsField("STEP_SIZE", &YAxisFineAlignmentSettings::stepSize),
+                           settingsField("RANGE", &YAxisFineAlignmentSettings::range),
+                           settingsField("DURATION_ACQUISITION", &YAxisFineAlignmentSettings::durationAcquisition),
+                           settingsField("DATA_LOG_FILENAME", &YAxisFineAlignmentSettings::dataLogFilename),
+                           settingsField("ERASE_CSV_CONTENT", &YAxisFineAlignmentSettings::eraseCsvContent));
+  }
+  /**
+   * @brief Check the values read from the alignment settings file.
+   *
+   * @return true if the loops on the Y axis terminate and the W scan is not empty.
+   * @return false otherwise.
+   */
+  bool isValid() const {
+    return stepSizeScan > 0 && rangeScan >= 0 && crystalWidth > 0 && stepSize != 0 && range != 0 && durationAcquisition > 0;
+  }
+};
+
+}  // namespace crystal
+
+#endif  // MODULES_DEVICES_INCLUDE_CRYSTAL_ALIGNMENTPROCEDURESETTINGS_HPP_
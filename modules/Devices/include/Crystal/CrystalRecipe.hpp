@@ -0,0 +1,70 @@
+/**
+ * @file Crystal/CrystalRecipe.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Actions of the crystal characterisation recipes (alignments, measurements and analysis of the scans).
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "BatchReprocessing.hpp"
+#include "IConfiguration.hpp"
+#include "ICrystalDeviceController.hpp"
+#include "RecipeEngine.hpp"
+
+namespace crystal {
+
+/**
+ * @brief Register the actions of the crystal in a recipe engine.
+ * @details Motion actions, run on the worker thread of the crystal:
+ * - 'x axis alignment', 'z axis alignment', 'y axis alignment', 'yw axes alignment', 'x axis fine alignment',
+ *   'bragg peak search', 'y axis fine alignment', 'flipped orientation check', 'bending angle', 'torsion angle':
+ *   no parameters, the settings are read from the alignment settings file;
+ * - 'miscut angle': optional parameter REPEAT_BENDING_ANGLE (0 or 1, default 0);
+ * - 'move stepper': parameter POSITION;
+ * - 'move hexapod': parameters X, Y, Z, U, V, W.
+ *
+ * Analysis action, run on the worker thread of the engine while the crystal moves:
+ * - 'reprocess scans': parameter SUMMARY (name of the summary .csv written in the scan directory), optional FILTER
+ *   (only the archived scans whose name contains it).
+ *
+ * The durations of the scans are estimated from the step sizes, ranges and acquisition times of the alignment settings.
+ *
+ * @param engine recipe engine.
+ * @param crystal crystal device controller.
+ * @param configuration configuration containing the alignment settings.
+ * @param pathToScanDirectory directory where the data logs of the scans are stored.
+ */
+void registerRecipeActions(RecipeEngine& engine,
+                           std::shared_ptr<ICrystalDeviceController> crystal,
+                           std::shared_ptr<IConfiguration> configuration,
+                           const std::filesystem::path& pathToScanDirectory);
+
+/**
+ * @brief Estimate the duration of a scan from the alignment settings.
+ *
+ * @param configuration configuration containing the alignment settings.
+ * @param section section of the alignment settings file.
+ * @param stepSizeKey key of the step size.
+ * @param rangeKey key of the range.
+ * @param durationKey key of the acquisition time of every point [s].
+ * @return double estimated duration [s] (0 if the keys are missing).
+ */
+double estimateScanDuration(IConfiguration& configuration,
+                            const std::string& section,
+                            const std::string& stepSizeKey,
+                            const std::string& rangeKey,
+                            const std::string& durationKey);
+
+}  // namespace crystal
@@ -0,0 +1,163 @@
+/**
+ * @file Crystal/HexapodMotionPlanner.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class moving the hexapod through a set of poses and timing the movements against a kinematic model.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#ifndef MODULES_DEVICES_INCLUDE_CRYSTAL_HEXAPODMOTIONPLANNER_HPP_
+#define MODULES_DEVICES_INCLUDE_CRYSTAL_HEXAPODMOTIONPLANNER_HPP_
+
+#include <spdlog/spdlog.h>
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "AlignmentSettings.hpp"
+#include "IHXP.hpp"
+#include "Crystal/MeasurementCheckpoint.hpp"
+
+namespace crystal {
+
+/**
+ * @struct HexapodMotionSettings
+ * @brief Struct containing the kinematic model of the hexapod axes (section 'Hexapod_Motion_CRYSTAL_STAGE').
+ *
+ */
+struct HexapodMotionSettings {
+  static constexpr const char* kSection = "Hexapod_Motion_CRYSTAL_STAGE";
+  float velocityX = 0;  /**< Velocity of the X axis [mm/s]. */
+  float velocityY = 0;  /**< Velocity of the Y axis [mm/s]. */
+  float velocityZ = 0;  /**< Velocity of the Z axis [mm/s]. */
+  float velocityU = 0;  /**< Velocity of the U axis [deg/s]. */
+  float velocityV = 0;  /**< Velocity of the V axis [deg/s]. */
+  float velocityW = 0;  /**< Velocity of the W axis [deg/s]. */
+  float accelerationX = 0;  /**< Acceleration of the X axis [mm/s^2]. */
+  float accelerationY = 0;  /**< Acceleration of the Y axis [mm/s^2]. */
+  float accelerationZ = 0;  /**< Acceleration of the Z axis [mm/s^2]. */
+  float accelerationU = 0;  /**< Acceleration of the U axis [deg/s^2]. */
+  float accelerationV = 0;  /**< Acceleration of the V axis [deg/s^2]. */
+  float accelerationW = 0;  /**< Acceleration of the W axis [deg/s^2]. */
+  float settlingTime = 0;  /**< Time spent by every movement besides the motion of the axes (command, settling) [s]. */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("VELOCITY_X", &HexapodMotionSettings::velocityX),
+                           settingsField("VELOCITY_Y", &HexapodMotionSettings::velocityY),
+                           settingsField("VELOCITY_Z", &HexapodMotionSettings::velocityZ),
+                           settingsField("VELOCITY_U", &HexapodMotionSettings::velocityU),
+                           settingsField("VELOCITY_V", &HexapodMotionSettings::velocityV),
+                           settingsField("VELOCITY_W", &HexapodMotionSettings::velocityW),
+                           settingsField("ACCELERATION_X", &HexapodMotionSettings::accelerationX),
+                           settingsField("ACCELERATION_Y", &HexapodMotionSettings::accelerationY),
+                           settingsField("ACCELERATION_Z", &HexapodMotionSettings::accelerationZ),
+                           settingsField("ACCELERATION_U", &HexapodMotionSettings::accelerationU),
+                           settingsField("ACCELERATION_V", &HexapodMotionSettings::accelerationV),
+                           settingsField("ACCELERATION_W", &HexapodMotionSettings::accelerationW),
+                           settingsField("SETTLING_TIME", &HexapodMotionSettings::settlingTime));
+  }
+  /**
+   * @brief Check the values read from the alignment settings file.
+   *
+   * @return true if all the velocities and the accelerations are positive.
+   * @return false otherwise.
+   */
+  bool isValid() const {
+    return velocityX > 0 && velocityY > 0 && velocityZ > 0 && velocityU > 0 && velocityV > 0 && velocityW > 0 &&
+           accelerationX > 0 && accelerationY > 0 && accelerationZ > 0 && accelerationU > 0 && accelerationV > 0 &&
+           accelerationW > 0 && settlingTime >= 0;
+  }
+};
+
+/**
+ * @struct HexapodMotionReport
+ * @brief Struct containing the predicted and the measured duration of the movements executed by the planner.
+ *
+ */
+struct HexapodMotionReport {
+  int moves = 0;  /**< Number of absolute movements sent to the hexapod. */
+  int failedMoves = 0;  /**< Number of movements that returned an error. */
+  double predictedTime = 0;  /**< Sum of the durations estimated by the kinematic model [s]. */
+  double actualTime = 0;  /**< Sum of the measured durations of the movements [s]. */
+};
+
+/**
+ * @class HexapodMotionPlanner
+ * @brief Class moving the hexapod through a set of poses.
+ *
+ * The axes of the hexapod move together during an absolute movement, so the duration of a movement is estimated as the
+ * longest trapezoidal profile (velocity and acceleration of each axis) plus a fixed settling time. The poses are visited in
+ * the given order, as the steps of the measurements depend on it (checkpoints, peaks paired by row), and every pose is
+ * reached with a single 'HexapodMoveAbsolute', whatever the number of coordinates changed from the previous pose. The
+ * predicted and the measured travel times are reported at the end of every visit.
+ *
+ * @code
+ * HexapodMotionPlanner planner(clientHxp, settings);
+ * planner.visit(poses, [&](size_t index, bool moved) { return moved && clientScanningHXP->scan(); });
+ * @endcode
+ *
+ */
+class HexapodMotionPlanner {
+ public:
+  using Step = std::function<bool(size_t index, bool moved)>;  /**< Function executed at every pose (index in the poses given to 'visit'). */
+
+  HexapodMotionPlanner() = delete;
+  /**
+   * @brief Construct a new HexapodMotionPlanner object.
+   *
+   * @param clientHxp shared pointer of class IHXP.
+   * @param settings kinematic model of the hexapod (when it is not valid, the movements are not timed).
+   */
+  HexapodMotionPlanner(std::shared_ptr<IHXP> clientHxp, const HexapodMotionSettings& settings);
+  /**
+   * @brief Estimate the duration of the absolute movement between two poses.
+   *
+   * @param from initial pose.
+   * @param to target pose.
+   * @return double estimated duration [s] (0 if the kinematic model is not valid or the poses are equal).
+   */
+  double estimateMoveTime(const HxpPose& from, const HxpPose& to) const;
+  /**
+   * @brief Move the hexapod to a pose with a single absolute movement.
+   *
+   * @param pose target pose (it becomes the target coordinates of the hexapod).
+   * @return true if the movement has been executed.
+   * @return false otherwise.
+   */
+  bool moveTo(const HxpPose& pose);
+  /**
+   * @brief Visit a set of poses in the given order and execute a step at each of them.
+   *
+   * @param poses poses to visit.
+   * @param step function executed after each movement: the visit stops when it returns false.
+   * @return true if all the steps succeeded.
+   * @return false otherwise.
+   */
+  bool visit(const std::vector<HxpPose>& poses, const Step& step);
+  /**
+   * @brief Get the predicted and the measured duration of the movements executed since the construction.
+   *
+   * @return HexapodMotionReport report of the movements.
+   */
+  HexapodMotionReport getReport() const;
+
+ private:
+  /**
+   * @brief Get the target coordinates of the hexapod.
+   *
+   * @return HxpPose structure containing the coordinates of the 6 axes.
+   */
+  HxpPose getTargetPose() const;
+  std::shared_ptr<IHXP> clientHxp_;  /**< Shared pointer of class IHXP. */
+  HexapodMotionSettings settings_;  /**< Kinematic model of the hexapod. */
+  HexapodMotionReport report_;  /**< Predicted and measured duration of the movements. */
+};
+
+}  // namespace crystal
+
+#endif  // MODULES_DEVICES_INCLUDE_CRYSTAL_HEXAPODMOTIONPLANNER_HPP_
@@ -0,0 +1,180 @@
+/**
+ * @file Crystal/MeasurementCheckpoint.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class used to store the progress of the crystal measurements (bending, miscut and torsion angle) in a checkpoint file.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#ifndef MODULES_DEVICES_INCLUDE_CRYSTAL_MEASUREMENTCHECKPOINT_HPP_
+#define MODULES_DEVICES_INCLUDE_CRYSTAL_MEASUREMENTCHECKPOINT_HPP_
+
+#include <ini.h>
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace crystal {
+
+/**
+ * @struct HxpPose
+ * @brief Struct containing the 6-axes hexapod coordinates stored in the checkpoint.
+ *
+ */
+struct HxpPose {
+  double CoordX = 0;
+  double CoordY = 0;
+  double CoordZ = 0;
+  double CoordU = 0;
+  double CoordV = 0;
+  double CoordW = 0;
+};
+
+/**
+ * @struct MeasurementCheckpointParameters
+ * @brief Struct containing the parameters that identify a measurement.
+ *
+ * A checkpoint is resumed only if the parameters of the new attempt match the ones stored in the checkpoint file.
+ *
+ */
+struct MeasurementCheckpointParameters {
+  double startPosition = 0;  /**< Initial position of the axis moved by the outer loop of the measurement. */
+  float stepSize = 0;  /**< Step size of the outer loop of the measurement. */
+  float range = 0;  /**< Range of the outer loop of the measurement. */
+  HxpPose initialPose;  /**< Hexapod coordinates at the beginning of the measurement. */
+};
+
+/**
+ * @class MeasurementCheckpoint
+ * @brief Class used to store the progress of the outer loop of the crystal measurements.
+ *
+ * For every completed step of the outer loop the class stores in a .ini file the position of the axis moved by the loop,
+ * the pose of the hexapod and the partial result (row of the peaks .csv file written by the post-processing script).
+ * If the measurement fails or is stopped, the next attempt with the same parameters skips the steps already completed.
+ */
+class MeasurementCheckpoint {
+ public:
+  MeasurementCheckpoint() = delete;
+  /**
+   * @brief Construct a new MeasurementCheckpoint object.
+   *
+   * @param pathToCheckpointFile path to the .ini file where the checkpoint is stored.
+   * @param measurementName name of the measurement (section of the alignment settings file).
+   */
+  explicit MeasurementCheckpoint(std::filesystem::path pathToCheckpointFile,
+                                 std::string measurementName);
+  /**
+   * @brief Destroy the MeasurementCheckpoint object.
+   *
+   */
+  ~MeasurementCheckpoint();
+  /**
+   * @brief Load the checkpoint file and check if it can be used to resume the measurement.
+   *
+   * If the checkpoint file does not exist or was written by a measurement with different parameters,
+   * a new checkpoint is started.
+   *
+   * @param parameters parameters of the measurement to execute.
+   * @return true if a checkpoint with at least one completed step has been restored.
+   * @return false otherwise.
+   */
+  bool resume(const MeasurementCheckpointParameters& parameters);
+  /**
+   * @brief Check if a step of the outer loop was completed in a previous attempt.
+   *
+   * @param iteration index of the step of the outer loop.
+   * @return true if the step is completed.
+   * @return false otherwise.
+   */
+  bool isIterationCompleted(int iteration) const;
+  /**
+   * @brief Register a completed step of the outer loop and save the checkpoint file.
+   *
+   * The last row of the peaks .csv file is stored as partial result of the step.
+   *
+   * @param iteration index of the step of the outer loop.
+   * @param position position of the axis moved by the outer loop.
+   * @param pose hexapod coordinates at the end of the step.
+   * @param pathToPeaks path to the .csv file where the post-processing script saves the peaks.
+   * @return true if the checkpoint file has been saved.
+   * @return false otherwise.
+   */
+  bool registerCompletedIteration(int iteration,
+                                  double position,
+                                  const HxpPose& pose,
+                                  const std::string& pathToPeaks);
+  /**
+   * @brief Rewrite the peaks .csv file with the partial results stored in the checkpoint.
+   *
+   * Rows appended by a step that did not complete are discarded.
+   *
+   * @param pathToPeaks path to the .csv file where the post-processing script saves the peaks.
+   * @return true if the file has been written.
+   * @return false otherwise.
+   */
+  bool restorePartialResults(const std::string& pathToPeaks) const;
+  /**
+   * @brief Get the number of completed steps of the outer loop.
+   *
+   * @return int number of completed steps.
+   */
+  int getCompletedIterations() const;
+  /**
+   * @brief Get the hexapod coordinates stored at the end of the last completed step.
+   *
+   * @return HxpPose hexapod coordinates (initial pose if no step has been completed).
+   */
+  HxpPose getLastPose() const;
+  /**
+   * @brief Remove the checkpoint file. It is called when the measurement has been completed.
+   *
+   * @return true if the checkpoint has been removed.
+   * @return false otherwise.
+   */
+  bool clear();
+
+ private:
+  /**
+   * @brief Write the checkpoint in the .ini file.
+   *
+   * @return true if the file has been written.
+   * @return false otherwise.
+   */
+  bool save() const;
+  /**
+   * @brief Check if the parameters stored in the checkpoint file match the ones of the new attempt.
+   *
+   * @param ini structure read from the checkpoint file.
+   * @param parameters parameters of the measurement to execute.
+   * @return true if the parameters match.
+   * @return false otherwise.
+   */
+  bool isCompatible(mINI::INIStructure& ini, const MeasurementCheckpointParameters& parameters) const;
+  /**
+   * @struct CompletedIteration
+   * @brief Struct containing the data stored for each completed step of the outer loop.
+   *
+   */
+  struct CompletedIteration {
+        double position = 0;
+        HxpPose pose;
+        std::string partialResult;
+  };
+  std::filesystem::path pathToCheckpointFile_;  /**< Path to the .ini file where the checkpoint is stored. */
+  std::string measurementName_;  /**< Name of the measurement. */
+  MeasurementCheckpointParameters parameters_;  /**< Parameters of the measurement. */
+  std::string peaksHeader_;  /**< Header of the peaks .csv file. */
+  std::vector<CompletedIteration> completedIterations_;  /**< Completed steps of the outer loop. */
+  const double tolerance_ = 1e-4;  /**< Tolerance used to compare the parameters of two measurements. */
+};
+
+}  // namespace crystal
+
+#endif  // MODULES_DEVICES_INCLUDE_CRYSTAL_MEASUREMENTCHECKPOINT_HPP_
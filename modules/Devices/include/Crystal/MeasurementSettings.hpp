@@ -0,0 +1,149 @@
+/**
+ * @file Crystal/MeasurementSettings.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Typed settings of the crystal measurements (bending, miscut and torsion angle) read from the alignment settings file.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#ifndef MODULES_DEVICES_INCLUDE_CRYSTAL_MEASUREMENTSETTINGS_HPP_
+#define MODULES_DEVICES_INCLUDE_CRYSTAL_MEASUREMENTSETTINGS_HPP_
+
+#include <filesystem>
+#include <string>
+#include <tuple>
+
+#include "AlignmentSettings.hpp"
+
+namespace crystal {
+
+/**
+ * @struct StartPositionSettings
+ * @brief Struct containing the initial positions shared by the crystal measurements (section 'xAxis_Alignment_CRYSTAL_STAGE').
+ *
+ */
+struct StartPositionSettings {
+  static constexpr const char* kSection = "xAxis_Alignment_CRYSTAL_STAGE";
+  float startPositionStepper = 0;  /**< Initial position of the stepper motor. */
+  float startPositionHxpU = 0;  /**< Initial position of the U axis of the hexapod. */
+  float startPositionHxpV = 0;  /**< Initial position of the V axis of the hexapod. */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("START_POSITION_STEPPER", &StartPositionSettings::startPositionStepper),
+                           settingsField("START_POSITION_HXP_U", &StartPositionSettings::startPositionHxpU),
+                           settingsField("START_POSITION_HXP_V", &StartPositionSettings::startPositionHxpV));
+  }
+  bool isValid() const {
+    return true;
+  }
+};
+
+/**
+ * @struct MeasurementSettings
+ * @brief Struct containing the settings common to the crystal measurements: double axis scan
+ * (scan on the W axis for every step performed on the outer axis).
+ *
+ */
+struct MeasurementSettings {
+  std::filesystem::path scriptName;  /**< Name of the post-processing script. */
+  std::string filenameToResult;  /**< Name of the .csv file where the result of the measurement is written. */
+  std::string filenameToPeaks;  /**< Name of the .csv file where the peaks of every W scan are written. */
+  float stepSizeScan = 0;  /**< Step size of the outer axis. */
+  float rangeScan = 0;  /**< Range of the outer axis. */
+  float offsetFromBraggAngle = 0;  /**< Offset of the W scan from the Bragg angle. */
+  float stepSize = 0;  /**< Step size of the W scan. */
+  float range = 0;  /**< Range of the W scan. */
+  int durationAcquisition = 0;  /**< Duration of the acquisition of every point of the W scan [s]. */
+  std::string dataLogFilename;  /**< Name of the .csv file where the data of the W scan are logged. */
+  bool eraseCsvContent = true;  /**< True to erase the data log before every W scan. */
+  /**
+   * @brief Check the values read from the alignment settings file.
+   *
+   * @return true if the outer loop terminates and the W scan is not empty.
+   * @return false otherwise.
+   */
+  bool isValid() const {
+    return stepSizeScan > 0 && rangeScan >= 0 && stepSize != 0 && range != 0 && durationAcquisition > 0;
+  }
+};
+
+/**
+ * @struct BendingAngleSettings
+ * @brief Struct containing the settings of the bending angle measurement (section 'Bending_Angle_CRYSTAL_STAGE').
+ *
+ */
+struct BendingAngleSettings : public MeasurementSettings {
+  static constexpr const char* kSection = "Bending_Angle_CRYSTAL_STAGE";
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("SCRIPT_NAME", &MeasurementSettings::scriptName),
+                           settingsField("FILENAME_TO_BENDING_ANGLE", &MeasurementSettings::filenameToResult),
+                           settingsField("FILENAME_TO_PEAKS", &MeasurementSettings::filenameToPeaks),
+                           settingsField("STEP_SIZE_SCAN_HXP_Y", &MeasurementSettings::stepSizeScan),
+                           settingsField("RANGE_SCAN_HXP_Y", &MeasurementSettings::rangeScan),
+                           settingsField("OFFSET_FROM_BRAGG_ANGLE", &MeasurementSettings::offsetFromBraggAngle),
+                           settingsField("STEP_SIZE", &MeasurementSettings::stepSize),
+                           settingsField("RANGE", &MeasurementSettings::range),
+                           settingsField("DURATION_ACQUISITION", &MeasurementSettings::durationAcquisition),
+                           settingsField("DATA_LOG_FILENAME", &MeasurementSettings::dataLogFilename),
+                           settingsField("ERASE_CSV_CONTENT", &MeasurementSettings::eraseCsvContent));
+  }
+};
+
+/**
+ * @struct MiscutAngleSettings
+ * @brief Struct containing the settings of the miscut angle measurement (section 'Miscut_Angle_CRYSTAL_STAGE').
+ *
+ */
+struct MiscutAngleSettings : public MeasurementSettings {
+  static constexpr const char* kSection = "Miscut_Angle_CRYSTAL_STAGE";
+  float startPositionStepper = 0;  /**< Initial position of the stepper motor. */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("SCRIPT_NAME", &MeasurementSettings::scriptName),
+                           settingsField("FILENAME_TO_MISCUT_ANGLE", &MeasurementSettings::filenameToResult),
+                           settingsField("FILENAME_TO_PEAKS", &MeasurementSettings::filenameToPeaks),
+                           settingsField("START_POSITION_STEPPER", &MiscutAngleSettings::startPositionStepper),
+                           settingsField("STEP_SIZE_SCAN_HXP_Y", &MeasurementSettings::stepSizeScan),
+                           settingsField("RANGE_SCAN_HXP_Y", &MeasurementSettings::rangeScan),
+                           settingsField("OFFSET_FROM_BRAGG_ANGLE", &MeasurementSettings::offsetFromBraggAngle),
+                           settingsField("STEP_SIZE", &MeasurementSettings::stepSize),
+                           settingsField("RANGE", &MeasurementSettings::range),
+                           settingsField("DURATION_ACQUISITION", &MeasurementSettings::durationAcquisition),
+                           settingsField("DATA_LOG_FILENAME", &MeasurementSettings::dataLogFilename),
+                           settingsField("ERASE_CSV_CONTENT", &MeasurementSettings::eraseCsvContent));
+  }
+};
+
+/**
+ * @struct TorsionAngleSettings
+ * @brief Struct containing the settings of the torsion angle measurement (section 'Torsion_Angle_CRYSTAL_STAGE').
+ *
+ */
+struct TorsionAngleSettings : public MeasurementSettings {
+  static constexpr const char* kSection = "Torsion_Angle_CRYSTAL_STAGE";
+  float startPositionStepper = 0;  /**< Initial position of the stepper motor. */
+  float startPositionHxpY = 0;  /**< Initial position of the Y axis of the hexapod. */
+  float startPositionHxpZ = 0;  /**< Initial position of the Z axis of the hexapod (first step of the outer loop). */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("SCRIPT_NAME", &MeasurementSettings::scriptName),
+                           settingsField("FILENAME_TO_TORSION_ANGLE", &MeasurementSettings::filenameToResult),
+                           settingsField("FILENAME_TO_PEAKS", &MeasurementSettings::filenameToPeaks),
+                           settingsField("START_POSITION_STEPPER", &TorsionAngleSettings::startPositionStepper),
+                           settingsField("START_POSITION_HXP_Y", &TorsionAngleSettings::startPositionHxpY),
+                           settingsField("START_POSITION_HXP_Z", &TorsionAngleSettings::startPositionHxpZ),
+                           settingsField("STEP_SIZE_SCAN_HXP_Z", &MeasurementSettings::stepSizeScan),
+                           settingsField("RANGE_SCAN_HXP_Z", &MeasurementSettings::rangeScan),
+                           settingsField("OFFSET_FROM_BRAGG_ANGLE", &MeasurementSettings::offsetFromBraggAngle),
+                           settingsField("STEP_SIZE", &MeasurementSettings::stepSize),
+                           settingsField("RANGE", &MeasurementSettings::range),
+                           settingsField("DURATION_ACQUISITION", &MeasurementSettings::durationAcquisition),
+                           settingsField("DATA_LOG_FILENAME", &MeasurementSettings::dataLogFilename),
+                           settingsField("ERASE_CSV_CONTENT", &MeasurementSettings::eraseCsvContent));
+  }
+};
+
+}  // namespace crystal
+
+#endif  // MODULES_DEVICES_INCLUDE_CRYSTAL_MEASUREMENTSETTINGS_HPP_
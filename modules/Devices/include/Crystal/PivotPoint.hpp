@@ -0,0 +1,128 @@
+/**
+ * @file Crystal/PivotPoint.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class moving the pivot point of the hexapod to the impact point of the beam on the crystal.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#ifndef MODULES_DEVICES_INCLUDE_CRYSTAL_PIVOTPOINT_HPP_
+#define MODULES_DEVICES_INCLUDE_CRYSTAL_PIVOTPOINT_HPP_
+
+#include <spdlog/spdlog.h>
+
+#include <memory>
+#include <tuple>
+
+#include "AlignmentSettings.hpp"
+#include "IHXP.hpp"
+#include "Crystal/MeasurementCheckpoint.hpp"
+
+namespace crystal {
+
+/**
+ * @struct PivotPointSettings
+ * @brief Struct containing the position of the beam used to place the pivot point (section 'Pivot_Point_CRYSTAL_STAGE').
+ *
+ */
+struct PivotPointSettings {
+  static constexpr const char* kSection = "Pivot_Point_CRYSTAL_STAGE";
+  bool enabled = false;  /**< True to execute the rocking curves about the impact point of the beam on the crystal. */
+  float beamX = 0;  /**< X coordinate of the impact point of the beam in the Work coordinate system [mm]. */
+  float beamY = 0;  /**< Y coordinate of the impact point of the beam in the Work coordinate system [mm]. */
+  float beamZ = 0;  /**< Z coordinate of the impact point of the beam in the Work coordinate system [mm]. */
+  float maxDistance = 0;  /**< Maximum distance between the pivot point and the centre of the carriage [mm]. */
+  static constexpr auto fields() {
+    return std::make_tuple(settingsField("ENABLED", &PivotPointSettings::enabled),
+                           settingsField("BEAM_X", &PivotPointSettings::beamX),
+                           settingsField("BEAM_Y", &PivotPointSettings::beamY),
+                           settingsField("BEAM_Z", &PivotPointSettings::beamZ),
+                           settingsField("MAX_DISTANCE", &PivotPointSettings::maxDistance));
+  }
+  /**
+   * @brief Check the values read from the alignment settings file.
+   *
+   * @return true if the maximum distance is positive.
+   * @return false otherwise.
+   */
+  bool isValid() const {
+    return maxDistance > 0;
+  }
+};
+
+/**
+ * @class PivotPoint
+ * @brief Class moving the pivot point of the hexapod to the impact point of the beam on the crystal.
+ *
+ * The hexapod rotates about the origin of its Tool coordinate system, by default the centre of the carriage, so a
+ * rotation of the aligned crystal also moves the beam spot on its surface. The impact point of the beam (fixed in the
+ * Work coordinate system) is expressed in the carriage frame from the current pose of the hexapod and the Tool coordinate
+ * system is moved there: the W scans then rotate the crystal about the beam spot, without compensating translations.
+ * The positions in the Work coordinate system refer to the Tool origin, so the target coordinates of the hexapod are
+ * expressed in the new frame while the pivot point is active. The previous Tool coordinate system is restored by
+ * 'release', or when the object is destroyed.
+ *
+ * The rotations follow the convention of the hexapod controller: U about X, then V about Y, then W about Z, all about
+ * the fixed axes. The previous Tool coordinate system is assumed not rotated with respect to the carriage.
+ *
+ */
+class PivotPoint {
+ public:
+  PivotPoint() = delete;
+  /**
+   * @brief Construct a new PivotPoint object.
+   *
+   * @param clientHxp shared pointer of class IHXP.
+   */
+  explicit PivotPoint(std::shared_ptr<IHXP> clientHxp);
+  /**
+   * @brief Destroy the PivotPoint object, restoring the previous Tool coordinate system.
+   *
+   */
+  ~PivotPoint();
+  PivotPoint(const PivotPoint&) = delete;
+  PivotPoint& operator=(const PivotPoint&) = delete;
+  /**
+   * @brief Express a point of the Work coordinate system in the frame of the hexapod Tool.
+   *
+   * @param pose pose of the Tool origin in the Work coordinate system.
+   * @param point point in the Work coordinate system (only the coordinates X, Y and Z are used).
+   * @return HxpPose point in the Tool frame (the rotations are zero).
+   */
+  static HxpPose toToolFrame(const HxpPose& pose, const HxpPose& point);
+  /**
+   * @brief Move the Tool coordinate system to the impact point of the beam, computed from the current target pose.
+   *
+   * @param settings position of the beam.
+   * @return true if the pivot point is active.
+   * @return false otherwise (the Tool coordinate system is left untouched).
+   */
+  bool activate(const PivotPointSettings& settings);
+  /**
+   * @brief Restore the Tool coordinate system active before 'activate'.
+   *
+   * @return true if the pivot point is not active anymore.
+   * @return false otherwise.
+   */
+  bool release();
+  /**
+   * @brief Check whether the pivot point is active.
+   *
+   * @return true if the rotations are executed about the impact point of the beam.
+   * @return false otherwise.
+   */
+  bool isActive() const;
+
+ private:
+  std::shared_ptr<IHXP> clientHxp_;  /**< Shared pointer of class IHXP. */
+  HxpPose previousTool_;  /**< Tool coordinate system active before the pivot point. */
+  bool active_;  /**< True while the Tool coordinate system is on the impact point of the beam. */
+};
+
+}  // namespace crystal
+
+#endif  // MODULES_DEVICES_INCLUDE_CRYSTAL_PIVOTPOINT_HPP_
@@ -18,6 +18,7 @@
 #include <string>
 #include <memory>
 
+#include "ActionResult.hpp"
 #include "Crystal/Actions.hpp"
 #include "Crystal/Events.hpp"
 
@@ -39,6 +40,7 @@ class systemError;
 class System{
  private:
   std::shared_ptr<Actions> actions_;
+  ActionResult lastAction_;  /**< Result of the action run by the last guard. */
 
  public:
   explicit System(std::shared_ptr<Actions> actions) noexcept:
@@ -56,8 +58,8 @@ class System{
     state<systemNotInitialized> + event<eventInitialize> = state<systemError>,
     // From SystemConnected
     state<systemConnected> + event<eventSetupHome> [([this] { return true; })] = state<systemInMotion>,
-    state<systemConnected> + event<eventDisconnect> [([this] { return actions_->disconnect(); })] = state<systemNotInitialized>,
-    state<systemConnected> + event<eventDisconnect> [([this] { return !actions_->disconnect(); })] = state<systemError>,
+    state<systemConnected> + event<eventDisconnect> [([this] { return lastAction_.store(actions_->disconnect()); })] = state<systemNotInitialized>,
+    state<systemConnected> + event<eventDisconnect> [([this] { return lastAction_.failed(); })] = state<systemError>,
     state<systemConnected> + event<eventMoveHxpToAbsolutePosition> [([this] { return true; })] = state<systemInMotion>,
     state<systemConnected> + event<eventMoveStepperToRelativePosition> [([this] { return true; })] = state<systemInMotion>,
     state<systemConnected> + event<eventStartScanStepper> [([this] { return true; })]  = state<systemInMotion>,
@@ -73,49 +75,49 @@ class System{
     state<systemConnected> + event<eventMiscutAngleMeasurement> [([this] { return true; })]  = state<systemInMotion>,
     state<systemConnected> + event<eventTorsionAngleMeasurement> [([this] { return true; })]  = state<systemInMotion>,
     // From systemInMotion
-    state<systemInMotion> + event<eventStartScanStepper> [([this] { return actions_->startScanStepper(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventStartScanStepper> [([this] { return !actions_->startScanStepper(); })] = state<systemError>,
-    state<systemInMotion> + event<eventStartScanHxp> [([this] { return actions_->startScanHxp(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventStartScanHxp> [([this] { return !actions_->startScanHxp(); })] = state<systemError>,
-    state<systemInMotion> + event<eventXAxisAlignmentCrystal> [([this] { return actions_->searchXAxisAlignmentCrystal(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventXAxisAlignmentCrystal> [([this] { return !actions_->searchXAxisAlignmentCrystal(); })] = state<systemError>,
-    state<systemInMotion> + event<eventZAxisAlignmentCrystal> [([this] { return actions_->searchZAxisAlignmentCrystal(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventZAxisAlignmentCrystal> [([this] { return !actions_->searchZAxisAlignmentCrystal(); })] = state<systemError>,
-    state<systemInMotion> + event<eventYAxisAlignmentCrystal> [([this] { return actions_->searchYAxisAlignmentCrystal(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventYAxisAlignmentCrystal> [([this] { return !actions_->searchYAxisAlignmentCrystal(); })] = state<systemError>,
-    state<systemInMotion> + event<eventYWAxesAlignmentCrystal> [([this] { return actions_->searchYWAxesAlignmentCrystal(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventYWAxesAlignmentCrystal> [([this] { return !actions_->searchYWAxesAlignmentCrystal(); })] = state<systemError>,
-    state<systemInMotion> + event<eventSearchBraggPeakCrystal> [([this] { return actions_->searchBraggPeakCrystal(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventSearchBraggPeakCrystal> [([this] { return !actions_->searchBraggPeakCrystal(); })] = state<systemError>,
-    state<systemInMotion> + event<eventYAxisFineAlignmentCrystal> [([this] { return actions_->searchYAxisFineAlignment(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventYAxisFineAlignmentCrystal> [([this] { return !actions_->searchYAxisFineAlignment(); })] = state<systemError>,
-    state<systemInMotion> + event<eventCheckAlignmentInFlippedOrientation> [([this] { return actions_->checkAlignmentFlippedOrientation(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventCheckAlignmentInFlippedOrientation> [([this] { return !actions_->checkAlignmentFlippedOrientation(); })] = state<systemError>,
-    state<systemInMotion> + event<eventBendingAngleMeasurement> [([this] { return actions_->bendingAngleMeasurement(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventBendingAngleMeasurement> [([this] { return !actions_->bendingAngleMeasurement(); })] = state<systemError>,
-    state<systemInMotion> + event<eventMiscutAngleMeasurement> [([this] { return actions_->miscutAngleMeasurement(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventMiscutAngleMeasurement> [([this] { return !actions_->miscutAngleMeasurement(); })] = state<systemError>,
-    state<systemInMotion> + event<eventTorsionAngleMeasurement> [([this] { return actions_->torsionAngleMeasurement(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventTorsionAngleMeasurement> [([this] { return !actions_->torsionAngleMeasurement(); })] = state<systemError>,
-    state<systemInMotion> + event<eventSetupHome> [([this] { return actions_->goHome(); })] = state<systemHome>,
-    state<systemInMotion> + event<eventSetupHome> [([this] { return !actions_->goHome(); })] = state<systemError>,
-    state<systemInMotion> + event<eventMoveHxpToAbsolutePosition> [([this] { return actions_->setHxpPositionAbsolute(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventMoveHxpToAbsolutePosition> [([this] { return !actions_->setHxpPositionAbsolute(); })] = state<systemError>,
-    state<systemInMotion> + event<eventMoveStepperToRelativePosition> [([this] { return actions_->moveCalibratedMotor(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventMoveStepperToRelativePosition> [([this] { return !actions_->moveCalibratedMotor(); })] = state<systemError>,
-    state<systemInMotion> + event<eventStopMovement> [([this] { return actions_->stop(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventStopMovement> [([this] { return !actions_->stop(); })] = state<systemError>,
+    state<systemInMotion> + event<eventStartScanStepper> [([this] { return lastAction_.store(actions_->startScanStepper()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventStartScanStepper> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventStartScanHxp> [([this] { return lastAction_.store(actions_->startScanHxp()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventStartScanHxp> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventXAxisAlignmentCrystal> [([this] { return lastAction_.store(actions_->searchXAxisAlignmentCrystal()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventXAxisAlignmentCrystal> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventZAxisAlignmentCrystal> [([this] { return lastAction_.store(actions_->searchZAxisAlignmentCrystal()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventZAxisAlignmentCrystal> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventYAxisAlignmentCrystal> [([this] { return lastAction_.store(actions_->searchYAxisAlignmentCrystal()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventYAxisAlignmentCrystal> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventYWAxesAlignmentCrystal> [([this] { return lastAction_.store(actions_->searchYWAxesAlignmentCrystal()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventYWAxesAlignmentCrystal> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventSearchBraggPeakCrystal> [([this] { return lastAction_.store(actions_->searchBraggPeakCrystal()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventSearchBraggPeakCrystal> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventYAxisFineAlignmentCrystal> [([this] { return lastAction_.store(actions_->searchYAxisFineAlignment()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventYAxisFineAlignmentCrystal> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventCheckAlignmentInFlippedOrientation> [([this] { return lastAction_.store(actions_->checkAlignmentFlippedOrientation()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventCheckAlignmentInFlippedOrientation> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventBendingAngleMeasurement> [([this] { return lastAction_.store(actions_->bendingAngleMeasurement()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventBendingAngleMeasurement> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventMiscutAngleMeasurement> [([this] { return lastAction_.store(actions_->miscutAngleMeasurement()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventMiscutAngleMeasurement> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventTorsionAngleMeasurement> [([this] { return lastAction_.store(actions_->torsionAngleMeasurement()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventTorsionAngleMeasurement> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventSetupHome> [([this] { return lastAction_.store(actions_->goHome()); })] = state<systemHome>,
+    state<systemInMotion> + event<eventSetupHome> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventMoveHxpToAbsolutePosition> [([this] { return lastAction_.store(actions_->setHxpPositionAbsolute()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventMoveHxpToAbsolutePosition> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventMoveStepperToRelativePosition> [([this] { return lastAction_.store(actions_->moveCalibratedMotor()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventMoveStepperToRelativePosition> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventStopMovement> [([this] { return lastAction_.store(actions_->stop()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventStopMovement> [([this] { return lastAction_.failed(); })] = state<systemError>,
     // From System Home
     state<systemHome> + event<eventSetupHome> [([this] { return true; })] = state<systemInMotion>,
-    state<systemHome> + event<eventDisconnect> [([this] { return actions_->disconnect(); })] = state<systemNotInitialized>,
-    state<systemHome> + event<eventDisconnect> [([this] { return !actions_->disconnect(); })] = state<systemError>,
+    state<systemHome> + event<eventDisconnect> [([this] { return lastAction_.store(actions_->disconnect()); })] = state<systemNotInitialized>,
+    state<systemHome> + event<eventDisconnect> [([this] { return lastAction_.failed(); })] = state<systemError>,
     state<systemHome> + event<eventMoveHxpToAbsolutePosition> [([this] { return true; })] = state<systemInMotion>,
     state<systemHome> + event<eventMoveStepperToRelativePosition> [([this] { return true; })] = state<systemInMotion>,
     state<systemHome> + event<eventStartScanStepper> [([this] { return true; })]  = state<systemInMotion>,
     state<systemHome> + event<eventStartScanHxp> [([this] { return true; })] = state<systemInMotion>,  // Scan OK
     state<systemHome> + event<eventXAxisAlignmentCrystal> [([this] { return true; })]  = state<systemInMotion>,
     state<systemHome> + event<eventZAxisAlignmentCrystal> [([this] { return true; })]  = state<systemInMotion>,
-    state<systemConnected> + event<eventYAxisAlignmentCrystal> [([this] { return true; })]  = state<systemInMotion>,
+    state<systemHome> + event<eventYAxisAlignmentCrystal> [([this] { return true; })]  = state<systemInMotion>,
     state<systemHome> + event<eventYWAxesAlignmentCrystal> [([this] { return true; })]  = state<systemInMotion>,
     state<systemHome> + event<eventSearchBraggPeakCrystal> [([this] { return true; })]  = state<systemInMotion>,
     state<systemHome> + event<eventYAxisFineAlignmentCrystal> [([this] { return true; })]  = state<systemInMotion>,
@@ -124,8 +126,9 @@ class System{
     state<systemHome> + event<eventMiscutAngleMeasurement> [([this] { return true; })]  = state<systemInMotion>,
     state<systemHome> + event<eventTorsionAngleMeasurement> [([this] { return true; })]  = state<systemInMotion>,
     // From System Error
-    state<systemError> + event<eventInitialize> [([this] { return actions_->connect(); })] = state<systemConnected>,
-    state<systemError> + event<eventInitialize> [([this] { return !actions_->connect(); })] = state<systemError>,
+    state<systemError> + event<eventStopMovement> [([this] { return lastAction_.store(actions_->stop()); })] = state<systemConnected>,  // action interrupted by a stop
+    state<systemError> + event<eventInitialize> [([this] { return lastAction_.store(actions_->connect()); })] = state<systemConnected>,
+    state<systemError> + event<eventInitialize> [([this] { return lastAction_.failed(); })] = state<systemError>,
     state<systemError> + event<eventDisconnect> / [this] { actions_->disconnect(); } = state<systemNotInitialized>);  // end transition table
   }
 };
@@ -0,0 +1,127 @@
+/**
+ * @file DeviceBringUp.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class connecting and homing all the devices of the machine in parallel.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DeviceOrchestrator.hpp"
+
+/**
+ * @struct DeviceBringUpReport
+ * @brief Struct containing the result of the bring-up of a device.
+ *
+ */
+struct DeviceBringUpReport {
+  std::string device;  /**< Name of the device. */
+  CommandState connection = CommandState::Queued;  /**< State of the connection (start of the controller). */
+  CommandState homing = CommandState::Queued;  /**< State of the homing (calibration and home search). */
+  double connectionTime = 0;  /**< Duration of the connection [s]. */
+  double homingTime = 0;  /**< Duration of the homing [s]. */
+};
+
+/**
+ * @class DeviceBringUp
+ * @brief Class bringing up the machine: each device is connected and then homed on its own worker thread.
+ *
+ * The stages live on separate controllers (XIMC controllers and the XPS of the hexapod), so the devices are brought up at
+ * the same time and the cold start lasts as long as the slowest device instead of the sum of all the homings. The homing
+ * of a device is not run if its connection fails, while the other devices are not affected.
+ *
+ * @code
+ * auto bringUp = std::make_shared<DeviceBringUp>();
+ * bringUp->addDevice("Crystal", client_Crystal);
+ * bringUp->addDevice("Slit", client_Slit);
+ * bringUp->start();
+ * bringUp->wait();
+ * @endcode
+ *
+ */
+class DeviceBringUp {
+ public:
+  /**
+   * @brief Construct a new DeviceBringUp object.
+   *
+   */
+  DeviceBringUp();
+  /**
+   * @brief Add a device controller (any class providing start, goHome and submitCommand, e.g. ICrystalDeviceController).
+   *
+   * @param name name of the device (used in the logs and in the report).
+   * @param device device controller.
+   */
+  template <class Device>
+  void addDevice(const std::string& name, std::shared_ptr<Device> device) {
+    size_t connection = orchestrator_.addStep(device, name + " connection", timed(name, "connection", [device] {
+      return device->start();
+    }));
+    orchestrator_.addStep(device, name + " homing", timed(name, "homing", [device] {
+      return device->goHome();
+    }), {connection});
+    devices_.push_back(name);
+  }
+  /**
+   * @brief Queue the connection and the homing of all the devices.
+   *
+   * @return std::vector<std::shared_ptr<DeviceCommand>> handles of the commands (connection and homing of each device).
+   */
+  std::vector<std::shared_ptr<DeviceCommand>> start();
+  /**
+   * @brief Wait until all the devices are brought up and log the report.
+   *
+   * @return true if all the devices have been connected and homed.
+   * @return false otherwise (or if the bring-up has not been started).
+   */
+  bool wait() const;
+  /**
+   * @brief Check if the bring-up has finished.
+   *
+   * @return true if all the commands have finished.
+   * @return false otherwise.
+   */
+  bool isDone() const;
+  /**
+   * @brief Get the state and the timing of the bring-up of each device.
+   *
+   * @return std::vector<DeviceBringUpReport> report of each device, in the order they were added.
+   */
+  std::vector<DeviceBringUpReport> getReport() const;
+  /**
+   * @brief Get the duration of the bring-up.
+   *
+   * @return double seconds from the start to the end of the slowest device (or to now while running).
+   */
+  double getDuration() const;
+
+ private:
+  /**
+   * @brief Wrap a command of a device so that its duration and its failure are logged when it finishes.
+   *
+   * @param device name of the device.
+   * @param stage name of the stage (connection or homing).
+   * @param command command of the device.
+   * @return std::function<bool()> command logging its result.
+   */
+  static std::function<bool()> timed(const std::string& device, const std::string& stage, std::function<bool()> command);
+
+  DeviceOrchestrator orchestrator_;  /**< Orchestrator running the commands of the devices. */
+  std::vector<std::string> devices_;  /**< Names of the devices, in the order they were added. */
+  std::vector<std::shared_ptr<DeviceCommand>> handles_;  /**< Connection and homing handles of each device (empty before start). */
+  std::chrono::steady_clock::time_point startTime_;  /**< Time at which the bring-up started. */
+};
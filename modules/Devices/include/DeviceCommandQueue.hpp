@@ -0,0 +1,243 @@
+/**
+ * @file DeviceCommandQueue.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Queue of the commands of a device, run one after the other by the worker thread of the device.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief States of a command of a device.
+ *
+ */
+enum class CommandState { Queued, Running, Succeeded, Failed, Cancelled };
+
+/**
+ * @class DeviceCommand
+ * @brief Handle of a command queued in a @ref DeviceCommandQueue, used to follow its progress and to wait for its result.
+ *
+ */
+class DeviceCommand {
+ public:
+  DeviceCommand() = delete;
+  /**
+   * @brief Construct a new DeviceCommand object.
+   *
+   * @param name name of the command (used in the logs).
+   */
+  explicit DeviceCommand(std::string name);
+  /**
+   * @brief Get the name of the command.
+   *
+   * @return const std::string& name of the command.
+   */
+  const std::string& getName() const;
+  /**
+   * @brief Get the state of the command.
+   *
+   * @return CommandState state of the command.
+   */
+  CommandState getState() const;
+  /**
+   * @brief Check if the command has finished (succeeded, failed or cancelled).
+   *
+   * @return true if the command has finished.
+   * @return false if it is queued or running.
+   */
+  bool isDone() const;
+  /**
+   * @brief Get the progress of the command, set by the command while it runs.
+   *
+   * @return double progress between 0 and 1 (1 when the command has finished).
+   */
+  double getProgress() const;
+  /**
+   * @brief Set the progress of the command.
+   *
+   * @param progress progress between 0 and 1.
+   */
+  void setProgress(double progress);
+  /**
+   * @brief Check if the command has been preempted by a stop. A long command can check it between its steps.
+   *
+   * @return true if the command has been preempted.
+   * @return false otherwise.
+   */
+  bool isCancelled() const;
+  /**
+   * @brief Check if the command has interrupted a running command when it was queued by 'preempt' (e.g. a stop that ended
+   * a scan, so that the device is recovered from the failure of the interrupted action).
+   *
+   * @return true if a command was running when this command was queued.
+   * @return false otherwise.
+   */
+  bool hasInterrupted() const;
+  /**
+   * @brief Wait until the command has finished.
+   *
+   * @return true if the command has run and returned true.
+   * @return false otherwise.
+   */
+  bool wait() const;
+  /**
+   * @brief Wait until the command has finished or the timeout has elapsed.
+   *
+   * @param timeout maximum waiting time.
+   * @return true if the command has finished.
+   * @return false otherwise.
+   */
+  bool waitFor(std::chrono::milliseconds timeout) const;
+  /**
+   * @brief Get the time spent running the command.
+   *
+   * @return double seconds from the start of the command to its end (or to now while it runs, 0 while it is queued).
+   */
+  double getDuration() const;
+
+ private:
+  friend class DeviceCommandQueue;
+  /**
+   * @brief Mark the command as preempted.
+   *
+   */
+  void cancel();
+  /**
+   * @brief Change the state of the command and wake up the threads waiting for it.
+   *
+   * @param state new state of the command.
+   * @param result value returned by the command.
+   */
+  void setState(CommandState state, bool result = false);
+
+  const std::string name_;  /**< Name of the command. */
+  std::atomic<double> progress_{0};  /**< Progress of the command. */
+  std::atomic<bool> cancelled_{false};  /**< True if the command has been preempted. */
+  std::atomic<bool> interrupted_{false};  /**< True if the command has interrupted the running command. */
+  mutable std::mutex mutex_;  /**< Mutex protecting the state and the result. */
+  mutable std::condition_variable condition_;  /**< Condition variable notified when the command finishes. */
+  CommandState state_ = CommandState::Queued;  /**< State of the command. */
+  bool result_ = false;  /**< Value returned by the command. */
+  std::chrono::steady_clock::time_point startTime_;  /**< Time at which the command started running. */
+  std::chrono::steady_clock::time_point endTime_;  /**< Time at which the command finished. */
+};
+
+/**
+ * @class DeviceCommandQueue
+ * @brief Queue of the commands of a device, run in submission order by the worker thread of the device.
+ *
+ * The state machine and the actions of the device are only used by the worker thread, so that the caller (e.g. the UI
+ * server) submits the commands without creating threads and follows them through their @ref DeviceCommand handles.
+ * A stop preempts the device: the queued commands are cancelled, the running one is interrupted on the caller's thread
+ * (e.g. by stopping the scan) and the stop command runs as soon as the worker thread is free.
+ *
+ */
+class DeviceCommandQueue {
+ public:
+  using Command = std::function<bool(DeviceCommand& command)>;  /**< Command run by the worker thread, with its handle. */
+  using Interrupt = std::function<void()>;  /**< Function interrupting the running command. */
+  using Observer = std::function<void(const std::string& name, bool running)>;  /**< Function notified when a command starts and ends. */
+
+  DeviceCommandQueue() = delete;
+  /**
+   * @brief Construct a new DeviceCommandQueue object and start its worker thread.
+   *
+   * @param deviceName name of the device (used in the logs).
+   */
+  explicit DeviceCommandQueue(std::string deviceName);
+  /**
+   * @brief Destroy the DeviceCommandQueue object. The queued commands are cancelled and the running one is completed
+   * before the worker thread is stopped.
+   *
+   */
+  ~DeviceCommandQueue();
+  /**
+   * @brief Queue a command.
+   *
+   * @param name name of the command.
+   * @param command command to be run.
+   * @return std::shared_ptr<DeviceCommand> handle of the command.
+   */
+  std::shared_ptr<DeviceCommand> submit(const std::string& name, Command command);
+  /**
+   * @brief Cancel the queued commands, interrupt the running one and queue a command in front of the queue.
+   *
+   * @param name name of the command.
+   * @param command command to be run (e.g. the event 'eventStopMovement').
+   * @param interrupt function interrupting the running command, called on the caller's thread only if a command is running.
+   * @return std::shared_ptr<DeviceCommand> handle of the command.
+   */
+  std::shared_ptr<DeviceCommand> preempt(const std::string& name, Command command, const Interrupt& interrupt);
+  /**
+   * @brief Run a command and wait for its result. If called by the worker thread (a command running other commands of
+   * the same device), the command runs immediately.
+   *
+   * @param name name of the command.
+   * @param command command to be run.
+   * @return true if the command has run and returned true.
+   * @return false otherwise.
+   */
+  bool run(const std::string& name, Command command);
+  /**
+   * @brief Check if the caller is the worker thread.
+   *
+   * @return true if the caller is the worker thread.
+   * @return false otherwise.
+   */
+  bool isWorkerThread() const;
+  /**
+   * @brief Check if the running command has been preempted by a stop. The commands run immediately by 'run' on the worker
+   * thread have their own handle, so the actions of the device check the running command between their steps.
+   *
+   * @return true if the running command has been preempted.
+   * @return false otherwise (or if no command is running).
+   */
+  bool isCancelled() const;
+  /**
+   * @brief Get the number of commands queued or running.
+   *
+   * @return size_t number of pending commands.
+   */
+  size_t getPendingCommands() const;
+  /**
+   * @brief Set the function notified by the worker thread when a command starts (running true) and when it ends (running false).
+   * The commands run immediately by 'run' on the worker thread are part of the running command and are not notified.
+   *
+   * @param observer function notified of the commands (e.g. to publish the running command with the state of the device).
+   */
+  void setObserver(Observer observer);
+
+ private:
+  /**
+   * @brief Run the commands until the queue is destroyed.
+   *
+   */
+  void work();
+
+  const std::string deviceName_;  /**< Name of the device. */
+  std::deque<std::pair<std::shared_ptr<DeviceCommand>, Command>> commands_;  /**< Commands waiting to be run. */
+  std::shared_ptr<DeviceCommand> running_;  /**< Command run by the worker thread (nullptr if idle). */
+  mutable std::mutex mutex_;  /**< Mutex protecting the queue. */
+  std::condition_variable condition_;  /**< Condition variable notified when a command is queued. */
+  bool stopped_ = false;  /**< True when the queue is destroyed. */
+  Observer observer_;  /**< Function notified when a command starts and ends. */
+  std::thread thread_;  /**< Worker thread of the device. */
+};
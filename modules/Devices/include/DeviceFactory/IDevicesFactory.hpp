@@ -21,6 +21,7 @@
 #include "ISingleStepperDeviceController.hpp"
 #include "IConfiguration.hpp"
 #include "IPostProcessing.hpp"
+#include "ScanPointStream.hpp"
 
 /**
  * @class IDevicesFactory
@@ -60,4 +61,14 @@ class IDevicesFactory {
   * @return shared pointer to XRaySensorDeviceController object.
   */
   virtual std::shared_ptr<ISingleStepperDeviceController> createXRaySensorDeviceController() = 0;
+  /**
+  * @brief get the stream where the scans of all the devices publish the acquired points.
+  * @return shared pointer to ScanPointStream object.
+  */
+  virtual std::shared_ptr<scanning::ScanPointStream> getScanPointStream() = 0;
+  /**
+  * @brief get the configuration shared by the devices (e.g. alignment settings read by the recipes).
+  * @return shared pointer to IConfiguration object.
+  */
+  virtual std::shared_ptr<IConfiguration> getConfiguration() = 0;
 };
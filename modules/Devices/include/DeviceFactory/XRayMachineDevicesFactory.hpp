@@ -16,13 +16,16 @@
 
 #include <string>
 #include <cassert>
+#include <chrono>
 #include <memory>
 
 #include "IDevicesFactory.hpp"
 #include "HXP.hpp"
 #include "XIMC.hpp"
 #include "Configuration.hpp"
+#include "ProjectPaths.hpp"
 #include "PostProcessing.hpp"
+#include "PythonWorkerPostProcessing.hpp"
 #include "ScanningHXP.hpp"
 #include "ScanningStepper.hpp"
 #include "Sensors.hpp"
@@ -52,7 +55,7 @@ class XRayMachineDevicesFactory : public IDevicesFactory {
   /**
    * @brief Construct a new XRayMachineDevicesFactory object.
    * 
-   * Creates the objects of the classes Sensors, Configuration and PostProcessing.
+   * Creates the objects of the classes Sensors, Configuration, PythonWorkerPostProcessing and ScanPointStream.
    * 
    */
   XRayMachineDevicesFactory();
@@ -67,9 +70,12 @@ class XRayMachineDevicesFactory : public IDevicesFactory {
   std::shared_ptr<IMultiStepperDeviceController> createSlitDeviceController() override;
   std::shared_ptr<ISingleStepperDeviceController> createXRaySensorDeviceController() override;
   std::shared_ptr<ISingleStepperDeviceController> createXRaySourceDeviceController() override;
+  std::shared_ptr<ScanPointStream> getScanPointStream() override;
+  std::shared_ptr<IConfiguration> getConfiguration() override;
   std::shared_ptr<ISensors> clientSensors_;  /**< Shared pointer to ISensor Class. */
   std::shared_ptr<IConfiguration> clientConfiguration_;  /**< Shared pointer to IConfiguration Class. */
   std::shared_ptr<IPostProcessing> clientPostProcessing_;  /**< Shared pointer to IPostProcessing Class. */
-  std::filesystem::path currentPath_;
-  std::filesystem::path projectName_;  /**< Name of the project. */
+  std::shared_ptr<ScanPointStream> scanPointStream_;  /**< Shared pointer to ScanPointStream Class shared by all the scans. */
+  std::shared_ptr<const ProjectPaths> projectPaths_;  /**< Directories of the project. */
+  const std::chrono::milliseconds configurationWatcherPeriod_{1000};  /**< Period of the checks of the configuration files edited on disk. */
 };
@@ -0,0 +1,151 @@
+/**
+ * @file DeviceOrchestrator.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class running the steps of a procedure involving several devices, in parallel when they do not depend on each other.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DeviceCommandQueue.hpp"
+
+/**
+ * @class DeviceOrchestrator
+ * @brief Class running the steps of a procedure involving several devices (e.g. the alignment of the beam).
+ *
+ * Each step is a command of a device and can depend on steps added before it, so the steps form an acyclic graph. All the
+ * steps are queued to their devices at once: the steps without dependencies run in parallel, each on the worker thread of
+ * its device, while a dependent step waits on the worker thread of its device until its dependencies have finished. If a
+ * dependency fails or is cancelled, the dependent step is not run (e.g. no acquisition while a device may still be in the
+ * beam). The caller is never blocked and the duration of a stage is the one of its slowest step. The orchestrator can be
+ * destroyed once started: the queued steps do not refer to it.
+ *
+ * @code
+ * DeviceOrchestrator orchestrator("Source alignment");
+ * size_t slit = orchestrator.addStep(client_Slit, "move out of beam", [this] { return client_Slit->alignSourceWithSensor(); });
+ * size_t sensor = orchestrator.addStep(client_XraySensor, "move out of beam", [this] { return client_XraySensor->alignSourceWithSensor(false); });
+ * orchestrator.addStep(client_XRaySource, "align", [this] { return client_XRaySource->alignSourceWithSensor(true); }, {slit, sensor});
+ * orchestrator.start();
+ * @endcode
+ *
+ */
+class DeviceOrchestrator {
+ public:
+  using Submit = std::function<std::shared_ptr<DeviceCommand>(const std::string& name, std::function<bool()> command)>;  /**< Function queueing a command to a device. */
+
+  DeviceOrchestrator() = delete;
+  /**
+   * @brief Construct a new DeviceOrchestrator object.
+   *
+   * @param name name of the procedure (used in the logs and in the names of the commands).
+   */
+  explicit DeviceOrchestrator(std::string name);
+  /**
+   * @brief Add a step run by a device controller (any class providing submitCommand, e.g. ISingleStepperDeviceController).
+   *
+   * @param device device running the step.
+   * @param name name of the step.
+   * @param command command of the step.
+   * @param dependencies indexes of the steps that must succeed before this step is run.
+   * @return size_t index of the step.
+   */
+  template <class Device>
+  size_t addStep(std::shared_ptr<Device> device, const std::string& name, std::function<bool()> command,
+                 const std::vector<size_t>& dependencies = {}) {
+    return this->addStep([device](const std::string& commandName, std::function<bool()> deviceCommand) {
+      return device->submitCommand(commandName, std::move(deviceCommand));
+    }, name, std::move(command), dependencies);
+  }
+  /**
+   * @brief Add a step queued by a generic function.
+   *
+   * @param submit function queueing the command to the device.
+   * @param name name of the step.
+   * @param command command of the step.
+   * @param dependencies indexes of the steps that must succeed before this step is run.
+   * @return size_t index of the step (steps with unknown dependencies are not added: the index is then getStepsCount()).
+   */
+  size_t addStep(Submit submit, const std::string& name, std::function<bool()> command,
+                 const std::vector<size_t>& dependencies = {});
+  /**
+   * @brief Queue all the steps to their devices.
+   *
+   * @return std::vector<std::shared_ptr<DeviceCommand>> handles of the steps, in the order they were added.
+   */
+  std::vector<std::shared_ptr<DeviceCommand>> start();
+  /**
+   * @brief Wait until all the steps have finished.
+   *
+   * @return true if all the steps succeeded.
+   * @return false otherwise (or if the procedure has not been started).
+   */
+  bool wait() const;
+  /**
+   * @brief Check if all the steps have finished.
+   *
+   * @return true if all the steps have finished.
+   * @return false otherwise.
+   */
+  bool isDone() const;
+  /**
+   * @brief Get the progress of the procedure.
+   *
+   * @return double mean progress of the steps, between 0 and 1.
+   */
+  double getProgress() const;
+  /**
+   * @brief Get the number of steps.
+   *
+   * @return size_t number of steps.
+   */
+  size_t getStepsCount() const;
+
+ private:
+  /**
+   * @struct Step
+   * @brief Struct containing a step of the procedure.
+   *
+   */
+  struct Step {
+    std::string name;  /**< Name of the step. */
+    Submit submit;  /**< Function queueing the command to the device. */
+    std::function<bool()> command;  /**< Command of the step. */
+    std::vector<size_t> dependencies;  /**< Steps that must succeed before this step. */
+    std::shared_ptr<DeviceCommand> handle;  /**< Handle of the queued command (nullptr before start). */
+    std::mutex mutex;  /**< Mutex protecting the handle, read by the worker thread while waiting for the dependencies. */
+  };
+  /**
+   * @brief Wait on the worker thread of a step until its dependencies have finished.
+   *
+   * @param name name of the procedure.
+   * @param step step waiting.
+   * @param dependencies handles of the dependencies.
+   * @param pollingPeriod period of the checks of a cancelled step.
+   * @return true if all the dependencies succeeded.
+   * @return false if one of them failed or if the step has been cancelled.
+   */
+  static bool waitForDependencies(const std::string& name,
+                                  const std::shared_ptr<Step>& step,
+                                  const std::vector<std::shared_ptr<DeviceCommand>>& dependencies,
+                                  std::chrono::milliseconds pollingPeriod);
+
+  const std::string name_;  /**< Name of the procedure. */
+  std::vector<std::shared_ptr<Step>> steps_;  /**< Steps of the procedure, in the order they were added. */
+  std::vector<std::shared_ptr<DeviceCommand>> handles_;  /**< Handles of the steps (empty before start). */
+  const std::chrono::milliseconds pollingPeriod_ = std::chrono::milliseconds(10);  /**< Period of the checks of a cancelled step. */
+};
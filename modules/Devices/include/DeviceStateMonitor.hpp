@@ -0,0 +1,124 @@
+/**
+ * @file DeviceStateMonitor.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class publishing the state of the state machine of a device, read by the other threads without locking.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+/**
+ * @struct DeviceStateSnapshot
+ * @brief Struct containing the state of a device at the moment of its last update.
+ *
+ */
+struct DeviceStateSnapshot {
+  int state = 0;  /**< Value of the status enumeration of the device (e.g. 'CrystalStatus'). */
+  const char* stateName = "";  /**< Name of the state, as returned by 'getFsmState'. */
+  std::string action;  /**< Name of the command running on the device (empty if the device is idle). */
+  double timestamp = 0;  /**< Time of the update (seconds since epoch). */
+  uint64_t sequence = 0;  /**< Number of updates published before this one. */
+};
+
+/**
+ * @class DeviceStateMonitor
+ * @brief Class publishing the state of a device and the command it is running.
+ *
+ * The worker thread of the device publishes the state after every event of the state machine and the command when it
+ * starts and ends. The readers (e.g. the thread sending the status to the GUI) get a consistent snapshot with a few atomic
+ * loads (sequence lock): they never lock a mutex nor query the state machine driven by the worker thread.
+ * The listeners are notified on the publishing thread, so that the status can be pushed as soon as it changes.
+ *
+ * @code
+ * static const char* const kStateNames[] = {"Not Defined", "Not Initialized", "Connected"};
+ * DeviceStateMonitor monitor(kStateNames, 3, 1);
+ * monitor.addListener([](const DeviceStateSnapshot& snapshot) { spdlog::info("{}\n", snapshot.stateName); });
+ * monitor.setAction("start");
+ * monitor.publish(2);
+ * @endcode
+ *
+ */
+class DeviceStateMonitor {
+ public:
+  using Listener = std::function<void(const DeviceStateSnapshot& snapshot)>;  /**< Function notified of every update. */
+
+  DeviceStateMonitor() = delete;
+  /**
+   * @brief Construct a new DeviceStateMonitor object.
+   *
+   * @param stateNames names of the states, indexed by the values of the status enumeration (static strings).
+   * @param statesCount number of states.
+   * @param initialState initial state.
+   */
+  DeviceStateMonitor(const char* const* stateNames, int statesCount, int initialState);
+  /**
+   * @brief Get the state of the device (one atomic load).
+   *
+   * @return int value of the status enumeration of the device.
+   */
+  int getState() const;
+  /**
+   * @brief Get a consistent snapshot of the state, of the running command and of the time of the last update.
+   *
+   * @return DeviceStateSnapshot snapshot of the device.
+   */
+  DeviceStateSnapshot getSnapshot() const;
+  /**
+   * @brief Publish the state of the device. Nothing is published if the state and the command did not change.
+   *
+   * @param state value of the status enumeration of the device.
+   */
+  void publish(int state);
+  /**
+   * @brief Publish the command running on the device.
+   *
+   * @param action name of the command (empty when the device is idle).
+   */
+  void setAction(const std::string& action);
+  /**
+   * @brief Add a listener notified of every update, on the thread publishing it.
+   *
+   * @param listener function notified of every update (it must not block, nor add or remove listeners).
+   * @return size_t id of the listener.
+   */
+  size_t addListener(Listener listener);
+  /**
+   * @brief Remove a listener.
+   *
+   * @param id id returned by 'addListener'.
+   */
+  void removeListener(size_t id);
+
+ private:
+  /**
+   * @brief Write a new snapshot and notify the listeners. The caller holds 'writerMutex_'.
+   *
+   * @param state value of the status enumeration of the device.
+   * @param action interned name of the running command.
+   */
+  void write(int state, const std::string* action);
+
+  const char* const* stateNames_;  /**< Names of the states. */
+  const int statesCount_;  /**< Number of states. */
+  std::atomic<uint64_t> sequence_{0};  /**< Sequence lock: odd while a snapshot is written, incremented twice per update. */
+  std::atomic<int> state_;  /**< State of the device. */
+  std::atomic<const std::string*> action_;  /**< Running command (element of 'actions_'). */
+  std::atomic<double> timestamp_;  /**< Time of the last update (seconds since epoch). */
+  std::set<std::string> actions_;  /**< Names of the commands run so far: the elements are never moved nor erased. */
+  std::map<size_t, Listener> listeners_;  /**< Listeners notified of every update. */
+  size_t nextListenerId_ = 0;  /**< Id of the next listener. */
+  std::mutex writerMutex_;  /**< Mutex serialising the writers and the listeners (never taken by the readers). */
+};
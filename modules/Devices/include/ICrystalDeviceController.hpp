@@ -12,9 +12,15 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 
+#include "DeviceCommandQueue.hpp"
+#include "DeviceStateMonitor.hpp"
+
 /**
  * @brief Interface used to control the crystal device moved by a stepper motor and an hexapod robot.
  * 
@@ -128,6 +134,15 @@ class ICrystalDeviceController {
      */
     virtual double getPositionW() = 0;
 
+    /**
+     * @brief This function returns the version of the configuration used by the last crystal measurement.
+     * 
+     * The measurements read the configuration files from a snapshot taken at their start (see IConfiguration::takeSnapshot()).
+     * 
+     * @return version of the configuration, 0 if no measurement has been started.
+     */
+    virtual uint64_t getConfigurationVersion() = 0;
+
     /**
      *  @brief Method used to process the event to go to the FSM state 'systemConnected'.
      * 
@@ -213,6 +228,28 @@ class ICrystalDeviceController {
      */
     virtual std::string getFsmState() = 0;
 
+    /**
+     * @brief Method used to get the FSM state, the running command and the time of the last transition without locking.
+     * 
+     * @return DeviceStateSnapshot consistent snapshot of the device.
+     */
+    virtual DeviceStateSnapshot getStateSnapshot() = 0;
+
+    /**
+     * @brief Method used to add a listener notified of every transition of the FSM and of every command started or ended.
+     * 
+     * @param listener function called on the worker thread of the device (it must not block).
+     * @return size_t id of the listener.
+     */
+    virtual size_t addStateListener(DeviceStateMonitor::Listener listener) = 0;
+
+    /**
+     * @brief Method used to remove a listener added by 'addStateListener'.
+     * 
+     * @param id id of the listener.
+     */
+    virtual void removeStateListener(size_t id) = 0;
+
     /**
      * @brief Method used to launch the event 'eventMoveHxpToAbsolutePosition'.
      * 
@@ -421,4 +458,23 @@ class ICrystalDeviceController {
      * @return true otherwise.
      */
     virtual bool torsionAngleMeasurement() = 0;
+
+    /**
+     * @brief Method used to queue a command in the queue of the device. The command runs on the worker thread of the device,
+     * after the commands queued before it, and can call the other methods of the controller (e.g. [this] { return goHome(); }).
+     * 
+     * @param name name of the command.
+     * @param command command to be run.
+     * @return std::shared_ptr<DeviceCommand> handle used to follow the progress and to wait for the result of the command.
+     */
+    virtual std::shared_ptr<DeviceCommand> submitCommand(const std::string& name, std::function<bool()> command) = 0;
+
+    /**
+     * @brief Method used to queue the event 'eventStopMovement' in front of the queue of the device, preempting the running command.
+     * 
+     * @note The queued commands are cancelled and the running one is interrupted immediately (see Actions::stop).
+     * 
+     * @return std::shared_ptr<DeviceCommand> handle of the stop command.
+     */
+    virtual std::shared_ptr<DeviceCommand> submitStop() = 0;
 };
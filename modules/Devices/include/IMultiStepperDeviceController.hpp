@@ -12,9 +12,14 @@
 
 #pragma once
 
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 
+#include "DeviceCommandQueue.hpp"
+#include "DeviceStateMonitor.hpp"
+
 class IMultiStepperDeviceController {
  public:
     int max_size = 1048576 * 5;  /**< Maximum size of the sink logger (5mb in this case). */
@@ -155,6 +160,28 @@ class IMultiStepperDeviceController {
      */
     virtual std::string getFsmState() = 0;
 
+    /**
+     * @brief Method used to get the FSM state, the running command and the time of the last transition without locking.
+     * 
+     * @return DeviceStateSnapshot consistent snapshot of the device.
+     */
+    virtual DeviceStateSnapshot getStateSnapshot() = 0;
+
+    /**
+     * @brief Method used to add a listener notified of every transition of the FSM and of every command started or ended.
+     * 
+     * @param listener function called on the worker thread of the device (it must not block).
+     * @return size_t id of the listener.
+     */
+    virtual size_t addStateListener(DeviceStateMonitor::Listener listener) = 0;
+
+    /**
+     * @brief Method used to remove a listener added by 'addStateListener'.
+     * 
+     * @param id id of the listener.
+     */
+    virtual void removeStateListener(size_t id) = 0;
+
     /**
      * @brief Method used to process the event to go to the FSM state 'systemScan'.
      * 
@@ -212,4 +239,23 @@ class IMultiStepperDeviceController {
      * @return true otherwise.
      */
     virtual bool alignSlit(bool alignDevice) = 0;
+
+    /**
+     * @brief Method used to queue a command in the queue of the device. The command runs on the worker thread of the device,
+     * after the commands queued before it, and can call the other methods of the controller (e.g. [this] { return goHome(); }).
+     * 
+     * @param name name of the command.
+     * @param command command to be run.
+     * @return std::shared_ptr<DeviceCommand> handle used to follow the progress and to wait for the result of the command.
+     */
+    virtual std::shared_ptr<DeviceCommand> submitCommand(const std::string& name, std::function<bool()> command) = 0;
+
+    /**
+     * @brief Method used to queue the event 'eventStopMovement' in front of the queue of the device, preempting the running command.
+     * 
+     * @note The queued commands are cancelled and the running one is interrupted immediately (see Actions::stop).
+     * 
+     * @return std::shared_ptr<DeviceCommand> handle of the stop command.
+     */
+    virtual std::shared_ptr<DeviceCommand> submitStop() = 0;
 };
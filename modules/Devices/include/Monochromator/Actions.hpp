@@ -15,6 +15,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <functional>
 #include <memory>
 #include <filesystem>
 
@@ -22,7 +23,10 @@
 #include "IScanning.hpp"
 #include "ISensors.hpp"
 #include "IConfiguration.hpp"
+#include "ProjectPaths.hpp"
+#include "ConfigurationTransaction.hpp"
 #include "IPostProcessing.hpp"
+#include "ConcurrentMotion.hpp"
 
 using namespace scanning;  // NOLINT
 using namespace sensors;  // NOLINT
@@ -110,6 +114,13 @@ class Actions {
    * @return false otherwise.
    */
   bool stop();
+  /**
+   * @brief Set the function telling the multi-step actions that the running command has been preempted by a stop: they end
+   * before their next step and fail.
+   * 
+   * @param isCancelled function returning true when the running command has been preempted.
+   */
+  void setCancellationCheck(std::function<bool()> isCancelled);
   /**
    * @brief Get the position (in mm) of the stepper motor that controls the linear motion of the device.
    * 
@@ -143,6 +154,7 @@ class Actions {
    * 
    * @note The target positions are stored in the parameters 'stepper1LinearPosition_' and
    * 'stepper2RotationalPosition_' and must be set before calling this method.
+   * The two stages move at the same time (see 'ConcurrentMotion') and the method returns when both have stopped.
    * 
    * @return true if the movement has been executed.
    * @return false otherwise.
@@ -207,6 +219,13 @@ class Actions {
   float getCenterPosition();
 
  private:
+  /**
+   * @brief Check if the running command has been preempted by a stop.
+   * 
+   * @return true if the action must end before its next step.
+   * @return false otherwise.
+   */
+  bool isCancelled() const;
   std::shared_ptr<IMotor> clientStepper1Linear_;  /**< Shared pointer to IMotor Class. This pointer controls the motion of the linear stage of the device. */
   std::shared_ptr<IMotor> clientStepper2Rotational_;  /**< Shared pointer to IMotor Class. This pointer controls the motion of the rotational stage of the device. */
   std::shared_ptr<scanning::IScanning> clientScanning1Linear_;  /**< Shared pointer to IScanning Class. */
@@ -219,11 +238,12 @@ class Actions {
   bool searchCenter_;  /**< Parameter that controls whether to compute the alignment position or not. */
   float centerLinearPosition_;  /**< Parameter that stores the alignment position of the linear axis of the device. */
   float centerRotationalPosition_;  /**< Parameter that stores the alignment position of the rotational axis of the device. */
-  std::filesystem::path pathToProjDirectory_ = clientSensors_->getPathToProjDirectory();
-  std::filesystem::path pathToLogFilesDirectory_ = pathToProjDirectory_ / "LogFiles";  /**< Path to the log file directory. */
-  std::filesystem::path pathToScriptDirectory_ = pathToProjDirectory_ / "modules\\Devices\\scripts\\Monochromator";  /**< Path to the directory where the python scripts are stored. */
+  ProjectPaths projectPaths_{clientSensors_->getPathToProjDirectory()};  /**< Directories of the project. */
+  std::filesystem::path pathToLogFilesDirectory_ = projectPaths_.getLogDirectory();  /**< Path to the log file directory. */
+  std::filesystem::path pathToScriptDirectory_ = projectPaths_.getScriptsDirectory() / "Monochromator";  /**< Path to the directory where the python scripts are stored. */
   std::filesystem::path monochromatorAlignmentResultsDirectoryName_ = "MonochromatorAlignmentResults";
-  std::string pathToMonochromatorAlinmentResultsDirectory_;  /**< Path to the directory where the alignment positions are stored in the .csv files. */
+  std::filesystem::path pathToMonochromatorAlinmentResultsDirectory_;  /**< Path to the directory where the alignment positions are stored in the .csv files. */
+  std::function<bool()> isCancelled_;  /**< Function telling if the running command has been preempted by a stop. */
 };
 
 }  // namespace monochromator
@@ -18,6 +18,7 @@
 #include <string>
 #include <memory>
 
+#include "ActionResult.hpp"
 #include "Monochromator/Actions.hpp"
 #include "Monochromator/Events.hpp"
 
@@ -39,6 +40,7 @@ class systemError;
 class System{
  private:
   std::shared_ptr<Actions> actions_;
+  ActionResult lastAction_;  /**< Result of the action run by the last guard. */
 
  public:
   explicit System(std::shared_ptr<Actions> actions) noexcept:
@@ -56,8 +58,8 @@ class System{
     state<systemNotInitialized> + event<eventInitialize> = state<systemError>,
     // From SystemConnected
     state<systemConnected> + event<eventSetupHome> [([this] { return true; })] = state<systemInMotion>,
-    state<systemConnected> + event<eventDisconnect> [([this] { return actions_->disconnect(); })] = state<systemNotInitialized>,
-    state<systemConnected> + event<eventDisconnect> [([this] { return !actions_->disconnect(); })] = state<systemError>,
+    state<systemConnected> + event<eventDisconnect> [([this] { return lastAction_.store(actions_->disconnect()); })] = state<systemNotInitialized>,
+    state<systemConnected> + event<eventDisconnect> [([this] { return lastAction_.failed(); })] = state<systemError>,
     state<systemConnected> + event<eventMoveStepper1LinearToRelativePosition> [([this] { return true; })] = state<systemInMotion>,
     state<systemConnected> + event<eventMoveStepper2RotationalToRelativePosition> [([this] { return true; })] = state<systemInMotion>,
     state<systemConnected> + event<eventStartScanStepper1Linear> [([this] { return true; })]  = state<systemInMotion>,
@@ -66,24 +68,24 @@ class System{
     state<systemConnected> + event<eventAlignMonochromator> [([this] { return true; })]  = state<systemInMotion>,
     state<systemConnected> + event<eventSearchMonochromatorBraggPeak> [([this] { return true; })]  = state<systemInMotion>,
     // From systemInMotion
-    state<systemInMotion> + event<eventSetupHome> [([this] { return actions_->goHome(); })] = state<systemHome>,
-    state<systemInMotion> + event<eventSetupHome> [([this] { return !actions_->goHome(); })] = state<systemError>,
-    state<systemInMotion> + event<eventStartScanStepper1Linear> [([this] { return actions_->startScanStepper1Linear(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventStartScanStepper1Linear> [([this] { return !actions_->startScanStepper1Linear(); })] = state<systemError>,
-    state<systemInMotion> + event<eventStartScanStepper2Rotational> [([this] { return actions_->startScanStepper2Rotational(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventStartScanStepper2Rotational> [([this] { return !actions_->startScanStepper2Rotational(); })] = state<systemError>,
-    state<systemInMotion> + event<eventMoveStepper1LinearToRelativePosition> [([this] { return actions_->moveCalibratedMotor1Linear(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventMoveStepper1LinearToRelativePosition> [([this] { return !actions_->moveCalibratedMotor1Linear(); })] = state<systemError>,
-    state<systemInMotion> + event<eventMoveStepper2RotationalToRelativePosition> [([this] { return actions_->moveCalibratedMotor2Rotational(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventMoveStepper2RotationalToRelativePosition> [([this] { return !actions_->moveCalibratedMotor2Rotational(); })] = state<systemError>,
-    state<systemInMotion> + event<eventAlignSourceWithSensor> [([this] { return actions_->moveBothMotors(); })]  = state<systemConnected>,
-    state<systemInMotion> + event<eventAlignSourceWithSensor> [([this] { return !actions_->moveBothMotors(); })] = state<systemError>,
-    state<systemInMotion> + event<eventAlignMonochromator> [([this] { return actions_->alignMonochromator(); })]  = state<systemConnected>,
-    state<systemInMotion> + event<eventAlignMonochromator> [([this] { return !actions_->alignMonochromator(); })] = state<systemError>,
-    state<systemInMotion> + event<eventSearchMonochromatorBraggPeak> [([this] { return actions_->searchMonochromatorBraggPeak(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventSearchMonochromatorBraggPeak> [([this] { return !actions_->searchMonochromatorBraggPeak(); })] = state<systemError>,
-    state<systemInMotion> + event<eventStopMovement> [([this] { return actions_->stop(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventStopMovement> [([this] { return !actions_->stop(); })] = state<systemError>,
+    state<systemInMotion> + event<eventSetupHome> [([this] { return lastAction_.store(actions_->goHome()); })] = state<systemHome>,
+    state<systemInMotion> + event<eventSetupHome> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventStartScanStepper1Linear> [([this] { return lastAction_.store(actions_->startScanStepper1Linear()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventStartScanStepper1Linear> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventStartScanStepper2Rotational> [([this] { return lastAction_.store(actions_->startScanStepper2Rotational()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventStartScanStepper2Rotational> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventMoveStepper1LinearToRelativePosition> [([this] { return lastAction_.store(actions_->moveCalibratedMotor1Linear()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventMoveStepper1LinearToRelativePosition> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventMoveStepper2RotationalToRelativePosition> [([this] { return lastAction_.store(actions_->moveCalibratedMotor2Rotational()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventMoveStepper2RotationalToRelativePosition> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventAlignSourceWithSensor> [([this] { return lastAction_.store(actions_->moveBothMotors()); })]  = state<systemConnected>,
+    state<systemInMotion> + event<eventAlignSourceWithSensor> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventAlignMonochromator> [([this] { return lastAction_.store(actions_->alignMonochromator()); })]  = state<systemConnected>,
+    state<systemInMotion> + event<eventAlignMonochromator> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventSearchMonochromatorBraggPeak> [([this] { return lastAction_.store(actions_->searchMonochromatorBraggPeak()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventSearchMonochromatorBraggPeak> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventStopMovement> [([this] { return lastAction_.store(actions_->stop()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventStopMovement> [([this] { return lastAction_.failed(); })] = state<systemError>,
     // From System Home
     state<systemHome> + event<eventDisconnect> / [this] { actions_->disconnect(); } = state<systemNotInitialized>,
     state<systemHome> + event<eventMoveStepper1LinearToRelativePosition> [([this] { return true; })] = state<systemInMotion>,
@@ -94,8 +96,9 @@ class System{
     state<systemHome> + event<eventAlignMonochromator> [([this] { return true; })]  = state<systemInMotion>,
     state<systemHome> + event<eventSearchMonochromatorBraggPeak> [([this] { return true; })]  = state<systemInMotion>,
     // From System Error
-    state<systemError> + event<eventInitialize> [([this] { return actions_->connect(); })] = state<systemConnected>,
-    state<systemError> + event<eventInitialize> [([this] { return !actions_->connect(); })] = state<systemError>,
+    state<systemError> + event<eventStopMovement> [([this] { return lastAction_.store(actions_->stop()); })] = state<systemConnected>,  // action interrupted by a stop
+    state<systemError> + event<eventInitialize> [([this] { return lastAction_.store(actions_->connect()); })] = state<systemConnected>,
+    state<systemError> + event<eventInitialize> [([this] { return lastAction_.failed(); })] = state<systemError>,
     state<systemError> + event<eventDisconnect> / [this] { actions_->disconnect(); } = state<systemNotInitialized>);  // end transition table
   }
 };
@@ -0,0 +1,248 @@
+/**
+ * @file RecipeEngine.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class running measurement recipes: sequences of device actions described in a file.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <ini.h>
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DeviceCommandQueue.hpp"
+#include "DeviceOrchestrator.hpp"
+
+using RecipeParameters = std::map<std::string, std::string>;  /**< Parameters of a step (lower case keys). */
+
+/**
+ * @struct RecipeStep
+ * @brief Struct containing a step of a recipe.
+ *
+ */
+struct RecipeStep {
+  std::string name;  /**< Name of the step (lower case, unique in the recipe). */
+  std::string action;  /**< Name of the action run by the step (lower case). */
+  RecipeParameters parameters;  /**< Parameters of the action. */
+  std::vector<std::string> dependencies;  /**< Steps whose results are used by this step. */
+};
+
+/**
+ * @struct Recipe
+ * @brief Struct containing a recipe: the steps of a measurement sequence (e.g. the characterisation of a crystal).
+ *
+ */
+struct Recipe {
+  std::string name;  /**< Name of the recipe (used for the progress file). */
+  std::vector<RecipeStep> steps;  /**< Steps of the recipe, in the order they are queued. */
+};
+
+/**
+ * @brief Load a recipe from a .ini file.
+ * @details The section 'RECIPE' contains the NAME of the recipe, each other section is a step named after the section.
+ * The key ACTION is the action of the step and DEPENDS_ON the comma separated list of the steps it depends on: without
+ * it the step depends on the previous one, with DEPENDS_ON = NONE on no step. The other keys are the parameters.
+ *
+ * @code
+ * [RECIPE]
+ * NAME = Crystal characterisation
+ * [BENDING]
+ * ACTION = bending angle
+ * [REPROCESS_BENDING]
+ * ACTION = reprocess scans
+ * SUMMARY = Summary_Bending_Angle_Scans.csv
+ * [MISCUT]
+ * ACTION = miscut angle
+ * DEPENDS_ON = BENDING
+ * @endcode
+ *
+ * @param pathToRecipeFile path to the .ini file.
+ * @param recipe recipe read from the file.
+ * @return true if the file has been read.
+ * @return false otherwise.
+ */
+bool loadRecipe(const std::filesystem::path& pathToRecipeFile, Recipe& recipe);
+
+/**
+ * @brief Kinds of the actions of a recipe.
+ *
+ */
+enum class RecipeActionKind { Motion, Analysis };
+
+/**
+ * @struct RecipeAction
+ * @brief Struct containing an action that the steps of a recipe can run.
+ *
+ */
+struct RecipeAction {
+  std::vector<std::string> requiredParameters;  /**< Parameters that a step must define (lower case). */
+  std::function<bool(const RecipeParameters& parameters)> run;  /**< Function running the action. */
+  std::function<double(const RecipeParameters& parameters)> estimate;  /**< Estimated duration of the action [s] (optional). */
+  std::function<bool(const RecipeParameters& parameters)> validate;  /**< Check of the values of the parameters (optional). */
+};
+
+/**
+ * @class RecipeEngine
+ * @brief Class validating, estimating and running recipes.
+ *
+ * The motion actions run on the worker thread of their device and the analysis actions on the worker thread of the
+ * engine, so the analysis of a step overlaps the motion of the next steps that do not depend on it. The completed steps
+ * are stored in a progress file: running the same recipe again after a failure skips them. The file is removed when all
+ * the steps have succeeded. The engine must outlive the recipes it runs (the analysis queue belongs to it).
+ *
+ */
+class RecipeEngine {
+ public:
+  RecipeEngine() = delete;
+  /**
+   * @brief Construct a new RecipeEngine object.
+   *
+   * @param pathToProgressDirectory directory where the progress files of the recipes are stored.
+   */
+  explicit RecipeEngine(std::filesystem::path pathToProgressDirectory);
+  /**
+   * @brief Register an action moving a device (any class providing submitCommand, e.g. ICrystalDeviceController).
+   *
+   * @param name name of the action.
+   * @param device device running the action.
+   * @param action definition of the action.
+   */
+  template <class Device>
+  void registerMotion(const std::string& name, std::shared_ptr<Device> device, RecipeAction action) {
+    this->registerAction(name, RecipeActionKind::Motion, device.get(),
+                         [device](const std::string& commandName, std::function<bool()> command) {
+                           return device->submitCommand(commandName, std::move(command));
+                         }, std::move(action));
+  }
+  /**
+   * @brief Register an action analysing data, run on the worker thread of the engine.
+   *
+   * @param name name of the action.
+   * @param action definition of the action.
+   */
+  void registerAnalysis(const std::string& name, RecipeAction action);
+  /**
+   * @brief Check a recipe before running it: known actions, required parameters, unique names and dependencies on
+   * previous steps. All the problems found are logged.
+   *
+   * @param recipe recipe to check.
+   * @return true if the recipe can be run.
+   * @return false otherwise.
+   */
+  bool validate(const Recipe& recipe) const;
+  /**
+   * @brief Estimate the duration of a recipe, taking into account the steps running in parallel and the steps already
+   * completed in a previous run.
+   *
+   * @param recipe recipe (validated).
+   * @return double estimated duration [s].
+   */
+  double estimateDuration(const Recipe& recipe) const;
+  /**
+   * @brief Validate and queue the steps of a recipe, resuming it if a previous run failed.
+   *
+   * @param recipe recipe to run.
+   * @return std::vector<std::shared_ptr<DeviceCommand>> handles of the steps, in the order of the recipe (empty if the
+   * recipe is not valid).
+   */
+  std::vector<std::shared_ptr<DeviceCommand>> start(const Recipe& recipe);
+  /**
+   * @brief Wait until the steps of the last recipe started have finished.
+   *
+   * @return true if all the steps succeeded.
+   * @return false otherwise (or if no recipe has been started).
+   */
+  bool wait() const;
+  /**
+   * @brief Get the path to the progress file of a recipe.
+   *
+   * @param recipe recipe.
+   * @return std::filesystem::path path to the .ini file storing the completed steps.
+   */
+  std::filesystem::path getPathToProgressFile(const Recipe& recipe) const;
+
+ private:
+  /**
+   * @struct RegisteredAction
+   * @brief Struct containing a registered action and the device running it.
+   *
+   */
+  struct RegisteredAction {
+    RecipeActionKind kind = RecipeActionKind::Motion;  /**< Kind of the action. */
+    const void* resource = nullptr;  /**< Device (or analysis queue) running the action: one action at a time. */
+    DeviceOrchestrator::Submit submit;  /**< Function queueing the action to its device. */
+    RecipeAction action;  /**< Definition of the action. */
+  };
+  /**
+   * @struct Progress
+   * @brief Struct containing the completed steps of a recipe, shared by the steps running on different threads.
+   *
+   */
+  struct Progress {
+    std::filesystem::path path;  /**< Path to the progress file. */
+    std::string name;  /**< Name of the recipe. */
+    std::string fingerprint;  /**< Fingerprint of the steps: a progress file is resumed only by the same recipe. */
+    size_t stepsCount = 0;  /**< Number of steps of the recipe. */
+    std::set<std::string> completed;  /**< Names of the completed steps. */
+    std::mutex mutex;  /**< Mutex protecting the completed steps and the file. */
+    /**
+     * @brief Register a completed step and save the progress file (removed once all the steps are completed).
+     *
+     * @param step name of the step.
+     */
+    void complete(const std::string& step);
+  };
+  /**
+   * @brief Register an action.
+   *
+   * @param name name of the action.
+   * @param kind kind of the action.
+   * @param resource device running the action.
+   * @param submit function queueing the action to its device.
+   * @param action definition of the action.
+   */
+  void registerAction(const std::string& name, RecipeActionKind kind, const void* resource,
+                      DeviceOrchestrator::Submit submit, RecipeAction action);
+  /**
+   * @brief Read the progress file of a recipe.
+   *
+   * @param recipe recipe.
+   * @return std::shared_ptr<Progress> progress (no completed steps if the file is missing or belongs to another recipe).
+   */
+  std::shared_ptr<Progress> loadProgress(const Recipe& recipe) const;
+  /**
+   * @brief Get the indexes of the steps a step depends on.
+   *
+   * @param recipe recipe (validated).
+   * @param index index of the step.
+   * @return std::vector<size_t> indexes of the dependencies.
+   */
+  static std::vector<size_t> getDependencies(const Recipe& recipe, size_t index);
+  /**
+   * @brief Compute the fingerprint of the steps of a recipe.
+   *
+   * @param recipe recipe.
+   * @return std::string fingerprint.
+   */
+  static std::string getFingerprint(const Recipe& recipe);
+
+  std::filesystem::path pathToProgressDirectory_;  /**< Directory where the progress files are stored. */
+  std::map<std::string, RegisteredAction> actions_;  /**< Registered actions, by name. */
+  std::vector<std::shared_ptr<DeviceCommand>> handles_;  /**< Handles of the steps of the last recipe started. */
+  DeviceCommandQueue analysisQueue_;  /**< Queue running the analysis actions. */
+};
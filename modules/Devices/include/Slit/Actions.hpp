@@ -16,6 +16,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <functional>
 #include <memory>
 #include <filesystem>
 
@@ -23,7 +24,10 @@
 #include "IScanning.hpp"
 #include "ISensors.hpp"
 #include "IConfiguration.hpp"
+#include "ProjectPaths.hpp"
+#include "ConfigurationTransaction.hpp"
 #include "IPostProcessing.hpp"
+#include "ConcurrentMotion.hpp"
 
 using namespace scanning;  // NOLINT
 using namespace sensors;  // NOLINT
@@ -126,6 +130,13 @@ class Actions {
    * @return false otherwise.
    */
   bool stop();
+  /**
+   * @brief Set the function telling the multi-step actions that the running command has been preempted by a stop: they end
+   * before their next step and fail.
+   * 
+   * @param isCancelled function returning true when the running command has been preempted.
+   */
+  void setCancellationCheck(std::function<bool()> isCancelled);
   /**
    * @brief Get the position (in mm) of the stepper motor that controls the linear motion of the device.
    * 
@@ -159,6 +170,7 @@ class Actions {
    * 
    * @note The target positions are stored in the parameters 'stepper1LinearPosition_' and
    * 'stepper2RotationalPosition_' and must be set before calling this method.
+   * The two stages move at the same time (see 'ConcurrentMotion') and the method returns when both have stopped.
    * 
    * @return true if the movement has been executed.
    * @return false otherwise.
@@ -194,6 +206,13 @@ class Actions {
   void setAlignDevice(bool alignDevice);
 
  private:
+  /**
+   * @brief Check if the running command has been preempted by a stop.
+   * 
+   * @return true if the action must end before its next step.
+   * @return false otherwise.
+   */
+  bool isCancelled() const;
   std::shared_ptr<IMotor> clientStepper1Linear_;
   std::shared_ptr<IMotor> clientStepper2Rotational_;
   std::shared_ptr<scanning::IScanning> clientScanning1Linear_;
@@ -206,11 +225,12 @@ class Actions {
   bool alignDevice_;
   float centerLinearPosition_;
   float centerRotationalPosition_;
-  std::filesystem::path pathToProjDirectory_ = clientSensors_->getPathToProjDirectory();
-  std::filesystem::path pathToLogFilesDirectory_ = pathToProjDirectory_ / "LogFiles";
-  std::filesystem::path pathToScriptDirectory = pathToProjDirectory_ / "modules\\Devices\\scripts\\Slit";
+  ProjectPaths projectPaths_{clientSensors_->getPathToProjDirectory()};  /**< Directories of the project. */
+  std::filesystem::path pathToLogFilesDirectory_ = projectPaths_.getLogDirectory();
+  std::filesystem::path pathToScriptDirectory = projectPaths_.getScriptsDirectory() / "Slit";
   std::filesystem::path slitAlignmentResultsDirectoryName_ = "SlitAlignmentResults";
-  std::string pathToSlitAlinmentResultsDirectory_;
+  std::filesystem::path pathToSlitAlinmentResultsDirectory_;
+  std::function<bool()> isCancelled_;  /**< Function telling if the running command has been preempted by a stop. */
 };
 
 }  // namespace slit
@@ -19,6 +19,7 @@
 #include <string>
 #include <memory>
 
+#include "ActionResult.hpp"
 #include "XRaySensor/Actions.hpp"
 #include "XRaySensor/Events.hpp"
 
@@ -40,6 +41,7 @@ class systemError;
 class System{
  private:
   std::shared_ptr<Actions> actions_;
+  ActionResult lastAction_;  /**< Result of the action run by the last guard. */
 
  public:
   explicit System(std::shared_ptr<Actions> actions) noexcept:
@@ -58,26 +60,27 @@ class System{
 
     // From SystemConnected
     state<systemConnected> + event<eventSetupHome> [([this] { return true; })] = state<systemInMotion>,
-    state<systemConnected> + event<eventDisconnect> [([this] { return actions_->disconnect(); })] = state<systemNotInitialized>,
-    state<systemConnected> + event<eventDisconnect> [([this] { return !actions_->disconnect(); })] = state<systemError>,
+    state<systemConnected> + event<eventDisconnect> [([this] { return lastAction_.store(actions_->disconnect()); })] = state<systemNotInitialized>,
+    state<systemConnected> + event<eventDisconnect> [([this] { return lastAction_.failed(); })] = state<systemError>,
     state<systemConnected> + event<eventMoveStepperToRelativePosition> [([this] { return true; })] = state<systemInMotion>,
     state<systemConnected> + event<eventStartScanStepper> [([this] { return true; })]  = state<systemInMotion>,
     // From systemInMotion
-    state<systemInMotion> + event<eventSetupHome> [([this] { return actions_->goHome(); })] = state<systemHome>,
-    state<systemInMotion> + event<eventSetupHome> [([this] { return !actions_->goHome(); })] = state<systemError>,
-    state<systemInMotion> + event<eventMoveStepperToRelativePosition> [([this] { return actions_->moveCalibratedMotor(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventMoveStepperToRelativePosition> [([this] { return !actions_->moveCalibratedMotor(); })] = state<systemError>,
-    state<systemInMotion> + event<eventStartScanStepper> [([this] { return actions_->startScanStepper(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventStartScanStepper> [([this] { return !actions_->startScanStepper(); })] = state<systemError>,
-    state<systemInMotion> + event<eventStopMovement> [([this] { return actions_->stop(); })] = state<systemConnected>,
-    state<systemInMotion> + event<eventStopMovement> [([this] { return !actions_->stop(); })] = state<systemError>,
+    state<systemInMotion> + event<eventSetupHome> [([this] { return lastAction_.store(actions_->goHome()); })] = state<systemHome>,
+    state<systemInMotion> + event<eventSetupHome> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventMoveStepperToRelativePosition> [([this] { return lastAction_.store(actions_->moveCalibratedMotor()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventMoveStepperToRelativePosition> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventStartScanStepper> [([this] { return lastAction_.store(actions_->startScanStepper()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventStartScanStepper> [([this] { return lastAction_.failed(); })] = state<systemError>,
+    state<systemInMotion> + event<eventStopMovement> [([this] { return lastAction_.store(actions_->stop()); })] = state<systemConnected>,
+    state<systemInMotion> + event<eventStopMovement> [([this] { return lastAction_.failed(); })] = state<systemError>,
     // From System Home
     state<systemHome> + event<eventDisconnect> / [this] { actions_->disconnect(); } = state<systemNotInitialized>,
     state<systemHome> + event<eventMoveStepperToRelativePosition> [([this] { return true; })] = state<systemInMotion>,
     state<systemHome> + event<eventStartScanStepper> [([this] { return true; })] = state<systemInMotion>,
     // From System Error
-    state<systemError> + event<eventInitialize> [([this] { return actions_->connect(); })] = state<systemConnected>,
-    state<systemError> + event<eventInitialize> [([this] { return !actions_->connect(); })] = state<systemError>,
+    state<systemError> + event<eventStopMovement> [([this] { return lastAction_.store(actions_->stop()); })] = state<systemConnected>,  // action interrupted by a stop
+    state<systemError> + event<eventInitialize> [([this] { return lastAction_.store(actions_->connect()); })] = state<systemConnected>,
+    state<systemError> + event<eventInitialize> [([this] { return lastAction_.failed(); })] = state<systemError>,
     state<systemError> + event<eventDisconnect> / [this] { actions_->disconnect(); } = state<systemNotInitialized>);  // end transition table
   }
 };
@@ -22,6 +22,7 @@
 #include "IScanning.hpp"
 #include "ISensors.hpp"
 #include "IConfiguration.hpp"
+#include "ProjectPaths.hpp"
 #include "IPostProcessing.hpp"
 
 using namespace scanning;  // NOLINT
@@ -130,11 +131,11 @@ class Actions {
   float stepperPosition_;  /**< Parameter that stores the target position of the stepper motor. */
   bool searchCenter_;   /**< Parameter that controls whether to compute the alignment position or not. */
   float centerPosition_;  /**< Parameter that stores the alignment position fo the device. */
-  std::filesystem::path pathToProjDirectory_ = clientSensors_->getPathToProjDirectory();
-  std::filesystem::path pathToLogFilesDirectory_ = pathToProjDirectory_ / "LogFiles";  /**< Path to the directory where the log files are stored. */
-  std::filesystem::path pathToScriptDirectory_ = pathToProjDirectory_ / "modules\\Devices\\scripts\\XRaySource";  /**< Path to the directory where the python scripts are stored. */
+  ProjectPaths projectPaths_{clientSensors_->getPathToProjDirectory()};  /**< Directories of the project. */
+  std::filesystem::path pathToLogFilesDirectory_ = projectPaths_.getLogDirectory();  /**< Path to the directory where the log files are stored. */
+  std::filesystem::path pathToScriptDirectory_ = projectPaths_.getScriptsDirectory() / "XRaySource";  /**< Path to the directory where the python scripts are stored. */
   std::filesystem::path xRaySourceAlignmentResultsDirectoryName_ = "XRaySourceAlignmentResults";
-  std::string pathToXRaySourceAlinmentResultsDirectory_;  /**< Path to the directory where the alignment positions are stored in the .csv files. */
+  std::filesystem::path pathToXRaySourceAlinmentResultsDirectory_;  /**< Path to the directory where the alignment positions are stored in the .csv files. */
 };
 
 }  // namespace xRaySource
@@ -0,0 +1,112 @@
+import contextlib
+import io
+import json
+import os
+import runpy
+import socket
+import sys
+import threading
+import time
+import traceback
+
+def runScript(request):
+    """
+    Brief
+    --------
+    Runs a post processing script in the interpreter of the worker, as if it was started from the command line.
+
+    Parameters
+    --------
+    request (dict): request sent by the class PythonWorkerPostProcessing, with the keys
+                    'id' (int), 'script' (string), 'args' (list of strings), 'data' (dict) and 'timeout' (float, seconds).
+
+    Returns
+    --------
+    dict: result of the script, with the keys 'id', 'status' ("ok" or "error"), 'exitCode', 'stdout', 'stderr' and 'duration'.
+
+    The script is executed with runpy as '__main__' and sys.argv set to the script followed by the arguments, so the scripts
+    run unmodified. The in-memory data of the request is available to the script as the global variable WORKER_DATA.
+    The modules imported by a script (pandas, scipy, matplotlib, seaborn...) stay loaded for the next requests.
+    If the script does not end before the timeout the worker exits, and it is restarted by the C++ side.
+    """
+    script = request["script"]
+    arguments = [str(argument) for argument in request.get("args", [])]
+    timeout = float(request.get("timeout", 0))
+    watchdog = None
+    if timeout > 0:
+        watchdog = threading.Timer(timeout, os._exit, args=(3,))
+        watchdog.daemon = True
+        watchdog.start()
+
+    stdout = io.StringIO()
+    stderr = io.StringIO()
+    exitCode = 0
+    savedArgv = sys.argv
+    sys.argv = [script] + arguments
+    start = time.perf_counter()
+    try:
+        with contextlib.redirect_stdout(stdout), contextlib.redirect_stderr(stderr):
+            runpy.run_path(script, init_globals={"WORKER_DATA": request.get("data", {})}, run_name="__main__")
+    except SystemExit as error:
+        if error.code is None:
+            exitCode = 0
+        elif isinstance(error.code, int):
+            exitCode = error.code
+        else:
+            stderr.write(str(error.code) + "\n")
+            exitCode = 1
+    except BaseException:
+        stderr.write(traceback.format_exc())
+        exitCode = 1
+    finally:
+        sys.argv = savedArgv
+        if watchdog is not None:
+            watchdog.cancel()
+        if "matplotlib.pyplot" in sys.modules:
+            sys.modules["matplotlib.pyplot"].close("all")  # the figures of a script are not kept alive by the worker
+
+    return {
+        "id": request.get("id", 0),
+        "status": "ok" if exitCode == 0 else "error",
+        "exitCode": exitCode,
+        "stdout": stdout.getvalue(),
+        "stderr": stderr.getvalue(),
+        "duration": time.perf_counter() - start
+    }
+
+def main():
+    """
+    Brief
+    --------
+    Connects to the class PythonWorkerPostProcessing and serves its requests until the connection is closed.
+
+    Input Args
+    --------
+    sys.argv[1] (string): port on 127.0.0.1 where the C++ side is listening.
+
+    Details
+    --------
+    Requests and results are JSON objects, one per line. The request {"command": "shutdown"} stops the worker,
+    the request {"command": "ping"} is answered with {"id": ..., "status": "ok"}.
+    """
+    port = int(sys.argv[1])
+    connection = socket.create_connection(("127.0.0.1", port))
+    stream = connection.makefile("rw", encoding="utf-8", newline="\n")
+    for line in stream:
+        if not line.strip():
+            continue
+        request = json.loads(line)
+        command = request.get("command", "run")
+        if command == "shutdown":
+            break
+        if command == "ping":
+            response = {"id": request.get("id", 0), "status": "ok"}
+        else:
+            response = runScript(request)
+        stream.write(json.dumps(response) + "\n")
+        stream.flush()
+    connection.close()
+
+# Main
+if __name__ == "__main__":
+    main()
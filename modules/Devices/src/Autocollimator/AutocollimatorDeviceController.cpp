@@ -10,20 +10,32 @@
  * 
  */
 
+#include <iterator>
 #include <string>
 
 #include "AutocollimatorDeviceController.hpp"
 
 namespace autocollimator {
 
+namespace {
+
+const char* const kAutocollimatorStatusNames[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
+
+}  // namespace
+
 AutocollimatorDeviceController::AutocollimatorDeviceController(std::filesystem::path logFilePath,
                                                                std::shared_ptr<IMotor> clientStepper,
                                                                std::shared_ptr<scanning::IScanning> clientScanning):
     logFilePath_(logFilePath),
     actionsPtr_(std::make_shared<Actions>(clientStepper, clientScanning)),
     scanningPtr_(clientScanning),
-    sMachine_(System(actionsPtr_)) {
+    sMachine_(System(actionsPtr_)),
+    stateMonitor_(kAutocollimatorStatusNames, std::size(kAutocollimatorStatusNames), static_cast<int>(AutocollimatorStatus::NotInitialized)),
+    commandQueue_("Autocollimator") {
     spdlog::info("cTor AutocollimatorDeviceController\n");
+    commandQueue_.setObserver([this](const std::string& name, bool running) {
+        stateMonitor_.setAction(running ? name : "");  // the command is published with the state
+    });
 }
 
 AutocollimatorDeviceController::~AutocollimatorDeviceController() {
@@ -31,37 +43,43 @@ AutocollimatorDeviceController::~AutocollimatorDeviceController() {
 }
 
 bool AutocollimatorDeviceController::start() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
-        sMachine_.process_event(eventInitialize{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("start", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
+            this->processEvent(eventInitialize{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool AutocollimatorDeviceController::disconnectStp() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventDisconnect{});
-    }
-    if (!sMachine_.is(state<systemNotInitialized>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("disconnectStp", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventDisconnect{});
+        }
+        if (!sMachine_.is(state<systemNotInitialized>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool AutocollimatorDeviceController::goHome() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventSetupHome{});
-        sMachine_.process_event(eventSetupHome{});
-    }
-    if (!sMachine_.is(state<systemHome>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("goHome", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventSetupHome{});
+            this->processEvent(eventSetupHome{});
+        }
+        if (!sMachine_.is(state<systemHome>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 float AutocollimatorDeviceController::getPositionStepper() {
@@ -69,16 +87,18 @@ float AutocollimatorDeviceController::getPositionStepper() {
 }
 
 bool AutocollimatorDeviceController::moveToPositionStepper(float position) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        actionsPtr_->setStepperPosition(position);
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("moveToPositionStepper", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            actionsPtr_->setStepperPosition(position);
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool AutocollimatorDeviceController::scanStepper(float stepSize,
@@ -87,11 +107,25 @@ bool AutocollimatorDeviceController::scanStepper(float stepSize,
                                                  std::string filename,
                                                  bool eraseCsvContent,
                                                  bool showPlot) {
+    return commandQueue_.run("scanStepper", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            scanningPtr_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
+            this->processEvent(eventStartScanStepper{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventStartScanStepper{});  // event that allows to start the scan
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
+}
+
+bool AutocollimatorDeviceController::stopMovement(bool interrupted) {
     using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        scanningPtr_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
-        sMachine_.process_event(eventStartScanStepper{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventStartScanStepper{});  // event that allows to start the scan
+    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) ||
+        (interrupted && sMachine_.is(state<systemError>))) {  // the interrupted action has failed
+        this->processEvent(eventStopMovement{});
     }
     if (!sMachine_.is(state<systemConnected>)) {
         return false;
@@ -100,53 +134,65 @@ bool AutocollimatorDeviceController::scanStepper(float stepSize,
 }
 
 bool AutocollimatorDeviceController::stop() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventStopMovement{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
+    if (commandQueue_.isWorkerThread()) {
+        return this->stopMovement(false);
     }
-    return true;
+    return this->submitStop()->wait();
+}
+
+std::shared_ptr<DeviceCommand> AutocollimatorDeviceController::submitCommand(const std::string& name, std::function<bool()> command) {
+    return commandQueue_.submit(name, [command](DeviceCommand&) { return command(); });
+}
+
+std::shared_ptr<DeviceCommand> AutocollimatorDeviceController::submitStop() {
+    return commandQueue_.preempt("stop",
+                                 [this](DeviceCommand& command) { return this->stopMovement(command.hasInterrupted()); },
+                                 [this] { actionsPtr_->stop(); });  // ends the scan running on the worker thread
 }
 
 bool AutocollimatorDeviceController::alignSourceWithSensor(bool searchCenter) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepperPosition(0);
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("alignSourceWithSensor", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepperPosition(0);
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool AutocollimatorDeviceController::setupMonochromatorBraggPeakSearch() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepperPosition(0);
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("setupMonochromatorBraggPeakSearch", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepperPosition(0);
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool AutocollimatorDeviceController::setupForCrystalBraggPeakSearch() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepperPosition(0);
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("setupForCrystalBraggPeakSearch", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepperPosition(0);
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool AutocollimatorDeviceController::logger(std::string filename) {
@@ -156,13 +202,28 @@ bool AutocollimatorDeviceController::logger(std::string filename) {
 }
 
 std::string AutocollimatorDeviceController::getFsmState() {
-    static const char *EnumCrystalStatusStrings[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
-    std::string temp = EnumCrystalStatusStrings[static_cast<int>(this->getStatus())];
+    std::string temp = kAutocollimatorStatusNames[stateMonitor_.getState()];
     spdlog::debug("AutocollimatorDeviceController FSM state is: {}\n", temp);
     return temp;
 }
 
+DeviceStateSnapshot AutocollimatorDeviceController::getStateSnapshot() {
+    return stateMonitor_.getSnapshot();
+}
+
+size_t AutocollimatorDeviceController::addStateListener(DeviceStateMonitor::Listener listener) {
+    return stateMonitor_.addListener(std::move(listener));
+}
+
+void AutocollimatorDeviceController::removeStateListener(size_t id) {
+    stateMonitor_.removeListener(id);
+}
+
 AutocollimatorStatus AutocollimatorDeviceController::getStatus() {
+    return static_cast<AutocollimatorStatus>(stateMonitor_.getState());
+}
+
+AutocollimatorStatus AutocollimatorDeviceController::readStatus() {
     using namespace boost::sml;  // NOLINT
     if (sMachine_.is(state<systemNotInitialized>)) {
         autocollimatorStatus_ = AutocollimatorStatus::NotInitialized;
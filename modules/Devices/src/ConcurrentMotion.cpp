@@ -0,0 +1,73 @@
+/**
+ * @file ConcurrentMotion.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class moving the axes of independent motor controllers at the same time.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "ConcurrentMotion.hpp"
+
+#include <chrono>
+#include <exception>
+#include <future>
+
+ConcurrentMotion::ConcurrentMotion(const std::string& device):
+                                   device_(device) {
+}
+
+void ConcurrentMotion::add(const std::string& axis, std::function<bool()> movement) {
+    axes_.push_back(axis);
+    movements_.push_back(std::move(movement));
+}
+
+bool ConcurrentMotion::run() {
+    failedAxes_.clear();
+    if (movements_.empty()) {
+        return true;
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<std::future<bool>> results;
+    for (size_t index = 1; index < movements_.size(); index++) {
+        results.push_back(std::async(std::launch::async, [this, index] { return this->move(index); }));
+    }
+    std::vector<bool> succeeded(movements_.size(), false);
+    succeeded[0] = this->move(0);  // the first axis is moved by the calling thread
+    for (size_t index = 1; index < movements_.size(); index++) {
+        succeeded[index] = results[index - 1].get();  // joined also when another axis failed
+    }
+    for (size_t index = 0; index < movements_.size(); index++) {
+        if (!succeeded[index]) {
+            failedAxes_.push_back(axes_[index]);
+        }
+    }
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    if (!failedAxes_.empty()) {
+        std::string failedAxes;
+        for (const std::string& axis : failedAxes_) {
+            failedAxes += (failedAxes.empty() ? "" : ", ") + axis;
+        }
+        spdlog::error("{}: movement failed on {} of {} axes ({}) after {:.2f} s\n",
+                      device_, failedAxes_.size(), axes_.size(), failedAxes, duration);
+        return false;
+    }
+    spdlog::info("{}: {} axes moved concurrently in {:.2f} s\n", device_, axes_.size(), duration);
+    return true;
+}
+
+std::vector<std::string> ConcurrentMotion::getFailedAxes() const {
+    return failedAxes_;
+}
+
+bool ConcurrentMotion::move(size_t index) const {
+    try {
+        return movements_[index]();
+    } catch (const std::exception& e) {
+        spdlog::error("{}: movement of the {} axis threw an exception ({})\n", device_, axes_[index], e.what());
+        return false;
+    }
+}
@@ -14,6 +14,14 @@
 
 namespace crystal {
 
+namespace {
+const char* const kPeakValueColumn = "Peak Value (au)";  /**< Column of the value of the Bragg peaks (as written by the scripts). */
+const char* const kYPositionColumn = "Y-Axis Position (mm)";  /**< Column of the Y axis positions of the Bragg peaks. */
+const char* const kZPositionColumn = "Z-Axis Position (mm)";  /**< Column of the Z axis positions of the Bragg peaks. */
+const char* const kWPositionColumn = "W-Axis Position (deg)";  /**< Column of the Bragg angles. */
+const float kStepperPositionTolerance = 0.01;  /**< Maximum difference between the stepper positions of a cached alignment and of the current one. */
+}  // namespace
+
 Actions::Actions(std::shared_ptr<IHXP> clientHxp,
                  std::shared_ptr<IMotor> clientStepper,
                  std::shared_ptr<IScanning> clientScanningHXP,
@@ -34,7 +42,8 @@ Actions::Actions(std::shared_ptr<IHXP> clientHxp,
                                                                                     "CRYSTAL_WIDTH")),
                  stepperPosition_(0) {
     spdlog::info("cTor Actions Crystal\n");
-    pathToCrystalAlinmentResultsDirectory_ = (clientConfiguration_->getPathToLogFilesDirectory() / crystalAlignmentResultsDirectoryName_).string();
+    pathToCrystalAlinmentResultsDirectory_ = clientConfiguration_->getPathToLogFilesDirectory() / crystalAlignmentResultsDirectoryName_;
+    alignmentCache_ = std::make_unique<AlignmentCache>(pathToCrystalAlinmentResultsDirectory_ / alignmentCacheFilename_);
     hxpAlignmentCoord_.CoordX = 0;
 }
 
@@ -69,6 +78,7 @@ bool Actions::goHome() {
     spdlog::info("Method goHome Crystal of class Actions\n");
     int result_goHome_hxp = clientHxp_->goHome();
     int result_goHome_stepper = clientStepper_->go_home();
+    alignmentCacheState_ = AlignmentCacheState::NotVerified;  // the crystal may be remounted
     if (result_goHome_hxp == 0 && result_goHome_stepper == 0) {
         return true;
     } else {
@@ -102,17 +112,26 @@ bool Actions::moveCalibratedMotor() {
 }
 
 bool Actions::moveBothMotors() {
-    bool result_movement_hxp = this->setHxpPositionAbsolute();
-    bool result_movement_stepper_rotational = this->moveCalibratedMotor();
-    if (result_movement_hxp == true && result_movement_stepper_rotational == true) {
+    ConcurrentMotion motion("Crystal");  // the hexapod and the stepper have separate controllers
+    motion.add("hexapod", [this] { return this->setHxpPositionAbsolute(); });
+    motion.add("stepper rotational", [this] { return this->moveCalibratedMotor(); });
+    return motion.run();
+}
+
+bool Actions::searchXAxisAlignmentCrystal() {
+    spdlog::info("Method searchXAxisAlignmentCrystal Crystal of class Actions\n");
+    alignmentCacheState_ = AlignmentCacheState::NotVerified;  // new alignment sequence
+    if (this->reuseCachedAlignment("X-axis alignment", false)) {
         return true;
-    } else {
+    }
+    XAxisAlignmentSettings settings;
+    if (!alignmentSettings::load(*clientConfiguration_, settings)) {
         return false;
     }
+    return this->runXAxisAlignment(settings);
 }
 
-bool Actions::searchXAxisAlignmentCrystal() {
-    spdlog::info("Method searchXAxisAlignmentCrystal Crystal of class Actions\n");
+bool Actions::runXAxisAlignment(const XAxisAlignmentSettings& settings) {
     /* Initial Movement */
     clientScanningHXP_->hxpAxisToScan_ = 1;
     this->moveBothMotors();
@@ -121,25 +140,13 @@ bool Actions::searchXAxisAlignmentCrystal() {
         return false;
     }
     /* Setup .csvs result */
-    std::string resultAlignmentCrystalXAxisFileNamePath = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                          + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                                  clientConfiguration_->getPath(),
-                                                                                                                  "XAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                                  "FILENAME_TO_X_ALIGNMENT_POSITION");
+    std::string resultAlignmentCrystalXAxisFileNamePath = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToResult).string();
     clientSensors_->flushCsv(resultAlignmentCrystalXAxisFileNamePath);  // Erase content
-    std::filesystem::path scriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                     clientConfiguration_->getPath(),
-                                                                                                     "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                     "SCRIPT_NAME");
-    std::filesystem::path pathToAlignmentScript = pathToScriptDirectory_ / scriptName;
+    std::filesystem::path pathToAlignmentScript = pathToScriptDirectory_ / settings.scriptName;
     const std::string pathToAlignmentScript_string = pathToAlignmentScript.string();
     /* Execute Alignment script */
-    std::string dataLogFileName = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                                clientConfiguration_->getPath(),
-                                                                                                                "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                                "DATA_LOG_FILENAME");
     clientPostProcessing_->executeScript2(pathToAlignmentScript_string,
-                                          dataLogFileName,
+                                          settings.dataLogFilename,
                                           resultAlignmentCrystalXAxisFileNamePath);
     /* Read new X-Axis positions and update .ini file */
     hxpAlignmentCoord_.CoordX = clientSensors_->readCsvResult(resultAlignmentCrystalXAxisFileNamePath);
@@ -158,6 +165,9 @@ bool Actions::searchXAxisAlignmentCrystal() {
 
 bool Actions::searchZAxisAlignmentCrystal() {
     spdlog::info("Method searchZAxisAlignmentCrystal Crystal of class Actions\n");
+    if (this->reuseCachedAlignment("Z-axis alignment", false)) {
+        return true;
+    }
     /* Initial Movement */
     bool result_movement = this->moveBothMotors();
     if (!result_movement) {
@@ -168,11 +178,11 @@ bool Actions::searchZAxisAlignmentCrystal() {
         return false;
     }
     /* Setup .csvs result */
-    std::string resultAlignmentCrystalZAxisFileNamePath = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                          + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+    std::string resultAlignmentCrystalZAxisFileNamePath = (pathToCrystalAlinmentResultsDirectory_
+                                                          / clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                                   clientConfiguration_->getPath(),
                                                                                                                   "zAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                                  "FILENAME_TO_Z_ALIGNMENT_POSITION");
+                                                                                                                  "FILENAME_TO_Z_ALIGNMENT_POSITION")).string();
     clientSensors_->flushCsv(resultAlignmentCrystalZAxisFileNamePath);  // Erase content
     std::filesystem::path scriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                      clientConfiguration_->getPath(),
@@ -206,6 +216,14 @@ bool Actions::searchZAxisAlignmentCrystal() {
 
 bool Actions::searchYAxisAlignmentCrystal() {
     spdlog::info("Method searchYAxisAlignmentCrystal Crystal of class Actions\n");
+    if (this->reuseCachedAlignment("Y-axis alignment", false)) {
+        return true;
+    }
+    YAxisAlignmentSettings settings;
+    XAxisAlignmentSettings xAxisSettings;  // X alignment at every step of the W axis
+    if (!alignmentSettings::load(*clientConfiguration_, settings) || !alignmentSettings::load(*clientConfiguration_, xAxisSettings)) {
+        return false;
+    }
     /* Initial Movement */
     double initialPositionYAxis = clientHxp_->getCoordinateY();
     double initialPositionWAxis = clientHxp_->getCoordinateW();
@@ -214,40 +232,20 @@ bool Actions::searchYAxisAlignmentCrystal() {
     if (!result_movement) {
         return false;
     }
-    std::filesystem::path scriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                     clientConfiguration_->getPath(),
-                                                                                                     "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                     "SCRIPT_NAME_OFFSET");
-    std::filesystem::path pathAlignmentScript = pathToScriptDirectory_ / scriptName;
+    std::filesystem::path pathAlignmentScript = pathToScriptDirectory_ / settings.scriptNameOffset;
     const std::string pathToAlignmentOffsetScript_string = pathAlignmentScript.string();
     /* Setup .csvs result */
-    const std::string pathToSlopes = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                               + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                       clientConfiguration_->getPath(),
-                                                                                                       "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                       "FILENAME_TO_Y_SLOPES");
+    const std::string pathToSlopes = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToSlopes).string();
     clientSensors_->flushCsv(pathToSlopes);  // Erase content
-    const std::string pathToResultWaxis = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                               + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                       clientConfiguration_->getPath(),
-                                                                                                       "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                       "FILENAME_TO_W_ALIGNMENT_POSITION");
-    clientSensors_->flushCsv(pathToResultWaxis);  // Erase content 
-    const std::string pathToResultXaxis = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                               + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                       clientConfiguration_->getPath(),
-                                                                                                       "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                       "FILENAME_TO_X_ALIGNMENT_POSITION");
-    clientSensors_->flushCsv(pathToResultXaxis);  // Erase content                                                                                                 
-    const float stepSizeOffeset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                       clientConfiguration_->getPath(),
-                                                                                       "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                       "STEP_SIZE_W");
-    const float stopOffset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                  clientConfiguration_->getPath(),
-                                                                                  "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                  "RANGE_W");  // Range W Scan
-    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset) {
+    const std::string pathToResultWaxis = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToWAlignmentPosition).string();
+    clientSensors_->flushCsv(pathToResultWaxis);  // Erase content
+    const std::string pathToResultXaxis = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToXAlignmentPosition).string();
+    clientSensors_->flushCsv(pathToResultXaxis);  // Erase content
+    const float stepSizeOffeset = settings.stepSizeW;
+    const float stopOffset = settings.rangeW;  // Range W Scan
+    AnalysisBatch analyses;
+    int iteration = 0;
+    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset, iteration++) {
         nextWAxisPosition = initialPositionWAxis + i;
         /* Movement to initial position */
         clientHxp_->setCoordinateX(-10);
@@ -256,90 +254,64 @@ bool Actions::searchYAxisAlignmentCrystal() {
         if (!result_movement && !clientScanningHXP_->checkReachingPosition(clientHxp_->getPositionW(), nextWAxisPosition)) {
             return false;
         }
+        if (this->isCancelled()) {
+            spdlog::warn("Y axis alignment interrupted by a stop\n");
+            return false;
+        }
         /* Align X axis */
-        clientScanningHXP_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
+        clientScanningHXP_->setupAlignmentParameters(xAxisSettings.stepSize,
+                                                     xAxisSettings.range,
+                                                     xAxisSettings.durationAcquisition,
+                                                     xAxisSettings.dataLogFilename,
+                                                     xAxisSettings.eraseCsvContent,
                                                      false);
-        this->searchXAxisAlignmentCrystal();
+        this->runXAxisAlignment(xAxisSettings);  // the cached alignment is checked once, at the start of the sequence
         /* Scan Y axis */
         clientScanningHXP_->hxpAxisToScan_ = 2;
-        clientScanningHXP_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE_Y"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "RANGE_Y"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME_Y_SCAN"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
+        clientScanningHXP_->setupAlignmentParameters(settings.stepSizeY,
+                                                     settings.rangeY,
+                                                     settings.durationAcquisition,
+                                                     settings.dataLogFilenameYScan,
+                                                     settings.eraseCsvContent,
                                                      false);
+        if (this->isCancelled()) {  // the result of the X alignment is not checked
+            spdlog::warn("Y axis alignment interrupted by a stop\n");
+            return false;
+        }
         bool result_scan = clientScanningHXP_->scanRelative();  // Y Scan
         if (!result_scan) {
             return false;
         }
-        /* Execute Alignment script */
+        /* Execute Alignment script while the next step is performed */
         std::string string_actual_WCoordinate = std::to_string(clientHxp_->getCoordinateW());
-        const std::string dataLogFileName = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                  clientConfiguration_->getPath(),
-                                                                                                  "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                  "DATA_LOG_FILENAME_Y_SCAN");
-        clientPostProcessing_->executeScript7(pathToAlignmentOffsetScript_string,
-                                              dataLogFileName,
-                                              pathToSlopes,
-                                              std::to_string(clientHxp_->getCoordinateW()),
-                                              std::to_string(clientHxp_->getCoordinateX()),
-                                              std::to_string(clientHxp_->getCoordinateY()),
-                                              pathToResultWaxis,
-                                              pathToResultXaxis
-                                              );
+        const std::string& dataLogFileName = settings.dataLogFilenameYScan;
+        const std::filesystem::path dataLogCopy = this->preserveScanDataLog(dataLogFileName, iteration);
+        analyses.add(clientPostProcessing_->executeScriptAsync(pathToAlignmentOffsetScript_string,
+                                                               {dataLogCopy.empty() ? dataLogFileName : dataLogCopy.filename().string(),
+                                                                pathToSlopes,
+                                                                std::to_string(clientHxp_->getCoordinateW()),
+                                                                std::to_string(clientHxp_->getCoordinateX()),
+                                                                std::to_string(clientHxp_->getCoordinateY()),
+                                                                pathToResultWaxis,
+                                                                pathToResultXaxis},
+                                                               pathToSlopes),
+                     nullptr,
+                     dataLogCopy);
+        if (dataLogCopy.empty()) {
+            analyses.wait();  // the next scan would overwrite the data log
+        }
         clientHxp_->setCoordinateY(initialPositionYAxis);  // return to initial position
     }
+    if (!analyses.wait()) {
+        return false;
+    }
     /* Read new X and W Axes positions and update .ini file */
     clientHxp_->setCoordinateW(clientSensors_->readCsvResult(pathToResultWaxis));
     clientHxp_->setCoordinateX(clientSensors_->readCsvResult(pathToResultXaxis));
-    int result_writeWAxisAlignmentPosition = clientConfiguration_->writeConfigurationFile(std::to_string(hxpAlignmentCoord_.CoordW),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_W",
-                                                                                          clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath());
-    int result_writeXAxisAlignmentPosition = clientConfiguration_->writeConfigurationFile(std::to_string(hxpAlignmentCoord_.CoordX),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X",
-                                                                                          clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath());
-    if (result_writeWAxisAlignmentPosition == 0) {
-        return false;
-    }
-    if (result_writeXAxisAlignmentPosition == 0) {
+    ConfigurationTransaction alignmentPositions(clientConfiguration_, clientConfiguration_->getConfigFilename(), clientConfiguration_->getPath());
+    alignmentPositions.set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W", hxpAlignmentCoord_.CoordW)
+                      .set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_X", hxpAlignmentCoord_.CoordX);
+    if (alignmentPositions.commit() == 0) {  // both positions or none
         return false;
     }
     /* Final movement to alignment position */
@@ -348,6 +320,18 @@ bool Actions::searchYAxisAlignmentCrystal() {
 
 bool Actions::searchYWAxesAlignmentCrystal() {
     spdlog::info("Method searchYWAxesAlignmentCrystal Crystal of class Actions\n");
+    if (this->reuseCachedAlignment("YW-axes alignment", false)) {
+        return true;
+    }
+    PivotPointSettings pivotSettings;
+    if (alignmentSettings::load(*clientConfiguration_, pivotSettings) && pivotSettings.enabled) {
+        spdlog::info("YW-axes alignment not needed: the rocking curves are executed about the impact point of the beam\n");
+        return true;
+    }
+    YWAxesAlignmentSettings settings;
+    if (!alignmentSettings::load(*clientConfiguration_, settings)) {
+        return false;
+    }
     /* Initial Movement */
     double initialPositionYAxis = clientHxp_->getCoordinateY();
     double initialPositionWAxis = clientHxp_->getCoordinateW();
@@ -356,64 +340,55 @@ bool Actions::searchYWAxesAlignmentCrystal() {
     if (!result_movement) {
         return false;
     }
-    std::filesystem::path scriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                     clientConfiguration_->getPath(),
-                                                                                                     "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                     "SCRIPT_NAME");
-    std::filesystem::path pathAlignmentScript = pathToScriptDirectory_ / scriptName;
+    std::filesystem::path pathAlignmentScript = pathToScriptDirectory_ / settings.scriptName;
     const std::string pathToYWAxesAlignmentScript_string = pathAlignmentScript.string();
     /* Setup .csvs result */
-    const std::string pathToResultYAlignment = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                               + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                       clientConfiguration_->getPath(),
-                                                                                                       "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                       "FILENAME_TO_Y_ALIGNMENT_POSITION");
-    const std::string pathToResultStdDevSlopes = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                 + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                         clientConfiguration_->getPath(),
-                                                                                                         "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                         "FILENAME_TO_STANDARD_DEVIATION_RESULT");
-    const std::string pathToSlopesYWAlignment = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                        clientConfiguration_->getPath(),
-                                                                                                        "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                        "FILENAME_TO_SLOPESFILE");
+    const std::string pathToResultYAlignment = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToYAlignmentPosition).string();
+    const std::string pathToResultStdDevSlopes = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToStandardDeviation).string();
+    const std::string pathToSlopesYWAlignment = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToSlopes).string();
     clientSensors_->flushCsv(pathToResultYAlignment);  // Erase content
     clientSensors_->flushCsv(pathToResultStdDevSlopes);  // Erase content
     clientSensors_->flushCsv(pathToSlopesYWAlignment);  // Erase content
-    const float stepSizeOffeset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                       clientConfiguration_->getPath(),
-                                                                                       "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                       "STEP_SIZE_SCAN_HXP_Y");
-    const float stopOffset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                  clientConfiguration_->getPath(),
-                                                                                  "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                  "RANGE_SCAN_HXP_Y");  // Range Y Scan
-    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset) {
+    const float stepSizeOffeset = settings.stepSizeScan;
+    const float stopOffset = settings.rangeScan;  // Range Y Scan
+    AnalysisBatch analyses;
+    int iteration = 0;
+    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset, iteration++) {
         nextYAxisPosition = initialPositionYAxis + i;
         clientHxp_->setCoordinateY(nextYAxisPosition);
         result_movement = this->setHxpPositionAbsolute();
         if (!result_movement && !clientScanningHXP_->checkReachingPosition(clientHxp_->getPositionY(), nextYAxisPosition)) {
             return false;
         }
+        if (this->isCancelled()) {
+            spdlog::warn("Y-W axes alignment interrupted by a stop\n");
+            return false;
+        }
         bool result_scan = clientScanningHXP_->scan();  // W Scan
         if (!result_scan) {
             return false;
         }
-        /* Execute Alignment script */
+        /* Execute Alignment script while the next step is performed */
         std::string string_actual_YCoordinate = std::to_string(clientHxp_->getCoordinateY());
-        const std::string dataLogFileName = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                  clientConfiguration_->getPath(),
-                                                                                                  "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                  "DATA_LOG_FILENAME");
-        clientPostProcessing_->executeScript5(pathToYWAxesAlignmentScript_string,
-                                              string_actual_YCoordinate,
-                                              dataLogFileName,
-                                              pathToResultYAlignment,
-                                              pathToResultStdDevSlopes,
-                                              pathToSlopesYWAlignment);
+        const std::string& dataLogFileName = settings.dataLogFilename;
+        const std::filesystem::path dataLogCopy = this->preserveScanDataLog(dataLogFileName, iteration);
+        analyses.add(clientPostProcessing_->executeScriptAsync(pathToYWAxesAlignmentScript_string,
+                                                               {string_actual_YCoordinate,
+                                                                dataLogCopy.empty() ? dataLogFileName : dataLogCopy.filename().string(),
+                                                                pathToResultYAlignment,
+                                                                pathToResultStdDevSlopes,
+                                                                pathToSlopesYWAlignment},
+                                                               pathToSlopesYWAlignment),
+                     nullptr,
+                     dataLogCopy);
+        if (dataLogCopy.empty()) {
+            analyses.wait();  // the next scan would overwrite the data log
+        }
         clientHxp_->setCoordinateW(initialPositionWAxis);  // return to initial position
     }
+    if (!analyses.wait()) {
+        return false;
+    }
     /* Read new Y and W Axes positions and update .ini file */
     hxpAlignmentCoord_.CoordY = clientSensors_->readCsvResult(pathToResultYAlignment);
     clientHxp_->setCoordinateY(hxpAlignmentCoord_.CoordY);
@@ -427,11 +402,13 @@ bool Actions::searchYWAxesAlignmentCrystal() {
         return false;
     }
 
-    float stdDevSlopes = clientSensors_->readCsvResult(pathToResultStdDevSlopes);  // std deviation of slopes
-    float thresholdSTD = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                              clientConfiguration_->getPath(),
-                                                                              "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                              "THRESHOLD_STD_DEVIATION");
+    const ResultFile resultStdDevSlopes = clientSensors_->readResult(pathToResultStdDevSlopes, 0);
+    float stdDevSlopes = 0;  // std deviation of slopes
+    if (!resultStdDevSlopes.getValue("Standard Deviation of slopes", stdDevSlopes)) {
+        spdlog::error("Alignment failed. Standard Deviation of slope differences not found in {}\n", pathToResultStdDevSlopes);
+        return false;
+    }
+    float thresholdSTD = settings.thresholdStdDeviation;
     if (stdDevSlopes > thresholdSTD) {
         spdlog::error("Alignment failed. Standard Deviation of slope differences exceeded threshold.\n");
         return false;
@@ -442,6 +419,13 @@ bool Actions::searchYWAxesAlignmentCrystal() {
 
 bool Actions::searchBraggPeakCrystal() {
     spdlog::info("Method searchBraggPeakCrystal Crystal of Class Action\n");
+    if (this->reuseCachedAlignment("Bragg peak search", false)) {
+        return true;
+    }
+    BraggPeakSearchSettings settings;
+    if (!alignmentSettings::load(*clientConfiguration_, settings)) {
+        return false;
+    }
     /* Initial Movement */
     bool result_movement = this->moveBothMotors();
     if (!result_movement) {
@@ -452,22 +436,11 @@ bool Actions::searchBraggPeakCrystal() {
         return false;
     }
     // Setup .csv result
-    const std::string pathToResultCrystalBraggPeakSearch = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                           + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                                   clientConfiguration_->getPath(),
-                                                                                                             "Braggs_Peak_Search_CRYSTAL_STAGE",
-                                                                                                             "FILENAME_TO_BRAGG_ANGLE");
+    const std::string pathToResultCrystalBraggPeakSearch = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToResult).string();
     clientSensors_->flushCsv(pathToResultCrystalBraggPeakSearch);  // Erase content
     // Bragg Peak search Script variables
-    const std::filesystem::path SearchCrystalBraggPeakScriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                                                 clientConfiguration_->getPath(),
-                                                                                                                                 "Braggs_Peak_Search_CRYSTAL_STAGE",
-                                                                                                                                 "SCRIPT_NAME");
-    std::filesystem::path pathToCrystalBraggPeakScript = pathToScriptDirectory_ / SearchCrystalBraggPeakScriptName;
-    const std::string dataLogFileName = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                              clientConfiguration_->getPath(),
-                                                                                              "Braggs_Peak_Search_CRYSTAL_STAGE",
-                                                                                              "DATA_LOG_FILENAME");
+    std::filesystem::path pathToCrystalBraggPeakScript = pathToScriptDirectory_ / settings.scriptName;
+    const std::string& dataLogFileName = settings.dataLogFilename;
     clientPostProcessing_->executeScript2(pathToCrystalBraggPeakScript.string(),
                                           dataLogFileName,
                                           pathToResultCrystalBraggPeakSearch);
@@ -487,11 +460,19 @@ bool Actions::searchBraggPeakCrystal() {
     if (!result_movement2) {
         return false;
     }
+    this->storeCachedAlignment();
     return true;
 }
 
 bool Actions::searchYAxisFineAlignment() {
     spdlog::info("Method searchYWAxesAlignmentCrystal Crystal of class Actions\n");
+    if (this->reuseCachedAlignment("Y-axis fine alignment", true)) {
+        return true;
+    }
+    YAxisFineAlignmentSettings settings;
+    if (!alignmentSettings::load(*clientConfiguration_, settings)) {
+        return false;
+    }
     /* Initial Movement */
     double initialPositionYAxis = clientHxp_->getCoordinateY();
     double initialPositionWAxis = clientHxp_->getCoordinateW();
@@ -501,42 +482,16 @@ bool Actions::searchYAxisFineAlignment() {
         return false;
     }
     /* Script Fully Opened Beam */
-    std::filesystem::path scriptNameFobComputation = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                                   clientConfiguration_->getPath(),
-                                                                                                                   "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                                   "SCRIPT_NAME_FULLY_OPENED_BEAM");
-
-    std::filesystem::path pathComputeFullyOpenedBeamScript = pathToScriptDirectory_ / scriptNameFobComputation;
+    std::filesystem::path pathComputeFullyOpenedBeamScript = pathToScriptDirectory_ / settings.scriptNameFullyOpenedBeam;
     const std::string pathToComputeFullyOpenedBeamScript_string = pathComputeFullyOpenedBeamScript.string();
     /* Script Y alignment */
-    std::filesystem::path scriptNameYinouComputation = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                                     clientConfiguration_->getPath(),
-                                                                                                                     "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                                     "SCRIPT_NAME");
-
-    std::filesystem::path pathAlignmentScript = pathToScriptDirectory_ / scriptNameYinouComputation;
+    std::filesystem::path pathAlignmentScript = pathToScriptDirectory_ / settings.scriptName;
     const std::string pathToYAxisFineAlignmentScript_string = pathAlignmentScript.string();
     /* Setup .csvs result */
-    const std::string pathToResultYAlignment = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                               + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                       clientConfiguration_->getPath(),
-                                                                                                       "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                       "FILENAME_TO_Y_ALIGNMENT_POSITION");
-    const std::string pathToYinFineAlignment = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                               + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                       clientConfiguration_->getPath(),
-                                                                                                       "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                       "FILENAME_TO_Yin");
-    const std::string pathToYoutFineAlignment = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                        clientConfiguration_->getPath(),
-                                                                                                        "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                        "FILENAME_TO_Yout");
-    const std::string pathToResultFullyOpenedBeam = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                    + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                            clientConfiguration_->getPath(),
-                                                                                                            "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                            "FILENAME_TO_FULLY_OPENED_BEAM");                                                                                                 
+    const std::string pathToResultYAlignment = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToYAlignmentPosition).string();
+    const std::string pathToYinFineAlignment = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToYin).string();
+    const std::string pathToYoutFineAlignment = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToYout).string();
+    const std::string pathToResultFullyOpenedBeam = (pathToCrystalAlinmentResultsDirectory_ / settings.filenameToFullyOpenedBeam).string();
     clientSensors_->flushCsv(pathToResultYAlignment);  // Erase content
     clientSensors_->flushCsv(pathToYinFineAlignment);  // Erase content
     clientSensors_->flushCsv(pathToYoutFineAlignment);  // Erase content
@@ -547,10 +502,7 @@ bool Actions::searchYAxisFineAlignment() {
             return false;
         }
     /* Execute Alignment script (Compute Fully Opened Beam) */
-    const std::string dataLogFileName = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                              clientConfiguration_->getPath(),
-                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                              "DATA_LOG_FILENAME");
+    const std::string& dataLogFileName = settings.dataLogFilename;
     clientPostProcessing_->executeScript2(pathToComputeFullyOpenedBeamScript_string,
                                           dataLogFileName,
                                           pathToResultFullyOpenedBeam);
@@ -558,82 +510,100 @@ bool Actions::searchYAxisFineAlignment() {
     float fullyOpenedBeamValue = clientSensors_->readCsvResult(pathToResultFullyOpenedBeam);
     std::string fullyOpenedBeamValue_string = std::to_string(fullyOpenedBeamValue);
     /* Go to Yin position */
-    initialPositionYAxis = initialPositionYAxis - clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                       clientConfiguration_->getPath(),
-                                                                                                       "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                       "CRYSTAL_WIDTH") / 2;
+    initialPositionYAxis = initialPositionYAxis - settings.crystalWidth / 2;
     clientHxp_->setCoordinateY(initialPositionYAxis);
     clientHxp_->setCoordinateW(initialPositionWAxis);
     this->setHxpPositionAbsolute();
     /* --- [Yin Computation] W Scans in Y0 - (Crystal W / 2) --- */
-    const float stepSizeOffeset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                       clientConfiguration_->getPath(),
-                                                                                       "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                       "STEP_SIZE_SCAN_HXP_Y");  // Step Size
-    const float stopOffset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                  clientConfiguration_->getPath(),
-                                                                                  "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                  "RANGE_SCAN_HXP_Y");  // Range
+    const float stepSizeOffeset = settings.stepSizeScan;  // Step Size
+    const float stopOffset = settings.rangeScan;  // Range
     float num_steps_yaxis = (stopOffset / stepSizeOffeset) + 1;
     std::string num_steps_yaxis_string = std::to_string(num_steps_yaxis);
-    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset) {
+    AnalysisBatch analyses;
+    int iteration = 0;  // counts the steps of both the scans, to name the copies of the data log
+    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset, iteration++) {
         nextYAxisPosition = initialPositionYAxis + i;
         clientHxp_->setCoordinateY(nextYAxisPosition);
         result_movement = this->setHxpPositionAbsolute();
         if (!result_movement && !clientScanningHXP_->checkReachingPosition(clientHxp_->getPositionY(), nextYAxisPosition)) {
             return false;
         }
+        if (this->isCancelled()) {
+            spdlog::warn("Y axis fine alignment interrupted by a stop\n");
+            return false;
+        }
         bool result_scan = clientScanningHXP_->scan();  // W Scan
         if (!result_scan) {
             return false;
         }
-        /* Execute Alignment script */
+        /* Execute Alignment script while the next step is performed */
         std::string string_actual_YCoordinate = std::to_string(clientHxp_->getCoordinateY());
-        clientPostProcessing_->executeScript6(pathToYAxisFineAlignmentScript_string,
-                                              string_actual_YCoordinate,
-                                              dataLogFileName,
-                                              pathToResultYAlignment,
-                                              pathToYinFineAlignment,
-                                              num_steps_yaxis_string,
-                                              fullyOpenedBeamValue_string);
+        const std::filesystem::path dataLogCopy = this->preserveScanDataLog(dataLogFileName, iteration);
+        analyses.add(clientPostProcessing_->executeScriptAsync(pathToYAxisFineAlignmentScript_string,
+                                                               {string_actual_YCoordinate,
+                                                                dataLogCopy.empty() ? dataLogFileName : dataLogCopy.filename().string(),
+                                                                pathToResultYAlignment,
+                                                                pathToYinFineAlignment,
+                                                                num_steps_yaxis_string,
+                                                                fullyOpenedBeamValue_string},
+                                                               pathToYinFineAlignment),
+                     nullptr,
+                     dataLogCopy);
+        if (dataLogCopy.empty()) {
+            analyses.wait();  // the next scan would overwrite the data log
+        }
         clientHxp_->setCoordinateW(initialPositionWAxis);  // return to initial position
     }
+    if (!analyses.wait()) {
+        return false;
+    }
     /* Read Yin Position */
     float yInPosition = clientSensors_->readCsvResult(pathToResultYAlignment);
     clientSensors_->flushCsv(pathToResultYAlignment);  // Erase content
     /* --- [Yout Computation] W Scans in Y0 + (Crystal W / 2) --- */
-    clientHxp_->setCoordinateY(initialPositionYAxis + clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                           clientConfiguration_->getPath(),
-                                                                                                           "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                           "CRYSTAL_WIDTH"));
+    clientHxp_->setCoordinateY(initialPositionYAxis + settings.crystalWidth);
     clientHxp_->setCoordinateW(initialPositionWAxis);
     result_movement = this->moveBothMotors();
     if (!result_movement) {
         return false;
     }
     initialPositionYAxis = clientHxp_->getCoordinateY();
-    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset) {
+    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset, iteration++) {
         nextYAxisPosition = initialPositionYAxis - i;
         clientHxp_->setCoordinateY(nextYAxisPosition);
         result_movement = this->setHxpPositionAbsolute();
         if (!result_movement && !clientScanningHXP_->checkReachingPosition(clientHxp_->getPositionY(), nextYAxisPosition)) {
             return false;
         }
+        if (this->isCancelled()) {
+            spdlog::warn("Y axis fine alignment interrupted by a stop\n");
+            return false;
+        }
         bool result_scan = clientScanningHXP_->scan();  // W Scan
         if (!result_scan) {
             return false;
         }
-        /* Execute Alignment script */
+        /* Execute Alignment script while the next step is performed */
         std::string string_actual_YCoordinate = std::to_string(clientHxp_->getCoordinateY());
-        clientPostProcessing_->executeScript6(pathToYAxisFineAlignmentScript_string,
-                                              string_actual_YCoordinate,
-                                              dataLogFileName,
-                                              pathToResultYAlignment,
-                                              pathToYoutFineAlignment,
-                                              num_steps_yaxis_string,
-                                              fullyOpenedBeamValue_string);
+        const std::filesystem::path dataLogCopy = this->preserveScanDataLog(dataLogFileName, iteration);
+        analyses.add(clientPostProcessing_->executeScriptAsync(pathToYAxisFineAlignmentScript_string,
+                                                               {string_actual_YCoordinate,
+                                                                dataLogCopy.empty() ? dataLogFileName : dataLogCopy.filename().string(),
+                                                                pathToResultYAlignment,
+                                                                pathToYoutFineAlignment,
+                                                                num_steps_yaxis_string,
+                                                                fullyOpenedBeamValue_string},
+                                                               pathToYoutFineAlignment),
+                     nullptr,
+                     dataLogCopy);
+        if (dataLogCopy.empty()) {
+            analyses.wait();  // the next scan would overwrite the data log
+        }
         clientHxp_->setCoordinateW(initialPositionWAxis);  // return to initial position
     }
+    if (!analyses.wait()) {
+        return false;
+    }
     /* Read Yout Position */
     float yOutPosition = clientSensors_->readCsvResult(pathToResultYAlignment);
     /* --- Compute new Y position and update .ini file --- */
@@ -650,11 +620,27 @@ bool Actions::searchYAxisFineAlignment() {
         return false;
     }
     /* Final movement to alignment position */
-    return this->setHxpPositionAbsolute();
+    if (!this->setHxpPositionAbsolute()) {
+        return false;
+    }
+    this->updateCachedFineYAlignment();
+    return true;
 }
 
 bool Actions::compensateAndReAlign(float compensation) {
     spdlog::info("Method compensateAndReAlign of class Actions Crystal - compensation of: {}.\n", compensation);
+    if (this->isCancelled()) {
+        spdlog::warn("Re-alignment interrupted by a stop\n");
+        return false;
+    }
+    XAxisAlignmentSettings xAxisSettings;
+    YAxisFineAlignmentSettings fineAlignmentSettings;
+    if (!alignmentSettings::load(*clientConfiguration_, xAxisSettings) ||
+        !alignmentSettings::load(*clientConfiguration_, fineAlignmentSettings)) {
+        return false;
+    }
+    alignmentCache_->erase(this->getAlignmentCacheKey());  // the alignment failed the check in flipped orientation
+    alignmentCacheState_ = AlignmentCacheState::NotVerified;
     /* Compensate */
     clientHxp_->setCoordinateY(compensation);
     this->setStepperPosition(0);
@@ -664,55 +650,25 @@ bool Actions::compensateAndReAlign(float compensation) {
     }
     /* Re-Align X Axis */
     clientScanningHXP_->hxpAxisToScan_ = 1;
-    clientScanningHXP_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                      clientConfiguration_->getPath(),
-                                                                                                      "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                      "STEP_SIZE"),
-                                                 clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                      clientConfiguration_->getPath(),
-                                                                                                      "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                      "RANGE"),
-                                                 clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                    clientConfiguration_->getPath(),
-                                                                                                    "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                    "DURATION_ACQUISITION"),
-                                                 clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                       clientConfiguration_->getPath(),
-                                                                                                       "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                       "DATA_LOG_FILENAME"),
-                                                 clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                     clientConfiguration_->getPath(),
-                                                                                                     "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                     "ERASE_CSV_CONTENT"),
-                                                  false);
-    bool result_x_alignment = this->searchXAxisAlignmentCrystal();
+    clientScanningHXP_->setupAlignmentParameters(xAxisSettings.stepSize,
+                                                 xAxisSettings.range,
+                                                 xAxisSettings.durationAcquisition,
+                                                 xAxisSettings.dataLogFilename,
+                                                 xAxisSettings.eraseCsvContent,
+                                                 false);
+    bool result_x_alignment = this->runXAxisAlignment(xAxisSettings);
     if (!result_x_alignment) {
         return false;
     }
     /* Re-Align Y Axis */
     clientScanningHXP_->hxpAxisToScan_ = 6;
     /*--- Alignment Parameters ---*/
-    clientScanningHXP_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                      clientConfiguration_->getPath(),
-                                                                                                      "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                      "STEP_SIZE"),
-                                                clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                     clientConfiguration_->getPath(),
-                                                                                                     "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                     "RANGE"),
-                                                clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                   clientConfiguration_->getPath(),
-                                                                                                   "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                   "DURATION_ACQUISITION"),
-                                                clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                      clientConfiguration_->getPath(),
-                                                                                                      "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                      "DATA_LOG_FILENAME"),
-                                                clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                    clientConfiguration_->getPath(),
-                                                                                                    "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                    "ERASE_CSV_CONTENT"),
-                                                false);
+    clientScanningHXP_->setupAlignmentParameters(fineAlignmentSettings.stepSize,
+                                                 fineAlignmentSettings.range,
+                                                 fineAlignmentSettings.durationAcquisition,
+                                                 fineAlignmentSettings.dataLogFilename,
+                                                 fineAlignmentSettings.eraseCsvContent,
+                                                 false);
     bool result_y_alignment = this->searchYAxisFineAlignment();
     if (!result_y_alignment) {
         return false;
@@ -765,241 +721,210 @@ bool Actions::checkAlignmentFlippedOrientation() {
 
 bool Actions::bendingAngleMeasurement() {
     spdlog::info("Method bendingAngleMeasurement Crystal of class Actions\n");
+    if (!bendingAngleSettings_.isValid()) {
+        spdlog::error("Settings of the bending angle measurement not loaded\n");
+        return false;
+    }
+    const double startTime = sensors::MeasurementIndex::now();
     /* Initial Movement */
     double initialPositionYAxis = clientHxp_->getCoordinateY();
-    double initialPositionWAxis = clientHxp_->getCoordinateW();
-    double nextYAxisPosition;
+    const HxpPose initialPose = this->getHxpPose();
     bool result_movement = this->moveBothMotors();
     if (!result_movement) {
         return false;
     }
-    std::filesystem::path scriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                     clientConfiguration_->getPath(),
-                                                                                                     "Bending_Angle_CRYSTAL_STAGE",
-                                                                                                     "SCRIPT_NAME");
-
-    std::filesystem::path pathToScriptName = pathToScriptMeasurementsDirectory_ / scriptName;
-    const std::string pathToBendingAngleMeasurementScript_string = pathToScriptName.string();
     /* Setup .csvs result */
-    const std::string pathToResultBendingAngle = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                 + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                         clientConfiguration_->getPath(),
-                                                                                                         "Bending_Angle_CRYSTAL_STAGE",
-                                                                                                         "FILENAME_TO_BENDING_ANGLE");
-    const std::string pathToPeaks = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                    + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                            clientConfiguration_->getPath(),
-                                                                                            "Bending_Angle_CRYSTAL_STAGE",
-                                                                                            "FILENAME_TO_PEAKS");
-    clientSensors_->flushCsv(pathToResultBendingAngle);  // Erase content
-    clientSensors_->flushCsv(pathToPeaks);               // Erase content
-    const float stepSizeOffeset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                       clientConfiguration_->getPath(),
-                                                                                       "Bending_Angle_CRYSTAL_STAGE",
-                                                                                       "STEP_SIZE_SCAN_HXP_Y");  // Step Size
-    const float stopOffset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                  clientConfiguration_->getPath(),
-                                                                                  "Bending_Angle_CRYSTAL_STAGE",
-                                                                                  "RANGE_SCAN_HXP_Y");  // Range
-    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset) {
-        nextYAxisPosition = initialPositionYAxis + i;
-        clientHxp_->setCoordinateY(nextYAxisPosition);
-        result_movement = this->setHxpPositionAbsolute();
-        if (!result_movement && !clientScanningHXP_->checkReachingPosition(clientHxp_->getPositionY(), nextYAxisPosition)) {
+    const std::string pathToResultBendingAngle = (pathToCrystalAlinmentResultsDirectory_ / bendingAngleSettings_.filenameToResult).string();
+    const std::string pathToPeaks = (pathToCrystalAlinmentResultsDirectory_ / bendingAngleSettings_.filenameToPeaks).string();
+    const float stepSizeOffeset = bendingAngleSettings_.stepSizeScan;  // Step Size
+    const float stopOffset = bendingAngleSettings_.rangeScan;  // Range
+    /* Resume the completed steps from the checkpoint or set-up the .csvs result */
+    MeasurementCheckpoint checkpoint(this->getPathToCheckpointFile(BendingAngleSettings::kSection), BendingAngleSettings::kSection);
+    MeasurementCheckpointParameters checkpointParameters;
+    checkpointParameters.startPosition = initialPositionYAxis;
+    checkpointParameters.stepSize = stepSizeOffeset;
+    checkpointParameters.range = stopOffset;
+    checkpointParameters.initialPose = initialPose;
+    if (!checkpoint.resume(checkpointParameters) || !checkpoint.restorePartialResults(pathToPeaks)) {
+        checkpoint.clear();
+        clientSensors_->flushCsv(pathToResultBendingAngle);  // Erase content
+        if (!this->createPeaksFile(pathToPeaks, {kPeakValueColumn, kYPositionColumn, kWPositionColumn})) {
             return false;
         }
+    }
+    bool result_steps = this->runMeasurementSteps(BendingAngleSettings::kSection, checkpoint, &HxpPose::CoordY, &IHXP::getPositionY,
+                                                   stepSizeOffeset, stopOffset, [&](int iteration, double position) {
         bool result_scan = clientScanningHXP_->scan();  // W Scan
         if (!result_scan) {
             return false;
         }
-        /* Execute Alignment script */
-        std::string string_actual_YCoordinate = std::to_string(clientHxp_->getCoordinateY());
-        const std::string dataLogFilename = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                  clientConfiguration_->getPath(),
-                                                                                                  "Bending_Angle_CRYSTAL_STAGE",
-                                                                                                  "DATA_LOG_FILENAME");
-        clientPostProcessing_->executeScript6(pathToBendingAngleMeasurementScript_string,
-                                              string_actual_YCoordinate,
-                                              dataLogFilename,
-                                              pathToResultBendingAngle,
-                                              pathToPeaks,
-                                              std::to_string(stopOffset),
-                                              std::to_string(crystalWidth_));
-        clientHxp_->setCoordinateW(initialPositionWAxis);  // return to initial position
+        /* Bragg peak of the rocking curve */
+        const analysis::Peak braggPeak = this->findBraggPeak();
+        if (!braggPeak.valid) {
+            return false;
+        }
+        if (!this->appendPeak(pathToPeaks, {braggPeak.value, clientHxp_->getCoordinateY(), braggPeak.centre})) {
+            return false;
+        }
+        if (!checkpoint.registerCompletedIteration(iteration, position, this->getHxpPose(), pathToPeaks)) {
+            spdlog::error("Unable to checkpoint step {} of {}. Measurement aborted.\n", iteration, BendingAngleSettings::kSection);
+            return false;  // a resume would skip or repeat steps
+        }
+        return true;
+    });
+    if (!result_steps) {
+        return false;
     }
-    /* Read Bending Angle and update .ini file */
-    float bendingAngle = clientSensors_->readCsvResult(pathToResultBendingAngle);
-    int result_BendingAngle = clientConfiguration_->writeConfigurationFile(std::to_string(bendingAngle),
-                                                                           "CRYSTAL_MEASUREMENTS",
-                                                                           "BENDING_ANGLE",
-                                                                           clientConfiguration_->getConfigFilename(),
-                                                                           clientConfiguration_->getPath());
-    if (result_BendingAngle == 0) {
+    /* Compute Bending Angle and update .ini file */
+    const analysis::AngleEstimate bendingAngle = analysis::bendingAngle(this->readPeaks(pathToPeaks, kYPositionColumn),
+                                                                        this->readPeaks(pathToPeaks, kWPositionColumn),
+                                                                        crystalWidth_,
+                                                                        bootstrapSettings_);
+    if (!this->saveAngleEstimate(bendingAngle, "BENDING_ANGLE", "Bending Angle (urad)", pathToResultBendingAngle)) {
+        this->recordMeasurement(BendingAngleSettings::kSection, startTime, bendingAngle, "", pathToPeaks, checkpointParameters);  // not completed
         return false;
     }
+    checkpoint.clear();
+    this->recordMeasurement(BendingAngleSettings::kSection, startTime, bendingAngle, pathToResultBendingAngle, pathToPeaks, checkpointParameters);
     return true;
 }
 
 bool Actions::miscutAngleMeasurement() {
     spdlog::info("Method miscutAngleMeasurement Crystal of class Actions\n");
+    if (!miscutAngleSettings_.isValid() || !bendingAngleSettings_.isValid()) {  // the peaks of the bending angle measurement are used
+        spdlog::error("Settings of the miscut angle measurement not loaded\n");
+        return false;
+    }
+    const double startTime = sensors::MeasurementIndex::now();
     /* Initial Movement */
     double initialPositionYAxis = clientHxp_->getCoordinateY();
-    double initialPositionWAxis = clientHxp_->getCoordinateW();
-    double nextYAxisPosition;
+    const HxpPose initialPose = this->getHxpPose();
     bool result_movement = this->moveBothMotors();
     if (!result_movement) {
         return false;
     }
-    std::filesystem::path scriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                     clientConfiguration_->getPath(),
-                                                                                                     "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                                     "SCRIPT_NAME");
-
-    std::filesystem::path pathToScriptName = pathToScriptMeasurementsDirectory_ / scriptName;
-    const std::string pathToMiscutAngleMeasurementScript_string = pathToScriptName.string();
     /* Setup .csvs result */
-    const std::string pathToResultMiscutAngle = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                        clientConfiguration_->getPath(),
-                                                                                                        "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                                        "FILENAME_TO_MISCUT_ANGLE");
-    const std::string pathToPeaks = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                    + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                            clientConfiguration_->getPath(),
-                                                                                            "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                            "FILENAME_TO_PEAKS");
-    clientSensors_->flushCsv(pathToResultMiscutAngle);  // Erase content
-    clientSensors_->flushCsv(pathToPeaks);               // Erase content
-    const float stepSizeOffeset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                       clientConfiguration_->getPath(),
-                                                                                       "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                       "STEP_SIZE_SCAN_HXP_Y");  // Step Size
-    const float stopOffset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                  clientConfiguration_->getPath(),
-                                                                                  "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                  "RANGE_SCAN_HXP_Y");  // Range
-    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset) {
-        nextYAxisPosition = initialPositionYAxis + i;
-        clientHxp_->setCoordinateY(nextYAxisPosition);
-        result_movement = this->setHxpPositionAbsolute();
-        if (!result_movement && !clientScanningHXP_->checkReachingPosition(clientHxp_->getPositionY(), nextYAxisPosition)) {
+    const std::string pathToResultMiscutAngle = (pathToCrystalAlinmentResultsDirectory_ / miscutAngleSettings_.filenameToResult).string();
+    const std::string pathToPeaks = (pathToCrystalAlinmentResultsDirectory_ / miscutAngleSettings_.filenameToPeaks).string();
+    const std::string pathToPeaksBending = (pathToCrystalAlinmentResultsDirectory_ / bendingAngleSettings_.filenameToPeaks).string();
+    const float stepSizeOffeset = miscutAngleSettings_.stepSizeScan;  // Step Size
+    const float stopOffset = miscutAngleSettings_.rangeScan;  // Range
+    /* Resume the completed steps from the checkpoint or set-up the .csvs result */
+    MeasurementCheckpoint checkpoint(this->getPathToCheckpointFile(MiscutAngleSettings::kSection), MiscutAngleSettings::kSection);
+    MeasurementCheckpointParameters checkpointParameters;
+    checkpointParameters.startPosition = initialPositionYAxis;
+    checkpointParameters.stepSize = stepSizeOffeset;
+    checkpointParameters.range = stopOffset;
+    checkpointParameters.initialPose = initialPose;
+    if (!checkpoint.resume(checkpointParameters) || !checkpoint.restorePartialResults(pathToPeaks)) {
+        checkpoint.clear();
+        clientSensors_->flushCsv(pathToResultMiscutAngle);  // Erase content
+        if (!this->createPeaksFile(pathToPeaks, {kPeakValueColumn, kYPositionColumn, kWPositionColumn})) {
             return false;
         }
+    }
+    bool result_steps = this->runMeasurementSteps(MiscutAngleSettings::kSection, checkpoint, &HxpPose::CoordY, &IHXP::getPositionY,
+                                                   stepSizeOffeset, stopOffset, [&](int iteration, double position) {
         bool result_scan = clientScanningHXP_->scan();  // W Scan
         if (!result_scan) {
             return false;
         }
-        /* Execute Alignment script */
-        std::string string_actual_YCoordinate = std::to_string(clientHxp_->getCoordinateY());
-        std::string dataLogPeaksFilename_bending =  pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                    + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                            clientConfiguration_->getPath(),
-                                                                                                            "Bending_Angle_CRYSTAL_STAGE",
-                                                                                                            "FILENAME_TO_PEAKS");
-        const std::string dataLogFilename = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                  clientConfiguration_->getPath(),
-                                                                                                  "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                                  "DATA_LOG_FILENAME");
-        clientPostProcessing_->executeScript7(pathToMiscutAngleMeasurementScript_string,
-                                              string_actual_YCoordinate,
-                                              dataLogFilename,
-                                              pathToResultMiscutAngle,
-                                              pathToPeaks,
-                                              std::to_string(stopOffset),
-                                              std::to_string(crystalWidth_),
-                                              dataLogPeaksFilename_bending);
-        clientHxp_->setCoordinateW(initialPositionWAxis);  // return to initial position
+        /* Bragg peak of the rocking curve */
+        const analysis::Peak braggPeak = this->findBraggPeak();
+        if (!braggPeak.valid) {
+            return false;
+        }
+        if (!this->appendPeak(pathToPeaks, {braggPeak.value, clientHxp_->getCoordinateY(), braggPeak.centre})) {
+            return false;
+        }
+        if (!checkpoint.registerCompletedIteration(iteration, position, this->getHxpPose(), pathToPeaks)) {
+            spdlog::error("Unable to checkpoint step {} of {}. Measurement aborted.\n", iteration, MiscutAngleSettings::kSection);
+            return false;  // a resume would skip or repeat steps
+        }
+        return true;
+    });
+    if (!result_steps) {
+        return false;
     }
-    /* Read Miscut Angle and update .ini file */
-    float miscutAngle = clientSensors_->readCsvResult(pathToResultMiscutAngle);
-    int result_MiscutAngle = clientConfiguration_->writeConfigurationFile(std::to_string(miscutAngle),
-                                                                           "CRYSTAL_MEASUREMENTS",
-                                                                           "MISCUT_ANGLE",
-                                                                           clientConfiguration_->getConfigFilename(),
-                                                                           clientConfiguration_->getPath());
-    if (result_MiscutAngle == 0) {
+    /* Compute Miscut Angle (peaks in 0 deg orientation from the bending angle measurement) and update .ini file */
+    const analysis::AngleEstimate miscutAngle = analysis::miscutAngle(this->readPeaks(pathToPeaksBending, kWPositionColumn),
+                                                                      this->readPeaks(pathToPeaks, kWPositionColumn),
+                                                                      bootstrapSettings_);
+    if (!this->saveAngleEstimate(miscutAngle, "MISCUT_ANGLE", "Avg Miscut Angle (urad)", pathToResultMiscutAngle)) {
+        this->recordMeasurement(MiscutAngleSettings::kSection, startTime, miscutAngle, "", pathToPeaks, checkpointParameters);  // not completed
         return false;
     }
+    checkpoint.clear();
+    this->recordMeasurement(MiscutAngleSettings::kSection, startTime, miscutAngle, pathToResultMiscutAngle, pathToPeaks, checkpointParameters);
     return true;
 }
 
 bool Actions::torsionAngleMeasurement() {
     spdlog::info("Method torsionAngleMeasurement Crystal of class Actions\n");
+    if (!torsionAngleSettings_.isValid()) {
+        spdlog::error("Settings of the torsion angle measurement not loaded\n");
+        return false;
+    }
+    const double startTime = sensors::MeasurementIndex::now();
     /* Initial Movement */
-    double initialPositionYAxis = clientHxp_->getCoordinateY();
     double initialPositionZAxis = clientHxp_->getCoordinateZ();
-    double initialPositionWAxis = clientHxp_->getCoordinateW();
-    double nextZAxisPosition;
+    const HxpPose initialPose = this->getHxpPose();
     bool result_movement = this->moveBothMotors();
     if (!result_movement) {
         return false;
     }
-    std::filesystem::path scriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                     clientConfiguration_->getPath(),
-                                                                                                     "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                                     "SCRIPT_NAME");
-
-    std::filesystem::path pathToScriptName = pathToScriptMeasurementsDirectory_ / scriptName;
-    const std::string pathToTorsionAngleMeasurementScript_string = pathToScriptName.string();
     /* Setup .csvs result */
-    const std::string pathToResultTorsionAngle = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                                 + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                         clientConfiguration_->getPath(),
-                                                                                                         "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                                         "FILENAME_TO_TORSION_ANGLE");
-    const std::string pathToPeaks = pathToCrystalAlinmentResultsDirectory_ + "\\"
-                                    + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                            clientConfiguration_->getPath(),
-                                                                                            "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                            "FILENAME_TO_PEAKS");
-    clientSensors_->flushCsv(pathToResultTorsionAngle);  // Erase content
-    clientSensors_->flushCsv(pathToPeaks);               // Erase content
-    const float stepSizeOffeset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                       clientConfiguration_->getPath(),
-                                                                                       "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                       "STEP_SIZE_SCAN_HXP_Z");  // Step Size
-    const float stopOffset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                  clientConfiguration_->getPath(),
-                                                                                  "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                  "RANGE_SCAN_HXP_Z");  // Range
-    for (double i = 0; i <= stopOffset; i = i + stepSizeOffeset) {
-        nextZAxisPosition = initialPositionZAxis + i;
-        clientHxp_->setCoordinateZ(nextZAxisPosition);
-        result_movement = this->setHxpPositionAbsolute();
-        if (!result_movement && !clientScanningHXP_->checkReachingPosition(clientHxp_->getPositionZ(), nextZAxisPosition)) {
+    const std::string pathToResultTorsionAngle = (pathToCrystalAlinmentResultsDirectory_ / torsionAngleSettings_.filenameToResult).string();
+    const std::string pathToPeaks = (pathToCrystalAlinmentResultsDirectory_ / torsionAngleSettings_.filenameToPeaks).string();
+    const float stepSizeOffeset = torsionAngleSettings_.stepSizeScan;  // Step Size
+    const float stopOffset = torsionAngleSettings_.rangeScan;  // Range
+    /* Resume the completed steps from the checkpoint or set-up the .csvs result */
+    MeasurementCheckpoint checkpoint(this->getPathToCheckpointFile(TorsionAngleSettings::kSection), TorsionAngleSettings::kSection);
+    MeasurementCheckpointParameters checkpointParameters;
+    checkpointParameters.startPosition = initialPositionZAxis;
+    checkpointParameters.stepSize = stepSizeOffeset;
+    checkpointParameters.range = stopOffset;
+    checkpointParameters.initialPose = initialPose;
+    if (!checkpoint.resume(checkpointParameters) || !checkpoint.restorePartialResults(pathToPeaks)) {
+        checkpoint.clear();
+        clientSensors_->flushCsv(pathToResultTorsionAngle);  // Erase content
+        if (!this->createPeaksFile(pathToPeaks, {kPeakValueColumn, kYPositionColumn, kZPositionColumn, kWPositionColumn})) {
             return false;
         }
+    }
+    bool result_steps = this->runMeasurementSteps(TorsionAngleSettings::kSection, checkpoint, &HxpPose::CoordZ, &IHXP::getPositionZ,
+                                                   stepSizeOffeset, stopOffset, [&](int iteration, double position) {
         bool result_scan = clientScanningHXP_->scan();  // W Scan
         if (!result_scan) {
             return false;
         }
-        /* Execute Alignment script */
-        std::string string_actual_ZCoordinate = std::to_string(clientHxp_->getCoordinateZ());
-        std::string string_actual_YCoordinate = std::to_string(clientHxp_->getCoordinateY());
-        const std::string dataLogFilename = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                  clientConfiguration_->getPath(),
-                                                                                                  "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                                  "DATA_LOG_FILENAME");
-        clientPostProcessing_->executeScript7(pathToTorsionAngleMeasurementScript_string,
-                                              string_actual_ZCoordinate,
-                                              dataLogFilename,
-                                              pathToResultTorsionAngle,
-                                              pathToPeaks,
-                                              std::to_string(stopOffset),
-                                              std::to_string(crystalWidth_),
-                                              string_actual_YCoordinate);
-        clientHxp_->setCoordinateW(initialPositionWAxis);  // return to initial position
+        /* Bragg peak of the rocking curve */
+        const analysis::Peak braggPeak = this->findBraggPeak();
+        if (!braggPeak.valid) {
+            return false;
+        }
+        if (!this->appendPeak(pathToPeaks, {braggPeak.value, clientHxp_->getCoordinateY(), clientHxp_->getCoordinateZ(), braggPeak.centre})) {
+            return false;
+        }
+        if (!checkpoint.registerCompletedIteration(iteration, position, this->getHxpPose(), pathToPeaks)) {
+            spdlog::error("Unable to checkpoint step {} of {}. Measurement aborted.\n", iteration, TorsionAngleSettings::kSection);
+            return false;  // a resume would skip or repeat steps
+        }
+        return true;
+    });
+    if (!result_steps) {
+        return false;
     }
-    /* Read Torsion Angle and update .ini file */
-    float torsionAngle = clientSensors_->readCsvResult(pathToResultTorsionAngle);
-    int result_TorsionAngle = clientConfiguration_->writeConfigurationFile(std::to_string(torsionAngle),
-                                                                           "CRYSTAL_MEASUREMENTS",
-                                                                           "TORSION_ANGLE",
-                                                                           clientConfiguration_->getConfigFilename(),
-                                                                           clientConfiguration_->getPath());
-    if (result_TorsionAngle == 0) {
+    /* Compute Torsion Angle and update .ini file */
+    const analysis::AngleEstimate torsionAngle = analysis::torsionAngle(this->readPeaks(pathToPeaks, kZPositionColumn),
+                                                                        this->readPeaks(pathToPeaks, kWPositionColumn),
+                                                                        bootstrapSettings_);
+    if (!this->saveAngleEstimate(torsionAngle, "TORSION_ANGLE", "Torsion Angle (urad)", pathToResultTorsionAngle)) {
+        this->recordMeasurement(TorsionAngleSettings::kSection, startTime, torsionAngle, "", pathToPeaks, checkpointParameters);  // not completed
         return false;
     }
+    checkpoint.clear();
+    this->recordMeasurement(TorsionAngleSettings::kSection, startTime, torsionAngle, pathToResultTorsionAngle, pathToPeaks, checkpointParameters);
     return true;
 }
 
@@ -1018,10 +943,379 @@ bool Actions::stop() {
     }
 }
 
+void Actions::setCancellationCheck(std::function<bool()> isCancelled) {
+    isCancelled_ = std::move(isCancelled);
+}
+
+bool Actions::isCancelled() const {
+    return isCancelled_ && isCancelled_();
+}
+
 bool Actions::startScanHxp() {
     return clientScanningHXP_->scan();
 }
 
+HxpPose Actions::getHxpPose() {
+    HxpPose pose;
+    pose.CoordX = clientHxp_->getCoordinateX();
+    pose.CoordY = clientHxp_->getCoordinateY();
+    pose.CoordZ = clientHxp_->getCoordinateZ();
+    pose.CoordU = clientHxp_->getCoordinateU();
+    pose.CoordV = clientHxp_->getCoordinateV();
+    pose.CoordW = clientHxp_->getCoordinateW();
+    return pose;
+}
+
+std::filesystem::path Actions::getPathToCheckpointFile(const std::string& measurementName) {
+    return pathToCrystalAlinmentResultsDirectory_ / (measurementName + "_checkpoint.ini");
+}
+
+bool Actions::runMeasurementSteps(const char* measurementName,
+                                  const MeasurementCheckpoint& checkpoint,
+                                  double HxpPose::*axis,
+                                  double (IHXP::*getPosition)(),
+                                  float stepSize,
+                                  float range,
+                                  const std::function<bool(int iteration, double position)>& step) {
+    /* Rocking curves about the impact point of the beam, if configured */
+    PivotPointSettings pivotSettings;
+    PivotPoint pivotPoint(clientHxp_);
+    if (alignmentSettings::load(*clientConfiguration_, pivotSettings) && pivotSettings.enabled &&
+        !pivotPoint.activate(pivotSettings)) {
+        return false;
+    }
+    const HxpPose initialPose = this->getHxpPose();
+    std::vector<HxpPose> poses;
+    std::vector<int> iterations;
+    int iteration = 0;
+    for (double i = 0; i <= range; i = i + stepSize, iteration++) {
+        if (checkpoint.isIterationCompleted(iteration)) {
+            spdlog::info("Step {} of {} already completed. Skipped.\n", iteration, measurementName);
+            continue;
+        }
+        HxpPose pose = initialPose;  // the W axis returns to its initial position after every scan
+        pose.*axis = initialPose.*axis + i;
+        poses.push_back(pose);
+        iterations.push_back(iteration);
+    }
+    HexapodMotionSettings motionSettings;
+    alignmentSettings::load(*clientConfiguration_, motionSettings);  // the kinematic model only times the movements
+    HexapodMotionPlanner planner(clientHxp_, motionSettings);
+    bool result = planner.visit(poses, [&](size_t index, bool moved) {
+        if (this->isCancelled()) {
+            spdlog::warn("{} interrupted by a stop before step {}\n", measurementName, iterations[index]);
+            return false;  // the completed steps are kept in the checkpoint
+        }
+        const double position = poses[index].*axis;
+        if (!moved && !clientScanningHXP_->checkReachingPosition((clientHxp_.get()->*getPosition)(), position)) {
+            return false;
+        }
+        return step(iterations[index], position);
+    });
+    bool result_release = pivotPoint.release();
+    clientHxp_->setCoordinateW(initialPose.CoordW);  // return to initial position
+    return result && result_release;
+}
+
+std::string Actions::getAlignmentCacheKey() {
+    std::string crystalId;
+    std::string mountId;
+    if (clientConfiguration_->hasKey("CRYSTAL_MEASUREMENTS",
+                                     "CRYSTAL_ID",
+                                     clientConfiguration_->getConfigFilename(),
+                                     clientConfiguration_->getPath()) == 1) {
+        crystalId = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                          clientConfiguration_->getPath(),
+                                                                          "CRYSTAL_MEASUREMENTS",
+                                                                          "CRYSTAL_ID");
+    }
+    if (clientConfiguration_->hasKey("CRYSTAL_MEASUREMENTS",
+                                     "MOUNT_ID",
+                                     clientConfiguration_->getConfigFilename(),
+                                     clientConfiguration_->getPath()) == 1) {
+        mountId = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                        clientConfiguration_->getPath(),
+                                                                        "CRYSTAL_MEASUREMENTS",
+                                                                        "MOUNT_ID");
+    }
+    return AlignmentCache::makeKey(crystalId, mountId);
+}
+
+bool Actions::findCachedAlignment(AlignmentCacheSettings& settings, AlignmentCacheEntry& entry) {
+    const std::string key = this->getAlignmentCacheKey();
+    if (key.empty()) {
+        return false;  // crystal not identified
+    }
+    if (key != alignmentCacheKey_) {
+        alignmentCacheKey_ = key;
+        alignmentCacheState_ = AlignmentCacheState::NotVerified;
+    }
+    if (!alignmentSettings::load(*clientConfiguration_, settings) || !settings.enabled) {
+        return false;
+    }
+    return alignmentCache_->find(key, sensors::MeasurementIndex::now(), settings.maxAge * 3600.0, entry);
+}
+
+bool Actions::reuseCachedAlignment(const std::string& alignmentName, bool fineYAlignment) {
+    AlignmentCacheSettings settings;
+    AlignmentCacheEntry entry;
+    if (!this->findCachedAlignment(settings, entry) || (fineYAlignment && !entry.fineYAlignment)) {
+        return false;
+    }
+    if (std::fabs(stepperPosition_ - entry.stepperPosition) > kStepperPositionTolerance) {
+        return false;  // e.g. alignment in flipped orientation
+    }
+    if (alignmentCacheState_ == AlignmentCacheState::NotVerified) {
+        alignmentCacheState_ = this->verifyCachedAlignment(entry, settings) ? AlignmentCacheState::Confirmed
+                                                                            : AlignmentCacheState::Rejected;
+    }
+    if (alignmentCacheState_ != AlignmentCacheState::Confirmed) {
+        return false;
+    }
+    spdlog::info("{}: cached alignment of {} reused\n", alignmentName, alignmentCacheKey_);
+    ConfigurationTransaction alignmentPositions(clientConfiguration_, clientConfiguration_->getConfigFilename(), clientConfiguration_->getPath());
+    alignmentPositions.set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_X", static_cast<float>(entry.pose.CoordX))
+                      .set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_Y", static_cast<float>(entry.pose.CoordY))
+                      .set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_Z", static_cast<float>(entry.pose.CoordZ))
+                      .set("CRYSTAL_HXP", "ALIGNMENT_POSITION_HXP_W", static_cast<float>(entry.pose.CoordW));
+    if (alignmentPositions.commit() == 0) {
+        return false;
+    }
+    hxpAlignmentCoord_.CoordX = entry.pose.CoordX;
+    hxpAlignmentCoord_.CoordY = entry.pose.CoordY;
+    hxpAlignmentCoord_.CoordZ = entry.pose.CoordZ;
+    hxpAlignmentCoord_.CoordW = entry.pose.CoordW;
+    clientHxp_->setHxpCoordinates(entry.pose.CoordX, entry.pose.CoordY, entry.pose.CoordZ,
+                                  entry.pose.CoordU, entry.pose.CoordV, entry.pose.CoordW);
+    return this->moveBothMotors();
+}
+
+bool Actions::verifyCachedAlignment(const AlignmentCacheEntry& entry, const AlignmentCacheSettings& settings) {
+    spdlog::info("Method verifyCachedAlignment Crystal of class Actions\n");
+    /* Setup of the requested alignment */
+    const HxpPose requestedPose = this->getHxpPose();
+    const int requestedAxis = clientScanningHXP_->hxpAxisToScan_;
+    const float requestedStepSize = clientScanningHXP_->getStepSize();
+    const float requestedRange = clientScanningHXP_->getRange();
+    const int requestedDurationAcquisition = clientScanningHXP_->getDurationAcquisition();
+    const std::string requestedFilename = clientScanningHXP_->getFilename();
+    const bool requestedEraseCsvContent = clientScanningHXP_->getEraseCsvContent();
+    const bool requestedShowPlot = clientScanningHXP_->getShowPlot();
+    /* W Scan centred on the cached Bragg angle */
+    clientHxp_->setHxpCoordinates(entry.pose.CoordX, entry.pose.CoordY, entry.pose.CoordZ,
+                                  entry.pose.CoordU, entry.pose.CoordV, entry.pose.CoordW - settings.range / 2);
+    clientScanningHXP_->hxpAxisToScan_ = 6;
+    clientScanningHXP_->setupAlignmentParameters(settings.stepSize,
+                                                 settings.range,
+                                                 settings.durationAcquisition,
+                                                 settings.dataLogFilename,
+                                                 true,
+                                                 false);
+    const bool confirmed = this->moveBothMotors() &&
+                           clientScanningHXP_->scan() &&
+                           AlignmentCache::isConfirmed(entry, this->findBraggPeak(), settings.durationAcquisition, settings);
+    /* Restore the requested alignment */
+    clientHxp_->setHxpCoordinates(requestedPose.CoordX, requestedPose.CoordY, requestedPose.CoordZ,
+                                  requestedPose.CoordU, requestedPose.CoordV, requestedPose.CoordW);
+    clientScanningHXP_->hxpAxisToScan_ = requestedAxis;
+    clientScanningHXP_->setupAlignmentParameters(requestedStepSize,
+                                                 requestedRange,
+                                                 requestedDurationAcquisition,
+                                                 requestedFilename,
+                                                 requestedEraseCsvContent,
+                                                 requestedShowPlot);
+    if (!confirmed) {
+        spdlog::warn("Cached alignment of {} not confirmed. Executing the full alignment.\n", alignmentCacheKey_);
+    }
+    return confirmed;
+}
+
+void Actions::storeCachedAlignment() {
+    AlignmentCacheSettings settings;
+    const std::string key = this->getAlignmentCacheKey();
+    if (key.empty() || !alignmentSettings::load(*clientConfiguration_, settings) || !settings.enabled) {
+        return;
+    }
+    const analysis::Peak braggPeak = this->findBraggPeak();
+    const int durationAcquisition = clientScanningHXP_->getDurationAcquisition();
+    if (!braggPeak.valid || durationAcquisition <= 0) {
+        spdlog::warn("Alignment of {} not cached: Bragg peak not found\n", key);
+        return;
+    }
+    AlignmentCacheEntry entry;
+    entry.pose = this->getHxpPose();
+    entry.stepperPosition = stepperPosition_;
+    entry.braggPeakRate = braggPeak.value / durationAcquisition;
+    entry.timestamp = sensors::MeasurementIndex::now();
+    if (alignmentCache_->store(key, entry)) {
+        spdlog::info("Alignment of {} cached\n", key);
+    }
+    alignmentCacheKey_ = key;
+    alignmentCacheState_ = AlignmentCacheState::NotVerified;  // the next sequence verifies the new alignment
+}
+
+void Actions::updateCachedFineYAlignment() {
+    AlignmentCacheSettings settings;
+    AlignmentCacheEntry entry;
+    if (!this->findCachedAlignment(settings, entry) ||
+        std::fabs(stepperPosition_ - entry.stepperPosition) > kStepperPositionTolerance) {
+        return;  // the alignment in flipped orientation is not cached
+    }
+    entry.pose.CoordY = clientHxp_->getCoordinateY();
+    entry.fineYAlignment = true;
+    entry.timestamp = sensors::MeasurementIndex::now();
+    alignmentCache_->store(alignmentCacheKey_, entry);
+}
+
+std::filesystem::path Actions::preserveScanDataLog(const std::string& dataLogFilename, int iteration) {
+    const std::filesystem::path pathToDataLog = projectPaths_.getScanDirectory() / dataLogFilename;
+    const std::filesystem::path pathToCopy = projectPaths_.getScanDirectory() / (pathToDataLog.stem().string() + "_" +
+                                                                                std::to_string(iteration) +
+                                                                                pathToDataLog.extension().string());
+    std::error_code errorCode;
+    std::filesystem::copy_file(pathToDataLog, pathToCopy, std::filesystem::copy_options::overwrite_existing, errorCode);
+    if (errorCode) {
+        spdlog::warn("Data log {} not copied: {}\n", pathToDataLog.string(), errorCode.message());
+        return {};
+    }
+    return pathToCopy;
+}
+
+void Actions::recordMeasurement(const std::string& measurementName,
+                                double startTime,
+                                const analysis::AngleEstimate& result,
+                                const std::string& pathToResult,
+                                const std::string& pathToPeaks,
+                                const MeasurementCheckpointParameters& parameters) {
+    sensors::MeasurementRecord record;
+    record.startTime = startTime;
+    record.type = measurementName;
+    record.name = measurementName;
+    record.completed = !pathToResult.empty();
+    if (result.valid) {
+        record.result = std::to_string(result.value);
+        record.uncertainty = std::to_string(result.sigma);
+    }
+    /* The result and the peaks are overwritten by the next measurement: the index refers to their archived copies */
+    const double archiveTime = sensors::MeasurementIndex::now();
+    if (record.completed) {
+        record.resultPath = sensors::MeasurementIndex::archive(pathToResult, archiveTime).string();
+    }
+    const std::filesystem::path archivedPeaks = sensors::MeasurementIndex::archive(pathToPeaks, archiveTime);
+    record.parameters = "START_POSITION=" + std::to_string(parameters.startPosition) +
+                        ";STEP_SIZE=" + std::to_string(parameters.stepSize) +
+                        ";RANGE=" + std::to_string(parameters.range) +
+                        ";CONFIG_VERSION=" + std::to_string(configurationVersion_) +
+                        ";PEAKS=" + archivedPeaks.string();
+    clientSensors_->recordMeasurement(record);
+}
+
+analysis::Peak Actions::findBraggPeak() {
+    const std::vector<scanning::ScanPoint> scanPoints = clientScanningHXP_->getLastScanPoints();
+    std::vector<double> positionsWAxis;
+    std::vector<double> counts;
+    positionsWAxis.reserve(scanPoints.size());
+    counts.reserve(scanPoints.size());
+    for (const scanning::ScanPoint& scanPoint : scanPoints) {
+        positionsWAxis.push_back(scanPoint.positionsHxp[5]);
+        counts.push_back(scanPoint.counts);
+    }
+    const analysis::Peak braggPeak = analysis::analyseRockingCurve(positionsWAxis, counts);
+    if (!braggPeak.valid) {
+        spdlog::error("Bragg peak not found in the last scan ({} points)\n", scanPoints.size());
+    }
+    return braggPeak;
+}
+
+bool Actions::createPeaksFile(const std::string& pathToPeaks, const std::vector<std::string>& columnNames) {
+    std::error_code errorCode;
+    std::filesystem::create_directories(std::filesystem::path(pathToPeaks).parent_path(), errorCode);
+    std::ofstream peaksFile(pathToPeaks, std::ios::out | std::ios::trunc);
+    if (!peaksFile.is_open()) {
+        spdlog::error("Unable to create the Bragg peaks file {}\n", pathToPeaks);
+        return false;
+    }
+    for (size_t index = 0; index < columnNames.size(); index++) {
+        peaksFile << (index == 0 ? "" : ",") << columnNames[index];
+    }
+    peaksFile << "\n";
+    return true;
+}
+
+bool Actions::appendPeak(const std::string& pathToPeaks, const std::vector<double>& values) {
+    std::ofstream peaksFile(pathToPeaks, std::ios::out | std::ios::app);
+    if (!peaksFile.is_open()) {
+        spdlog::error("Unable to write the Bragg peak in {}\n", pathToPeaks);
+        return false;
+    }
+    peaksFile << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (size_t index = 0; index < values.size(); index++) {
+        peaksFile << (index == 0 ? "" : ",") << values[index];
+    }
+    peaksFile << "\n";
+    return true;
+}
+
+std::vector<double> Actions::readPeaks(const std::string& pathToPeaks, const std::string& columnName) {
+    std::vector<double> values;
+    std::ifstream peaksFile(pathToPeaks);
+    std::string line;
+    if (!std::getline(peaksFile, line)) {
+        spdlog::error("Bragg peaks file {} is empty\n", pathToPeaks);
+        return values;
+    }
+    auto split = [](const std::string& row) {
+        std::vector<std::string> fields;
+        std::stringstream stream(row);
+        std::string field;
+        while (std::getline(stream, field, ',')) {
+            fields.push_back(field);
+        }
+        return fields;
+    };
+    const std::vector<std::string> header = split(line);
+    const size_t column = std::find(header.begin(), header.end(), columnName) - header.begin();
+    if (column == header.size()) {
+        spdlog::error("Column '{}' not found in {}\n", columnName, pathToPeaks);
+        return values;
+    }
+    while (std::getline(peaksFile, line)) {
+        const std::vector<std::string> fields = split(line);
+        if (column >= fields.size()) {
+            continue;
+        }
+        try {
+            values.push_back(std::stod(fields[column]));
+        } catch (const std::exception&) {
+            spdlog::warn("Invalid Bragg peak '{}' in {}\n", line, pathToPeaks);
+        }
+    }
+    return values;
+}
+
+bool Actions::saveAngleEstimate(const analysis::AngleEstimate& angle,
+                                const std::string& keyName,
+                                const std::string& columnName,
+                                const std::string& pathToResult) {
+    if (!angle.valid) {
+        spdlog::error("{} not estimated from {} Bragg peaks. Configuration file not updated.\n", keyName, angle.points);
+        return false;
+    }
+    spdlog::info("{}: {} +/- {} ({} Bragg peaks)\n", keyName, angle.value, angle.sigma, angle.points);
+    std::ofstream resultFile(pathToResult, std::ios::out | std::ios::trunc);
+    if (!resultFile.is_open()) {
+        spdlog::error("Unable to write the result in {}\n", pathToResult);
+        return false;
+    }
+    resultFile << std::setprecision(std::numeric_limits<double>::max_digits10);
+    resultFile << columnName << ",Uncertainty (urad)\n" << angle.value << "," << angle.sigma << "\n";
+    resultFile.close();
+    ConfigurationTransaction measurement(clientConfiguration_, clientConfiguration_->getConfigFilename(), clientConfiguration_->getPath());
+    measurement.set("CRYSTAL_MEASUREMENTS", keyName, static_cast<float>(angle.value))
+               .set("CRYSTAL_MEASUREMENTS", keyName + "_UNCERTAINTY", static_cast<float>(angle.sigma));
+    return measurement.commit() != 0;  // value and uncertainty or none
+}
+
 float Actions::getStepperPosition() {
     return clientStepper_->getPositionUserUnits();
 }
@@ -1030,4 +1324,24 @@ void Actions::setStepperPosition(float stepperPosition) {
     stepperPosition_ = stepperPosition;
 }
 
+void Actions::setBendingAngleSettings(const BendingAngleSettings& settings) {
+    bendingAngleSettings_ = settings;
+}
+
+void Actions::setMiscutAngleSettings(const MiscutAngleSettings& settings) {
+    miscutAngleSettings_ = settings;
+}
+
+void Actions::setTorsionAngleSettings(const TorsionAngleSettings& settings) {
+    torsionAngleSettings_ = settings;
+}
+
+void Actions::setConfigurationVersion(uint64_t configurationVersion) {
+    configurationVersion_ = configurationVersion;
+}
+
+uint64_t Actions::getConfigurationVersion() {
+    return configurationVersion_;
+}
+
 }  // namespace crystal
@@ -0,0 +1,135 @@
+/**
+ * @file Crystal/AlignmentCache.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class used to store the alignment positions of the mounted crystals, so that a crystal aligned recently can skip the full alignment.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "Crystal/AlignmentCache.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace crystal {
+
+namespace {
+
+void writePose(mINI::INIMap<std::string>& section, const HxpPose& pose) {
+    section["HXP_X"] = std::to_string(pose.CoordX);
+    section["HXP_Y"] = std::to_string(pose.CoordY);
+    section["HXP_Z"] = std::to_string(pose.CoordZ);
+    section["HXP_U"] = std::to_string(pose.CoordU);
+    section["HXP_V"] = std::to_string(pose.CoordV);
+    section["HXP_W"] = std::to_string(pose.CoordW);
+}
+
+HxpPose readPose(mINI::INIMap<std::string>& section) {
+    HxpPose pose;
+    pose.CoordX = std::stod(section["HXP_X"]);
+    pose.CoordY = std::stod(section["HXP_Y"]);
+    pose.CoordZ = std::stod(section["HXP_Z"]);
+    pose.CoordU = std::stod(section["HXP_U"]);
+    pose.CoordV = std::stod(section["HXP_V"]);
+    pose.CoordW = std::stod(section["HXP_W"]);
+    return pose;
+}
+
+}  // namespace
+
+AlignmentCache::AlignmentCache(std::filesystem::path pathToCacheFile):
+                               pathToCacheFile_(pathToCacheFile) {
+    spdlog::info("cTor AlignmentCache\n");
+}
+
+AlignmentCache::~AlignmentCache() {
+    spdlog::info("dTor AlignmentCache\n");
+}
+
+std::string AlignmentCache::makeKey(const std::string& crystalId, const std::string& mountId) {
+    if (crystalId.empty() || crystalId == "UNDEFINED") {
+        return "";
+    }
+    std::string key = crystalId + "_MOUNT_" + (mountId.empty() ? "0" : mountId);
+    std::replace_if(key.begin(), key.end(), [](unsigned char c) { return !std::isalnum(c) && c != '_' && c != '-'; }, '_');
+    return key;  // section of the cache file
+}
+
+bool AlignmentCache::find(const std::string& key, double now, double maxAge, AlignmentCacheEntry& entry) const {
+    mINI::INIStructure ini;
+    if (key.empty() || !this->read(ini) || !ini.has(key)) {
+        return false;
+    }
+    AlignmentCacheEntry storedEntry;
+    try {
+        storedEntry.pose = readPose(ini[key]);
+        storedEntry.stepperPosition = std::stof(ini[key]["STEPPER_POSITION"]);
+        storedEntry.braggPeakRate = std::stod(ini[key]["BRAGG_PEAK_RATE"]);
+        storedEntry.fineYAlignment = ini[key]["FINE_Y_ALIGNMENT"] == "1";
+        storedEntry.timestamp = std::stod(ini[key]["TIMESTAMP"]);
+    } catch (const std::exception& e) {
+        spdlog::error("Corrupted entry {} of the alignment cache {} ({})\n", key, pathToCacheFile_.string(), e.what());
+        return false;
+    }
+    if (now - storedEntry.timestamp > maxAge) {
+        spdlog::info("Cached alignment of {} expired ({:.1f} h old)\n", key, (now - storedEntry.timestamp) / 3600);
+        return false;
+    }
+    entry = storedEntry;
+    return true;
+}
+
+bool AlignmentCache::store(const std::string& key, const AlignmentCacheEntry& entry) const {
+    if (key.empty()) {
+        return false;
+    }
+    mINI::INIStructure ini;
+    this->read(ini);  // the entries of the other crystals are kept
+    ini[key].clear();
+    writePose(ini[key], entry.pose);
+    ini[key]["STEPPER_POSITION"] = std::to_string(entry.stepperPosition);
+    ini[key]["BRAGG_PEAK_RATE"] = std::to_string(entry.braggPeakRate);
+    ini[key]["FINE_Y_ALIGNMENT"] = entry.fineYAlignment ? "1" : "0";
+    ini[key]["TIMESTAMP"] = std::to_string(entry.timestamp);
+    mINI::INIFile file(pathToCacheFile_.string());
+    bool generateSuccess = file.generate(ini, true);
+    if (!generateSuccess) {
+        spdlog::error("Unable to save the alignment cache {}\n", pathToCacheFile_.string());
+    }
+    return generateSuccess;
+}
+
+bool AlignmentCache::erase(const std::string& key) const {
+    mINI::INIStructure ini;
+    if (key.empty() || !this->read(ini) || !ini.has(key)) {
+        return true;
+    }
+    ini.remove(key);
+    mINI::INIFile file(pathToCacheFile_.string());
+    return file.generate(ini, true);
+}
+
+bool AlignmentCache::isConfirmed(const AlignmentCacheEntry& entry,
+                                 const analysis::Peak& peak,
+                                 int durationAcquisition,
+                                 const AlignmentCacheSettings& settings) {
+    if (!peak.valid || durationAcquisition <= 0) {
+        return false;
+    }
+    const double shift = peak.centre - entry.pose.CoordW;
+    const double ratio = entry.braggPeakRate > 0 ? (peak.value / durationAcquisition) / entry.braggPeakRate : 0;
+    spdlog::info("Verification of the cached alignment: Bragg peak shifted by {} deg, {:.2f} of the cached value\n", shift, ratio);
+    return std::fabs(shift) <= settings.toleranceHxpW && ratio >= settings.minPeakRatio;
+}
+
+bool AlignmentCache::read(mINI::INIStructure& ini) const {
+    mINI::INIFile file(pathToCacheFile_.string());
+    return std::filesystem::exists(pathToCacheFile_) && file.read(ini);
+}
+
+}  // namespace crystal
@@ -10,12 +10,19 @@
  * 
  */
 
+#include <iterator>
 #include <string>
 
 #include "CrystalDeviceController.hpp"
 
 namespace crystal {
 
+namespace {
+
+const char* const kCrystalStatusNames[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
+
+}  // namespace
+
 CrystalDeviceController::CrystalDeviceController(std::filesystem::path logFilePath,
                                                  std::shared_ptr<IHXP> clientHXP,
                                                  std::shared_ptr<IMotor> clientStepper,
@@ -37,8 +44,16 @@ CrystalDeviceController::CrystalDeviceController(std::filesystem::path logFilePa
     clientHxp_(clientHXP),
     clientStepper_(clientStepper),
     clientConfiguration_(clientConfiguration),
-    sMachine_(System(actionsPtr_)) {
+    sMachine_(System(actionsPtr_)),
+    stateMonitor_(kCrystalStatusNames, std::size(kCrystalStatusNames), static_cast<int>(CrystalStatus::NotInitialized)),
+    commandQueue_("Crystal") {
     spdlog::info("cTor CrystalDeviceController\n");
+    commandQueue_.setObserver([this](const std::string& name, bool running) {
+        stateMonitor_.setAction(running ? name : "");  // the command is published with the state
+    });
+    actionsPtr_->setCancellationCheck([this] {
+        return commandQueue_.isCancelled();  // the multi-step actions end before their next step when stopped
+    });
 }
 
 
@@ -47,9 +62,23 @@ CrystalDeviceController::~CrystalDeviceController() {
 }
 
 bool CrystalDeviceController::start() {
+    return commandQueue_.run("start", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
+            this->processEvent(eventInitialize{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
+}
+
+bool CrystalDeviceController::stopMovement(bool interrupted) {
     using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
-        sMachine_.process_event(eventInitialize{});
+    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) ||
+        (interrupted && sMachine_.is(state<systemError>))) {  // the interrupted action has failed
+        this->processEvent(eventStopMovement{});
     }
     if (!sMachine_.is(state<systemConnected>)) {
         return false;
@@ -58,37 +87,47 @@ bool CrystalDeviceController::start() {
 }
 
 bool CrystalDeviceController::stop() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventStopMovement{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
+    if (commandQueue_.isWorkerThread()) {
+        return this->stopMovement(false);
     }
-    return true;
+    return this->submitStop()->wait();
+}
+
+std::shared_ptr<DeviceCommand> CrystalDeviceController::submitCommand(const std::string& name, std::function<bool()> command) {
+    return commandQueue_.submit(name, [command](DeviceCommand&) { return command(); });
+}
+
+std::shared_ptr<DeviceCommand> CrystalDeviceController::submitStop() {
+    return commandQueue_.preempt("stop",
+                                 [this](DeviceCommand& command) { return this->stopMovement(command.hasInterrupted()); },
+                                 [this] { actionsPtr_->stop(); });  // ends the scan running on the worker thread
 }
 
 bool CrystalDeviceController::disconnect() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventDisconnect{});
-    }
-    if (!sMachine_.is(state<systemNotInitialized>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("disconnect", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventDisconnect{});
+        }
+        if (!sMachine_.is(state<systemNotInitialized>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::goHome() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemHome>)) {
-        sMachine_.process_event(eventSetupHome{});
-        sMachine_.process_event(eventSetupHome{});
-    }
-    if (!sMachine_.is(state<systemHome>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("goHome", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemHome>)) {
+            this->processEvent(eventSetupHome{});
+            this->processEvent(eventSetupHome{});
+        }
+        if (!sMachine_.is(state<systemHome>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 float CrystalDeviceController::getPositionStepper() {
@@ -119,806 +158,785 @@ double CrystalDeviceController::getPositionW() {
     return clientHxp_->getCoordinateW();
 }
 
+uint64_t CrystalDeviceController::getConfigurationVersion() {
+    return actionsPtr_->getConfigurationVersion();
+}
+
 bool CrystalDeviceController::moveToAbsPosition(double CoordX, double CoordY, double CoordZ, double CoordU, double CoordV, double CoordW) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        clientHxp_->setHxpCoordinates(CoordX, CoordY, CoordZ, CoordU, CoordV, CoordW);
-        sMachine_.process_event(eventMoveHxpToAbsolutePosition{});
-        sMachine_.process_event(eventMoveHxpToAbsolutePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("moveToAbsPosition", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            clientHxp_->setHxpCoordinates(CoordX, CoordY, CoordZ, CoordU, CoordV, CoordW);
+            this->processEvent(eventMoveHxpToAbsolutePosition{});
+            this->processEvent(eventMoveHxpToAbsolutePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::scanHxp(int axis, float stepSize, float range, int durationAcquisition, std::string filename, bool eraseCsvContent, bool showPlot) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        clientScanningHxp_->hxpAxisToScan_ = axis;
-        clientScanningHxp_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
-        sMachine_.process_event(eventStartScanHxp{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventStartScanHxp{});  // event that allows to start the scan
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("scanHxp", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            clientScanningHxp_->hxpAxisToScan_ = axis;
+            clientScanningHxp_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
+            this->processEvent(eventStartScanHxp{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventStartScanHxp{});  // event that allows to start the scan
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::scanStepper(float stepSize, float range, int durationAcquisition, std::string filename, bool eraseCsvContent, bool showPlot) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        clientScanningStepper_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
-        sMachine_.process_event(eventStartScanStepper{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventStartScanStepper{});  // event that allows to start the scan
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("scanStepper", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            clientScanningStepper_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
+            this->processEvent(eventStartScanStepper{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventStartScanStepper{});  // event that allows to start the scan
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::alignSourceWithSensor() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        clientHxp_->setHxpCoordinates(17, 0, 0, 0, 0, 0);
-        sMachine_.process_event(eventMoveHxpToAbsolutePosition{});
-        sMachine_.process_event(eventMoveHxpToAbsolutePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("alignSourceWithSensor", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            clientHxp_->setHxpCoordinates(17, 0, 0, 0, 0, 0);
+            this->processEvent(eventMoveHxpToAbsolutePosition{});
+            this->processEvent(eventMoveHxpToAbsolutePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::moveToPositionStepper(float position) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        actionsPtr_->setStepperPosition(position);
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("moveToPositionStepper", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            actionsPtr_->setStepperPosition(position);
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::xAxisAlignmentCrystal() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Positions Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_W"));
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::X;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventXAxisAlignmentCrystal{});
-        sMachine_.process_event(eventXAxisAlignmentCrystal{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("xAxisAlignmentCrystal", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Initial Positions Setup ---*/
+            clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_X"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_Y"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_Z"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_U"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_V"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_W"));
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                 "START_POSITION_STEPPER"));
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::X;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "STEP_SIZE"),
+                                                         clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "RANGE"),
+                                                         clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DURATION_ACQUISITION"),
+                                                         clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DATA_LOG_FILENAME"),
+                                                         clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "ERASE_CSV_CONTENT"),
+                                                         false);
+            this->processEvent(eventXAxisAlignmentCrystal{});
+            this->processEvent(eventXAxisAlignmentCrystal{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::yAxisAlignmentCrystal() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_W")
-                                                                                           );
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::Y;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE_Y"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "RANGE_Y"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME_Y_SCAN"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventYAxisAlignmentCrystal{});
-        sMachine_.process_event(eventYAxisAlignmentCrystal{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("yAxisAlignmentCrystal", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                              clientConfiguration_->getPath(),
+                                                                                              "CRYSTAL_HXP",
+                                                                                              "ALIGNMENT_POSITION_HXP_X"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_Y"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Z"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_U"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_V"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_W")
+                                                                                               );
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                 "START_POSITION_STEPPER"));
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::Y;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "STEP_SIZE_Y"),
+                                                         clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "RANGE_Y"),
+                                                         clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DURATION_ACQUISITION"),
+                                                         clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DATA_LOG_FILENAME_Y_SCAN"),
+                                                         clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "ERASE_CSV_CONTENT"),
+                                                         false);
+            this->processEvent(eventYAxisAlignmentCrystal{});
+            this->processEvent(eventYAxisAlignmentCrystal{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::zAxisAlignmentCrystal() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "zAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_W"));
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::Z;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "zAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "zAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "zAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "zAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "zAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventZAxisAlignmentCrystal{});
-        sMachine_.process_event(eventZAxisAlignmentCrystal{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("zAxisAlignmentCrystal", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                              clientConfiguration_->getPath(),
+                                                                                              "CRYSTAL_HXP",
+                                                                                              "ALIGNMENT_POSITION_HXP_X"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_Y"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_Z"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_U"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_V"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "zAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_W"));
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                 "START_POSITION_STEPPER"));
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::Z;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "zAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "STEP_SIZE"),
+                                                         clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "zAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "RANGE"),
+                                                         clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "zAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DURATION_ACQUISITION"),
+                                                         clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "zAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DATA_LOG_FILENAME"),
+                                                         clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "zAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "ERASE_CSV_CONTENT"),
+                                                         false);
+            this->processEvent(eventZAxisAlignmentCrystal{});
+            this->processEvent(eventZAxisAlignmentCrystal{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::yWAxesAlignmentCrystal() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_SCAN_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_W"));
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yWAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventYWAxesAlignmentCrystal{});
-        sMachine_.process_event(eventYWAxesAlignmentCrystal{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("yWAxesAlignmentCrystal", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                              clientConfiguration_->getPath(),
+                                                                                              "CRYSTAL_HXP",
+                                                                                              "ALIGNMENT_POSITION_HXP_X"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "yWAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_SCAN_HXP_Y"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Z"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_U"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_V"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "yWAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_W"));
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                 "START_POSITION_STEPPER"));
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yWAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "STEP_SIZE"),
+                                                         clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yWAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "RANGE"),
+                                                         clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yWAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DURATION_ACQUISITION"),
+                                                         clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yWAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DATA_LOG_FILENAME"),
+                                                         clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yWAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "ERASE_CSV_CONTENT"),
+                                                         false);
+            this->processEvent(eventYWAxesAlignmentCrystal{});
+            this->processEvent(eventYWAxesAlignmentCrystal{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::xAxisFineAlignmentCrystal() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                          "START_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_W"));
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::X;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventXAxisAlignmentCrystal{});
-        sMachine_.process_event(eventXAxisAlignmentCrystal{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("xAxisFineAlignmentCrystal", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                              clientConfiguration_->getPath(),
+                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                              "START_POSITION_HXP_X"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Y"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Z"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_U"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_V"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_W"));
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                 "START_POSITION_STEPPER"));
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::X;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "STEP_SIZE"),
+                                                         clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "RANGE"),
+                                                         clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DURATION_ACQUISITION"),
+                                                         clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DATA_LOG_FILENAME"),
+                                                         clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                              "ERASE_CSV_CONTENT"),
+                                                         false);
+            this->processEvent(eventXAxisAlignmentCrystal{});
+            this->processEvent(eventXAxisAlignmentCrystal{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::braggPeakSearchCrystal() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "Braggs_Peak_Search_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_W"));
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Braggs_Peak_Search_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Braggs_Peak_Search_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Braggs_Peak_Search_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Braggs_Peak_Search_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Braggs_Peak_Search_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventSearchBraggPeakCrystal{});
-        sMachine_.process_event(eventSearchBraggPeakCrystal{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("braggPeakSearchCrystal", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                              clientConfiguration_->getPath(),
+                                                                                              "CRYSTAL_HXP",
+                                                                                              "ALIGNMENT_POSITION_HXP_X"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Y"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Z"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_U"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_V"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "Braggs_Peak_Search_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_W"));
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                 "START_POSITION_STEPPER"));
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "Braggs_Peak_Search_CRYSTAL_STAGE",
+                                                                                                              "STEP_SIZE"),
+                                                         clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "Braggs_Peak_Search_CRYSTAL_STAGE",
+                                                                                                              "RANGE"),
+                                                         clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "Braggs_Peak_Search_CRYSTAL_STAGE",
+                                                                                                              "DURATION_ACQUISITION"),
+                                                         clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "Braggs_Peak_Search_CRYSTAL_STAGE",
+                                                                                                              "DATA_LOG_FILENAME"),
+                                                         clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "Braggs_Peak_Search_CRYSTAL_STAGE",
+                                                                                                              "ERASE_CSV_CONTENT"),
+                                                         false);
+            this->processEvent(eventSearchBraggPeakCrystal{});
+            this->processEvent(eventSearchBraggPeakCrystal{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::yAxisFineAlignmentCrystal() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_W") -
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                           "OFFSET_FROM_BRAGG_ANGLE"));
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventYAxisFineAlignmentCrystal{});
-        sMachine_.process_event(eventYAxisFineAlignmentCrystal{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("yAxisFineAlignmentCrystal", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                              clientConfiguration_->getPath(),
+                                                                                              "CRYSTAL_HXP",
+                                                                                              "ALIGNMENT_POSITION_HXP_X"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Y"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Z"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_U"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_V"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_W") -
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                               "OFFSET_FROM_BRAGG_ANGLE"));
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                                 "START_POSITION_STEPPER"));
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "STEP_SIZE"),
+                                                         clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "RANGE"),
+                                                         clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DURATION_ACQUISITION"),
+                                                         clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DATA_LOG_FILENAME"),
+                                                         clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "ERASE_CSV_CONTENT"),
+                                                         false);
+            this->processEvent(eventYAxisFineAlignmentCrystal{});
+            this->processEvent(eventYAxisFineAlignmentCrystal{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::checkAlignmentInFlippedOrientation() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_W") -
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                           "OFFSET_FROM_BRAGG_ANGLE"));
-        actionsPtr_->setStepperPosition(180);
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "yAxis_Fine_Alignment_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventCheckAlignmentInFlippedOrientation{});
-        sMachine_.process_event(eventCheckAlignmentInFlippedOrientation{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("checkAlignmentInFlippedOrientation", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                              clientConfiguration_->getPath(),
+                                                                                              "CRYSTAL_HXP",
+                                                                                              "ALIGNMENT_POSITION_HXP_X"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Y"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_Z"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_U"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "xAxis_Alignment_CRYSTAL_STAGE",
+                                                                                               "START_POSITION_HXP_V"),
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "CRYSTAL_HXP",
+                                                                                               "ALIGNMENT_POSITION_HXP_W") -
+                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                               clientConfiguration_->getPath(),
+                                                                                               "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                               "OFFSET_FROM_BRAGG_ANGLE"));
+            actionsPtr_->setStepperPosition(180);
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "STEP_SIZE"),
+                                                         clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "RANGE"),
+                                                         clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DURATION_ACQUISITION"),
+                                                         clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "DATA_LOG_FILENAME"),
+                                                         clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "yAxis_Fine_Alignment_CRYSTAL_STAGE",
+                                                                                                              "ERASE_CSV_CONTENT"),
+                                                         false);
+            this->processEvent(eventCheckAlignmentInFlippedOrientation{});
+            this->processEvent(eventCheckAlignmentInFlippedOrientation{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::bendingAngleMeasurement() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_W") +
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "Bending_Angle_CRYSTAL_STAGE",
-                                                                                           "OFFSET_FROM_BRAGG_ANGLE"));
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Bending_Angle_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Bending_Angle_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Bending_Angle_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Bending_Angle_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Bending_Angle_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventBendingAngleMeasurement{});
-        sMachine_.process_event(eventBendingAngleMeasurement{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("bendingAngleMeasurement", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Settings (loaded from a snapshot of the configuration and validated before any movement) ---*/
+            std::shared_ptr<IConfiguration> configuration = clientConfiguration_->takeSnapshot();
+            StartPositionSettings startPositionSettings;
+            BendingAngleSettings settings;
+            if (!alignmentSettings::load(*configuration, startPositionSettings) ||
+                !alignmentSettings::load(*configuration, settings)) {
+                return false;
+            }
+            actionsPtr_->setBendingAngleSettings(settings);
+            actionsPtr_->setConfigurationVersion(configuration->getConfigurationVersion());
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_X"),
+                                          configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_Y"),
+                                          configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_Z"),
+                                          startPositionSettings.startPositionHxpU,
+                                          startPositionSettings.startPositionHxpV,
+                                          configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_W") + settings.offsetFromBraggAngle);
+            actionsPtr_->setStepperPosition(startPositionSettings.startPositionStepper);
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(settings.stepSize,
+                                                         settings.range,
+                                                         settings.durationAcquisition,
+                                                         settings.dataLogFilename,
+                                                         settings.eraseCsvContent,
+                                                         false);
+            this->processEvent(eventBendingAngleMeasurement{});
+            this->processEvent(eventBendingAngleMeasurement{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::miscutAngleMeasurement(bool repeateBendingAngleMeas) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        if (repeateBendingAngleMeas) {
-            this->bendingAngleMeasurement();
-        }
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_W") +
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                           "OFFSET_FROM_BRAGG_ANGLE"));
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Miscut_Angle_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventMiscutAngleMeasurement{});
-        sMachine_.process_event(eventMiscutAngleMeasurement{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("miscutAngleMeasurement", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            if (repeateBendingAngleMeas) {
+                this->bendingAngleMeasurement();
+            }
+            /*--- Settings (loaded from a snapshot of the configuration and validated before any movement) ---*/
+            std::shared_ptr<IConfiguration> configuration = clientConfiguration_->takeSnapshot();
+            StartPositionSettings startPositionSettings;
+            BendingAngleSettings bendingAngleSettings;  // the peaks of the bending angle measurement are used
+            MiscutAngleSettings settings;
+            if (!alignmentSettings::load(*configuration, startPositionSettings) ||
+                !alignmentSettings::load(*configuration, bendingAngleSettings) ||
+                !alignmentSettings::load(*configuration, settings)) {
+                return false;
+            }
+            actionsPtr_->setBendingAngleSettings(bendingAngleSettings);
+            actionsPtr_->setMiscutAngleSettings(settings);
+            actionsPtr_->setConfigurationVersion(configuration->getConfigurationVersion());
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_X"),
+                                          configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_Y"),
+                                          configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_Z"),
+                                          startPositionSettings.startPositionHxpU,
+                                          startPositionSettings.startPositionHxpV,
+                                          configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_W") + settings.offsetFromBraggAngle);
+            actionsPtr_->setStepperPosition(settings.startPositionStepper);
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(settings.stepSize,
+                                                         settings.range,
+                                                         settings.durationAcquisition,
+                                                         settings.dataLogFilename,
+                                                         settings.eraseCsvContent,
+                                                         false);
+            this->processEvent(eventMiscutAngleMeasurement{});
+            this->processEvent(eventMiscutAngleMeasurement{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::torsionAngleMeasurement() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        /*--- Initial Position Setup ---*/
-        clientHxp_->setHxpCoordinates(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                          clientConfiguration_->getPath(),
-                                                                                          "CRYSTAL_HXP",
-                                                                                          "ALIGNMENT_POSITION_HXP_X"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_Y"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_Z"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_U"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "xAxis_Alignment_CRYSTAL_STAGE",
-                                                                                           "START_POSITION_HXP_V"),
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "CRYSTAL_HXP",
-                                                                                           "ALIGNMENT_POSITION_HXP_W") +
-                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                           clientConfiguration_->getPath(),
-                                                                                           "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                           "OFFSET_FROM_BRAGG_ANGLE"));
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                             "START_POSITION_STEPPER"));
-        /*--- Axis to Scan ---*/
-        clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
-        /*--- Alignment Parameters ---*/
-        clientScanningHxp_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                                          "STEP_SIZE"),
-                                                     clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                                          "RANGE"),
-                                                     clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                                          "DURATION_ACQUISITION"),
-                                                     clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                                          "DATA_LOG_FILENAME"),
-                                                     clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Torsion_Angle_CRYSTAL_STAGE",
-                                                                                                          "ERASE_CSV_CONTENT"),
-                                                     false);
-        sMachine_.process_event(eventTorsionAngleMeasurement{});
-        sMachine_.process_event(eventTorsionAngleMeasurement{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("torsionAngleMeasurement", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            /*--- Settings (loaded from a snapshot of the configuration and validated before any movement) ---*/
+            std::shared_ptr<IConfiguration> configuration = clientConfiguration_->takeSnapshot();
+            StartPositionSettings startPositionSettings;
+            TorsionAngleSettings settings;
+            if (!alignmentSettings::load(*configuration, startPositionSettings) ||
+                !alignmentSettings::load(*configuration, settings)) {
+                return false;
+            }
+            actionsPtr_->setTorsionAngleSettings(settings);
+            actionsPtr_->setConfigurationVersion(configuration->getConfigurationVersion());
+            /*--- Initial Position Setup ---*/
+            clientHxp_->setHxpCoordinates(configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_X"),
+                                          settings.startPositionHxpY,
+                                          settings.startPositionHxpZ,
+                                          startPositionSettings.startPositionHxpU,
+                                          startPositionSettings.startPositionHxpV,
+                                          configuration->readFloatFromConfigurationFile(configuration->getConfigFilename(),
+                                                                                        configuration->getPath(),
+                                                                                        "CRYSTAL_HXP",
+                                                                                        "ALIGNMENT_POSITION_HXP_W") + settings.offsetFromBraggAngle);
+            actionsPtr_->setStepperPosition(settings.startPositionStepper);
+            /*--- Axis to Scan ---*/
+            clientScanningHxp_->hxpAxisToScan_ = this->hxpAxis::W;
+            /*--- Alignment Parameters ---*/
+            clientScanningHxp_->setupAlignmentParameters(settings.stepSize,
+                                                         settings.range,
+                                                         settings.durationAcquisition,
+                                                         settings.dataLogFilename,
+                                                         settings.eraseCsvContent,
+                                                         false);
+            this->processEvent(eventTorsionAngleMeasurement{});
+            this->processEvent(eventTorsionAngleMeasurement{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool CrystalDeviceController::logger(std::string filename) {
@@ -928,13 +946,28 @@ bool CrystalDeviceController::logger(std::string filename) {
 }
 
 std::string CrystalDeviceController::getFsmState() {
-    static const char *EnumCrystalStatusStrings[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
-    std::string temp = EnumCrystalStatusStrings[static_cast<int>(this->getStatus())];
+    std::string temp = kCrystalStatusNames[stateMonitor_.getState()];
     spdlog::debug("CrystalDeviceController FSM state is: {}\n", temp);
     return temp;
 }
 
+DeviceStateSnapshot CrystalDeviceController::getStateSnapshot() {
+    return stateMonitor_.getSnapshot();
+}
+
+size_t CrystalDeviceController::addStateListener(DeviceStateMonitor::Listener listener) {
+    return stateMonitor_.addListener(std::move(listener));
+}
+
+void CrystalDeviceController::removeStateListener(size_t id) {
+    stateMonitor_.removeListener(id);
+}
+
 CrystalStatus CrystalDeviceController::getStatus() {
+    return static_cast<CrystalStatus>(stateMonitor_.getState());
+}
+
+CrystalStatus CrystalDeviceController::readStatus() {
     using namespace boost::sml;  // NOLINT
     if (sMachine_.is(state<systemNotInitialized>)) {
         crystalStatus_ = CrystalStatus::NotInitialized;
@@ -0,0 +1,191 @@
+/**
+ * @file Crystal/CrystalRecipe.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Actions of the crystal characterisation recipes (alignments, measurements and analysis of the scans).
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "Crystal/CrystalRecipe.hpp"
+
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <vector>
+
+namespace crystal {
+
+namespace {
+
+const double kSettlingTime = 0.5;  // motion between two points of a scan [s]
+
+bool readSetting(IConfiguration& configuration, const std::string& section, const std::string& key, double& value) {
+    try {
+        value = configuration.readFloatFromConfigurationFile(configuration.getAlignmentSettingsConfigFilename(),
+                                                             configuration.getPath(), section, key);
+    } catch (const std::exception&) {  // std::stof of a missing or non numeric value
+        return false;
+    }
+    return std::isfinite(value);
+}
+
+int countSteps(double stepSize, double range) {
+    return stepSize == 0 ? 1 : static_cast<int>(std::floor(std::fabs(range / stepSize) + 1e-9)) + 1;
+}
+
+/* Duration of a double axis scan: a scan on the W axis for every step of the outer axis */
+double estimateDoubleScanDuration(IConfiguration& configuration,
+                                  const std::string& section,
+                                  const std::string& outerStepSizeKey,
+                                  const std::string& outerRangeKey) {
+    double stepSize = 0;
+    double range = 0;
+    if (!readSetting(configuration, section, outerStepSizeKey, stepSize) || !readSetting(configuration, section, outerRangeKey, range)) {
+        spdlog::warn("Duration of {} not estimated: {} or {} missing\n", section, outerStepSizeKey, outerRangeKey);
+        return 0;
+    }
+    return countSteps(stepSize, range) * estimateScanDuration(configuration, section, "STEP_SIZE", "RANGE", "DURATION_ACQUISITION");
+}
+
+bool isNumber(const RecipeParameters& parameters, const std::string& key) {
+    try {
+        size_t parsed = 0;
+        std::stod(parameters.at(key), &parsed);
+        return parsed == parameters.at(key).size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool reprocessScans(const std::filesystem::path& pathToScanDirectory, const RecipeParameters& parameters) {
+    const std::string filter = parameters.count("filter") ? parameters.at("filter") : "";
+    std::vector<std::filesystem::path> files;
+    for (const std::filesystem::path& file : analysis::findArchivedFiles(pathToScanDirectory)) {
+        if (file.extension() == ".csv" && file.filename().string().find(filter) != std::string::npos) {
+            files.push_back(file);
+        }
+    }
+    const std::filesystem::path pathToSummary = pathToScanDirectory / parameters.at("summary");
+    std::ofstream summary(pathToSummary, std::ios::out | std::ios::trunc);
+    if (!summary.is_open()) {
+        spdlog::error("Unable to write the summary {}\n", pathToSummary.string());
+        return false;
+    }
+    analysis::BatchReprocessing batch(analysis::ReprocessingSettings{});
+    std::vector<analysis::ReprocessingResult> results = batch.run(files, summary);
+    size_t failures = 0;
+    for (const analysis::ReprocessingResult& result : results) {
+        failures += result.success ? 0 : 1;
+    }
+    spdlog::info("{} scans reprocessed in {} ({} failed)\n", results.size(), pathToSummary.string(), failures);
+    return failures == 0;
+}
+
+}  // namespace
+
+double estimateScanDuration(IConfiguration& configuration,
+                            const std::string& section,
+                            const std::string& stepSizeKey,
+                            const std::string& rangeKey,
+                            const std::string& durationKey) {
+    double stepSize = 0;
+    double range = 0;
+    double duration = 0;
+    if (!readSetting(configuration, section, stepSizeKey, stepSize) ||
+        !readSetting(configuration, section, rangeKey, range) ||
+        !readSetting(configuration, section, durationKey, duration)) {
+        spdlog::warn("Duration of {} not estimated: {}, {} or {} missing\n", section, stepSizeKey, rangeKey, durationKey);
+        return 0;
+    }
+    return countSteps(stepSize, range) * (duration + kSettlingTime);
+}
+
+void registerRecipeActions(RecipeEngine& engine,
+                           std::shared_ptr<ICrystalDeviceController> crystal,
+                           std::shared_ptr<IConfiguration> configuration,
+                           const std::filesystem::path& pathToScanDirectory) {
+    /* Alignments */
+    engine.registerMotion("x axis alignment", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->xAxisAlignmentCrystal();
+    }, [configuration](const RecipeParameters&) {
+        return estimateScanDuration(*configuration, "xAxis_Alignment_CRYSTAL_STAGE", "STEP_SIZE", "RANGE", "DURATION_ACQUISITION");
+    }, nullptr});
+    engine.registerMotion("z axis alignment", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->zAxisAlignmentCrystal();
+    }, [configuration](const RecipeParameters&) {
+        return estimateScanDuration(*configuration, "zAxis_Alignment_CRYSTAL_STAGE", "STEP_SIZE", "RANGE", "DURATION_ACQUISITION");
+    }, nullptr});
+    engine.registerMotion("y axis alignment", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->yAxisAlignmentCrystal();
+    }, [configuration](const RecipeParameters&) {
+        return estimateScanDuration(*configuration, "yAxis_Alignment_CRYSTAL_STAGE", "STEP_SIZE_W", "RANGE_W", "DURATION_ACQUISITION") +
+               estimateScanDuration(*configuration, "yAxis_Alignment_CRYSTAL_STAGE", "STEP_SIZE_Y", "RANGE_Y", "DURATION_ACQUISITION_Y");
+    }, nullptr});
+    engine.registerMotion("yw axes alignment", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->yWAxesAlignmentCrystal();
+    }, [configuration](const RecipeParameters&) {
+        return estimateDoubleScanDuration(*configuration, "yWAxis_Alignment_CRYSTAL_STAGE", "STEP_SIZE_SCAN_HXP_Y", "RANGE_SCAN_HXP_Y");
+    }, nullptr});
+    engine.registerMotion("x axis fine alignment", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->xAxisFineAlignmentCrystal();
+    }, nullptr, nullptr});
+    engine.registerMotion("bragg peak search", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->braggPeakSearchCrystal();
+    }, [configuration](const RecipeParameters&) {
+        return estimateScanDuration(*configuration, "Braggs_Peak_Search_CRYSTAL_STAGE", "STEP_SIZE", "RANGE", "DURATION_ACQUISITION");
+    }, nullptr});
+    engine.registerMotion("y axis fine alignment", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->yAxisFineAlignmentCrystal();
+    }, [configuration](const RecipeParameters&) {
+        return estimateDoubleScanDuration(*configuration, "yAxis_Fine_Alignment_CRYSTAL_STAGE", "STEP_SIZE_SCAN_HXP_Y", "RANGE_SCAN_HXP_Y");
+    }, nullptr});
+    engine.registerMotion("flipped orientation check", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->checkAlignmentInFlippedOrientation();
+    }, nullptr, nullptr});
+    /* Measurements */
+    engine.registerMotion("bending angle", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->bendingAngleMeasurement();
+    }, [configuration](const RecipeParameters&) {
+        return estimateDoubleScanDuration(*configuration, "Bending_Angle_CRYSTAL_STAGE", "STEP_SIZE_SCAN_HXP_Y", "RANGE_SCAN_HXP_Y");
+    }, nullptr});
+    engine.registerMotion("miscut angle", crystal, {{}, [crystal](const RecipeParameters& parameters) {
+        return crystal->miscutAngleMeasurement(parameters.count("repeat_bending_angle") && parameters.at("repeat_bending_angle") == "1");
+    }, [configuration](const RecipeParameters& parameters) {
+        double duration = estimateDoubleScanDuration(*configuration, "Miscut_Angle_CRYSTAL_STAGE", "STEP_SIZE_SCAN_HXP_Y", "RANGE_SCAN_HXP_Y");
+        if (parameters.count("repeat_bending_angle") && parameters.at("repeat_bending_angle") == "1") {
+            duration += estimateDoubleScanDuration(*configuration, "Bending_Angle_CRYSTAL_STAGE", "STEP_SIZE_SCAN_HXP_Y", "RANGE_SCAN_HXP_Y");
+        }
+        return duration;
+    }, [](const RecipeParameters& parameters) {
+        return !parameters.count("repeat_bending_angle") || parameters.at("repeat_bending_angle") == "0" ||
+               parameters.at("repeat_bending_angle") == "1";
+    }});
+    engine.registerMotion("torsion angle", crystal, {{}, [crystal](const RecipeParameters&) {
+        return crystal->torsionAngleMeasurement();
+    }, [configuration](const RecipeParameters&) {
+        return estimateDoubleScanDuration(*configuration, "Torsion_Angle_CRYSTAL_STAGE", "STEP_SIZE_SCAN_HXP_Z", "RANGE_SCAN_HXP_Z");
+    }, nullptr});
+    /* Motions */
+    engine.registerMotion("move stepper", crystal, {{"position"}, [crystal](const RecipeParameters& parameters) {
+        return crystal->moveToPositionStepper(std::stof(parameters.at("position")));
+    }, nullptr, [](const RecipeParameters& parameters) {
+        return isNumber(parameters, "position");
+    }});
+    engine.registerMotion("move hexapod", crystal, {{"x", "y", "z", "u", "v", "w"}, [crystal](const RecipeParameters& parameters) {
+        return crystal->moveToAbsPosition(std::stod(parameters.at("x")), std::stod(parameters.at("y")), std::stod(parameters.at("z")),
+                                          std::stod(parameters.at("u")), std::stod(parameters.at("v")), std::stod(parameters.at("w")));
+    }, nullptr, [](const RecipeParameters& parameters) {
+        return isNumber(parameters, "x") && isNumber(parameters, "y") && isNumber(parameters, "z") &&
+               isNumber(parameters, "u") && isNumber(parameters, "v") && isNumber(parameters, "w");
+    }});
+    /* Analysis */
+    engine.registerAnalysis("reprocess scans", {{"summary"}, [pathToScanDirectory](const RecipeParameters& parameters) {
+        return reprocessScans(pathToScanDirectory, parameters);
+    }, nullptr, nullptr});
+}
+
+}  // namespace crystal
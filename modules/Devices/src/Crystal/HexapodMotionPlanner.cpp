@@ -0,0 +1,108 @@
+/**
+ * @file Crystal/HexapodMotionPlanner.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class moving the hexapod through a set of poses and timing the movements against a kinematic model.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "Crystal/HexapodMotionPlanner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace crystal {
+
+namespace {
+
+/**
+ * @brief Duration of a trapezoidal velocity profile (triangular when the axis cannot reach its velocity).
+ *
+ */
+double profileTime(double distance, double velocity, double acceleration) {
+    distance = std::fabs(distance);
+    if (distance <= 0) {
+        return 0;
+    }
+    if (distance >= velocity * velocity / acceleration) {
+        return distance / velocity + velocity / acceleration;
+    }
+    return 2 * std::sqrt(distance / acceleration);
+}
+
+}  // namespace
+
+HexapodMotionPlanner::HexapodMotionPlanner(std::shared_ptr<IHXP> clientHxp, const HexapodMotionSettings& settings):
+                                           clientHxp_(clientHxp),
+                                           settings_(settings) {
+    if (!settings_.isValid()) {
+        spdlog::warn("Kinematic model of the hexapod not valid: the movements are not timed\n");
+    }
+}
+
+double HexapodMotionPlanner::estimateMoveTime(const HxpPose& from, const HxpPose& to) const {
+    if (!settings_.isValid()) {
+        return 0;
+    }
+    const double axesTime = std::max({profileTime(to.CoordX - from.CoordX, settings_.velocityX, settings_.accelerationX),
+                                      profileTime(to.CoordY - from.CoordY, settings_.velocityY, settings_.accelerationY),
+                                      profileTime(to.CoordZ - from.CoordZ, settings_.velocityZ, settings_.accelerationZ),
+                                      profileTime(to.CoordU - from.CoordU, settings_.velocityU, settings_.accelerationU),
+                                      profileTime(to.CoordV - from.CoordV, settings_.velocityV, settings_.accelerationV),
+                                      profileTime(to.CoordW - from.CoordW, settings_.velocityW, settings_.accelerationW)});
+    return axesTime > 0 ? axesTime + settings_.settlingTime : 0;  // the axes move together
+}
+
+bool HexapodMotionPlanner::moveTo(const HxpPose& pose) {
+    const double predictedTime = this->estimateMoveTime(this->getTargetPose(), pose);
+    clientHxp_->setHxpCoordinates(pose.CoordX, pose.CoordY, pose.CoordZ, pose.CoordU, pose.CoordV, pose.CoordW);
+    auto startTime = std::chrono::steady_clock::now();
+    bool moved = clientHxp_->setPositionAbsolute(pose.CoordX, pose.CoordY, pose.CoordZ, pose.CoordU, pose.CoordV, pose.CoordW) == 0;
+    const double actualTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    report_.moves++;
+    report_.failedMoves += moved ? 0 : 1;
+    report_.predictedTime += predictedTime;
+    report_.actualTime += actualTime;
+    spdlog::debug("Hexapod movement: predicted {:.2f} s, measured {:.2f} s\n", predictedTime, actualTime);
+    return moved;
+}
+
+bool HexapodMotionPlanner::visit(const std::vector<HxpPose>& poses, const Step& step) {
+    const HexapodMotionReport reportBefore = report_;
+    bool result = true;
+    for (size_t index = 0; index < poses.size(); index++) {
+        bool moved = this->moveTo(poses[index]);
+        if (!step(index, moved)) {
+            result = false;
+            break;
+        }
+    }
+    spdlog::info("Hexapod: {} movements ({} failed), predicted travel time {:.1f} s, measured {:.1f} s\n",
+                 report_.moves - reportBefore.moves,
+                 report_.failedMoves - reportBefore.failedMoves,
+                 report_.predictedTime - reportBefore.predictedTime,
+                 report_.actualTime - reportBefore.actualTime);
+    return result;
+}
+
+HexapodMotionReport HexapodMotionPlanner::getReport() const {
+    return report_;
+}
+
+HxpPose HexapodMotionPlanner::getTargetPose() const {
+    HxpPose pose;
+    pose.CoordX = clientHxp_->getCoordinateX();
+    pose.CoordY = clientHxp_->getCoordinateY();
+    pose.CoordZ = clientHxp_->getCoordinateZ();
+    pose.CoordU = clientHxp_->getCoordinateU();
+    pose.CoordV = clientHxp_->getCoordinateV();
+    pose.CoordW = clientHxp_->getCoordinateW();
+    return pose;
+}
+
+}  // namespace crystal
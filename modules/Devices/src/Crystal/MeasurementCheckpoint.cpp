@@ -0,0 +1,217 @@
+/**
+ * @file Crystal/MeasurementCheckpoint.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class used to store the progress of the crystal measurements (bending, miscut and torsion angle) in a checkpoint file.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "Crystal/MeasurementCheckpoint.hpp"
+
+#include <cmath>
+
+namespace crystal {
+
+namespace {
+
+void writePose(mINI::INIMap<std::string>& section, const HxpPose& pose) {
+    section["HXP_X"] = std::to_string(pose.CoordX);
+    section["HXP_Y"] = std::to_string(pose.CoordY);
+    section["HXP_Z"] = std::to_string(pose.CoordZ);
+    section["HXP_U"] = std::to_string(pose.CoordU);
+    section["HXP_V"] = std::to_string(pose.CoordV);
+    section["HXP_W"] = std::to_string(pose.CoordW);
+}
+
+HxpPose readPose(mINI::INIMap<std::string>& section) {
+    HxpPose pose;
+    pose.CoordX = std::stod(section["HXP_X"]);
+    pose.CoordY = std::stod(section["HXP_Y"]);
+    pose.CoordZ = std::stod(section["HXP_Z"]);
+    pose.CoordU = std::stod(section["HXP_U"]);
+    pose.CoordV = std::stod(section["HXP_V"]);
+    pose.CoordW = std::stod(section["HXP_W"]);
+    return pose;
+}
+
+std::string iterationSectionName(int iteration) {
+    return "ITERATION_" + std::to_string(iteration);
+}
+
+}  // namespace
+
+MeasurementCheckpoint::MeasurementCheckpoint(std::filesystem::path pathToCheckpointFile,
+                                             std::string measurementName):
+                                             pathToCheckpointFile_(pathToCheckpointFile),
+                                             measurementName_(measurementName) {
+    spdlog::info("cTor MeasurementCheckpoint\n");
+}
+
+MeasurementCheckpoint::~MeasurementCheckpoint() {
+    spdlog::info("dTor MeasurementCheckpoint\n");
+}
+
+bool MeasurementCheckpoint::resume(const MeasurementCheckpointParameters& parameters) {
+    spdlog::info("Method resume of Class MeasurementCheckpoint\n");
+    parameters_ = parameters;
+    peaksHeader_.clear();
+    completedIterations_.clear();
+    mINI::INIFile file(pathToCheckpointFile_.string());
+    mINI::INIStructure ini;
+    if (!std::filesystem::exists(pathToCheckpointFile_) || !file.read(ini)) {
+        return false;
+    }
+    try {
+        if (!this->isCompatible(ini, parameters)) {
+            spdlog::warn("Checkpoint {} belongs to a different measurement. Starting from the first step.\n",
+                         pathToCheckpointFile_.string());
+            return false;
+        }
+        peaksHeader_ = ini["CHECKPOINT"]["PEAKS_HEADER"];
+        const int nCompletedIterations = std::stoi(ini["CHECKPOINT"]["COMPLETED_ITERATIONS"]);
+        for (int iteration = 0; iteration < nCompletedIterations; iteration++) {
+            const std::string sectionName = iterationSectionName(iteration);
+            if (!ini.has(sectionName)) {
+                break;
+            }
+            CompletedIteration completedIteration;
+            completedIteration.position = std::stod(ini[sectionName]["POSITION"]);
+            completedIteration.pose = readPose(ini[sectionName]);
+            completedIteration.partialResult = ini[sectionName]["PARTIAL_RESULT"];
+            completedIterations_.push_back(completedIteration);
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("Corrupted checkpoint {} ({}). Starting from the first step.\n",
+                      pathToCheckpointFile_.string(),
+                      e.what());
+        peaksHeader_.clear();
+        completedIterations_.clear();
+        return false;
+    }
+    spdlog::info("Resuming {} from step {}\n", measurementName_, completedIterations_.size());
+    return !completedIterations_.empty();
+}
+
+bool MeasurementCheckpoint::isIterationCompleted(int iteration) const {
+    return iteration >= 0 && iteration < static_cast<int>(completedIterations_.size());
+}
+
+bool MeasurementCheckpoint::registerCompletedIteration(int iteration,
+                                                       double position,
+                                                       const HxpPose& pose,
+                                                       const std::string& pathToPeaks) {
+    spdlog::info("Method registerCompletedIteration of Class MeasurementCheckpoint\n");
+    if (iteration != static_cast<int>(completedIterations_.size())) {
+        spdlog::error("Step {} of {} registered out of order\n", iteration, measurementName_);
+        return false;
+    }
+    CompletedIteration completedIteration;
+    completedIteration.position = position;
+    completedIteration.pose = pose;
+    std::ifstream peaksFile(pathToPeaks);
+    std::string line;
+    while (std::getline(peaksFile, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        if (peaksHeader_.empty()) {
+            peaksHeader_ = line;
+        } else if (line != peaksHeader_) {
+            completedIteration.partialResult = line;
+        }
+    }
+    completedIterations_.push_back(completedIteration);
+    return this->save();
+}
+
+bool MeasurementCheckpoint::restorePartialResults(const std::string& pathToPeaks) const {
+    spdlog::info("Method restorePartialResults of Class MeasurementCheckpoint\n");
+    if (peaksHeader_.empty()) {
+        return false;
+    }
+    std::ofstream peaksFile(pathToPeaks, std::ios::out | std::ios::trunc);
+    if (!peaksFile.is_open()) {
+        spdlog::error("Unable to restore the partial results in {}\n", pathToPeaks);
+        return false;
+    }
+    peaksFile << peaksHeader_ << "\n";
+    for (const CompletedIteration& completedIteration : completedIterations_) {
+        if (!completedIteration.partialResult.empty()) {
+            peaksFile << completedIteration.partialResult << "\n";
+        }
+    }
+    return true;
+}
+
+int MeasurementCheckpoint::getCompletedIterations() const {
+    return static_cast<int>(completedIterations_.size());
+}
+
+HxpPose MeasurementCheckpoint::getLastPose() const {
+    if (completedIterations_.empty()) {
+        return parameters_.initialPose;
+    }
+    return completedIterations_.back().pose;
+}
+
+bool MeasurementCheckpoint::clear() {
+    spdlog::info("Method clear of Class MeasurementCheckpoint\n");
+    peaksHeader_.clear();
+    completedIterations_.clear();
+    std::error_code errorCode;
+    std::filesystem::remove(pathToCheckpointFile_, errorCode);
+    return !errorCode;
+}
+
+bool MeasurementCheckpoint::save() const {
+    mINI::INIFile file(pathToCheckpointFile_.string());
+    mINI::INIStructure ini;
+    ini["CHECKPOINT"]["MEASUREMENT"] = measurementName_;
+    ini["CHECKPOINT"]["START_POSITION"] = std::to_string(parameters_.startPosition);
+    ini["CHECKPOINT"]["STEP_SIZE"] = std::to_string(parameters_.stepSize);
+    ini["CHECKPOINT"]["RANGE"] = std::to_string(parameters_.range);
+    writePose(ini["CHECKPOINT"], parameters_.initialPose);
+    ini["CHECKPOINT"]["PEAKS_HEADER"] = peaksHeader_;
+    ini["CHECKPOINT"]["COMPLETED_ITERATIONS"] = std::to_string(completedIterations_.size());
+    for (size_t iteration = 0; iteration < completedIterations_.size(); iteration++) {
+        const std::string sectionName = iterationSectionName(static_cast<int>(iteration));
+        ini[sectionName]["POSITION"] = std::to_string(completedIterations_[iteration].position);
+        writePose(ini[sectionName], completedIterations_[iteration].pose);
+        ini[sectionName]["PARTIAL_RESULT"] = completedIterations_[iteration].partialResult;
+    }
+    bool generateSuccess = file.generate(ini, true);
+    if (!generateSuccess) {
+        spdlog::error("Unable to save the checkpoint {}\n", pathToCheckpointFile_.string());
+    }
+    return generateSuccess;
+}
+
+bool MeasurementCheckpoint::isCompatible(mINI::INIStructure& ini, const MeasurementCheckpointParameters& parameters) const {
+    if (!ini.has("CHECKPOINT") || ini["CHECKPOINT"]["MEASUREMENT"] != measurementName_) {
+        return false;
+    }
+    const HxpPose storedPose = readPose(ini["CHECKPOINT"]);
+    const double differences[] = {
+        std::stod(ini["CHECKPOINT"]["START_POSITION"]) - parameters.startPosition,
+        std::stod(ini["CHECKPOINT"]["STEP_SIZE"]) - parameters.stepSize,
+        std::stod(ini["CHECKPOINT"]["RANGE"]) - parameters.range,
+        storedPose.CoordX - parameters.initialPose.CoordX,
+        storedPose.CoordY - parameters.initialPose.CoordY,
+        storedPose.CoordZ - parameters.initialPose.CoordZ,
+        storedPose.CoordU - parameters.initialPose.CoordU,
+        storedPose.CoordV - parameters.initialPose.CoordV,
+        storedPose.CoordW - parameters.initialPose.CoordW
+    };
+    for (double difference : differences) {
+        if (std::fabs(difference) > tolerance_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace crystal
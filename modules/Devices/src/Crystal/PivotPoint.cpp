@@ -0,0 +1,114 @@
+/**
+ * @file Crystal/PivotPoint.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class moving the pivot point of the hexapod to the impact point of the beam on the crystal.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "Crystal/PivotPoint.hpp"
+
+#include <cmath>
+
+namespace crystal {
+
+namespace {
+
+constexpr double kDegreesToRadians = 3.14159265358979323846 / 180.0;
+
+/**
+ * @brief Rotate the vector (x, y) by an angle in degrees.
+ *
+ */
+void rotate(double& x, double& y, double angle) {
+    const double c = std::cos(angle * kDegreesToRadians);
+    const double s = std::sin(angle * kDegreesToRadians);
+    const double rotatedX = c * x - s * y;
+    y = s * x + c * y;
+    x = rotatedX;
+}
+
+}  // namespace
+
+PivotPoint::PivotPoint(std::shared_ptr<IHXP> clientHxp): clientHxp_(clientHxp), active_(false) {}
+
+PivotPoint::~PivotPoint() {
+    this->release();
+}
+
+HxpPose PivotPoint::toToolFrame(const HxpPose& pose, const HxpPose& point) {
+    /* Inverse of Rz(W) * Ry(V) * Rx(U): rotate by -W about Z, then by -V about Y, then by -U about X */
+    HxpPose local;
+    local.CoordX = point.CoordX - pose.CoordX;
+    local.CoordY = point.CoordY - pose.CoordY;
+    local.CoordZ = point.CoordZ - pose.CoordZ;
+    rotate(local.CoordX, local.CoordY, -pose.CoordW);
+    rotate(local.CoordZ, local.CoordX, -pose.CoordV);
+    rotate(local.CoordY, local.CoordZ, -pose.CoordU);
+    return local;
+}
+
+bool PivotPoint::activate(const PivotPointSettings& settings) {
+    if (active_) {
+        return true;
+    }
+    if (!settings.enabled || !settings.isValid()) {
+        return false;
+    }
+    HxpPose tool;
+    if (clientHxp_->getToolCoordinateSystem(tool.CoordX, tool.CoordY, tool.CoordZ, tool.CoordU, tool.CoordV, tool.CoordW) != 0) {
+        return false;
+    }
+    HxpPose pose;
+    pose.CoordX = clientHxp_->getCoordinateX();
+    pose.CoordY = clientHxp_->getCoordinateY();
+    pose.CoordZ = clientHxp_->getCoordinateZ();
+    pose.CoordU = clientHxp_->getCoordinateU();
+    pose.CoordV = clientHxp_->getCoordinateV();
+    pose.CoordW = clientHxp_->getCoordinateW();
+    HxpPose beam;
+    beam.CoordX = settings.beamX;
+    beam.CoordY = settings.beamY;
+    beam.CoordZ = settings.beamZ;
+    HxpPose pivot = PivotPoint::toToolFrame(pose, beam);
+    pivot.CoordX += tool.CoordX;
+    pivot.CoordY += tool.CoordY;
+    pivot.CoordZ += tool.CoordZ;
+    const double distance = std::sqrt(pivot.CoordX * pivot.CoordX + pivot.CoordY * pivot.CoordY + pivot.CoordZ * pivot.CoordZ);
+    if (distance > settings.maxDistance) {
+        spdlog::error("Pivot point at {:.3f} mm from the centre of the carriage (maximum {} mm)\n", distance, settings.maxDistance);
+        return false;
+    }
+    if (clientHxp_->setToolCoordinateSystem(pivot.CoordX, pivot.CoordY, pivot.CoordZ, tool.CoordU, tool.CoordV, tool.CoordW) != 0) {
+        return false;
+    }
+    previousTool_ = tool;
+    active_ = true;
+    spdlog::info("Pivot point on the impact point of the beam: X: {:.3f}; Y: {:.3f}; Z: {:.3f} (carriage frame)\n",
+                 pivot.CoordX, pivot.CoordY, pivot.CoordZ);
+    return true;
+}
+
+bool PivotPoint::release() {
+    if (!active_) {
+        return true;
+    }
+    if (clientHxp_->setToolCoordinateSystem(previousTool_.CoordX, previousTool_.CoordY, previousTool_.CoordZ,
+                                            previousTool_.CoordU, previousTool_.CoordV, previousTool_.CoordW) != 0) {
+        spdlog::error("Tool coordinate system of the hexapod not restored\n");
+        return false;
+    }
+    active_ = false;
+    spdlog::info("Pivot point restored\n");
+    return true;
+}
+
+bool PivotPoint::isActive() const {
+    return active_;
+}
+
+}  // namespace crystal
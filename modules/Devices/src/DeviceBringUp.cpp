@@ -0,0 +1,89 @@
+/**
+ * @file DeviceBringUp.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class connecting and homing all the devices of the machine in parallel.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "DeviceBringUp.hpp"
+
+DeviceBringUp::DeviceBringUp() :
+    orchestrator_("Bring-up") {
+}
+
+std::vector<std::shared_ptr<DeviceCommand>> DeviceBringUp::start() {
+    startTime_ = std::chrono::steady_clock::now();
+    handles_ = orchestrator_.start();
+    spdlog::info("Bring-up: {} devices connecting and homing in parallel\n", devices_.size());
+    return handles_;
+}
+
+bool DeviceBringUp::wait() const {
+    bool succeeded = orchestrator_.wait();
+    for (const DeviceBringUpReport& report : this->getReport()) {
+        if (report.homing == CommandState::Succeeded) {
+            spdlog::info("Bring-up: {} ready (connection {:.1f} s, homing {:.1f} s)\n",
+                         report.device, report.connectionTime, report.homingTime);
+        } else {
+            spdlog::error("Bring-up: {} not ready ({} failed)\n",
+                          report.device, report.connection == CommandState::Succeeded ? "homing" : "connection");
+        }
+    }
+    spdlog::info("Bring-up: finished in {:.1f} s\n", this->getDuration());
+    return succeeded;
+}
+
+bool DeviceBringUp::isDone() const {
+    return orchestrator_.isDone();
+}
+
+std::vector<DeviceBringUpReport> DeviceBringUp::getReport() const {
+    std::vector<DeviceBringUpReport> reports;
+    for (size_t device = 0; device < devices_.size(); device++) {
+        DeviceBringUpReport report;
+        report.device = devices_[device];
+        if (2 * device + 1 < handles_.size()) {
+            const std::shared_ptr<DeviceCommand>& connection = handles_[2 * device];
+            const std::shared_ptr<DeviceCommand>& homing = handles_[2 * device + 1];
+            report.connection = connection->getState();
+            report.connectionTime = connection->getDuration();
+            report.homing = homing->getState();
+            report.homingTime = homing->getDuration();
+        }
+        reports.push_back(report);
+    }
+    return reports;
+}
+
+double DeviceBringUp::getDuration() const {
+    if (handles_.empty()) {
+        return 0;
+    }
+    if (!this->isDone()) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime_).count();
+    }
+    double duration = 0;
+    for (const DeviceBringUpReport& report : this->getReport()) {  // the homing follows the connection on the same device
+        duration = std::max(duration, report.connectionTime + report.homingTime);
+    }
+    return duration;
+}
+
+std::function<bool()> DeviceBringUp::timed(const std::string& device, const std::string& stage, std::function<bool()> command) {
+    return [device, stage, command = std::move(command)] {
+        auto start = std::chrono::steady_clock::now();
+        bool succeeded = command();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (succeeded) {
+            spdlog::info("Bring-up: {} {} done in {:.1f} s\n", device, stage, seconds);
+        } else {
+            spdlog::error("Bring-up: {} {} failed after {:.1f} s\n", device, stage, seconds);
+        }
+        return succeeded;
+    };
+}
@@ -0,0 +1,207 @@
+/**
+ * @file DeviceCommandQueue.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Queue of the commands of a device, run one after the other by the worker thread of the device.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "DeviceCommandQueue.hpp"
+
+DeviceCommand::DeviceCommand(std::string name) :
+    name_(std::move(name)) {
+}
+
+const std::string& DeviceCommand::getName() const {
+    return name_;
+}
+
+CommandState DeviceCommand::getState() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+}
+
+bool DeviceCommand::isDone() const {
+    CommandState state = this->getState();
+    return state != CommandState::Queued && state != CommandState::Running;
+}
+
+double DeviceCommand::getProgress() const {
+    return progress_;
+}
+
+void DeviceCommand::setProgress(double progress) {
+    progress_ = progress < 0 ? 0 : (progress > 1 ? 1 : progress);
+}
+
+bool DeviceCommand::isCancelled() const {
+    return cancelled_;
+}
+
+bool DeviceCommand::hasInterrupted() const {
+    return interrupted_;
+}
+
+bool DeviceCommand::wait() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return state_ != CommandState::Queued && state_ != CommandState::Running; });
+    return result_;
+}
+
+bool DeviceCommand::waitFor(std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, timeout, [this] { return state_ != CommandState::Queued && state_ != CommandState::Running; });
+}
+
+double DeviceCommand::getDuration() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ == CommandState::Queued || startTime_ == std::chrono::steady_clock::time_point()) {
+        return 0;  // never run (e.g. cancelled while queued)
+    }
+    auto end = state_ == CommandState::Running ? std::chrono::steady_clock::now() : endTime_;
+    return std::chrono::duration<double>(end - startTime_).count();
+}
+
+void DeviceCommand::cancel() {
+    cancelled_ = true;
+}
+
+void DeviceCommand::setState(CommandState state, bool result) {
+    if (state != CommandState::Queued && state != CommandState::Running) {
+        progress_ = 1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state == CommandState::Running) {
+        startTime_ = std::chrono::steady_clock::now();
+    } else if (state != CommandState::Queued) {
+        endTime_ = std::chrono::steady_clock::now();
+    }
+    state_ = state;
+    result_ = result;
+    condition_.notify_all();
+}
+
+DeviceCommandQueue::DeviceCommandQueue(std::string deviceName) :
+    deviceName_(std::move(deviceName)) {
+    thread_ = std::thread(&DeviceCommandQueue::work, this);
+}
+
+DeviceCommandQueue::~DeviceCommandQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        for (auto& [handle, command] : commands_) {
+            handle->cancel();
+            handle->setState(CommandState::Cancelled);
+        }
+        commands_.clear();
+    }
+    condition_.notify_all();
+    thread_.join();
+}
+
+std::shared_ptr<DeviceCommand> DeviceCommandQueue::submit(const std::string& name, Command command) {
+    auto handle = std::make_shared<DeviceCommand>(name);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+        handle->setState(CommandState::Cancelled);
+        return handle;
+    }
+    commands_.emplace_back(handle, std::move(command));
+    condition_.notify_one();
+    return handle;
+}
+
+std::shared_ptr<DeviceCommand> DeviceCommandQueue::preempt(const std::string& name, Command command, const Interrupt& interrupt) {
+    auto handle = std::make_shared<DeviceCommand>(name);
+    std::shared_ptr<DeviceCommand> running;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            handle->setState(CommandState::Cancelled);
+            return handle;
+        }
+        for (auto& [queued, queuedCommand] : commands_) {
+            spdlog::info("{}: command '{}' cancelled by '{}'\n", deviceName_, queued->getName(), name);
+            queued->cancel();
+            queued->setState(CommandState::Cancelled);
+        }
+        commands_.clear();
+        commands_.emplace_front(handle, std::move(command));
+        running = running_;
+        if (running) {
+            running->cancel();
+            handle->interrupted_ = true;
+        }
+    }
+    if (running && interrupt) {
+        spdlog::info("{}: command '{}' interrupted by '{}'\n", deviceName_, running->getName(), name);
+        interrupt();  // the worker thread is busy: the running command is stopped from here
+    }
+    condition_.notify_one();
+    return handle;
+}
+
+bool DeviceCommandQueue::run(const std::string& name, Command command) {
+    if (this->isWorkerThread()) {
+        DeviceCommand nested(name);
+        return command(nested);
+    }
+    return this->submit(name, std::move(command))->wait();
+}
+
+bool DeviceCommandQueue::isWorkerThread() const {
+    return std::this_thread::get_id() == thread_.get_id();
+}
+
+bool DeviceCommandQueue::isCancelled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_ && running_->isCancelled();
+}
+
+size_t DeviceCommandQueue::getPendingCommands() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return commands_.size() + (running_ ? 1 : 0);
+}
+
+void DeviceCommandQueue::setObserver(Observer observer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    observer_ = std::move(observer);
+}
+
+void DeviceCommandQueue::work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this] { return stopped_ || !commands_.empty(); });
+        if (commands_.empty()) {
+            return;  // stopped and nothing left to run
+        }
+        auto [handle, command] = std::move(commands_.front());
+        commands_.pop_front();
+        running_ = handle;
+        handle->setState(CommandState::Running);
+        Observer observer = observer_;
+        lock.unlock();
+        if (observer) {
+            observer(handle->getName(), true);
+        }
+        CommandState state = CommandState::Failed;
+        bool result = false;
+        try {
+            result = command(*handle);
+            state = handle->isCancelled() ? CommandState::Cancelled : (result ? CommandState::Succeeded : CommandState::Failed);
+        } catch (const std::exception& exception) {
+            spdlog::error("{}: command '{}' failed: {}\n", deviceName_, handle->getName(), exception.what());
+        }
+        if (observer) {
+            observer(handle->getName(), false);  // before the handle is completed: the callers waiting for it see the device idle
+        }
+        lock.lock();
+        running_.reset();
+        handle->setState(state, result);
+    }
+}
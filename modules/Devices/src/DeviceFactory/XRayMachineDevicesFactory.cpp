@@ -14,16 +14,26 @@
 
 XRayMachineDevicesFactory::XRayMachineDevicesFactory() {
     spdlog::info("cTor XRayMachineDevicesFactory\n");
-    currentPath_ = std::filesystem::current_path();
-    projectName_ = "XRay_Machine";
-    clientConfiguration_ = std::make_shared<Configuration>();
-    clientPostProcessing_ = std::make_shared<PostProcessing>();
-    std::filesystem::path pathToProjDirectory = clientConfiguration_->getPartialPathUntilKeyName(currentPath_, projectName_);
-    clientSensors_ = std::make_shared<Sensors>(pathToProjDirectory);
+    projectPaths_ = ProjectPaths::getShared();
+    std::shared_ptr<Configuration> configuration = std::make_shared<Configuration>();
+    configuration->startWatcher(configurationWatcherPeriod_);  // the edits of the configuration files are published in background
+    clientConfiguration_ = configuration;
+    clientPostProcessing_ = std::make_shared<PythonWorkerPostProcessing>(projectPaths_->getScriptsDirectory() / "PostProcessingWorker.py");
+    scanPointStream_ = std::make_shared<ScanPointStream>();
+    clientSensors_ = std::make_shared<Sensors>(projectPaths_->getRoot());
 }
 
 XRayMachineDevicesFactory::~XRayMachineDevicesFactory() {
     spdlog::info("dTor XRayMachineDevicesFactory\n");
+    ConfigurationCache::getShared()->stopWatcher();
+}
+
+std::shared_ptr<ScanPointStream> XRayMachineDevicesFactory::getScanPointStream() {
+    return scanPointStream_;
+}
+
+std::shared_ptr<IConfiguration> XRayMachineDevicesFactory::getConfiguration() {
+    return clientConfiguration_;
 }
 
 std::shared_ptr<ICrystalDeviceController> XRayMachineDevicesFactory::createCrystalDeviceController() {
@@ -35,12 +45,13 @@ std::shared_ptr<ICrystalDeviceController> XRayMachineDevicesFactory::createCryst
     // Scanning
     std::shared_ptr<IScanning> clientScanningHXP =
         std::make_shared<ScanningHXP>(clientHXP, clientSensors_, clientPostProcessing_);
+    clientScanningHXP->setScanPointStream(scanPointStream_);
     std::shared_ptr<IScanning> clientScanningStepper =
         std::make_shared<ScanningStepper>(clientStepper, clientSensors_, clientPostProcessing_);
+    clientScanningStepper->setScanPointStream(scanPointStream_);
     // Logger
-    std::filesystem::path logFileDirectoryName = "LogFiles";
     std::filesystem::path logFileName = "crystalDeviceController_logFile.txt";
-    std::filesystem::path logFilePath = clientConfiguration_->getPartialPathUntilKeyName(currentPath_, projectName_) / logFileDirectoryName / logFileName;
+    std::filesystem::path logFilePath = projectPaths_->getLogDirectory() / logFileName;
     std::shared_ptr<ICrystalDeviceController> clientCryDeviceController =
         std::make_shared<CrystalDeviceController>(logFilePath,
                                                   clientHXP,
@@ -60,10 +71,10 @@ std::shared_ptr<ISingleStepperDeviceController> XRayMachineDevicesFactory::creat
     // Scanning
     std::shared_ptr<IScanning> clientScanning =
         std::make_shared<ScanningStepper>(clientStepper, clientSensors_, clientPostProcessing_);
+    clientScanning->setScanPointStream(scanPointStream_);
     // Logger
-    std::filesystem::path logFileDirectoryName = "LogFiles";
     std::filesystem::path logFileName = "AutocollimatorDeviceController_logFile.txt";
-    std::filesystem::path logFilePath = clientConfiguration_->getPartialPathUntilKeyName(currentPath_, projectName_) /= logFileDirectoryName /= logFileName;
+    std::filesystem::path logFilePath = projectPaths_->getLogDirectory() / logFileName;
     std::shared_ptr<ISingleStepperDeviceController> clientAutocollimatorDeviceController =
         std::make_shared<AutocollimatorDeviceController>(logFilePath,
                                                          clientStepper,
@@ -81,12 +92,13 @@ std::shared_ptr<IMultiStepperDeviceController> XRayMachineDevicesFactory::create
     // Scanning
     std::shared_ptr<IScanning> clientScanningLinear =
         std::make_shared<ScanningStepper>(clientStepperLinear, clientSensors_, clientPostProcessing_);
+    clientScanningLinear->setScanPointStream(scanPointStream_);
     std::shared_ptr<IScanning> clientScanningRotational =
         std::make_shared<ScanningStepper>(clientStepperRotational, clientSensors_, clientPostProcessing_);
+    clientScanningRotational->setScanPointStream(scanPointStream_);
     // Logger
-    std::filesystem::path logFileDirectoryName = "LogFiles";
     std::filesystem::path logFileName = "MonochromatorDeviceController_logFile.txt";
-    std::filesystem::path logFilePath = clientConfiguration_->getPartialPathUntilKeyName(currentPath_, projectName_) /= logFileDirectoryName /= logFileName;
+    std::filesystem::path logFilePath = projectPaths_->getLogDirectory() / logFileName;
     std::shared_ptr<IMultiStepperDeviceController> clientMonochromatorDeviceController =
         std::make_shared<MonochromatorDeviceController>(logFilePath,
                                                         clientStepperLinear,
@@ -108,12 +120,13 @@ std::shared_ptr<IMultiStepperDeviceController> XRayMachineDevicesFactory::create
     // Scanning
     std::shared_ptr<IScanning> clientScanningLinear =
         std::make_shared<ScanningStepper>(clientStepperLinear, clientSensors_, clientPostProcessing_);
+    clientScanningLinear->setScanPointStream(scanPointStream_);
     std::shared_ptr<IScanning> clientScanningRotational =
         std::make_shared<ScanningStepper>(clientStepperRotational, clientSensors_, clientPostProcessing_);
+    clientScanningRotational->setScanPointStream(scanPointStream_);
     // Logger
-    std::filesystem::path logFileDirectoryName = "LogFiles";
     std::filesystem::path logFileName = "SlitDeviceController_logFile.txt";
-    std::filesystem::path logFilePath = clientConfiguration_->getPartialPathUntilKeyName(currentPath_, projectName_) /= logFileDirectoryName /= logFileName;
+    std::filesystem::path logFilePath = projectPaths_->getLogDirectory() / logFileName;
     std::shared_ptr<IMultiStepperDeviceController> clientSlitDeviceController =
         std::make_shared<SlitDeviceController>(logFilePath,
                                                clientStepperLinear,
@@ -133,10 +146,10 @@ std::shared_ptr<ISingleStepperDeviceController> XRayMachineDevicesFactory::creat
     // Scanning
     std::shared_ptr<IScanning> clientScanning =
         std::make_shared<ScanningStepper>(clientStepper, clientSensors_, clientPostProcessing_);
+    clientScanning->setScanPointStream(scanPointStream_);
     // Logger
-    std::filesystem::path logFileDirectoryName = "LogFiles";
     std::filesystem::path logFileName = "XRaySensorDeviceController_logFile.txt";
-    std::filesystem::path logFilePath = clientConfiguration_->getPartialPathUntilKeyName(currentPath_, projectName_) /= logFileDirectoryName /= logFileName;
+    std::filesystem::path logFilePath = projectPaths_->getLogDirectory() / logFileName;
     std::shared_ptr<ISingleStepperDeviceController> clientXRaySensorDeviceController =
         std::make_shared<XRaySensorDeviceController>(logFilePath,
                                                      clientStepper,
@@ -152,10 +165,10 @@ std::shared_ptr<ISingleStepperDeviceController> XRayMachineDevicesFactory::creat
     // Scanning
     std::shared_ptr<IScanning> clientScanning =
         std::make_shared<ScanningStepper>(clientStepper, clientSensors_, clientPostProcessing_);
+    clientScanning->setScanPointStream(scanPointStream_);
     // Logger
-    std::filesystem::path logFileDirectoryName = "LogFiles";
     std::filesystem::path logFileName = "XRaySourceDeviceController_logFile.txt";
-    std::filesystem::path logFilePath = clientConfiguration_->getPartialPathUntilKeyName(currentPath_, projectName_) /= logFileDirectoryName /= logFileName;
+    std::filesystem::path logFilePath = projectPaths_->getLogDirectory() / logFileName;
     std::shared_ptr<ISingleStepperDeviceController> clientXRaySourceDeviceController =
         std::make_shared<XRaySourceDeviceController>(logFilePath,
                                                      clientStepper,
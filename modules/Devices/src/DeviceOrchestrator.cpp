@@ -0,0 +1,113 @@
+/**
+ * @file DeviceOrchestrator.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class running the steps of a procedure involving several devices, in parallel when they do not depend on each other.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "DeviceOrchestrator.hpp"
+
+DeviceOrchestrator::DeviceOrchestrator(std::string name) :
+    name_(std::move(name)) {
+}
+
+size_t DeviceOrchestrator::addStep(Submit submit, const std::string& name, std::function<bool()> command,
+                                   const std::vector<size_t>& dependencies) {
+    for (size_t dependency : dependencies) {
+        if (dependency >= steps_.size()) {  // only the steps added before: the graph cannot have cycles
+            spdlog::error("{}: step '{}' depends on the unknown step {}\n", name_, name, dependency);
+            return steps_.size();
+        }
+    }
+    auto step = std::make_shared<Step>();
+    step->name = name;
+    step->submit = std::move(submit);
+    step->command = std::move(command);
+    step->dependencies = dependencies;
+    steps_.push_back(step);
+    return steps_.size() - 1;
+}
+
+std::vector<std::shared_ptr<DeviceCommand>> DeviceOrchestrator::start() {
+    handles_.clear();
+    for (const std::shared_ptr<Step>& step : steps_) {
+        std::vector<std::shared_ptr<DeviceCommand>> dependencies;
+        for (size_t dependency : step->dependencies) {
+            dependencies.push_back(handles_[dependency]);
+        }
+        std::function<bool()> command = step->command;
+        if (!dependencies.empty()) {
+            command = [name = name_, step, dependencies, pollingPeriod = pollingPeriod_] {  // the orchestrator may be gone
+                if (!waitForDependencies(name, step, dependencies, pollingPeriod)) {
+                    spdlog::warn("{}: step '{}' not run\n", name, step->name);
+                    return false;
+                }
+                return step->command();
+            };
+        }
+        std::shared_ptr<DeviceCommand> handle = step->submit(name_ + ": " + step->name, std::move(command));
+        {
+            std::lock_guard<std::mutex> lock(step->mutex);
+            step->handle = handle;
+        }
+        handles_.push_back(handle);
+    }
+    spdlog::info("{}: {} steps started\n", name_, steps_.size());
+    return handles_;
+}
+
+bool DeviceOrchestrator::wait() const {
+    bool succeeded = !handles_.empty();
+    for (const std::shared_ptr<DeviceCommand>& handle : handles_) {
+        succeeded = handle->wait() && succeeded;
+    }
+    return succeeded;
+}
+
+bool DeviceOrchestrator::isDone() const {
+    for (const std::shared_ptr<DeviceCommand>& handle : handles_) {
+        if (!handle->isDone()) {
+            return false;
+        }
+    }
+    return !handles_.empty();
+}
+
+double DeviceOrchestrator::getProgress() const {
+    if (handles_.empty()) {
+        return 0;
+    }
+    double progress = 0;
+    for (const std::shared_ptr<DeviceCommand>& handle : handles_) {
+        progress += handle->getProgress();
+    }
+    return progress / handles_.size();
+}
+
+size_t DeviceOrchestrator::getStepsCount() const {
+    return steps_.size();
+}
+
+bool DeviceOrchestrator::waitForDependencies(const std::string& name,
+                                             const std::shared_ptr<Step>& step,
+                                             const std::vector<std::shared_ptr<DeviceCommand>>& dependencies,
+                                             std::chrono::milliseconds pollingPeriod) {
+    for (const std::shared_ptr<DeviceCommand>& dependency : dependencies) {
+        while (!dependency->waitFor(pollingPeriod)) {
+            std::lock_guard<std::mutex> lock(step->mutex);
+            if (step->handle && step->handle->isCancelled()) {
+                return false;  // the device of the step has been stopped while waiting
+            }
+        }
+        if (dependency->getState() != CommandState::Succeeded) {
+            spdlog::warn("{}: step '{}' stopped by the failure of '{}'\n", name, step->name, dependency->getName());
+            return false;
+        }
+    }
+    return true;
+}
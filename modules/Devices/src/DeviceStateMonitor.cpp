@@ -0,0 +1,103 @@
+/**
+ * @file DeviceStateMonitor.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class publishing the state of the state machine of a device, read by the other threads without locking.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "DeviceStateMonitor.hpp"
+
+#include <chrono>
+
+namespace {
+
+double now() {
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+DeviceStateMonitor::DeviceStateMonitor(const char* const* stateNames, int statesCount, int initialState) :
+    stateNames_(stateNames),
+    statesCount_(statesCount),
+    state_(initialState),
+    timestamp_(now()) {
+    action_.store(&*actions_.insert("").first);
+}
+
+int DeviceStateMonitor::getState() const {
+    return state_.load(std::memory_order_acquire);
+}
+
+DeviceStateSnapshot DeviceStateMonitor::getSnapshot() const {
+    uint64_t before = 0;
+    uint64_t after = 0;
+    int state = 0;
+    const std::string* action = nullptr;
+    double timestamp = 0;
+    do {
+        before = sequence_.load(std::memory_order_acquire);
+        state = state_.load(std::memory_order_relaxed);
+        action = action_.load(std::memory_order_relaxed);
+        timestamp = timestamp_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence_.load(std::memory_order_relaxed);
+    } while (before != after || before % 2 != 0);  // a snapshot was written meanwhile
+    DeviceStateSnapshot snapshot;
+    snapshot.state = state;
+    snapshot.stateName = state >= 0 && state < statesCount_ ? stateNames_[state] : "Not Defined";
+    snapshot.action = *action;  // the interned names are never modified
+    snapshot.timestamp = timestamp;
+    snapshot.sequence = before / 2;
+    return snapshot;
+}
+
+void DeviceStateMonitor::publish(int state) {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    if (state == state_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    this->write(state, action_.load(std::memory_order_relaxed));
+}
+
+void DeviceStateMonitor::setAction(const std::string& action) {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    const std::string* interned = &*actions_.insert(action).first;
+    if (interned == action_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    this->write(state_.load(std::memory_order_relaxed), interned);
+}
+
+size_t DeviceStateMonitor::addListener(Listener listener) {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    listeners_[nextListenerId_] = std::move(listener);
+    return nextListenerId_++;
+}
+
+void DeviceStateMonitor::removeListener(size_t id) {
+    std::lock_guard<std::mutex> lock(writerMutex_);  // a listener removed is not running and will not be notified
+    listeners_.erase(id);
+}
+
+void DeviceStateMonitor::write(int state, const std::string* action) {
+    const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    state_.store(state, std::memory_order_relaxed);
+    action_.store(action, std::memory_order_relaxed);
+    timestamp_.store(now(), std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+    if (listeners_.empty()) {
+        return;
+    }
+    const DeviceStateSnapshot snapshot = this->getSnapshot();
+    for (const auto& [id, listener] : listeners_) {
+        listener(snapshot);
+    }
+}
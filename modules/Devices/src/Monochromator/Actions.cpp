@@ -38,7 +38,7 @@ Actions::Actions(std::shared_ptr<IMotor> clientStepper1Linear,
                                                                                                 "MONOCHROMATOR_STAGE_ROTATIONAL",
                                                                                                 "ALIGNMENT_POSITION")) {
     spdlog::info("cTor Actions Monochromator\n");
-    pathToMonochromatorAlinmentResultsDirectory_ = (clientConfiguration_->getPathToLogFilesDirectory() / monochromatorAlignmentResultsDirectoryName_).string();
+    pathToMonochromatorAlinmentResultsDirectory_ = clientConfiguration_->getPathToLogFilesDirectory() / monochromatorAlignmentResultsDirectoryName_;
 }
 
 Actions::~Actions() {
@@ -121,6 +121,14 @@ bool Actions::stop() {
     }
 }
 
+void Actions::setCancellationCheck(std::function<bool()> isCancelled) {
+    isCancelled_ = std::move(isCancelled);
+}
+
+bool Actions::isCancelled() const {
+    return isCancelled_ && isCancelled_();
+}
+
 float Actions::getStepper1LinearPosition() {
     return clientStepper1Linear_->getPositionUserUnits();
 }
@@ -138,13 +146,10 @@ void Actions::setStepper2RotationalPosition(float stepperPosition) {
 }
 
 bool Actions::moveBothMotors() {
-    bool result_movement_stepper_linear = this->moveCalibratedMotor1Linear();
-    bool result_movement_stepper_rotational = this->moveCalibratedMotor2Rotational();
-    if (result_movement_stepper_linear == true && result_movement_stepper_rotational == true) {
-        return true;
-    } else {
-        return false;
-    }
+    ConcurrentMotion motion("Monochromator");  // the linear and the rotational steppers have separate controllers
+    motion.add("stepper linear", [this] { return this->moveCalibratedMotor1Linear(); });
+    motion.add("stepper rotational", [this] { return this->moveCalibratedMotor2Rotational(); });
+    return motion.run();
 }
 
 bool Actions::alignMonochromator() {
@@ -152,21 +157,21 @@ bool Actions::alignMonochromator() {
         this->moveCalibratedMotor1Linear();  // Move linear motor to predefined position
         bool result_movement;
         /* Setup Result csvs */
-        const std::string pathToResultXAxisFileName = pathToMonochromatorAlinmentResultsDirectory_ + "\\"
-                                                      + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+        const std::string pathToResultXAxisFileName = (pathToMonochromatorAlinmentResultsDirectory_
+                                                      / clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                               clientConfiguration_->getPath(),
                                                                                                               "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
-                                                                                                              "FILENAME_TO_X_ALIGNMENT_POSITION");
-        const std::string pathToResultOmegaAxisFileName = pathToMonochromatorAlinmentResultsDirectory_ + "\\"
-                                                          + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              "FILENAME_TO_X_ALIGNMENT_POSITION")).string();
+        const std::string pathToResultOmegaAxisFileName = (pathToMonochromatorAlinmentResultsDirectory_
+                                                          / clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                                 clientConfiguration_->getPath(),
                                                                                                                 "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                                "FILENAME_TO_OMEGA_ALIGNMENT_POSITION");
-        const std::string pathToResultSlopesXOmegaAxesFileName = pathToMonochromatorAlinmentResultsDirectory_ + "\\"
-                                                                 + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                "FILENAME_TO_OMEGA_ALIGNMENT_POSITION")).string();
+        const std::string pathToResultSlopesXOmegaAxesFileName = (pathToMonochromatorAlinmentResultsDirectory_
+                                                                 / clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                                          clientConfiguration_->getPath(),
                                                                                                                          "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                                         "FILENAME_TO_SLOPES");
+                                                                                                                         "FILENAME_TO_SLOPES")).string();
         clientSensors_->flushCsv(pathToResultXAxisFileName);
         clientSensors_->flushCsv(pathToResultOmegaAxisFileName);
         clientSensors_->flushCsv(pathToResultSlopesXOmegaAxesFileName);
@@ -220,7 +225,15 @@ bool Actions::alignMonochromator() {
             if (!result_movement && !clientScanning1Linear_->checkReachingPosition(clientStepper1Linear_->getPositionUserUnits(), stepper1LinearPosition_)) {
                     return false;
             }
+            if (this->isCancelled()) {
+                spdlog::warn("X-Omega alignment interrupted by a stop\n");
+                return false;
+            }
             clientScanning2Rotational_->scan();  // Omega Scan
+            if (this->isCancelled()) {  // the scan has been stopped: its data log is not analysed
+                spdlog::warn("X-Omega alignment interrupted by a stop\n");
+                return false;
+            }
 
             std::string string_stepper1LinearPosition = std::to_string(stepper1LinearPosition_);
             clientPostProcessing_->executeScript5(pathToMonochromatorRotationalAlignmentScript_string,
@@ -238,22 +251,11 @@ bool Actions::alignMonochromator() {
         }  // end for
         /* Read new linear and rotational positions and update .ini file */
         centerLinearPosition_ = clientSensors_->readCsvResult(pathToResultXAxisFileName);  // Read Monochromator crystal X-Axis center position from .csv file after scans
-        int result_writeLinearAlignmentPosition = clientConfiguration_->writeConfigurationFile(std::to_string(centerLinearPosition_),
-                                                                                               "MONOCHROMATOR_STAGE_LINEAR",
-                                                                                               "ALIGNMENT_POSITION",
-                                                                                               clientConfiguration_->getConfigFilename(),
-                                                                                               clientConfiguration_->getPath());
-        if (result_writeLinearAlignmentPosition == 0) {
-            return false;
-        }
-
         centerRotationalPosition_ = clientSensors_->readCsvResult(pathToResultOmegaAxisFileName);  // Read Monochromator crystal Omega-Axis alignment position from .csv file after scans
-        int result_writeRotationalAlignmentPosition = clientConfiguration_->writeConfigurationFile(std::to_string(centerRotationalPosition_),
-                                                                                                   "MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                   "ALIGNMENT_POSITION",
-                                                                                                   clientConfiguration_->getConfigFilename(),
-                                                                                                   clientConfiguration_->getPath());
-        if (result_writeRotationalAlignmentPosition == 0) {
+        ConfigurationTransaction alignmentPositions(clientConfiguration_, clientConfiguration_->getConfigFilename(), clientConfiguration_->getPath());
+        alignmentPositions.set("MONOCHROMATOR_STAGE_LINEAR", "ALIGNMENT_POSITION", centerLinearPosition_)
+                          .set("MONOCHROMATOR_STAGE_ROTATIONAL", "ALIGNMENT_POSITION", centerRotationalPosition_);
+        if (alignmentPositions.commit() == 0) {  // both positions or none
             return false;
         }
     }
@@ -279,11 +281,11 @@ bool Actions::searchMonochromatorBraggPeak() {
         return false;
     }
     // Setup .csv result
-    std::string pathToResultMonochromatorBraggPeakSearch = pathToMonochromatorAlinmentResultsDirectory_ + "\\"
-                                                           + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+    std::string pathToResultMonochromatorBraggPeakSearch = (pathToMonochromatorAlinmentResultsDirectory_
+                                                           / clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                                    clientConfiguration_->getPath(),
                                                                                                                    "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                                   "FILENAME_TO_ALIGNMENT_POSITION");
+                                                                                                                   "FILENAME_TO_ALIGNMENT_POSITION")).string();
     clientSensors_->flushCsv(pathToResultMonochromatorBraggPeakSearch);  // Erase content
     // Bragg Peak search Script variables
     std::filesystem::path SearchMonochromatorBraggPeakScriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
@@ -7,12 +7,19 @@
  *  ===============================================================================================
  */
 
+#include <iterator>
 #include <string>
 
 #include "MonochromatorDeviceController.hpp"
 
 namespace monochromator {
 
+namespace {
+
+const char* const kMonochromatorStatusNames[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
+
+}  // namespace
+
 MonochromatorDeviceController::MonochromatorDeviceController(std::filesystem::path logFilePath,
                                                              std::shared_ptr<IMotor> clientStepper1Linear,
                                                              std::shared_ptr<IMotor> clientStepper2Rotational,
@@ -32,8 +39,16 @@ MonochromatorDeviceController::MonochromatorDeviceController(std::filesystem::pa
     scanningPtr1Linear_(clientScanning1Linear),
     scanningPtr2Rotational_(clientScanning2Rotational),
     clientConfiguration_(clientConfiguration),
-    sMachine_(System(actionsPtr_)) {
+    sMachine_(System(actionsPtr_)),
+    stateMonitor_(kMonochromatorStatusNames, std::size(kMonochromatorStatusNames), static_cast<int>(MonochromatorStatus::NotInitialized)),
+    commandQueue_("Monochromator") {
     spdlog::info("cTor MonochromatorDeviceController\n");
+    commandQueue_.setObserver([this](const std::string& name, bool running) {
+        stateMonitor_.setAction(running ? name : "");  // the command is published with the state
+    });
+    actionsPtr_->setCancellationCheck([this] {
+        return commandQueue_.isCancelled();  // the multi-step actions end before their next step when stopped
+    });
 }
 
 MonochromatorDeviceController::~MonochromatorDeviceController() {
@@ -41,38 +56,44 @@ MonochromatorDeviceController::~MonochromatorDeviceController() {
 }
 
 bool MonochromatorDeviceController::start() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
-        sMachine_.process_event(eventInitialize{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
+    return commandQueue_.run("start", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
+            this->processEvent(eventInitialize{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
 
-    return true;
+        return true;
+    });
 }
 
 bool MonochromatorDeviceController::disconnectStp() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventDisconnect{});
-    }
-    if (!sMachine_.is(state<systemNotInitialized>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("disconnectStp", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventDisconnect{});
+        }
+        if (!sMachine_.is(state<systemNotInitialized>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool MonochromatorDeviceController::goHome() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventSetupHome{});
-        sMachine_.process_event(eventSetupHome{});
-    }
-    if (!sMachine_.is(state<systemHome>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("goHome", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventSetupHome{});
+            this->processEvent(eventSetupHome{});
+        }
+        if (!sMachine_.is(state<systemHome>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 float MonochromatorDeviceController::getPositionStepperLinear() {
@@ -84,170 +105,184 @@ float MonochromatorDeviceController::getPositionStepperRotational() {
 }
 
 bool MonochromatorDeviceController::moveToPositionStepper1Linear(float position) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        actionsPtr_->setStepper1LinearPosition(position);
-        sMachine_.process_event(eventMoveStepper1LinearToRelativePosition{});
-        sMachine_.process_event(eventMoveStepper1LinearToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("moveToPositionStepper1Linear", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            actionsPtr_->setStepper1LinearPosition(position);
+            this->processEvent(eventMoveStepper1LinearToRelativePosition{});
+            this->processEvent(eventMoveStepper1LinearToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool MonochromatorDeviceController::moveToPositionStepper2Rotational(float position) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        actionsPtr_->setStepper2RotationalPosition(position);
-        sMachine_.process_event(eventMoveStepper2RotationalToRelativePosition{});
-        sMachine_.process_event(eventMoveStepper2RotationalToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("moveToPositionStepper2Rotational", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            actionsPtr_->setStepper2RotationalPosition(position);
+            this->processEvent(eventMoveStepper2RotationalToRelativePosition{});
+            this->processEvent(eventMoveStepper2RotationalToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool MonochromatorDeviceController::scanStepper1Linear(float stepSize, float range, int durationAcquisition, std::string filename, bool eraseCsvContent, bool showPlot) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        scanningPtr1Linear_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
-        sMachine_.process_event(eventStartScanStepper1Linear{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventStartScanStepper1Linear{});  // event that allows to start the scan
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("scanStepper1Linear", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            scanningPtr1Linear_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
+            this->processEvent(eventStartScanStepper1Linear{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventStartScanStepper1Linear{});  // event that allows to start the scan
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool MonochromatorDeviceController::scanStepper2Rotational(float stepSize, float range, int durationAcquisition, std::string filename, bool eraseCsvContent, bool showPlot) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        scanningPtr2Rotational_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
-        sMachine_.process_event(eventStartScanStepper2Rotational{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventStartScanStepper2Rotational{});  // event that allows to start the scan
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("scanStepper2Rotational", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            scanningPtr2Rotational_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
+            this->processEvent(eventStartScanStepper2Rotational{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventStartScanStepper2Rotational{});  // event that allows to start the scan
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool MonochromatorDeviceController::alignSourceWithSensor() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepper2RotationalPosition(0);
-        actionsPtr_->setStepper1LinearPosition(0);
-        sMachine_.process_event(eventAlignSourceWithSensor{});
-        sMachine_.process_event(eventAlignSourceWithSensor{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("alignSourceWithSensor", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepper2RotationalPosition(0);
+            actionsPtr_->setStepper1LinearPosition(0);
+            this->processEvent(eventAlignSourceWithSensor{});
+            this->processEvent(eventAlignSourceWithSensor{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool MonochromatorDeviceController::alignMonochromator(bool searchCenter) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setSearchCenter(searchCenter);
-        /* Initial Position */
-        actionsPtr_->setStepper1LinearPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                    clientConfiguration_->getPath(),
-                                                                                                    "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
-                                                                                                    "START_POSITION"));
-
-        /*--- Alignment Parameters ---*/
-        scanningPtr1Linear_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
-                                                                                                          "STEP_SIZE"),
-                                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                            clientConfiguration_->getPath(),
-                                                                                                            "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
-                                                                                                            "RANGE"),
-                                                      clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                            clientConfiguration_->getPath(),
-                                                                                                            "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
-                                                                                                            "DURATION_ACQUISITION"),
-                                                      clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                            clientConfiguration_->getPath(),
-                                                                                                            "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
-                                                                                                            "DATA_LOG_FILENAME"),
-                                                      clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                            clientConfiguration_->getPath(),
-                                                                                                            "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
-                                                                                                            "ERASE_CSV_CONTENT"),
-                                                      false);
-
-        scanningPtr2Rotational_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                          "STEP_SIZE"),
+    return commandQueue_.run("alignMonochromator", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setSearchCenter(searchCenter);
+            /* Initial Position */
+            actionsPtr_->setStepper1LinearPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                        clientConfiguration_->getPath(),
+                                                                                                        "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
+                                                                                                        "START_POSITION"));
+
+            /*--- Alignment Parameters ---*/
+            scanningPtr1Linear_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
+                                                                                                              "STEP_SIZE"),
                                                           clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                               clientConfiguration_->getPath(),
-                                                                                                               "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                               "RANGE"),
+                                                                                                                clientConfiguration_->getPath(),
+                                                                                                                "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
+                                                                                                                "RANGE"),
                                                           clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                             clientConfiguration_->getPath(),
-                                                                                                             "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                             "DURATION_ACQUISITION"),
+                                                                                                                clientConfiguration_->getPath(),
+                                                                                                                "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
+                                                                                                                "DURATION_ACQUISITION"),
                                                           clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                                 clientConfiguration_->getPath(),
-                                                                                                                "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                                "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
                                                                                                                 "DATA_LOG_FILENAME"),
                                                           clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                clientConfiguration_->getPath(),
+                                                                                                                "1st_Linear_Alignment_MONOCHROMATOR_STAGE_LINEAR",
+                                                                                                                "ERASE_CSV_CONTENT"),
+                                                          false);
+
+            scanningPtr2Rotational_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                               clientConfiguration_->getPath(),
                                                                                                               "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                              "ERASE_CSV_CONTENT"),
-                                                      false);
+                                                                                                              "STEP_SIZE"),
+                                                              clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                   clientConfiguration_->getPath(),
+                                                                                                                   "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                                   "RANGE"),
+                                                              clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                 clientConfiguration_->getPath(),
+                                                                                                                 "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                                 "DURATION_ACQUISITION"),
+                                                              clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                    clientConfiguration_->getPath(),
+                                                                                                                    "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                                    "DATA_LOG_FILENAME"),
+                                                              clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                  clientConfiguration_->getPath(),
+                                                                                                                  "2nd_Linear_Alignment_MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                                  "ERASE_CSV_CONTENT"),
+                                                          false);
 
-        sMachine_.process_event(eventAlignMonochromator{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventAlignMonochromator{});  // event that allows to start the scan
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+            this->processEvent(eventAlignMonochromator{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventAlignMonochromator{});  // event that allows to start the scan
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool MonochromatorDeviceController::searchMonochromatorBraggPeak() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepper2RotationalPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                                    clientConfiguration_->getPath(),
-                                                                                                    "MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                    "THETA"));
-        scanningPtr2Rotational_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                          "STEP_SIZE"),
-                                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                               clientConfiguration_->getPath(),
-                                                                                                               "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                               "RANGE"),
-                                                          clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                             clientConfiguration_->getPath(),
-                                                                                                             "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                             "DURATION_ACQUISITION"),
-                                                          clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                                clientConfiguration_->getPath(),
-                                                                                                                "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                                "DATA_LOG_FILENAME"),
-                                                          clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+    return commandQueue_.run("searchMonochromatorBraggPeak", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepper2RotationalPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                                        clientConfiguration_->getPath(),
+                                                                                                        "MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                        "THETA"));
+            scanningPtr2Rotational_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                               clientConfiguration_->getPath(),
                                                                                                               "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
-                                                                                                              "ERASE_CSV_CONTENT"),
-                                                          false);
-        sMachine_.process_event(eventSearchMonochromatorBraggPeak{});
-        sMachine_.process_event(eventSearchMonochromatorBraggPeak{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+                                                                                                              "STEP_SIZE"),
+                                                              clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                   clientConfiguration_->getPath(),
+                                                                                                                   "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                                   "RANGE"),
+                                                              clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                 clientConfiguration_->getPath(),
+                                                                                                                 "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                                 "DURATION_ACQUISITION"),
+                                                              clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                    clientConfiguration_->getPath(),
+                                                                                                                    "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                                    "DATA_LOG_FILENAME"),
+                                                              clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                  clientConfiguration_->getPath(),
+                                                                                                                  "Bragg_Peak_Search_MONOCHROMATOR_STAGE_ROTATIONAL",
+                                                                                                                  "ERASE_CSV_CONTENT"),
+                                                              false);
+            this->processEvent(eventSearchMonochromatorBraggPeak{});
+            this->processEvent(eventSearchMonochromatorBraggPeak{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool MonochromatorDeviceController::alignSlit(bool searchCenter) {
@@ -261,10 +296,11 @@ bool MonochromatorDeviceController::alignSlit(bool searchCenter) {
     return true;
 }
 
-bool MonochromatorDeviceController::stop() {
+bool MonochromatorDeviceController::stopMovement(bool interrupted) {
     using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventStopMovement{});
+    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) ||
+        (interrupted && sMachine_.is(state<systemError>))) {  // the interrupted action has failed
+        this->processEvent(eventStopMovement{});
     }
     if (!sMachine_.is(state<systemConnected>)) {
         return false;
@@ -272,6 +308,23 @@ bool MonochromatorDeviceController::stop() {
     return true;
 }
 
+bool MonochromatorDeviceController::stop() {
+    if (commandQueue_.isWorkerThread()) {
+        return this->stopMovement(false);
+    }
+    return this->submitStop()->wait();
+}
+
+std::shared_ptr<DeviceCommand> MonochromatorDeviceController::submitCommand(const std::string& name, std::function<bool()> command) {
+    return commandQueue_.submit(name, [command](DeviceCommand&) { return command(); });
+}
+
+std::shared_ptr<DeviceCommand> MonochromatorDeviceController::submitStop() {
+    return commandQueue_.preempt("stop",
+                                 [this](DeviceCommand& command) { return this->stopMovement(command.hasInterrupted()); },
+                                 [this] { actionsPtr_->stop(); });  // ends the scan running on the worker thread
+}
+
 bool MonochromatorDeviceController::logger(std::string filename) {
     auto logger = spdlog::rotating_logger_mt(filename, logFilePath_.string(), max_size, max_files);
     spdlog::set_default_logger(logger);
@@ -279,13 +332,28 @@ bool MonochromatorDeviceController::logger(std::string filename) {
 }
 
 std::string MonochromatorDeviceController::getFsmState() {
-    static const char *EnumCrystalStatusStrings[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
-    std::string temp = EnumCrystalStatusStrings[static_cast<int>(this->getStatus())];
+    std::string temp = kMonochromatorStatusNames[stateMonitor_.getState()];
     spdlog::debug("MonochromatorDeviceController FSM state is: {}\n", temp);
     return temp;
 }
 
+DeviceStateSnapshot MonochromatorDeviceController::getStateSnapshot() {
+    return stateMonitor_.getSnapshot();
+}
+
+size_t MonochromatorDeviceController::addStateListener(DeviceStateMonitor::Listener listener) {
+    return stateMonitor_.addListener(std::move(listener));
+}
+
+void MonochromatorDeviceController::removeStateListener(size_t id) {
+    stateMonitor_.removeListener(id);
+}
+
 MonochromatorStatus MonochromatorDeviceController::getStatus() {
+    return static_cast<MonochromatorStatus>(stateMonitor_.getState());
+}
+
+MonochromatorStatus MonochromatorDeviceController::readStatus() {
     using namespace boost::sml;  // NOLINT
     if (sMachine_.is(state<systemNotInitialized>)) {
         monochromatorStatus_ = MonochromatorStatus::NotInitialized;
@@ -0,0 +1,298 @@
+/**
+ * @file RecipeEngine.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class running measurement recipes: sequences of device actions described in a file.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "RecipeEngine.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+namespace {
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+std::string trim(const std::string& text) {
+    const size_t first = text.find_first_not_of(" \t");
+    if (first == std::string::npos) {
+        return "";
+    }
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        item = toLower(trim(item));
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+}  // namespace
+
+bool loadRecipe(const std::filesystem::path& pathToRecipeFile, Recipe& recipe) {
+    mINI::INIFile file(pathToRecipeFile.string());
+    mINI::INIStructure ini;
+    if (!std::filesystem::exists(pathToRecipeFile) || !file.read(ini)) {
+        spdlog::error("Recipe {} not found\n", pathToRecipeFile.string());
+        return false;
+    }
+    recipe = Recipe();
+    recipe.name = ini.has("RECIPE") && ini["RECIPE"].has("NAME") ? ini["RECIPE"]["NAME"] : pathToRecipeFile.stem().string();
+    for (const auto& [section, keys] : ini) {  // the sections keep the order of the file
+        if (section == "recipe") {
+            continue;
+        }
+        RecipeStep step;
+        step.name = section;
+        for (const auto& [key, value] : keys) {
+            if (key == "action") {
+                step.action = toLower(trim(value));
+            } else if (key != "depends_on") {
+                step.parameters[key] = trim(value);
+            }
+        }
+        if (keys.has("depends_on")) {
+            std::vector<std::string> dependencies = splitList(keys.get("depends_on"));
+            if (dependencies != std::vector<std::string>{"none"}) {
+                step.dependencies = dependencies;
+            }
+        } else if (!recipe.steps.empty()) {
+            step.dependencies.push_back(recipe.steps.back().name);  // by default the steps form a sequence
+        }
+        recipe.steps.push_back(step);
+    }
+    spdlog::info("Recipe '{}' loaded: {} steps\n", recipe.name, recipe.steps.size());
+    return true;
+}
+
+RecipeEngine::RecipeEngine(std::filesystem::path pathToProgressDirectory) :
+    pathToProgressDirectory_(std::move(pathToProgressDirectory)),
+    analysisQueue_("Recipe analysis") {
+}
+
+void RecipeEngine::registerAnalysis(const std::string& name, RecipeAction action) {
+    this->registerAction(name, RecipeActionKind::Analysis, &analysisQueue_,
+                         [this](const std::string& commandName, std::function<bool()> command) {
+                           return analysisQueue_.submit(commandName, [command](DeviceCommand&) { return command(); });
+                         }, std::move(action));
+}
+
+void RecipeEngine::registerAction(const std::string& name, RecipeActionKind kind, const void* resource,
+                                  DeviceOrchestrator::Submit submit, RecipeAction action) {
+    RegisteredAction registered;
+    registered.kind = kind;
+    registered.resource = resource;
+    registered.submit = std::move(submit);
+    registered.action = std::move(action);
+    actions_[toLower(name)] = std::move(registered);
+}
+
+bool RecipeEngine::validate(const Recipe& recipe) const {
+    bool valid = true;
+    if (recipe.steps.empty()) {
+        spdlog::error("Recipe '{}' has no steps\n", recipe.name);
+        valid = false;
+    }
+    std::set<std::string> previousSteps;
+    for (const RecipeStep& step : recipe.steps) {
+        if (previousSteps.count(step.name)) {
+            spdlog::error("Recipe '{}': step '{}' defined twice\n", recipe.name, step.name);
+            valid = false;
+        }
+        auto registered = actions_.find(step.action);
+        if (registered == actions_.end()) {
+            spdlog::error("Recipe '{}': step '{}' runs the unknown action '{}'\n", recipe.name, step.name, step.action);
+            valid = false;
+        } else {
+            const RecipeAction& action = registered->second.action;
+            bool parametersFound = true;
+            for (const std::string& parameter : action.requiredParameters) {
+                if (!step.parameters.count(parameter)) {
+                    spdlog::error("Recipe '{}': step '{}' misses the parameter '{}'\n", recipe.name, step.name, parameter);
+                    parametersFound = false;
+                }
+            }
+            if (parametersFound && action.validate && !action.validate(step.parameters)) {
+                spdlog::error("Recipe '{}': invalid parameters of step '{}'\n", recipe.name, step.name);
+                parametersFound = false;
+            }
+            valid = valid && parametersFound;
+        }
+        for (const std::string& dependency : step.dependencies) {
+            if (!previousSteps.count(dependency)) {  // only the previous steps: the graph cannot have cycles
+                spdlog::error("Recipe '{}': step '{}' depends on '{}', which is not a previous step\n",
+                              recipe.name, step.name, dependency);
+                valid = false;
+            }
+        }
+        previousSteps.insert(step.name);
+    }
+    return valid;
+}
+
+double RecipeEngine::estimateDuration(const Recipe& recipe) const {
+    std::shared_ptr<Progress> progress = this->loadProgress(recipe);
+    std::vector<double> finish(recipe.steps.size(), 0);
+    std::map<const void*, double> busyUntil;  // each device runs one action at a time
+    double duration = 0;
+    for (size_t index = 0; index < recipe.steps.size(); index++) {
+        const RecipeStep& step = recipe.steps[index];
+        double start = 0;
+        for (size_t dependency : getDependencies(recipe, index)) {
+            start = std::max(start, finish[dependency]);
+        }
+        auto registered = actions_.find(step.action);
+        if (registered == actions_.end()) {
+            continue;
+        }
+        const void* resource = registered->second.resource;
+        start = std::max(start, busyUntil[resource]);
+        double stepDuration = 0;
+        if (!progress->completed.count(step.name) && registered->second.action.estimate) {
+            stepDuration = registered->second.action.estimate(step.parameters);
+        }
+        finish[index] = start + stepDuration;
+        busyUntil[resource] = finish[index];
+        duration = std::max(duration, finish[index]);
+    }
+    return duration;
+}
+
+std::vector<std::shared_ptr<DeviceCommand>> RecipeEngine::start(const Recipe& recipe) {
+    handles_.clear();
+    if (!this->validate(recipe)) {
+        return handles_;
+    }
+    std::shared_ptr<Progress> progress = this->loadProgress(recipe);
+    if (!progress->completed.empty()) {
+        spdlog::info("Recipe '{}': resuming, {} of {} steps already completed\n",
+                     recipe.name, progress->completed.size(), recipe.steps.size());
+    }
+    spdlog::info("Recipe '{}': estimated duration {:.0f} s\n", recipe.name, this->estimateDuration(recipe));
+    DeviceOrchestrator orchestrator(recipe.name);
+    for (size_t index = 0; index < recipe.steps.size(); index++) {
+        const RecipeStep& step = recipe.steps[index];
+        const RegisteredAction& registered = actions_.at(step.action);
+        std::function<bool()> command;
+        if (progress->completed.count(step.name)) {
+            command = [name = recipe.name, step = step.name] {
+                spdlog::info("Recipe '{}': step '{}' already completed. Skipped.\n", name, step);
+                return true;
+            };
+        } else {
+            command = [run = registered.action.run, parameters = step.parameters, step = step.name, progress] {
+                if (!run(parameters)) {
+                    return false;
+                }
+                progress->complete(step);
+                return true;
+            };
+        }
+        orchestrator.addStep(registered.submit, step.name, std::move(command), getDependencies(recipe, index));
+    }
+    handles_ = orchestrator.start();
+    return handles_;
+}
+
+bool RecipeEngine::wait() const {
+    bool succeeded = !handles_.empty();
+    for (const std::shared_ptr<DeviceCommand>& handle : handles_) {
+        succeeded = handle->wait() && succeeded;
+    }
+    return succeeded;
+}
+
+std::filesystem::path RecipeEngine::getPathToProgressFile(const Recipe& recipe) const {
+    std::string filename = recipe.name;
+    std::replace_if(filename.begin(), filename.end(), [](unsigned char c) { return !std::isalnum(c); }, '_');
+    return pathToProgressDirectory_ / (filename + "_progress.ini");
+}
+
+std::shared_ptr<RecipeEngine::Progress> RecipeEngine::loadProgress(const Recipe& recipe) const {
+    auto progress = std::make_shared<Progress>();
+    progress->path = this->getPathToProgressFile(recipe);
+    progress->name = recipe.name;
+    progress->fingerprint = getFingerprint(recipe);
+    progress->stepsCount = recipe.steps.size();
+    mINI::INIFile file(progress->path.string());
+    mINI::INIStructure ini;
+    if (!std::filesystem::exists(progress->path) || !file.read(ini)) {
+        return progress;
+    }
+    if (ini["RECIPE"]["FINGERPRINT"] != progress->fingerprint) {
+        spdlog::warn("Progress file {} belongs to a different recipe. Starting from the first step.\n", progress->path.string());
+        return progress;
+    }
+    const mINI::INIMap<std::string>& completed = ini["COMPLETED"];
+    for (const RecipeStep& step : recipe.steps) {
+        if (completed.has(step.name) && completed.get(step.name) == "1") {
+            progress->completed.insert(step.name);
+        }
+    }
+    return progress;
+}
+
+std::vector<size_t> RecipeEngine::getDependencies(const Recipe& recipe, size_t index) {
+    std::vector<size_t> dependencies;
+    for (const std::string& dependency : recipe.steps[index].dependencies) {
+        for (size_t previous = 0; previous < index; previous++) {
+            if (recipe.steps[previous].name == dependency) {
+                dependencies.push_back(previous);
+                break;
+            }
+        }
+    }
+    return dependencies;
+}
+
+std::string RecipeEngine::getFingerprint(const Recipe& recipe) {
+    std::string description = recipe.name;
+    for (const RecipeStep& step : recipe.steps) {
+        description += ";" + step.name + ":" + step.action;
+        for (const auto& [key, value] : step.parameters) {
+            description += "," + key + "=" + value;
+        }
+        for (const std::string& dependency : step.dependencies) {
+            description += ",<" + dependency;
+        }
+    }
+    return std::to_string(std::hash<std::string>{}(description));
+}
+
+void RecipeEngine::Progress::complete(const std::string& step) {
+    std::lock_guard<std::mutex> lock(mutex);
+    completed.insert(step);
+    if (completed.size() == stepsCount) {
+        std::error_code errorCode;
+        std::filesystem::remove(path, errorCode);  // recipe completed: the next run starts from the first step
+        spdlog::info("Recipe '{}' completed\n", name);
+        return;
+    }
+    mINI::INIFile file(path.string());
+    mINI::INIStructure ini;
+    ini["RECIPE"]["NAME"] = name;
+    ini["RECIPE"]["FINGERPRINT"] = fingerprint;
+    for (const std::string& completedStep : completed) {
+        ini["COMPLETED"][completedStep] = "1";
+    }
+    if (!file.generate(ini)) {
+        spdlog::error("Progress of recipe '{}' not saved in {}\n", name, path.string());
+    }
+}
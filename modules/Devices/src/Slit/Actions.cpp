@@ -36,7 +36,7 @@ Actions::Actions(std::shared_ptr<IMotor> clientStepper1Linear,
                                                                                                 "SLIT_STAGE_ROTATIONAL",
                                                                                                 "ALIGNMENT_POSITION")) {
     spdlog::info("cTor Actions Slit\n");
-    pathToSlitAlinmentResultsDirectory_ = (clientConfiguration_->getPathToLogFilesDirectory() / slitAlignmentResultsDirectoryName_).string();
+    pathToSlitAlinmentResultsDirectory_ = clientConfiguration_->getPathToLogFilesDirectory() / slitAlignmentResultsDirectoryName_;
 }
 
 Actions::~Actions() {
@@ -119,6 +119,14 @@ bool Actions::stop() {
     }
 }
 
+void Actions::setCancellationCheck(std::function<bool()> isCancelled) {
+    isCancelled_ = std::move(isCancelled);
+}
+
+bool Actions::isCancelled() const {
+    return isCancelled_ && isCancelled_();
+}
+
 float Actions::getStepper1LinearPosition() {
     return clientStepper1Linear_->getPositionUserUnits();
 }
@@ -137,13 +145,10 @@ void Actions::setStepper2RotationalPosition(float stepperPosition) {
 
 bool Actions::moveBothMotors() {
     spdlog::info("Method moveBothMotors of class Actions\n");
-    bool result_movement_stepper_linear = this->moveCalibratedMotor1Linear();
-    bool result_movement_stepper_rotational = this->moveCalibratedMotor2Rotational();
-    if (result_movement_stepper_linear == true && result_movement_stepper_rotational == true) {
-        return true;
-    } else {
-        return false;
-    }
+    ConcurrentMotion motion("Slit");  // the linear and the rotational steppers have separate controllers
+    motion.add("stepper linear", [this] { return this->moveCalibratedMotor1Linear(); });
+    motion.add("stepper rotational", [this] { return this->moveCalibratedMotor2Rotational(); });
+    return motion.run();
 }
 
 bool Actions::alignDevice() {
@@ -164,23 +169,23 @@ bool Actions::alignDevice() {
         std::filesystem::path pathToSlitLinearAlignmentScript = pathToScriptDirectory / slitLinearAlignmentScriptName;
         const std::string pathToSlitLinearAlignmentScript_string = pathToSlitLinearAlignmentScript.string();
         /* Setup .csvs results */
-        const std::string pathToResultXAxisPositionSlitFileName = pathToSlitAlinmentResultsDirectory_ + "\\"
-                                                                  + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+        const std::string pathToResultXAxisPositionSlitFileName = (pathToSlitAlinmentResultsDirectory_
+                                                                  / clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                                           clientConfiguration_->getPath(),
                                                                                                                           "Linear_Alignment_SLIT_STAGE_LINEAR",
-                                                                                                                          "FILENAME_LINEAR_ALIGNMENT_POSITION");
+                                                                                                                          "FILENAME_LINEAR_ALIGNMENT_POSITION")).string();
         clientSensors_->flushCsv(pathToResultXAxisPositionSlitFileName);  // Erase content
-        const std::string pathToResultRotationalAxisPositionSlitFileName = pathToSlitAlinmentResultsDirectory_ + "\\"
-                                                                           + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+        const std::string pathToResultRotationalAxisPositionSlitFileName = (pathToSlitAlinmentResultsDirectory_
+                                                                           / clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                                                    clientConfiguration_->getPath(),
                                                                                                                                    "Rotational_Alignment_SLIT_STAGE_ROTATIONAL",
-                                                                                                                                   "FILENAME_ROTATIONAL_ALIGNMENT_POSITION");
+                                                                                                                                   "FILENAME_ROTATIONAL_ALIGNMENT_POSITION")).string();
         clientSensors_->flushCsv(pathToResultRotationalAxisPositionSlitFileName);  // Erase content
-        const std::string pathToResultSlitAlignmentFileName = pathToSlitAlinmentResultsDirectory_ + "\\"
-                                                              + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+        const std::string pathToResultSlitAlignmentFileName = (pathToSlitAlinmentResultsDirectory_
+                                                              / clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                                       clientConfiguration_->getPath(),
                                                                                                                       "Rotational_Alignment_SLIT_STAGE_ROTATIONAL",
-                                                                                                                      "FILENAME_FWHM");
+                                                                                                                      "FILENAME_FWHM")).string();
         clientSensors_->flushCsv(pathToResultSlitAlignmentFileName);  // Erase content
         const float startOffset = clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                       clientConfiguration_->getPath(),
@@ -200,7 +205,15 @@ bool Actions::alignDevice() {
             if (!result_movement && !clientScanning1Linear_->checkReachingPosition(clientStepper2Rotational_->getPositionUserUnits(), stepper2RotationalPosition_)) {
                     return false;
             }
+            if (this->isCancelled()) {
+                spdlog::warn("Rotational alignment interrupted by a stop\n");
+                return false;
+            }
             clientScanning1Linear_->scan();  // Linear axis scan
+            if (this->isCancelled()) {  // the scan has been stopped: its data log is not analysed
+                spdlog::warn("Rotational alignment interrupted by a stop\n");
+                return false;
+            }
             std::string string_stepper2RotationalPosition = std::to_string(clientStepper2Rotational_->getPositionUserUnits());
             const std::string dataLogFileName = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                       clientConfiguration_->getPath(),
@@ -218,22 +231,11 @@ bool Actions::alignDevice() {
         }
         /* Read new rotational positions and update .ini file */
         centerLinearPosition_ = clientSensors_->readCsvResult(pathToResultXAxisPositionSlitFileName);
-        int result_writeLinearAlignmentPosition = clientConfiguration_->writeConfigurationFile(std::to_string(centerLinearPosition_),
-                                                                                               "SLIT_STAGE_LINEAR",
-                                                                                               "ALIGNMENT_POSITION",
-                                                                                               clientConfiguration_->getConfigFilename(),
-                                                                                               clientConfiguration_->getPath());
-        if (result_writeLinearAlignmentPosition == 0) {
-            return false;
-        }
-
         centerRotationalPosition_ = clientSensors_->readCsvResult(pathToResultRotationalAxisPositionSlitFileName);
-        int result_writeRotationalAlignmentPosition = clientConfiguration_->writeConfigurationFile(std::to_string(centerRotationalPosition_),
-                                                                                                   "SLIT_STAGE_ROTATIONAL",
-                                                                                                   "ALIGNMENT_POSITION",
-                                                                                                   clientConfiguration_->getConfigFilename(),
-                                                                                                   clientConfiguration_->getPath());
-        if (result_writeRotationalAlignmentPosition == 0) {
+        ConfigurationTransaction alignmentPositions(clientConfiguration_, clientConfiguration_->getConfigFilename(), clientConfiguration_->getPath());
+        alignmentPositions.set("SLIT_STAGE_LINEAR", "ALIGNMENT_POSITION", centerLinearPosition_)
+                          .set("SLIT_STAGE_ROTATIONAL", "ALIGNMENT_POSITION", centerRotationalPosition_);
+        if (alignmentPositions.commit() == 0) {  // both positions or none
             return false;
         }
     }
@@ -10,12 +10,19 @@
  * 
  */
 
+#include <iterator>
 #include <string>
 
 #include "SlitDeviceController.hpp"
 
 namespace slit {
 
+namespace {
+
+const char* const kSlitStatusNames[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
+
+}  // namespace
+
 SlitDeviceController::SlitDeviceController(std::filesystem::path logFilePath,
                                            std::shared_ptr<IMotor> clientStepper1Linear,
                                            std::shared_ptr<IMotor> clientStepper2Rotational,
@@ -35,8 +42,16 @@ SlitDeviceController::SlitDeviceController(std::filesystem::path logFilePath,
     scanningPtr1Linear_(clientScanning1Linear),
     scanningPtr2Rotational_(clientScanning2Rotational),
     clientConfiguration_(clientConfiguration),
-    sMachine_(System(actionsPtr_)) {
+    sMachine_(System(actionsPtr_)),
+    stateMonitor_(kSlitStatusNames, std::size(kSlitStatusNames), static_cast<int>(SlitStatus::NotInitialized)),
+    commandQueue_("Slit") {
     spdlog::info("cTor SlitDeviceController\n");
+    commandQueue_.setObserver([this](const std::string& name, bool running) {
+        stateMonitor_.setAction(running ? name : "");  // the command is published with the state
+    });
+    actionsPtr_->setCancellationCheck([this] {
+        return commandQueue_.isCancelled();  // the multi-step actions end before their next step when stopped
+    });
 }
 
 
@@ -45,38 +60,44 @@ SlitDeviceController::~SlitDeviceController() {
 }
 
 bool SlitDeviceController::start() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
-        sMachine_.process_event(eventInitialize{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
+    return commandQueue_.run("start", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
+            this->processEvent(eventInitialize{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
 
-    return true;
+        return true;
+    });
 }
 
 bool SlitDeviceController::disconnectStp() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventDisconnect{});
-    }
-    if (!sMachine_.is(state<systemNotInitialized>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("disconnectStp", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventDisconnect{});
+        }
+        if (!sMachine_.is(state<systemNotInitialized>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool SlitDeviceController::goHome() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventSetupHome{});
-        sMachine_.process_event(eventSetupHome{});
-    }
-    if (!sMachine_.is(state<systemHome>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("goHome", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventSetupHome{});
+            this->processEvent(eventSetupHome{});
+        }
+        if (!sMachine_.is(state<systemHome>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 float SlitDeviceController::getPositionStepperLinear() {
@@ -88,136 +109,164 @@ float SlitDeviceController::getPositionStepperRotational() {
 }
 
 bool SlitDeviceController::moveToPositionStepper1Linear(float position) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        actionsPtr_->setStepper1LinearPosition(position);
-        sMachine_.process_event(eventMoveStepper1LinearToRelativePosition{});
-        sMachine_.process_event(eventMoveStepper1LinearToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("moveToPositionStepper1Linear", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            actionsPtr_->setStepper1LinearPosition(position);
+            this->processEvent(eventMoveStepper1LinearToRelativePosition{});
+            this->processEvent(eventMoveStepper1LinearToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool SlitDeviceController::moveToPositionStepper2Rotational(float position) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        actionsPtr_->setStepper2RotationalPosition(position);
-        sMachine_.process_event(eventMoveStepper2RotationalToRelativePosition{});
-        sMachine_.process_event(eventMoveStepper2RotationalToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("moveToPositionStepper2Rotational", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            actionsPtr_->setStepper2RotationalPosition(position);
+            this->processEvent(eventMoveStepper2RotationalToRelativePosition{});
+            this->processEvent(eventMoveStepper2RotationalToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool SlitDeviceController::scanStepper1Linear(float stepSize, float range, int durationAcquisition, std::string filename, bool eraseCsvContent, bool showPlot) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        scanningPtr1Linear_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
-        sMachine_.process_event(eventStartScanStepper1Linear{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventStartScanStepper1Linear{});  // event that allows to start the scan
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("scanStepper1Linear", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            scanningPtr1Linear_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
+            this->processEvent(eventStartScanStepper1Linear{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventStartScanStepper1Linear{});  // event that allows to start the scan
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool SlitDeviceController::scanStepper2Rotational(float stepSize, float range, int durationAcquisition, std::string filename, bool eraseCsvContent, bool showPlot) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        scanningPtr2Rotational_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
-        sMachine_.process_event(eventStartScanStepper2Rotational{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventStartScanStepper2Rotational{});  // event that allows to start the scan
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("scanStepper2Rotational", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            scanningPtr2Rotational_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
+            this->processEvent(eventStartScanStepper2Rotational{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventStartScanStepper2Rotational{});  // event that allows to start the scan
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool SlitDeviceController::alignSourceWithSensor() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepper1LinearPosition(0);
-        actionsPtr_->setStepper2RotationalPosition(0);
-        sMachine_.process_event(eventMoveBothMotors{});
-        sMachine_.process_event(eventMoveBothMotors{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("alignSourceWithSensor", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepper1LinearPosition(0);
+            actionsPtr_->setStepper2RotationalPosition(0);
+            this->processEvent(eventMoveBothMotors{});
+            this->processEvent(eventMoveBothMotors{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool SlitDeviceController::alignMonochromator(bool searchCenter) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepper1LinearPosition(0);
-        actionsPtr_->setStepper2RotationalPosition(0);
-        sMachine_.process_event(eventMoveBothMotors{});
-        sMachine_.process_event(eventMoveBothMotors{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("alignMonochromator", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepper1LinearPosition(0);
+            actionsPtr_->setStepper2RotationalPosition(0);
+            this->processEvent(eventMoveBothMotors{});
+            this->processEvent(eventMoveBothMotors{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool SlitDeviceController::searchMonochromatorBraggPeak() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepper1LinearPosition(0);
-        actionsPtr_->setStepper2RotationalPosition(0);
-        sMachine_.process_event(eventMoveBothMotors{});
-        sMachine_.process_event(eventMoveBothMotors{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("searchMonochromatorBraggPeak", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepper1LinearPosition(0);
+            actionsPtr_->setStepper2RotationalPosition(0);
+            this->processEvent(eventMoveBothMotors{});
+            this->processEvent(eventMoveBothMotors{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool SlitDeviceController::alignSlit(bool alignDevice) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        /* Initial Positions */
-        actionsPtr_->setStepper2RotationalPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                        clientConfiguration_->getPath(),
-                                                                                                        "Rotational_Alignment_SLIT_STAGE_ROTATIONAL",
-                                                                                                        "START_POSITION"));
-        actionsPtr_->setStepper1LinearPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                        clientConfiguration_->getPath(),
-                                                                                                        "Linear_Alignment_SLIT_STAGE_LINEAR",
-                                                                                                        "START_POSITION"));
-        /* Setup Alignment */
-        actionsPtr_->setAlignDevice(alignDevice);
-        scanningPtr1Linear_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                          clientConfiguration_->getPath(),
-                                                                                                          "Linear_Alignment_SLIT_STAGE_LINEAR",
-                                                                                                          "STEP_SIZE"),
-                                                      clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                           clientConfiguration_->getPath(),
-                                                                                                            "Linear_Alignment_SLIT_STAGE_LINEAR",
-                                                                                                            "RANGE"),
-                                                      clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                         clientConfiguration_->getPath(),
-                                                                                                         "Linear_Alignment_SLIT_STAGE_LINEAR",
-                                                                                                         "DURATION_ACQUISITION"),
-                                                      clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+    return commandQueue_.run("alignSlit", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            /* Initial Positions */
+            actionsPtr_->setStepper2RotationalPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                             clientConfiguration_->getPath(),
-                                                                                                            "Linear_Alignment_SLIT_STAGE_LINEAR",
-                                                                                                            "DATA_LOG_FILENAME"),
-                                                      clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                            "Rotational_Alignment_SLIT_STAGE_ROTATIONAL",
+                                                                                                            "START_POSITION"));
+            actionsPtr_->setStepper1LinearPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                             clientConfiguration_->getPath(),
                                                                                                             "Linear_Alignment_SLIT_STAGE_LINEAR",
-                                                                                                            "ERASE_CSV_CONTENT"),
-                                                       false);
-        sMachine_.process_event(eventAlignSlit{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventAlignSlit{});  // event that allows to start the alignment
+                                                                                                            "START_POSITION"));
+            /* Setup Alignment */
+            actionsPtr_->setAlignDevice(alignDevice);
+            scanningPtr1Linear_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                              clientConfiguration_->getPath(),
+                                                                                                              "Linear_Alignment_SLIT_STAGE_LINEAR",
+                                                                                                              "STEP_SIZE"),
+                                                          clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                               clientConfiguration_->getPath(),
+                                                                                                                "Linear_Alignment_SLIT_STAGE_LINEAR",
+                                                                                                                "RANGE"),
+                                                          clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                             clientConfiguration_->getPath(),
+                                                                                                             "Linear_Alignment_SLIT_STAGE_LINEAR",
+                                                                                                             "DURATION_ACQUISITION"),
+                                                          clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                clientConfiguration_->getPath(),
+                                                                                                                "Linear_Alignment_SLIT_STAGE_LINEAR",
+                                                                                                                "DATA_LOG_FILENAME"),
+                                                          clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                                clientConfiguration_->getPath(),
+                                                                                                                "Linear_Alignment_SLIT_STAGE_LINEAR",
+                                                                                                                "ERASE_CSV_CONTENT"),
+                                                           false);
+            this->processEvent(eventAlignSlit{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventAlignSlit{});  // event that allows to start the alignment
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
+}
+
+bool SlitDeviceController::stopMovement(bool interrupted) {
+    using namespace boost::sml;  // NOLINT
+    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) ||
+        (interrupted && sMachine_.is(state<systemError>))) {  // the interrupted action has failed
+        this->processEvent(eventStopMovement{});
     }
     if (!sMachine_.is(state<systemConnected>)) {
         return false;
@@ -226,14 +275,20 @@ bool SlitDeviceController::alignSlit(bool alignDevice) {
 }
 
 bool SlitDeviceController::stop() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventStopMovement{});
+    if (commandQueue_.isWorkerThread()) {
+        return this->stopMovement(false);
     }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return this->submitStop()->wait();
+}
+
+std::shared_ptr<DeviceCommand> SlitDeviceController::submitCommand(const std::string& name, std::function<bool()> command) {
+    return commandQueue_.submit(name, [command](DeviceCommand&) { return command(); });
+}
+
+std::shared_ptr<DeviceCommand> SlitDeviceController::submitStop() {
+    return commandQueue_.preempt("stop",
+                                 [this](DeviceCommand& command) { return this->stopMovement(command.hasInterrupted()); },
+                                 [this] { actionsPtr_->stop(); });  // ends the scan running on the worker thread
 }
 
 bool SlitDeviceController::logger(std::string filename) {
@@ -243,13 +298,28 @@ bool SlitDeviceController::logger(std::string filename) {
 }
 
 std::string SlitDeviceController::getFsmState() {
-    static const char *EnumCrystalStatusStrings[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
-    std::string temp = EnumCrystalStatusStrings[static_cast<int>(this->getStatus())];
+    std::string temp = kSlitStatusNames[stateMonitor_.getState()];
     spdlog::debug("SlitDeviceController FSM state is: {}\n", temp);
     return temp;
 }
 
+DeviceStateSnapshot SlitDeviceController::getStateSnapshot() {
+    return stateMonitor_.getSnapshot();
+}
+
+size_t SlitDeviceController::addStateListener(DeviceStateMonitor::Listener listener) {
+    return stateMonitor_.addListener(std::move(listener));
+}
+
+void SlitDeviceController::removeStateListener(size_t id) {
+    stateMonitor_.removeListener(id);
+}
+
 SlitStatus SlitDeviceController::getStatus() {
+    return static_cast<SlitStatus>(stateMonitor_.getState());
+}
+
+SlitStatus SlitDeviceController::readStatus() {
     using namespace boost::sml;  // NOLINT
     if (sMachine_.is(state<systemNotInitialized>)) {
         slitStatus_ = SlitStatus::NotInitialized;
@@ -10,12 +10,19 @@
  * 
  */
 
+#include <iterator>
 #include <string>
 
 #include "XRaySensorDeviceController.hpp"
 
 namespace xRaySensor {
 
+namespace {
+
+const char* const kXRaySensorStatusNames[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
+
+}  // namespace
+
 XRaySensorDeviceController::XRaySensorDeviceController(std::filesystem::path logFilePath,
                                                        std::shared_ptr<IMotor> clientStepper,
                                                        std::shared_ptr<scanning::IScanning> clientScanning,
@@ -24,8 +31,13 @@ XRaySensorDeviceController::XRaySensorDeviceController(std::filesystem::path log
     actionsPtr_(std::make_shared<Actions>(clientStepper, clientScanning)),
     scanningPtr_(clientScanning),
     sMachine_(System(actionsPtr_)),
-    clientConfiguration_(clientConfiguration) {
+    clientConfiguration_(clientConfiguration),
+    stateMonitor_(kXRaySensorStatusNames, std::size(kXRaySensorStatusNames), static_cast<int>(XRaySensorStatus::NotInitialized)),
+    commandQueue_("X-Ray Sensor") {
     spdlog::info("cTor XRaySensorDeviceController\n");
+    commandQueue_.setObserver([this](const std::string& name, bool running) {
+        stateMonitor_.setAction(running ? name : "");  // the command is published with the state
+    });
 }
 
 
@@ -34,37 +46,43 @@ XRaySensorDeviceController::~XRaySensorDeviceController() {
 }
 
 bool XRaySensorDeviceController::start() {
-     using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
-        sMachine_.process_event(eventInitialize{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("start", [&](DeviceCommand&) {
+         using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
+            this->processEvent(eventInitialize{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySensorDeviceController::disconnectStp() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventDisconnect{});
-    }
-    if (!sMachine_.is(state<systemNotInitialized>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("disconnectStp", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventDisconnect{});
+        }
+        if (!sMachine_.is(state<systemNotInitialized>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySensorDeviceController::goHome() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventSetupHome{});
-        sMachine_.process_event(eventSetupHome{});
-    }
-    if (!sMachine_.is(state<systemHome>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("goHome", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventSetupHome{});
+            this->processEvent(eventSetupHome{});
+        }
+        if (!sMachine_.is(state<systemHome>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 float XRaySensorDeviceController::getPositionStepper() {
@@ -72,24 +90,40 @@ float XRaySensorDeviceController::getPositionStepper() {
 }
 
 bool XRaySensorDeviceController::moveToPositionStepper(float position) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        actionsPtr_->setStepperPosition(position);
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("moveToPositionStepper", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            actionsPtr_->setStepperPosition(position);
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySensorDeviceController::scanStepper(float stepSize, float range, int durationAcquisition, std::string filename, bool eraseCsvContent, bool showPlot) {
+    return commandQueue_.run("scanStepper", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            scanningPtr_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
+            this->processEvent(eventStartScanStepper{});
+            this->processEvent(eventStartScanStepper{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
+}
+
+bool XRaySensorDeviceController::stopMovement(bool interrupted) {
     using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        scanningPtr_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
-        sMachine_.process_event(eventStartScanStepper{});
-        sMachine_.process_event(eventStartScanStepper{});
+    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) ||
+        (interrupted && sMachine_.is(state<systemError>))) {  // the interrupted action has failed
+        this->processEvent(eventStopMovement{});
     }
     if (!sMachine_.is(state<systemConnected>)) {
         return false;
@@ -98,57 +132,69 @@ bool XRaySensorDeviceController::scanStepper(float stepSize, float range, int du
 }
 
 bool XRaySensorDeviceController::stop() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventStopMovement{});
+    if (commandQueue_.isWorkerThread()) {
+        return this->stopMovement(false);
     }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return this->submitStop()->wait();
+}
+
+std::shared_ptr<DeviceCommand> XRaySensorDeviceController::submitCommand(const std::string& name, std::function<bool()> command) {
+    return commandQueue_.submit(name, [command](DeviceCommand&) { return command(); });
+}
+
+std::shared_ptr<DeviceCommand> XRaySensorDeviceController::submitStop() {
+    return commandQueue_.preempt("stop",
+                                 [this](DeviceCommand& command) { return this->stopMovement(command.hasInterrupted()); },
+                                 [this] { actionsPtr_->stop(); });  // ends the scan running on the worker thread
 }
 
 
 bool XRaySensorDeviceController::alignSourceWithSensor(bool searchCenter) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepperPosition(0);  // middle point
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("alignSourceWithSensor", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepperPosition(0);  // middle point
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySensorDeviceController::setupMonochromatorBraggPeakSearch() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepperPosition(0);
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("setupMonochromatorBraggPeakSearch", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepperPosition(0);
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySensorDeviceController::setupForCrystalBraggPeakSearch() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "X-RAY_SENSOR",
-                                                                                             "2THETA"));
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("setupForCrystalBraggPeakSearch", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "X-RAY_SENSOR",
+                                                                                                 "2THETA"));
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySensorDeviceController::logger(std::string filename) {
@@ -158,13 +204,28 @@ bool XRaySensorDeviceController::logger(std::string filename) {
 }
 
 std::string XRaySensorDeviceController::getFsmState() {
-    static const char *EnumCrystalStatusStrings[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
-    std::string temp = EnumCrystalStatusStrings[static_cast<int>(this->getStatus())];
+    std::string temp = kXRaySensorStatusNames[stateMonitor_.getState()];
     spdlog::debug("XRaySensorDeviceController FSM state is: {}\n", temp);
     return temp;
 }
 
+DeviceStateSnapshot XRaySensorDeviceController::getStateSnapshot() {
+    return stateMonitor_.getSnapshot();
+}
+
+size_t XRaySensorDeviceController::addStateListener(DeviceStateMonitor::Listener listener) {
+    return stateMonitor_.addListener(std::move(listener));
+}
+
+void XRaySensorDeviceController::removeStateListener(size_t id) {
+    stateMonitor_.removeListener(id);
+}
+
 XRaySensorStatus XRaySensorDeviceController::getStatus() {
+    return static_cast<XRaySensorStatus>(stateMonitor_.getState());
+}
+
+XRaySensorStatus XRaySensorDeviceController::readStatus() {
     using namespace boost::sml;  // NOLINT
     if (sMachine_.is(state<systemNotInitialized>)) {
         xRaySensorStatus_ = XRaySensorStatus::NotInitialized;
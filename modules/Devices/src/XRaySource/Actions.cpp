@@ -30,7 +30,7 @@ Actions::Actions(std::shared_ptr<IMotor> clientStepper,
                                                                                       "X-RAY_SOURCE",
                                                                                       "ALIGNMENT_POSITION")) {
     spdlog::info("cTor Actions XRaySource\n");
-    pathToXRaySourceAlinmentResultsDirectory_ = (clientConfiguration_->getPathToLogFilesDirectory() / xRaySourceAlignmentResultsDirectoryName_).string();
+    pathToXRaySourceAlinmentResultsDirectory_ = clientConfiguration_->getPathToLogFilesDirectory() / xRaySourceAlignmentResultsDirectoryName_;
 }
 
 Actions::~Actions() {
@@ -110,11 +110,11 @@ bool Actions::alignSourceWithSensor() {
             return false;
         }
         /* Setup .csv result */
-        std::string pathToResultAlignmentScanSourceFileName = pathToXRaySourceAlinmentResultsDirectory_ + "\\"
-                                                              + clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+        std::string pathToResultAlignmentScanSourceFileName = (pathToXRaySourceAlinmentResultsDirectory_
+                                                              / clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                                       clientConfiguration_->getPath(),
                                                                                                                       "XRAY_SOURCE_STAGE_ROTATIONAL",
-                                                                                                                      "FILENAME_TO_ALIGNMENT_POSITION");
+                                                                                                                      "FILENAME_TO_ALIGNMENT_POSITION")).string();
         clientSensors_->flushCsv(pathToResultAlignmentScanSourceFileName);  // Erase content
         std::filesystem::path scriptName = clientConfiguration_->readFileSystemPathFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
                                                                                                          clientConfiguration_->getPath(),
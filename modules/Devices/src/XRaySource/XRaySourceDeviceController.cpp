@@ -10,12 +10,19 @@
  * 
  */
 
+#include <iterator>
 #include <string>
 
 #include "XRaySourceDeviceController.hpp"
 
 namespace xRaySource {
 
+namespace {
+
+const char* const kXRaySourceStatusNames[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
+
+}  // namespace
+
 XRaySourceDeviceController::XRaySourceDeviceController(std::filesystem::path logFilePath,
                                                        std::shared_ptr<IMotor> clientStepper,
                                                        std::shared_ptr<scanning::IScanning> clientScanning,
@@ -26,8 +33,13 @@ XRaySourceDeviceController::XRaySourceDeviceController(std::filesystem::path log
     actionsPtr_(std::make_shared<Actions>(clientStepper, clientScanning, clientSensors, clientConfiguration, clientPostProcessing)),
     scanningPtr_(clientScanning),
     clientConfiguration_(clientConfiguration),
-    sMachine_(System(actionsPtr_)) {
+    sMachine_(System(actionsPtr_)),
+    stateMonitor_(kXRaySourceStatusNames, std::size(kXRaySourceStatusNames), static_cast<int>(XRaySourceStatus::NotInitialized)),
+    commandQueue_("X-Ray Source") {
     spdlog::info("cTor XRaySourceDeviceController\n");
+    commandQueue_.setObserver([this](const std::string& name, bool running) {
+        stateMonitor_.setAction(running ? name : "");  // the command is published with the state
+    });
 }
 
 
@@ -36,38 +48,44 @@ XRaySourceDeviceController::~XRaySourceDeviceController() {
 }
 
 bool XRaySourceDeviceController::start() {
-     using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
-        sMachine_.process_event(eventInitialize{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("start", [&](DeviceCommand&) {
+         using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemNotInitialized>) || sMachine_.is(state<systemError>)) {
+            this->processEvent(eventInitialize{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySourceDeviceController::disconnectStp() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventDisconnect{});
-    }
+    return commandQueue_.run("disconnectStp", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventDisconnect{});
+        }
 
-    if (!sMachine_.is(state<systemNotInitialized>)) {
-        return false;
-    }
-    return true;
+        if (!sMachine_.is(state<systemNotInitialized>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySourceDeviceController::goHome() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventSetupHome{});
-        sMachine_.process_event(eventSetupHome{});
-    }
-    if (!sMachine_.is(state<systemHome>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("goHome", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemInMotion>)) {
+            this->processEvent(eventSetupHome{});
+            this->processEvent(eventSetupHome{});
+        }
+        if (!sMachine_.is(state<systemHome>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 float XRaySourceDeviceController::getPositionStepper() {
@@ -75,90 +93,112 @@ float XRaySourceDeviceController::getPositionStepper() {
 }
 
 bool XRaySourceDeviceController::moveToPositionStepper(float position) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        actionsPtr_->setStepperPosition(position);
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("moveToPositionStepper", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
+            actionsPtr_->setStepperPosition(position);
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySourceDeviceController::scanStepper(float stepSize, float range, int durationAcquisition, std::string filename, bool eraseCsvContent, bool showPlot) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        scanningPtr_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
-        sMachine_.process_event(eventStartScanStepper{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventStartScanStepper{});  // event that allows to start the scan
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("scanStepper", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            scanningPtr_->setupAlignmentParameters(stepSize, range, durationAcquisition, filename, eraseCsvContent, showPlot);
+            this->processEvent(eventStartScanStepper{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventStartScanStepper{});  // event that allows to start the scan
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySourceDeviceController::alignSourceWithSensor(bool searchCenter) {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setSearchCenter(searchCenter);
-        scanningPtr_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                    clientConfiguration_->getPath(),
-                                                                                                    "XRAY_SOURCE_STAGE_ROTATIONAL",
-                                                                                                    "STEP_SIZE"),
-                                               clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                    clientConfiguration_->getPath(),
-                                                                                                    "XRAY_SOURCE_STAGE_ROTATIONAL",
-                                                                                                    "RANGE"),
-                                               clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                    clientConfiguration_->getPath(),
-                                                                                                    "XRAY_SOURCE_STAGE_ROTATIONAL",
-                                                                                                    "DURATION_ACQUISITION"),
-                                               clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                    clientConfiguration_->getPath(),
-                                                                                                    "XRAY_SOURCE_STAGE_ROTATIONAL",
-                                                                                                    "DATA_LOG_FILENAME"),
-                                               clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
-                                                                                                    clientConfiguration_->getPath(),
-                                                                                                    "XRAY_SOURCE_STAGE_ROTATIONAL",
-                                                                                                    "ERASE_CSV_CONTENT"),
-                                               false);
-        sMachine_.process_event(eventAlignSourceWithSensor{});  // event that allows transition to temp state "systemInMotion"
-        sMachine_.process_event(eventAlignSourceWithSensor{});  // event that allows to start the alignment
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("alignSourceWithSensor", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setSearchCenter(searchCenter);
+            scanningPtr_->setupAlignmentParameters(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                        clientConfiguration_->getPath(),
+                                                                                                        "XRAY_SOURCE_STAGE_ROTATIONAL",
+                                                                                                        "STEP_SIZE"),
+                                                   clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                        clientConfiguration_->getPath(),
+                                                                                                        "XRAY_SOURCE_STAGE_ROTATIONAL",
+                                                                                                        "RANGE"),
+                                                   clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                        clientConfiguration_->getPath(),
+                                                                                                        "XRAY_SOURCE_STAGE_ROTATIONAL",
+                                                                                                        "DURATION_ACQUISITION"),
+                                                   clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                        clientConfiguration_->getPath(),
+                                                                                                        "XRAY_SOURCE_STAGE_ROTATIONAL",
+                                                                                                        "DATA_LOG_FILENAME"),
+                                                   clientConfiguration_->readBoolFromConfigurationFile(clientConfiguration_->getAlignmentSettingsConfigFilename(),
+                                                                                                        clientConfiguration_->getPath(),
+                                                                                                        "XRAY_SOURCE_STAGE_ROTATIONAL",
+                                                                                                        "ERASE_CSV_CONTENT"),
+                                                   false);
+            this->processEvent(eventAlignSourceWithSensor{});  // event that allows transition to temp state "systemInMotion"
+            this->processEvent(eventAlignSourceWithSensor{});  // event that allows to start the alignment
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySourceDeviceController::setupMonochromatorBraggPeakSearch() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "X-RAY_SOURCE",
-                                                                                             "2THETA"));
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
-    }
-    return true;
+    return commandQueue_.run("setupMonochromatorBraggPeakSearch", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "X-RAY_SOURCE",
+                                                                                                 "2THETA"));
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
 }
 
 bool XRaySourceDeviceController::setupForCrystalBraggPeakSearch() {
+    return commandQueue_.run("setupForCrystalBraggPeakSearch", [&](DeviceCommand&) {
+        using namespace boost::sml;  // NOLINT
+        if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
+            actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                                 clientConfiguration_->getPath(),
+                                                                                                 "X-RAY_SOURCE",
+                                                                                                 "2THETA"));
+            this->processEvent(eventMoveStepperToRelativePosition{});
+            this->processEvent(eventMoveStepperToRelativePosition{});
+        }
+        if (!sMachine_.is(state<systemConnected>)) {
+            return false;
+        }
+        return true;
+    });
+}
+
+bool XRaySourceDeviceController::stopMovement(bool interrupted) {
     using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) || sMachine_.is(state<systemNotInitialized>)) {
-        actionsPtr_->setStepperPosition(clientConfiguration_->readFloatFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-                                                                                             clientConfiguration_->getPath(),
-                                                                                             "X-RAY_SOURCE",
-                                                                                             "2THETA"));
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
-        sMachine_.process_event(eventMoveStepperToRelativePosition{});
+    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>) ||
+        (interrupted && sMachine_.is(state<systemError>))) {  // the interrupted action has failed
+        this->processEvent(eventStopMovement{});
     }
     if (!sMachine_.is(state<systemConnected>)) {
         return false;
@@ -167,14 +207,20 @@ bool XRaySourceDeviceController::setupForCrystalBraggPeakSearch() {
 }
 
 bool XRaySourceDeviceController::stop() {
-    using namespace boost::sml;  // NOLINT
-    if (sMachine_.is(state<systemConnected>) || sMachine_.is(state<systemHome>) || sMachine_.is(state<systemInMotion>)) {
-        sMachine_.process_event(eventStopMovement{});
-    }
-    if (!sMachine_.is(state<systemConnected>)) {
-        return false;
+    if (commandQueue_.isWorkerThread()) {
+        return this->stopMovement(false);
     }
-    return true;
+    return this->submitStop()->wait();
+}
+
+std::shared_ptr<DeviceCommand> XRaySourceDeviceController::submitCommand(const std::string& name, std::function<bool()> command) {
+    return commandQueue_.submit(name, [command](DeviceCommand&) { return command(); });
+}
+
+std::shared_ptr<DeviceCommand> XRaySourceDeviceController::submitStop() {
+    return commandQueue_.preempt("stop",
+                                 [this](DeviceCommand& command) { return this->stopMovement(command.hasInterrupted()); },
+                                 [this] { actionsPtr_->stop(); });  // ends the scan running on the worker thread
 }
 
 bool XRaySourceDeviceController::logger(std::string filename) {
@@ -184,13 +230,28 @@ bool XRaySourceDeviceController::logger(std::string filename) {
 }
 
 std::string XRaySourceDeviceController::getFsmState() {
-    static const char *EnumCrystalStatusStrings[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
-    std::string temp = EnumCrystalStatusStrings[static_cast<int>(this->getStatus())];
+    std::string temp = kXRaySourceStatusNames[stateMonitor_.getState()];
     spdlog::debug("XRaySourceDeviceController FSM state is: {}\n", temp);
     return temp;
 }
 
+DeviceStateSnapshot XRaySourceDeviceController::getStateSnapshot() {
+    return stateMonitor_.getSnapshot();
+}
+
+size_t XRaySourceDeviceController::addStateListener(DeviceStateMonitor::Listener listener) {
+    return stateMonitor_.addListener(std::move(listener));
+}
+
+void XRaySourceDeviceController::removeStateListener(size_t id) {
+    stateMonitor_.removeListener(id);
+}
+
 XRaySourceStatus XRaySourceDeviceController::getStatus() {
+    return static_cast<XRaySourceStatus>(stateMonitor_.getState());
+}
+
+XRaySourceStatus XRaySourceDeviceController::readStatus() {
     using namespace boost::sml;  // NOLINT
     if (sMachine_.is(state<systemNotInitialized>)) {
         xRaySourceStatus_ = XRaySourceStatus::NotInitialized;
@@ -0,0 +1,97 @@
+/**
+ * @file AlignmentCacheTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the alignment cache of the mounted crystals.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Crystal/AlignmentCache.hpp"
+
+using namespace crystal;  // NOLINT
+
+/**
+ * @struct AlignmentCacheTests
+ * @brief Test fixture called 'AlignmentCacheTests', which inherits from 'testing::Test'.
+ *
+ */
+struct AlignmentCacheTests
+    : public ::testing::Test {
+        void SetUp() override {
+            directory_ = std::filesystem::temp_directory_path() / "AlignmentCacheTests";
+            std::filesystem::create_directories(directory_);
+            pathToCacheFile_ = directory_ / "Alignment_Cache.ini";
+            entry_.pose.CoordX = 1.25;
+            entry_.pose.CoordY = -0.5;
+            entry_.pose.CoordZ = 2;
+            entry_.pose.CoordW = 8.39;
+            entry_.braggPeakRate = 1000;
+            entry_.timestamp = 3600;
+            settings_.toleranceHxpW = 0.01;
+            settings_.minPeakRatio = 0.8;
+            }
+        void TearDown() override {
+            std::filesystem::remove_all(directory_);
+            }
+        std::filesystem::path directory_;  /**< Temporary directory used by the tests. */
+        std::filesystem::path pathToCacheFile_;  /**< Path to the cache file. */
+        AlignmentCacheEntry entry_;  /**< Alignment of the mounted crystal. */
+        AlignmentCacheSettings settings_;  /**< Settings of the cache. */
+};
+
+TEST_F(AlignmentCacheTests, UnidentifiedCrystalIsNotCached) {
+    AlignmentCache cache(pathToCacheFile_);
+    ASSERT_TRUE(AlignmentCache::makeKey("UNDEFINED", "0").empty());
+    ASSERT_FALSE(cache.store(AlignmentCache::makeKey("", "0"), entry_));
+    ASSERT_FALSE(std::filesystem::exists(pathToCacheFile_));
+}
+
+TEST_F(AlignmentCacheTests, StoredAlignmentIsFoundByCrystalAndMount) {
+    AlignmentCache cache(pathToCacheFile_);
+    const std::string key = AlignmentCache::makeKey("STF-103", "holder 2");
+    ASSERT_TRUE(cache.store(key, entry_));
+    ASSERT_TRUE(cache.store(AlignmentCache::makeKey("STF-104", "holder 2"), AlignmentCacheEntry()));
+    AlignmentCacheEntry entry;
+    ASSERT_TRUE(cache.find(key, 7200, 3600, entry));
+    ASSERT_NEAR(1.25, entry.pose.CoordX, 1e-6);
+    ASSERT_NEAR(-0.5, entry.pose.CoordY, 1e-6);
+    ASSERT_NEAR(8.39, entry.pose.CoordW, 1e-6);
+    ASSERT_NEAR(1000, entry.braggPeakRate, 1e-6);
+    ASSERT_FALSE(entry.fineYAlignment);
+    ASSERT_FALSE(cache.find(AlignmentCache::makeKey("STF-103", "holder 1"), 7200, 3600, entry));  // other mount
+}
+
+TEST_F(AlignmentCacheTests, ExpiredAndErasedAlignmentsAreNotFound) {
+    AlignmentCache cache(pathToCacheFile_);
+    const std::string key = AlignmentCache::makeKey("STF-103", "0");
+    ASSERT_TRUE(cache.store(key, entry_));
+    AlignmentCacheEntry entry;
+    ASSERT_FALSE(cache.find(key, 3600 + 7201, 7200, entry));
+    ASSERT_TRUE(cache.find(key, 3600 + 7199, 7200, entry));
+    ASSERT_TRUE(cache.erase(key));
+    ASSERT_FALSE(cache.find(key, 3600, 7200, entry));
+}
+
+TEST_F(AlignmentCacheTests, VerificationPeakConfirmsTheAlignment) {
+    analysis::Peak peak;
+    peak.valid = true;
+    peak.centre = 8.395;
+    peak.value = 1800;  // 2 s per point
+    ASSERT_TRUE(AlignmentCache::isConfirmed(entry_, peak, 2, settings_));
+    peak.centre = 8.41;  // shifted crystal
+    ASSERT_FALSE(AlignmentCache::isConfirmed(entry_, peak, 2, settings_));
+    peak.centre = 8.39;
+    peak.value = 1000;  // weaker peak
+    ASSERT_FALSE(AlignmentCache::isConfirmed(entry_, peak, 2, settings_));
+    peak.valid = false;
+    ASSERT_FALSE(AlignmentCache::isConfirmed(entry_, peak, 1, settings_));
+}
@@ -0,0 +1,63 @@
+/**
+ * @file ConcurrentMotionTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the concurrent movements of the axes of the devices.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ConcurrentMotion.hpp"
+
+/**
+ * @brief Test case that checks that the axes move at the same time: every movement waits for the start of the other one.
+ *
+ */
+TEST(ConcurrentMotionTests, Axes_move_at_the_same_time) {
+    std::promise<void> hexapodStarted;
+    std::promise<void> stepperStarted;
+    std::shared_future<void> hexapodStartedFuture = hexapodStarted.get_future().share();
+    std::shared_future<void> stepperStartedFuture = stepperStarted.get_future().share();
+    ConcurrentMotion motion("Test");
+    motion.add("hexapod", [&] {
+        hexapodStarted.set_value();
+        return stepperStartedFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    });
+    motion.add("stepper", [&] {
+        stepperStarted.set_value();
+        return hexapodStartedFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    });
+    ASSERT_TRUE(motion.run());
+    ASSERT_TRUE(motion.getFailedAxes().empty());
+}
+
+/**
+ * @brief Test case that checks that all the movements end before the failures are reported, also when one throws.
+ *
+ */
+TEST(ConcurrentMotionTests, Failures_of_all_the_axes_are_reported) {
+    bool linearEnded = false;
+    ConcurrentMotion motion("Test");
+    motion.add("stepper linear", [&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        linearEnded = true;
+        return true;
+    });
+    motion.add("stepper rotational", [] { return false; });
+    motion.add("hexapod", []() -> bool { throw std::runtime_error("connection lost"); });
+    ASSERT_FALSE(motion.run());
+    ASSERT_TRUE(linearEnded);
+    ASSERT_EQ((std::vector<std::string>{"stepper rotational", "hexapod"}), motion.getFailedAxes());
+}
@@ -10,11 +10,19 @@
  * 
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "XRayMachineDevicesFactory.hpp"
+#include "RecipeEngine.hpp"
+#include "Crystal/CrystalRecipe.hpp"
 #include "HXPMockConfiguration.hpp"
 #include "StepperMockConfiguration.hpp"
 #include "SensorsMockConfiguration.hpp"
@@ -48,6 +56,15 @@ struct CrystalDeviceTests
             ScanningStepperMockConfig_.configureScanningStepperMock();
             ScanningHXPMockConfig_.configureScanningHXPMock();
             ConfigurationMockConfig_.configureConfigurationMock();
+            ON_CALL(*ConfigurationMockConfig_.getMock(), readFloatFromConfigurationFile(_, _, "Pivot_Point_CRYSTAL_STAGE", "MAX_DISTANCE"))
+                .WillByDefault(Return(50));
+            // At least 3 Bragg peaks are required to estimate the angles
+            ON_CALL(*ConfigurationMockConfig_.getMock(), readFloatFromConfigurationFile(_, _, "Bending_Angle_CRYSTAL_STAGE", "RANGE_SCAN_HXP_Y"))
+                .WillByDefault(Return(0.3));
+            ON_CALL(*ConfigurationMockConfig_.getMock(), readFloatFromConfigurationFile(_, _, "Miscut_Angle_CRYSTAL_STAGE", "RANGE_SCAN_HXP_Y"))
+                .WillByDefault(Return(0.3));
+            ON_CALL(*ConfigurationMockConfig_.getMock(), readFloatFromConfigurationFile(_, _, "Torsion_Angle_CRYSTAL_STAGE", "RANGE_SCAN_HXP_Z"))
+                .WillByDefault(Return(0.3));
             PostProcessingMockConfig_.configurePostProcessingMock();
             sut_.reset(new crystal::CrystalDeviceController(
                 logFilePath,
@@ -61,6 +78,7 @@ struct CrystalDeviceTests
                 ));
             }
         void TearDown() override {
+            std::filesystem::remove_all(std::filesystem::path("test_getPathToLogFilesDirectory") / "CrystalAlignmentResults" / "Archive");
             }
         std::unique_ptr<crystal::CrystalDeviceController> sut_;  /**< System Under Test (SUT) - unique pointer to CrystalDeviceController Class. */
         HXPMockConfiguration HXPMockConfig_;
@@ -143,7 +161,13 @@ TEST_F(CrystalDeviceTests, CrystalDeviceController_Y_Alignment) {
     sut_->getFsmState();
     ASSERT_TRUE(sut_->goHome());
     sut_->getFsmState();
+    ON_CALL(*ConfigurationMockConfig_.getMock(), readBoolFromConfigurationFile(_, _, "Pivot_Point_CRYSTAL_STAGE", "ENABLED"))
+        .WillByDefault(Return(false));  // the YW-axes alignment is skipped about the pivot point
+    const std::filesystem::path resultStdDev = std::filesystem::temp_directory_path() / "Result_Standard_Deviation_Slopes_Crystal.csv";
+    std::ofstream(resultStdDev) << "Standard Deviation of slopes\n0.05\n";  // as written by SearchCrystalYWAxesAlignment.py
+    ON_CALL(*SensorsMockConfig_.getMock(), readResult(_, 0)).WillByDefault(Return(ResultFile(resultStdDev.string())));
     ASSERT_TRUE(sut_->yWAxesAlignmentCrystal());
+    std::filesystem::remove(resultStdDev);
     ASSERT_EQ("Connected", sut_->getFsmState());
     sut_->getFsmState();
     ASSERT_TRUE(sut_->yAxisFineAlignmentCrystal());
@@ -153,6 +177,57 @@ TEST_F(CrystalDeviceTests, CrystalDeviceController_Y_Alignment) {
     sut_->getFsmState();
 }
 
+TEST_F(CrystalDeviceTests, CrystalDeviceController_YW_Alignment_Standard_Deviation_Not_Found) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    ON_CALL(*ConfigurationMockConfig_.getMock(), readBoolFromConfigurationFile(_, _, "Pivot_Point_CRYSTAL_STAGE", "ENABLED"))
+        .WillByDefault(Return(false));  // the YW-axes alignment is skipped about the pivot point
+    // The result file of the script is not readable: a missing standard deviation must not pass the threshold
+    ASSERT_FALSE(sut_->yWAxesAlignmentCrystal());
+}
+
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Y_Alignment_Invalid_Settings) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    ON_CALL(*ConfigurationMockConfig_.getMock(), readFloatFromConfigurationFile(_, _, "yAxis_Alignment_CRYSTAL_STAGE", "STEP_SIZE_W"))
+        .WillByDefault(Return(0));  // the loop on the W axis would not terminate
+    EXPECT_CALL(*ScanningHXPMockConfig_.getMock(), scanRelative()).Times(0);
+    EXPECT_CALL(*ScanningStepperMockConfig_.getMock(), scanRelative()).Times(0);
+    ASSERT_FALSE(sut_->yAxisAlignmentCrystal());
+}
+
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Y_Alignment_Verifies_Cache_Once) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    // Identified crystal with a cached alignment that the verification scan rejects (Bragg peak far from the cached angle)
+    ON_CALL(*ConfigurationMockConfig_.getMock(), hasKey(_, _, _, _)).WillByDefault(Return(1));
+    const std::filesystem::path cacheFile = std::filesystem::path("test_getPathToLogFilesDirectory") / "CrystalAlignmentResults" /
+                                            "Alignment_Cache.ini";
+    std::filesystem::remove(cacheFile);
+    AlignmentCacheEntry entry;
+    entry.pose.CoordW = 100;
+    entry.stepperPosition = 0.1f;  // START_POSITION_STEPPER
+    entry.braggPeakRate = 1000;
+    entry.timestamp = MeasurementIndex::now();
+    ASSERT_TRUE(AlignmentCache(cacheFile).store(AlignmentCache::makeKey("test_read_string", "test_read_string"), entry));
+    std::atomic<int> scans(0);
+    auto countScan = [&scans] {
+        scans++;
+        return true;
+    };
+    ON_CALL(*ScanningStepperMockConfig_.getMock(), scan()).WillByDefault(testing::Invoke(countScan));
+    ON_CALL(*ScanningHXPMockConfig_.getMock(), scan()).WillByDefault(testing::Invoke(countScan));
+    ON_CALL(*ScanningStepperMockConfig_.getMock(), scanRelative()).WillByDefault(Return(true));
+    ON_CALL(*ScanningHXPMockConfig_.getMock(), scanRelative()).WillByDefault(Return(true));
+    ASSERT_TRUE(sut_->yAxisAlignmentCrystal());
+    // 1 verification scan, then 1 X scan for each of the 2 steps of the W axis
+    EXPECT_EQ(3, scans);
+    std::filesystem::remove(cacheFile);
+}
+
 TEST_F(CrystalDeviceTests, CrystalDeviceController_Z_Alignment) {
     spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
     ASSERT_TRUE(sut_->start());
@@ -203,4 +278,215 @@ TEST_F(CrystalDeviceTests, CrystalDeviceController_Torsion_Measurement) {
     sut_->getFsmState();
     ASSERT_TRUE(sut_->disconnect());
     sut_->getFsmState();
-}
\ No newline at end of file
+}
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Bending_Measurement_Invalid_Settings) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    ON_CALL(*ConfigurationMockConfig_.getMock(), readFloatFromConfigurationFile(_, _, "Bending_Angle_CRYSTAL_STAGE", "STEP_SIZE_SCAN_HXP_Y"))
+        .WillByDefault(Return(0));
+    EXPECT_CALL(*HXPMockConfig_.getMock(), setPositionAbsolute(_, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(*StepperMockConfig_.getMock(), moveCalibratedMotor(_)).Times(0);
+    ASSERT_FALSE(sut_->bendingAngleMeasurement());
+}
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Bending_Measurement_Not_Estimated) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    ON_CALL(*ConfigurationMockConfig_.getMock(), readFloatFromConfigurationFile(_, _, "Bending_Angle_CRYSTAL_STAGE", "RANGE_SCAN_HXP_Y"))
+        .WillByDefault(Return(0.1));  // 2 Bragg peaks
+    std::vector<MeasurementRecord> records;
+    ON_CALL(*SensorsMockConfig_.getMock(), recordMeasurement(_))
+        .WillByDefault(testing::Invoke([&records](MeasurementRecord record) {
+            records.push_back(record);
+            return true;
+        }));
+    ASSERT_FALSE(sut_->bendingAngleMeasurement());
+    ASSERT_FALSE(records.empty());
+    ASSERT_EQ("Bending_Angle_CRYSTAL_STAGE", records.back().type);
+    ASSERT_FALSE(records.back().completed);
+    ASSERT_TRUE(records.back().resultPath.empty());
+    ASSERT_TRUE(records.back().result.empty());
+    std::filesystem::remove(std::filesystem::path("test_getPathToLogFilesDirectory") / "CrystalAlignmentResults" /
+                            "Bending_Angle_CRYSTAL_STAGE_checkpoint.ini");  // all steps completed
+}
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Bending_Measurement_Is_Archived) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    std::vector<MeasurementRecord> records;
+    ON_CALL(*SensorsMockConfig_.getMock(), recordMeasurement(_))
+        .WillByDefault(testing::Invoke([&records](MeasurementRecord record) {
+            records.push_back(record);
+            return true;
+        }));
+    ASSERT_TRUE(sut_->bendingAngleMeasurement());
+    ASSERT_FALSE(records.empty());
+    ASSERT_TRUE(records.back().completed);
+    // The index refers to copies that the next measurement does not overwrite
+    const std::filesystem::path resultPath(records.back().resultPath);
+    ASSERT_EQ("Archive", resultPath.parent_path().filename());
+    ASSERT_TRUE(std::filesystem::exists(resultPath));
+    const std::string peaks = "PEAKS=";
+    const size_t peaksPosition = records.back().parameters.find(peaks);
+    ASSERT_NE(std::string::npos, peaksPosition);
+    const std::filesystem::path peaksPath(records.back().parameters.substr(peaksPosition + peaks.size()));
+    ASSERT_EQ("Archive", peaksPath.parent_path().filename());
+    ASSERT_NE(resultPath, peaksPath);
+}
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Bending_Measurement_Steps_Keep_Their_Order) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    // The checkpoint and the bending angle pair the peaks with the steps by index: the poses are visited in their order
+    std::vector<double> positionsY;
+    ON_CALL(*HXPMockConfig_.getMock(), setPositionAbsolute(_, _, _, _, _, _))
+        .WillByDefault(testing::Invoke([this, &positionsY](double coordX, double coordY, double coordZ,
+                                                           double coordU, double coordV, double coordW) {
+            positionsY.push_back(coordY);
+            return HXPMockConfig_.moveAbsolute(coordX, coordY, coordZ, coordU, coordV, coordW);
+        }));
+    ASSERT_TRUE(sut_->bendingAngleMeasurement());
+    ASSERT_GE(positionsY.size(), 4u);
+    ASSERT_TRUE(std::is_sorted(positionsY.begin(), positionsY.end()));
+}
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Bending_Measurement_Pivot_Point) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    EXPECT_CALL(*HXPMockConfig_.getMock(), setToolCoordinateSystem(_, _, _, _, _, _)).Times(2);  // pivot point set and restored
+    ASSERT_TRUE(sut_->bendingAngleMeasurement());
+}
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Bending_Measurement_Pivot_Point_Not_Set) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    ON_CALL(*HXPMockConfig_.getMock(), setToolCoordinateSystem(_, _, _, _, _, _)).WillByDefault(Return(1));
+    EXPECT_CALL(*ScanningHXPMockConfig_.getMock(), scan()).Times(0);
+    ASSERT_FALSE(sut_->bendingAngleMeasurement());
+}
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Bending_Measurement_Configuration_Snapshot) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    ASSERT_EQ(0u, sut_->getConfigurationVersion());
+    EXPECT_CALL(*ConfigurationMockConfig_.getMock(), takeSnapshot()).Times(1);
+    ON_CALL(*ConfigurationMockConfig_.getMock(), getConfigurationVersion()).WillByDefault(Return(7));
+    sut_->bendingAngleMeasurement();
+    ASSERT_EQ(7u, sut_->getConfigurationVersion());
+}
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Failed_Action_Runs_Once) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    // The scan of the X alignment fails: the action must not be run again by the guard of the transition to systemError
+    ON_CALL(*ScanningStepperMockConfig_.getMock(), scan()).WillByDefault(Return(false));
+    EXPECT_CALL(*ScanningStepperMockConfig_.getMock(), scan()).Times(1);
+    ASSERT_FALSE(sut_->xAxisAlignmentCrystal());
+    ASSERT_EQ("Error", sut_->getFsmState());
+    // Successful actions are run once as well
+    EXPECT_CALL(*HXPMockConfig_.getMock(), connect(_, _)).Times(1);
+    ASSERT_TRUE(sut_->start());
+    ASSERT_EQ("Connected", sut_->getFsmState());
+}
+
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Stop_Preempts_Running_Command) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    // The scan runs until it is stopped and then fails, as the scans of class ScanningHXP and ScanningStepper
+    std::atomic<bool> stopped(false);
+    auto scanUntilStopped = [&stopped] {
+        while (!stopped) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    };
+    auto stopScan = [&stopped] {
+        stopped = true;
+        return true;
+    };
+    ON_CALL(*ScanningStepperMockConfig_.getMock(), scan()).WillByDefault(testing::Invoke(scanUntilStopped));
+    ON_CALL(*ScanningHXPMockConfig_.getMock(), scan()).WillByDefault(testing::Invoke(scanUntilStopped));
+    ON_CALL(*ScanningStepperMockConfig_.getMock(), stop()).WillByDefault(testing::Invoke(stopScan));
+    ON_CALL(*ScanningHXPMockConfig_.getMock(), stop()).WillByDefault(testing::Invoke(stopScan));
+    std::shared_ptr<DeviceCommand> scan = sut_->submitCommand("scan", [this] {
+        return sut_->scanHxp(ICrystalDeviceController::hxpAxis::W, 0.1, 1, 1, "scan.csv", true, false);
+    });
+    std::shared_ptr<DeviceCommand> home = sut_->submitCommand("home", [this] { return sut_->goHome(); });
+    while (scan->getState() == CommandState::Queued) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(CommandState::Running, scan->getState());
+    ASSERT_EQ(CommandState::Queued, home->getState());
+    // The stop interrupts the scan and cancels the queued commands: the failed scan does not leave the device in error
+    ASSERT_TRUE(sut_->stop());
+    ASSERT_TRUE(scan->isDone());
+    EXPECT_EQ(CommandState::Cancelled, scan->getState());
+    EXPECT_FALSE(scan->wait());
+    EXPECT_EQ(CommandState::Cancelled, home->getState());
+    EXPECT_FALSE(home->wait());
+    ASSERT_EQ("Connected", sut_->getFsmState());
+    // The device accepts new commands after the stop
+    std::shared_ptr<DeviceCommand> move = sut_->submitCommand("move", [this] { return sut_->moveToPositionStepper(0.1); });
+    ASSERT_TRUE(move->wait());
+    EXPECT_EQ(CommandState::Succeeded, move->getState());
+    EXPECT_DOUBLE_EQ(1.0, move->getProgress());
+}
+
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Stop_Ends_Multi_Step_Command) {
+    spdlog::set_level(spdlog::level::debug);  // Set global log level to debug
+    ASSERT_TRUE(sut_->start());
+    ASSERT_TRUE(sut_->goHome());
+    ON_CALL(*ConfigurationMockConfig_.getMock(), readFloatFromConfigurationFile(_, _, "Bending_Angle_CRYSTAL_STAGE", "RANGE_SCAN_HXP_Y"))
+        .WillByDefault(Return(0.2));  // 3 steps
+    const std::filesystem::path checkpointFile = std::filesystem::path("test_getPathToLogFilesDirectory") / "CrystalAlignmentResults" /
+                                                 "Bending_Angle_CRYSTAL_STAGE_checkpoint.ini";
+    std::filesystem::remove(checkpointFile);  // left by a previous run: the measurement would be resumed
+    // The scan of the first step completes its last point while the stop is received: the next steps must not run
+    std::atomic<int> scans(0);
+    std::atomic<bool> stopped(false);
+    auto scanUntilStopped = [&scans, &stopped] {
+        scans++;
+        while (!stopped) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    };
+    auto stopScan = [&stopped] {
+        stopped = true;
+        return true;
+    };
+    ON_CALL(*ScanningStepperMockConfig_.getMock(), scan()).WillByDefault(testing::Invoke(scanUntilStopped));
+    ON_CALL(*ScanningHXPMockConfig_.getMock(), scan()).WillByDefault(testing::Invoke(scanUntilStopped));
+    ON_CALL(*ScanningStepperMockConfig_.getMock(), stop()).WillByDefault(testing::Invoke(stopScan));
+    ON_CALL(*ScanningHXPMockConfig_.getMock(), stop()).WillByDefault(testing::Invoke(stopScan));
+    std::shared_ptr<DeviceCommand> measurement = sut_->submitCommand("bendingAngleMeasurement", [this] {
+        return sut_->bendingAngleMeasurement();
+    });
+    while (scans == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(sut_->stop());
+    EXPECT_FALSE(measurement->wait());
+    EXPECT_EQ(CommandState::Cancelled, measurement->getState());
+    EXPECT_EQ(1, scans);
+    ASSERT_EQ("Connected", sut_->getFsmState());
+    EXPECT_TRUE(std::filesystem::exists(checkpointFile));  // the completed step is kept to resume the measurement
+    std::filesystem::remove(checkpointFile);
+}
+TEST_F(CrystalDeviceTests, CrystalDeviceController_Characterisation_Recipe_Is_Valid) {
+    // The recipe shipped with the machine only uses actions registered for the crystal
+    const std::filesystem::path pathToRecipe = std::filesystem::path(__FILE__).parent_path().parent_path().parent_path()
+        .parent_path() / "ConfigurationFiles" / "Recipe_Crystal_Characterisation.ini";
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "CrystalDeviceTests_Recipe";
+    std::shared_ptr<crystal::CrystalDeviceController> crystal(std::move(sut_));
+    RecipeEngine engine(directory);
+    crystal::registerRecipeActions(engine, crystal, ConfigurationMockConfig_.getMock(), directory);
+    Recipe recipe;
+    ASSERT_TRUE(loadRecipe(pathToRecipe, recipe));
+    EXPECT_EQ("Crystal Characterisation", recipe.name);
+    EXPECT_TRUE(engine.validate(recipe));
+    EXPECT_GT(engine.estimateDuration(recipe), 0);
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file DeviceBringUpTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the parallel connection and homing of the devices.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DeviceBringUp.hpp"
+
+/**
+ * @class FakeController
+ * @brief Device controller with its own command queue, whose homing lasts until all the devices are homing.
+ *
+ */
+class FakeController {
+ public:
+  FakeController(std::atomic<int>& homing, int devicesCount, bool connects) :
+      homing_(homing), devicesCount_(devicesCount), connects_(connects), queue_("Fake") {}
+  bool start() {
+    return connects_;
+  }
+  bool goHome() {
+    homing_++;
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (homing_ < devicesCount_) {  // succeeds only if the homings run in parallel
+      if (std::chrono::steady_clock::now() > timeout) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    homed = true;
+    return true;
+  }
+  std::shared_ptr<DeviceCommand> submitCommand(const std::string& name, std::function<bool()> command) {
+    return queue_.submit(name, [command](DeviceCommand&) { return command(); });
+  }
+
+  std::atomic<bool> homed{false};  /**< True once the device has been homed. */
+
+ private:
+  std::atomic<int>& homing_;
+  const int devicesCount_;
+  const bool connects_;
+  DeviceCommandQueue queue_;
+};
+
+/**
+ * @brief Test case that checks that the devices are homed in parallel and that the report contains all of them.
+ *
+ */
+TEST(DeviceBringUpTests, Devices_are_homed_in_parallel) {
+    std::atomic<int> homing(0);
+    auto crystal = std::make_shared<FakeController>(homing, 3, true);
+    auto slit = std::make_shared<FakeController>(homing, 3, true);
+    auto source = std::make_shared<FakeController>(homing, 3, true);
+    DeviceBringUp bringUp;
+    bringUp.addDevice("Crystal", crystal);
+    bringUp.addDevice("Slit", slit);
+    bringUp.addDevice("X-Ray Source", source);
+    EXPECT_DOUBLE_EQ(0.0, bringUp.getDuration());
+    EXPECT_EQ(6u, bringUp.start().size());
+    ASSERT_TRUE(bringUp.wait());
+    EXPECT_TRUE(bringUp.isDone());
+    std::vector<DeviceBringUpReport> report = bringUp.getReport();
+    ASSERT_EQ(3u, report.size());
+    EXPECT_EQ("Slit", report[1].device);
+    for (const DeviceBringUpReport& device : report) {
+        EXPECT_EQ(CommandState::Succeeded, device.connection);
+        EXPECT_EQ(CommandState::Succeeded, device.homing);
+        EXPECT_GE(device.homingTime, 0.0);
+    }
+    EXPECT_GE(bringUp.getDuration(), report[0].homingTime);
+}
+
+/**
+ * @brief Test case that checks that a device failing to connect is not homed, without stopping the other devices.
+ *
+ */
+TEST(DeviceBringUpTests, Failed_connection_skips_the_homing) {
+    std::atomic<int> homing(0);
+    auto crystal = std::make_shared<FakeController>(homing, 1, false);
+    auto slit = std::make_shared<FakeController>(homing, 1, true);
+    DeviceBringUp bringUp;
+    bringUp.addDevice("Crystal", crystal);
+    bringUp.addDevice("Slit", slit);
+    bringUp.start();
+    EXPECT_FALSE(bringUp.wait());
+    std::vector<DeviceBringUpReport> report = bringUp.getReport();
+    EXPECT_EQ(CommandState::Failed, report[0].connection);
+    EXPECT_EQ(CommandState::Failed, report[0].homing);
+    EXPECT_FALSE(crystal->homed);
+    EXPECT_EQ(CommandState::Succeeded, report[1].homing);
+    EXPECT_TRUE(slit->homed);
+}
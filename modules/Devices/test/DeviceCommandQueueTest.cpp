@@ -0,0 +1,138 @@
+/**
+ * @file DeviceCommandQueueTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the queue of the commands of the devices.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DeviceCommandQueue.hpp"
+
+/**
+ * @brief Test case that checks that the commands run in submission order, all on the worker thread.
+ *
+ */
+TEST(DeviceCommandQueueTests, Commands_run_in_order_on_the_worker_thread) {
+    DeviceCommandQueue queue("Test");
+    std::vector<int> order;
+    std::vector<std::thread::id> threads;
+    std::vector<std::shared_ptr<DeviceCommand>> commands;
+    for (int index = 0; index < 10; index++) {
+        commands.push_back(queue.submit("command " + std::to_string(index), [&, index](DeviceCommand& command) {
+            command.setProgress(0.5);
+            order.push_back(index);
+            threads.push_back(std::this_thread::get_id());
+            return index % 2 == 0;
+        }));
+    }
+    for (int index = 0; index < 10; index++) {
+        EXPECT_EQ(index % 2 == 0, commands[index]->wait());
+        EXPECT_EQ(index % 2 == 0 ? CommandState::Succeeded : CommandState::Failed, commands[index]->getState());
+        EXPECT_DOUBLE_EQ(1.0, commands[index]->getProgress());
+    }
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), order);
+    for (const std::thread::id& thread : threads) {
+        EXPECT_EQ(threads.front(), thread);
+    }
+    EXPECT_NE(std::this_thread::get_id(), threads.front());
+    EXPECT_EQ(0u, queue.getPendingCommands());
+}
+
+/**
+ * @brief Test case that checks that a command can run other commands of the same queue without waiting for itself, and
+ * that an exception thrown by a command fails the command without stopping the queue.
+ *
+ */
+TEST(DeviceCommandQueueTests, Nested_commands_and_exceptions) {
+    DeviceCommandQueue queue("Test");
+    std::shared_ptr<DeviceCommand> outer = queue.submit("outer", [&queue](DeviceCommand&) {
+        return queue.isWorkerThread() && queue.run("inner", [](DeviceCommand&) { return true; });
+    });
+    EXPECT_TRUE(outer->wait());
+    std::shared_ptr<DeviceCommand> failing = queue.submit("failing", [](DeviceCommand&) -> bool {
+        throw std::runtime_error("device not reachable");
+    });
+    EXPECT_FALSE(failing->wait());
+    EXPECT_EQ(CommandState::Failed, failing->getState());
+    EXPECT_TRUE(queue.run("next", [](DeviceCommand&) { return true; }));
+    EXPECT_FALSE(queue.isWorkerThread());
+}
+
+/**
+ * @brief Test case that checks that a preemption cancels the queued commands, interrupts the running one and runs before
+ * the commands submitted after it.
+ *
+ */
+TEST(DeviceCommandQueueTests, Preemption) {
+    DeviceCommandQueue queue("Test");
+    std::atomic<bool> interrupted(false);
+    std::shared_ptr<DeviceCommand> running = queue.submit("scan", [&interrupted](DeviceCommand& command) {
+        while (!interrupted) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return command.isCancelled();
+    });
+    std::shared_ptr<DeviceCommand> queued = queue.submit("move", [](DeviceCommand&) { return true; });
+    while (running->getState() == CommandState::Queued) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_FALSE(running->waitFor(std::chrono::milliseconds(10)));
+    std::shared_ptr<DeviceCommand> stop = queue.preempt("stop", [](DeviceCommand&) { return true; }, [&interrupted] { interrupted = true; });
+    EXPECT_TRUE(interrupted);
+    EXPECT_TRUE(stop->hasInterrupted());
+    EXPECT_EQ(CommandState::Cancelled, queued->getState());
+    EXPECT_TRUE(stop->wait());
+    EXPECT_TRUE(running->wait());  // value returned by the interrupted command
+    EXPECT_EQ(CommandState::Cancelled, running->getState());
+    EXPECT_FALSE(queued->wait());
+    // Without a running command the interrupt is not called
+    interrupted = false;
+    std::shared_ptr<DeviceCommand> idleStop = queue.preempt("stop", [](DeviceCommand&) { return true; }, [&interrupted] { interrupted = true; });
+    EXPECT_TRUE(idleStop->wait());
+    EXPECT_FALSE(interrupted);
+    EXPECT_FALSE(idleStop->hasInterrupted());
+}
+
+/**
+ * @brief Test case that checks that the commands run immediately on the worker thread (the steps of an action) see the
+ * preemption of the running command.
+ *
+ */
+TEST(DeviceCommandQueueTests, Preemption_of_nested_commands) {
+    DeviceCommandQueue queue("Test");
+    std::atomic<bool> started(false);
+    std::atomic<bool> interrupted(false);
+    std::shared_ptr<DeviceCommand> running = queue.submit("measurement", [&](DeviceCommand&) {
+        return queue.run("step", [&](DeviceCommand& step) {
+            bool cancelledBefore = queue.isCancelled();
+            started = true;
+            while (!interrupted) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return !cancelledBefore && !step.isCancelled() && queue.isCancelled();  // the nested handle is not preempted
+        });
+    });
+    while (!started) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::shared_ptr<DeviceCommand> stop = queue.preempt("stop", [&queue](DeviceCommand&) { return !queue.isCancelled(); },
+                                                        [&interrupted] { interrupted = true; });
+    EXPECT_TRUE(running->wait());
+    EXPECT_EQ(CommandState::Cancelled, running->getState());
+    EXPECT_TRUE(stop->wait());  // the stop itself is not preempted
+    EXPECT_FALSE(queue.isCancelled());
+}
@@ -0,0 +1,121 @@
+/**
+ * @file DeviceOrchestratorTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the orchestration of the procedures involving several devices.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DeviceOrchestrator.hpp"
+
+/**
+ * @class FakeDevice
+ * @brief Device with its own command queue, as the device controllers.
+ *
+ */
+class FakeDevice {
+ public:
+  FakeDevice() : queue_("Fake") {}
+  std::shared_ptr<DeviceCommand> submitCommand(const std::string& name, std::function<bool()> command) {
+    return queue_.submit(name, [command](DeviceCommand&) { return command(); });
+  }
+
+ private:
+  DeviceCommandQueue queue_;
+};
+
+/**
+ * @brief Test fixture called 'DeviceOrchestratorTests' with the devices of a beam alignment.
+ *
+ */
+struct DeviceOrchestratorTests : public ::testing::Test {
+    /**
+     * @brief Motion of a device, lasting until all the motions of the stage have started (so it can succeed only if the
+     * motions of the stage run in parallel).
+     *
+     * @param stageSize number of motions of the stage.
+     * @return std::function<bool()> command of the motion.
+     */
+    std::function<bool()> parallelMotion(int stageSize) {
+        return [this, stageSize] {
+            started++;
+            const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (started < stageSize) {
+                if (std::chrono::steady_clock::now() > timeout) {
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            finished++;
+            return true;
+        };
+    }
+
+    std::shared_ptr<FakeDevice> monochromator = std::make_shared<FakeDevice>();  /**< Device moved out of the beam. */
+    std::shared_ptr<FakeDevice> slit = std::make_shared<FakeDevice>();  /**< Device moved out of the beam. */
+    std::shared_ptr<FakeDevice> sensor = std::make_shared<FakeDevice>();  /**< Device moved out of the beam. */
+    std::shared_ptr<FakeDevice> source = std::make_shared<FakeDevice>();  /**< Device aligned once the beam path is clear. */
+    std::atomic<int> started{0};  /**< Number of motions started. */
+    std::atomic<int> finished{0};  /**< Number of motions finished. */
+};
+
+/**
+ * @brief Test case that checks that the independent steps run in parallel and the dependent step after all of them.
+ *
+ */
+TEST_F(DeviceOrchestratorTests, Independent_steps_run_in_parallel) {
+    DeviceOrchestrator orchestrator("Source alignment");
+    std::vector<size_t> beamPathCleared;
+    beamPathCleared.push_back(orchestrator.addStep(monochromator, "move out of beam", parallelMotion(3)));
+    beamPathCleared.push_back(orchestrator.addStep(slit, "move out of beam", parallelMotion(3)));
+    beamPathCleared.push_back(orchestrator.addStep(sensor, "move out of beam", parallelMotion(3)));
+    int finishedBeforeAlignment = -1;
+    orchestrator.addStep(source, "align", [this, &finishedBeforeAlignment] {
+        finishedBeforeAlignment = finished;
+        return true;
+    }, beamPathCleared);
+    ASSERT_EQ(4u, orchestrator.getStepsCount());
+    std::vector<std::shared_ptr<DeviceCommand>> steps = orchestrator.start();
+    ASSERT_EQ(4u, steps.size());
+    ASSERT_TRUE(orchestrator.wait());
+    EXPECT_TRUE(orchestrator.isDone());
+    EXPECT_DOUBLE_EQ(1.0, orchestrator.getProgress());
+    EXPECT_EQ(3, finishedBeforeAlignment);
+}
+
+/**
+ * @brief Test case that checks that a step is not run if one of its dependencies fails, and that the unknown dependencies
+ * are rejected.
+ *
+ */
+TEST_F(DeviceOrchestratorTests, Failed_dependency_stops_the_dependent_steps) {
+    DeviceOrchestrator orchestrator("Source alignment");
+    size_t slitOut = orchestrator.addStep(slit, "move out of beam", [] { return false; });
+    size_t sensorOut = orchestrator.addStep(sensor, "move out of beam", [] { return true; });
+    std::atomic<bool> aligned(false);
+    size_t alignment = orchestrator.addStep(source, "align", [&aligned] {
+        aligned = true;
+        return true;
+    }, {slitOut, sensorOut});
+    EXPECT_EQ(orchestrator.getStepsCount(), orchestrator.addStep(source, "acquire", [] { return true; }, {alignment + 1}));
+    std::vector<std::shared_ptr<DeviceCommand>> steps = orchestrator.start();
+    EXPECT_FALSE(orchestrator.wait());
+    EXPECT_EQ(CommandState::Failed, steps[slitOut]->getState());
+    EXPECT_EQ(CommandState::Succeeded, steps[sensorOut]->getState());
+    EXPECT_EQ(CommandState::Failed, steps[alignment]->getState());
+    EXPECT_FALSE(aligned);
+}
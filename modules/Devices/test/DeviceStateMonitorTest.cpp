@@ -0,0 +1,109 @@
+/**
+ * @file DeviceStateMonitorTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the state published by the devices.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DeviceCommandQueue.hpp"
+#include "DeviceStateMonitor.hpp"
+
+namespace {
+
+const char* const kStateNames[] = { "Not Defined", "Not Initialized", "Connected", "Home", "In Motion", "Error" };
+
+}  // namespace
+
+/**
+ * @brief Test case that checks that the listeners are notified of the changes only, with the name of the state.
+ *
+ */
+TEST(DeviceStateMonitorTests, Listeners_are_notified_of_the_changes) {
+    DeviceStateMonitor monitor(kStateNames, 6, 1);
+    ASSERT_EQ(1, monitor.getState());
+    ASSERT_STREQ("Not Initialized", monitor.getSnapshot().stateName);
+    std::vector<std::string> notified;
+    size_t id = monitor.addListener([&](const DeviceStateSnapshot& snapshot) {
+        notified.push_back(std::string(snapshot.stateName) + "/" + snapshot.action);
+    });
+    monitor.setAction("start");
+    monitor.publish(2);
+    monitor.publish(2);  // no transition
+    monitor.setAction("");
+    monitor.removeListener(id);
+    monitor.publish(4);
+    ASSERT_EQ((std::vector<std::string>{"Not Initialized/start", "Connected/start", "Connected/"}), notified);
+    DeviceStateSnapshot snapshot = monitor.getSnapshot();
+    ASSERT_EQ(4, snapshot.state);
+    ASSERT_STREQ("In Motion", snapshot.stateName);
+    ASSERT_EQ(4u, snapshot.sequence);
+    ASSERT_GT(snapshot.timestamp, 0);
+}
+
+/**
+ * @brief Test case that checks that a reader never gets a snapshot mixing two updates while a writer is publishing.
+ *
+ */
+TEST(DeviceStateMonitorTests, Snapshots_are_consistent_while_the_state_is_published) {
+    DeviceStateMonitor monitor(kStateNames, 6, 1);
+    std::atomic<bool> writing(true);
+    std::thread writer([&] {
+        for (int index = 0; index < 20000; index++) {
+            int state = 2 + index % 3;
+            monitor.setAction(std::string("command ") + kStateNames[state]);  // the action always matches the state
+            monitor.publish(state);
+        }
+        writing = false;
+    });
+    auto stateOfIndex = [](int index) { return index < 0 ? 1 : 2 + index % 3; };
+    int inconsistentSnapshots = 0;
+    uint64_t lastSequence = 0;
+    while (writing) {
+        DeviceStateSnapshot snapshot = monitor.getSnapshot();
+        EXPECT_GE(snapshot.sequence, lastSequence);
+        lastSequence = snapshot.sequence;
+        if (snapshot.sequence == 0) {
+            continue;
+        }
+        // every loop of the writer publishes the action (odd sequence) and then the state (even sequence)
+        int index = static_cast<int>((snapshot.sequence - 1) / 2);
+        int state = stateOfIndex(snapshot.sequence % 2 == 0 ? index : index - 1);
+        if (snapshot.state != state || snapshot.action != std::string("command ") + kStateNames[stateOfIndex(index)]) {
+            inconsistentSnapshots++;
+        }
+    }
+    writer.join();
+    ASSERT_EQ(0, inconsistentSnapshots);
+}
+
+/**
+ * @brief Test case that checks that the queue of the commands publishes the name of the running command.
+ *
+ */
+TEST(DeviceStateMonitorTests, Command_queue_publishes_the_running_command) {
+    DeviceStateMonitor monitor(kStateNames, 6, 1);
+    DeviceCommandQueue queue("Test");
+    queue.setObserver([&](const std::string& name, bool running) { monitor.setAction(running ? name : ""); });
+    std::string action;
+    ASSERT_TRUE(queue.run("goHome", [&](DeviceCommand&) {
+        action = monitor.getSnapshot().action;
+        monitor.publish(3);
+        return true;
+    }));
+    ASSERT_EQ("goHome", action);
+    DeviceStateSnapshot snapshot = monitor.getSnapshot();
+    ASSERT_EQ("", snapshot.action);
+    ASSERT_STREQ("Home", snapshot.stateName);
+}
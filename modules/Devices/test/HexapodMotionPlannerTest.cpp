@@ -0,0 +1,86 @@
+/**
+ * @file HexapodMotionPlannerTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the planning of the movements of the hexapod.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "HXPMock.hpp"
+#include "Crystal/HexapodMotionPlanner.hpp"
+
+using namespace crystal;  // NOLINT
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+/**
+ * @struct HexapodMotionPlannerTests
+ * @brief Test fixture called 'HexapodMotionPlannerTests', which inherits from 'testing::Test'.
+ *
+ */
+struct HexapodMotionPlannerTests
+    : public ::testing::Test {
+        void SetUp() override {
+            hxp_ = std::make_shared<NiceMock<HXPMock>>();
+            settings_.velocityX = settings_.velocityY = settings_.velocityZ = 1;
+            settings_.velocityU = settings_.velocityV = settings_.velocityW = 1;
+            settings_.accelerationX = settings_.accelerationY = settings_.accelerationZ = 1;
+            settings_.accelerationU = settings_.accelerationV = settings_.accelerationW = 1;
+            settings_.settlingTime = 0.5;
+            }
+        HxpPose poseY(double y) {
+            HxpPose pose;
+            pose.CoordY = y;
+            return pose;
+            }
+        std::shared_ptr<NiceMock<HXPMock>> hxp_;  /**< Mock of the hexapod. */
+        HexapodMotionSettings settings_;  /**< Kinematic model of the hexapod. */
+};
+
+TEST_F(HexapodMotionPlannerTests, MoveTimeFollowsTheSlowestAxis) {
+    HexapodMotionPlanner planner(hxp_, settings_);
+    HxpPose start;
+    HxpPose target = poseY(4);  // trapezoidal profile: 4 / 1 + 1 / 1
+    ASSERT_DOUBLE_EQ(5.5, planner.estimateMoveTime(start, target));
+    target.CoordW = 0.25;  // triangular profile: 2 * sqrt(0.25 / 1)
+    ASSERT_DOUBLE_EQ(5.5, planner.estimateMoveTime(start, target));
+    ASSERT_DOUBLE_EQ(1.5, planner.estimateMoveTime(start, poseY(0.25)));
+    ASSERT_DOUBLE_EQ(0, planner.estimateMoveTime(start, start));
+}
+
+TEST_F(HexapodMotionPlannerTests, EveryPoseIsReachedWithOneAbsoluteMovement) {
+    EXPECT_CALL(*hxp_, setHxpCoordinates(_, _, _, _, _, _)).Times(3);
+    EXPECT_CALL(*hxp_, setPositionAbsolute(_, _, _, _, _, _)).Times(3).WillRepeatedly(Return(0));
+    EXPECT_CALL(*hxp_, setPositionAbsolute()).Times(0);
+    HexapodMotionPlanner planner(hxp_, settings_);
+    std::vector<HxpPose> poses = {poseY(3), poseY(1), poseY(2)};
+    poses[1].CoordW = 0.5;
+    std::vector<size_t> visited;
+    ASSERT_TRUE(planner.visit(poses, [&](size_t index, bool moved) {
+        visited.push_back(index);
+        return moved;
+    }));
+    ASSERT_EQ((std::vector<size_t>{0, 1, 2}), visited);  // the steps keep their order
+    const HexapodMotionReport report = planner.getReport();
+    ASSERT_EQ(3, report.moves);
+    ASSERT_EQ(0, report.failedMoves);
+    ASSERT_GT(report.predictedTime, 0);
+}
+
+TEST_F(HexapodMotionPlannerTests, VisitStopsWhenAStepFails) {
+    EXPECT_CALL(*hxp_, setPositionAbsolute(_, _, _, _, _, _)).Times(1).WillOnce(Return(-1));
+    HexapodMotionPlanner planner(hxp_, settings_);
+    ASSERT_FALSE(planner.visit({poseY(1), poseY(2)}, [](size_t, bool moved) { return moved; }));
+    ASSERT_EQ(1, planner.getReport().failedMoves);
+}
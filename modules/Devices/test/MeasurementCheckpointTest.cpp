@@ -0,0 +1,116 @@
+/**
+ * @file MeasurementCheckpointTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the checkpoint of the crystal measurements.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Crystal/MeasurementCheckpoint.hpp"
+
+using namespace crystal;  // NOLINT
+
+/**
+ * @struct MeasurementCheckpointTests
+ * @brief Test fixture called 'MeasurementCheckpointTests', which inherits from 'testing::Test'.
+ *
+ */
+struct MeasurementCheckpointTests
+    : public ::testing::Test {
+        void SetUp() override {
+            directory_ = std::filesystem::temp_directory_path() / "MeasurementCheckpointTests";
+            std::filesystem::create_directories(directory_);
+            pathToCheckpointFile_ = directory_ / "Bending_Angle_CRYSTAL_STAGE_checkpoint.ini";
+            pathToPeaks_ = (directory_ / "peaks.csv").string();
+            parameters_.startPosition = -1.5;
+            parameters_.stepSize = 0.5;
+            parameters_.range = 2;
+            parameters_.initialPose.CoordW = 30.2;
+            }
+        void TearDown() override {
+            std::filesystem::remove_all(directory_);
+            }
+        void appendPeak(const std::string& row) {
+            bool newFile = !std::filesystem::exists(pathToPeaks_);
+            std::ofstream peaksFile(pathToPeaks_, std::ios::app);
+            if (newFile) {
+                peaksFile << "Peak Value (au),Y-Axis Position (mm),W-Axis Position (deg)\n";
+            }
+            peaksFile << row << "\n";
+        }
+        std::filesystem::path directory_;  /**< Temporary directory used by the tests. */
+        std::filesystem::path pathToCheckpointFile_;  /**< Path to the checkpoint file. */
+        std::string pathToPeaks_;  /**< Path to the peaks .csv file. */
+        MeasurementCheckpointParameters parameters_;  /**< Parameters of the measurement. */
+};
+
+TEST_F(MeasurementCheckpointTests, NoCheckpointStartsFromFirstStep) {
+    MeasurementCheckpoint checkpoint(pathToCheckpointFile_, "Bending_Angle_CRYSTAL_STAGE");
+    ASSERT_FALSE(checkpoint.resume(parameters_));
+    ASSERT_EQ(0, checkpoint.getCompletedIterations());
+    ASSERT_FALSE(checkpoint.isIterationCompleted(0));
+}
+
+TEST_F(MeasurementCheckpointTests, ResumeSkipsCompletedSteps) {
+    {
+        MeasurementCheckpoint checkpoint(pathToCheckpointFile_, "Bending_Angle_CRYSTAL_STAGE");
+        checkpoint.resume(parameters_);
+        HxpPose pose = parameters_.initialPose;
+        for (int iteration = 0; iteration < 2; iteration++) {
+            pose.CoordY = parameters_.startPosition + iteration * parameters_.stepSize;
+            appendPeak("100," + std::to_string(pose.CoordY) + ",30.1");
+            ASSERT_TRUE(checkpoint.registerCompletedIteration(iteration, pose.CoordY, pose, pathToPeaks_));
+        }
+        appendPeak("100,-0.5,30.1");  // Step interrupted before being registered
+    }
+    MeasurementCheckpoint checkpoint(pathToCheckpointFile_, "Bending_Angle_CRYSTAL_STAGE");
+    ASSERT_TRUE(checkpoint.resume(parameters_));
+    ASSERT_EQ(2, checkpoint.getCompletedIterations());
+    ASSERT_TRUE(checkpoint.isIterationCompleted(1));
+    ASSERT_FALSE(checkpoint.isIterationCompleted(2));
+    ASSERT_NEAR(-1.0, checkpoint.getLastPose().CoordY, 1e-6);
+    ASSERT_TRUE(checkpoint.restorePartialResults(pathToPeaks_));
+    std::ifstream peaksFile(pathToPeaks_);
+    std::string line;
+    int nLines = 0;
+    while (std::getline(peaksFile, line)) {
+        nLines++;
+    }
+    ASSERT_EQ(3, nLines);  // Header + 2 completed steps
+}
+
+TEST_F(MeasurementCheckpointTests, DifferentParametersStartFromFirstStep) {
+    {
+        MeasurementCheckpoint checkpoint(pathToCheckpointFile_, "Bending_Angle_CRYSTAL_STAGE");
+        checkpoint.resume(parameters_);
+        appendPeak("100,-1.5,30.1");
+        ASSERT_TRUE(checkpoint.registerCompletedIteration(0, -1.5, parameters_.initialPose, pathToPeaks_));
+    }
+    parameters_.stepSize = 0.25;
+    MeasurementCheckpoint checkpoint(pathToCheckpointFile_, "Bending_Angle_CRYSTAL_STAGE");
+    ASSERT_FALSE(checkpoint.resume(parameters_));
+    ASSERT_FALSE(checkpoint.isIterationCompleted(0));
+    MeasurementCheckpoint otherMeasurement(pathToCheckpointFile_, "Torsion_Angle_CRYSTAL_STAGE");
+    ASSERT_FALSE(otherMeasurement.resume(parameters_));
+}
+
+TEST_F(MeasurementCheckpointTests, ClearRemovesCheckpoint) {
+    MeasurementCheckpoint checkpoint(pathToCheckpointFile_, "Bending_Angle_CRYSTAL_STAGE");
+    checkpoint.resume(parameters_);
+    appendPeak("100,-1.5,30.1");
+    ASSERT_TRUE(checkpoint.registerCompletedIteration(0, -1.5, parameters_.initialPose, pathToPeaks_));
+    ASSERT_TRUE(std::filesystem::exists(pathToCheckpointFile_));
+    ASSERT_TRUE(checkpoint.clear());
+    ASSERT_FALSE(std::filesystem::exists(pathToCheckpointFile_));
+    ASSERT_EQ(0, checkpoint.getCompletedIterations());
+}
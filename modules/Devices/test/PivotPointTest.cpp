@@ -0,0 +1,112 @@
+/**
+ * @file PivotPointTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the pivot point of the hexapod on the impact point of the beam.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "HXPMock.hpp"
+#include "Crystal/PivotPoint.hpp"
+
+using namespace crystal;  // NOLINT
+using testing::_;
+using testing::DoAll;
+using testing::DoubleNear;
+using testing::NiceMock;
+using testing::Return;
+using testing::SetArgReferee;
+
+/**
+ * @struct PivotPointTests
+ * @brief Test fixture called 'PivotPointTests', which inherits from 'testing::Test'.
+ *
+ */
+struct PivotPointTests
+    : public ::testing::Test {
+        void SetUp() override {
+            hxp_ = std::make_shared<NiceMock<HXPMock>>();
+            ON_CALL(*hxp_, getCoordinateX()).WillByDefault(Return(10));
+            ON_CALL(*hxp_, getCoordinateY()).WillByDefault(Return(0));
+            ON_CALL(*hxp_, getCoordinateZ()).WillByDefault(Return(0));
+            ON_CALL(*hxp_, getCoordinateW()).WillByDefault(Return(90));
+            settings_.enabled = true;
+            settings_.beamX = 10;
+            settings_.beamY = 5;
+            settings_.beamZ = 2;
+            settings_.maxDistance = 50;
+            }
+        std::shared_ptr<NiceMock<HXPMock>> hxp_;  /**< Mock of the hexapod. */
+        PivotPointSettings settings_;  /**< Position of the beam. */
+};
+
+TEST_F(PivotPointTests, PointIsExpressedInTheToolFrame) {
+    HxpPose pose;
+    pose.CoordX = 1;
+    pose.CoordW = 90;
+    HxpPose point;
+    point.CoordX = 1;
+    point.CoordY = 3;
+    point.CoordZ = 2;
+    HxpPose local = PivotPoint::toToolFrame(pose, point);  // a rotation of 90 deg about Z brings the tool X axis on the work Y axis
+    ASSERT_NEAR(3, local.CoordX, 1e-9);
+    ASSERT_NEAR(0, local.CoordY, 1e-9);
+    ASSERT_NEAR(2, local.CoordZ, 1e-9);
+    pose.CoordW = 0;
+    pose.CoordU = 90;
+    local = PivotPoint::toToolFrame(pose, point);
+    ASSERT_NEAR(0, local.CoordX, 1e-9);
+    ASSERT_NEAR(2, local.CoordY, 1e-9);
+    ASSERT_NEAR(-3, local.CoordZ, 1e-9);
+}
+
+TEST_F(PivotPointTests, ToolIsMovedOnTheBeamAndRestored) {
+    EXPECT_CALL(*hxp_, getToolCoordinateSystem(_, _, _, _, _, _))
+        .WillOnce(DoAll(SetArgReferee<2>(1.5), Return(0)));
+    testing::InSequence sequence;
+    EXPECT_CALL(*hxp_, setToolCoordinateSystem(DoubleNear(5, 1e-9), DoubleNear(0, 1e-9), DoubleNear(3.5, 1e-9), 0, 0, 0))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*hxp_, setToolCoordinateSystem(0, 0, 1.5, 0, 0, 0)).WillOnce(Return(0));
+    PivotPoint pivotPoint(hxp_);
+    ASSERT_TRUE(pivotPoint.activate(settings_));
+    ASSERT_TRUE(pivotPoint.isActive());
+    ASSERT_TRUE(pivotPoint.release());
+    ASSERT_FALSE(pivotPoint.isActive());
+}
+
+TEST_F(PivotPointTests, ToolRotationIsKept) {
+    EXPECT_CALL(*hxp_, getToolCoordinateSystem(_, _, _, _, _, _))
+        .WillOnce(DoAll(SetArgReferee<3>(0.5), SetArgReferee<4>(-1), SetArgReferee<5>(2), Return(0)));
+    testing::InSequence sequence;
+    EXPECT_CALL(*hxp_, setToolCoordinateSystem(_, _, _, 0.5, -1, 2)).WillOnce(Return(0));
+    EXPECT_CALL(*hxp_, setToolCoordinateSystem(0, 0, 0, 0.5, -1, 2)).WillOnce(Return(0));
+    PivotPoint pivotPoint(hxp_);
+    ASSERT_TRUE(pivotPoint.activate(settings_));
+    ASSERT_TRUE(pivotPoint.release());
+}
+
+TEST_F(PivotPointTests, ToolIsRestoredWhenThePivotPointIsDestroyed) {
+    EXPECT_CALL(*hxp_, setToolCoordinateSystem(_, _, _, _, _, _)).Times(2).WillRepeatedly(Return(0));
+    PivotPoint pivotPoint(hxp_);
+    ASSERT_TRUE(pivotPoint.activate(settings_));
+}
+
+TEST_F(PivotPointTests, ToolIsNotMovedFarFromTheCarriage) {
+    EXPECT_CALL(*hxp_, setToolCoordinateSystem(_, _, _, _, _, _)).Times(0);
+    settings_.maxDistance = 1;
+    PivotPoint pivotPoint(hxp_);
+    ASSERT_FALSE(pivotPoint.activate(settings_));
+    settings_.maxDistance = 50;
+    settings_.enabled = false;
+    ASSERT_FALSE(pivotPoint.activate(settings_));
+    ASSERT_FALSE(pivotPoint.isActive());
+}
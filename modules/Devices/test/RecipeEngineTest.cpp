@@ -0,0 +1,180 @@
+/**
+ * @file RecipeEngineTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the validation, the estimate, the execution and the resumption of the recipes.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "RecipeEngine.hpp"
+
+/**
+ * @class FakeStage
+ * @brief Device with its own command queue, as the device controllers.
+ *
+ */
+class FakeStage {
+ public:
+  FakeStage() : queue_("Fake") {}
+  std::shared_ptr<DeviceCommand> submitCommand(const std::string& name, std::function<bool()> command) {
+    return queue_.submit(name, [command](DeviceCommand&) { return command(); });
+  }
+
+ private:
+  DeviceCommandQueue queue_;
+};
+
+/**
+ * @struct RecipeEngineTests
+ * @brief Test fixture called 'RecipeEngineTests' with an engine running a fake stage.
+ *
+ */
+struct RecipeEngineTests : public ::testing::Test {
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "RecipeEngineTests";
+        std::filesystem::create_directories(directory_);
+        engine_ = std::make_unique<RecipeEngine>(directory_);
+        engine_->registerMotion("scan", stage_, {{"duration"}, [this](const RecipeParameters&) {
+            return ++scans_ != failingScan_;
+        }, [](const RecipeParameters& parameters) {
+            return std::stod(parameters.at("duration"));
+        }, nullptr});
+        engine_->registerAnalysis("analyse", {{}, [this](const RecipeParameters&) {
+            const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (scans_ < 2) {  // succeeds only if the next scan runs during the analysis
+                if (std::chrono::steady_clock::now() > timeout) {
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return true;
+        }, [](const RecipeParameters&) {
+            return 5.0;
+        }, nullptr});
+    }
+    void TearDown() override {
+        engine_.reset();
+        std::filesystem::remove_all(directory_);
+    }
+    /**
+     * @brief Recipe with a scan, its analysis and a second scan that does not wait for the analysis.
+     *
+     * @return Recipe recipe.
+     */
+    Recipe overlappingRecipe() const {
+        Recipe recipe;
+        recipe.name = "Characterisation";
+        recipe.steps.push_back({"first scan", "scan", {{"duration", "10"}}, {}});
+        recipe.steps.push_back({"analysis", "analyse", {}, {"first scan"}});
+        recipe.steps.push_back({"second scan", "scan", {{"duration", "10"}}, {"first scan"}});
+        return recipe;
+    }
+
+    std::filesystem::path directory_;  /**< Temporary directory used by the tests. */
+    std::shared_ptr<FakeStage> stage_ = std::make_shared<FakeStage>();  /**< Stage running the scans. */
+    std::unique_ptr<RecipeEngine> engine_;  /**< Engine running the recipes. */
+    std::atomic<int> scans_{0};  /**< Number of scans run. */
+    std::atomic<int> failingScan_{0};  /**< Number of the scan that fails (0 for none). */
+};
+
+/**
+ * @brief Test case that checks that the invalid recipes are rejected before running any step.
+ *
+ */
+TEST_F(RecipeEngineTests, Invalid_recipes_are_rejected) {
+    EXPECT_TRUE(engine_->validate(overlappingRecipe()));
+    Recipe unknownAction = overlappingRecipe();
+    unknownAction.steps[1].action = "fit";
+    EXPECT_FALSE(engine_->validate(unknownAction));
+    Recipe missingParameter = overlappingRecipe();
+    missingParameter.steps[0].parameters.clear();
+    EXPECT_FALSE(engine_->validate(missingParameter));
+    Recipe forwardDependency = overlappingRecipe();
+    forwardDependency.steps[0].dependencies = {"second scan"};
+    EXPECT_FALSE(engine_->validate(forwardDependency));
+    EXPECT_TRUE(engine_->start(forwardDependency).empty());
+    EXPECT_EQ(0, scans_);
+}
+
+/**
+ * @brief Test case that checks that the analysis overlaps the next motion, in the estimate and in the execution.
+ *
+ */
+TEST_F(RecipeEngineTests, Analysis_overlaps_the_next_motion) {
+    Recipe recipe = overlappingRecipe();
+    EXPECT_DOUBLE_EQ(20.0, engine_->estimateDuration(recipe));  // 25 s if run in sequence
+    ASSERT_EQ(3u, engine_->start(recipe).size());
+    EXPECT_TRUE(engine_->wait());
+    EXPECT_EQ(2, scans_);
+    EXPECT_FALSE(std::filesystem::exists(engine_->getPathToProgressFile(recipe)));
+}
+
+/**
+ * @brief Test case that checks that a recipe that failed is resumed from the first step not completed.
+ *
+ */
+TEST_F(RecipeEngineTests, Failed_recipe_is_resumed) {
+    Recipe recipe;
+    recipe.name = "Characterisation";
+    recipe.steps.push_back({"first scan", "scan", {{"duration", "10"}}, {}});
+    recipe.steps.push_back({"second scan", "scan", {{"duration", "10"}}, {"first scan"}});
+    recipe.steps.push_back({"third scan", "scan", {{"duration", "10"}}, {"second scan"}});
+    failingScan_ = 2;
+    std::vector<std::shared_ptr<DeviceCommand>> steps = engine_->start(recipe);
+    EXPECT_FALSE(engine_->wait());
+    EXPECT_EQ(CommandState::Succeeded, steps[0]->getState());
+    EXPECT_EQ(CommandState::Failed, steps[2]->getState());
+    EXPECT_EQ(2, scans_);
+    ASSERT_TRUE(std::filesystem::exists(engine_->getPathToProgressFile(recipe)));
+    // Second attempt: the first scan is not repeated
+    failingScan_ = 0;
+    scans_ = 0;
+    EXPECT_DOUBLE_EQ(20.0, engine_->estimateDuration(recipe));
+    engine_->start(recipe);
+    EXPECT_TRUE(engine_->wait());
+    EXPECT_EQ(2, scans_);
+    EXPECT_FALSE(std::filesystem::exists(engine_->getPathToProgressFile(recipe)));
+}
+
+/**
+ * @brief Test case that checks that a recipe file is read with the default sequence of the steps.
+ *
+ */
+TEST_F(RecipeEngineTests, Recipe_file_is_loaded) {
+    const std::filesystem::path pathToRecipe = directory_ / "recipe.ini";
+    std::ofstream file(pathToRecipe);
+    file << "[RECIPE]\nNAME = Characterisation\n"
+         << "[FIRST_SCAN]\nACTION = Scan\nDURATION = 10\n"
+         << "[ANALYSIS]\nACTION = analyse\n"
+         << "[SECOND_SCAN]\nACTION = scan\nDURATION = 10\nDEPENDS_ON = FIRST_SCAN\n"
+         << "[CHECK]\nACTION = scan\nDURATION = 1\nDEPENDS_ON = NONE\n";
+    file.close();
+    Recipe recipe;
+    ASSERT_TRUE(loadRecipe(pathToRecipe, recipe));
+    EXPECT_EQ("Characterisation", recipe.name);
+    ASSERT_EQ(4u, recipe.steps.size());
+    EXPECT_EQ("first_scan", recipe.steps[0].name);
+    EXPECT_EQ("scan", recipe.steps[0].action);
+    EXPECT_EQ("10", recipe.steps[0].parameters["duration"]);
+    EXPECT_EQ((std::vector<std::string>{"first_scan"}), recipe.steps[1].dependencies);
+    EXPECT_EQ((std::vector<std::string>{"first_scan"}), recipe.steps[2].dependencies);
+    EXPECT_TRUE(recipe.steps[3].dependencies.empty());
+    EXPECT_TRUE(engine_->validate(recipe));
+    EXPECT_FALSE(loadRecipe(directory_ / "missing.ini", recipe));
+}
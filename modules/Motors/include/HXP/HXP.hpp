@@ -84,6 +84,8 @@ class HXP: public IHXP {
   double getCoordinateW() override;
   int stopHxp() override;
   void setHxpCoordinates(double CoordX, double CoordY, double CoordZ, double CoordU, double CoordV, double CoordW) override;
+  int setToolCoordinateSystem(double CoordX, double CoordY, double CoordZ, double CoordU, double CoordV, double CoordW) override;
+  int getToolCoordinateSystem(double& CoordX, double& CoordY, double& CoordZ, double& CoordU, double& CoordV, double& CoordW) override;
   /**
   * @brief Get the Socket identifier used for TCP connection.
   * @return integer representing the socket identifier.
@@ -104,4 +104,8 @@ class HXPMock : public IHXP {
   int());
   MOCK_METHOD6(setHxpCoordinates,
   void(double CoordX, double CoordY, double CoordZ, double CoordU, double CoordV, double CoordW));
+  MOCK_METHOD6(setToolCoordinateSystem,
+  int(double CoordX, double CoordY, double CoordZ, double CoordU, double CoordV, double CoordW));
+  MOCK_METHOD6(getToolCoordinateSystem,
+  int(double& CoordX, double& CoordY, double& CoordZ, double& CoordU, double& CoordV, double& CoordW));
 };
@@ -15,6 +15,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <array>
 #include <memory>
 
 #include "HXPMock.hpp"
@@ -43,9 +44,38 @@ class HXPMockConfiguration {
     ON_CALL(*hxpMock_, connect(_, _)).WillByDefault(Return(0));
     ON_CALL(*hxpMock_, goHome()).WillByDefault(Return(0));
     ON_CALL(*hxpMock_, disconnect()).WillByDefault(Return(0));
-    ON_CALL(*hxpMock_, setPositionAbsolute(_, _, _, _, _, _)).WillByDefault(Return(0));
+    ON_CALL(*hxpMock_, setPositionAbsolute(_, _, _, _, _, _)).WillByDefault(Invoke(this, &HXPMockConfiguration::moveAbsolute));
+    ON_CALL(*hxpMock_, setToolCoordinateSystem(_, _, _, _, _, _)).WillByDefault(Return(0));
+    ON_CALL(*hxpMock_, getToolCoordinateSystem(_, _, _, _, _, _)).WillByDefault(Return(0));
+    // The coordinates are stored as done by the HXP class
+    ON_CALL(*hxpMock_, setHxpCoordinates(_, _, _, _, _, _)).WillByDefault(Invoke(
+      [this](double CoordX, double CoordY, double CoordZ, double CoordU, double CoordV, double CoordW) {
+          coordinates_ = {CoordX, CoordY, CoordZ, CoordU, CoordV, CoordW};
+      }));
+    ON_CALL(*hxpMock_, setCoordinateX(_)).WillByDefault(Invoke([this](double coord) { coordinates_[0] = coord; }));
+    ON_CALL(*hxpMock_, setCoordinateY(_)).WillByDefault(Invoke([this](double coord) { coordinates_[1] = coord; }));
+    ON_CALL(*hxpMock_, setCoordinateZ(_)).WillByDefault(Invoke([this](double coord) { coordinates_[2] = coord; }));
+    ON_CALL(*hxpMock_, setCoordinateU(_)).WillByDefault(Invoke([this](double coord) { coordinates_[3] = coord; }));
+    ON_CALL(*hxpMock_, setCoordinateV(_)).WillByDefault(Invoke([this](double coord) { coordinates_[4] = coord; }));
+    ON_CALL(*hxpMock_, setCoordinateW(_)).WillByDefault(Invoke([this](double coord) { coordinates_[5] = coord; }));
+    ON_CALL(*hxpMock_, getCoordinateX()).WillByDefault(Invoke([this] { return coordinates_[0]; }));
+    ON_CALL(*hxpMock_, getCoordinateY()).WillByDefault(Invoke([this] { return coordinates_[1]; }));
+    ON_CALL(*hxpMock_, getCoordinateZ()).WillByDefault(Invoke([this] { return coordinates_[2]; }));
+    ON_CALL(*hxpMock_, getCoordinateU()).WillByDefault(Invoke([this] { return coordinates_[3]; }));
+    ON_CALL(*hxpMock_, getCoordinateV()).WillByDefault(Invoke([this] { return coordinates_[4]; }));
+    ON_CALL(*hxpMock_, getCoordinateW()).WillByDefault(Invoke([this] { return coordinates_[5]; }));
+  }
+  /**
+   * @brief Default action of the absolute movement: store the coordinates of the target, as done by the HXP class.
+   * 
+   * @return int 0 (movement executed).
+   */
+  int moveAbsolute(double CoordX, double CoordY, double CoordZ, double CoordU, double CoordV, double CoordW) {
+    coordinates_ = {CoordX, CoordY, CoordZ, CoordU, CoordV, CoordW};
+    return 0;
   }
 
  private:
   std::shared_ptr<NiceMock<HXPMock>> hxpMock_;  /**< Shared pointer object of Class 'HXPMock. '*/
+  std::array<double, 6> coordinates_{};  /**< Coordinates X, Y, Z, U, V, W of the hexapod. */
 };
@@ -276,4 +276,34 @@ class IHXP {
      * @param CoordW hexapod coordinate to get.
      */
     virtual double getCoordinateW() = 0;
+
+    /**
+     * @brief This function modifies the position of the Tool coordinate system with respect to the carriage.
+     * The rotations of the hexapod are executed about the origin of the Tool coordinate system and the positions
+     * in the Work coordinate system refer to it, so the "hxpCoord_" struct variable is updated with the current position.
+     * 
+     * @param CoordX X-axis coordinate of the origin.
+     * @param CoordY Y-axis coordinate of the origin.
+     * @param CoordZ Z-axis coordinate of the origin.
+     * @param CoordU U-axis rotation.
+     * @param CoordV V-axis rotation.
+     * @param CoordW W-axis rotation.
+     * @return 1 if an error occurred.
+     * @return 0 if the coordinate system was modified.
+     */
+    virtual int setToolCoordinateSystem(double CoordX, double CoordY, double CoordZ, double CoordU, double CoordV, double CoordW) = 0;
+
+    /**
+     * @brief This function reads the position of the Tool coordinate system with respect to the carriage.
+     * 
+     * @param CoordX X-axis coordinate of the origin.
+     * @param CoordY Y-axis coordinate of the origin.
+     * @param CoordZ Z-axis coordinate of the origin.
+     * @param CoordU U-axis rotation.
+     * @param CoordV V-axis rotation.
+     * @param CoordW W-axis rotation.
+     * @return 1 if an error occurred.
+     * @return 0 if the coordinate system was read.
+     */
+    virtual int getToolCoordinateSystem(double& CoordX, double& CoordY, double& CoordZ, double& CoordU, double& CoordV, double& CoordW) = 0;
 };
@@ -374,6 +374,43 @@ void HXP::setHxpCoordinates(double CoordX, double CoordY, double CoordZ, double
     hxpCoord_.CoordW = CoordW;
 }
 
+int HXP::setToolCoordinateSystem(double CoordX, double CoordY, double CoordZ, double CoordU, double CoordV, double CoordW) {
+    spdlog::info("Method 'setToolCoordinateSystem' of class HXP\n");
+    spdlog::info("Tool coordinate system: X: {}; Y: {}; Z: {}; U: {}; V: {}; W: {}.\n", CoordX, CoordY, CoordZ, CoordU, CoordV, CoordW);
+    std::string pGroup_temp_str = pGroup_;
+    char *pGroup_temp_ch = pGroup_temp_str.data();  // Conversion string to char *
+    char coordinateSystem_temp_ch[] = "Tool";
+    int error = HexapodCoordinateSystemSet(socketID_, pGroup_temp_ch, coordinateSystem_temp_ch, CoordX, CoordY, CoordZ, CoordU, CoordV, CoordW);
+    if (0 != error) {
+        spdlog::error("Error {} in HexapodCoordinateSystemSet.\n", error);
+        return 1;
+    }
+    /* The positions in the Work coordinate system now refer to the new Tool origin */
+    double  CurrentPosition[6];
+    error = GroupPositionCurrentGet(socketID_, pGroup_temp_ch, 6, CurrentPosition);
+    if (0 != error) {
+        spdlog::error("Error {} in GroupPositionCurrentGet.\n", error);
+        return 1;
+    }
+    this->setHxpCoordinates(CurrentPosition[0], CurrentPosition[1], CurrentPosition[2], CurrentPosition[3], CurrentPosition[4], CurrentPosition[5]);
+    spdlog::debug("HexapodCoordinateSystemSet executed!\n");
+    return 0;
+}
+
+int HXP::getToolCoordinateSystem(double& CoordX, double& CoordY, double& CoordZ, double& CoordU, double& CoordV, double& CoordW) {
+    spdlog::info("Method 'getToolCoordinateSystem' of class HXP\n");
+    std::string pGroup_temp_str = pGroup_;
+    char *pGroup_temp_ch = pGroup_temp_str.data();  // Conversion string to char *
+    char coordinateSystem_temp_ch[] = "Tool";
+    int error = HexapodCoordinateSystemGet(socketID_, pGroup_temp_ch, coordinateSystem_temp_ch, &CoordX, &CoordY, &CoordZ, &CoordU, &CoordV, &CoordW);
+    if (0 != error) {
+        spdlog::error("Error {} in HexapodCoordinateSystemGet.\n", error);
+        return 1;
+    }
+    spdlog::debug("HexapodCoordinateSystemGet executed!\n");
+    return 0;
+}
+
 void HXP::setCoordinateX(double CoordX) {
     hxpCoord_.CoordX = CoordX;
 }
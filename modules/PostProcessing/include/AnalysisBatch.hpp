@@ -0,0 +1,94 @@
+/**
+ * @file AnalysisBatch.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class collecting the results of the post processing scripts running in background.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+
+#include "IPostProcessing.hpp"
+
+/**
+ * @class AnalysisBatch
+ * @brief Class collecting the results of the post processing scripts running in background.
+ *
+ * The analyses are completed in the order they were added: the callback of an analysis (e.g. the registration of the
+ * iteration in a checkpoint) is called only after the callbacks of the previous ones, and no more callbacks are called once an
+ * analysis failed. The temporary file of an analysis
+ * (e.g. the copy of the scan log read by the script) is removed when the analysis is completed.
+ * The owner thread joins the analyses only where the results are needed (@ref wait), the destructor joins the ones left.
+ *
+ */
+class AnalysisBatch {
+ public:
+  using Callback = std::function<void(const ScriptResult& result)>;  /**< Function called when an analysis succeeds. */
+
+  AnalysisBatch() = default;
+  AnalysisBatch(const AnalysisBatch&) = delete;
+  AnalysisBatch& operator=(const AnalysisBatch&) = delete;
+  /**
+   * @brief Destroy the AnalysisBatch object, waiting for the analyses still running.
+   *
+   */
+  ~AnalysisBatch();
+  /**
+   * @brief Add an analysis to the batch.
+   *
+   * @param result future result of the script.
+   * @param onCompleted function called if the script and all the previous ones succeed (can be empty).
+   * @param temporaryFile file removed when the script ends (can be empty).
+   */
+  void add(std::future<ScriptResult> result, Callback onCompleted = nullptr, std::filesystem::path temporaryFile = {});
+  /**
+   * @brief Complete the analyses already ended, without waiting for the running ones.
+   *
+   */
+  void collect();
+  /**
+   * @brief Wait for all the analyses of the batch.
+   *
+   * @return true if all the analyses added since the construction succeeded.
+   * @return false otherwise.
+   */
+  bool wait();
+  /**
+   * @brief Get the number of analyses not completed yet.
+   *
+   * @return size_t number of pending analyses.
+   */
+  size_t getPendingAnalyses() const;
+
+ private:
+  /**
+   * @struct Analysis
+   * @brief Struct containing an analysis running in background.
+   *
+   */
+  struct Analysis {
+    std::future<ScriptResult> result;  /**< Future result of the script. */
+    Callback onCompleted;  /**< Function called if the script succeeds. */
+    std::filesystem::path temporaryFile;  /**< File removed when the script ends. */
+  };
+  /**
+   * @brief Get the result of the first analysis, call its callback and remove its temporary file.
+   *
+   */
+  void completeFirst();
+
+  std::deque<Analysis> analyses_;  /**< Analyses not completed, in order of submission. */
+  bool succeeded_ = true;  /**< False if at least one analysis failed. */
+};
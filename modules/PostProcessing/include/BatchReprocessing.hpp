@@ -0,0 +1,172 @@
+/**
+ * @file BatchReprocessing.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Offline reprocessing of archived scans and spectra with the native analysis kernels.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ScanAnalysis.hpp"
+
+namespace analysis {
+
+/**
+ * @struct ScanLog
+ * @brief Struct containing the columns of a data log written during a scan (see Sensors::startAcquisitionCrystal).
+ *
+ */
+struct ScanLog {
+  std::vector<std::string> columns;  /**< Names of the columns. */
+  std::vector<std::vector<double>> values;  /**< Values of the columns (one vector per column). */
+  /**
+   * @brief Get the values of a column.
+   *
+   * @param name name of the column.
+   * @return const std::vector<double>* values of the column (nullptr if the column is not found).
+   */
+  const std::vector<double>* getColumn(const std::string& name) const;
+};
+
+/**
+ * @struct RegionOfInterest
+ * @brief Struct containing a region of interest of a spectrum (e.g. K_ALPHA_START and K_ALPHA_STOP of the configuration file).
+ *
+ */
+struct RegionOfInterest {
+  std::string name;  /**< Name of the region (column of the summary). */
+  size_t start = 0;  /**< First channel of the region. */
+  size_t stop = 0;  /**< Last channel of the region. */
+};
+
+/**
+ * @struct ReprocessingSettings
+ * @brief Struct containing the settings of the reprocessing.
+ *
+ */
+struct ReprocessingSettings {
+  std::string xColumn;  /**< Column of the scanned axis (empty to use "HXP W-Axis" or "Stepper Motor Position"). */
+  std::string yColumn = "X-Ray Sensor Data";  /**< Column of the signal. */
+  size_t windowLength = 10;  /**< Window length of the Savitzky-Golay filter. */
+  size_t polyOrder = 3;  /**< Polynomial order of the Savitzky-Golay filter. */
+  std::vector<RegionOfInterest> regions;  /**< Regions of interest integrated in the spectra. */
+  size_t threads = 0;  /**< Number of threads (0 to use all the cores). */
+};
+
+/**
+ * @struct ReprocessingResult
+ * @brief Struct containing the result of the reprocessing of one archived file.
+ *
+ */
+struct ReprocessingResult {
+  std::filesystem::path file;  /**< Archived file (scan data log .csv or spectrum .mca). */
+  bool success = false;  /**< False if the file could not be read or analysed. */
+  std::string error;  /**< Reason of the failure. */
+  size_t points = 0;  /**< Number of points of the scan or channels of the spectrum. */
+  Peak peak;  /**< Peak of the rocking curve (scans only). */
+  std::vector<double> integrals;  /**< Integrals of the regions of interest (spectra only). */
+};
+
+/**
+ * @brief Read a data log written during a scan (columns separated by ';').
+ *
+ * @param pathToScanLog path to the data log.
+ * @param scanLog columns of the data log.
+ * @return true if the data log has been read.
+ * @return false otherwise.
+ */
+bool readScanLog(const std::filesystem::path& pathToScanLog, ScanLog& scanLog);
+/**
+ * @brief Read the counts of a spectrum saved by the x-ray sensor (Amptek .mca file, section <<DATA>>).
+ *
+ * @param pathToSpectrum path to the .mca file.
+ * @param counts counts of the channels.
+ * @return true if the spectrum has been read.
+ * @return false otherwise.
+ */
+bool readSpectrum(const std::filesystem::path& pathToSpectrum, std::vector<int>& counts);
+/**
+ * @brief Integrate a region of interest of a spectrum with the trapezoidal rule, as done by XRaySensor::computeIntegral.
+ *
+ * @param counts counts of the channels.
+ * @param region region of interest.
+ * @param integral integral of the region.
+ * @return true if the region is inside the spectrum.
+ * @return false otherwise.
+ */
+bool integrateRegion(const std::vector<int>& counts, const RegionOfInterest& region, double& integral);
+/**
+ * @brief Reprocess one archived file: peak of the rocking curve for the scans (.csv), integrals of the regions of interest
+ * for the spectra (.mca).
+ *
+ * @param file archived file.
+ * @param settings settings of the reprocessing.
+ * @return ReprocessingResult result of the reprocessing.
+ */
+ReprocessingResult reprocessFile(const std::filesystem::path& file, const ReprocessingSettings& settings);
+/**
+ * @brief Find the archived files (.csv and .mca) of a directory and its subdirectories.
+ *
+ * @param directory directory of the archive.
+ * @return std::vector<std::filesystem::path> archived files, sorted by path.
+ */
+std::vector<std::filesystem::path> findArchivedFiles(const std::filesystem::path& directory);
+
+/**
+ * @class BatchReprocessing
+ * @brief Class used to reprocess many archived files in parallel.
+ *
+ * The files are analysed by the lanes of a @ref WorkerPool, each taking the next file as soon as it has finished the
+ * previous one, so that long and short scans are balanced across the cores. The rows of the summary table are written in
+ * the order of the files as soon as they are available, without waiting for the whole batch.
+ *
+ */
+class BatchReprocessing {
+ public:
+  BatchReprocessing() = delete;
+  /**
+   * @brief Construct a new BatchReprocessing object.
+   *
+   * @param settings settings of the reprocessing.
+   */
+  explicit BatchReprocessing(ReprocessingSettings settings);
+  /**
+   * @brief Reprocess the files and write the summary table (.csv, one row per file).
+   *
+   * @param files archived files.
+   * @param summary stream of the summary table.
+   * @return std::vector<ReprocessingResult> results, in the order of the files.
+   */
+  std::vector<ReprocessingResult> run(const std::vector<std::filesystem::path>& files, std::ostream& summary);
+  /**
+   * @brief Write the header of the summary table.
+   *
+   * @param summary stream of the summary table.
+   */
+  void writeHeader(std::ostream& summary) const;
+  /**
+   * @brief Write a row of the summary table.
+   *
+   * @param result result of the reprocessing of a file.
+   * @param summary stream of the summary table.
+   */
+  void writeRow(const ReprocessingResult& result, std::ostream& summary) const;
+
+ private:
+  ReprocessingSettings settings_;  /**< Settings of the reprocessing. */
+};
+
+}  // namespace analysis
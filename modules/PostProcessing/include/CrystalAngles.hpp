@@ -0,0 +1,117 @@
+/**
+ * @file CrystalAngles.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Native estimators of the bending, miscut and torsion angles of a crystal, with bootstrap uncertainties.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "ScanAnalysis.hpp"
+
+namespace analysis {
+
+/**
+ * @struct BootstrapSettings
+ * @brief Struct containing the settings of the bootstrap used to estimate the uncertainty of an angle.
+ *
+ */
+struct BootstrapSettings {
+  size_t replicates = 2000;  /**< Number of resampled data sets. */
+  size_t threads = 0;  /**< Number of threads computing the replicates (0 uses all the cores). */
+  uint64_t seed = 20220101;  /**< Seed of the resampling: the same seed gives the same uncertainty with any number of threads. */
+};
+
+/**
+ * @struct AngleEstimate
+ * @brief Struct containing an angle and its standard uncertainty.
+ *
+ */
+struct AngleEstimate {
+  bool valid = false;  /**< True if the angle has been computed. */
+  double value = 0;  /**< Angle estimated from the measured data. */
+  double sigma = 0;  /**< Standard deviation of the angle over the bootstrap replicates (0 if not estimated). */
+  size_t points = 0;  /**< Number of Bragg peaks used. */
+};
+
+/**
+ * @brief Compute the replicates of a bootstrap on all the threads.
+ *
+ * Every replicate has its own random generator, seeded from the seed and the index of the replicate, so the replicates
+ * do not depend on the number of threads.
+ *
+ * @param settings settings of the bootstrap.
+ * @param replicate function computing one replicate with the given generator.
+ * @return std::vector<double> values of the replicates.
+ */
+std::vector<double> bootstrapReplicates(const BootstrapSettings& settings,
+                                        const std::function<double(std::mt19937_64& generator)>& replicate);
+/**
+ * @brief Compute the standard deviation of a set of values.
+ *
+ * @param values values.
+ * @return double sample standard deviation (0 if less than 2 values).
+ */
+double standardDeviation(const std::vector<double>& values);
+/**
+ * @brief Estimate the slope of a linear fit and its uncertainty, resampling the residuals of the fit.
+ *
+ * @param x positions of the impact points (e.g. Y axis).
+ * @param y Bragg angles (W axis positions of the peaks).
+ * @param settings settings of the bootstrap.
+ * @return AngleEstimate slope of the fit.
+ */
+AngleEstimate slopeEstimate(const std::vector<double>& x, const std::vector<double>& y, const BootstrapSettings& settings);
+/**
+ * @brief Estimate the bending angle: slope of the Bragg angles as a function of the horizontal impact points, multiplied
+ * by the crystal thickness (as done by BendingAngle.py). At least 3 peaks are required.
+ *
+ * @param yPositions positions of the Y axis of the hexapod.
+ * @param braggAngles Bragg angles (W axis positions of the peaks).
+ * @param crystalThickness thickness of the crystal.
+ * @param settings settings of the bootstrap.
+ * @return AngleEstimate bending angle.
+ */
+AngleEstimate bendingAngle(const std::vector<double>& yPositions,
+                           const std::vector<double>& braggAngles,
+                           double crystalThickness,
+                           const BootstrapSettings& settings = BootstrapSettings());
+/**
+ * @brief Estimate the torsion angle: slope of the Bragg angles as a function of the vertical impact points (as done by
+ * TorsionAngle.py). At least 3 peaks are required.
+ *
+ * @param zPositions positions of the Z axis of the hexapod.
+ * @param braggAngles Bragg angles (W axis positions of the peaks).
+ * @param settings settings of the bootstrap.
+ * @return AngleEstimate torsion angle.
+ */
+AngleEstimate torsionAngle(const std::vector<double>& zPositions,
+                           const std::vector<double>& braggAngles,
+                           const BootstrapSettings& settings = BootstrapSettings());
+/**
+ * @brief Estimate the miscut angle: mean of the half differences between the Bragg angles in 0 deg and in 180 deg
+ * orientation at the same impact points (as done by MiscutAngle.py). The uncertainty is the bootstrap of the mean.
+ *
+ * @param braggAngles0 Bragg angles in 0 deg orientation (peaks of the bending angle measurement).
+ * @param braggAngles180 Bragg angles in 180 deg orientation.
+ * @param settings settings of the bootstrap.
+ * @return AngleEstimate miscut angle.
+ */
+AngleEstimate miscutAngle(const std::vector<double>& braggAngles0,
+                          const std::vector<double>& braggAngles180,
+                          const BootstrapSettings& settings = BootstrapSettings());
+
+}  // namespace analysis
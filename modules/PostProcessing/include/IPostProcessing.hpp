@@ -12,8 +12,23 @@
 
 #pragma once
 
+#include <future>
 #include <iostream>
 #include <string>
+#include <vector>
+
+/**
+ * @struct ScriptResult
+ * @brief Struct containing the result of a python script.
+ *
+ */
+struct ScriptResult {
+  bool success = false;  /**< True if the script ended with exit code 0. */
+  int exitCode = -1;  /**< Exit code of the script (-1 if the script did not end). */
+  std::string output;  /**< Standard output of the script (empty if not captured). */
+  std::string error;  /**< Standard error of the script (traceback if an exception was raised). */
+  double duration = 0;  /**< Time (in seconds) spent by the script. */
+};
 
 /**
  * @class IPostProcessing
@@ -104,4 +119,19 @@ class IPostProcessing {  // Interface
                                std::string argument5,
                                std::string argument6,
                                std::string argument7) = 0;
+  /**
+   * @brief The method queues the execution of the Python script on a pool of workers and returns immediately, so that
+   * the analysis of a scan can run while the next scan is acquired.
+   *
+   * The scripts submitted with the same (non-empty) sequence run one after the other in submission order, e.g. the scripts
+   * that append their results to the same .csv file.
+   *
+   * @param pathToPythonScript - A string representing the path to the Python script.
+   * @param arguments - Arguments to be passed to the Python script.
+   * @param sequence - Name of the sequence of the script (empty if the script does not depend on other scripts).
+   * @return std::future<ScriptResult> result of the script, available when the script ends.
+   */
+   virtual std::future<ScriptResult> executeScriptAsync(std::string pathToPythonScript,
+                                                        std::vector<std::string> arguments,
+                                                        std::string sequence) = 0;
 };
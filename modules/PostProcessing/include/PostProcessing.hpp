@@ -18,8 +18,11 @@
 #include <cassert>
 #include <memory>
 #include <filesystem>
+#include <future>
+#include <vector>
 
 #include "IPostProcessing.hpp"
+#include "WorkerPool.hpp"
 
 /**
  * @class PostProcessing
@@ -70,6 +73,10 @@ class PostProcessing : public IPostProcessing {
                       std::string argument6,
                       std::string argument7) override;
 
+  std::future<ScriptResult> executeScriptAsync(std::string pathToPythonScript,
+                                               std::vector<std::string> arguments,
+                                               std::string sequence) override;
+
  private:
-  
+  WorkerPool pool_{2};  /**< Pool running the scripts queued by executeScriptAsync. */
 };
@@ -15,7 +15,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <future>
 #include <string>
+#include <vector>
 
 #include "IPostProcessing.hpp"
 
@@ -62,4 +64,7 @@ class PostProcessingMock : public IPostProcessing {
                                       std::string argument5,
                                       std::string argument6,
                                       std::string argument7));
+    MOCK_METHOD3(executeScriptAsync, std::future<ScriptResult>(std::string pathToPythonScript,
+                                                               std::vector<std::string> arguments,
+                                                               std::string sequence));
 };
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include <spdlog/spdlog.h>
 
+#include <future>
 #include <memory>
 
 #include "PostProcessingMock.hpp"
@@ -63,6 +64,16 @@ class PostProcessingMockConfiguration {
       [this] {
           spdlog::info("Method executeScript7 of Class configurePostProcessingMock\n");
       }));
+    ON_CALL(*PostProcessingMock_, executeScriptAsync(_, _, _)).WillByDefault(Invoke(
+      [this] {
+          spdlog::info("Method executeScriptAsync of Class configurePostProcessingMock\n");
+          ScriptResult ended;
+          ended.success = true;
+          ended.exitCode = 0;
+          std::promise<ScriptResult> result;
+          result.set_value(ended);
+          return result.get_future();
+      }));
   }
 
  private:
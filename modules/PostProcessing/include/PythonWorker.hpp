@@ -0,0 +1,133 @@
+/**
+ * @file PythonWorker.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class used to run the python scripts in a long-lived python process.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <asio.hpp>
+#include <json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "IPostProcessing.hpp"
+
+/**
+ * @class PythonWorker
+ * @brief Class used to run the python scripts in a long-lived python process.
+ *
+ * The worker (scripts/PostProcessingWorker.py) is started at the first request and connects to a socket opened by this class
+ * on 127.0.0.1. Each request (script, arguments and in-memory data) is sent as one line of JSON and the result of the script
+ * is received the same way, so the interpreter start-up and the imports of the scripts are paid only once.
+ * The scripts run unmodified: the worker executes them as '__main__' with the arguments in sys.argv.
+ *
+ * If the worker does not answer before the timeout or dies, the request fails and a new worker is started. The failed
+ * request is not sent again, since the script may already have written part of its results. If the worker cannot be started
+ * (e.g. python not installed) the script is run in a new process, as done by @ref PostProcessing.
+ *
+ */
+class PythonWorker {
+ public:
+  PythonWorker() = delete;
+  /**
+   * @brief Construct a new PythonWorker object. The python process is started at the first request.
+   *
+   * @param pathToWorkerScript path to the script of the worker (PostProcessingWorker.py).
+   * @param timeout maximum time spent by a script.
+   * @param pythonCommand command used to start the python interpreter.
+   */
+  explicit PythonWorker(std::filesystem::path pathToWorkerScript,
+                        std::chrono::seconds timeout,
+                        std::string pythonCommand);
+  /**
+   * @brief Destroy the PythonWorker object, stopping the python process.
+   *
+   */
+  ~PythonWorker();
+  /**
+   * @brief Run a python script in the worker and wait for its result.
+   *
+   * @param pathToPythonScript path to the python script.
+   * @param arguments arguments of the script (sys.argv[1:]).
+   * @param data in-memory data available to the script as the global variable WORKER_DATA.
+   * @return ScriptResult exit code, output and error of the script.
+   */
+  ScriptResult execute(const std::string& pathToPythonScript,
+                       const std::vector<std::string>& arguments,
+                       const nlohmann::json& data = nlohmann::json::object());
+  /**
+   * @brief Check if the python process is running and connected.
+   *
+   * @return true if the python process is running.
+   * @return false otherwise.
+   */
+  bool isRunning();
+  /**
+   * @brief Get the number of times the python process has been started.
+   *
+   * @return size_t number of starts (1 if the process never died).
+   */
+  size_t getStarts() const;
+
+ private:
+  /**
+   * @brief Start a new python process and wait for its connection. Must be called with the mutex locked.
+   *
+   * @return true if the worker is connected.
+   * @return false if the worker could not be started.
+   */
+  bool startWorker();
+  /**
+   * @brief Ask the python process to exit and wait for it. Must be called with the mutex locked.
+   *
+   */
+  void stopWorker();
+  /**
+   * @brief Send a request to the worker and wait for the answer. Must be called with the mutex locked.
+   *
+   * @param request request (one line of JSON).
+   * @param response answer of the worker.
+   * @param timeout maximum waiting time.
+   * @return true if the worker answered.
+   * @return false if the connection was lost or the timeout expired.
+   */
+  bool exchange(const std::string& request, std::string& response, std::chrono::milliseconds timeout);
+  /**
+   * @brief Run a python script in a new process (used when the worker cannot be started).
+   *
+   * @param pathToPythonScript path to the python script.
+   * @param arguments arguments of the script.
+   * @return ScriptResult exit code of the script.
+   */
+  ScriptResult executeInNewProcess(const std::string& pathToPythonScript, const std::vector<std::string>& arguments);
+
+  const std::filesystem::path pathToWorkerScript_;  /**< Path to the script of the worker. */
+  const std::chrono::seconds timeout_;  /**< Maximum time spent by a script. */
+  const std::string pythonCommand_;  /**< Command used to start the python interpreter. */
+  const std::chrono::seconds startTimeout_{30};  /**< Maximum time waited for the connection of a new worker. */
+  const std::chrono::seconds shutdownTimeout_{5};  /**< Maximum time waited for the exit of the worker. */
+  std::mutex mutex_;  /**< Mutex serializing the requests to the worker. */
+  asio::io_context ioContext_;  /**< I/O context of the socket. */
+  asio::ip::tcp::socket socket_{ioContext_};  /**< Socket connected to the worker. */
+  asio::streambuf buffer_;  /**< Buffer of the answers of the worker. */
+  std::thread supervisor_;  /**< Thread waiting for the exit of the python process. */
+  std::shared_ptr<std::atomic<bool>> workerAlive_;  /**< True while the python process is running (shared with the supervisor). */
+  std::atomic<size_t> workerStarts_{0};  /**< Number of times the python process has been started. */
+  uint64_t requestId_ = 0;  /**< Identifier of the last request. */
+};
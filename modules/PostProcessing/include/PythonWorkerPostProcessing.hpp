@@ -0,0 +1,142 @@
+/**
+ * @file PythonWorkerPostProcessing.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Implementation of Class @ref IPostProcessing running the python scripts in long-lived python workers.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "IPostProcessing.hpp"
+#include "PythonWorker.hpp"
+#include "WorkerPool.hpp"
+
+/**
+ * @class PythonWorkerPostProcessing
+ * @brief Implementation of Class @ref IPostProcessing running the python scripts in long-lived python workers.
+ *
+ * The scripts are run by a @ref WorkerPool: every lane of the pool owns a @ref PythonWorker, started at the first script of
+ * the lane. The blocking methods (executeScriptN) wait for the script queued in the pool, the scripts queued by
+ * executeScriptAsync run in background.
+ *
+ */
+class PythonWorkerPostProcessing : public IPostProcessing {
+ public:
+  PythonWorkerPostProcessing() = delete;
+  /**
+   * @brief Construct a new PythonWorkerPostProcessing object.
+   *
+   * @param pathToWorkerScript path to the script of the worker (PostProcessingWorker.py).
+   * @param timeout maximum time spent by a script.
+   * @param pythonCommand command used to start the python interpreter.
+   * @param workersCount number of python workers (lanes of the pool).
+   */
+  explicit PythonWorkerPostProcessing(std::filesystem::path pathToWorkerScript,
+                                      std::chrono::seconds timeout = std::chrono::seconds(600),
+                                      std::string pythonCommand = "py",
+                                      size_t workersCount = 2);
+  /**
+   * @brief Destroy the PythonWorkerPostProcessing object. The scripts already queued are run before the workers are stopped.
+   *
+   */
+  ~PythonWorkerPostProcessing();
+
+  void executeScript1(std::string pathToPythonScript,
+                      std::string argument1) override;
+
+  void executeScript2(std::string pathToPythonScript,
+                      std::string argument1,
+                      std::string argument2) override;
+
+  void executeScript5(std::string pathToPythonScript,
+                      std::string argument1,
+                      std::string argument2,
+                      std::string argument3,
+                      std::string argument4,
+                      std::string argument5) override;
+
+  void executeScript6(std::string pathToPythonScript,
+                      std::string argument1,
+                      std::string argument2,
+                      std::string argument3,
+                      std::string argument4,
+                      std::string argument5,
+                      std::string argument6) override;
+
+  void executeScript7(std::string pathToPythonScript,
+                      std::string argument1,
+                      std::string argument2,
+                      std::string argument3,
+                      std::string argument4,
+                      std::string argument5,
+                      std::string argument6,
+                      std::string argument7) override;
+
+  std::future<ScriptResult> executeScriptAsync(std::string pathToPythonScript,
+                                               std::vector<std::string> arguments,
+                                               std::string sequence) override;
+  /**
+   * @brief Queue a python script with in-memory data.
+   *
+   * @param pathToPythonScript path to the python script.
+   * @param arguments arguments of the script (sys.argv[1:]).
+   * @param sequence name of the sequence of the script (empty if the script does not depend on other scripts).
+   * @param data in-memory data available to the script as the global variable WORKER_DATA.
+   * @return std::future<ScriptResult> result of the script.
+   */
+  std::future<ScriptResult> executeAsync(const std::string& pathToPythonScript,
+                                         const std::vector<std::string>& arguments,
+                                         const std::string& sequence,
+                                         const nlohmann::json& data = nlohmann::json::object());
+  /**
+   * @brief Run a python script and wait for its result.
+   *
+   * @param pathToPythonScript path to the python script.
+   * @param arguments arguments of the script (sys.argv[1:]).
+   * @param data in-memory data available to the script as the global variable WORKER_DATA.
+   * @return ScriptResult exit code, output and error of the script.
+   */
+  ScriptResult execute(const std::string& pathToPythonScript,
+                       const std::vector<std::string>& arguments,
+                       const nlohmann::json& data = nlohmann::json::object());
+  /**
+   * @brief Check if at least one python worker is running.
+   *
+   * @return true if a worker is running.
+   * @return false otherwise.
+   */
+  bool isWorkerRunning();
+  /**
+   * @brief Get the number of times the python workers have been started.
+   *
+   * @return size_t number of starts of all the workers.
+   */
+  size_t getWorkerStarts() const;
+
+ private:
+  /**
+   * @brief Log the result of a script.
+   *
+   * @param pathToPythonScript path to the python script.
+   * @param result result of the script.
+   */
+  static void logResult(const std::string& pathToPythonScript, const ScriptResult& result);
+
+  std::vector<std::unique_ptr<PythonWorker>> workers_;  /**< Python workers, one for each lane of the pool. */
+  std::unique_ptr<WorkerPool> pool_;  /**< Pool running the scripts (destroyed before the workers). */
+};
@@ -0,0 +1,208 @@
+/**
+ * @file ScanAnalysis.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Native analysis of the scans (smoothing, half maximum crossings, peak centre and linear fit).
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Kernels used by the alignment scripts (see modules/Devices/scripts/functions.py), working on the arrays of a scan
+ * already in memory. Every function gives the same result of its python counterpart; the functions that can fail log the
+ * error and return false (or a result with 'valid' false) instead of raising.
+ *
+ */
+namespace analysis {
+
+/**
+ * @struct HalfMaximum
+ * @brief Struct containing the crossings between a signal and the horizontal line at half of its range.
+ *
+ */
+struct HalfMaximum {
+  bool valid = false;  /**< False if the signal does not cross the half maximum twice. */
+  double firstCrossing = 0;  /**< First x-axis intersection point between the signal and the half maximum. */
+  double secondCrossing = 0;  /**< Second x-axis intersection point between the signal and the half maximum. */
+  double maximum = 0;  /**< Max of the signal. */
+  double minimum = 0;  /**< Min of the signal. */
+  double half = 0;  /**< Middle value between min and max of the signal. */
+  /**
+   * @brief Get the centre of the peak (middle point between the two crossings).
+   *
+   * @return double position of the centre of the peak.
+   */
+  double getCentre() const { return (firstCrossing + secondCrossing) / 2; }
+  /**
+   * @brief Get the full width at half maximum.
+   *
+   * @return double distance between the two crossings.
+   */
+  double getFwhm() const { return secondCrossing - firstCrossing; }
+};
+
+/**
+ * @struct Peak
+ * @brief Struct containing the result of the analysis of a rocking curve.
+ *
+ */
+struct Peak {
+  bool valid = false;  /**< False if the peak could not be found. */
+  double centre = 0;  /**< Position of the centre of the peak (middle point of the half maximum crossings). */
+  double fwhm = 0;  /**< Full width at half maximum. */
+  double value = 0;  /**< Value of the (smoothed) signal at the centre of the peak. */
+  HalfMaximum halfMaximum;  /**< Crossings with the half maximum. */
+};
+
+/**
+ * @struct LinearFit
+ * @brief Struct containing the coefficients of a least squares fit of a line (y = slope * x + intercept).
+ *
+ */
+struct LinearFit {
+  bool valid = false;  /**< False if less than two distinct x values are given. */
+  double slope = 0;  /**< Slope of the line. */
+  double intercept = 0;  /**< Intercept of the line. */
+  /**
+   * @brief Evaluate the line.
+   *
+   * @param x x-axis value.
+   * @return double y-axis value of the line.
+   */
+  double evaluate(double x) const { return slope * x + intercept; }
+};
+
+/**
+ * @brief Savitzky-Golay filter, same as scipy.signal.savgol_filter(y, windowLength, polyOrder) (mode 'interp').
+ * @details The points far from the edges are the value at the centre of the window of the polynomial fitted on the window
+ * (for an even window length the centre lies half a sample after the point, as in scipy). The first and last windowLength / 2
+ * points are taken from the polynomial fitted on the first and last window.
+ *
+ * @param y signal.
+ * @param windowLength number of points of the window.
+ * @param polyOrder order of the polynomial, smaller than the window length.
+ * @return std::vector<double> smoothed signal, the input signal unchanged if the parameters are not valid.
+ */
+std::vector<double> savitzkyGolay(const std::vector<double>& y, size_t windowLength, size_t polyOrder);
+/**
+ * @brief Least squares fit of a polynomial (same as numpy.polyfit, with the coefficients in increasing order).
+ *
+ * @param x x-axis values.
+ * @param y y-axis values.
+ * @param order order of the polynomial.
+ * @param coefficients coefficients of the polynomial (coefficients[k] multiplies x^k).
+ * @return true if the fit was successful.
+ * @return false if there are not enough points or the system is singular.
+ */
+bool polynomialFit(const std::vector<double>& x, const std::vector<double>& y, size_t order, std::vector<double>& coefficients);
+/**
+ * @brief Least squares fit of a line (same as compute_linear_fit of functions.py).
+ *
+ * @param x x-axis values.
+ * @param y y-axis values.
+ * @return LinearFit slope and intercept of the line.
+ */
+LinearFit linearFit(const std::vector<double>& x, const std::vector<double>& y);
+/**
+ * @brief Linear interpolation of the x-axis value where the signal crosses a horizontal line (lin_interp of functions.py).
+ *
+ * @param x x-axis values.
+ * @param y y-axis values.
+ * @param index index of the point before the crossing (index + 1 must be a valid index).
+ * @param level value of the horizontal line.
+ * @return double x-axis value of the crossing.
+ */
+double interpolateX(const std::vector<double>& x, const std::vector<double>& y, size_t index, double level);
+/**
+ * @brief Linear interpolation of the y-axis value where the signal crosses a vertical line (lin_interp_y of functions.py).
+ *
+ * @param x x-axis values.
+ * @param y y-axis values.
+ * @param index index of the point before the crossing (index + 1 must be a valid index).
+ * @param position value of the vertical line.
+ * @return double y-axis value of the crossing.
+ */
+double interpolateY(const std::vector<double>& x, const std::vector<double>& y, size_t index, double position);
+/**
+ * @brief Find the indexes where the signal crosses a level (same as the zero crossings of numpy.sign used in functions.py,
+ * so the last point of the signal is never considered).
+ *
+ * @param values signal.
+ * @param level value to be crossed.
+ * @return std::vector<size_t> indexes of the points before the crossings.
+ */
+std::vector<size_t> findCrossings(const std::vector<double>& values, double level);
+/**
+ * @brief Find the two crossings between the signal and its half maximum (half_max_x of functions.py).
+ *
+ * @param x x-axis values.
+ * @param y y-axis values.
+ * @return HalfMaximum crossings, max, min and half of the signal.
+ */
+HalfMaximum halfMaximum(const std::vector<double>& x, const std::vector<double>& y);
+/**
+ * @brief Find the position where the signal crosses the middle value between two levels
+ * (half_max_position_interpolation of functions.py).
+ *
+ * @param x x-axis values.
+ * @param y y-axis values.
+ * @param levelStart first level (e.g. mean count of the fully opened beam).
+ * @param levelEnd second level (e.g. mean count of the fully closed beam).
+ * @param position x-axis value of the first crossing.
+ * @return true if the signal crosses the middle value.
+ * @return false otherwise.
+ */
+bool halfLevelPosition(const std::vector<double>& x, const std::vector<double>& y, double levelStart, double levelEnd, double& position);
+/**
+ * @brief Find the value of the signal at a position (searchPeakPosition of functions.py).
+ *
+ * @param x x-axis values.
+ * @param y y-axis values.
+ * @param position x-axis value.
+ * @param value y-axis value of the signal at the position.
+ * @return true if the position is inside the scanned range.
+ * @return false otherwise.
+ */
+bool valueAtPosition(const std::vector<double>& x, const std::vector<double>& y, double position, double& value);
+/**
+ * @brief Find the peak of a signal already smoothed: centre and width from the half maximum crossings and value at the centre.
+ *
+ * @param x x-axis values.
+ * @param y y-axis values.
+ * @return Peak centre, width and value of the peak.
+ */
+Peak findPeak(const std::vector<double>& x, const std::vector<double>& y);
+/**
+ * @brief Smooth a rocking curve and find its peak, as done by the Bragg peak and the measurement scripts.
+ *
+ * @param x x-axis values (e.g. positions of the W axis).
+ * @param y y-axis values (e.g. counts of the x-ray sensor).
+ * @param windowLength window length of the Savitzky-Golay filter.
+ * @param polyOrder polynomial order of the Savitzky-Golay filter.
+ * @return Peak centre, width and value of the peak of the smoothed signal.
+ */
+Peak analyseRockingCurve(const std::vector<double>& x,
+                         const std::vector<double>& y,
+                         size_t windowLength = 10,
+                         size_t polyOrder = 3);
+/**
+ * @brief Mean of a range of the signal.
+ *
+ * @param values signal.
+ * @param begin index of the first point.
+ * @param end index after the last point.
+ * @return double mean of the points, 0 if the range is empty.
+ */
+double mean(const std::vector<double>& values, size_t begin, size_t end);
+
+}  // namespace analysis
@@ -0,0 +1,107 @@
+/**
+ * @file WorkerPool.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Pool of threads running the post processing tasks in background.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class WorkerPool
+ * @brief Pool of threads ("lanes") running the post processing tasks in background.
+ *
+ * Each lane has its own thread and queue, and the index of the lane is passed to the task, so that a lane can own a
+ * resource that is not shared (e.g. a python worker process). The tasks of the same sequence are queued in the same lane,
+ * therefore they run one after the other in submission order. A task without sequence is queued in the lane with fewer
+ * pending tasks.
+ *
+ */
+class WorkerPool {
+ public:
+  using Task = std::function<void(size_t lane)>;  /**< Task run by a lane, with the index of the lane. */
+
+  WorkerPool() = delete;
+  /**
+   * @brief Construct a new WorkerPool object and start its threads.
+   *
+   * @param lanesCount number of lanes (at least 1).
+   */
+  explicit WorkerPool(size_t lanesCount);
+  /**
+   * @brief Destroy the WorkerPool object. The tasks already queued are run before the threads are stopped.
+   *
+   */
+  ~WorkerPool();
+  /**
+   * @brief Queue a task.
+   *
+   * @param sequence name of the sequence of the task (empty if the task does not depend on other tasks).
+   * @param task task to be run.
+   * @return size_t index of the lane that will run the task.
+   */
+  size_t submit(const std::string& sequence, Task task);
+  /**
+   * @brief Get the number of lanes.
+   *
+   * @return size_t number of lanes.
+   */
+  size_t getLanesCount() const;
+  /**
+   * @brief Get the number of tasks queued or running.
+   *
+   * @return size_t number of pending tasks.
+   */
+  size_t getPendingTasks();
+
+ private:
+  /**
+   * @struct Lane
+   * @brief Struct containing the queue and the thread of a lane.
+   *
+   */
+  struct Lane {
+    std::deque<std::pair<std::string, Task>> tasks;  /**< Tasks waiting to be run, with their sequence. */
+    size_t pending = 0;  /**< Number of tasks queued or running. */
+    std::condition_variable condition;  /**< Condition variable notified when a task is queued. */
+    std::thread thread;  /**< Thread running the tasks. */
+  };
+  /**
+   * @struct Sequence
+   * @brief Struct containing the lane assigned to a sequence while it has pending tasks.
+   *
+   */
+  struct Sequence {
+    size_t lane = 0;  /**< Lane of the sequence. */
+    size_t pending = 0;  /**< Number of tasks of the sequence queued or running. */
+  };
+  /**
+   * @brief Run the tasks of a lane until the pool is stopped.
+   *
+   * @param index index of the lane.
+   */
+  void run(size_t index);
+
+  std::vector<std::unique_ptr<Lane>> lanes_;  /**< Lanes of the pool. */
+  std::map<std::string, Sequence> sequences_;  /**< Sequences with pending tasks. */
+  std::mutex mutex_;  /**< Mutex protecting the queues and the sequences. */
+  bool stopped_ = false;  /**< True when the pool is destroyed. */
+};
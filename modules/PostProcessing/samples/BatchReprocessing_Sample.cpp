@@ -0,0 +1,152 @@
+/* © Copyright CERN 2022.  All rights reserved. This software is released under a CERN proprietary
+ * software licence. Any permission to use it shall be granted in writing. Requests shall be
+ * addressed to CERN through mail-KT@cern.ch
+ *
+ * Author: Gianmarco Ricci CERN BE/CEM/MRO 2022
+ *
+ *  Command line tool reprocessing archived scans (.csv data logs) and spectra (.mca) with new analysis settings.
+ *
+ *  BatchReprocessing_Sample <directory> [options]
+ *  BatchReprocessing_Sample --index <index file> [--type TYPE] [--crystal ID] [--from SECONDS] [--to SECONDS] [options]
+ *
+ *  Options:
+ *    --x COLUMN             column of the scanned axis (default "HXP W-Axis" or "Stepper Motor Position")
+ *    --y COLUMN             column of the signal (default "X-Ray Sensor Data")
+ *    --window N             window length of the Savitzky-Golay filter (default 10)
+ *    --order N              polynomial order of the Savitzky-Golay filter (default 3)
+ *    --roi NAME:START:STOP  region of interest integrated in the spectra (repeatable)
+ *    --threads N            number of threads (default: all the cores)
+ *    --output FILE          summary table (default: standard output)
+ *  ===============================================================================================
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "BatchReprocessing.hpp"
+#include "MeasurementIndex.hpp"
+
+#include <spdlog/spdlog.h>
+
+namespace {
+
+/**
+ * @brief Parse a region of interest given as NAME:START:STOP.
+ *
+ * @param argument command line argument.
+ * @param region region of interest.
+ * @return true if the argument is valid.
+ * @return false otherwise.
+ */
+bool parseRegion(const std::string& argument, analysis::RegionOfInterest& region) {
+    const size_t first = argument.find(':');
+    const size_t second = argument.find(':', first + 1);
+    if (first == std::string::npos || second == std::string::npos) {
+        return false;
+    }
+    try {
+        region.name = argument.substr(0, first);
+        region.start = std::stoul(argument.substr(first + 1, second - first - 1));
+        region.stop = std::stoul(argument.substr(second + 1));
+    } catch (const std::exception&) {
+        return false;
+    }
+    return !region.name.empty() && region.start < region.stop;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    analysis::ReprocessingSettings settings;
+    sensors::MeasurementQuery query;
+    std::filesystem::path directory;
+    std::filesystem::path pathToIndexFile;
+    std::filesystem::path pathToSummary;
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (argument.rfind("--", 0) != 0) {
+                directory = argument;
+            } else if (!hasValue) {
+                spdlog::error("Missing value of {}\n", argument);
+                return 2;
+            } else if (argument == "--index") {
+                pathToIndexFile = argv[++i];
+            } else if (argument == "--type") {
+                query.type = argv[++i];
+            } else if (argument == "--crystal") {
+                query.crystalId = argv[++i];
+            } else if (argument == "--from") {
+                query.from = std::stod(argv[++i]);
+            } else if (argument == "--to") {
+                query.to = std::stod(argv[++i]);
+            } else if (argument == "--x") {
+                settings.xColumn = argv[++i];
+            } else if (argument == "--y") {
+                settings.yColumn = argv[++i];
+            } else if (argument == "--window") {
+                settings.windowLength = std::stoul(argv[++i]);
+            } else if (argument == "--order") {
+                settings.polyOrder = std::stoul(argv[++i]);
+            } else if (argument == "--threads") {
+                settings.threads = std::stoul(argv[++i]);
+            } else if (argument == "--output") {
+                pathToSummary = argv[++i];
+            } else if (argument == "--roi") {
+                analysis::RegionOfInterest region;
+                if (!parseRegion(argv[++i], region)) {
+                    spdlog::error("Invalid region of interest {} (expected NAME:START:STOP)\n", argv[i]);
+                    return 2;
+                }
+                settings.regions.push_back(region);
+            } else {
+                spdlog::error("Unknown option {}\n", argument);
+                return 2;
+            }
+        }
+    } catch (const std::exception&) {
+        spdlog::error("Invalid numeric option\n");
+        return 2;
+    }
+    if (directory.empty() == pathToIndexFile.empty()) {
+        spdlog::error("Usage: BatchReprocessing_Sample <directory> | --index <index file> [options]\n");
+        return 2;
+    }
+    /* Files to reprocess: whole archive directory or result of a query to the measurement index */
+    std::vector<std::filesystem::path> files;
+    if (!directory.empty()) {
+        files = analysis::findArchivedFiles(directory);
+    } else {
+        sensors::MeasurementIndex index(pathToIndexFile);
+        std::set<std::filesystem::path> queriedFiles;
+        for (const sensors::MeasurementRecord& record : index.query(query)) {
+            if (!record.resultPath.empty() && queriedFiles.insert(record.resultPath).second) {  // a file is reprocessed once
+                files.push_back(record.resultPath);
+            }
+        }
+    }
+    spdlog::info("{} files to reprocess\n", files.size());
+    std::ofstream summaryFile;
+    if (!pathToSummary.empty()) {
+        summaryFile.open(pathToSummary, std::ios::out | std::ios::trunc);
+        if (!summaryFile.is_open()) {
+            spdlog::error("Unable to open the summary {}\n", pathToSummary.string());
+            return 2;
+        }
+    }
+    const auto start = std::chrono::steady_clock::now();
+    analysis::BatchReprocessing batch(settings);
+    const std::vector<analysis::ReprocessingResult> results = batch.run(files, pathToSummary.empty() ? std::cout : summaryFile);
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t failures = 0;
+    for (const analysis::ReprocessingResult& result : results) {
+        failures += result.success ? 0 : 1;
+    }
+    spdlog::info("{} files reprocessed in {:.2f} s ({} failed)\n", results.size(), elapsed, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file AnalysisBatch.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class collecting the results of the post processing scripts running in background.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "AnalysisBatch.hpp"
+
+AnalysisBatch::~AnalysisBatch() {
+    this->wait();
+}
+
+void AnalysisBatch::add(std::future<ScriptResult> result, Callback onCompleted, std::filesystem::path temporaryFile) {
+    analyses_.push_back(Analysis{std::move(result), std::move(onCompleted), std::move(temporaryFile)});
+    this->collect();
+}
+
+void AnalysisBatch::collect() {
+    while (!analyses_.empty()) {
+        const std::future<ScriptResult>& result = analyses_.front().result;
+        if (result.valid() && result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;  // the next analyses are completed after this one
+        }
+        this->completeFirst();
+    }
+}
+
+bool AnalysisBatch::wait() {
+    while (!analyses_.empty()) {
+        this->completeFirst();
+    }
+    return succeeded_;
+}
+
+size_t AnalysisBatch::getPendingAnalyses() const {
+    return analyses_.size();
+}
+
+void AnalysisBatch::completeFirst() {
+    Analysis analysis = std::move(analyses_.front());
+    analyses_.pop_front();
+    ScriptResult result;
+    if (analysis.result.valid()) {
+        try {
+            result = analysis.result.get();
+        } catch (const std::exception& exception) {
+            result.error = exception.what();
+        }
+    } else {
+        result.error = "Script not queued";
+    }
+    if (!analysis.temporaryFile.empty()) {
+        std::error_code errorCode;
+        std::filesystem::remove(analysis.temporaryFile, errorCode);
+    }
+    if (!result.success) {
+        spdlog::error("Analysis failed: {}\n", result.error);
+        succeeded_ = false;
+    }
+    if (succeeded_ && analysis.onCompleted) {  // no callback after a failure, the next results depend on the missing one
+        analysis.onCompleted(result);
+    }
+}
@@ -0,0 +1,266 @@
+/**
+ * @file BatchReprocessing.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Offline reprocessing of archived scans and spectra with the native analysis kernels.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "BatchReprocessing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "WorkerPool.hpp"
+
+namespace analysis {
+
+namespace {
+
+/**
+ * @brief Split a line of a .csv file, removing the carriage return of the files written on Windows.
+ *
+ * @param line line of the file.
+ * @param separator column separator.
+ * @return std::vector<std::string> fields of the line.
+ */
+std::vector<std::string> splitLine(std::string line, char separator) {
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    std::vector<std::string> fields;
+    std::istringstream lineStream(line);
+    std::string field;
+    while (std::getline(lineStream, field, separator)) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+}  // namespace
+
+const std::vector<double>* ScanLog::getColumn(const std::string& name) const {
+    const auto it = std::find(columns.begin(), columns.end(), name);
+    if (it == columns.end()) {
+        return nullptr;
+    }
+    return &values[it - columns.begin()];
+}
+
+bool readScanLog(const std::filesystem::path& pathToScanLog, ScanLog& scanLog) {
+    scanLog = ScanLog();
+    std::ifstream scanLogFile(pathToScanLog);
+    std::string line;
+    if (!std::getline(scanLogFile, line)) {
+        spdlog::error("Unable to read the data log {}\n", pathToScanLog.string());
+        return false;
+    }
+    scanLog.columns = splitLine(line, ';');
+    while (!scanLog.columns.empty() && scanLog.columns.back().empty()) {  // every row ends with a separator
+        scanLog.columns.pop_back();
+    }
+    scanLog.values.resize(scanLog.columns.size());
+    std::vector<double> row(scanLog.columns.size());
+    while (std::getline(scanLogFile, line)) {
+        const std::vector<std::string> fields = splitLine(line, ';');
+        if (fields.size() < scanLog.columns.size()) {
+            continue;  // empty or incomplete row (scan stopped)
+        }
+        try {
+            for (size_t column = 0; column < row.size(); column++) {
+                row[column] = std::stod(fields[column]);
+            }
+        } catch (const std::exception&) {
+            spdlog::warn("Invalid row '{}' in {}\n", line, pathToScanLog.string());
+            continue;
+        }
+        for (size_t column = 0; column < row.size(); column++) {
+            scanLog.values[column].push_back(row[column]);
+        }
+    }
+    return !scanLog.columns.empty();
+}
+
+bool readSpectrum(const std::filesystem::path& pathToSpectrum, std::vector<int>& counts) {
+    counts.clear();
+    std::ifstream spectrumFile(pathToSpectrum);
+    std::string line;
+    bool data = false;
+    while (std::getline(spectrumFile, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line == "<<DATA>>") {
+            data = true;
+        } else if (line == "<<END>>") {
+            return data;
+        } else if (data) {
+            try {
+                counts.push_back(std::stoi(line));
+            } catch (const std::exception&) {
+                spdlog::error("Invalid channel '{}' in {}\n", line, pathToSpectrum.string());
+                return false;
+            }
+        }
+    }
+    spdlog::error("Section <<DATA>> not found or not terminated in {}\n", pathToSpectrum.string());
+    return false;
+}
+
+bool integrateRegion(const std::vector<int>& counts, const RegionOfInterest& region, double& integral) {
+    integral = 0;
+    if (region.start >= region.stop || region.stop >= counts.size()) {
+        return false;
+    }
+    for (size_t channel = region.start; channel < region.stop; channel++) {
+        integral += (counts[channel] + counts[channel + 1]) / 2.0;
+    }
+    return true;
+}
+
+ReprocessingResult reprocessFile(const std::filesystem::path& file, const ReprocessingSettings& settings) {
+    ReprocessingResult result;
+    result.file = file;
+    if (file.extension() == ".mca") {
+        std::vector<int> counts;
+        if (!readSpectrum(file, counts)) {
+            result.error = "spectrum not readable";
+            return result;
+        }
+        result.points = counts.size();
+        for (const RegionOfInterest& region : settings.regions) {
+            double integral = 0;
+            if (!integrateRegion(counts, region, integral)) {
+                result.error = "region " + region.name + " outside the spectrum";
+                return result;
+            }
+            result.integrals.push_back(integral);
+        }
+        result.success = true;
+        return result;
+    }
+    ScanLog scanLog;
+    if (!readScanLog(file, scanLog)) {
+        result.error = "data log not readable";
+        return result;
+    }
+    const std::vector<double>* x = nullptr;
+    if (!settings.xColumn.empty()) {
+        x = scanLog.getColumn(settings.xColumn);
+    } else if ((x = scanLog.getColumn("HXP W-Axis")) == nullptr) {
+        x = scanLog.getColumn("Stepper Motor Position");
+    }
+    const std::vector<double>* y = scanLog.getColumn(settings.yColumn);
+    if (x == nullptr || y == nullptr) {
+        result.error = "columns of the scan not found";
+        return result;
+    }
+    result.points = y->size();
+    result.peak = analyseRockingCurve(*x, *y, settings.windowLength, settings.polyOrder);
+    if (!result.peak.valid) {
+        result.error = "peak not found";
+        return result;
+    }
+    result.success = true;
+    return result;
+}
+
+std::vector<std::filesystem::path> findArchivedFiles(const std::filesystem::path& directory) {
+    std::vector<std::filesystem::path> files;
+    std::error_code errorCode;
+    for (std::filesystem::recursive_directory_iterator it(directory, errorCode), end; !errorCode && it != end; it.increment(errorCode)) {
+        const std::filesystem::path extension = it->path().extension();
+        if (it->is_regular_file() && (extension == ".csv" || extension == ".mca")) {
+            files.push_back(it->path());
+        }
+    }
+    if (errorCode) {
+        spdlog::error("Unable to list the archive {}: {}\n", directory.string(), errorCode.message());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+BatchReprocessing::BatchReprocessing(ReprocessingSettings settings) :
+    settings_(std::move(settings)) {
+}
+
+std::vector<ReprocessingResult> BatchReprocessing::run(const std::vector<std::filesystem::path>& files, std::ostream& summary) {
+    std::vector<ReprocessingResult> results(files.size());
+    std::vector<bool> completed(files.size(), false);
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<size_t> nextFile{0};
+    this->writeHeader(summary);
+    {
+        size_t lanesCount = settings_.threads > 0 ? settings_.threads : std::thread::hardware_concurrency();
+        lanesCount = std::max<size_t>(std::min(lanesCount, files.size()), 1);
+        WorkerPool pool(lanesCount);
+        for (size_t lane = 0; lane < lanesCount; lane++) {
+            pool.submit("", [&](size_t) {
+                for (size_t index = nextFile++; index < files.size(); index = nextFile++) {
+                    ReprocessingResult result;
+                    try {
+                        result = reprocessFile(files[index], settings_);
+                    } catch (const std::exception& exception) {
+                        result.file = files[index];
+                        result.error = exception.what();
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    results[index] = std::move(result);
+                    completed[index] = true;
+                    condition.notify_all();
+                }
+            });
+        }
+        // Rows in the order of the files, each written as soon as the previous ones are available
+        for (size_t index = 0; index < files.size(); index++) {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&completed, index] { return completed[index]; });
+            lock.unlock();
+            this->writeRow(results[index], summary);
+            summary.flush();
+        }
+    }
+    return results;
+}
+
+void BatchReprocessing::writeHeader(std::ostream& summary) const {
+    summary << "File,Status,Points,Peak Centre,FWHM,Peak Value";
+    for (const RegionOfInterest& region : settings_.regions) {
+        summary << "," << region.name;
+    }
+    summary << ",Error\n";
+}
+
+void BatchReprocessing::writeRow(const ReprocessingResult& result, std::ostream& summary) const {
+    std::ostringstream row;
+    row << std::setprecision(std::numeric_limits<double>::max_digits10);
+    row << result.file.string() << "," << (result.success ? "OK" : "FAILED") << "," << result.points;
+    if (result.peak.valid) {
+        row << "," << result.peak.centre << "," << result.peak.fwhm << "," << result.peak.value;
+    } else {
+        row << ",,,";
+    }
+    for (size_t region = 0; region < settings_.regions.size(); region++) {
+        row << ",";
+        if (region < result.integrals.size()) {
+            row << result.integrals[region];
+        }
+    }
+    row << "," << result.error << "\n";
+    summary << row.str();
+}
+
+}  // namespace analysis
@@ -0,0 +1,136 @@
+/**
+ * @file CrystalAngles.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Native estimators of the bending, miscut and torsion angles of a crystal, with bootstrap uncertainties.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "CrystalAngles.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace analysis {
+
+std::vector<double> bootstrapReplicates(const BootstrapSettings& settings,
+                                        const std::function<double(std::mt19937_64& generator)>& replicate) {
+    std::vector<double> values(settings.replicates);
+    size_t threadsCount = settings.threads > 0 ? settings.threads : std::thread::hardware_concurrency();
+    threadsCount = std::max<size_t>(1, std::min(threadsCount, settings.replicates));
+    auto computeRange = [&settings, &replicate, &values](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; index++) {
+            std::seed_seq seed{settings.seed, static_cast<uint64_t>(index)};
+            std::mt19937_64 generator(seed);
+            values[index] = replicate(generator);
+        }
+    };
+    std::vector<std::thread> threads;
+    const size_t chunk = (settings.replicates + threadsCount - 1) / threadsCount;
+    for (size_t begin = chunk; begin < settings.replicates; begin += chunk) {
+        threads.emplace_back(computeRange, begin, std::min(begin + chunk, settings.replicates));
+    }
+    computeRange(0, std::min(chunk, settings.replicates));  // first chunk on the calling thread
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return values;
+}
+
+double standardDeviation(const std::vector<double>& values) {
+    if (values.size() < 2) {
+        return 0;
+    }
+    const double average = mean(values, 0, values.size());
+    double sum = 0;
+    for (double value : values) {
+        sum += (value - average) * (value - average);
+    }
+    return std::sqrt(sum / (values.size() - 1));
+}
+
+AngleEstimate slopeEstimate(const std::vector<double>& x, const std::vector<double>& y, const BootstrapSettings& settings) {
+    AngleEstimate estimate;
+    estimate.points = x.size();
+    if (x.size() != y.size() || x.size() < 3) {
+        spdlog::error("At least 3 Bragg peaks are required to fit the slope ({} found)\n", std::min(x.size(), y.size()));
+        return estimate;
+    }
+    const LinearFit fit = linearFit(x, y);
+    if (!fit.valid) {
+        spdlog::error("Linear fit of the Bragg peaks failed\n");
+        return estimate;
+    }
+    estimate.valid = true;
+    estimate.value = fit.slope;
+    // Residuals rescaled by sqrt(n / (n - 2)), so that their variance is the unbiased variance of the fit
+    const double scale = std::sqrt(static_cast<double>(x.size()) / (x.size() - 2));
+    std::vector<double> residuals(x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        residuals[i] = (y[i] - fit.evaluate(x[i])) * scale;
+    }
+    const std::vector<double> slopes = bootstrapReplicates(settings, [&x, &fit, &residuals](std::mt19937_64& generator) {
+        std::uniform_int_distribution<size_t> pick(0, residuals.size() - 1);
+        std::vector<double> resampled(x.size());
+        for (size_t i = 0; i < x.size(); i++) {
+            resampled[i] = fit.evaluate(x[i]) + residuals[pick(generator)];
+        }
+        return linearFit(x, resampled).slope;
+    });
+    estimate.sigma = standardDeviation(slopes);
+    return estimate;
+}
+
+AngleEstimate bendingAngle(const std::vector<double>& yPositions,
+                           const std::vector<double>& braggAngles,
+                           double crystalThickness,
+                           const BootstrapSettings& settings) {
+    AngleEstimate estimate = slopeEstimate(yPositions, braggAngles, settings);
+    estimate.value *= crystalThickness;
+    estimate.sigma *= std::fabs(crystalThickness);
+    return estimate;
+}
+
+AngleEstimate torsionAngle(const std::vector<double>& zPositions,
+                           const std::vector<double>& braggAngles,
+                           const BootstrapSettings& settings) {
+    return slopeEstimate(zPositions, braggAngles, settings);
+}
+
+AngleEstimate miscutAngle(const std::vector<double>& braggAngles0,
+                          const std::vector<double>& braggAngles180,
+                          const BootstrapSettings& settings) {
+    AngleEstimate estimate;
+    estimate.points = braggAngles180.size();
+    if (braggAngles0.size() != braggAngles180.size() || braggAngles0.empty()) {
+        spdlog::error("Bragg peaks in 0 deg ({}) and 180 deg ({}) orientation do not match\n",
+                      braggAngles0.size(), braggAngles180.size());
+        return estimate;
+    }
+    std::vector<double> miscutAngles(braggAngles0.size());
+    for (size_t i = 0; i < miscutAngles.size(); i++) {
+        miscutAngles[i] = (braggAngles0[i] - braggAngles180[i]) / 2;
+    }
+    estimate.valid = true;
+    estimate.value = mean(miscutAngles, 0, miscutAngles.size());
+    if (miscutAngles.size() < 2) {
+        return estimate;
+    }
+    const std::vector<double> means = bootstrapReplicates(settings, [&miscutAngles](std::mt19937_64& generator) {
+        std::uniform_int_distribution<size_t> pick(0, miscutAngles.size() - 1);
+        double sum = 0;
+        for (size_t i = 0; i < miscutAngles.size(); i++) {
+            sum += miscutAngles[pick(generator)];
+        }
+        return sum / miscutAngles.size();
+    });
+    estimate.sigma = standardDeviation(means);
+    return estimate;
+}
+
+}  // namespace analysis
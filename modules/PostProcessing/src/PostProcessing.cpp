@@ -95,4 +95,24 @@ void PostProcessing::executeScript7(std::string pathToPythonScript,
                                                         + argument7;
     spdlog::debug("Executing: {}\n", commandToExecuteScript);
     std::system(commandToExecuteScript.data());
-}
\ No newline at end of file
+}
+
+std::future<ScriptResult> PostProcessing::executeScriptAsync(std::string pathToPythonScript,
+                                                             std::vector<std::string> arguments,
+                                                             std::string sequence) {
+    spdlog::info("Method executeScriptAsync of Class PostProcessing\n");
+    std::string commandToExecuteScript = "py " + pathToPythonScript;
+    for (const std::string& argument : arguments) {
+        commandToExecuteScript += " " + argument;
+    }
+    auto script = std::make_shared<std::packaged_task<ScriptResult(size_t)>>([commandToExecuteScript](size_t) {
+        spdlog::debug("Executing: {}\n", commandToExecuteScript);
+        ScriptResult result;
+        result.exitCode = std::system(commandToExecuteScript.data());
+        result.success = result.exitCode == 0;
+        return result;
+    });
+    std::future<ScriptResult> result = script->get_future();
+    pool_.submit(sequence, [script](size_t lane) { (*script)(lane); });
+    return result;
+}
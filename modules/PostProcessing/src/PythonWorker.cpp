@@ -0,0 +1,216 @@
+/**
+ * @file PythonWorker.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Class used to run the python scripts in a long-lived python process.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "PythonWorker.hpp"
+
+#include <cstdlib>
+#include <istream>
+
+PythonWorker::PythonWorker(std::filesystem::path pathToWorkerScript,
+                           std::chrono::seconds timeout,
+                           std::string pythonCommand) :
+    pathToWorkerScript_(pathToWorkerScript),
+    timeout_(timeout),
+    pythonCommand_(pythonCommand) {
+    spdlog::info("cTor PythonWorker\n");
+}
+
+PythonWorker::~PythonWorker() {
+    spdlog::info("dTor PythonWorker\n");
+    std::lock_guard<std::mutex> lock(mutex_);
+    this->stopWorker();
+}
+
+ScriptResult PythonWorker::execute(const std::string& pathToPythonScript,
+                                   const std::vector<std::string>& arguments,
+                                   const nlohmann::json& data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool workerRunning = socket_.is_open() && workerAlive_ && *workerAlive_;
+    if (!workerRunning) {
+        workerRunning = this->startWorker();
+    }
+    std::string request;
+    try {
+        request = nlohmann::json{{"id", ++requestId_},
+                                 {"command", "run"},
+                                 {"script", pathToPythonScript},
+                                 {"args", arguments},
+                                 {"data", data},
+                                 {"timeout", timeout_.count()}}.dump() + "\n";
+    } catch (const nlohmann::json::exception& exception) {
+        spdlog::error("Request for {} not valid: {}\n", pathToPythonScript, exception.what());
+        workerRunning = false;
+    }
+    if (!workerRunning) {
+        spdlog::warn("Python worker not available, running {} in a new process\n", pathToPythonScript);
+        return this->executeInNewProcess(pathToPythonScript, arguments);
+    }
+
+    ScriptResult result;
+    std::string response;
+    if (!this->exchange(request, response, timeout_ + shutdownTimeout_)) {
+        // The script is not sent again: it may already have written part of its results.
+        spdlog::error("Python worker lost while running {}, restarting it\n", pathToPythonScript);
+        result.error = "Python worker lost";
+        this->stopWorker();
+        this->startWorker();
+        return result;
+    }
+    try {
+        const nlohmann::json answer = nlohmann::json::parse(response);
+        result.exitCode = answer.value("exitCode", -1);
+        result.success = answer.value("status", "") == "ok";
+        result.output = answer.value("stdout", "");
+        result.error = answer.value("stderr", "");
+        result.duration = answer.value("duration", 0.0);
+    } catch (const nlohmann::json::exception& exception) {
+        spdlog::error("Answer of the python worker not valid: {}\n", exception.what());
+        result.error = response;
+    }
+    return result;
+}
+
+bool PythonWorker::isRunning() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return socket_.is_open() && workerAlive_ && *workerAlive_;
+}
+
+size_t PythonWorker::getStarts() const {
+    return workerStarts_;
+}
+
+bool PythonWorker::startWorker() {
+    spdlog::info("Method startWorker of Class PythonWorker\n");
+    this->stopWorker();
+    asio::error_code errorCode;
+    asio::ip::tcp::acceptor acceptor(ioContext_);
+    acceptor.open(asio::ip::tcp::v4(), errorCode);
+    if (!errorCode) {
+        acceptor.bind(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0), errorCode);
+    }
+    if (!errorCode) {
+        acceptor.listen(1, errorCode);
+    }
+    if (errorCode) {
+        spdlog::error("Socket for the python worker not opened: {}\n", errorCode.message());
+        return false;
+    }
+
+    const std::string command = pythonCommand_ + " \"" + pathToWorkerScript_.string() + "\" "
+                                               + std::to_string(acceptor.local_endpoint().port());
+    spdlog::debug("Executing: {}\n", command);
+    std::shared_ptr<std::atomic<bool>> workerAlive = std::make_shared<std::atomic<bool>>(true);
+    workerAlive_ = workerAlive;
+    supervisor_ = std::thread([command, workerAlive]() {
+        const int exitCode = std::system(command.data());
+        *workerAlive = false;
+        spdlog::info("Python worker exited with code {}\n", exitCode);
+    });
+
+    bool accepted = false;
+    acceptor.async_accept(socket_, [&accepted, &errorCode](const asio::error_code& acceptError) {
+        errorCode = acceptError;
+        accepted = true;
+    });
+    // The loop stops early if the worker exits without connecting (e.g. python or the worker script not found).
+    const auto deadline = std::chrono::steady_clock::now() + startTimeout_;
+    ioContext_.restart();
+    while (!accepted && *workerAlive && std::chrono::steady_clock::now() < deadline) {
+        ioContext_.run_for(std::chrono::milliseconds(100));
+    }
+    if (!accepted) {
+        acceptor.close();
+        ioContext_.restart();
+        ioContext_.run();
+    }
+    if (!accepted || errorCode) {
+        spdlog::error("Python worker {} not connected\n", pathToWorkerScript_.string());
+        this->stopWorker();
+        return false;
+    }
+    workerStarts_++;
+    spdlog::info("Python worker started\n");
+    return true;
+}
+
+void PythonWorker::stopWorker() {
+    asio::error_code errorCode;
+    if (socket_.is_open()) {
+        if (workerAlive_ && *workerAlive_) {
+            asio::write(socket_, asio::buffer(std::string("{\"command\": \"shutdown\"}\n")), errorCode);
+        }
+        socket_.shutdown(asio::ip::tcp::socket::shutdown_both, errorCode);
+        socket_.close(errorCode);
+    }
+    buffer_.consume(buffer_.size());
+    if (!supervisor_.joinable()) {
+        return;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + shutdownTimeout_;
+    while (*workerAlive_ && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (*workerAlive_) {
+        // The worker ends by itself at the timeout of the script (see PostProcessingWorker.py).
+        spdlog::warn("Python worker still running, detached\n");
+        supervisor_.detach();
+    } else {
+        supervisor_.join();
+    }
+}
+
+bool PythonWorker::exchange(const std::string& request,
+                            std::string& response,
+                            std::chrono::milliseconds timeout) {
+    asio::error_code errorCode;
+    asio::write(socket_, asio::buffer(request), errorCode);
+    if (errorCode) {
+        spdlog::error("Request not sent to the python worker: {}\n", errorCode.message());
+        return false;
+    }
+    bool completed = false;
+    asio::async_read_until(socket_, buffer_, '\n', [&completed, &errorCode](const asio::error_code& readError, size_t) {
+        errorCode = readError;
+        completed = true;
+    });
+    ioContext_.restart();
+    ioContext_.run_for(timeout);
+    if (!completed) {
+        spdlog::error("Python worker timeout ({} s)\n", std::chrono::duration_cast<std::chrono::seconds>(timeout).count());
+        socket_.close(errorCode);
+        ioContext_.restart();
+        ioContext_.run();
+        return false;
+    }
+    if (errorCode) {
+        spdlog::error("Answer of the python worker not received: {}\n", errorCode.message());
+        return false;
+    }
+    std::istream stream(&buffer_);
+    std::getline(stream, response);
+    return true;
+}
+
+ScriptResult PythonWorker::executeInNewProcess(const std::string& pathToPythonScript,
+                                               const std::vector<std::string>& arguments) {
+    std::string commandToExecuteScript = pythonCommand_ + " " + pathToPythonScript;
+    for (const std::string& argument : arguments) {
+        commandToExecuteScript += " " + argument;
+    }
+    spdlog::debug("Executing: {}\n", commandToExecuteScript);
+    ScriptResult result;
+    const auto start = std::chrono::steady_clock::now();
+    result.exitCode = std::system(commandToExecuteScript.data());
+    result.duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.success = result.exitCode == 0;
+    return result;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file PythonWorkerPostProcessing.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Implementation of Class @ref IPostProcessing running the python scripts in long-lived python workers.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "PythonWorkerPostProcessing.hpp"
+
+#include <algorithm>
+
+PythonWorkerPostProcessing::PythonWorkerPostProcessing(std::filesystem::path pathToWorkerScript,
+                                                       std::chrono::seconds timeout,
+                                                       std::string pythonCommand,
+                                                       size_t workersCount) {
+    spdlog::info("cTor PythonWorkerPostProcessing\n");
+    workersCount = std::max<size_t>(workersCount, 1);
+    for (size_t index = 0; index < workersCount; index++) {
+        workers_.push_back(std::make_unique<PythonWorker>(pathToWorkerScript, timeout, pythonCommand));
+    }
+    pool_ = std::make_unique<WorkerPool>(workersCount);
+}
+
+PythonWorkerPostProcessing::~PythonWorkerPostProcessing() {
+    spdlog::info("dTor PythonWorkerPostProcessing\n");
+    pool_.reset();  // runs the queued scripts while the workers are still available
+}
+
+void PythonWorkerPostProcessing::executeScript1(std::string pathToPythonScript,
+                                                std::string argument1) {
+    spdlog::info("Method executeScript1 of Class PythonWorkerPostProcessing\n");
+    this->execute(pathToPythonScript, {argument1});
+}
+
+void PythonWorkerPostProcessing::executeScript2(std::string pathToPythonScript,
+                                                std::string argument1,
+                                                std::string argument2) {
+    spdlog::info("Method executeScript2 of Class PythonWorkerPostProcessing\n");
+    this->execute(pathToPythonScript, {argument1, argument2});
+}
+
+void PythonWorkerPostProcessing::executeScript5(std::string pathToPythonScript,
+                                                std::string argument1,
+                                                std::string argument2,
+                                                std::string argument3,
+                                                std::string argument4,
+                                                std::string argument5) {
+    spdlog::info("Method executeScript5 of Class PythonWorkerPostProcessing\n");
+    this->execute(pathToPythonScript, {argument1, argument2, argument3, argument4, argument5});
+}
+
+void PythonWorkerPostProcessing::executeScript6(std::string pathToPythonScript,
+                                                std::string argument1,
+                                                std::string argument2,
+                                                std::string argument3,
+                                                std::string argument4,
+                                                std::string argument5,
+                                                std::string argument6) {
+    spdlog::info("Method executeScript6 of Class PythonWorkerPostProcessing\n");
+    this->execute(pathToPythonScript, {argument1, argument2, argument3, argument4, argument5, argument6});
+}
+
+void PythonWorkerPostProcessing::executeScript7(std::string pathToPythonScript,
+                                                std::string argument1,
+                                                std::string argument2,
+                                                std::string argument3,
+                                                std::string argument4,
+                                                std::string argument5,
+                                                std::string argument6,
+                                                std::string argument7) {
+    spdlog::info("Method executeScript7 of Class PythonWorkerPostProcessing\n");
+    this->execute(pathToPythonScript, {argument1, argument2, argument3, argument4, argument5, argument6, argument7});
+}
+
+std::future<ScriptResult> PythonWorkerPostProcessing::executeScriptAsync(std::string pathToPythonScript,
+                                                                         std::vector<std::string> arguments,
+                                                                         std::string sequence) {
+    spdlog::info("Method executeScriptAsync of Class PythonWorkerPostProcessing\n");
+    return this->executeAsync(pathToPythonScript, arguments, sequence);
+}
+
+std::future<ScriptResult> PythonWorkerPostProcessing::executeAsync(const std::string& pathToPythonScript,
+                                                                   const std::vector<std::string>& arguments,
+                                                                   const std::string& sequence,
+                                                                   const nlohmann::json& data) {
+    auto script = std::make_shared<std::packaged_task<ScriptResult(size_t)>>(
+        [this, pathToPythonScript, arguments, data](size_t lane) {
+            ScriptResult result = workers_[lane]->execute(pathToPythonScript, arguments, data);
+            logResult(pathToPythonScript, result);
+            return result;
+        });
+    std::future<ScriptResult> result = script->get_future();
+    pool_->submit(sequence, [script](size_t lane) { (*script)(lane); });
+    return result;
+}
+
+ScriptResult PythonWorkerPostProcessing::execute(const std::string& pathToPythonScript,
+                                                 const std::vector<std::string>& arguments,
+                                                 const nlohmann::json& data) {
+    return this->executeAsync(pathToPythonScript, arguments, "", data).get();
+}
+
+bool PythonWorkerPostProcessing::isWorkerRunning() {
+    return std::any_of(workers_.begin(), workers_.end(),
+                       [](const std::unique_ptr<PythonWorker>& worker) { return worker->isRunning(); });
+}
+
+size_t PythonWorkerPostProcessing::getWorkerStarts() const {
+    size_t starts = 0;
+    for (const std::unique_ptr<PythonWorker>& worker : workers_) {
+        starts += worker->getStarts();
+    }
+    return starts;
+}
+
+void PythonWorkerPostProcessing::logResult(const std::string& pathToPythonScript, const ScriptResult& result) {
+    if (!result.output.empty()) {
+        spdlog::info("{}\n", result.output);
+    }
+    if (!result.success) {
+        spdlog::error("Script {} failed (exit code {}): {}\n", pathToPythonScript, result.exitCode, result.error);
+    }
+    spdlog::debug("Script {} executed in {} s\n", pathToPythonScript, result.duration);
+}
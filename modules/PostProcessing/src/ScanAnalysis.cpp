@@ -0,0 +1,309 @@
+/**
+ * @file ScanAnalysis.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Native analysis of the scans (smoothing, half maximum crossings, peak centre and linear fit).
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "ScanAnalysis.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace analysis {
+
+namespace {
+
+/**
+ * @brief Solve a linear system with gaussian elimination and partial pivoting.
+ *
+ * @param matrix square matrix of the system (row major), overwritten.
+ * @param rhs right hand side of the system, overwritten with the solution.
+ * @return true if the system was solved.
+ * @return false if the matrix is singular.
+ */
+bool solveLinearSystem(std::vector<std::vector<double>>& matrix, std::vector<double>& rhs) {
+    const size_t size = rhs.size();
+    for (size_t column = 0; column < size; column++) {
+        size_t pivot = column;
+        for (size_t row = column + 1; row < size; row++) {
+            if (std::fabs(matrix[row][column]) > std::fabs(matrix[pivot][column])) {
+                pivot = row;
+            }
+        }
+        if (matrix[pivot][column] == 0) {
+            return false;
+        }
+        std::swap(matrix[pivot], matrix[column]);
+        std::swap(rhs[pivot], rhs[column]);
+        for (size_t row = column + 1; row < size; row++) {
+            const double factor = matrix[row][column] / matrix[column][column];
+            for (size_t k = column; k < size; k++) {
+                matrix[row][k] -= factor * matrix[column][k];
+            }
+            rhs[row] -= factor * rhs[column];
+        }
+    }
+    for (size_t row = size; row-- > 0;) {
+        for (size_t k = row + 1; k < size; k++) {
+            rhs[row] -= matrix[row][k] * rhs[k];
+        }
+        rhs[row] /= matrix[row][row];
+    }
+    return true;
+}
+
+/**
+ * @brief Build the normal matrix (A^T A) of a polynomial least squares fit.
+ *
+ * @param t coordinates of the points.
+ * @param order order of the polynomial.
+ * @return std::vector<std::vector<double>> normal matrix.
+ */
+std::vector<std::vector<double>> normalMatrix(const std::vector<double>& t, size_t order) {
+    std::vector<double> powerSums(2 * order + 1, 0);
+    for (double coordinate : t) {
+        double power = 1;
+        for (double& sum : powerSums) {
+            sum += power;
+            power *= coordinate;
+        }
+    }
+    std::vector<std::vector<double>> matrix(order + 1, std::vector<double>(order + 1));
+    for (size_t row = 0; row <= order; row++) {
+        for (size_t column = 0; column <= order; column++) {
+            matrix[row][column] = powerSums[row + column];
+        }
+    }
+    return matrix;
+}
+
+/**
+ * @brief Evaluate a polynomial with the Horner scheme.
+ *
+ * @param coefficients coefficients of the polynomial in increasing order.
+ * @param t coordinate.
+ * @return double value of the polynomial.
+ */
+double evaluatePolynomial(const std::vector<double>& coefficients, double t) {
+    double value = 0;
+    for (size_t k = coefficients.size(); k-- > 0;) {
+        value = value * t + coefficients[k];
+    }
+    return value;
+}
+
+/**
+ * @brief Fit a polynomial on a window of the signal and evaluate it on a range of points of the window
+ * (same as _fit_edge of scipy).
+ *
+ * @param y signal.
+ * @param windowStart index of the first point of the window.
+ * @param windowLength number of points of the window.
+ * @param polyOrder order of the polynomial.
+ * @param interpStart index of the first point to be evaluated.
+ * @param interpStop index after the last point to be evaluated.
+ * @param smoothed smoothed signal, updated in the range.
+ */
+void fitEdge(const std::vector<double>& y, size_t windowStart, size_t windowLength, size_t polyOrder,
+             size_t interpStart, size_t interpStop, std::vector<double>& smoothed) {
+    const double centre = (static_cast<double>(windowLength) - 1) / 2;
+    std::vector<double> t(windowLength);
+    std::vector<double> window(y.begin() + windowStart, y.begin() + windowStart + windowLength);
+    for (size_t j = 0; j < windowLength; j++) {
+        t[j] = static_cast<double>(j) - centre;
+    }
+    std::vector<double> coefficients;
+    if (!polynomialFit(t, window, polyOrder, coefficients)) {
+        return;
+    }
+    for (size_t i = interpStart; i < interpStop; i++) {
+        smoothed[i] = evaluatePolynomial(coefficients, static_cast<double>(i - windowStart) - centre);
+    }
+}
+
+}  // namespace
+
+std::vector<double> savitzkyGolay(const std::vector<double>& y, size_t windowLength, size_t polyOrder) {
+    if (polyOrder >= windowLength || windowLength > y.size()) {
+        spdlog::error("Savitzky-Golay filter: window length {} not valid for polyorder {} and {} points\n",
+                      windowLength, polyOrder, y.size());
+        return y;
+    }
+    // Weights of the window: value at the centre of the window of the fitted polynomial (first row of (A^T A)^-1 A^T).
+    const double centre = (static_cast<double>(windowLength) - 1) / 2;
+    std::vector<double> t(windowLength);
+    for (size_t j = 0; j < windowLength; j++) {
+        t[j] = static_cast<double>(j) - centre;
+    }
+    std::vector<std::vector<double>> matrix = normalMatrix(t, polyOrder);
+    std::vector<double> g(polyOrder + 1, 0);
+    g[0] = 1;
+    if (!solveLinearSystem(matrix, g)) {
+        return y;
+    }
+    std::vector<double> weights(windowLength);
+    for (size_t j = 0; j < windowLength; j++) {
+        weights[j] = evaluatePolynomial(g, t[j]);
+    }
+
+    const size_t halfLength = windowLength / 2;
+    const size_t offset = (windowLength - 1) / 2;  // The window of point i starts at i - offset
+    std::vector<double> smoothed(y.size());
+    for (size_t i = halfLength; i + halfLength < y.size(); i++) {
+        smoothed[i] = std::inner_product(weights.begin(), weights.end(), y.begin() + (i - offset), 0.0);
+    }
+    fitEdge(y, 0, windowLength, polyOrder, 0, halfLength, smoothed);
+    fitEdge(y, y.size() - windowLength, windowLength, polyOrder, y.size() - halfLength, y.size(), smoothed);
+    return smoothed;
+}
+
+bool polynomialFit(const std::vector<double>& x, const std::vector<double>& y, size_t order, std::vector<double>& coefficients) {
+    if (x.size() != y.size() || x.size() <= order) {
+        spdlog::error("Polynomial fit: {} points not enough for order {}\n", std::min(x.size(), y.size()), order);
+        return false;
+    }
+    // The fit is done on centred and scaled coordinates to keep the normal matrix well conditioned.
+    const double shift = mean(x, 0, x.size());
+    double scale = 0;
+    for (double value : x) {
+        scale = std::max(scale, std::fabs(value - shift));
+    }
+    if (scale == 0) {
+        spdlog::error("Polynomial fit: all the x values are equal\n");
+        return false;
+    }
+    std::vector<double> t(x.size());
+    std::transform(x.begin(), x.end(), t.begin(), [shift, scale](double value) { return (value - shift) / scale; });
+    std::vector<std::vector<double>> matrix = normalMatrix(t, order);
+    std::vector<double> scaled(order + 1, 0);
+    for (size_t i = 0; i < t.size(); i++) {
+        double power = 1;
+        for (double& element : scaled) {
+            element += power * y[i];
+            power *= t[i];
+        }
+    }
+    if (!solveLinearSystem(matrix, scaled)) {
+        spdlog::error("Polynomial fit: singular system\n");
+        return false;
+    }
+    // Back to the coefficients of x: sum_k c_k ((x - shift) / scale)^k
+    coefficients.assign(order + 1, 0);
+    for (size_t k = 0; k <= order; k++) {
+        const double factor = scaled[k] / std::pow(scale, static_cast<double>(k));
+        double binomial = 1;
+        for (size_t j = 0; j <= k; j++) {
+            coefficients[j] += factor * binomial * std::pow(-shift, static_cast<double>(k - j));
+            binomial = binomial * static_cast<double>(k - j) / static_cast<double>(j + 1);
+        }
+    }
+    return true;
+}
+
+LinearFit linearFit(const std::vector<double>& x, const std::vector<double>& y) {
+    LinearFit fit;
+    std::vector<double> coefficients;
+    if (polynomialFit(x, y, 1, coefficients)) {
+        fit.valid = true;
+        fit.intercept = coefficients[0];
+        fit.slope = coefficients[1];
+    }
+    return fit;
+}
+
+double interpolateX(const std::vector<double>& x, const std::vector<double>& y, size_t index, double level) {
+    return x[index] + (x[index + 1] - x[index]) * ((level - y[index]) / (y[index + 1] - y[index]));
+}
+
+double interpolateY(const std::vector<double>& x, const std::vector<double>& y, size_t index, double position) {
+    return y[index] + (y[index + 1] - y[index]) * ((position - x[index]) / (x[index + 1] - x[index]));
+}
+
+std::vector<size_t> findCrossings(const std::vector<double>& values, double level) {
+    auto sign = [level](double value) { return (value > level) - (value < level); };
+    std::vector<size_t> crossings;
+    for (size_t i = 0; i + 2 < values.size(); i++) {
+        if (sign(values[i]) != sign(values[i + 1])) {
+            crossings.push_back(i);
+        }
+    }
+    return crossings;
+}
+
+HalfMaximum halfMaximum(const std::vector<double>& x, const std::vector<double>& y) {
+    HalfMaximum result;
+    if (y.empty() || x.size() != y.size()) {
+        spdlog::error("Half maximum: {} x values and {} y values\n", x.size(), y.size());
+        return result;
+    }
+    const auto [minimum, maximum] = std::minmax_element(y.begin(), y.end());
+    result.maximum = *maximum;
+    result.minimum = *minimum;
+    result.half = (result.maximum + result.minimum) / 2;
+    const std::vector<size_t> crossings = findCrossings(y, result.half);
+    if (crossings.size() < 2) {
+        spdlog::error("Half maximum: {} crossings found, 2 expected\n", crossings.size());
+        return result;
+    }
+    result.firstCrossing = interpolateX(x, y, crossings[0], result.half);
+    result.secondCrossing = interpolateX(x, y, crossings[1], result.half);
+    result.valid = true;
+    return result;
+}
+
+bool halfLevelPosition(const std::vector<double>& x, const std::vector<double>& y, double levelStart, double levelEnd, double& position) {
+    const double half = (levelStart + levelEnd) / 2;
+    const std::vector<size_t> crossings = findCrossings(y, half);
+    if (crossings.empty() || x.size() != y.size()) {
+        spdlog::error("Half level position: level {} not crossed\n", half);
+        return false;
+    }
+    position = interpolateX(x, y, crossings[0], half);
+    return true;
+}
+
+bool valueAtPosition(const std::vector<double>& x, const std::vector<double>& y, double position, double& value) {
+    const std::vector<size_t> crossings = findCrossings(x, position);
+    if (crossings.empty() || x.size() != y.size()) {
+        spdlog::error("Value at position: position {} outside of the scan\n", position);
+        return false;
+    }
+    value = interpolateY(x, y, crossings[0], position);
+    return true;
+}
+
+Peak findPeak(const std::vector<double>& x, const std::vector<double>& y) {
+    Peak peak;
+    peak.halfMaximum = halfMaximum(x, y);
+    if (!peak.halfMaximum.valid) {
+        return peak;
+    }
+    peak.centre = peak.halfMaximum.getCentre();
+    peak.fwhm = peak.halfMaximum.getFwhm();
+    peak.valid = valueAtPosition(x, y, peak.centre, peak.value);
+    return peak;
+}
+
+Peak analyseRockingCurve(const std::vector<double>& x,
+                         const std::vector<double>& y,
+                         size_t windowLength,
+                         size_t polyOrder) {
+    return findPeak(x, savitzkyGolay(y, windowLength, polyOrder));
+}
+
+double mean(const std::vector<double>& values, size_t begin, size_t end) {
+    end = std::min(end, values.size());
+    if (begin >= end) {
+        return 0;
+    }
+    return std::accumulate(values.begin() + begin, values.begin() + end, 0.0) / static_cast<double>(end - begin);
+}
+
+}  // namespace analysis
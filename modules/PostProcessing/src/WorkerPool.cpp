@@ -0,0 +1,92 @@
+/**
+ * @file WorkerPool.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Pool of threads running the post processing tasks in background.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t lanesCount) {
+    lanesCount = std::max<size_t>(lanesCount, 1);
+    for (size_t index = 0; index < lanesCount; index++) {
+        lanes_.push_back(std::make_unique<Lane>());
+    }
+    for (size_t index = 0; index < lanesCount; index++) {
+        lanes_[index]->thread = std::thread(&WorkerPool::run, this, index);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    for (std::unique_ptr<Lane>& lane : lanes_) {
+        lane->condition.notify_all();
+        lane->thread.join();
+    }
+}
+
+size_t WorkerPool::submit(const std::string& sequence, Task task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto lessPending = [](const std::unique_ptr<Lane>& first, const std::unique_ptr<Lane>& second) {
+        return first->pending < second->pending;
+    };
+    size_t index = std::min_element(lanes_.begin(), lanes_.end(), lessPending) - lanes_.begin();
+    if (!sequence.empty()) {
+        auto it = sequences_.try_emplace(sequence, Sequence{index, 0}).first;
+        index = it->second.lane;
+        it->second.pending++;
+    }
+    Lane& lane = *lanes_[index];
+    lane.pending++;
+    lane.tasks.emplace_back(sequence, std::move(task));
+    lane.condition.notify_one();
+    return index;
+}
+
+size_t WorkerPool::getLanesCount() const {
+    return lanes_.size();
+}
+
+size_t WorkerPool::getPendingTasks() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t pending = 0;
+    for (const std::unique_ptr<Lane>& lane : lanes_) {
+        pending += lane->pending;
+    }
+    return pending;
+}
+
+void WorkerPool::run(size_t index) {
+    Lane& lane = *lanes_[index];
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        lane.condition.wait(lock, [this, &lane] { return stopped_ || !lane.tasks.empty(); });
+        if (lane.tasks.empty()) {
+            return;  // stopped and nothing left to run
+        }
+        auto [sequence, task] = std::move(lane.tasks.front());
+        lane.tasks.pop_front();
+        lock.unlock();
+        try {
+            task(index);
+        } catch (const std::exception& exception) {
+            spdlog::error("Post processing task failed: {}\n", exception.what());
+        }
+        lock.lock();
+        lane.pending--;
+        auto it = sequences_.find(sequence);
+        if (it != sequences_.end() && --it->second.pending == 0) {
+            sequences_.erase(it);  // the next task of the sequence can go to any lane
+        }
+    }
+}
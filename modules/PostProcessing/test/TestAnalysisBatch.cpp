@@ -0,0 +1,70 @@
+/**
+ * @file TestAnalysisBatch.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test methods of class 'AnalysisBatch'.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <vector>
+
+#include "AnalysisBatch.hpp"
+
+/**
+ * @brief Get the future of a script already ended.
+ *
+ * @param success true if the script succeeded.
+ * @return std::future<ScriptResult> ready future.
+ */
+static std::future<ScriptResult> endedScript(bool success) {
+    ScriptResult ended;
+    ended.success = success;
+    ended.exitCode = success ? 0 : 1;
+    std::promise<ScriptResult> result;
+    result.set_value(ended);
+    return result.get_future();
+}
+
+/**
+ * @brief Test case that checks that the callbacks are called in submission order, once the previous analyses ended.
+ *
+ */
+TEST(TestAnalysisBatch, Callbacks_in_order) {
+    AnalysisBatch analyses;
+    std::vector<int> completed;
+    std::promise<ScriptResult> first;
+    analyses.add(first.get_future(), [&completed](const ScriptResult&) { completed.push_back(0); });
+    analyses.add(endedScript(true), [&completed](const ScriptResult&) { completed.push_back(1); });
+    EXPECT_TRUE(completed.empty());  // the second analysis waits for the first one
+    EXPECT_EQ(2u, analyses.getPendingAnalyses());
+    first.set_value(endedScript(true).get());
+    analyses.collect();
+    EXPECT_EQ((std::vector<int>{0, 1}), completed);
+    EXPECT_TRUE(analyses.wait());
+}
+
+/**
+ * @brief Test case that checks that no callback is called after a failure and that the temporary files are removed.
+ *
+ */
+TEST(TestAnalysisBatch, Failure_stops_callbacks) {
+    const std::filesystem::path temporaryFile = std::filesystem::temp_directory_path() / "TestAnalysisBatch_scan_0.csv";
+    std::ofstream(temporaryFile) << "W;Counts\n";
+    AnalysisBatch analyses;
+    int completed = 0;
+    analyses.add(endedScript(false), [&completed](const ScriptResult&) { completed++; }, temporaryFile);
+    analyses.add(endedScript(true), [&completed](const ScriptResult&) { completed++; });
+    analyses.add(std::future<ScriptResult>());  // script not queued
+    EXPECT_FALSE(analyses.wait());
+    EXPECT_EQ(0, completed);
+    EXPECT_EQ(0u, analyses.getPendingAnalyses());
+    EXPECT_FALSE(std::filesystem::exists(temporaryFile));
+}
@@ -0,0 +1,143 @@
+/**
+ * @file TestBatchReprocessing.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the reprocessing of archived scans and spectra ('BatchReprocessing').
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BatchReprocessing.hpp"
+
+/**
+ * @brief Test fixture called 'TestBatchReprocessing' writing an archive of scans and spectra.
+ *
+ */
+struct TestBatchReprocessing : public ::testing::Test {
+    void SetUp() override {
+        std::filesystem::create_directories(directory / "spectra");
+    }
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+    /**
+     * @brief Write a data log of a W scan, as done by Sensors::startAcquisitionCrystal.
+     *
+     * @param name name of the data log.
+     * @param centre position of the peak of the rocking curve.
+     * @return std::filesystem::path path to the data log.
+     */
+    std::filesystem::path writeScanLog(const std::string& name, double centre) {
+        const std::filesystem::path path = directory / name;
+        std::ofstream scanLog(path);
+        scanLog << "X-Ray Sensor Data;HXP X-Axis;HXP Y-Axis;HXP Z-Axis;HXP U-Axis;HXP V-Axis;HXP W-Axis;\n";
+        for (int index = 0; index <= 40; index++) {
+            const double position = index * 0.05;
+            const int counts = static_cast<int>(50 + 1000 * std::exp(-std::pow((position - centre) / 0.2, 2)));
+            scanLog << counts << ";0;0;0;0;0;" << position << ";\n";
+        }
+        return path;
+    }
+    /**
+     * @brief Write a spectrum, in the format of the .mca files of the x-ray sensor.
+     *
+     * @param name name of the .mca file.
+     * @param counts counts of the channels.
+     * @return std::filesystem::path path to the spectrum.
+     */
+    std::filesystem::path writeSpectrum(const std::string& name, const std::vector<int>& counts) {
+        const std::filesystem::path path = directory / "spectra" / name;
+        std::ofstream spectrum(path);
+        spectrum << "<<PMCA SPECTRUM>>\r\nTAG - TestTag\r\n<<DATA>>\r\n";
+        for (int count : counts) {
+            spectrum << count << "\r\n";
+        }
+        spectrum << "<<END>>\r\n<<DPP STATUS>>\r\n";
+        return path;
+    }
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "TestBatchReprocessing";  /**< Archive. */
+};
+
+/**
+ * @brief Test case that checks that the peak of an archived scan is the one found on the arrays of the scan.
+ *
+ */
+TEST_F(TestBatchReprocessing, Scan_log_peak) {
+    const std::filesystem::path path = writeScanLog("scan.csv", 1.0);
+    analysis::ScanLog scanLog;
+    ASSERT_TRUE(analysis::readScanLog(path, scanLog));
+    ASSERT_EQ(7u, scanLog.columns.size());
+    ASSERT_NE(nullptr, scanLog.getColumn("HXP W-Axis"));
+    EXPECT_EQ(41u, scanLog.getColumn("HXP W-Axis")->size());
+    const analysis::ReprocessingResult result = analysis::reprocessFile(path, analysis::ReprocessingSettings());
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(41u, result.points);
+    const analysis::Peak expected = analysis::analyseRockingCurve(*scanLog.getColumn("HXP W-Axis"),
+                                                                  *scanLog.getColumn("X-Ray Sensor Data"));
+    EXPECT_DOUBLE_EQ(expected.centre, result.peak.centre);
+    EXPECT_NEAR(1.0, result.peak.centre, 0.05);
+}
+
+/**
+ * @brief Test case that checks the integrals of the regions of interest of an archived spectrum.
+ *
+ */
+TEST_F(TestBatchReprocessing, Spectrum_regions) {
+    const std::filesystem::path path = writeSpectrum("spectrum.mca", {0, 2, 4, 6, 8, 10});
+    analysis::ReprocessingSettings settings;
+    settings.regions = {{"K_ALPHA", 1, 3}, {"K_BETA", 3, 5}};
+    const analysis::ReprocessingResult result = analysis::reprocessFile(path, settings);
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(6u, result.points);
+    EXPECT_EQ((std::vector<double>{8, 16}), result.integrals);
+    settings.regions = {{"OUTSIDE", 3, 6}};
+    EXPECT_FALSE(analysis::reprocessFile(path, settings).success);
+}
+
+/**
+ * @brief Test case that checks that the batch gives the results of the sequential reprocessing, with the rows of the summary
+ * in the order of the files.
+ *
+ */
+TEST_F(TestBatchReprocessing, Batch_matches_sequential) {
+    for (int index = 0; index < 20; index++) {
+        writeScanLog("scan_" + std::to_string(10 + index) + ".csv", 0.5 + index * 0.05);
+    }
+    std::ofstream(directory / "scan_99.csv") << "X-Ray Sensor Data;Stepper Motor Position;\n";  // scan stopped before the first point
+    writeSpectrum("spectrum.mca", std::vector<int>(100, 1));
+    const std::vector<std::filesystem::path> files = analysis::findArchivedFiles(directory);
+    ASSERT_EQ(22u, files.size());
+    analysis::ReprocessingSettings settings;
+    settings.regions = {{"K_ALPHA", 10, 20}};
+    settings.threads = 4;
+    std::ostringstream summary;
+    const std::vector<analysis::ReprocessingResult> results = analysis::BatchReprocessing(settings).run(files, summary);
+    ASSERT_EQ(files.size(), results.size());
+    std::istringstream rows(summary.str());
+    std::string row;
+    std::getline(rows, row);
+    EXPECT_EQ("File,Status,Points,Peak Centre,FWHM,Peak Value,K_ALPHA,Error", row);
+    for (size_t index = 0; index < files.size(); index++) {
+        const analysis::ReprocessingResult expected = analysis::reprocessFile(files[index], settings);
+        EXPECT_EQ(files[index], results[index].file);
+        EXPECT_EQ(expected.success, results[index].success);
+        EXPECT_DOUBLE_EQ(expected.peak.centre, results[index].peak.centre);
+        EXPECT_EQ(expected.integrals, results[index].integrals);
+        ASSERT_TRUE(std::getline(rows, row));
+        EXPECT_EQ(0u, row.find(files[index].string() + ","));
+    }
+    EXPECT_FALSE(results[20].success);  // scan_99.csv
+    EXPECT_EQ((std::vector<double>{10}), results[21].integrals);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file TestCrystalAngles.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the estimators of 'CrystalAngles' against the least squares results of the measurement scripts.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include "CrystalAngles.hpp"
+
+/**
+ * @brief Test fixture with the Bragg peaks of a Y scan. The slope (0.00207879) and its standard error (0.0001008) were
+ * computed with np.polyfit(y, w, 1, cov=True).
+ *
+ */
+struct TestCrystalAngles : public ::testing::Test {
+    std::vector<double> yPositions = {0, 0.5, 1, 1.5, 2, 2.5, 3, 3.5, 4, 4.5};  /**< Positions of the Y axis. */
+    std::vector<double> braggAngles = {1.2000, 1.2017, 1.2016, 1.2035, 1.2036,
+                                       1.2058, 1.2062, 1.2071, 1.2082, 1.2098};  /**< W positions of the peaks. */
+};
+
+/**
+ * @brief Test case that checks the bending angle and that its uncertainty is close to the standard error of the slope.
+ *
+ */
+TEST_F(TestCrystalAngles, Bending_angle) {
+    const analysis::AngleEstimate estimate = analysis::bendingAngle(yPositions, braggAngles, 2.0);
+    ASSERT_TRUE(estimate.valid);
+    EXPECT_EQ(10u, estimate.points);
+    EXPECT_NEAR(2 * 0.00207879, estimate.value, 1e-8);
+    EXPECT_NEAR(2 * 0.0001008, estimate.sigma, 2 * 0.0001008 * 0.1);
+}
+
+/**
+ * @brief Test case that checks that the uncertainty does not depend on the number of threads.
+ *
+ */
+TEST_F(TestCrystalAngles, Bootstrap_is_reproducible) {
+    analysis::BootstrapSettings oneThread;
+    oneThread.threads = 1;
+    analysis::BootstrapSettings fourThreads;
+    fourThreads.threads = 4;
+    const analysis::AngleEstimate first = analysis::torsionAngle(yPositions, braggAngles, oneThread);
+    const analysis::AngleEstimate second = analysis::torsionAngle(yPositions, braggAngles, fourThreads);
+    EXPECT_DOUBLE_EQ(first.sigma, second.sigma);
+    EXPECT_GT(first.sigma, 0);
+}
+
+/**
+ * @brief Test case that checks the exact slope of aligned peaks and the minimum number of peaks.
+ *
+ */
+TEST_F(TestCrystalAngles, Torsion_angle) {
+    const analysis::AngleEstimate aligned = analysis::torsionAngle({0, 1, 2, 3}, {1.0, 1.5, 2.0, 2.5});
+    ASSERT_TRUE(aligned.valid);
+    EXPECT_NEAR(0.5, aligned.value, 1e-12);
+    EXPECT_NEAR(0, aligned.sigma, 1e-12);
+    EXPECT_FALSE(analysis::torsionAngle({0, 1}, {1.0, 1.5}).valid);
+}
+
+/**
+ * @brief Test case that checks the miscut angle and its uncertainty (standard error of the mean).
+ *
+ */
+TEST_F(TestCrystalAngles, Miscut_angle) {
+    const std::vector<double> braggAngles180 = {1.1900, 1.1921, 1.1912, 1.1939, 1.1932,
+                                                1.1962, 1.1958, 1.1975, 1.1980, 1.1994};
+    const analysis::AngleEstimate estimate = analysis::miscutAngle(braggAngles, braggAngles180);
+    ASSERT_TRUE(estimate.valid);
+    EXPECT_NEAR(0.00501, estimate.value, 1e-9);
+    // bootstrap standard error of the mean of the half differences: np.std(d) / sqrt(10)
+    EXPECT_NEAR(0.0000574, estimate.sigma, 0.0000574 * 0.1);
+    EXPECT_FALSE(analysis::miscutAngle(braggAngles, {1.19}).valid);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file TestPythonWorkerPostProcessing.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test methods of class 'PythonWorkerPostProcessing' (requires a python interpreter).
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <future>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "PythonWorkerPostProcessing.hpp"
+
+/**
+ * @brief Test fixture called 'TestPythonWorkerPostProcessing', which inherits from 'testing::Test'.
+ *
+ */
+struct TestPythonWorkerPostProcessing : public ::testing::Test {
+    /**
+     * @brief Write the scripts used by the tests.
+     *
+     */
+    void SetUp() override {
+        std::filesystem::create_directories(directory);
+        std::ofstream(directory / "arguments.py") << "import os, sys\nprint(os.getpid(), *sys.argv[1:])\n";
+        std::ofstream(directory / "data.py") << "print(sum(WORKER_DATA['counts']))\n";
+        std::ofstream(directory / "failure.py") << "import sys\nsys.exit(2)\n";
+        std::ofstream(directory / "exception.py") << "raise ValueError('bad scan')\n";
+        std::ofstream(directory / "sleep.py") << "import time\ntime.sleep(10)\n";
+        std::ofstream(directory / "append.py") << "import sys, time\ntime.sleep(float(sys.argv[3]))\n"
+                                                  "open(sys.argv[1], 'a').write(sys.argv[2] + '\\n')\n";
+        if (std::system((pythonCommand + " --version").data()) != 0) {
+            GTEST_SKIP() << "Python interpreter not found";
+        }
+    }
+    /**
+     * @brief Remove the scripts used by the tests.
+     *
+     */
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+    /**
+     * @brief Get the path of a script used by the tests.
+     *
+     * @param name name of the script.
+     * @return std::string path to the script.
+     */
+    std::string script(const std::string& name) {
+        return (directory / name).string();
+    }
+
+#ifdef _WIN32
+    std::string pythonCommand = "py";  /**< Command used to start the python interpreter. */
+#else
+    std::string pythonCommand = "python3";  /**< Command used to start the python interpreter. */
+#endif
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "TestPythonWorkerPostProcessing";  /**< Directory of the scripts. */
+    std::filesystem::path pathToWorkerScript = std::filesystem::path(__FILE__).parent_path().parent_path().parent_path() /
+        "Devices" / "scripts" / "PostProcessingWorker.py";  /**< Path to the script of the worker. */
+};
+
+/**
+ * @brief Test case that checks that the scripts receive the arguments and run in the same worker.
+ *
+ */
+TEST_F(TestPythonWorkerPostProcessing, Worker_is_reused) {
+    PythonWorkerPostProcessing postProcessing(pathToWorkerScript, std::chrono::seconds(30), pythonCommand, 1);
+    const ScriptResult first = postProcessing.execute(script("arguments.py"), {"scan.csv", "2"});
+    const ScriptResult second = postProcessing.execute(script("arguments.py"), {"scan2.csv"});
+    ASSERT_TRUE(first.success);
+    ASSERT_TRUE(second.success);
+    const std::string pid = first.output.substr(0, first.output.find(' '));
+    EXPECT_EQ(pid + " scan.csv 2\n", first.output);
+    EXPECT_EQ(pid + " scan2.csv\n", second.output);
+    EXPECT_EQ(1u, postProcessing.getWorkerStarts());
+    EXPECT_TRUE(postProcessing.isWorkerRunning());
+}
+
+/**
+ * @brief Test case that checks that the in-memory data are available to the script.
+ *
+ */
+TEST_F(TestPythonWorkerPostProcessing, In_memory_data) {
+    PythonWorkerPostProcessing postProcessing(pathToWorkerScript, std::chrono::seconds(30), pythonCommand, 1);
+    const ScriptResult result = postProcessing.execute(script("data.py"), {}, {{"counts", {1, 2, 3}}});
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ("6\n", result.output);
+}
+
+/**
+ * @brief Test case that checks the exit code and the traceback of the scripts that fail.
+ *
+ */
+TEST_F(TestPythonWorkerPostProcessing, Failures_are_reported) {
+    PythonWorkerPostProcessing postProcessing(pathToWorkerScript, std::chrono::seconds(30), pythonCommand, 1);
+    const ScriptResult failure = postProcessing.execute(script("failure.py"), {});
+    EXPECT_FALSE(failure.success);
+    EXPECT_EQ(2, failure.exitCode);
+    const ScriptResult exception = postProcessing.execute(script("exception.py"), {});
+    EXPECT_FALSE(exception.success);
+    EXPECT_NE(std::string::npos, exception.error.find("ValueError: bad scan"));
+    EXPECT_TRUE(postProcessing.execute(script("arguments.py"), {}).success);
+    EXPECT_EQ(1u, postProcessing.getWorkerStarts());
+}
+
+/**
+ * @brief Test case that checks that a new worker is started after a timeout.
+ *
+ */
+TEST_F(TestPythonWorkerPostProcessing, Restart_after_timeout) {
+    PythonWorkerPostProcessing postProcessing(pathToWorkerScript, std::chrono::seconds(1), pythonCommand, 1);
+    const ScriptResult first = postProcessing.execute(script("arguments.py"), {});
+    const ScriptResult timeout = postProcessing.execute(script("sleep.py"), {});
+    const ScriptResult second = postProcessing.execute(script("arguments.py"), {});
+    ASSERT_TRUE(first.success);
+    EXPECT_FALSE(timeout.success);
+    ASSERT_TRUE(second.success);
+    EXPECT_NE(first.output, second.output);
+    EXPECT_EQ(2u, postProcessing.getWorkerStarts());
+}
+
+/**
+ * @brief Test case that checks that the scripts run in a new process if the worker cannot be started.
+ *
+ */
+TEST_F(TestPythonWorkerPostProcessing, Fallback_without_worker) {
+    PythonWorkerPostProcessing postProcessing(directory / "missing.py", std::chrono::seconds(30), pythonCommand, 1);
+    EXPECT_TRUE(postProcessing.execute(script("arguments.py"), {}).success);
+    EXPECT_EQ(0u, postProcessing.getWorkerStarts());
+    EXPECT_FALSE(postProcessing.execute(script("failure.py"), {}).success);
+}
+
+/**
+ * @brief Test case that checks that the scripts of the same sequence run in submission order, the others in parallel.
+ *
+ */
+TEST_F(TestPythonWorkerPostProcessing, Sequences_keep_order) {
+    PythonWorkerPostProcessing postProcessing(pathToWorkerScript, std::chrono::seconds(30), pythonCommand, 2);
+    const std::string peaks = (directory / "peaks.csv").string();
+    const std::string other = (directory / "other.csv").string();
+    std::vector<std::future<ScriptResult>> results;
+    results.push_back(postProcessing.executeScriptAsync(script("append.py"), {peaks, "1", "0.3"}, peaks));
+    results.push_back(postProcessing.executeScriptAsync(script("append.py"), {other, "a", "0"}, other));
+    results.push_back(postProcessing.executeScriptAsync(script("append.py"), {peaks, "2", "0"}, peaks));
+    results.push_back(postProcessing.executeScriptAsync(script("append.py"), {peaks, "3", "0.1"}, peaks));
+    for (std::future<ScriptResult>& result : results) {
+        EXPECT_TRUE(result.get().success);
+    }
+    std::ifstream peaksFile(peaks);
+    const std::string content((std::istreambuf_iterator<char>(peaksFile)), std::istreambuf_iterator<char>());
+    EXPECT_EQ("1\n2\n3\n", content);
+    EXPECT_EQ(2u, postProcessing.getWorkerStarts());
+}
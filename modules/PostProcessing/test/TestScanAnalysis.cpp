@@ -0,0 +1,152 @@
+/**
+ * @file TestScanAnalysis.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the functions of 'ScanAnalysis' against the results of the python scripts (functions.py and scipy).
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "ScanAnalysis.hpp"
+
+/**
+ * @brief Test fixture with a rocking curve (W scan) and an edge scan (X scan). The expected values were computed with
+ * savgol_filter of scipy and the functions of modules/Devices/scripts/functions.py.
+ *
+ */
+struct TestScanAnalysis : public ::testing::Test {
+    std::vector<double> positions = {
+        0.0, 0.05, 0.1, 0.15, 0.2, 0.25, 0.3, 0.35, 0.4, 0.45, 0.5, 0.55, 0.6, 0.65, 0.7, 0.75, 0.8, 0.85, 0.9, 0.95, 1.0,
+        1.05, 1.1, 1.15, 1.2, 1.25, 1.3, 1.35, 1.4, 1.45, 1.5, 1.55, 1.6, 1.65, 1.7, 1.75, 1.8, 1.85, 1.9, 1.95, 2.0};  /**< Positions of the scanned axis. */
+    std::vector<double> rockingCurve = {
+        50.0, 63.1, 69.8, 66.8, 55.6, 41.9, 32.9, 34.0, 46.6, 68.3, 95.3, 126.1, 163.8, 216.6, 294.9, 405.9, 548.4, 709.5,
+        866.2, 990.5, 1058.4, 1057.2, 989.3, 871.2, 726.9, 580.1, 447.8, 337.7, 249.4, 178.9, 122.6, 79.5, 51.0, 38.3, 39.9,
+        50.6, 63.1, 69.9, 67.3, 56.3, 42.3};  /**< Counts of the rocking curve. */
+    std::vector<double> edge = {
+        940.0, 932.8, 921.6, 922.3, 933.9, 939.6, 930.8, 919.5, 920.4, 929.2, 927.4, 905.6, 871.6, 829.9, 762.3, 643.4, 478.9,
+        315.9, 199.5, 131.8, 87.5, 52.2, 32.2, 32.8, 41.1, 39.3, 27.0, 20.4, 28.2, 38.9, 37.0, 25.1, 20.3, 29.3, 39.4, 36.0,
+        24.0, 20.6, 30.7, 39.8, 34.9};  /**< Counts of the edge scan. */
+    std::vector<double> rockingCurveSmoothed = {
+        48.80699300699277, 65.82494172494154, 69.72902097902082, 64.5610722610721, 54.362937062936865, 40.392500000000055,
+        37.39875000000011, 42.38625000000019, 55.6693750000003, 76.11812500000046, 103.26812500000068, 139.3368750000009,
+        189.9087500000012, 262.4062500000015, 362.7231250000017, 491.0800000000018, 639.1806250000019, 790.0712500000018,
+        921.3093750000013, 1010.7437500000009, 1042.7512500000003, 1012.7037499999999, 927.9299999999993, 805.0374999999988,
+        664.5337499999986, 525.1974999999985, 400.0868749999986, 295.2974999999987, 211.46999999999892, 146.55749999999918,
+        98.32624999999939, 65.43437499999959, 47.09499999999975, 41.67249999999986, 45.72812499999995, 54.08249999999998,
+        59.20205128205147, 67.58247086247108, 69.86032634032654, 61.686433566433735, 38.711608391608436};  /**< savgol_filter(rockingCurve, 10, 3). */
+};
+
+/**
+ * @brief Test case that checks the Savitzky-Golay filter with an even window (as in most of the scripts).
+ *
+ */
+TEST_F(TestScanAnalysis, SavitzkyGolay_even_window) {
+    const std::vector<double> smoothed = analysis::savitzkyGolay(rockingCurve, 10, 3);
+    ASSERT_EQ(rockingCurveSmoothed.size(), smoothed.size());
+    for (size_t i = 0; i < smoothed.size(); i++) {
+        EXPECT_NEAR(rockingCurveSmoothed[i], smoothed[i], 1e-8) << "index " << i;
+    }
+}
+
+/**
+ * @brief Test case that checks the Savitzky-Golay filter with an odd window (as in SearchCrystalXAxisAlignment.py).
+ *
+ */
+TEST_F(TestScanAnalysis, SavitzkyGolay_odd_window) {
+    const std::vector<double> smoothed = analysis::savitzkyGolay(rockingCurve, 7, 2);
+    ASSERT_EQ(rockingCurve.size(), smoothed.size());
+    EXPECT_NEAR(52.23571428571424, smoothed[0], 1e-8);
+    EXPECT_NEAR(65.20000000000006, smoothed[3], 1e-8);
+    EXPECT_NEAR(1052.3857142857153, smoothed[20], 1e-8);
+    EXPECT_NEAR(42.60714285714281, smoothed[40], 1e-8);
+}
+
+/**
+ * @brief Test case that checks that the signal is returned unchanged if the window is not valid.
+ *
+ */
+TEST_F(TestScanAnalysis, SavitzkyGolay_invalid_window) {
+    const std::vector<double> signal = {1, 2, 3};
+    EXPECT_EQ(signal, analysis::savitzkyGolay(signal, 10, 3));
+    EXPECT_EQ(signal, analysis::savitzkyGolay(signal, 3, 3));
+}
+
+/**
+ * @brief Test case that checks the half maximum crossings, the centre and the value of the peak (half_max_x and searchPeakPosition).
+ *
+ */
+TEST_F(TestScanAnalysis, Peak_of_rocking_curve) {
+    const analysis::Peak peak = analysis::analyseRockingCurve(positions, rockingCurve);
+    ASSERT_TRUE(peak.valid);
+    EXPECT_NEAR(0.7665411185806942, peak.halfMaximum.firstCrossing, 1e-10);
+    EXPECT_NEAR(1.244661295965694, peak.halfMaximum.secondCrossing, 1e-10);
+    EXPECT_NEAR(1042.7512500000003, peak.halfMaximum.maximum, 1e-8);
+    EXPECT_NEAR(37.39875000000011, peak.halfMaximum.minimum, 1e-8);
+    EXPECT_NEAR(540.0750000000002, peak.halfMaximum.half, 1e-8);
+    EXPECT_NEAR(1.0056012072731941, peak.centre, 1e-10);
+    EXPECT_NEAR(1.244661295965694 - 0.7665411185806942, peak.fwhm, 1e-10);
+    EXPECT_NEAR(1039.3852044891742, peak.value, 1e-8);
+}
+
+/**
+ * @brief Test case that checks that a signal without peak is reported as not valid.
+ *
+ */
+TEST_F(TestScanAnalysis, Peak_not_found) {
+    const std::vector<double> x = {0, 1, 2, 3, 4};
+    const std::vector<double> y = {1, 2, 4, 5, 5};
+    EXPECT_FALSE(analysis::findPeak(x, y).valid);
+    double value = 0;
+    EXPECT_FALSE(analysis::valueAtPosition(x, y, 10, value));
+}
+
+/**
+ * @brief Test case that checks the position of the half level of an edge scan (half_max_position_interpolation).
+ *
+ */
+TEST_F(TestScanAnalysis, Half_level_of_edge) {
+    const std::vector<double> smoothed = analysis::savitzkyGolay(edge, 7, 2);
+    const double levelStart = analysis::mean(smoothed, 0, 5);
+    const double levelEnd = analysis::mean(smoothed, smoothed.size() - 5, smoothed.size());
+    EXPECT_NEAR(931.1600000000004, levelStart, 1e-8);
+    EXPECT_NEAR(30.720000000000017, levelEnd, 1e-8);
+    double position = 0;
+    ASSERT_TRUE(analysis::halfLevelPosition(positions, smoothed, levelStart, levelEnd, position));
+    EXPECT_NEAR(0.7995333900066119, position, 1e-10);
+}
+
+/**
+ * @brief Test case that checks the linear fit (compute_linear_fit).
+ *
+ */
+TEST_F(TestScanAnalysis, Linear_fit) {
+    const analysis::LinearFit fit = analysis::linearFit({-1.0, -0.5, 0.0, 0.5, 1.0}, {0.512, 0.498, 0.531, 0.476, 0.455});
+    ASSERT_TRUE(fit.valid);
+    EXPECT_NEAR(-0.027200000000000005, fit.slope, 1e-12);
+    EXPECT_NEAR(0.49439999999999995, fit.intercept, 1e-12);
+    EXPECT_FALSE(analysis::linearFit({1.0, 1.0}, {2.0, 3.0}).valid);
+}
+
+/**
+ * @brief Test case that checks the polynomial fit on coordinates far from the origin.
+ *
+ */
+TEST_F(TestScanAnalysis, Polynomial_fit) {
+    std::vector<double> x;
+    std::vector<double> y;
+    for (int i = 0; i < 20; i++) {
+        x.push_back(100 + 0.1 * i);
+        y.push_back(2 - 3 * x.back() + 0.5 * x.back() * x.back());
+    }
+    std::vector<double> coefficients;
+    ASSERT_TRUE(analysis::polynomialFit(x, y, 2, coefficients));
+    EXPECT_NEAR(2, coefficients[0], 1e-5);
+    EXPECT_NEAR(-3, coefficients[1], 1e-7);
+    EXPECT_NEAR(0.5, coefficients[2], 1e-9);
+}
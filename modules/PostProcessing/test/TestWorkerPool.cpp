@@ -0,0 +1,84 @@
+/**
+ * @file TestWorkerPool.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test methods of class 'WorkerPool'.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "WorkerPool.hpp"
+
+/**
+ * @brief Test case that checks that the tasks of the same sequence run in one lane, in submission order.
+ *
+ */
+TEST(TestWorkerPool, Sequence_runs_in_order) {
+    std::mutex mutex;
+    std::vector<int> order;
+    std::vector<size_t> lanes;
+    {
+        WorkerPool pool(3);
+        for (int index = 0; index < 20; index++) {
+            lanes.push_back(pool.submit("peaks.csv", [&mutex, &order, index](size_t) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(index % 3));
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(index);
+            }));
+        }
+    }  // the destructor runs the queued tasks
+    ASSERT_EQ(20u, order.size());
+    for (int index = 0; index < 20; index++) {
+        EXPECT_EQ(index, order[index]);
+        EXPECT_EQ(lanes[0], lanes[index]);
+    }
+}
+
+/**
+ * @brief Test case that checks that the tasks without sequence are shared among the lanes.
+ *
+ */
+TEST(TestWorkerPool, Tasks_run_in_parallel) {
+    WorkerPool pool(2);
+    std::atomic<int> running{0};
+    std::atomic<int> maximumRunning{0};
+    auto task = [&running, &maximumRunning](size_t) {
+        const int now = ++running;
+        int maximum = maximumRunning;
+        while (now > maximum && !maximumRunning.compare_exchange_weak(maximum, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        running--;
+    };
+    const size_t first = pool.submit("", task);
+    const size_t second = pool.submit("", task);
+    EXPECT_NE(first, second);
+    while (pool.getPendingTasks() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(2, maximumRunning);
+}
+
+/**
+ * @brief Test case that checks that an exception thrown by a task does not stop the lane.
+ *
+ */
+TEST(TestWorkerPool, Exception_does_not_stop_the_lane) {
+    std::atomic<int> completed{0};
+    {
+        WorkerPool pool(1);
+        pool.submit("", [](size_t) { throw std::runtime_error("analysis failed"); });
+        pool.submit("", [&completed](size_t) { completed++; });
+    }
+    EXPECT_EQ(1, completed);
+}
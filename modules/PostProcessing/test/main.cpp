@@ -0,0 +1,18 @@
+/**
+ * @file main.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief This code initializes the Google Mock framework and runs all the tests that are defined in the test code.
+ * @version 0.1
+ * @date 2022
+ * 
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ * 
+ */
+
+#include "gmock/gmock.h"
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
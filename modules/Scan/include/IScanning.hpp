@@ -14,6 +14,9 @@
 
 #include <iostream>
 #include <string>
+#include <memory>
+
+#include "ScanPointStream.hpp"
 
 namespace scanning {
 
@@ -50,7 +53,7 @@ class IScanning {
    * clientScanningStepper_->scan();  // To start the scan with the parameters set before.
    * 
    * @return true if the scan has been completed succesfully.
-   * @return false otherwise.
+   * @return false otherwise (e.g. if it has been stopped).
    */
   virtual bool scan() = 0;
   virtual bool scanRelative() = 0;
@@ -115,7 +118,7 @@ class IScanning {
    */
   virtual void setRange(float range) = 0;
   /**
-   * @brief Method that toggles the parameter 'stopMotor_' to true.
+   * @brief Method that toggles the parameter 'stopMotor_' to true: the running scan ends before its next step and fails.
    * 
    * @return true
    */
@@ -166,6 +169,21 @@ class IScanning {
    */
   virtual bool checkReachingPosition(float currentPosition,
                                      float targetPosition) = 0;
+  /**
+   * @brief Set the stream where the points acquired during the scan are published.
+   * 
+   * When a stream is set the points are sent live to the clients of the UI management server
+   * and the plot script is not executed at the end of the scan.
+   * 
+   * @param scanPointStream shared pointer to ScanPointStream Class (nullptr to disable the stream).
+   */
+  virtual void setScanPointStream(std::shared_ptr<ScanPointStream> scanPointStream) = 0;
+  /**
+   * @brief Get the points acquired during the last scan, kept in memory for the native analysis of the scan.
+   * 
+   * @return std::vector<ScanPoint> points of the last scan (all of them, also when the stream is not subscribed).
+   */
+  virtual std::vector<ScanPoint> getLastScanPoints() = 0;
   int hxpAxisToScan_;  /**< Integer value representing the axis to scan. The value of this parameter must be within 0-6. */
 };
 
@@ -0,0 +1,164 @@
+/**
+ * @file ScanPointStream.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2023
+ * @brief Class used to publish the points acquired during a scan to the clients of the UI management server.
+ * @version 0.1
+ * @date 2023
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace scanning {
+
+/**
+ * @struct ScanPoint
+ * @brief Struct containing the data of a point acquired during a scan.
+ *
+ */
+struct ScanPoint {
+  int scanId = 0;  /**< Identifier of the scan the point belongs to. */
+  int index = 0;  /**< Index of the point in the scan. */
+  double position = 0;  /**< Position of the scanned axis. */
+  std::array<float, 6> positionsHxp = {};  /**< Positions of the axes of the hexapod (X, Y, Z, U, V, W). Zero for stepper scans. */
+  int counts = 0;  /**< Counts of the x-ray sensor in the region of interest. */
+  double timestamp = 0;  /**< Time (in seconds) elapsed from the beginning of the scan. */
+  double stepDuration = 0;  /**< Time (in seconds) spent to move to the point and acquire it. */
+};
+
+/**
+ * @struct ScanInfo
+ * @brief Struct containing the description of the scan that is currently streamed.
+ *
+ */
+struct ScanInfo {
+  int scanId = 0;  /**< Identifier of the scan. */
+  std::string scanName;  /**< Name of the scan (filename of the data log). */
+  int axis = 0;  /**< Axis of the hexapod that is scanned (1-6). 0 for stepper scans. */
+  bool running = false;  /**< True while the scan is running. */
+  bool completed = false;  /**< True if the scan reached the final position. */
+};
+
+/**
+ * @class ScanPointStream
+ * @brief Class used to stream the points acquired during a scan.
+ *
+ * The scanning thread calls 'publish' for every acquired point. The points are stored in a buffer with fixed capacity
+ * and collected by the thread that sends them to the clients. The scanning thread never waits for the clients:
+ * when the buffer is full the oldest points are decimated (one every two points is dropped, the last point is always kept).
+ *
+ */
+class ScanPointStream {
+ public:
+  /**
+   * @brief Construct a new ScanPointStream object.
+   *
+   * @param capacity maximum number of points stored while waiting to be collected.
+   */
+  explicit ScanPointStream(size_t capacity = 512);
+  /**
+   * @brief Destroy the ScanPointStream object.
+   *
+   */
+  ~ScanPointStream();
+  /**
+   * @brief Signal the beginning of a new scan.
+   *
+   * @param scanName name of the scan (filename of the data log).
+   * @param axis axis of the hexapod that is scanned (1-6). 0 for stepper scans.
+   * @return int identifier of the new scan.
+   */
+  int beginScan(const std::string& scanName, int axis);
+  /**
+   * @brief Signal the end of the current scan.
+   *
+   * @param completed true if the scan reached the final position.
+   */
+  void endScan(bool completed);
+  /**
+   * @brief Publish a point of the current scan.
+   *
+   * The method returns immediately if no client is subscribed to the stream.
+   *
+   * @param point point acquired. The fields 'scanId' and 'timestamp' are filled by the method.
+   */
+  void publish(ScanPoint point);
+  /**
+   * @brief Collect the points published since the last call.
+   *
+   * @param maxPoints maximum number of points to return. If more points are pending they are decimated,
+   * keeping the last one.
+   * @return std::vector<ScanPoint> points collected.
+   */
+  std::vector<ScanPoint> collect(size_t maxPoints);
+  /**
+   * @brief Wait until new points are published or the scan status changes.
+   *
+   * @param timeout maximum waiting time.
+   * @return true if there is something to send to the clients.
+   * @return false if the timeout expired.
+   */
+  bool waitForUpdates(std::chrono::milliseconds timeout);
+  /**
+   * @brief Get the description of the current (or last) scan.
+   *
+   * @return ScanInfo description of the scan.
+   */
+  ScanInfo getScanInfo();
+  /**
+   * @brief Get the number of points dropped since the beginning of the current scan.
+   *
+   * @return size_t number of points dropped.
+   */
+  size_t getDroppedPoints();
+  /**
+   * @brief Enable or disable the stream for one client.
+   *
+   * @param subscribe true to subscribe a client, false to unsubscribe it.
+   */
+  void setSubscription(bool subscribe);
+  /**
+   * @brief Check if at least one client is subscribed to the stream.
+   *
+   * @return true if at least one client is subscribed.
+   * @return false otherwise.
+   */
+  bool hasSubscribers() const;
+  /**
+   * @brief Wake up the threads waiting for updates (used when the server is closed).
+   *
+   */
+  void shutdown();
+
+ private:
+  /**
+   * @brief Drop one every two points of the buffer, keeping the last one. Must be called with the mutex locked.
+   *
+   */
+  void decimate();
+  const size_t capacity_;  /**< Maximum number of points stored in the buffer. */
+  std::vector<ScanPoint> points_;  /**< Points waiting to be collected. */
+  ScanInfo scanInfo_;  /**< Description of the current scan. */
+  bool scanInfoChanged_ = false;  /**< True if the scan began or ended since the last call of 'collect'. */
+  bool shutdown_ = false;  /**< True if the stream has been closed. */
+  size_t droppedPoints_ = 0;  /**< Number of points dropped in the current scan. */
+  std::chrono::steady_clock::time_point scanStart_;  /**< Time point of the beginning of the current scan. */
+  std::atomic<int> subscribers_;  /**< Number of clients subscribed to the stream. */
+  std::mutex mutex_;  /**< Mutex protecting the buffer. */
+  std::condition_variable updates_;  /**< Condition variable notified when a point is published. */
+};
+
+}  // namespace scanning
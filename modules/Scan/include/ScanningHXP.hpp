@@ -14,6 +14,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <memory>
@@ -25,6 +26,7 @@
 #include "IMotor.hpp"
 #include "IScanning.hpp"
 #include "ISensors.hpp"
+#include "ProjectPaths.hpp"
 #include "IPostProcessing.hpp"
 
 using namespace sensors;  // NOLINT
@@ -76,6 +78,8 @@ class ScanningHXP : public IScanning{
                                 bool showPlot) override;
   bool checkReachingPosition(float currentPosition,
                              float targetPosition) override;
+  void setScanPointStream(std::shared_ptr<ScanPointStream> scanPointStream) override;
+  std::vector<ScanPoint> getLastScanPoints() override;
   /**
    * @brief This method sets the axis target position of the hexapod based on the
    * selected axis that is currently scanning ('hxpAxisToScan_').
@@ -154,18 +158,38 @@ class ScanningHXP : public IScanning{
    */
   bool relativeMotionHXP(double displacement);
  private:
+  /**
+   * @brief Store a point of the scan and publish it in the scan point stream (if set).
+   * 
+   * @param index index of the point in the scan.
+   * @param countsXRaySensor counts read by the x-ray sensor.
+   * @param stepStart time point of the beginning of the step.
+   */
+  void publishScanPoint(int index,
+                        int countsXRaySensor,
+                        std::chrono::steady_clock::time_point stepStart);
+  /**
+   * @brief Signal the end of the scan to the scan point stream (if set) and record the scan in the measurement index,
+   * with the path to the archived copy of its data log.
+   * 
+   * @param completed true if the scan reached the final position.
+   */
+  void finishScan(bool completed);
   std::shared_ptr<IHXP> clientHxp_;  /**< shared pointer to IHXP Class.*/
   std::shared_ptr<sensors::ISensors> clientSensors_;  /**< shared pointer to ISensor Class.*/
   std::shared_ptr<IPostProcessing> clientPostProcessing_;  /**< shared pointer to IPostProcessing Class.*/
-  std::filesystem::path pathToProjDirectory_ = clientSensors_->getPathToProjDirectory();
-  std::filesystem::path pathToPlotScanScript_ = pathToProjDirectory_ / "modules\\Devices\\scripts\\Scans\\plotScanHXP.py";
+  ProjectPaths projectPaths_{clientSensors_->getPathToProjDirectory()};  /**< Directories of the project. */
+  std::filesystem::path pathToPlotScanScript_ = projectPaths_.getScriptsDirectory() / "Scans" / "plotScanHXP.py";
   float stepSize_;  /**< Step size of the scan. */
   int durationAcquisition_;  /**< Acquisition time (in seconds) between steps of a scan. */
   float range_;  /**< Range of the scan. */
   std::string filename_;  /**< Filename where the data logged by the sensors will be saved. */
   bool eraseCsvContent_;  /**< Boolean flag used to control if the data registered by the xray sensor will not be saved at the end of the scan.*/
-  bool stopMotor_;  /**< Boolean flag used to control if the stop command has been called. */
+  std::atomic<bool> stopMotor_;  /**< Boolean flag used to control if the stop command has been called (from another thread). */
   bool showPlot_;  /**< Boolean flag used to control whether to show the plot at the end of the scan or not. */
+  std::shared_ptr<ScanPointStream> scanPointStream_;  /**< Shared pointer to ScanPointStream Class used to send the points to the clients. */
+  double scanStartTime_ = 0;  /**< Beginning of the current scan (seconds since epoch). */
+  std::vector<ScanPoint> lastScanPoints_;  /**< Points acquired during the last scan. */
 };
 
 }  // namespace scanning
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <vector>
 
 #include "IScanning.hpp"
 
@@ -63,6 +64,8 @@ class ScanningHXPMock : public IScanning {
   MOCK_METHOD0(getAxisPosition, double());
   MOCK_METHOD2(checkReachingPosition, bool(float currentPosition,
                                            float targetPosition));
+  MOCK_METHOD1(setScanPointStream, void(std::shared_ptr<ScanPointStream> scanPointStream));
+  MOCK_METHOD0(getLastScanPoints, std::vector<ScanPoint>());
 };
 
 }  // namespace scanning
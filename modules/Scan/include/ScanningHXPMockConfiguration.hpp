@@ -15,7 +15,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <memory>
+#include <vector>
 
 #include "ScanningHXPMock.hpp"
 
@@ -46,6 +48,19 @@ class ScanningHXPMockConfiguration {
   void configureScanningHXPMock() {
     ON_CALL(*ScanningHXPMock_, scan()).WillByDefault(Return(true));
     ON_CALL(*ScanningHXPMock_, checkReachingPosition(_, _)).WillByDefault(Return(true));
+    ON_CALL(*ScanningHXPMock_, getLastScanPoints()).WillByDefault(Invoke(
+      [] {
+          std::vector<ScanPoint> points;  // rocking curve with the Bragg peak in W = 0.5
+          for (int index = 0; index <= 40; index++) {
+              ScanPoint point;
+              point.index = index;
+              point.position = index * 0.025;
+              point.positionsHxp[5] = static_cast<float>(point.position);
+              point.counts = static_cast<int>(50 + 1000 * std::exp(-std::pow((point.position - 0.5) / 0.1, 2)));
+              points.push_back(point);
+          }
+          return points;
+      }));
   }
 
  private:
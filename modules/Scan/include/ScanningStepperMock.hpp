@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <vector>
 
 #include "ScanningStepper.hpp"
 
@@ -59,6 +60,8 @@ class ScanningStepperMock : public IScanning {
                                               bool showPlot));
   MOCK_METHOD2(checkReachingPosition, bool(float currentPosition,
                                            float targetPosition));
+  MOCK_METHOD1(setScanPointStream, void(std::shared_ptr<ScanPointStream> scanPointStream));
+  MOCK_METHOD0(getLastScanPoints, std::vector<ScanPoint>());
 };
 
 }  // namespace scanning
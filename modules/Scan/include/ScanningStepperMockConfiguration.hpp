@@ -15,7 +15,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <memory>
+#include <vector>
 
 #include "ScanningStepperMock.hpp"
 
@@ -50,6 +52,19 @@ class ScanningStepperMockConfiguration {
           return true;
       }));
     ON_CALL(*ScanningStepperMock_, checkReachingPosition(_, _)).WillByDefault(Return(true));
+    ON_CALL(*ScanningStepperMock_, getLastScanPoints()).WillByDefault(Invoke(
+      [] {
+          std::vector<ScanPoint> points;  // rocking curve with the peak in 0.5
+          for (int index = 0; index <= 40; index++) {
+              ScanPoint point;
+              point.index = index;
+              point.position = index * 0.025;
+              point.positionsHxp[5] = static_cast<float>(point.position);
+              point.counts = static_cast<int>(50 + 1000 * std::exp(-std::pow((point.position - 0.5) / 0.1, 2)));
+              points.push_back(point);
+          }
+          return points;
+      }));
   }
 
  private:
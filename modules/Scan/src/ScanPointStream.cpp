@@ -0,0 +1,136 @@
+/**
+ * @file ScanPointStream.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2023
+ * @brief Class used to publish the points acquired during a scan to the clients of the UI management server.
+ * @version 0.1
+ * @date 2023
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "ScanPointStream.hpp"
+
+namespace scanning {
+
+ScanPointStream::ScanPointStream(size_t capacity):
+    capacity_(capacity < 2 ? 2 : capacity),
+    subscribers_(0) {
+    spdlog::info("cTor ScanPointStream\n");
+    points_.reserve(capacity_);
+}
+
+ScanPointStream::~ScanPointStream() {
+    spdlog::info("dTor ScanPointStream\n");
+}
+
+int ScanPointStream::beginScan(const std::string& scanName, int axis) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    scanInfo_.scanId++;
+    scanInfo_.scanName = scanName;
+    scanInfo_.axis = axis;
+    scanInfo_.running = true;
+    scanInfo_.completed = false;
+    scanInfoChanged_ = true;
+    droppedPoints_ = 0;
+    points_.clear();
+    scanStart_ = std::chrono::steady_clock::now();
+    updates_.notify_one();
+    return scanInfo_.scanId;
+}
+
+void ScanPointStream::endScan(bool completed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    scanInfo_.running = false;
+    scanInfo_.completed = completed;
+    scanInfoChanged_ = true;
+    updates_.notify_one();
+}
+
+void ScanPointStream::publish(ScanPoint point) {
+    if (!this->hasSubscribers()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    point.scanId = scanInfo_.scanId;
+    point.timestamp = std::chrono::duration<double>(std::chrono::steady_clock::now() - scanStart_).count();
+    if (points_.size() >= capacity_) {
+        this->decimate();
+    }
+    points_.push_back(point);
+    updates_.notify_one();
+}
+
+std::vector<ScanPoint> ScanPointStream::collect(size_t maxPoints) {
+    std::vector<ScanPoint> collected;
+    std::lock_guard<std::mutex> lock(mutex_);
+    scanInfoChanged_ = false;
+    if (points_.empty()) {
+        return collected;
+    }
+    if (maxPoints == 0 || points_.size() <= maxPoints) {
+        collected.swap(points_);
+        points_.reserve(capacity_);
+        return collected;
+    }
+    /* Keep 'maxPoints' points evenly spaced, the last one included */
+    collected.reserve(maxPoints);
+    const double stride = static_cast<double>(points_.size() - 1) / (maxPoints > 1 ? maxPoints - 1 : 1);
+    for (size_t i = 0; i < maxPoints; i++) {
+        size_t index = maxPoints > 1 ? static_cast<size_t>(i * stride + 0.5) : points_.size() - 1;
+        collected.push_back(points_[index]);
+    }
+    droppedPoints_ += points_.size() - maxPoints;
+    points_.clear();
+    return collected;
+}
+
+bool ScanPointStream::waitForUpdates(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return updates_.wait_for(lock, timeout, [this] { return shutdown_ || scanInfoChanged_ || !points_.empty(); }) && !shutdown_;
+}
+
+ScanInfo ScanPointStream::getScanInfo() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return scanInfo_;
+}
+
+size_t ScanPointStream::getDroppedPoints() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return droppedPoints_;
+}
+
+void ScanPointStream::setSubscription(bool subscribe) {
+    if (subscribe) {
+        subscribers_++;
+    } else if (subscribers_ > 0) {
+        subscribers_--;
+    }
+    spdlog::info("Scan point stream subscribers: {}\n", subscribers_.load());
+}
+
+bool ScanPointStream::hasSubscribers() const {
+    return subscribers_.load() > 0;
+}
+
+void ScanPointStream::shutdown() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+    updates_.notify_all();
+}
+
+void ScanPointStream::decimate() {
+    const size_t size = points_.size();
+    size_t kept = 0;
+    for (size_t i = 0; i < size; i += 2) {
+        points_[kept++] = points_[i];
+    }
+    if ((size - 1) % 2 != 0) {
+        points_[kept++] = points_[size - 1];  // always keep the last point
+    }
+    droppedPoints_ += size - kept;
+    points_.resize(kept);
+}
+
+}  // namespace scanning
@@ -99,6 +99,51 @@ bool ScanningHXP::checkReachingPosition(float currentPosition, float targetPosit
     }
 }
 
+void ScanningHXP::setScanPointStream(std::shared_ptr<ScanPointStream> scanPointStream) {
+    scanPointStream_ = scanPointStream;
+}
+
+std::vector<ScanPoint> ScanningHXP::getLastScanPoints() {
+    return lastScanPoints_;
+}
+
+void ScanningHXP::publishScanPoint(int index,
+                                   int countsXRaySensor,
+                                   std::chrono::steady_clock::time_point stepStart) {
+    ScanPoint point;
+    point.index = index;
+    point.position = this->getAxisPosition();
+    point.positionsHxp = {static_cast<float>(clientHxp_->getPositionX()),
+                          static_cast<float>(clientHxp_->getPositionY()),
+                          static_cast<float>(clientHxp_->getPositionZ()),
+                          static_cast<float>(clientHxp_->getPositionU()),
+                          static_cast<float>(clientHxp_->getPositionV()),
+                          static_cast<float>(clientHxp_->getPositionW())};
+    point.counts = countsXRaySensor;
+    point.stepDuration = std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count();
+    lastScanPoints_.push_back(point);
+    if (scanPointStream_ && scanPointStream_->hasSubscribers()) {
+        scanPointStream_->publish(point);
+    }
+}
+
+void ScanningHXP::finishScan(bool completed) {
+    if (scanPointStream_) {
+        scanPointStream_->endScan(completed);
+    }
+    sensors::MeasurementRecord record;
+    record.startTime = scanStartTime_;
+    record.type = "Scan";
+    record.name = filename_;
+    record.completed = completed;
+    record.resultPath = clientSensors_->archiveDataLog().string();  // the data log is overwritten by the next scan
+    record.parameters = "AXIS=" + std::to_string(hxpAxisToScan_) +
+                        ";STEP_SIZE=" + std::to_string(stepSize_) +
+                        ";RANGE=" + std::to_string(range_) +
+                        ";DURATION_ACQUISITION=" + std::to_string(durationAcquisition_);
+    clientSensors_->recordMeasurement(record);
+}
+
 bool ScanningHXP::relativeMotionHXP(double displacement) {
     bool resultMotion;
     switch (hxpAxisToScan_) {
@@ -136,10 +181,19 @@ bool ScanningHXP::relativeMotionHXP(double displacement) {
 bool ScanningHXP::scan() {
     spdlog::info("Method scan of Class ScanningHXP\n");
     spdlog::debug("Scan parameters - Step Size: {}; Range: {}.\n", stepSize_, range_);
+    stopMotor_ = false;  // a stop received while no scan was running does not end this scan
     double currentPosition = this->getAxisPosition();
     float finalPosition = currentPosition + range_;
     clientSensors_->startAcquisitionCrystal(filename_, eraseCsvContent_);
-    clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+    scanStartTime_ = sensors::MeasurementIndex::now();
+    lastScanPoints_.clear();
+    if (scanPointStream_) {
+        scanPointStream_->beginScan(filename_, hxpAxisToScan_);
+    }
+    std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+    int pointIndex = 0;
+    int countsXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+    this->publishScanPoint(pointIndex++, countsXRaySensor, stepStart);
     if (fmodf(finalPosition, stepSize_) != 0.0  && finalPosition > 0) {
         int numSteps = round(finalPosition / stepSize_);
         stepSize_ = finalPosition / numSteps;  // Update stepSize if remainder of division is != 0
@@ -148,6 +202,7 @@ bool ScanningHXP::scan() {
     }
     if (finalPosition > currentPosition) {  // Forward Motion
         for (float nextPosition = currentPosition + stepSize_; nextPosition <= (finalPosition+0.001); nextPosition = nextPosition + stepSize_) {
+            stepStart = std::chrono::steady_clock::now();
             if (stopMotor_ != true) {
                 spdlog::debug("Start Axis Movement to: {} (Forward)\n", nextPosition);
                 this->updateAxisPosition(nextPosition);
@@ -160,13 +215,17 @@ bool ScanningHXP::scan() {
                 clientSensors_->motionStabilizationTimer(100);
             } else {
                 stopMotor_ = false;
-                return true;
+                spdlog::warn("Scan stopped\n");
+                this->finishScan(false);
+                return false;
             }
             currentPosition = this->getAxisPosition();
-            clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+            countsXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+            this->publishScanPoint(pointIndex++, countsXRaySensor, stepStart);
             if (!this->checkReachingPosition(currentPosition, nextPosition)) {
                 spdlog::error("Position {} not reached! The system is currently in position: {}\n", nextPosition, currentPosition);
                 spdlog::debug("----------------------------------------------------------\n");
+                this->finishScan(false);
                 return false;
             } else {
                 spdlog::debug("Position {} reached!\n", currentPosition);
@@ -175,6 +234,7 @@ bool ScanningHXP::scan() {
         }
     } else {  // Backward motion
         for (float nextPosition = currentPosition - stepSize_; nextPosition >= (finalPosition-0.001); nextPosition = nextPosition - stepSize_) {
+            stepStart = std::chrono::steady_clock::now();
             if (stopMotor_ != true) {
                 spdlog::debug("Start Axis Movement to: {} (Forward)\n", nextPosition);
                 this->updateAxisPosition(nextPosition);
@@ -187,13 +247,17 @@ bool ScanningHXP::scan() {
                 clientSensors_->motionStabilizationTimer(100);
             } else {
                 stopMotor_ = false;
-                return true;
+                spdlog::warn("Scan stopped\n");
+                this->finishScan(false);
+                return false;
             }
             currentPosition = this->getAxisPosition();
-            clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+            countsXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+            this->publishScanPoint(pointIndex++, countsXRaySensor, stepStart);
             if (!this->checkReachingPosition(currentPosition, nextPosition)) {
                 spdlog::error("Position {} not reached! The system is currently in position: {}\n", nextPosition, currentPosition);
                 spdlog::debug("----------------------------------------------------------\n");
+                this->finishScan(false);
                 return false;
             } else {
                 spdlog::debug("Position {} reached!\n", currentPosition);
@@ -202,7 +266,8 @@ bool ScanningHXP::scan() {
         }
     }
     spdlog::debug("#################################################################\n");
-    if (showPlot_) {
+    this->finishScan(true);
+    if (showPlot_ && !(scanPointStream_ && scanPointStream_->hasSubscribers())) {  // otherwise the points are plotted live by the clients
         clientPostProcessing_->executeScript2(pathToPlotScanScript_.string(), filename_, std::to_string(hxpAxisToScan_));
     }
     return true;
@@ -211,10 +276,19 @@ bool ScanningHXP::scan() {
 bool ScanningHXP::scanRelative() {
     spdlog::info("Method scan of Class ScanningHXP\n");
     spdlog::debug("Scan parameters - Step Size: {}; Range: {}.\n", stepSize_, range_);
+    stopMotor_ = false;  // a stop received while no scan was running does not end this scan
     double currentPosition = this->getAxisPosition();
     float finalPosition = currentPosition + range_;
     clientSensors_->startAcquisitionCrystal(filename_, eraseCsvContent_);
-    clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+    scanStartTime_ = sensors::MeasurementIndex::now();
+    lastScanPoints_.clear();
+    if (scanPointStream_) {
+        scanPointStream_->beginScan(filename_, hxpAxisToScan_);
+    }
+    std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+    int pointIndex = 0;
+    int countsXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+    this->publishScanPoint(pointIndex++, countsXRaySensor, stepStart);
     if (fmodf(finalPosition, stepSize_) != 0.0  && finalPosition > 0) {
         int numSteps = round(finalPosition / stepSize_);
         stepSize_ = finalPosition / numSteps;  // Update stepSize if remainder of division is != 0
@@ -223,6 +297,7 @@ bool ScanningHXP::scanRelative() {
     }
     if (finalPosition > currentPosition) {  // Forward Motion
         for (float nextPosition = currentPosition + stepSize_; nextPosition <= (finalPosition+0.001); nextPosition = nextPosition + stepSize_) {
+            stepStart = std::chrono::steady_clock::now();
             if (stopMotor_ != true) {
                 spdlog::debug("Start Axis Movement to: {} (Forward)\n", nextPosition);
                 this->updateAxisPosition(nextPosition);
@@ -231,13 +306,17 @@ bool ScanningHXP::scanRelative() {
                 clientSensors_->motionStabilizationTimer(100);
             } else {
                 stopMotor_ = false;
-                return true;
+                spdlog::warn("Scan stopped\n");
+                this->finishScan(false);
+                return false;
             }
             currentPosition = this->getAxisPosition();
-            clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+            countsXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+            this->publishScanPoint(pointIndex++, countsXRaySensor, stepStart);
             if (!this->checkReachingPosition(currentPosition, nextPosition)) {
                 spdlog::error("Position {} not reached! The system is currently in position: {}\n", nextPosition, currentPosition);
                 spdlog::debug("----------------------------------------------------------\n");
+                this->finishScan(false);
                 return false;
             } else {
                 spdlog::debug("Position {} reached!\n", currentPosition);
@@ -246,6 +325,7 @@ bool ScanningHXP::scanRelative() {
         }
     } else {  // Backward motion
         for (float nextPosition = currentPosition - stepSize_; nextPosition >= (finalPosition-0.001); nextPosition = nextPosition - stepSize_) {
+            stepStart = std::chrono::steady_clock::now();
             if (stopMotor_ != true) {
                 spdlog::debug("Start Axis Movement to: {} (Forward)\n", nextPosition);
                 this->updateAxisPosition(nextPosition);
@@ -254,13 +334,17 @@ bool ScanningHXP::scanRelative() {
                 clientSensors_->motionStabilizationTimer(100);
             } else {
                 stopMotor_ = false;
-                return true;
+                spdlog::warn("Scan stopped\n");
+                this->finishScan(false);
+                return false;
             }
             currentPosition = this->getAxisPosition();
-            clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+            countsXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, clientHxp_->getPositionX(), clientHxp_->getPositionY(), clientHxp_->getPositionZ(), clientHxp_->getPositionU(), clientHxp_->getPositionV(), clientHxp_->getPositionW());
+            this->publishScanPoint(pointIndex++, countsXRaySensor, stepStart);
             if (!this->checkReachingPosition(currentPosition, nextPosition)) {
                 spdlog::error("Position {} not reached! The system is currently in position: {}\n", nextPosition, currentPosition);
                 spdlog::debug("----------------------------------------------------------\n");
+                this->finishScan(false);
                 return false;
             } else {
                 spdlog::debug("Position {} reached!\n", currentPosition);
@@ -269,7 +353,8 @@ bool ScanningHXP::scanRelative() {
         }
     }
     spdlog::debug("#################################################################\n");
-    if (showPlot_) {
+    this->finishScan(true);
+    if (showPlot_ && !(scanPointStream_ && scanPointStream_->hasSubscribers())) {  // otherwise the points are plotted live by the clients
         clientPostProcessing_->executeScript2(pathToPlotScanScript_.string(), filename_, std::to_string(hxpAxisToScan_));
     }
     return true;
@@ -48,6 +48,45 @@ bool ScanningStepper::checkReachingPosition(float currentPosition, float targetP
     }
 }
 
+void ScanningStepper::setScanPointStream(std::shared_ptr<ScanPointStream> scanPointStream) {
+    scanPointStream_ = scanPointStream;
+}
+
+std::vector<ScanPoint> ScanningStepper::getLastScanPoints() {
+    return lastScanPoints_;
+}
+
+void ScanningStepper::publishScanPoint(int index,
+                                       float position,
+                                       int countsXRaySensor,
+                                       std::chrono::steady_clock::time_point stepStart) {
+    ScanPoint point;
+    point.index = index;
+    point.position = position;
+    point.counts = countsXRaySensor;
+    point.stepDuration = std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count();
+    lastScanPoints_.push_back(point);
+    if (scanPointStream_ && scanPointStream_->hasSubscribers()) {
+        scanPointStream_->publish(point);
+    }
+}
+
+void ScanningStepper::finishScan(bool completed) {
+    if (scanPointStream_) {
+        scanPointStream_->endScan(completed);
+    }
+    sensors::MeasurementRecord record;
+    record.startTime = scanStartTime_;
+    record.type = "Scan";
+    record.name = filename_;
+    record.completed = completed;
+    record.resultPath = clientSensors_->archiveDataLog().string();  // the data log is overwritten by the next scan
+    record.parameters = "STEP_SIZE=" + std::to_string(stepSize_) +
+                        ";RANGE=" + std::to_string(range_) +
+                        ";DURATION_ACQUISITION=" + std::to_string(durationAcquisition_);
+    clientSensors_->recordMeasurement(record);
+}
+
 bool ScanningStepper::scanRelative() {
     return true;
 }
@@ -55,12 +94,21 @@ bool ScanningStepper::scanRelative() {
 bool ScanningStepper::scan() {
     spdlog::info("Method scan of Class ScanningStepper\n");
     spdlog::debug("Scan parameters - Step Size: {}; Range: {}.\n", stepSize_, range_);
+    stopMotor_ = false;  // a stop received while no scan was running does not end this scan
     float stepSize = stepSize_;
-    std::string dataXRaySensor;
+    int countsXRaySensor = 0;
     clientSensors_->startAcquisitionSingleStepper(filename_, eraseCsvContent_);
+    scanStartTime_ = sensors::MeasurementIndex::now();
+    lastScanPoints_.clear();
+    if (scanPointStream_) {
+        scanPointStream_->beginScan(filename_, 0);
+    }
     float currentPosition = clientStepper_->getPositionUserUnits();
     float finalPosition = currentPosition + range_;
-    dataXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, currentPosition);  // 1st Read X-Ray Sensor
+    std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+    int pointIndex = 0;
+    countsXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, currentPosition);  // 1st Read X-Ray Sensor
+    this->publishScanPoint(pointIndex++, currentPosition, countsXRaySensor, stepStart);
     spdlog::debug("Method startScan. Step Size: {} [UU]; Final Position: {} [UU]; Current Position: {} [UU]\n", stepSize, finalPosition, currentPosition);
     if (fmodf(finalPosition, stepSize) != 0.0 && finalPosition > 0) {
         int numSteps = round(finalPosition / stepSize);
@@ -70,21 +118,27 @@ bool ScanningStepper::scan() {
     }
     if (finalPosition > currentPosition) {  // Forward Motion
         for (float nextPosition = currentPosition + stepSize; nextPosition <= finalPosition + stepSize; nextPosition = nextPosition + stepSize) {
+            stepStart = std::chrono::steady_clock::now();
             spdlog::debug("Start Movement to: {} (Forward)\n", nextPosition);
             if (stopMotor_ != true) {
                 int result_moveCalibratedMotor = clientStepper_->moveCalibratedMotor(nextPosition);
                 if (result_moveCalibratedMotor != 0) {
+                    this->finishScan(false);
                     return false;
                 }
             } else {
                 stopMotor_ = false;
-                return true;
+                spdlog::warn("Scan stopped\n");
+                this->finishScan(false);
+                return false;
             }
             currentPosition = clientStepper_->getPositionUserUnits();  // Read Position after move
-            dataXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, currentPosition);  // Read X-Ray Sensor
+            countsXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, currentPosition);  // Read X-Ray Sensor
+            this->publishScanPoint(pointIndex++, currentPosition, countsXRaySensor, stepStart);
             if (!this->checkReachingPosition(currentPosition, nextPosition)) {
                 spdlog::error("Position {} not reached! The system is currently in position: {}\n", nextPosition, currentPosition);
                 spdlog::debug("----------------------------------------------------------\n");
+                this->finishScan(false);
                 return false;
             } else {
                 spdlog::debug("Position {} reached!\n", currentPosition);
@@ -93,21 +147,27 @@ bool ScanningStepper::scan() {
         }  // end for
     } else {  //  Backward Motion
         for (float nextPosition = currentPosition - stepSize; nextPosition >= finalPosition; nextPosition = nextPosition - stepSize) {
+            stepStart = std::chrono::steady_clock::now();
             spdlog::debug("Start Movement to: {} (Backward)\n", nextPosition);
             if (stopMotor_ != true) {
                 int result_moveCalibratedMotor = clientStepper_->moveCalibratedMotor(nextPosition);
                 if (result_moveCalibratedMotor != 0) {
+                    this->finishScan(false);
                     return false;
                 }
             } else {
                 stopMotor_ = false;
-                return true;
+                spdlog::warn("Scan stopped\n");
+                this->finishScan(false);
+                return false;
             }
             currentPosition = clientStepper_->getPositionUserUnits();  // Read Position after move
-            dataXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, currentPosition);  // Read X-Ray Sensor
+            countsXRaySensor = clientSensors_->readXRaySensor(durationAcquisition_, currentPosition);  // Read X-Ray Sensor
+            this->publishScanPoint(pointIndex++, currentPosition, countsXRaySensor, stepStart);
             if (!this->checkReachingPosition(currentPosition, nextPosition)) {
                 spdlog::error("Position {} not reached! The system is currently in position: {}\n", nextPosition, currentPosition);
                 spdlog::debug("----------------------------------------------------------\n");
+                this->finishScan(false);
                 return false;
             } else {
                 spdlog::debug("Position {} reached!\n", currentPosition);
@@ -116,7 +176,8 @@ bool ScanningStepper::scan() {
         }  // end for
     }
     spdlog::debug("#################################################################\n");
-    if (showPlot_) {
+    this->finishScan(true);
+    if (showPlot_ && !(scanPointStream_ && scanPointStream_->hasSubscribers())) {  // otherwise the points are plotted live by the clients
         clientPostProcessing_->executeScript1(pathToPlotScanScript_.string(), filename_);
     }
     return true;
@@ -0,0 +1,99 @@
+/**
+ * @file ScanPointStreamTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2023
+ * @brief Test the stream of the points acquired during a scan.
+ * @version 0.1
+ * @date 2023
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ScanPointStream.hpp"
+
+namespace {
+
+void publishPoints(scanning::ScanPointStream& stream, int nPoints) {
+    for (int index = 0; index < nPoints; index++) {
+        scanning::ScanPoint point;
+        point.index = index;
+        point.position = index * 0.1;
+        stream.publish(point);
+    }
+}
+
+std::vector<int> indexes(const std::vector<scanning::ScanPoint>& points) {
+    std::vector<int> result;
+    for (const scanning::ScanPoint& point : points) {
+        result.push_back(point.index);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(ScanPointStreamTests, SubscriptionsAreCounted) {
+    scanning::ScanPointStream stream;
+    ASSERT_FALSE(stream.hasSubscribers());
+    stream.setSubscription(true);
+    stream.setSubscription(true);
+    stream.setSubscription(false);
+    ASSERT_TRUE(stream.hasSubscribers());  // one client is still subscribed
+    stream.setSubscription(false);
+    ASSERT_FALSE(stream.hasSubscribers());
+    stream.setSubscription(false);  // more unsubscriptions than subscriptions
+    stream.setSubscription(true);
+    ASSERT_TRUE(stream.hasSubscribers());
+}
+
+TEST(ScanPointStreamTests, PointsAreNotCollectedWithoutSubscribers) {
+    scanning::ScanPointStream stream;
+    int scanId = stream.beginScan("scan.csv", 6);
+    publishPoints(stream, 10);
+    ASSERT_TRUE(stream.collect(0).empty());
+    scanning::ScanInfo scanInfo = stream.getScanInfo();  // the scan is still described for late subscribers
+    ASSERT_EQ(scanId, scanInfo.scanId);
+    ASSERT_EQ("scan.csv", scanInfo.scanName);
+    ASSERT_TRUE(scanInfo.running);
+    stream.setSubscription(true);
+    publishPoints(stream, 2);
+    std::vector<scanning::ScanPoint> points = stream.collect(0);
+    ASSERT_EQ(2u, points.size());
+    ASSERT_EQ(scanId, points[0].scanId);
+}
+
+TEST(ScanPointStreamTests, FullBufferIsDecimatedKeepingTheLastPoint) {
+    scanning::ScanPointStream stream(4);
+    stream.setSubscription(true);
+    stream.beginScan("scan.csv", 6);
+    publishPoints(stream, 5);
+    ASSERT_EQ(std::vector<int>({0, 2, 3, 4}), indexes(stream.collect(0)));
+    ASSERT_EQ(1u, stream.getDroppedPoints());
+    stream.beginScan("next.csv", 6);
+    ASSERT_EQ(0u, stream.getDroppedPoints());  // counted per scan
+}
+
+TEST(ScanPointStreamTests, CollectDecimatesToMaxPoints) {
+    scanning::ScanPointStream stream;
+    stream.setSubscription(true);
+    stream.beginScan("scan.csv", 6);
+    publishPoints(stream, 10);
+    ASSERT_EQ(std::vector<int>({0, 3, 6, 9}), indexes(stream.collect(4)));
+    ASSERT_EQ(6u, stream.getDroppedPoints());
+    ASSERT_TRUE(stream.collect(4).empty());
+}
+
+TEST(ScanPointStreamTests, EndOfScanWakesUpTheCollector) {
+    scanning::ScanPointStream stream;
+    stream.beginScan("scan.csv", 6);
+    stream.collect(0);
+    ASSERT_FALSE(stream.waitForUpdates(std::chrono::milliseconds(10)));
+    stream.endScan(true);
+    ASSERT_TRUE(stream.waitForUpdates(std::chrono::milliseconds(10)));
+    ASSERT_TRUE(stream.getScanInfo().completed);
+}
@@ -15,6 +15,10 @@
 #include <iostream>
 #include <string>
 #include <filesystem>
+#include <vector>
+
+#include "MeasurementIndex.hpp"
+#include "ResultFile.hpp"
 
 namespace sensors {
 
@@ -61,8 +65,9 @@ class ISensors {
   * @brief Read X-Ray sensor and saves data read and position of the steppr motor in the .csv file.
   * @param durationAcquisition amount of time used for the acquisition of data.
   * @param position of the stepper motor.
+  * @return int counts read by the X-Ray sensor.
   */
-  virtual std::string readXRaySensor(int durationAcquisition, float position) = 0;
+  virtual int readXRaySensor(int durationAcquisition, float position) = 0;
 
   /**
   * @brief Read X-Ray sensor and saves data read and positions of the hexapod axis in the .csv file.
@@ -73,8 +78,9 @@ class ISensors {
   * @param positionU position of U-axis.
   * @param positionV position of V-axis.
   * @param positionW position of W-axis.
+  * @return int counts read by the X-Ray sensor.
   */
-  virtual std::string readXRaySensor(int durationAcquisition, float positionX, float positionY, float positionZ, float positionU, float positionV, float positionW) = 0;
+  virtual int readXRaySensor(int durationAcquisition, float positionX, float positionY, float positionZ, float positionU, float positionV, float positionW) = 0;
 
   /**
   * @brief Deinitialize X-Ray sensor.
@@ -95,10 +101,44 @@ class ISensors {
 
   /**
   * @brief Read float from .csv file.
+  * @details Equivalent to readResult(pathToFile, 0).getFloat(0): first value of the first row after the header.
   * @param pathToFile.
   */
   virtual float readCsvResult(std::string pathToFile) = 0;
 
+  /**
+  * @brief Read a row of a .csv result file written by the post-processing scripts.
+  * @details The returned object gives typed access to all the values of the row (e.g. slope, intercept and
+  * standard deviation), by index or by column name.
+  * @param pathToFile path to the .csv result file.
+  * @param row index of the row to read (0 is the first row after the header, ResultFile::kLastRow is the last row).
+  * @return ResultFile row read. ResultFile::isValid() is false if the row cannot be read.
+  */
+  virtual ResultFile readResult(std::string pathToFile, size_t row) = 0;
+
+  /**
+  * @brief Copy the .csv file of the last acquisition to the archive (see MeasurementIndex::archive).
+  * @details The data log is overwritten by the next scan using the same filename: the measurement index refers to the copy.
+  * @return std::filesystem::path path to the copy (empty if the data log has not been copied).
+  */
+  virtual std::filesystem::path archiveDataLog() = 0;
+
+  /**
+  * @brief Append a finished scan or measurement to the measurement index.
+  * @details If not set, the crystal identifier is read from the configuration file
+  * (section CRYSTAL_MEASUREMENTS, key CRYSTAL_ID). The result path is written as given.
+  * @param record entry to append.
+  * @return true if the entry has been written.
+  */
+  virtual bool recordMeasurement(MeasurementRecord record) = 0;
+
+  /**
+  * @brief Search the scans and measurements stored in the measurement index.
+  * @param query filters of the query (time range, crystal identifier, type).
+  * @return std::vector<MeasurementRecord> entries matching the filters, sorted by start time.
+  */
+  virtual std::vector<MeasurementRecord> queryMeasurements(const MeasurementQuery& query) = 0;
+
   /**
   * @brief Getter funtion of "pathToProjDirectory_" representing the path to project directory.
   */
@@ -0,0 +1,138 @@
+/**
+ * @file MeasurementIndex.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief File-based index of the scans and measurements executed by the machine.
+ * @version 0.1
+ * @date 2022
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sensors {
+
+/**
+ * @struct MeasurementRecord
+ * @brief Struct containing one entry of the measurement index.
+ *
+ */
+struct MeasurementRecord {
+  double startTime = 0;  /**< Beginning of the scan/measurement (seconds since epoch). */
+  double endTime = 0;  /**< End of the scan/measurement (seconds since epoch). */
+  std::string type;  /**< Type of the entry ("Scan" or name of the measurement, e.g. "Bending_Angle_CRYSTAL_STAGE"). */
+  std::string crystalId;  /**< Identifier of the crystal under test. */
+  std::string name;  /**< Name of the scan (data log filename) or of the measurement. */
+  bool completed = false;  /**< True if the scan/measurement completed successfully. */
+  std::string result;  /**< Result of the measurement (empty for scans). */
+  std::string uncertainty;  /**< Standard uncertainty of the result (empty if not estimated). */
+  std::string resultPath;  /**< Path to the file containing the data/result. */
+  std::string parameters;  /**< Parameters of the scan/measurement ("KEY=value;KEY=value"). */
+};
+
+/**
+ * @struct MeasurementQuery
+ * @brief Struct containing the filters of a query to the measurement index. Empty strings match any value.
+ *
+ */
+struct MeasurementQuery {
+  double from = 0;  /**< Minimum start time (seconds since epoch). */
+  double to = std::numeric_limits<double>::max();  /**< Maximum start time (seconds since epoch). */
+  std::string type;  /**< Type of the entries. */
+  std::string crystalId;  /**< Identifier of the crystal. */
+};
+
+/**
+ * @class MeasurementIndex
+ * @brief File-based index of the scans and measurements executed by the machine.
+ *
+ * Each entry is appended as a tab-separated line to the index file, so the index is updated incrementally
+ * as scans and measurements finish and can be opened with any spreadsheet. Queries read only the lines
+ * appended since the previous query and search the entries, kept sorted by start time, in memory.
+ *
+ */
+class MeasurementIndex {
+ public:
+  MeasurementIndex() = delete;
+  /**
+   * @brief Construct a new MeasurementIndex object.
+   *
+   * @param pathToIndexFile path to the index file (created at the first entry).
+   */
+  explicit MeasurementIndex(std::filesystem::path pathToIndexFile);
+  /**
+   * @brief Destroy the MeasurementIndex object.
+   *
+   */
+  ~MeasurementIndex();
+  /**
+   * @brief Append an entry to the index file.
+   *
+   * @param record entry to append. Tabs and new lines in the fields are replaced by spaces.
+   * @return true if the entry has been written.
+   * @return false otherwise.
+   */
+  bool append(const MeasurementRecord& record);
+  /**
+   * @brief Search the entries of the index.
+   *
+   * @param query filters of the query.
+   * @return std::vector<MeasurementRecord> entries matching the filters, sorted by start time.
+   */
+  std::vector<MeasurementRecord> query(const MeasurementQuery& query);
+  /**
+   * @brief Get the path to the index file.
+   *
+   * @return std::filesystem::path path to the index file.
+   */
+  std::filesystem::path getPath() const;
+  /**
+   * @brief Get the current time in the format used by the index.
+   *
+   * @return double seconds since epoch.
+   */
+  static double now();
+  /**
+   * @brief Copy a data/result file to the archive, so that the index keeps pointing at its content when the file is
+   * overwritten by the next scan or measurement.
+   *
+   * The copy is written in the subdirectory 'Archive' of the directory of the file and its name is the name of the file
+   * followed by the time (e.g. 'alignment_Crystal_XAxis_20221005_143012_250.csv'); a counter is added when a copy with
+   * the same name already exists.
+   *
+   * @param pathToFile path to the file to archive.
+   * @param time time of the archive (seconds since epoch).
+   * @return std::filesystem::path path to the copy (empty if the file has not been copied).
+   */
+  static std::filesystem::path archive(const std::filesystem::path& pathToFile, double time);
+
+ private:
+  /**
+   * @brief Read the entries appended to the index file since the previous call. Must be called with the mutex locked.
+   *
+   */
+  void refresh();
+  /**
+   * @brief Parse a line of the index file.
+   *
+   * @param line line of the index file.
+   * @param record parsed entry.
+   * @return true if the line is a valid entry.
+   * @return false otherwise.
+   */
+  bool parseLine(const std::string& line, MeasurementRecord& record) const;
+  std::filesystem::path pathToIndexFile_;  /**< Path to the index file. */
+  std::vector<MeasurementRecord> records_;  /**< Entries read from the index file, sorted by start time. */
+  std::streamoff readOffset_ = 0;  /**< Offset of the first byte of the index file not read yet. */
+  std::mutex mutex_;  /**< Mutex protecting the entries and the index file. */
+};
+
+}  // namespace sensors
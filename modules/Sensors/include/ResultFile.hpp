@@ -0,0 +1,144 @@
+/**
+ * @file ResultFile.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Reader of the .csv result files written by the post-processing scripts.
+ * @version 0.1
+ * @date 2022
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace sensors {
+
+/**
+ * @class ResultFile
+ * @brief Reader of the .csv result files written by the post-processing scripts.
+ *
+ * A result file has a header row with the names of the results (e.g. "Slope,Intercept,Standard Deviation")
+ * followed by one or more rows of values, separated by ',' or ';'.
+ * The file is read once in a fixed-size buffer owned by the object and only the requested row is split:
+ * the values are parsed on demand with std::from_chars, so reading a result does not allocate memory.
+ *
+ */
+class ResultFile {
+ public:
+  static constexpr size_t kMaxFileSize = 4096;  /**< Maximum size (bytes) of a result file. */
+  static constexpr size_t kMaxColumns = 16;  /**< Maximum number of values in a row. */
+  static constexpr size_t kLastRow = std::numeric_limits<size_t>::max();  /**< Index used to read the last row of the file. */
+  /**
+   * @brief Construct an empty (not valid) ResultFile object.
+   *
+   */
+  ResultFile();
+  /**
+   * @brief Construct a new ResultFile object reading a row of the given file.
+   *
+   * @param pathToFile path to the .csv result file.
+   * @param row index of the row to read (0 is the first row after the header, kLastRow is the last row).
+   */
+  explicit ResultFile(const std::string& pathToFile, size_t row = 0);
+  /**
+   * @brief Check if the requested row has been read.
+   *
+   * @return true if the row has been read.
+   * @return false if the file does not exist, does not contain the row or is too large for the row to be read completely.
+   */
+  bool isValid() const;
+  /**
+   * @brief Get the number of values in the row read.
+   *
+   * @return size_t number of values.
+   */
+  size_t getColumns() const;
+  /**
+   * @brief Get the index of a column from its name in the header.
+   *
+   * @param columnName name of the column.
+   * @return int index of the column, -1 if the column does not exist.
+   */
+  int findColumn(std::string_view columnName) const;
+  /**
+   * @brief Get the text of a value of the row read.
+   *
+   * @param column index of the value.
+   * @return std::string_view text of the value (empty if the column does not exist).
+   */
+  std::string_view getField(size_t column) const;
+  /**
+   * @brief Parse a value of the row read.
+   *
+   * @param column index of the value.
+   * @param value parsed value.
+   * @return true if the value has been parsed.
+   * @return false otherwise.
+   */
+  bool getValue(size_t column, float& value) const;
+  bool getValue(size_t column, double& value) const;
+  bool getValue(size_t column, int& value) const;
+  /**
+   * @brief Parse a value of the row read from the name of its column.
+   *
+   * @param columnName name of the column in the header.
+   * @param value parsed value.
+   * @return true if the value has been parsed.
+   * @return false otherwise.
+   */
+  bool getValue(std::string_view columnName, float& value) const;
+  bool getValue(std::string_view columnName, double& value) const;
+  bool getValue(std::string_view columnName, int& value) const;
+  /**
+   * @brief Parse a value of the row read.
+   *
+   * @param column index of the value.
+   * @return float parsed value, 0 if the value cannot be parsed.
+   */
+  float getFloat(size_t column = 0) const;
+
+ private:
+  /**
+   * @struct Field
+   * @brief Position of a field in the buffer.
+   *
+   */
+  struct Field {
+    uint16_t begin = 0;  /**< Offset of the first character. */
+    uint16_t end = 0;  /**< Offset after the last character. */
+  };
+  /**
+   * @brief Split the header and the requested row of the buffer.
+   *
+   * @param row index of the row to read.
+   * @return true if the row has been found.
+   * @return false otherwise.
+   */
+  bool parse(size_t row);
+  /**
+   * @brief Split a line of the buffer in fields.
+   *
+   * @param begin offset of the first character of the line.
+   * @param end offset after the last character of the line.
+   * @param fields fields found.
+   * @return size_t number of fields found.
+   */
+  size_t splitLine(size_t begin, size_t end, std::array<Field, kMaxColumns>& fields) const;
+  std::array<char, kMaxFileSize> buffer_;  /**< Content of the file. */
+  size_t length_ = 0;  /**< Number of bytes read. */
+  std::array<Field, kMaxColumns> header_;  /**< Fields of the header. */
+  size_t nHeaderColumns_ = 0;  /**< Number of fields of the header. */
+  std::array<Field, kMaxColumns> fields_;  /**< Fields of the row read. */
+  size_t nColumns_ = 0;  /**< Number of fields of the row read. */
+  bool valid_ = false;  /**< True if the requested row has been read. */
+};
+
+}  // namespace sensors
@@ -26,6 +26,7 @@
 
 #include "ISensors.hpp"
 #include "XRaySensor.hpp"
+#include "ProjectPaths.hpp"
 
 namespace sensors {
 
@@ -62,15 +63,15 @@ class Sensors : public ISensors{
    * @param positionW W-axis coordinate of HXP.
    */
   void savePosition(float positionX, float positionY, float positionZ, float positionU, float positionV, float positionW);
-  std::string readXRaySensor(int durationAcquisition, float position) override;
-  std::string readXRaySensor(int durationAcquisition, float positionX, float positionY, float positionZ, float positionU, float positionV, float positionW) override;
+  int readXRaySensor(int durationAcquisition, float position) override;
+  int readXRaySensor(int durationAcquisition, float positionX, float positionY, float positionZ, float positionU, float positionV, float positionW) override;
   void deinitializeXRaySensor() override;
   void motionStabilizationTimer(int timerLength) override;
   /**
    * @brief Writes on a .csv file the data read by the X-Ray Sensor.
-   * @param data data read by the X-Ray Sensor.
+   * @param counts counts read by the X-Ray Sensor.
    */
-  void writeDataToCsv(std::string data);
+  void writeDataToCsv(int counts);
   void flushCsv(std::string pathToCsv) override;
   /**
    * @brief Writes "\n" character in the .csv file.
@@ -82,6 +83,10 @@ class Sensors : public ISensors{
    */
   void separator();
   float readCsvResult(std::string pathToFile) override;
+  ResultFile readResult(std::string pathToFile, size_t row) override;
+  std::filesystem::path archiveDataLog() override;
+  bool recordMeasurement(MeasurementRecord record) override;
+  std::vector<MeasurementRecord> queryMeasurements(const MeasurementQuery& query) override;
   std::filesystem::path getPathToProjDirectory() override;
   /**
    * @brief String splitting function that takes an input string and
@@ -93,15 +98,23 @@ class Sensors : public ISensors{
    * @return std::vector<std::string> of substrigs splitted.
    */
   std::vector<std::string> split(const std::string& s, char delimiter);
+  /**
+   * @brief Getter function of the pool of buffers used to store the spectra of the acquisition session.
+   * @return std::shared_ptr<SpectrumBufferPool> pool of buffers.
+   */
+  std::shared_ptr<SpectrumBufferPool> getSpectrumBufferPool();
 
  private:
   std::shared_ptr<IXRaySensor> clientXRaySensor_;  /**< Shared pointer to IXRaySensor Class. */
+  std::shared_ptr<IConfiguration> clientConfiguration_;  /**< Shared pointer to IConfiguration Class. */
+  std::shared_ptr<MeasurementIndex> measurementIndex_;  /**< Index of the scans and measurements executed. */
+  std::shared_ptr<SpectrumBufferPool> spectrumBufferPool_;  /**< Pool of the buffers used to store the spectra acquired in the session. */
   std::ofstream fs_;  /**< Declaration of type 'std::ofstream' ( standard C++ class that provides an interface to write data to a file). */
   std::string xRaySensorName_;  /**< Parameter that stores the name of the XRaySensor (name stored in configuration file). */
   unsigned int baudrate_;  /**< Baudrate (i.e. bits per second at which bits are transmitted) of the serial communication. */
   std::string pathToCsv_;  /**< Path to the .csv file where to log the data. */
   std::filesystem::path pathToProjDirectory_;
-  std::string pathToDirectoryLogFiles_;  /**< Path to the directory where the log files need to be saved. */
+  std::filesystem::path pathToDirectoryLogFiles_;  /**< Path to the directory where the log files need to be saved. */
 };
 
 }  // namespace sensors
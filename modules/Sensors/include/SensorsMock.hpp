@@ -42,12 +42,16 @@ class SensorsMock : public ISensors {
  public:
   MOCK_METHOD2(startAcquisitionSingleStepper, void(std::string filename, bool eraseCsvContent));
   MOCK_METHOD2(startAcquisitionCrystal, void(std::string filename, bool eraseCsvContent));
-  MOCK_METHOD2(readXRaySensor, std::string(int durationAcquisition, float position));
-  MOCK_METHOD7(readXRaySensor, std::string(int durationAcquisition, float positionX, float positionY, float positionZ, float positionU, float positionV, float positionW));
+  MOCK_METHOD2(readXRaySensor, int(int durationAcquisition, float position));
+  MOCK_METHOD7(readXRaySensor, int(int durationAcquisition, float positionX, float positionY, float positionZ, float positionU, float positionV, float positionW));
   MOCK_METHOD0(deinitializeXRaySensor, void());
   MOCK_METHOD1(motionStabilizationTimer, void(int timerLength));
   MOCK_METHOD1(flushCsv, void(std::string pathToCsv));
   MOCK_METHOD1(readCsvResult, float(std::string filename));
+  MOCK_METHOD2(readResult, ResultFile(std::string pathToFile, size_t row));
+  MOCK_METHOD0(archiveDataLog, std::filesystem::path());
+  MOCK_METHOD1(recordMeasurement, bool(MeasurementRecord record));
+  MOCK_METHOD1(queryMeasurements, std::vector<MeasurementRecord>(const MeasurementQuery& query));
   MOCK_METHOD0(getPathToProjDirectory, std::filesystem::path());
 };
 
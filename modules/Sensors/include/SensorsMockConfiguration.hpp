@@ -45,7 +45,7 @@ class SensorsMockConfiguration {
         return SensorsMock_;
   }
   void configureSensorsMock() {
-    ON_CALL(*SensorsMock_, readXRaySensor(_, _)).WillByDefault(Return("00"));
+    ON_CALL(*SensorsMock_, readXRaySensor(_, _)).WillByDefault(Return(0));
     ON_CALL(*SensorsMock_, deinitializeXRaySensor()).WillByDefault(Return());
     ON_CALL(*SensorsMock_, motionStabilizationTimer(_)).WillByDefault(Return());
   }
@@ -0,0 +1,201 @@
+/**
+ * @file MeasurementIndex.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief File-based index of the scans and measurements executed by the machine.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "MeasurementIndex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+
+namespace sensors {
+
+namespace {
+
+const char* const kHeader = "START_TIME\tEND_TIME\tTYPE\tCRYSTAL_ID\tNAME\tCOMPLETED\tRESULT\tRESULT_PATH\tPARAMETERS\tUNCERTAINTY";
+const size_t kNumFields = 10;
+const size_t kNumFieldsWithoutUncertainty = 9;  // entries written before the uncertainty was added
+
+std::string sanitize(const std::string& field) {
+    std::string sanitized = field;
+    std::replace_if(sanitized.begin(), sanitized.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+    return sanitized;
+}
+
+bool isBefore(const MeasurementRecord& record, double time) {
+    return record.startTime < time;
+}
+
+}  // namespace
+
+MeasurementIndex::MeasurementIndex(std::filesystem::path pathToIndexFile):
+    pathToIndexFile_(pathToIndexFile) {
+    spdlog::info("cTor MeasurementIndex\n");
+}
+
+MeasurementIndex::~MeasurementIndex() {
+    spdlog::info("dTor MeasurementIndex\n");
+}
+
+bool MeasurementIndex::append(const MeasurementRecord& record) {
+    spdlog::info("Method append of Class MeasurementIndex\n");
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code errorCode;
+    const bool newFile = !std::filesystem::exists(pathToIndexFile_, errorCode);
+    if (newFile && pathToIndexFile_.has_parent_path()) {
+        std::filesystem::create_directories(pathToIndexFile_.parent_path(), errorCode);
+    }
+    std::ofstream indexFile(pathToIndexFile_, std::ios::out | std::ios::app | std::ios::binary);
+    if (!indexFile.is_open()) {
+        spdlog::error("Unable to open the measurement index {}\n", pathToIndexFile_.string());
+        return false;
+    }
+    if (newFile) {
+        indexFile << kHeader << "\n";
+    }
+    indexFile << std::fixed << std::setprecision(3)
+              << record.startTime << "\t"
+              << record.endTime << "\t"
+              << sanitize(record.type) << "\t"
+              << sanitize(record.crystalId) << "\t"
+              << sanitize(record.name) << "\t"
+              << (record.completed ? 1 : 0) << "\t"
+              << sanitize(record.result) << "\t"
+              << sanitize(record.resultPath) << "\t"
+              << sanitize(record.parameters) << "\t"
+              << sanitize(record.uncertainty) << "\n";
+    indexFile.flush();
+    return indexFile.good();
+}
+
+std::vector<MeasurementRecord> MeasurementIndex::query(const MeasurementQuery& query) {
+    spdlog::info("Method query of Class MeasurementIndex\n");
+    std::lock_guard<std::mutex> lock(mutex_);
+    this->refresh();
+    std::vector<MeasurementRecord> results;
+    auto it = std::lower_bound(records_.begin(), records_.end(), query.from, isBefore);
+    for (; it != records_.end() && it->startTime <= query.to; ++it) {
+        if (!query.type.empty() && it->type != query.type) {
+            continue;
+        }
+        if (!query.crystalId.empty() && it->crystalId != query.crystalId) {
+            continue;
+        }
+        results.push_back(*it);
+    }
+    return results;
+}
+
+std::filesystem::path MeasurementIndex::getPath() const {
+    return pathToIndexFile_;
+}
+
+double MeasurementIndex::now() {
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::filesystem::path MeasurementIndex::archive(const std::filesystem::path& pathToFile, double time) {
+    const std::filesystem::path pathToArchive = pathToFile.parent_path() / "Archive";
+    std::error_code errorCode;
+    std::filesystem::create_directories(pathToArchive, errorCode);
+    if (errorCode) {
+        spdlog::warn("Unable to create the archive {}: {}\n", pathToArchive.string(), errorCode.message());
+        return {};
+    }
+    const std::time_t seconds = static_cast<std::time_t>(time);
+    std::ostringstream stem;
+    stem << pathToFile.stem().string() << "_" << std::put_time(std::localtime(&seconds), "%Y%m%d_%H%M%S") << "_" << std::setw(3)
+         << std::setfill('0') << static_cast<int>((time - static_cast<double>(seconds)) * 1000);
+    for (int copy = 0; copy < 1000; copy++) {
+        const std::filesystem::path pathToCopy = pathToArchive / (stem.str() + (copy == 0 ? "" : "_" + std::to_string(copy)) +
+                                                                  pathToFile.extension().string());
+        if (std::filesystem::copy_file(pathToFile, pathToCopy, std::filesystem::copy_options::none, errorCode)) {
+            return pathToCopy;
+        }
+        if (errorCode != std::errc::file_exists) {
+            break;
+        }
+    }
+    spdlog::warn("File {} not archived: {}\n", pathToFile.string(), errorCode.message());
+    return {};
+}
+
+void MeasurementIndex::refresh() {
+    std::ifstream indexFile(pathToIndexFile_, std::ios::in | std::ios::binary);
+    if (!indexFile.is_open()) {
+        return;
+    }
+    indexFile.seekg(0, std::ios::end);
+    const std::streamoff size = indexFile.tellg();
+    if (size < readOffset_) {  // the file has been replaced: read it again
+        records_.clear();
+        readOffset_ = 0;
+    }
+    indexFile.seekg(readOffset_);
+    std::string line;
+    while (std::getline(indexFile, line)) {
+        if (indexFile.eof()) {  // incomplete line, still being written
+            break;
+        }
+        readOffset_ += static_cast<std::streamoff>(line.size()) + 1;
+        MeasurementRecord record;
+        if (!this->parseLine(line, record)) {
+            continue;
+        }
+        // Entries are appended when they finish: keep them sorted by start time
+        auto position = std::upper_bound(records_.begin(), records_.end(), record.startTime,
+                                         [](double time, const MeasurementRecord& other) { return time < other.startTime; });
+        records_.insert(position, std::move(record));
+    }
+}
+
+bool MeasurementIndex::parseLine(const std::string& line, MeasurementRecord& record) const {
+    if (line.empty() || line.rfind("START_TIME", 0) == 0) {
+        return false;
+    }
+    std::vector<std::string> fields;
+    std::string field;
+    std::istringstream lineStream(line);
+    while (std::getline(lineStream, field, '\t')) {
+        fields.push_back(field);
+    }
+    if (!line.empty() && line.back() == '\t') {
+        fields.push_back("");
+    }
+    if (fields.size() != kNumFields && fields.size() != kNumFieldsWithoutUncertainty) {
+        spdlog::warn("Invalid entry in the measurement index: {}\n", line);
+        return false;
+    }
+    try {
+        record.startTime = std::stod(fields[0]);
+        record.endTime = std::stod(fields[1]);
+    } catch (const std::exception&) {
+        spdlog::warn("Invalid entry in the measurement index: {}\n", line);
+        return false;
+    }
+    record.type = fields[2];
+    record.crystalId = fields[3];
+    record.name = fields[4];
+    record.completed = fields[5] == "1";
+    record.result = fields[6];
+    record.resultPath = fields[7];
+    record.parameters = fields[8];
+    if (fields.size() == kNumFields) {
+        record.uncertainty = fields[9];
+    }
+    return true;
+}
+
+}  // namespace sensors
@@ -0,0 +1,190 @@
+/**
+ * @file ResultFile.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Reader of the .csv result files written by the post-processing scripts.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "ResultFile.hpp"
+
+#include <charconv>
+#include <cstdio>
+
+namespace sensors {
+
+namespace {
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '"';
+}
+
+template <typename T>
+bool parseField(std::string_view field, T& value) {
+    if (field.empty()) {
+        return false;
+    }
+    const char* first = field.data();
+    const char* last = field.data() + field.size();
+    if (*first == '+') {  // not accepted by std::from_chars
+        ++first;
+    }
+    auto [next, errorCode] = std::from_chars(first, last, value);
+    return errorCode == std::errc() && next == last;
+}
+
+}  // namespace
+
+ResultFile::ResultFile() {}
+
+ResultFile::ResultFile(const std::string& pathToFile, size_t row) {
+    std::FILE* file = std::fopen(pathToFile.c_str(), "rb");
+    if (file == nullptr) {
+        spdlog::error("Unable to open the result file {}\n", pathToFile);
+        return;
+    }
+    std::setvbuf(file, nullptr, _IONBF, 0);  // read directly in 'buffer_'
+    length_ = std::fread(buffer_.data(), 1, buffer_.size(), file);
+    const bool truncated = length_ == buffer_.size() && std::fgetc(file) != EOF;
+    std::fclose(file);
+    if (truncated) {
+        if (row == kLastRow) {  // the last row is beyond the buffer
+            spdlog::error("Result file {} is larger than {} bytes\n", pathToFile, kMaxFileSize);
+            return;
+        }
+        while (length_ > 0 && buffer_[length_ - 1] != '\n') {  // the line cut by the end of the buffer is not complete
+            length_--;
+        }
+    }
+    valid_ = this->parse(row);
+    if (!valid_ && truncated) {
+        spdlog::error("Result file {} is larger than {} bytes: row {} not read\n", pathToFile, kMaxFileSize, row);
+    } else if (!valid_) {
+        spdlog::error("Result not found in {}\n", pathToFile);
+    }
+}
+
+bool ResultFile::isValid() const {
+    return valid_;
+}
+
+size_t ResultFile::getColumns() const {
+    return nColumns_;
+}
+
+int ResultFile::findColumn(std::string_view columnName) const {
+    for (size_t column = 0; column < nHeaderColumns_; column++) {
+        std::string_view name(buffer_.data() + header_[column].begin, header_[column].end - header_[column].begin);
+        if (name == columnName) {
+            return static_cast<int>(column);
+        }
+    }
+    return -1;
+}
+
+std::string_view ResultFile::getField(size_t column) const {
+    if (!valid_ || column >= nColumns_) {
+        return std::string_view();
+    }
+    return std::string_view(buffer_.data() + fields_[column].begin, fields_[column].end - fields_[column].begin);
+}
+
+bool ResultFile::getValue(size_t column, float& value) const {
+    return parseField(this->getField(column), value);
+}
+
+bool ResultFile::getValue(size_t column, double& value) const {
+    return parseField(this->getField(column), value);
+}
+
+bool ResultFile::getValue(size_t column, int& value) const {
+    return parseField(this->getField(column), value);
+}
+
+bool ResultFile::getValue(std::string_view columnName, float& value) const {
+    int column = this->findColumn(columnName);
+    return column >= 0 && this->getValue(static_cast<size_t>(column), value);
+}
+
+bool ResultFile::getValue(std::string_view columnName, double& value) const {
+    int column = this->findColumn(columnName);
+    return column >= 0 && this->getValue(static_cast<size_t>(column), value);
+}
+
+bool ResultFile::getValue(std::string_view columnName, int& value) const {
+    int column = this->findColumn(columnName);
+    return column >= 0 && this->getValue(static_cast<size_t>(column), value);
+}
+
+float ResultFile::getFloat(size_t column) const {
+    float value = 0;
+    if (!this->getValue(column, value)) {
+        return 0;
+    }
+    return value;
+}
+
+bool ResultFile::parse(size_t row) {
+    size_t lineBegin = 0;
+    size_t lineIndex = 0;
+    size_t lastRowBegin = 0;
+    size_t lastRowEnd = 0;
+    bool lastRowFound = false;
+    while (lineBegin < length_) {
+        size_t lineEnd = lineBegin;
+        while (lineEnd < length_ && buffer_[lineEnd] != '\n') {
+            lineEnd++;
+        }
+        size_t contentEnd = lineEnd;
+        while (contentEnd > lineBegin && isBlank(buffer_[contentEnd - 1])) {
+            contentEnd--;
+        }
+        if (contentEnd > lineBegin) {  // skip empty lines
+            if (lineIndex == 0) {
+                nHeaderColumns_ = this->splitLine(lineBegin, contentEnd, header_);
+            } else if (row == kLastRow) {
+                lastRowBegin = lineBegin;
+                lastRowEnd = contentEnd;
+                lastRowFound = true;
+            } else if (lineIndex - 1 == row) {
+                nColumns_ = this->splitLine(lineBegin, contentEnd, fields_);
+                return true;
+            }
+            lineIndex++;
+        }
+        lineBegin = lineEnd + 1;
+    }
+    if (lastRowFound) {
+        nColumns_ = this->splitLine(lastRowBegin, lastRowEnd, fields_);
+        return true;
+    }
+    return false;
+}
+
+size_t ResultFile::splitLine(size_t begin, size_t end, std::array<Field, kMaxColumns>& fields) const {
+    size_t nFields = 0;
+    size_t fieldBegin = begin;
+    for (size_t i = begin; i <= end && nFields < kMaxColumns; i++) {
+        if (i == end || buffer_[i] == ',' || buffer_[i] == ';') {
+            size_t first = fieldBegin;
+            size_t last = i;
+            while (first < last && isBlank(buffer_[first])) {
+                first++;
+            }
+            while (last > first && isBlank(buffer_[last - 1])) {
+                last--;
+            }
+            fields[nFields].begin = static_cast<uint16_t>(first);
+            fields[nFields].end = static_cast<uint16_t>(last);
+            nFields++;
+            fieldBegin = i + 1;
+        }
+    }
+    return nFields;
+}
+
+}  // namespace sensors
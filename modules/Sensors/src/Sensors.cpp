@@ -17,13 +17,12 @@ namespace sensors {
 Sensors::Sensors(std::filesystem::path pathToProjDirectory) :
     pathToProjDirectory_(pathToProjDirectory) {
     spdlog::info("cTor Sensors\n");
-    std::filesystem::path directoryNameLogFiles = "LogFiles";
-    std::filesystem::path directoryNameDeviceScans = "DeviceScans";
-    std::filesystem::path pathToDirectoryLogFiles = pathToProjDirectory / directoryNameLogFiles / directoryNameDeviceScans;
-    pathToDirectoryLogFiles_ = pathToDirectoryLogFiles.string();
+    const ProjectPaths projectPaths(pathToProjDirectory);
+    pathToDirectoryLogFiles_ = projectPaths.getScanDirectory();
+    spectrumBufferPool_ = std::make_shared<SpectrumBufferPool>();
+    measurementIndex_ = std::make_shared<MeasurementIndex>(projectPaths.getLogDirectory() / "MeasurementIndex.csv");
     //  XRaySensor Initialization
-    std::shared_ptr<IConfiguration> clientConfiguration_ = 
-            std::make_shared<Configuration>();
+    clientConfiguration_ = std::make_shared<Configuration>();
     std::shared_ptr<XRaySensor> clientXRaySensor = std::make_shared<XRaySensor>(clientConfiguration_);  // Obj of class XRaySensor
     clientXRaySensor_ = clientXRaySensor;
     clientXRaySensor_->connectToSensor();
@@ -38,7 +37,10 @@ Sensors::~Sensors() {
 
 void Sensors::startAcquisitionSingleStepper(std::string filename, bool flushFlag) {
     spdlog::info("Method startAcquisition of Class Sensors\n");
-    pathToCsv_ = pathToDirectoryLogFiles_ + "\\" + filename;
+    // New acquisition session: recycle the buffers of the previous scan
+    spectrumBufferPool_->recycle();
+    clientXRaySensor_->startSession(spectrumBufferPool_);
+    pathToCsv_ = (pathToDirectoryLogFiles_ / filename).string();
     fs_.close();
     fs_.open(pathToCsv_, std::ofstream::app);
     if (!fs_) {
@@ -57,7 +59,10 @@ void Sensors::startAcquisitionSingleStepper(std::string filename, bool flushFlag
 
 void Sensors::startAcquisitionCrystal(std::string filename, bool flushFlag) {
     spdlog::info("Method startAcquisitionCrystal of Class Sensors\n");
-    pathToCsv_ = pathToDirectoryLogFiles_ + "\\" + filename;
+    // New acquisition session: recycle the buffers of the previous scan
+    spectrumBufferPool_->recycle();
+    clientXRaySensor_->startSession(spectrumBufferPool_);
+    pathToCsv_ = (pathToDirectoryLogFiles_ / filename).string();
     fs_.close();
     fs_.open(pathToCsv_, std::ofstream::app);
     if (!fs_) {
@@ -108,24 +113,24 @@ void Sensors::savePosition(float positionX, float positionY, float positionZ, fl
     this->endRow();
 }
 
-std::string Sensors::readXRaySensor(int durationAcquisition, float position) {
+int Sensors::readXRaySensor(int durationAcquisition, float position) {
     spdlog::info("Method readXRaySensor of class Sensors\n");
     const int waitTimer = 200;
     this->motionStabilizationTimer(waitTimer);  // motion stabilization wait waitTimer ms
-    int output = clientXRaySensor_->acquireKalphaRadiation(durationAcquisition);
-    this->writeDataToCsv(std::to_string(output));
+    int counts = clientXRaySensor_->acquireKalphaRadiation(durationAcquisition);
+    this->writeDataToCsv(counts);
     this->savePosition(position);
-    return std::to_string(output);
+    return counts;
 }
 
-std::string Sensors::readXRaySensor(int durationAcquisition, float positionX, float positionY, float positionZ, float positionU, float positionV, float positionW) {
+int Sensors::readXRaySensor(int durationAcquisition, float positionX, float positionY, float positionZ, float positionU, float positionV, float positionW) {
     spdlog::info("Method readXRaySensor of class Sensors\n");
     const int waitTimer = 200;
     this->motionStabilizationTimer(waitTimer);  // motion stabilization wait waitTimer ms
-    int output = clientXRaySensor_->acquireKalphaRadiation(durationAcquisition);
-    this->writeDataToCsv(std::to_string(output));
+    int counts = clientXRaySensor_->acquireKalphaRadiation(durationAcquisition);
+    this->writeDataToCsv(counts);
     this->savePosition(positionX, positionY, positionZ, positionU, positionV, positionW);
-    return std::to_string(output);
+    return counts;
 }
 
 void Sensors::deinitializeXRaySensor() {
@@ -142,8 +147,8 @@ void Sensors::motionStabilizationTimer(int timerLength) {
     // spdlog::debug("Elapsed time: {} [s]\n", elapsed_seconds.count());
 }
 
-void Sensors::writeDataToCsv(std::string data) {
-    fs_ << data;  // write in 1st col
+void Sensors::writeDataToCsv(int counts) {
+    fs_ << counts;  // write in 1st col
 }
 
 void Sensors::flushCsv(std::string pathToCsv) {
@@ -161,26 +166,42 @@ void Sensors::separator() {
 
 float Sensors::readCsvResult(std::string pathToFile) {
     spdlog::info("Method readCsv of class Sensors\n");
-    std::vector<std::string> outputs;
-    std::ifstream infile(pathToFile);
-    std::vector<int> outputs_xray_sensor;
-    std::vector<float> outputs_positions;
-    float position = 0;
-    // Temporary buffer
-    std::string temp;
-    // Get the input from the input file until EOF
-    while (std::getline(infile, temp, '\n')) {
-        outputs.push_back(temp);
-    }
-    int j = 0;
     // Read second row of .csv file that contains the position
-    for (const auto& i : outputs) {
-       if (j == 1) {
-        position = std::stof(outputs[j]);
-       }
-       j++;
+    return ResultFile(pathToFile).getFloat(0);
+}
+
+ResultFile Sensors::readResult(std::string pathToFile, size_t row) {
+    spdlog::info("Method readResult of class Sensors\n");
+    return ResultFile(pathToFile, row);
+}
+
+std::filesystem::path Sensors::archiveDataLog() {
+    spdlog::info("Method archiveDataLog of class Sensors\n");
+    fs_.flush();
+    return MeasurementIndex::archive(pathToCsv_, MeasurementIndex::now());
+}
+
+bool Sensors::recordMeasurement(MeasurementRecord record) {
+    spdlog::info("Method recordMeasurement of class Sensors\n");
+    if (record.crystalId.empty() &&
+        clientConfiguration_->hasKey("CRYSTAL_MEASUREMENTS",
+                                     "CRYSTAL_ID",
+                                     clientConfiguration_->getConfigFilename(),
+                                     clientConfiguration_->getPath()) == 1) {
+        record.crystalId = clientConfiguration_->readStringFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+                                                                                 clientConfiguration_->getPath(),
+                                                                                 "CRYSTAL_MEASUREMENTS",
+                                                                                 "CRYSTAL_ID");
+    }
+    if (record.endTime == 0) {
+        record.endTime = MeasurementIndex::now();
     }
-    return  position;
+    return measurementIndex_->append(record);
+}
+
+std::vector<MeasurementRecord> Sensors::queryMeasurements(const MeasurementQuery& query) {
+    spdlog::info("Method queryMeasurements of class Sensors\n");
+    return measurementIndex_->query(query);
 }
 
 std::vector<std::string> Sensors::split(const std::string& s, char delimiter) {
@@ -193,6 +214,10 @@ std::vector<std::string> Sensors::split(const std::string& s, char delimiter) {
     return tokens;
 }
 
+std::shared_ptr<SpectrumBufferPool> Sensors::getSpectrumBufferPool() {
+    return spectrumBufferPool_;
+}
+
 std::filesystem::path Sensors::getPathToProjDirectory() {
     return pathToProjDirectory_;
 }
@@ -0,0 +1,190 @@
+/**
+ * @file MeasurementIndexTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the file-based index of the scans and measurements.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "MeasurementIndex.hpp"
+
+using namespace sensors;  // NOLINT
+
+/**
+ * @struct MeasurementIndexTests
+ * @brief Test fixture called 'MeasurementIndexTests', which inherits from 'testing::Test'.
+ *
+ */
+struct MeasurementIndexTests
+    : public ::testing::Test {
+        void SetUp() override {
+            directory_ = std::filesystem::temp_directory_path() / "MeasurementIndexTests";
+            std::filesystem::remove_all(directory_);
+            pathToIndexFile_ = directory_ / "Logs" / "Measurement_Index.tsv";
+            }
+        void TearDown() override {
+            std::filesystem::remove_all(directory_);
+            }
+        /**
+         * @brief Create an entry of the index.
+         *
+         * @param startTime beginning of the measurement.
+         * @param type type of the entry.
+         * @param crystalId identifier of the crystal.
+         * @return MeasurementRecord entry.
+         */
+        MeasurementRecord makeRecord(double startTime, const std::string& type, const std::string& crystalId) {
+            MeasurementRecord record;
+            record.startTime = startTime;
+            record.endTime = startTime + 60;
+            record.type = type;
+            record.crystalId = crystalId;
+            record.name = type + "_" + std::to_string(static_cast<int>(startTime));
+            record.completed = true;
+            return record;
+            }
+        std::filesystem::path directory_;  /**< Temporary directory used by the tests. */
+        std::filesystem::path pathToIndexFile_;  /**< Path to the index file. */
+};
+
+TEST_F(MeasurementIndexTests, EmptyIndexReturnsNoEntries) {
+    MeasurementIndex index(pathToIndexFile_);
+    ASSERT_TRUE(index.query(MeasurementQuery()).empty());
+    ASSERT_FALSE(std::filesystem::exists(pathToIndexFile_));
+}
+
+TEST_F(MeasurementIndexTests, AppendedEntriesAreQueriedInStartTimeOrder) {
+    MeasurementIndex index(pathToIndexFile_);
+    MeasurementRecord bending = this->makeRecord(2000, "Bending_Angle_CRYSTAL_STAGE", "STF-103");
+    bending.result = "12.5";
+    bending.uncertainty = "0.4";
+    bending.parameters = "STEP_SIZE=0.5;RANGE=4";
+    ASSERT_TRUE(index.append(bending));
+    ASSERT_TRUE(index.append(this->makeRecord(1000, "Scan", "STF-103")));  // longer entry finished later
+    ASSERT_TRUE(index.append(this->makeRecord(3000, "Scan", "STF-104")));
+    ASSERT_TRUE(std::filesystem::exists(pathToIndexFile_));
+    std::vector<MeasurementRecord> records = index.query(MeasurementQuery());
+    ASSERT_EQ(3u, records.size());
+    ASSERT_DOUBLE_EQ(1000, records[0].startTime);
+    ASSERT_DOUBLE_EQ(2000, records[1].startTime);
+    ASSERT_DOUBLE_EQ(3000, records[2].startTime);
+    ASSERT_EQ("12.5", records[1].result);
+    ASSERT_EQ("0.4", records[1].uncertainty);
+    ASSERT_EQ("STEP_SIZE=0.5;RANGE=4", records[1].parameters);
+    ASSERT_TRUE(records[1].completed);
+}
+
+TEST_F(MeasurementIndexTests, QueriesAreFilteredByTimeTypeAndCrystal) {
+    MeasurementIndex index(pathToIndexFile_);
+    index.append(this->makeRecord(1000, "Scan", "STF-103"));
+    index.append(this->makeRecord(2000, "Bending_Angle_CRYSTAL_STAGE", "STF-103"));
+    index.append(this->makeRecord(3000, "Scan", "STF-104"));
+    index.append(this->makeRecord(4000, "Scan", "STF-103"));
+    MeasurementQuery query;
+    query.type = "Scan";
+    ASSERT_EQ(3u, index.query(query).size());
+    query.crystalId = "STF-103";
+    ASSERT_EQ(2u, index.query(query).size());
+    query.from = 1500;
+    query.to = 4000;
+    std::vector<MeasurementRecord> records = index.query(query);
+    ASSERT_EQ(1u, records.size());
+    ASSERT_DOUBLE_EQ(4000, records[0].startTime);
+}
+
+TEST_F(MeasurementIndexTests, FieldSeparatorsAreReplaced) {
+    MeasurementIndex index(pathToIndexFile_);
+    MeasurementRecord record = this->makeRecord(1000, "Scan", "STF-103");
+    record.name = "scan\twith\ntabs";
+    ASSERT_TRUE(index.append(record));
+    std::vector<MeasurementRecord> records = index.query(MeasurementQuery());
+    ASSERT_EQ(1u, records.size());
+    ASSERT_EQ("scan with tabs", records[0].name);
+}
+
+TEST_F(MeasurementIndexTests, IndexIsRebuiltFromTheFile) {
+    {
+        MeasurementIndex index(pathToIndexFile_);
+        index.append(this->makeRecord(2000, "Scan", "STF-103"));
+        index.append(this->makeRecord(1000, "Scan", "STF-103"));
+    }
+    MeasurementIndex index(pathToIndexFile_);  // e.g. after a restart of the server
+    ASSERT_EQ(2u, index.query(MeasurementQuery()).size());
+    MeasurementIndex writer(pathToIndexFile_);  // another process appending to the same file
+    writer.append(this->makeRecord(1500, "Scan", "STF-104"));
+    std::vector<MeasurementRecord> records = index.query(MeasurementQuery());
+    ASSERT_EQ(3u, records.size());
+    ASSERT_EQ("STF-104", records[1].crystalId);
+}
+
+TEST_F(MeasurementIndexTests, ReplacedFileIsReadAgain) {
+    MeasurementIndex index(pathToIndexFile_);
+    index.append(this->makeRecord(1000, "Scan", "STF-103"));
+    index.append(this->makeRecord(2000, "Scan", "STF-103"));
+    ASSERT_EQ(2u, index.query(MeasurementQuery()).size());
+    std::filesystem::remove(pathToIndexFile_);
+    MeasurementIndex writer(pathToIndexFile_);
+    writer.append(this->makeRecord(3000, "Scan", "STF-104"));
+    std::vector<MeasurementRecord> records = index.query(MeasurementQuery());
+    ASSERT_EQ(1u, records.size());
+    ASSERT_EQ("STF-104", records[0].crystalId);
+}
+
+TEST_F(MeasurementIndexTests, IncompleteAndInvalidLinesAreSkipped) {
+    std::filesystem::create_directories(pathToIndexFile_.parent_path());
+    {
+        std::ofstream indexFile(pathToIndexFile_, std::ios::out | std::ios::binary);
+        indexFile << "START_TIME\tEND_TIME\tTYPE\tCRYSTAL_ID\tNAME\tCOMPLETED\tRESULT\tRESULT_PATH\tPARAMETERS\n"
+                  << "1000.000\t1060.000\tScan\tSTF-103\tscan_1\t1\t\tscan_1.csv\t\n"  // written before the uncertainty was added
+                  << "not a time\t1060.000\tScan\tSTF-103\tscan_2\t1\t\tscan_2.csv\t\t\n"
+                  << "3000.000\t3060.000\tScan";  // still being written
+    }
+    MeasurementIndex index(pathToIndexFile_);
+    std::vector<MeasurementRecord> records = index.query(MeasurementQuery());
+    ASSERT_EQ(1u, records.size());
+    ASSERT_EQ("scan_1", records[0].name);
+    ASSERT_TRUE(records[0].uncertainty.empty());
+    {
+        std::ofstream indexFile(pathToIndexFile_, std::ios::out | std::ios::app | std::ios::binary);
+        indexFile << "\tSTF-103\tscan_3\t0\t\tscan_3.csv\t\t\n";  // line completed
+    }
+    records = index.query(MeasurementQuery());
+    ASSERT_EQ(2u, records.size());
+    ASSERT_EQ("scan_3", records[1].name);
+    ASSERT_FALSE(records[1].completed);
+}
+
+TEST_F(MeasurementIndexTests, ArchivedCopiesKeepTheirContent) {
+    const std::filesystem::path dataLog = directory_ / "DeviceScans" / "alignment_Crystal_XAxis.csv";
+    std::filesystem::create_directories(dataLog.parent_path());
+    std::ofstream(dataLog) << "first scan\n";
+    const double time = MeasurementIndex::now();
+    const std::filesystem::path firstCopy = MeasurementIndex::archive(dataLog, time);
+    std::ofstream(dataLog) << "second scan\n";  // the next scan overwrites the data log
+    const std::filesystem::path secondCopy = MeasurementIndex::archive(dataLog, time);
+    ASSERT_FALSE(firstCopy.empty());
+    ASSERT_FALSE(secondCopy.empty());
+    ASSERT_NE(firstCopy, secondCopy);  // same time: the name is made unique
+    ASSERT_EQ(dataLog.parent_path() / "Archive", firstCopy.parent_path());
+    ASSERT_EQ(0u, firstCopy.filename().string().find("alignment_Crystal_XAxis_"));
+    ASSERT_EQ(".csv", firstCopy.extension());
+    std::string line;
+    std::ifstream firstFile(firstCopy);
+    std::getline(firstFile, line);
+    ASSERT_EQ("first scan", line);
+    std::ifstream secondFile(secondCopy);
+    std::getline(secondFile, line);
+    ASSERT_EQ("second scan", line);
+    ASSERT_TRUE(MeasurementIndex::archive(directory_ / "missing.csv", time).empty());
+}
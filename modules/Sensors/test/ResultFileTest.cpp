@@ -0,0 +1,147 @@
+/**
+ * @file ResultFileTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the reader of the .csv result files.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ResultFile.hpp"
+
+using namespace sensors;  // NOLINT
+
+/**
+ * @struct ResultFileTests
+ * @brief Test fixture called 'ResultFileTests', which inherits from 'testing::Test'.
+ *
+ */
+struct ResultFileTests
+    : public ::testing::Test {
+        void SetUp() override {
+            directory_ = std::filesystem::temp_directory_path() / "ResultFileTests";
+            std::filesystem::create_directories(directory_);
+            pathToResult_ = (directory_ / "result.csv").string();
+            }
+        void TearDown() override {
+            std::filesystem::remove_all(directory_);
+            }
+        /**
+         * @brief Write the result file, as the post-processing scripts do.
+         *
+         * @param content content of the file.
+         * @param mode std::ios::trunc to replace the file, std::ios::app to append to it.
+         */
+        void write(const std::string& content, std::ios::openmode mode = std::ios::trunc) {
+            std::ofstream file(pathToResult_, std::ios::out | mode);
+            file << content;
+            }
+        std::filesystem::path directory_;  /**< Temporary directory used by the tests. */
+        std::string pathToResult_;  /**< Path to the result file. */
+};
+
+TEST_F(ResultFileTests, WrittenResultIsReadBack) {
+    this->write("Slope,Intercept,Standard Deviation\n-0.125,8.39,1e-3\n");
+    ResultFile result(pathToResult_);
+    ASSERT_TRUE(result.isValid());
+    ASSERT_EQ(3u, result.getColumns());
+    double slope = 0;
+    double intercept = 0;
+    float deviation = 0;
+    ASSERT_TRUE(result.getValue("Slope", slope));
+    ASSERT_TRUE(result.getValue(1, intercept));
+    ASSERT_TRUE(result.getValue("Standard Deviation", deviation));
+    ASSERT_DOUBLE_EQ(-0.125, slope);
+    ASSERT_DOUBLE_EQ(8.39, intercept);
+    ASSERT_FLOAT_EQ(1e-3f, deviation);
+    ASSERT_EQ(-1, result.findColumn("Offset"));
+    ASSERT_FALSE(result.getValue("Offset", slope));
+}
+
+TEST_F(ResultFileTests, SeparatorsAndBlanksAreAccepted) {
+    this->write("\"Peak\" ; \"Counts\"\r\n\r\n +8.39 ; 1200 \r\n");
+    ResultFile result(pathToResult_);
+    ASSERT_TRUE(result.isValid());
+    float peak = 0;
+    int counts = 0;
+    ASSERT_TRUE(result.getValue("Peak", peak));
+    ASSERT_TRUE(result.getValue("Counts", counts));
+    ASSERT_FLOAT_EQ(8.39f, peak);
+    ASSERT_EQ(1200, counts);
+}
+
+TEST_F(ResultFileTests, AppendedRowsAreReadByIndexOrLast) {
+    this->write("Peak,Y\n1.5,0\n");
+    this->write("2.5,0.1\n", std::ios::app);
+    this->write("3.5,0.2\n", std::ios::app);
+    ASSERT_FLOAT_EQ(1.5f, ResultFile(pathToResult_).getFloat());
+    ASSERT_FLOAT_EQ(2.5f, ResultFile(pathToResult_, 1).getFloat());
+    ASSERT_FLOAT_EQ(3.5f, ResultFile(pathToResult_, ResultFile::kLastRow).getFloat());
+    ASSERT_FALSE(ResultFile(pathToResult_, 3).isValid());
+}
+
+TEST_F(ResultFileTests, MissingOrEmptyFileIsNotValid) {
+    ASSERT_FALSE(ResultFile(pathToResult_).isValid());
+    this->write("");
+    ASSERT_FALSE(ResultFile(pathToResult_).isValid());
+    this->write("Slope,Intercept\n");  // header written, values not yet
+    ASSERT_FALSE(ResultFile(pathToResult_).isValid());
+    ASSERT_FALSE(ResultFile(pathToResult_, ResultFile::kLastRow).isValid());
+    ResultFile empty;
+    ASSERT_FALSE(empty.isValid());
+    ASSERT_TRUE(empty.getField(0).empty());
+}
+
+TEST_F(ResultFileTests, PartlyWrittenRowIsNotParsed) {
+    this->write("Slope,Intercept,Standard Deviation\n-0.125,8.39,0.001\n0.5,2.5e");  // last row being written
+    ResultFile last(pathToResult_, ResultFile::kLastRow);
+    ASSERT_TRUE(last.isValid());
+    ASSERT_EQ(2u, last.getColumns());
+    double value = 0;
+    ASSERT_TRUE(last.getValue("Slope", value));
+    ASSERT_FALSE(last.getValue("Intercept", value));  // "2.5e" is not a number
+    ASSERT_FALSE(last.getValue("Standard Deviation", value));  // not written yet
+    ASSERT_EQ(0, last.getFloat(1));
+    ResultFile first(pathToResult_);  // the complete rows are not affected
+    ASSERT_TRUE(first.getValue("Intercept", value));
+    ASSERT_DOUBLE_EQ(8.39, value);
+}
+
+TEST_F(ResultFileTests, TruncatedLargeFileIsOnlyReadFromTheBeginning) {
+    std::string content = "Peak,Y\n";
+    for (int row = 0; content.size() <= ResultFile::kMaxFileSize; row++) {
+        content += std::to_string(row) + ".5,0\n";
+    }
+    this->write(content);
+    ResultFile first(pathToResult_);
+    ASSERT_TRUE(first.isValid());
+    ASSERT_FLOAT_EQ(0.5f, first.getFloat());
+    ASSERT_FALSE(ResultFile(pathToResult_, ResultFile::kLastRow).isValid());  // the last row is beyond the buffer
+}
+
+TEST_F(ResultFileTests, RowCutByTheEndOfTheBufferIsNotValid) {
+    std::string content = "Peak,Y     \n";
+    size_t rows = 0;
+    for (; content.size() < ResultFile::kMaxFileSize - 7; rows++) {
+        content += "1.5,0.25\n";
+    }
+    ASSERT_EQ(ResultFile::kMaxFileSize - 7, content.size());  // only "1.5,0.2" of the next row fits in the buffer
+    content += "1.5,0.25\n2.5,0.25\n";
+    this->write(content);
+    ResultFile complete(pathToResult_, rows - 1);
+    ASSERT_TRUE(complete.isValid());
+    ASSERT_EQ(0.25f, complete.getFloat(1));
+    ResultFile cut(pathToResult_, rows);
+    ASSERT_FALSE(cut.isValid());  // 0.2 would be read instead of 0.25
+    ASSERT_TRUE(cut.getField(1).empty());
+    ASSERT_FALSE(ResultFile(pathToResult_, rows + 1).isValid());  // beyond the buffer
+}
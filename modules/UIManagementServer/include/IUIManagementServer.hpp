@@ -18,6 +18,7 @@
 #include <string>
 #include <thread>
 #include <cassert>
+#include <filesystem>
 #include <memory>
 #include <iostream>
 
@@ -77,4 +78,21 @@ class IUIManagementServer {
    * 
    */
   virtual void sendFSMStatus() = 0;
+  /**
+   * @brief Connect and home all the devices in parallel.
+   * @details The method returns immediately: the progress and the timing of each device are sent to the client
+   * with the FSM status.
+   *
+   */
+  virtual void bringUpDevices() = 0;
+  /**
+   * @brief Load, validate and run a recipe of the configuration directory.
+   * @details The method returns immediately: the steps run on the worker threads of the devices and their completion
+   * is sent to the client with the FSM status.
+   *
+   * @param recipeFilename name of the recipe file (e.g. "Recipe_Crystal_Characterisation.ini").
+   * @return true if the recipe has been started.
+   * @return false if the recipe cannot be loaded or is not valid.
+   */
+  virtual bool runRecipe(const std::filesystem::path& recipeFilename) = 0;
 };
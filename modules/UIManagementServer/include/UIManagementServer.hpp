@@ -15,15 +15,28 @@
 #include <spdlog/spdlog.h>
 #include <json.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <cassert>
 #include <memory>
 #include <iostream>
+#include <vector>
 
 #include "IUIManagementServer.hpp"
+#include "DeviceBringUp.hpp"
+#include "DeviceOrchestrator.hpp"
+#include "ProjectPaths.hpp"
+#include "RecipeEngine.hpp"
 #include "Autocollimator/AutocollimatorDeviceController.hpp"
 #include "Crystal/CrystalDeviceController.hpp"
+#include "Crystal/CrystalRecipe.hpp"
 #include "Monochromator/MonochromatorDeviceController.hpp"
 #include "XRaySensor/XRaySensorDeviceController.hpp"
 #include "XRaySource/XRaySourceDeviceController.hpp"
@@ -91,6 +104,30 @@ class UIManagementServer : public IUIManagementServer {
    * 
    */
   void sendFSMStatus() override;
+  /**
+   * @brief Connect and home all the devices in parallel.
+   * @details The connection and the homing of each device are queued to its worker thread, so the cold start lasts
+   * as long as the slowest device. The report is sent with the FSM status under "Bring Up".
+   *
+   */
+  void bringUpDevices() override;
+  /**
+   * @brief Load, validate and run a recipe of the configuration directory with the actions of the crystal.
+   * @details The estimated duration of the recipe is sent with the FSM status under "Recipe".
+   *
+   * @param recipeFilename name of the recipe file (e.g. "Recipe_Crystal_Characterisation.ini").
+   * @return true if the recipe has been started.
+   * @return false if the recipe cannot be loaded or is not valid.
+   */
+  bool runRecipe(const std::filesystem::path& recipeFilename) override;
+  /**
+   * @brief Method used to bring up the machine or to run a recipe.
+   * @details The messages have the form {"Machine": {"bring up": true}} and
+   * {"Machine": {"run recipe": "Recipe_Crystal_Characterisation.ini"}}.
+   *
+   * @param jsonFile The JSON configuration file containing instructions.
+   */
+  void handleMachine(const nlohmann::json& jsonFile);
   /**
    * @brief Handle motor controls based on the JSON configuration file.
    * @details This function processes the JSON configuration file for motor controls
@@ -131,6 +168,15 @@ class UIManagementServer : public IUIManagementServer {
    * @param jsonFile The JSON configuration file containing crystal measurement instructions.
    */
   void handleCrystalMeasurements(const nlohmann::json& jsonFile);
+  /**
+   * @brief Method used to subscribe/unsubscribe the client to the live stream of the scan points.
+   * @details The message has the form {"Scan Stream": {"subscribe": true}}.
+   * While at least one client is subscribed, the points acquired by the scans are sent to all the clients
+   * in messages with root "Scan Stream" and the python plot at the end of the scans is not opened.
+   *
+   * @param jsonFile The JSON configuration file containing the subscription.
+   */
+  void handleScanStream(const nlohmann::json& jsonFile);
   /**
    * @brief Method used to handle the xray source motion.
    * 
@@ -376,11 +422,58 @@ class UIManagementServer : public IUIManagementServer {
    * 
    */
   void updateJsonToSendWithStepperPositions();
+  /**
+   * @brief Method used to update Json file to send to GUI with the report of the bring-up of the devices.
+   *
+   */
+  void updateJsonToSendWithBringUpReport();
+  /**
+   * @brief Method executed by the thread that sends the scan points to the clients.
+   * @details The thread waits for the points published by the scans and sends them in batches
+   * (at most 'maxStreamedPoints_' points every 'streamPeriod_'), so the scanning thread never waits for the network.
+   *
+   */
+  void streamScanPoints();
+  /**
+   * @brief Method used to subscribe a client to the scan points or to unsubscribe it.
+   * @details The subscriptions are kept per client, so that the subscription of a client leaving the server is released.
+   *
+   * @param socket connection of the client.
+   * @param subscribe true to subscribe the client, false to unsubscribe it.
+   */
+  void setScanStreamSubscription(const TCPSocket::pointer& socket, bool subscribe);
+  /**
+   * @brief Method used to keep the handle of a command queued to a device, until the status of its completion is sent.
+   *
+   * @param command handle of the command.
+   * @return std::shared_ptr<DeviceCommand> the same handle.
+   */
+  std::shared_ptr<DeviceCommand> track(std::shared_ptr<DeviceCommand> command);
+  /**
+   * @brief Method used to keep the handles of the steps of a procedure involving several devices.
+   *
+   * @param commands handles of the steps (see DeviceOrchestrator::start).
+   */
+  void track(const std::vector<std::shared_ptr<DeviceCommand>>& commands);
+  /**
+   * @brief Method executed by the thread that sends the FSM status to the client.
+   * @details The status is sent as soon as the state of a device changes, every 'statusPeriod_' while the crystal is
+   * connected or commands are running, and once more after the last command has finished.
+   *
+   */
+  void publishFSMStatus();
+  /**
+   * @brief Method used to wake up the status thread when the state of a device changes.
+   * @details It is called on the worker thread of the device, so it only sets a flag.
+   *
+   */
+  void notifyStateChange();
 
  private:
   std::shared_ptr<ISocket> socket_;  /**< Shared pointer of class ISocket. */
   std::shared_ptr<TCPServer> server_;  /**< Shared pointer of class TCPServer. */
   std::string message_;  /**< Message received from the client. */
+  TCPSocket::pointer messageSocket_;  /**< Connection of the client that sent the message being interpreted. */
   std::shared_ptr<IDevicesFactory> devicesFactory_;  /**< Shared pointer of class IDevicesFactory.*/
   std::shared_ptr<ISingleStepperDeviceController> client_XRaySource;  /**< Shared pointer of class ISingleStepperDeviceController.*/
   std::shared_ptr<ICrystalDeviceController> client_Crystal;  /**< Shared pointer of class ICrystalDeviceController.*/
@@ -388,6 +481,22 @@ class UIManagementServer : public IUIManagementServer {
   std::shared_ptr<IMultiStepperDeviceController> client_Slit;  /**< Shared pointer of class IMultiStepperDeviceController.*/
   std::shared_ptr<ISingleStepperDeviceController> client_XraySensor;  /**< Shared pointer of class ISingleStepperDeviceController.*/
   nlohmann::json jsonToSend_;  /**< Message to send to the client. */
-  std::thread t1_;  /**< Object to detach a new thread. */
-  std::thread t_status_;  /**< Object to detach a new thread for status update. */
+  std::mutex statusMutex_;  /**< Mutex protecting the sockets, serialising the messages written to them, and the json to send. */
+  std::thread t_status_;  /**< Thread sending the FSM status to the client. */
+  const std::chrono::milliseconds statusPeriod_ = std::chrono::milliseconds(500);  /**< Period of the status messages. */
+  std::mutex stateChangeMutex_;  /**< Mutex protecting 'stateChanged_'. */
+  std::condition_variable stateChangeCondition_;  /**< Condition variable waking up the status thread. */
+  bool stateChanged_ = false;  /**< True if the state of a device changed since the last status message. */
+  std::vector<std::function<void()>> stateListenersRemovals_;  /**< Functions removing the state listeners from the devices. */
+  std::shared_ptr<DeviceBringUp> bringUp_;  /**< Last bring-up of the devices (nullptr before the first one). */
+  std::shared_ptr<IConfiguration> clientConfiguration_;  /**< Configuration shared by the devices (settings of the recipe actions). */
+  std::unique_ptr<RecipeEngine> recipeEngine_;  /**< Engine running the recipes, with the actions of the crystal. */
+  std::vector<std::shared_ptr<DeviceCommand>> commands_;  /**< Commands queued to the devices and not reported yet. */
+  std::mutex commandsMutex_;  /**< Mutex protecting the commands. */
+  std::shared_ptr<scanning::ScanPointStream> scanPointStream_;  /**< Stream of the points acquired by the scans. */
+  std::thread t_stream_;  /**< Thread sending the scan points to the clients. */
+  std::unordered_set<TCPSocket::pointer> streamSubscribers_;  /**< Clients subscribed to the scan points (protected by 'statusMutex_'). */
+  std::atomic<bool> streaming_;  /**< False when the streaming and status threads have to stop. */
+  const std::chrono::milliseconds streamPeriod_ = std::chrono::milliseconds(100);  /**< Maximum waiting time between two stream messages. */
+  const size_t maxStreamedPoints_ = 64;  /**< Maximum number of points sent in a stream message. */
 };
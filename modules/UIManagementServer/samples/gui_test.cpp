@@ -28,6 +28,7 @@ int main() {
     std::shared_ptr<IUIManagementServer> clientUIManagementServer =
         std::make_shared<UIManagementServer>(1337, clientXRayMachineDevicesFactory);
 
+    clientUIManagementServer->bringUpDevices();  // connect and home the devices while the server starts
     clientUIManagementServer->initServer();
 
 }
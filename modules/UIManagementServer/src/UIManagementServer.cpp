@@ -14,7 +14,8 @@
 
 UIManagementServer::UIManagementServer(int port,
                                        std::shared_ptr<IDevicesFactory> devicesFactory):
-                                       devicesFactory_(devicesFactory) {
+                                       devicesFactory_(devicesFactory),
+                                       streaming_(true) {
     spdlog::info("cTor UIManagementServer\n");
 
     /*Creation of the objects*/
@@ -24,6 +25,24 @@ UIManagementServer::UIManagementServer(int port,
     client_Monochromator = devicesFactory_->createMonochromatorDeviceController();
     client_Slit = devicesFactory_->createSlitDeviceController();
     client_XraySensor = devicesFactory_->createXRaySensorDeviceController();
+    scanPointStream_ = devicesFactory_->getScanPointStream();
+    clientConfiguration_ = devicesFactory_->getConfiguration();
+
+    /*Recipes of the crystal characterisation*/
+    const std::shared_ptr<const ProjectPaths> projectPaths = ProjectPaths::getShared();
+    recipeEngine_ = std::make_unique<RecipeEngine>(projectPaths->getResultsDirectory("Crystal"));
+    crystal::registerRecipeActions(*recipeEngine_, client_Crystal, clientConfiguration_, projectPaths->getScanDirectory());
+
+    /*Push of the FSM status when the state of a device changes*/
+    auto addStateListener = [this](auto client) {
+        size_t id = client->addStateListener([this](const DeviceStateSnapshot&) { this->notifyStateChange(); });
+        stateListenersRemovals_.push_back([client, id] { client->removeStateListener(id); });
+    };
+    addStateListener(client_XRaySource);
+    addStateListener(client_Crystal);
+    addStateListener(client_Monochromator);
+    addStateListener(client_Slit);
+    addStateListener(client_XraySensor);
 
     /*Json to send initialization*/
     jsonToSend_ =  nlohmann::json::parse(R"(
@@ -36,7 +55,8 @@ UIManagementServer::UIManagementServer(int port,
                 "Crystal": {
                     "state": "Not Initialized",
                     "position stepper rotational": 0,
-                    "position axes hxp": [0, 0, 0, 0, 0, 0]
+                    "position axes hxp": [0, 0, 0, 0, 0, 0],
+                    "configuration version": 0
                 },
                 "Monochromator": {
                     "state": "Not Initialized",
@@ -63,44 +83,51 @@ UIManagementServer::UIManagementServer(int port,
     /*Definitions of Server Class obj functions*/
     server_->OnJoin = [this](TCPSocket::pointer socket) {
         spdlog::info("User has joined the server: {}\n", socket->GetUsername());
+        std::lock_guard<std::mutex> lock(statusMutex_);
         socket_ = socket;  // socket passed to std::shared_ptr<ISocket> socket_
     };
 
     server_->OnLeave = [this](TCPSocket::pointer socket) {
         spdlog::info("User has left the server: {}\n", socket->GetUsername());
+        this->setScanStreamSubscription(socket, false);  // the stream is not kept alive by a client that has gone
     };
 
-    server_->OnClientMessage = [this](const std::string& message) { // Grabber
+    server_->OnSocketMessage = [this](TCPSocket::pointer socket, const std::string& message) { // Grabber
+        messageSocket_ = socket;
         message_ = message;
         spdlog::debug("User message: {}", message_);
-        nlohmann::json j = nlohmann::json::parse(message_);  // deserialize message
-        if (j.contains("Motor Controls") &&  // do not use threads for crystal device connection and disconnection
-            (j["Motor Controls"]["Crystal Rotational"]["disconnect"].get<bool>() == true ||
-             j["Motor Controls"]["Crystal Rotational"]["connect"].get<bool>() == true)) {
-                interpreter();
-                /* Detach a thread that runs until client_Crystal is connected */
-                
-                t_status_ = std::thread([this](){
-                while (client_Crystal->getFsmState() != "Not Initialized") {
-                    // Send FSM Status every second
-                    this->sendFSMStatus();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                }
-                return 0;
-                });
-                t_status_.detach();
-        } else {  // detach a thread
-            t1_ = std::thread([this](){
-                interpreter();
-                return 0;
-                });
-            t1_.detach();
-        }
+        interpreter();  // the commands are queued to the devices, which run them on their own threads
     };  // end Grabber
+
+    /* Thread sending the FSM status while the devices are connected or running commands */
+    t_status_ = std::thread([this](){
+        this->publishFSMStatus();
+        });
+
+    /* Thread sending the scan points to the subscribed clients */
+    if (scanPointStream_) {
+        t_stream_ = std::thread([this](){
+            this->streamScanPoints();
+            });
+    }
 }
 
 UIManagementServer::~UIManagementServer() {
     spdlog::info("dTor UIManagementServer\n");
+    for (const auto& removeStateListener : stateListenersRemovals_) {
+        removeStateListener();
+    }
+    streaming_ = false;
+    this->notifyStateChange();
+    if (scanPointStream_) {
+        scanPointStream_->shutdown();
+    }
+    if (t_stream_.joinable()) {
+        t_stream_.join();
+    }
+    if (t_status_.joinable()) {
+        t_status_.join();
+    }
 }
 
 bool UIManagementServer::open() {
@@ -130,11 +157,13 @@ bool UIManagementServer::initServer() {
 void UIManagementServer::interpreter() {
     spdlog::info("Method interpreter of class UIManagementServer\n");
     nlohmann::json jsonFile = nlohmann::json::parse(message_);
+    this->handleMachine(jsonFile);
     this->handleMotorControls(jsonFile);
     this->handleDeviceScans(jsonFile);
     this->handleBeamAlignments(jsonFile);
     this->handleCrystalAlignments(jsonFile);
     this->handleCrystalMeasurements(jsonFile);
+    this->handleScanStream(jsonFile);
     /* Send FSM Status */
     this->sendFSMStatus();
 }
@@ -144,14 +173,14 @@ void UIManagementServer::interpreter() {
 void UIManagementServer::handleXRaySourceRotational(const nlohmann::json& jsonFile) {
     if (jsonFile["Motor Controls"].contains("X-Ray Source Rotational")) {  // check Branch
         if (jsonFile["Motor Controls"]["X-Ray Source Rotational"]["connect"].get<bool>() == true) {
-            client_XRaySource->start();
+            this->track(client_XRaySource->submitCommand("start", [this] { return client_XRaySource->start(); }));
         } else if (jsonFile["Motor Controls"]["X-Ray Source Rotational"]["disconnect"].get<bool>() == true) {
-            client_XRaySource->disconnectStp();
+            this->track(client_XRaySource->submitCommand("disconnectStp", [this] { return client_XRaySource->disconnectStp(); }));
         } else if (jsonFile["Motor Controls"]["X-Ray Source Rotational"]["go home"].get<bool>() == true) {
-            client_XRaySource->goHome();
+            this->track(client_XRaySource->submitCommand("goHome", [this] { return client_XRaySource->goHome(); }));
         } else if (jsonFile["Motor Controls"]["X-Ray Source Rotational"]["relative motion"].get<bool>() == true) {
             double position = jsonFile["Motor Controls"]["X-Ray Source Rotational"]["stepper position (deg)"].get<double>();
-            client_XRaySource->moveToPositionStepper(position);
+            this->track(client_XRaySource->submitCommand("moveToPositionStepper", [this, position] { return client_XRaySource->moveToPositionStepper(position); }));
         }
     }
 }
@@ -160,14 +189,14 @@ void UIManagementServer::handleXRaySourceRotational(const nlohmann::json& jsonFi
 void UIManagementServer::handleMonochromatorRotational(const nlohmann::json& jsonFile) {
     if (jsonFile["Motor Controls"].contains("Monochromator Rotational")) {  // check Branch
         if (jsonFile["Motor Controls"]["Monochromator Rotational"]["connect"].get<bool>() == true) {
-            client_Monochromator->start();
+            this->track(client_Monochromator->submitCommand("start", [this] { return client_Monochromator->start(); }));
         } else if (jsonFile["Motor Controls"]["Monochromator Rotational"]["disconnect"].get<bool>() == true) {
-            client_Monochromator->disconnectStp();
+            this->track(client_Monochromator->submitCommand("disconnectStp", [this] { return client_Monochromator->disconnectStp(); }));
         } else if (jsonFile["Motor Controls"]["Monochromator Rotational"]["go home"].get<bool>() == true) {
-            client_Monochromator->goHome();
+            this->track(client_Monochromator->submitCommand("goHome", [this] { return client_Monochromator->goHome(); }));
         } else if (jsonFile["Motor Controls"]["Monochromator Rotational"]["relative motion"].get<bool>() == true) {
             double position = jsonFile["Motor Controls"]["Monochromator Rotational"]["stepper position (deg)"].get<double>();
-            client_Monochromator->moveToPositionStepper2Rotational(position);
+            this->track(client_Monochromator->submitCommand("moveToPositionStepper2Rotational", [this, position] { return client_Monochromator->moveToPositionStepper2Rotational(position); }));
         }
     }
 }
@@ -176,14 +205,14 @@ void UIManagementServer::handleMonochromatorRotational(const nlohmann::json& jso
 void UIManagementServer::handleMonochromatorLinear(const nlohmann::json& jsonFile) {
     if (jsonFile["Motor Controls"].contains("Monochromator Linear")) {  // check Branch
         if (jsonFile["Motor Controls"]["Monochromator Linear"]["connect"].get<bool>() == true) {
-            client_Monochromator->start();
+            this->track(client_Monochromator->submitCommand("start", [this] { return client_Monochromator->start(); }));
         } else if (jsonFile["Motor Controls"]["Monochromator Linear"]["disconnect"].get<bool>() == true) {
-            client_Monochromator->disconnectStp();
+            this->track(client_Monochromator->submitCommand("disconnectStp", [this] { return client_Monochromator->disconnectStp(); }));
         } else if (jsonFile["Motor Controls"]["Monochromator Linear"]["go home"].get<bool>() == true) {
-            client_Monochromator->goHome();
+            this->track(client_Monochromator->submitCommand("goHome", [this] { return client_Monochromator->goHome(); }));
         } else if (jsonFile["Motor Controls"]["Monochromator Linear"]["relative motion"].get<bool>() == true) {
             double position = jsonFile["Motor Controls"]["Monochromator Linear"]["stepper position (deg)"].get<double>();
-            client_Monochromator->moveToPositionStepper1Linear(position);
+            this->track(client_Monochromator->submitCommand("moveToPositionStepper1Linear", [this, position] { return client_Monochromator->moveToPositionStepper1Linear(position); }));
         }
     }
 }
@@ -192,14 +221,14 @@ void UIManagementServer::handleMonochromatorLinear(const nlohmann::json& jsonFil
 void UIManagementServer::handleSlitRotational(const nlohmann::json& jsonFile) {
     if (jsonFile["Motor Controls"].contains("Slit Rotational")) {  // check Branch
         if (jsonFile["Motor Controls"]["Slit Rotational"]["connect"].get<bool>() == true) {
-            client_Slit->start();
+            this->track(client_Slit->submitCommand("start", [this] { return client_Slit->start(); }));
         } else if (jsonFile["Motor Controls"]["Slit Rotational"]["disconnect"].get<bool>() == true) {
-            client_Slit->disconnectStp();
+            this->track(client_Slit->submitCommand("disconnectStp", [this] { return client_Slit->disconnectStp(); }));
         } else if (jsonFile["Motor Controls"]["Slit Rotational"]["go home"].get<bool>() == true) {
-            client_Slit->goHome();
+            this->track(client_Slit->submitCommand("goHome", [this] { return client_Slit->goHome(); }));
         } else if (jsonFile["Motor Controls"]["Slit Rotational"]["relative motion"].get<bool>() == true) {
             double position = jsonFile["Motor Controls"]["Slit Rotational"]["stepper position (deg)"].get<double>();
-            client_Slit->moveToPositionStepper2Rotational(position);
+            this->track(client_Slit->submitCommand("moveToPositionStepper2Rotational", [this, position] { return client_Slit->moveToPositionStepper2Rotational(position); }));
         }
     }
 }
@@ -208,14 +237,14 @@ void UIManagementServer::handleSlitRotational(const nlohmann::json& jsonFile) {
 void UIManagementServer::handleSlitLinear(const nlohmann::json& jsonFile) {
     if (jsonFile["Motor Controls"].contains("Slit Linear")) {  // check Branch
         if (jsonFile["Motor Controls"]["Slit Linear"]["connect"].get<bool>() == true) {
-            client_Slit->start();
+            this->track(client_Slit->submitCommand("start", [this] { return client_Slit->start(); }));
         } else if (jsonFile["Motor Controls"]["Slit Linear"]["disconnect"].get<bool>() == true) {
-            client_Slit->disconnectStp();
+            this->track(client_Slit->submitCommand("disconnectStp", [this] { return client_Slit->disconnectStp(); }));
         } else if (jsonFile["Motor Controls"]["Slit Linear"]["go home"].get<bool>() == true) {
-            client_Slit->goHome();
+            this->track(client_Slit->submitCommand("goHome", [this] { return client_Slit->goHome(); }));
         } else if (jsonFile["Motor Controls"]["Slit Linear"]["relative motion"].get<bool>() == true) {
             double position = jsonFile["Motor Controls"]["Slit Linear"]["stepper position (deg)"].get<double>();
-            client_Slit->moveToPositionStepper1Linear(position);
+            this->track(client_Slit->submitCommand("moveToPositionStepper1Linear", [this, position] { return client_Slit->moveToPositionStepper1Linear(position); }));
         }
     }
 }
@@ -224,14 +253,14 @@ void UIManagementServer::handleSlitLinear(const nlohmann::json& jsonFile) {
 void UIManagementServer::handleCrystalRotational(const nlohmann::json& jsonFile) {
     if (jsonFile["Motor Controls"].contains("Crystal Rotational")) {  // check Branch
         if (jsonFile["Motor Controls"]["Crystal Rotational"]["connect"].get<bool>() == true) {
-            client_Crystal->start();
+            this->track(client_Crystal->submitCommand("start", [this] { return client_Crystal->start(); }));
         } else if (jsonFile["Motor Controls"]["Crystal Rotational"]["disconnect"].get<bool>() == true) {
-            client_Crystal->disconnect();
+            this->track(client_Crystal->submitCommand("disconnect", [this] { return client_Crystal->disconnect(); }));
         } else if (jsonFile["Motor Controls"]["Crystal Rotational"]["go home"].get<bool>() == true) {
-            client_Crystal->goHome();
+            this->track(client_Crystal->submitCommand("goHome", [this] { return client_Crystal->goHome(); }));
         } else if (jsonFile["Motor Controls"]["Crystal Rotational"]["relative motion"].get<bool>() == true) {
             double position = jsonFile["Motor Controls"]["Crystal Rotational"]["stepper position (deg)"].get<double>();
-            client_Crystal->moveToPositionStepper(position);
+            this->track(client_Crystal->submitCommand("moveToPositionStepper", [this, position] { return client_Crystal->moveToPositionStepper(position); }));
         }
     }
 }
@@ -240,11 +269,11 @@ void UIManagementServer::handleCrystalRotational(const nlohmann::json& jsonFile)
 void UIManagementServer::handleHexapod(const nlohmann::json& jsonFile) {
     if (jsonFile["Motor Controls"].contains("Hexapod")) {  // check Branch
         if (jsonFile["Motor Controls"]["Hexapod"]["connect"].get<bool>() == true) {
-            client_Crystal->start();
+            this->track(client_Crystal->submitCommand("start", [this] { return client_Crystal->start(); }));
         } else if (jsonFile["Motor Controls"]["Hexapod"]["disconnect"].get<bool>() == true) {
-            client_Crystal->disconnect();
+            this->track(client_Crystal->submitCommand("disconnect", [this] { return client_Crystal->disconnect(); }));
         } else if (jsonFile["Motor Controls"]["Hexapod"]["go home"].get<bool>() == true) {
-            client_Crystal->goHome();
+            this->track(client_Crystal->submitCommand("goHome", [this] { return client_Crystal->goHome(); }));
         } else if (jsonFile["Motor Controls"]["Hexapod"]["absolute motion"].get<bool>() == true) {
             double posX = jsonFile["Motor Controls"]["Hexapod"]["axes positions"][0].get<double>();
             double posY = jsonFile["Motor Controls"]["Hexapod"]["axes positions"][1].get<double>();
@@ -252,7 +281,7 @@ void UIManagementServer::handleHexapod(const nlohmann::json& jsonFile) {
             double posU = jsonFile["Motor Controls"]["Hexapod"]["axes positions"][3].get<double>();
             double posV = jsonFile["Motor Controls"]["Hexapod"]["axes positions"][4].get<double>();
             double posW = jsonFile["Motor Controls"]["Hexapod"]["axes positions"][5].get<double>();
-            client_Crystal->moveToAbsPosition(posX, posY, posZ, posU, posV, posW);
+            this->track(client_Crystal->submitCommand("moveToAbsPosition", [this, posX, posY, posZ, posU, posV, posW] { return client_Crystal->moveToAbsPosition(posX, posY, posZ, posU, posV, posW); }));
         }
     }
 }
@@ -277,14 +306,14 @@ void UIManagementServer::handleAutocollimatorRotational(const nlohmann::json& js
 void UIManagementServer::handleXRayDetectorRotational(const nlohmann::json& jsonFile) {
     if (jsonFile["Motor Controls"].contains("X-Ray Detector Rotational")) {  // check Branch
         if (jsonFile["Motor Controls"]["X-Ray Detector Rotational"]["connect"].get<bool>() == true) {
-            client_XraySensor->start();
+            this->track(client_XraySensor->submitCommand("start", [this] { return client_XraySensor->start(); }));
         } else if (jsonFile["Motor Controls"]["X-Ray Detector Rotational"]["disconnect"].get<bool>() == true) {
-            client_XraySensor->disconnectStp();
+            this->track(client_XraySensor->submitCommand("disconnectStp", [this] { return client_XraySensor->disconnectStp(); }));
         } else if (jsonFile["Motor Controls"]["X-Ray Detector Rotational"]["go home"].get<bool>() == true) {
-            client_XraySensor->goHome();
+            this->track(client_XraySensor->submitCommand("goHome", [this] { return client_XraySensor->goHome(); }));
         } else if (jsonFile["Motor Controls"]["X-Ray Detector Rotational"]["relative motion"].get<bool>() == true) {
             double position = jsonFile["Motor Controls"]["X-Ray Detector Rotational"]["stepper position (deg)"].get<double>();
-            client_XraySensor->moveToPositionStepper(position);
+            this->track(client_XraySensor->submitCommand("moveToPositionStepper", [this, position] { return client_XraySensor->moveToPositionStepper(position); }));
         }
     }
 }
@@ -314,9 +343,9 @@ void UIManagementServer::handleXRaySourceRotationalScan(const nlohmann::json& js
             bool eraseCsvContent = jsonFile["Device Scans"]["X-Ray Source Rotational"]["erase csv content"].get<bool>();
             int durationAcquisition = jsonFile["Device Scans"]["X-Ray Source Rotational"]["duration acquisition"].get<int>();
             std::string dataLogFileName = jsonFile["Device Scans"]["X-Ray Source Rotational"]["data log filename"].get<std::string>();
-            client_XRaySource->scanStepper(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true);
+            this->track(client_XRaySource->submitCommand("scanStepper", [this, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent] { return client_XRaySource->scanStepper(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true); }));
         } else if (jsonFile["Device Scans"]["X-Ray Source Rotational"]["stop"].get<bool>() == true) {
-            client_XRaySource->stop();
+            this->track(client_XRaySource->submitStop());
         }
     }
 }
@@ -330,9 +359,9 @@ void UIManagementServer::handleMonochromatorRotationalScan(const nlohmann::json&
             bool eraseCsvContent = jsonFile["Device Scans"]["Monochromator Rotational"]["erase csv content"].get<bool>();
             int durationAcquisition = jsonFile["Device Scans"]["Monochromator Rotational"]["duration acquisition"].get<int>();
             std::string dataLogFileName = jsonFile["Device Scans"]["Monochromator Rotational"]["data log filename"].get<std::string>();
-            client_Monochromator->scanStepper2Rotational(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true);
+            this->track(client_Monochromator->submitCommand("scanStepper2Rotational", [this, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent] { return client_Monochromator->scanStepper2Rotational(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true); }));
         } else if (jsonFile["Device Scans"]["Monochromator Rotational"]["stop"].get<bool>() == true) {
-            client_Monochromator->stop();
+            this->track(client_Monochromator->submitStop());
         }
     }
 }
@@ -346,9 +375,9 @@ void UIManagementServer::handleMonochromatorLinearScan(const nlohmann::json& jso
             bool eraseCsvContent = jsonFile["Device Scans"]["Monochromator Linear"]["erase csv content"].get<bool>();
             int durationAcquisition = jsonFile["Device Scans"]["Monochromator Linear"]["duration acquisition"].get<int>();
             std::string dataLogFileName = jsonFile["Device Scans"]["Monochromator Linear"]["data log filename"].get<std::string>();
-            client_Monochromator->scanStepper1Linear(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true);
+            this->track(client_Monochromator->submitCommand("scanStepper1Linear", [this, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent] { return client_Monochromator->scanStepper1Linear(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true); }));
         } else if (jsonFile["Device Scans"]["Monochromator Linear"]["stop"].get<bool>() == true) {
-            client_Monochromator->stop();
+            this->track(client_Monochromator->submitStop());
         }
     }
 }
@@ -362,9 +391,9 @@ void UIManagementServer::handleSlitRotationalScan(const nlohmann::json& jsonFile
             bool eraseCsvContent = jsonFile["Device Scans"]["Slit Rotational"]["erase csv content"].get<bool>();
             int durationAcquisition = jsonFile["Device Scans"]["Slit Rotational"]["duration acquisition"].get<int>();
             std::string dataLogFileName = jsonFile["Device Scans"]["Slit Rotational"]["data log filename"].get<std::string>();
-            client_Slit->scanStepper2Rotational(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true);
+            this->track(client_Slit->submitCommand("scanStepper2Rotational", [this, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent] { return client_Slit->scanStepper2Rotational(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true); }));
         } else if (jsonFile["Device Scans"]["Slit Rotational"]["stop"].get<bool>() == true) {
-            client_Slit->stop();
+            this->track(client_Slit->submitStop());
         }
     }
 }
@@ -378,9 +407,9 @@ void UIManagementServer::handleSlitLinearScan(const nlohmann::json& jsonFile) {
             bool eraseCsvContent = jsonFile["Device Scans"]["Slit Linear"]["erase csv content"].get<bool>();
             int durationAcquisition = jsonFile["Device Scans"]["Slit Linear"]["duration acquisition"].get<int>();
             std::string dataLogFileName = jsonFile["Device Scans"]["Slit Linear"]["data log filename"].get<std::string>();
-            client_Slit->scanStepper1Linear(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true);
+            this->track(client_Slit->submitCommand("scanStepper1Linear", [this, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent] { return client_Slit->scanStepper1Linear(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true); }));
         } else if (jsonFile["Device Scans"]["Slit Linear"]["stop"].get<bool>() == true) {
-            client_Slit->stop();
+            this->track(client_Slit->submitStop());
         }
     }
 }
@@ -394,9 +423,9 @@ void UIManagementServer::handleCrystalRotationalScan(const nlohmann::json& jsonF
             bool eraseCsvContent = jsonFile["Device Scans"]["Crystal Rotational"]["erase csv content"].get<bool>();
             int durationAcquisition = jsonFile["Device Scans"]["Crystal Rotational"]["duration acquisition"].get<int>();
             std::string dataLogFileName = jsonFile["Device Scans"]["Crystal Rotational"]["data log filename"].get<std::string>();
-            client_Crystal->scanStepper(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true);
+            this->track(client_Crystal->submitCommand("scanStepper", [this, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent] { return client_Crystal->scanStepper(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true); }));
         } else if (jsonFile["Device Scans"]["Crystal Rotational"]["stop"].get<bool>() == true) {
-            client_Crystal->stop();
+            this->track(client_Crystal->submitStop());
         }
     }
 }
@@ -411,9 +440,9 @@ void UIManagementServer::handleHexapodScan(const nlohmann::json& jsonFile) {
             int durationAcquisition = jsonFile["Device Scans"]["Hexapod"]["duration acquisition"].get<int>();
             int axisToScan = jsonFile["Device Scans"]["Hexapod"]["axis to scan"].get<int>();
             std::string dataLogFileName = jsonFile["Device Scans"]["Hexapod"]["data log filename"].get<std::string>();
-            client_Crystal->scanHxp(axisToScan, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true);
+            this->track(client_Crystal->submitCommand("scanHxp", [this, axisToScan, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent] { return client_Crystal->scanHxp(axisToScan, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true); }));
         } else if (jsonFile["Device Scans"]["Hexapod"]["stop"].get<bool>() == true) {
-            client_Crystal->stop();
+            this->track(client_Crystal->submitStop());
         }
     }
 }
@@ -443,9 +472,9 @@ void UIManagementServer::handleXRayDetectorRotationalScan(const nlohmann::json&
             bool eraseCsvContent = jsonFile["Device Scans"]["X-Ray Detector Rotational"]["erase csv content"].get<bool>();
             int durationAcquisition = jsonFile["Device Scans"]["X-Ray Detector Rotational"]["duration acquisition"].get<int>();
             std::string dataLogFileName = jsonFile["Device Scans"]["X-Ray Detector Rotational"]["data log filename"].get<std::string>();
-            client_XraySensor->scanStepper(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true);
+            this->track(client_XraySensor->submitCommand("scanStepper", [this, stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent] { return client_XraySensor->scanStepper(stepSize, range, durationAcquisition, dataLogFileName, eraseCsvContent, true); }));
         } else if (jsonFile["Device Scans"]["X-Ray Detector Rotational"]["stop"].get<bool>() == true) {
-            client_XraySensor->stop();
+            this->track(client_XraySensor->submitStop());
         }
     }
 }
@@ -471,13 +500,16 @@ void UIManagementServer::handleXRaySourceRotationalAlignment(const nlohmann::jso
     if (jsonFile["Beam Alignments"].contains("X-Ray Source Rotational")) {  // check Branch
         if (jsonFile["Beam Alignments"]["X-Ray Source Rotational"]["start alignment"].get<bool>() == true) {
             bool computeAlignPosition = jsonFile["Beam Alignments"]["X-Ray Source Rotational"]["compute alignment position"].get<bool>();
+            DeviceOrchestrator orchestrator("Source alignment");
+            std::vector<size_t> beamPathCleared;  // the devices are mechanically independent: they move in parallel
             if (computeAlignPosition) {
-                client_Monochromator->alignSourceWithSensor();
-                client_Slit->alignSourceWithSensor();
-                client_Crystal->alignSourceWithSensor();
-                client_XraySensor->alignSourceWithSensor(false);
+                beamPathCleared.push_back(orchestrator.addStep(client_Monochromator, "alignSourceWithSensor", [this] { return client_Monochromator->alignSourceWithSensor(); }));
+                beamPathCleared.push_back(orchestrator.addStep(client_Slit, "alignSourceWithSensor", [this] { return client_Slit->alignSourceWithSensor(); }));
+                beamPathCleared.push_back(orchestrator.addStep(client_Crystal, "alignSourceWithSensor", [this] { return client_Crystal->alignSourceWithSensor(); }));
+                beamPathCleared.push_back(orchestrator.addStep(client_XraySensor, "alignSourceWithSensor", [this] { return client_XraySensor->alignSourceWithSensor(false); }));
             }
-            client_XRaySource->alignSourceWithSensor(computeAlignPosition);
+            orchestrator.addStep(client_XRaySource, "alignSourceWithSensor", [this, computeAlignPosition] { return client_XRaySource->alignSourceWithSensor(computeAlignPosition); }, beamPathCleared);
+            this->track(orchestrator.start());
         }
     }
 }
@@ -486,11 +518,13 @@ void UIManagementServer::handleMonochromatorAlignment(const nlohmann::json& json
     if (jsonFile["Beam Alignments"].contains("Monochromator")) {  // check Branch
         if (jsonFile["Beam Alignments"]["Monochromator"]["start alignment"].get<bool>() == true) {
             bool computeAlignPosition = jsonFile["Beam Alignments"]["Monochromator"]["compute alignment position"].get<bool>();
-            client_Monochromator->alignMonochromator(computeAlignPosition);
+            this->track(client_Monochromator->submitCommand("alignMonochromator", [this, computeAlignPosition] { return client_Monochromator->alignMonochromator(computeAlignPosition); }));
         }
         if (jsonFile["Beam Alignments"]["Monochromator"]["search Bragg peak"].get<bool>() == true) {
-            client_XRaySource->setupMonochromatorBraggPeakSearch();
-            client_Monochromator->searchMonochromatorBraggPeak();
+            DeviceOrchestrator orchestrator("Monochromator Bragg peak search");
+            size_t setup = orchestrator.addStep(client_XRaySource, "setupMonochromatorBraggPeakSearch", [this] { return client_XRaySource->setupMonochromatorBraggPeakSearch(); });
+            orchestrator.addStep(client_Monochromator, "searchMonochromatorBraggPeak", [this] { return client_Monochromator->searchMonochromatorBraggPeak(); }, {setup});
+            this->track(orchestrator.start());
         }
     }
 }
@@ -499,7 +533,7 @@ void UIManagementServer::handleSlitAlignment(const nlohmann::json& jsonFile) {
     if (jsonFile["Beam Alignments"].contains("Slit")) {  // check Branch
         if (jsonFile["Beam Alignments"]["Slit"]["start alignment"].get<bool>() == true) {
             bool computeAlignPosition = jsonFile["Beam Alignments"]["Slit"]["compute alignment position"].get<bool>();
-            client_Slit->alignSlit(computeAlignPosition);
+            this->track(client_Slit->submitCommand("alignSlit", [this, computeAlignPosition] { return client_Slit->alignSlit(computeAlignPosition); }));
         }
     }
 }
@@ -517,7 +551,7 @@ void UIManagementServer::handleBeamAlignments(const nlohmann::json& jsonFile) {
 void UIManagementServer::handleCrystalXAxisAlignment(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Alignments"].contains("X-Axis Alignment")) {  // check Branch
         if (jsonFile["Crystal Alignments"]["X-Axis Alignment"]["start alignment"].get<bool>()) {
-            client_Crystal->xAxisAlignmentCrystal();
+            this->track(client_Crystal->submitCommand("xAxisAlignmentCrystal", [this] { return client_Crystal->xAxisAlignmentCrystal(); }));
         }
     }
 }
@@ -526,7 +560,7 @@ void UIManagementServer::handleCrystalXAxisAlignment(const nlohmann::json& jsonF
 void UIManagementServer::handleCrystalYAxisAlignment(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Alignments"].contains("Y-Axis Alignment")) {  // check Branch
         if (jsonFile["Crystal Alignments"]["Y-Axis Alignment"]["start alignment"].get<bool>()) {
-            client_Crystal->yAxisAlignmentCrystal();
+            this->track(client_Crystal->submitCommand("yAxisAlignmentCrystal", [this] { return client_Crystal->yAxisAlignmentCrystal(); }));
         }
     }
 }
@@ -535,7 +569,7 @@ void UIManagementServer::handleCrystalYAxisAlignment(const nlohmann::json& jsonF
 void UIManagementServer::handleCrystalYAxisFineAlignment(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Alignments"].contains("Y-Axis Fine Alignment")) {  // check Branch
         if (jsonFile["Crystal Alignments"]["Y-Axis Fine Alignment"]["start alignment"].get<bool>()) {
-            client_Crystal->yAxisFineAlignmentCrystal();
+            this->track(client_Crystal->submitCommand("yAxisFineAlignmentCrystal", [this] { return client_Crystal->yAxisFineAlignmentCrystal(); }));
         }
     }
 }
@@ -544,7 +578,7 @@ void UIManagementServer::handleCrystalYAxisFineAlignment(const nlohmann::json& j
 void UIManagementServer::handleCrystalYWAxesAlignment(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Alignments"].contains("YW-Axes Alignment")) {  // check Branch
         if (jsonFile["Crystal Alignments"]["YW-Axes Alignment"]["start alignment"].get<bool>()) {
-            client_Crystal->yWAxesAlignmentCrystal();
+            this->track(client_Crystal->submitCommand("yWAxesAlignmentCrystal", [this] { return client_Crystal->yWAxesAlignmentCrystal(); }));
         }
     }
 }
@@ -562,8 +596,10 @@ void UIManagementServer::handleCrystalZAxisAlignment(const nlohmann::json& jsonF
 void UIManagementServer::handleCrystalBraggPeakSearch(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Alignments"].contains("Bragg Peak Search")) {  // check Branch
         if (jsonFile["Crystal Alignments"]["Bragg Peak Search"]["start search"].get<bool>()) {
-            client_XraySensor->setupForCrystalBraggPeakSearch();
-            client_Crystal->braggPeakSearchCrystal();
+            DeviceOrchestrator orchestrator("Crystal Bragg peak search");
+            size_t setup = orchestrator.addStep(client_XraySensor, "setupForCrystalBraggPeakSearch", [this] { return client_XraySensor->setupForCrystalBraggPeakSearch(); });
+            orchestrator.addStep(client_Crystal, "braggPeakSearchCrystal", [this] { return client_Crystal->braggPeakSearchCrystal(); }, {setup});
+            this->track(orchestrator.start());
         }
     }
 }
@@ -572,7 +608,7 @@ void UIManagementServer::handleCrystalBraggPeakSearch(const nlohmann::json& json
 void UIManagementServer::handleCrystalCheckAlignmentFlippedOrientation(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Alignments"].contains("Check Alignment in Flipped Orientation")) {  // check Branch
         if (jsonFile["Crystal Alignments"]["Check Alignment in Flipped Orientation"]["start alignment"].get<bool>()) {
-            client_Crystal->checkAlignmentInFlippedOrientation();
+            this->track(client_Crystal->submitCommand("checkAlignmentInFlippedOrientation", [this] { return client_Crystal->checkAlignmentInFlippedOrientation(); }));
         }
     }
 }
@@ -581,7 +617,7 @@ void UIManagementServer::handleCrystalCheckAlignmentFlippedOrientation(const nlo
 void UIManagementServer::handleCrystalXAxisFineAlignment(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Alignments"].contains("X-Axis Fine Alignment")) {  // check Branch
         if (jsonFile["Crystal Alignments"]["X-Axis Fine Alignment"]["start alignment"].get<bool>()) {
-            client_Crystal->xAxisFineAlignmentCrystal();
+            this->track(client_Crystal->submitCommand("xAxisFineAlignmentCrystal", [this] { return client_Crystal->xAxisFineAlignmentCrystal(); }));
         }
     }
 }
@@ -605,7 +641,7 @@ void UIManagementServer::handleCrystalAlignments(const nlohmann::json& jsonFile)
 void UIManagementServer::handleCrystalBendingAngleMeasurement(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Measurements"].contains("Bending Angle")) {  // check Branch
         if (jsonFile["Crystal Measurements"]["Bending Angle"]["start measurement"].get<bool>()) {
-            client_Crystal->bendingAngleMeasurement();
+            this->track(client_Crystal->submitCommand("bendingAngleMeasurement", [this] { return client_Crystal->bendingAngleMeasurement(); }));
         }
     }
 }
@@ -614,7 +650,7 @@ void UIManagementServer::handleCrystalBendingAngleMeasurement(const nlohmann::js
 void UIManagementServer::handleCrystalMiscutAngleMeasurement(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Measurements"].contains("Miscut Angle")) {  // check Branch
         if (jsonFile["Crystal Measurements"]["Miscut Angle"]["start measurement"].get<bool>()) {
-            client_Crystal->miscutAngleMeasurement(true);
+            this->track(client_Crystal->submitCommand("miscutAngleMeasurement", [this] { return client_Crystal->miscutAngleMeasurement(true); }));
         }
     }
 }
@@ -623,7 +659,7 @@ void UIManagementServer::handleCrystalMiscutAngleMeasurement(const nlohmann::jso
 void UIManagementServer::handleCrystalTorsionAngleMeasurement(const nlohmann::json& jsonFile) {
     if (jsonFile["Crystal Measurements"].contains("Torsion Angle")) {  // check Branch
         if (jsonFile["Crystal Measurements"]["Torsion Angle"]["start measurement"].get<bool>()) {
-            client_Crystal->torsionAngleMeasurement();
+            this->track(client_Crystal->submitCommand("torsionAngleMeasurement", [this] { return client_Crystal->torsionAngleMeasurement(); }));
         }
     }
 }
@@ -638,20 +674,175 @@ void UIManagementServer::handleCrystalMeasurements(const nlohmann::json& jsonFil
 }
 
 void UIManagementServer::sendFSMStatus() {
-    //  spdlog::set_level(spdlog::level::warn);  // Set the logging level to 'warn' to pause output
-    if (client_Crystal->getFsmState() != "In Motion") {  // If the HXP is moving
-        this->updateJsonToSendWithFSMsStates();
-        this->updateJsonToSendWithStepperPositions();
-        this->updateJsonToSendWithPositionsHXPAxes();
-    } else {  // If the HXP is not moving
-        this->updateJsonToSendWithFSMsStates();
-        this->updateJsonToSendWithStepperPositions();
-        this->updateJsonToSendWithPositionsHXPAxes();
+    std::lock_guard<std::mutex> lock(statusMutex_);
+    if (!socket_) {
+        return;  // no client joined yet
     }
+    //  spdlog::set_level(spdlog::level::warn);  // Set the logging level to 'warn' to pause output
+    this->updateJsonToSendWithFSMsStates();
+    this->updateJsonToSendWithStepperPositions();
+    this->updateJsonToSendWithPositionsHXPAxes();
+    this->updateJsonToSendWithBringUpReport();
     socket_->write(jsonToSend_.dump());
     //  spdlog::set_level(spdlog::level::info);  // Restart the logging by setting the logging level to 'info'
 }
 
+void UIManagementServer::bringUpDevices() {
+    auto bringUp = std::make_shared<DeviceBringUp>();
+    bringUp->addDevice("Crystal", client_Crystal);
+    bringUp->addDevice("Monochromator", client_Monochromator);
+    bringUp->addDevice("Slit", client_Slit);
+    bringUp->addDevice("X-Ray Sensor", client_XraySensor);
+    bringUp->addDevice("X-Ray Source", client_XRaySource);
+    this->track(bringUp->start());
+    std::lock_guard<std::mutex> lock(statusMutex_);
+    bringUp_ = bringUp;
+}
+
+bool UIManagementServer::runRecipe(const std::filesystem::path& recipeFilename) {
+    spdlog::info("Method runRecipe of class UIManagementServer\n");
+    const std::filesystem::path pathToRecipe = ProjectPaths::getShared()->getConfigurationDirectory() / recipeFilename;
+    Recipe recipe;
+    if (!loadRecipe(pathToRecipe, recipe) || !recipeEngine_->validate(recipe)) {
+        spdlog::error("Recipe {} not run\n", pathToRecipe.string());
+        std::lock_guard<std::mutex> lock(statusMutex_);
+        jsonToSend_["Recipe"] = {{"file", recipeFilename.string()}, {"valid", false}};
+        return false;
+    }
+    const double estimatedDuration = recipeEngine_->estimateDuration(recipe);
+    spdlog::info("Recipe {}: {} steps, estimated duration {:.0f} s\n", recipe.name, recipe.steps.size(), estimatedDuration);
+    const std::vector<std::shared_ptr<DeviceCommand>> steps = recipeEngine_->start(recipe);
+    this->track(steps);
+    std::lock_guard<std::mutex> lock(statusMutex_);
+    jsonToSend_["Recipe"] = {{"file", recipeFilename.string()},
+                             {"name", recipe.name},
+                             {"valid", true},
+                             {"steps", recipe.steps.size()},
+                             {"estimated duration", estimatedDuration}};
+    return !steps.empty();
+}
+
+void UIManagementServer::handleMachine(const nlohmann::json& jsonFile) {
+    if (jsonFile.contains("Machine")) {
+        if (jsonFile["Machine"].contains("bring up") && jsonFile["Machine"]["bring up"].get<bool>()) {
+            this->bringUpDevices();
+        }
+        if (jsonFile["Machine"].contains("run recipe")) {
+            this->runRecipe(jsonFile["Machine"]["run recipe"].get<std::string>());
+        }
+    }
+}
+
+std::shared_ptr<DeviceCommand> UIManagementServer::track(std::shared_ptr<DeviceCommand> command) {
+    std::lock_guard<std::mutex> lock(commandsMutex_);
+    commands_.push_back(command);
+    return command;
+}
+
+void UIManagementServer::track(const std::vector<std::shared_ptr<DeviceCommand>>& commands) {
+    std::lock_guard<std::mutex> lock(commandsMutex_);
+    commands_.insert(commands_.end(), commands.begin(), commands.end());
+}
+
+void UIManagementServer::notifyStateChange() {
+    {
+        std::lock_guard<std::mutex> lock(stateChangeMutex_);
+        stateChanged_ = true;
+    }
+    stateChangeCondition_.notify_one();
+}
+
+void UIManagementServer::publishFSMStatus() {
+    while (streaming_) {
+        bool stateChanged = false;
+        {
+            std::unique_lock<std::mutex> lock(stateChangeMutex_);
+            stateChangeCondition_.wait_for(lock, statusPeriod_, [this] { return stateChanged_; });
+            stateChanged = stateChanged_;
+            stateChanged_ = false;
+        }
+        if (!streaming_) {
+            break;
+        }
+        bool commandsPending = false;
+        {
+            std::lock_guard<std::mutex> lock(commandsMutex_);
+            commandsPending = !commands_.empty();  // the commands completed since the last message are reported once
+            commands_.erase(std::remove_if(commands_.begin(), commands_.end(),
+                                           [](const std::shared_ptr<DeviceCommand>& command) { return command->isDone(); }),
+                            commands_.end());
+        }
+        bool crystalInitialized = client_Crystal->getStateSnapshot().state != static_cast<int>(crystal::CrystalStatus::NotInitialized);
+        if (stateChanged || commandsPending || crystalInitialized) {
+            this->sendFSMStatus();
+        }
+    }
+}
+
+void UIManagementServer::handleScanStream(const nlohmann::json& jsonFile) {
+    if (jsonFile.contains("Scan Stream") && scanPointStream_) {
+        if (jsonFile["Scan Stream"].contains("subscribe")) {
+            this->setScanStreamSubscription(messageSocket_, jsonFile["Scan Stream"]["subscribe"].get<bool>());
+        }
+    }
+}
+
+void UIManagementServer::setScanStreamSubscription(const TCPSocket::pointer& socket, bool subscribe) {
+    if (!scanPointStream_ || !socket) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(statusMutex_);
+    bool changed = subscribe ? streamSubscribers_.insert(socket).second : streamSubscribers_.erase(socket) > 0;
+    if (changed) {  // a client subscribing twice is counted once
+        scanPointStream_->setSubscription(subscribe);
+    }
+}
+
+void UIManagementServer::streamScanPoints() {
+    int lastScanId = 0;
+    bool lastRunning = false;
+    while (streaming_) {
+        if (!scanPointStream_->waitForUpdates(streamPeriod_)) {
+            continue;
+        }
+        std::vector<scanning::ScanPoint> points = scanPointStream_->collect(maxStreamedPoints_);
+        scanning::ScanInfo scanInfo = scanPointStream_->getScanInfo();
+        if (points.empty() && scanInfo.scanId == lastScanId && scanInfo.running == lastRunning) {
+            continue;
+        }
+        lastScanId = scanInfo.scanId;
+        lastRunning = scanInfo.running;
+        if (!scanPointStream_->hasSubscribers()) {
+            continue;
+        }
+        nlohmann::json jsonStream;
+        jsonStream["Scan Stream"]["scan id"] = scanInfo.scanId;
+        jsonStream["Scan Stream"]["scan name"] = scanInfo.scanName;
+        jsonStream["Scan Stream"]["axis"] = scanInfo.axis;
+        jsonStream["Scan Stream"]["running"] = scanInfo.running;
+        jsonStream["Scan Stream"]["completed"] = scanInfo.completed;
+        jsonStream["Scan Stream"]["dropped points"] = scanPointStream_->getDroppedPoints();
+        jsonStream["Scan Stream"]["points"] = nlohmann::json::array();
+        for (const scanning::ScanPoint& point : points) {
+            jsonStream["Scan Stream"]["points"].push_back({
+                {"index", point.index},
+                {"position", point.position},
+                {"position axes hxp", point.positionsHxp},
+                {"counts", point.counts},
+                {"time", point.timestamp},
+                {"step duration", point.stepDuration}
+            });
+        }
+        const std::string message = jsonStream.dump();
+        std::lock_guard<std::mutex> lock(statusMutex_);  // the status messages are written to the same sockets
+        for (const TCPSocket::pointer& subscriber : streamSubscribers_) {
+            subscriber->write(message);
+        }
+        // Pace the messages: the points published meanwhile are coalesced in the next batch
+        std::this_thread::sleep_for(streamPeriod_);
+    }
+}
+
 void UIManagementServer::updateJsonToSendWithPositionsHXPAxes() {
     jsonToSend_["FSM Devices Status"]["Crystal"]["position axes hxp"][0] = client_Crystal->getPositionX();
     jsonToSend_["FSM Devices Status"]["Crystal"]["position axes hxp"][1] = client_Crystal->getPositionY();
@@ -662,12 +853,43 @@ void UIManagementServer::updateJsonToSendWithPositionsHXPAxes() {
 }
 
 void UIManagementServer::updateJsonToSendWithFSMsStates() {
-    //  jsonToSend_["FSM Devices Status"]["Autocollimator"]["state"] = client_Autocollimator->getFsmState();
-    jsonToSend_["FSM Devices Status"]["Crystal"]["state"] = client_Crystal->getFsmState();
-    jsonToSend_["FSM Devices Status"]["Monochromator"]["state"] = client_Monochromator->getFsmState();
-    jsonToSend_["FSM Devices Status"]["Slit"]["state"] = client_Slit->getFsmState();
-    jsonToSend_["FSM Devices Status"]["X-Ray Sensor"]["state"] = client_XraySensor->getFsmState();
-    jsonToSend_["FSM Devices Status"]["X-Ray Source"]["state"] = client_XRaySource->getFsmState();
+    auto updateState = [this](const std::string& device, const DeviceStateSnapshot& snapshot) {
+        jsonToSend_["FSM Devices Status"][device]["state"] = snapshot.stateName;
+        jsonToSend_["FSM Devices Status"][device]["action"] = snapshot.action;
+        jsonToSend_["FSM Devices Status"][device]["state time"] = snapshot.timestamp;
+    };
+    //  updateState("Autocollimator", client_Autocollimator->getStateSnapshot());
+    updateState("Crystal", client_Crystal->getStateSnapshot());
+    jsonToSend_["FSM Devices Status"]["Crystal"]["configuration version"] = client_Crystal->getConfigurationVersion();
+    updateState("Monochromator", client_Monochromator->getStateSnapshot());
+    updateState("Slit", client_Slit->getStateSnapshot());
+    updateState("X-Ray Sensor", client_XraySensor->getStateSnapshot());
+    updateState("X-Ray Source", client_XRaySource->getStateSnapshot());
+}
+
+void UIManagementServer::updateJsonToSendWithBringUpReport() {
+    if (!bringUp_) {
+        return;
+    }
+    auto toString = [](CommandState state) {
+        switch (state) {
+            case CommandState::Queued: return "Queued";
+            case CommandState::Running: return "Running";
+            case CommandState::Succeeded: return "Succeeded";
+            case CommandState::Failed: return "Failed";
+            default: return "Cancelled";
+        }
+    };
+    nlohmann::json devices = nlohmann::json::object();
+    for (const DeviceBringUpReport& report : bringUp_->getReport()) {
+        devices[report.device] = {
+            {"connection", toString(report.connection)},
+            {"connection time", report.connectionTime},
+            {"homing", toString(report.homing)},
+            {"homing time", report.homingTime}
+        };
+    }
+    jsonToSend_["Bring Up"] = {{"devices", devices}, {"done", bringUp_->isDone()}, {"duration", bringUp_->getDuration()}};
 }
 
 void UIManagementServer::updateJsonToSendWithStepperPositions() {
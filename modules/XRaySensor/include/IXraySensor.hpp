@@ -13,9 +13,11 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include "IConfiguration.hpp"
+#include "SpectrumBufferPool.hpp"
 
 /**
  * @class IXRaySensor
@@ -42,6 +44,15 @@ class IXRaySensor {
      * and processes the received status data. It updates internal flags based on the status response.
      */
     virtual void getSensorStatus() = 0;
+    /**
+     * @brief Starts a new acquisition session (e.g. a scan).
+     * 
+     * The spectra of the session are stored in the buffers of the given pool and the regions of interest
+     * (K-alpha and K-beta channels) are read once from the configuration file.
+     * 
+     * @param spectrumBufferPool pool of buffers owned by the acquisition session.
+     */
+    virtual void startSession(std::shared_ptr<SpectrumBufferPool> spectrumBufferPool) = 0;
     /**
      * @brief Acquires K-alpha radiation data.
      * 
@@ -0,0 +1,96 @@
+/**
+ * @file SpectrumBufferPool.hpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Pool of pre-sized buffers used to store the spectra acquired by the X-Ray sensor.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class SpectrumBufferPool
+ * @brief Pool of pre-sized buffers used to store the spectra acquired by the X-Ray sensor.
+ *
+ * The pool is owned by the acquisition session (see @ref sensors::Sensors). The buffers are allocated once with
+ * the capacity of the largest spectrum, handed out for the acquisition of a point and given back to the pool
+ * when the lease is destroyed, so the spectra of the points of a scan do not allocate memory once the pool is warm.
+ *
+ */
+class SpectrumBufferPool {
+ public:
+  /**
+   * @struct Recycler
+   * @brief Deleter of the leased buffers: the buffer is given back to the pool instead of being destroyed.
+   *
+   */
+  struct Recycler {
+    SpectrumBufferPool* pool = nullptr;  /**< Pool that owns the buffer. */
+    void operator()(std::vector<int>* buffer) const;
+  };
+  using SpectrumBuffer = std::unique_ptr<std::vector<int>, Recycler>;  /**< Buffer leased from the pool. */
+  /**
+   * @brief Construct a new SpectrumBufferPool object.
+   *
+   * @param nChannels capacity (number of channels) of each buffer.
+   * @param nBuffers number of buffers allocated up-front.
+   */
+  explicit SpectrumBufferPool(size_t nChannels = 8192, size_t nBuffers = 2);
+  /**
+   * @brief Destroy the SpectrumBufferPool object.
+   *
+   */
+  ~SpectrumBufferPool();
+  SpectrumBufferPool(const SpectrumBufferPool&) = delete;
+  SpectrumBufferPool& operator=(const SpectrumBufferPool&) = delete;
+  /**
+   * @brief Lease an empty buffer with capacity of at least 'nChannels' channels.
+   *
+   * A new buffer is allocated only if all the buffers of the pool are leased.
+   *
+   * @return SpectrumBuffer buffer leased. It is given back to the pool when destroyed.
+   */
+  SpectrumBuffer acquire();
+  /**
+   * @brief Release the buffers allocated beyond the initial 'nBuffers'. It is called when a scan finishes.
+   *
+   */
+  void recycle();
+  /**
+   * @brief Get the capacity (number of channels) of each buffer.
+   *
+   * @return size_t number of channels.
+   */
+  size_t getChannels() const;
+  /**
+   * @brief Get the number of buffers allocated since the construction of the pool.
+   * @details Used to check that leasing the spectrum buffers of a scan in steady state does not allocate memory.
+   *
+   * @return size_t number of allocations.
+   */
+  size_t getAllocations();
+
+ private:
+  /**
+   * @brief Give a buffer back to the pool.
+   *
+   * @param buffer buffer to give back.
+   */
+  void release(std::vector<int>* buffer);
+  const size_t nChannels_;  /**< Capacity (number of channels) of each buffer. */
+  const size_t nBuffers_;  /**< Number of buffers allocated up-front. */
+  std::vector<std::unique_ptr<std::vector<int>>> freeBuffers_;  /**< Buffers available to be leased. */
+  size_t nAllocatedBuffers_ = 0;  /**< Number of buffers owned by the pool (free and leased). */
+  size_t nAllocations_ = 0;  /**< Number of buffers allocated since the construction of the pool. */
+  std::mutex mutex_;  /**< Mutex protecting the free buffers. */
+};
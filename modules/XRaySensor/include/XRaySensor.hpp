@@ -17,6 +17,8 @@
 #include <sstream>
 #include <ctime>
 #include <iomanip>
+#include <memory>
+#include <vector>
 
 #include <asio.hpp>
 #include "DppLibUsb.h"
@@ -25,6 +27,7 @@
 
 #include "IXRaySensor.hpp"
 #include "Configuration.hpp"
+#include "ProjectPaths.hpp"
 
 /**
  * @class XRaySensor
@@ -45,6 +48,7 @@ class XRaySensor: public IXRaySensor {
     void disconnectSensor() override;
 	 bool connectToSensor() override;
     void getSensorStatus() override;
+    void startSession(std::shared_ptr<SpectrumBufferPool> spectrumBufferPool) override;
     int acquireKalphaRadiation(int timeOfAcquisition) override;
     int acquireKbetaRadiation(int timeOfAcquisition) override;
     std::vector<int> acquireFullSpectrumOfRadiations(int timeOfAcquisition) override;
@@ -146,8 +150,41 @@ class XRaySensor: public IXRaySensor {
     int findMaxAboveIndex(const std::vector<int>& numbers, int startIndex);
 
     double computeIntegral(const std::vector<int>& numbers, size_t start, size_t stop);
+    /**
+     * @brief Copies the spectrum received from the hardware in a buffer.
+     *
+     * The buffer is filled without building the .mca string, so no memory is allocated
+     * if its capacity is large enough.
+     *
+     * @param numbers buffer where the counts of the channels are copied.
+     * @return true if a spectrum is available.
+     * @return false otherwise.
+     */
+    bool readSpectrum(std::vector<int>& numbers);
+    /**
+     * @brief Parses the counts written between <<DATA>> and <<END>> in a .mca string.
+     *
+     * @param input The input string containing the spectrum data.
+     * @param numbers buffer where the counts of the channels are copied.
+     * @return true if the boundaries are found in the input string.
+     * @return false otherwise.
+     */
+    bool parseSpectrum(const std::string& input, std::vector<int>& numbers);
 
  private:
+    /**
+     * @brief Reads the regions of interest (K-alpha and K-beta channels) from the configuration file.
+     *
+     */
+    void loadRegionsOfInterest();
+    /**
+     * @brief Computes the K-alpha (integral) and K-beta (maximum) counts of a spectrum.
+     *
+     * @param numbers counts of the channels of the spectrum.
+     * @return A pair of integers representing the counts for Kalpha and Kbeta radiation.
+     */
+    std::pair<int, int> computeCountsKalphaKbeta(const std::vector<int>& numbers);
+
     std::shared_ptr<IConfiguration> clientConfiguration_;  /**< Shared pointer to IConfiguration Class. */
     CDppLibUsb DppLibUsb_;  /**< LibUsb communications object. */
     bool LibUsb_isConnected_;  /**< LibUsb is connected if true. */
@@ -157,4 +194,10 @@ class XRaySensor: public IXRaySensor {
     bool bRunConfigurationTest_ = false;  /**< run configuration test */
     bool bHaveStatusResponse_ = false;  /**< have status response */
     bool bHaveConfigFromHW_ = false;  /**< have configuration from hardware */
+    std::shared_ptr<SpectrumBufferPool> spectrumBufferPool_;  /**< Pool of the buffers used to store the spectra. */
+    std::filesystem::path pathToSpectraDirectory_;  /**< Path to the directory where the spectra files are saved. */
+    bool regionsOfInterestLoaded_ = false;  /**< True if the regions of interest have been read from the configuration file. */
+    int kAlphaStart_ = 0;  /**< First channel of the K-alpha region of interest. */
+    int kAlphaStop_ = 0;  /**< Last channel of the K-alpha region of interest. */
+    int kBetaStart_ = 0;  /**< First channel of the K-beta region of interest. */
 };
@@ -42,4 +42,6 @@ class XRaySensorMock : public IXRaySensor {
   void(std::string data));
   MOCK_METHOD0(deinitialize,
   void());
+  MOCK_METHOD1(startSession,
+  void(std::shared_ptr<SpectrumBufferPool> spectrumBufferPool));
 };
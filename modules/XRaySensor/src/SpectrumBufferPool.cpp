@@ -0,0 +1,78 @@
+/**
+ * @file SpectrumBufferPool.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Pool of pre-sized buffers used to store the spectra acquired by the X-Ray sensor.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include "SpectrumBufferPool.hpp"
+
+void SpectrumBufferPool::Recycler::operator()(std::vector<int>* buffer) const {
+    if (pool) {
+        pool->release(buffer);
+    } else {
+        delete buffer;
+    }
+}
+
+SpectrumBufferPool::SpectrumBufferPool(size_t nChannels, size_t nBuffers):
+    nChannels_(nChannels),
+    nBuffers_(nBuffers) {
+    spdlog::debug("cTor SpectrumBufferPool\n");
+    freeBuffers_.reserve(nBuffers_);
+    for (size_t i = 0; i < nBuffers_; i++) {
+        auto buffer = std::make_unique<std::vector<int>>();
+        buffer->reserve(nChannels_);
+        freeBuffers_.push_back(std::move(buffer));
+        nAllocatedBuffers_++;
+        nAllocations_++;
+    }
+}
+
+SpectrumBufferPool::~SpectrumBufferPool() {
+    spdlog::debug("dTor SpectrumBufferPool\n");
+}
+
+SpectrumBufferPool::SpectrumBuffer SpectrumBufferPool::acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<std::vector<int>> buffer;
+    if (freeBuffers_.empty()) {
+        spdlog::debug("SpectrumBufferPool exhausted: allocating a new buffer\n");
+        buffer = std::make_unique<std::vector<int>>();
+        buffer->reserve(nChannels_);
+        nAllocatedBuffers_++;
+        nAllocations_++;
+    } else {
+        buffer = std::move(freeBuffers_.back());
+        freeBuffers_.pop_back();
+    }
+    buffer->clear();
+    return SpectrumBuffer(buffer.release(), Recycler{this});
+}
+
+void SpectrumBufferPool::recycle() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (nAllocatedBuffers_ > nBuffers_ && !freeBuffers_.empty()) {
+        freeBuffers_.pop_back();
+        nAllocatedBuffers_--;
+    }
+}
+
+size_t SpectrumBufferPool::getChannels() const {
+    return nChannels_;
+}
+
+size_t SpectrumBufferPool::getAllocations() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nAllocations_;
+}
+
+void SpectrumBufferPool::release(std::vector<int>* buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    freeBuffers_.emplace_back(buffer);
+}
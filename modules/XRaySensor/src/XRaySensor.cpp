@@ -16,6 +16,8 @@
 #include "asio.hpp"
 
 #include <fcntl.h>
+#include <algorithm>
+#include <charconv>
 #include <iostream>
 #include <string>
 #include <fstream>
@@ -23,7 +25,9 @@
 #include "XRaySensor.hpp"
 
 XRaySensor::XRaySensor(std::shared_ptr<IConfiguration> clientConfiguration) :
-	clientConfiguration_(clientConfiguration) {
+	clientConfiguration_(clientConfiguration),
+	spectrumBufferPool_(std::make_shared<SpectrumBufferPool>(MAX_BUFFER_DATA)),
+	pathToSpectraDirectory_(ProjectPaths::getShared()->getSpectraDirectory()) {
         spdlog::debug("CTor of Class XRaySensor\n");
 }
 
@@ -84,6 +88,30 @@ void XRaySensor::getSensorStatus() {
 	}
 }
 
+void XRaySensor::startSession(std::shared_ptr<SpectrumBufferPool> spectrumBufferPool) {
+	spdlog::info("Method startSession of Class XRaySensor\n");
+	if (spectrumBufferPool) {
+		spectrumBufferPool_ = spectrumBufferPool;
+	}
+	this->loadRegionsOfInterest();
+}
+
+void XRaySensor::loadRegionsOfInterest() {
+	kAlphaStart_ = clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+																	  clientConfiguration_->getPath(),
+																	  "X_RAY_SENSOR_SETTINGS",
+																	  "K_ALPHA_START");
+	kAlphaStop_ = clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+																	 clientConfiguration_->getPath(),
+																	 "X_RAY_SENSOR_SETTINGS",
+																	 "K_ALPHA_STOP");
+	kBetaStart_ = clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getConfigFilename(),
+																	 clientConfiguration_->getPath(),
+																	 "X_RAY_SENSOR_SETTINGS",
+																	 "K_BETA_START");
+	regionsOfInterestLoaded_ = true;
+}
+
 void XRaySensor::readDppConfigurationFromHardware(bool bDisplayCfg) {
 	CONFIG_OPTIONS CfgOptions;
 	if (bHaveStatusResponse_ && bRunConfigurationTest_) {
@@ -113,19 +141,78 @@ void XRaySensor::readDppConfigurationFromHardware(bool bDisplayCfg) {
 int XRaySensor::acquireKalphaRadiation(int timeOfAcquisition) {
 	spdlog::info("Method acquireKalphaRadiation of Class XRaySensor\n");
 	this->acquireSpectrum(timeOfAcquisition);
-	return this->getCountAtDesiredRadiation(this->saveSpectrumFile(timeOfAcquisition, false)).first;
+	SpectrumBufferPool::SpectrumBuffer numbers = spectrumBufferPool_->acquire();
+	if (!this->readSpectrum(*numbers)) {
+		return -1;
+	}
+	return this->computeCountsKalphaKbeta(*numbers).first;
 }
 
 int XRaySensor::acquireKbetaRadiation(int timeOfAcquisition) {
 	spdlog::info("Method acquireKbetaRadiation of Class XRaySensor\n");
 	this->acquireSpectrum(timeOfAcquisition);
-	return this->getCountAtDesiredRadiation(this->saveSpectrumFile(timeOfAcquisition, false)).second;
+	SpectrumBufferPool::SpectrumBuffer numbers = spectrumBufferPool_->acquire();
+	if (!this->readSpectrum(*numbers)) {
+		return -1;
+	}
+	return this->computeCountsKalphaKbeta(*numbers).second;
 }
 
 std::vector<int> XRaySensor::acquireFullSpectrumOfRadiations(int timeOfAcquisition) {
 	spdlog::info("Method acquireFullSpectrumOfRadiations of Class XRaySensor\n");
 	this->acquireSpectrum(timeOfAcquisition);
-	return this->getCountsFullSpectrumOfRadiation(this->saveSpectrumFile(timeOfAcquisition, false));
+	std::vector<int> numbers;
+	this->readSpectrum(numbers);
+	return numbers;
+}
+
+bool XRaySensor::readSpectrum(std::vector<int>& numbers) {
+	numbers.clear();
+	if (chdpp_.DP5Stat.m_DP5_Status.SerialNumber <= 0) {  // same check of CreateMCAData
+		spdlog::error("No spectrum available.\n");
+		return false;
+	}
+	const int nChannels = std::min(chdpp_.mcaCH, MAX_BUFFER_DATA);
+	numbers.assign(chdpp_.DP5Proto.SPECTRUM.DATA, chdpp_.DP5Proto.SPECTRUM.DATA + std::max(nChannels, 0));
+	return true;
+}
+
+bool XRaySensor::parseSpectrum(const std::string& input, std::vector<int>& numbers) {
+	numbers.clear();
+    // Find the positions of <<DATA>> and <<END>>
+    size_t dataPos = input.find("<<DATA>>");
+    size_t endPos = input.find("<<END>>");
+    if (dataPos == std::string::npos || endPos == std::string::npos || endPos < dataPos) {
+		spdlog::error("Boundaries not found in the input string.\n");
+		return false;
+    }
+	// Parse the numbers between <<DATA>> and <<END>> in place
+	const char* first = input.data() + dataPos + 8;
+	const char* last = input.data() + endPos;
+	while (first < last) {
+		while (first < last && (*first == ' ' || *first == '\r' || *first == '\n' || *first == '\t')) {
+			++first;
+		}
+		int num;
+		auto [next, errorCode] = std::from_chars(first, last, num);
+		if (errorCode != std::errc()) {
+			break;
+		}
+		numbers.push_back(num);
+		first = next;
+	}
+	return true;
+}
+
+std::pair<int, int> XRaySensor::computeCountsKalphaKbeta(const std::vector<int>& numbers) {
+	if (!regionsOfInterestLoaded_) {
+		this->loadRegionsOfInterest();
+	}
+	std::pair<int, int> countsKA_KB;
+	//  countsKA_KB.first = this->findMaxAboveIndex(numbers, kAlphaStart_);  // Kalpha
+	countsKA_KB.first = this->computeIntegral(numbers, kAlphaStart_, kAlphaStop_);  // Kalpha
+	countsKA_KB.second = this->findMaxAboveIndex(numbers, kBetaStart_);  // Kbeta
+	return countsKA_KB;
 }
 
 void XRaySensor::acquireSpectrum(int timeOfAcquisition) {
@@ -179,79 +266,24 @@ void XRaySensor::sendPresetAcquisitionTime(string strPRET) {
 
 int XRaySensor::getCountAtDesiredRadiation(const std::string& input, int centroidIndex) {
 	spdlog::info("Method getCountAtDesiredRadiation of Class XRaySensor\n");
-    // Find the positions of <<DATA>> and <<END>>
-    size_t dataPos = input.find("<<DATA>>");
-    size_t endPos = input.find("<<END>>");
-	int count;
-
-    if (dataPos != std::string::npos && endPos != std::string::npos) {
-        // Extract the substring between <<DATA>> and <<END>>
-        std::string dataSubstring = input.substr(dataPos + 8, endPos - dataPos - 8);
-
-        // Parse the numbers within the substring
-		std::istringstream iss(dataSubstring);
-        std::vector<int> numbers;
-        int num;
-        while (iss >> num) {
-            numbers.push_back(num);
-        }
-
-        // Find the maximum number
-        if (numbers.size() > centroidIndex) {
-            count = numbers[centroidIndex];
-            return count;
+	SpectrumBufferPool::SpectrumBuffer numbers = spectrumBufferPool_->acquire();
+    if (this->parseSpectrum(input, *numbers)) {
+        if (centroidIndex >= 0 && numbers->size() > static_cast<size_t>(centroidIndex)) {
+            return (*numbers)[centroidIndex];
         } else {
-            spdlog::error("Not enough numbers in the spectrum; index 28 is out of range.\n");
+            spdlog::error("Not enough numbers in the spectrum; index {} is out of range.\n", centroidIndex);
         }
-    } else {
-		spdlog::error("Boundaries not found in the input string.\n");
     }
     return -1; // Indicate failure by returning a negative number
 }
 
 std::pair<int, int> XRaySensor::getCountAtDesiredRadiation(const std::string& input) {
 	spdlog::info("Method getCountAtDesiredRadiation of Class XRaySensor\n");
-    // Find the positions of <<DATA>> and <<END>>
-    size_t dataPos = input.find("<<DATA>>");
-    size_t endPos = input.find("<<END>>");
-	std::pair<int, int> countsKA_KB;
-
-    if (dataPos != std::string::npos && endPos != std::string::npos) {
-        // Extract the substring between <<DATA>> and <<END>>
-        std::string dataSubstring = input.substr(dataPos + 8, endPos - dataPos - 8);
-
-        // Parse the numbers within the substring
-		std::istringstream iss(dataSubstring);
-        std::vector<int> numbers;
-        int num;
-        while (iss >> num) {
-            numbers.push_back(num);
-        }
-		/*
-        countsKA_KB.first = this->findMaxAboveIndex(numbers, clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-																												clientConfiguration_->getPath(),
-																												"X_RAY_SENSOR_SETTINGS",
-																												"K_ALPHA_START")
-																												);  // Kalpha*/
-		countsKA_KB.first = this->computeIntegral(numbers, clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-																												clientConfiguration_->getPath(),
-																												"X_RAY_SENSOR_SETTINGS",
-																												"K_ALPHA_START"),
-															clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-																													clientConfiguration_->getPath(),
-																													"X_RAY_SENSOR_SETTINGS",
-																													"K_ALPHA_STOP")
-																													);																										
-		countsKA_KB.second = this->findMaxAboveIndex(numbers, clientConfiguration_->readIntFromConfigurationFile(clientConfiguration_->getConfigFilename(),
-																												 clientConfiguration_->getPath(),
-																												 "X_RAY_SENSOR_SETTINGS",
-																												 "K_BETA_START")
-																												 );  // Kbeta
-		return countsKA_KB;
-    } else {
-		spdlog::error("Boundaries not found in the input string.\n");
+	SpectrumBufferPool::SpectrumBuffer numbers = spectrumBufferPool_->acquire();
+    if (this->parseSpectrum(input, *numbers)) {
+		return this->computeCountsKalphaKbeta(*numbers);
     }
-	return countsKA_KB;
+	return std::pair<int, int>(-1, -1);
 }
 
 int XRaySensor::findMaxAboveIndex(const std::vector<int>& numbers, int startIndex) {
@@ -281,25 +313,9 @@ double XRaySensor::computeIntegral(const std::vector<int>& numbers, size_t start
 
 std::vector<int> XRaySensor::getCountsFullSpectrumOfRadiation(const std::string& input) {
 	spdlog::info("Method getCountsFullSpectrumOfRadiation of Class XRaySensor\n");
-    // Find the positions of <<DATA>> and <<END>>
-    size_t dataPos = input.find("<<DATA>>");
-    size_t endPos = input.find("<<END>>");
 	std::vector<int> numbers;
-
-    if (dataPos != std::string::npos && endPos != std::string::npos) {
-        // Extract the substring between <<DATA>> and <<END>>
-        std::string dataSubstring = input.substr(dataPos + 8, endPos - dataPos - 8);
-
-        // Parse the numbers within the substring
-		std::istringstream iss(dataSubstring);
-        int num;
-        while (iss >> num) {
-            numbers.push_back(num);
-        }
-    } else {
-		spdlog::error("Boundaries not found in the input string.\n");
-    }
-    return numbers; // Indicate failure by returning a negative number
+	this->parseSpectrum(input, numbers);
+    return numbers;
 }
 
 std::string XRaySensor::saveSpectrumFile(int timeOfAcquisition, bool saveMCAfile) {
@@ -317,19 +333,10 @@ std::string XRaySensor::saveSpectrumFile(int timeOfAcquisition, bool saveMCAfile
     std::tm* localTime = std::localtime(&now);
     std::stringstream dateTimeStream;
     dateTimeStream << std::put_time(localTime, "%Y-%m-%d_%H-%M-%S");
-	// Create path to save spectrum
-	std::filesystem::path currentPath = std::filesystem::current_path();
-    std::string projectName = "XRay_Machine";
-    std::filesystem::path pathToProjDirectory = clientConfiguration_->getPartialPathUntilKeyName(currentPath, projectName);
-    // Additional path parts
-    std::filesystem::path logFilesDirectry = "LogFiles";
-	std::filesystem::path spectraFilesDirectry = "Spectra";
-    // Combine the paths
-    std::filesystem::path directoryPath = pathToProjDirectory / logFilesDirectry / spectraFilesDirectry;
     // Create the filename with the current date and time
     std::filesystem::path fileName = "SpectrumData_TOA_" + std::to_string(timeOfAcquisition) + "_" + dateTimeStream.str() + ".mca";
     // Combine the directory path and filename
-    std::filesystem::path fullPath = directoryPath / fileName;
+    std::filesystem::path fullPath = pathToSpectraDirectory_ / fileName;
 	if (saveMCAfile) {
 		chdpp_.SaveSpectrumStringToFile(strSpectrum, fullPath.string());  // save spectrum file string to file
 	}
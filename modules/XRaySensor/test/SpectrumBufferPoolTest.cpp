@@ -0,0 +1,51 @@
+/**
+ * @file SpectrumBufferPoolTest.cpp
+ * @author Gianmarco Ricci CERN BE/CEM/MRO 2022
+ * @brief Test the pool of buffers used to store the spectra of the X-Ray sensor.
+ * @version 0.1
+ * @date 2022
+ *
+ * @copyright © Copyright CERN 2018. All rights reserved. This software is released under a CERN proprietary software license.
+ * Any permission to use it shall be granted in writing. Requests shall be addressed to CERN through mail-KT@cern.ch
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "SpectrumBufferPool.hpp"
+
+TEST(SpectrumBufferPoolTests, BuffersArePreSized) {
+    SpectrumBufferPool pool(1024, 2);
+    SpectrumBufferPool::SpectrumBuffer buffer = pool.acquire();
+    ASSERT_TRUE(buffer->empty());
+    ASSERT_GE(buffer->capacity(), 1024u);
+}
+
+TEST(SpectrumBufferPoolTests, SteadyStateDoesNotAllocate) {
+    SpectrumBufferPool pool(1024, 2);
+    const size_t allocations = pool.getAllocations();
+    const int* data = nullptr;
+    for (int point = 0; point < 100; point++) {
+        SpectrumBufferPool::SpectrumBuffer buffer = pool.acquire();
+        buffer->assign(1024, point);
+        if (data == nullptr) {
+            data = buffer->data();
+        }
+        ASSERT_EQ(data, buffer->data());  // same storage recycled at every point
+    }
+    ASSERT_EQ(allocations, pool.getAllocations());
+}
+
+TEST(SpectrumBufferPoolTests, RecycleReleasesExtraBuffers) {
+    SpectrumBufferPool pool(16, 1);
+    {
+        SpectrumBufferPool::SpectrumBuffer first = pool.acquire();
+        SpectrumBufferPool::SpectrumBuffer second = pool.acquire();  // pool exhausted
+        ASSERT_NE(first.get(), second.get());
+    }
+    ASSERT_EQ(2u, pool.getAllocations());
+    pool.recycle();
+    SpectrumBufferPool::SpectrumBuffer first = pool.acquire();
+    SpectrumBufferPool::SpectrumBuffer second = pool.acquire();
+    ASSERT_EQ(3u, pool.getAllocations());
+}